@@ -2,6 +2,7 @@
 // Simple Mesh Shader
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "GBufferEncoding.hlsli"
 
 cbuffer PerFrameCB : register(b0)
 {
@@ -53,10 +54,40 @@ VertexOutput VS_Geometry(VertexInput input)
     return output;
 }
 
-//geometry rendering
+// Instanced drawing, per instance data lives in a structured buffer indexed by
+// SV_InstanceID. That starts at 0 for every draw so batches sharing the buffer
+// add their first instance.
+cbuffer PerBatchCB : register(b3)
+{
+	uint instanceOffset;
+	uint3 batchPadding;
+};
+
+struct GeometryInstance
+{
+	matrix matModel;
+	matrix matMVP;
+};
+
+StructuredBuffer<GeometryInstance> geometryInstances : register(t8);
+
+VertexOutput VS_Geometry_Instanced(VertexInput input, uint instanceID : SV_InstanceID)
+{
+    GeometryInstance instance = geometryInstances[instanceOffset + instanceID];
+
+    VertexOutput output;
+    output.vpos  = mul(float4(input.pos, 1.0f), instance.matMVP);
+    output.color = input.color;
+    output.normal = mul(input.normal, (float3x3)instance.matModel);
+    output.uv = input.uv;
+
+    return output;
+}
+
+//geometry rendering, packed as described in GBufferEncoding.hlsli
 struct GBufferOut {
 	float4 vColourSpec : SV_TARGET0;
-	float4 vNormalPow : SV_TARGET1;
+	float2 vNormal : SV_TARGET1;
 };
 
 GBufferOut PS_Geometry_NoTex(VertexOutput input) : SV_TARGET
@@ -65,10 +96,9 @@ GBufferOut PS_Geometry_NoTex(VertexOutput input) : SV_TARGET
 
 	// Albido.
 	gbuffer.vColourSpec.rgb = float3(0.9,0.9,0.9); // Force everything to white so we see effects of SSAO better
-	gbuffer.vColourSpec.a = 0.f;
+	gbuffer.vColourSpec.a = input.color.a; // baked AO, see VertexAO.h
 
-	gbuffer.vNormalPow.rgb = normalize(input.normal);
-	gbuffer.vNormalPow.a = 0.f;
+	gbuffer.vNormal = encode_normal_oct(normalize(input.normal));
 
 	return gbuffer;
 }
@@ -80,17 +110,16 @@ GBufferOut PS_Geometry(VertexOutput input) : SV_TARGET
 
 	// Albido.
  	gbuffer.vColourSpec.rgb = texture0.Sample(linearMipSampler, input.uv).rgb;
-	gbuffer.vColourSpec.a = 0.f;
+	gbuffer.vColourSpec.a = input.color.a;
 
- 	gbuffer.vNormalPow.rgb = normalize(input.normal);
-	gbuffer.vNormalPow.a = 0.f;
+ 	gbuffer.vNormal = encode_normal_oct(normalize(input.normal));
 
  	return gbuffer;
 }
 
 // Gbuffer textures for lighting and Debug passes.
 Texture2D gBufferColourSpec : register(t0);
-Texture2D gBufferNormalPow : register(t1);
+Texture2D<float2> gBufferNormal : register(t1);
 Texture2D gBufferDepth : register(t2);
 
 VertexOutput VS_Passthrough(VertexInput input)
@@ -108,7 +137,7 @@ float4 PS_GBufferDebug_Albido(VertexOutput input) : SV_TARGET
 {
 
  	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- //	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
+ //	float3 vNormal = load_gbuffer_normal(gBufferNormal, input.uv);
  //	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r
 
  	return float4(vColourSpec.xyz, 1.0f);
@@ -119,10 +148,10 @@ float4 PS_GBufferDebug_Normals(VertexOutput input) : SV_TARGET
 {
 
  //	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- 	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
+ 	float3 vNormal = load_gbuffer_normal(gBufferNormal, input.uv);
  //	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
 
- 	return float4(vNormalPow.xyz * 0.5f + 0.5f, 1.0f);
+ 	return float4(vNormal * 0.5f + 0.5f, 1.0f);
 
 }
 
@@ -130,10 +159,10 @@ float4 PS_GBufferDebug_Specular(VertexOutput input) : SV_TARGET
 {
 
  	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- 	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
  //	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
 
- 	return float4(vColourSpec.w, vNormalPow.w, 0.0f, 1.0f);
+ 	// The alpha holds the baked ambient visibility now, nothing reads a specular term.
+ 	return float4(vColourSpec.www, 1.0f);
 
 }
 
@@ -142,7 +171,7 @@ float4 PS_GBufferDebug_Position(VertexOutput input) : SV_TARGET
 
 
  //	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- //	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
+ //	float3 vNormal = load_gbuffer_normal(gBufferNormal, input.uv);
  	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
 
  	// discard fragments we didn't write in the Geometry pass.
@@ -164,7 +193,7 @@ float4 PS_GBufferDebug_Depth(VertexOutput input) : SV_TARGET
 {
 
  //	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- //	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
+ //	float3 vNormal = load_gbuffer_normal(gBufferNormal, input.uv);
  	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
  	float fScaledDepth = (fDepth - 0.9) * 4.0f;
  	return float4(fScaledDepth,fScaledDepth,fScaledDepth, 1.0f);
@@ -185,7 +214,7 @@ cbuffer LightInfo : register(b2)
 	float4 vLightColour; // all types
 	float4 vLightAtt; // light attenuation factors spot and point.
 	// various spot params... to be added.
-	float4 vLightAmbient;
+	float4 vLightAmbient; // w : how much of the baked vertex AO the directional light applies.
 };
 
 float4 PS_SSAODebug(VertexOutput input) : SV_TARGET
@@ -194,22 +223,89 @@ float4 PS_SSAODebug(VertexOutput input) : SV_TARGET
 	return float4(ssao, ssao, ssao, 1.f);
 }
 
+// Distance field of the static geometry, see DistanceFieldAO.h for the CPU reference.
+Texture3D<float> distanceField : register(t4);
+SamplerState distanceFieldSampler : register(s1); // bilinear, clamp.
+
+cbuffer DistanceFieldCB : register(b4)
+{
+	float3 vDistanceFieldMin;
+	float  fDistanceFieldMaxDistance;
+	float3 vDistanceFieldInvExtent; // world to uvw.
+	float  fDistanceFieldSurfaceBias;
+	int    iDistanceFieldSteps;
+	float  fDistanceFieldWeight; // 0 = off.
+	float2 distanceFieldPadding;
+};
+
+static const float kDistanceFieldConeTilt = 1.0471976f;
+static const float kDistanceFieldConeTanHalfAngle = 0.6f;
+
+float distance_field_cone(float3 origin, float3 direction)
+{
+	float cone = 1.0f;
+	for (int i = 0; i < iDistanceFieldSteps; ++i)
+	{
+		float k = (i + 1) / (float)iDistanceFieldSteps;
+		float distance = fDistanceFieldMaxDistance * k * k;
+		float3 uvw = (origin + direction * distance - vDistanceFieldMin) * vDistanceFieldInvExtent;
+		float d = distanceField.SampleLevel(distanceFieldSampler, uvw, 0);
+		cone = min(cone, saturate(d / (distance * kDistanceFieldConeTanHalfAngle)));
+	}
+	return cone;
+}
+
+// Obscurance from five cones (the normal and a ring of four), 0 open to 1 closed.
+float distance_field_ao(float3 P, float3 N)
+{
+	// Duff et al. 2017 basis.
+	float s = N.z >= 0.0f ? 1.0f : -1.0f;
+	float a = -1.0f / (s + N.z);
+	float b = N.x * N.y * a;
+	float3 T = float3(1.0f + s * N.x * N.x * a, s * b, -s * N.x);
+	float3 B = float3(b, s + N.y * N.y * a, -N.y);
+
+	float sinTilt = sin(kDistanceFieldConeTilt);
+	float cosTilt = cos(kDistanceFieldConeTilt);
+	float3 origin = P + N * fDistanceFieldSurfaceBias;
+
+	float visibility = distance_field_cone(origin, N);
+	visibility += distance_field_cone(origin, T * sinTilt + N * cosTilt) * cosTilt;
+	visibility += distance_field_cone(origin, T * -sinTilt + N * cosTilt) * cosTilt;
+	visibility += distance_field_cone(origin, B * sinTilt + N * cosTilt) * cosTilt;
+	visibility += distance_field_cone(origin, B * -sinTilt + N * cosTilt) * cosTilt;
+	return 1.0f - visibility / (1.0f + 4.0f * cosTilt);
+}
+
 float4 PS_DirectionalLight(VertexOutput input) : SV_TARGET
 {
  	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, input.uv);
- 	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, input.uv);
- 	//float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
+ 	float3 N = load_gbuffer_normal(gBufferNormal, input.uv);
+ 	float fDepth = gBufferDepth.Sample(linearMipSampler, input.uv).r;
  	
  	// decode the gbuffer.
  	float3 materialColour = vColourSpec.rgb;
-	float3 N = vNormalPow.xyz;
 
 	float kDiffuse = max(dot(vLightDirection.xyz, N),0); 
  	float3 diffuseColour = kDiffuse * materialColour * vLightColour.rgb;
 
 	//sample the ao
 	float ssao = 1.0f - ssaoBuffer.Sample(linearMipSampler, input.uv);
-	float3 ambient = vLightAmbient.xyz * ssao;
+	float baked = lerp(1.0f, vColourSpec.a, vLightAmbient.w);
+
+	// distance field AO where the geometry pass wrote, the darker of it and the ssao.
+	float dfao = 1.0f;
+	if (fDistanceFieldWeight > 0.0f && fDepth < 0.99999f)
+	{
+		float2 flipUV = input.uv.xy * float2(1,-1) + float2(0,1);
+		float4 clipPos = float4(flipUV * 2.0f - 1.0f, fDepth, 1.0f);
+		float4 viewPos = mul(clipPos, matInverseProjection);
+		viewPos /= viewPos.w;
+		float4 worldPos = mul(viewPos, matInverseView);
+
+		dfao = lerp(1.0f, 1.0f - distance_field_ao(worldPos.xyz, N), fDistanceFieldWeight);
+	}
+	float3 ambient = vLightAmbient.xyz * min(ssao, dfao) * baked;
 
  	return float4(ambient + diffuseColour, 1.f);
 }
@@ -228,12 +324,12 @@ LightVolumeVertexOutput VS_LightVolume(VertexInput input)
     return output;
 }
 
-float4 PS_PointLight(LightVolumeVertexOutput input) : SV_TARGET
+float4 point_light(float4 vScreenPos, float4 lightPosition, float4 lightColour, float4 lightAtt)
 {
-	float2 ScreenUV = (input.vScreenPos.xy / input.vScreenPos.w * 0.5 + 0.5) * float2(1, -1) + float2(0, 1);
+	float2 ScreenUV = (vScreenPos.xy / vScreenPos.w * 0.5 + 0.5) * float2(1, -1) + float2(0, 1);
 
  	float4 vColourSpec = gBufferColourSpec.Sample(linearMipSampler, ScreenUV);
- 	float4 vNormalPow = gBufferNormalPow.Sample(linearMipSampler, ScreenUV);
+ 	float3 N = load_gbuffer_normal(gBufferNormal, ScreenUV);
  	float fDepth = gBufferDepth.Sample(linearMipSampler, ScreenUV).r;
  	 
  	// discard fragments we didn't write in the Geometry pass.
@@ -241,33 +337,72 @@ float4 PS_PointLight(LightVolumeVertexOutput input) : SV_TARGET
 
  	// decode the gbuffer.
  	float3 materialColour = vColourSpec.xyz;
-	float3 N = vNormalPow.xyz;
 
 	// Decode world position for uv
- 	float4 clipPos = float4(input.vScreenPos.xy / input.vScreenPos.w, fDepth, 1.0f);
+ 	float4 clipPos = float4(vScreenPos.xy / vScreenPos.w, fDepth, 1.0f);
  	float4 viewPos = mul(clipPos, matInverseProjection);
  	viewPos /= viewPos.w;
  	float4 worldPos = mul(viewPos, matInverseView);
 
  	// obtain vector to point light
- 	float3 vToLight = vLightPosition.xyz - worldPos.xyz;
+ 	float3 vToLight = lightPosition.xyz - worldPos.xyz;
  	float3 lightDir = normalize(vToLight);
  	float lightDistance = length(vToLight);
 
  	//Compute light attenuation
-	float kAtt = 1.0 / (vLightAtt.x + vLightAtt.y*lightDistance + vLightAtt.z*lightDistance*lightDistance);
-	kAtt *= 1.0f - smoothstep(vLightAtt.w - 0.25f, vLightAtt.w, lightDistance);
+	float kAtt = 1.0 / (lightAtt.x + lightAtt.y*lightDistance + lightAtt.z*lightDistance*lightDistance);
+	kAtt *= 1.0f - smoothstep(lightAtt.w - 0.25f, lightAtt.w, lightDistance);
 
 	// clip outside of volume radius.
-	clip(vLightAtt.w - lightDistance);
+	clip(lightAtt.w - lightDistance);
 
 	float kDiffuse = max(dot(lightDir, N),0) * kAtt; 
 
- 	float3 diffuseColour = kDiffuse * materialColour * vLightColour.rgb;
+ 	float3 diffuseColour = kDiffuse * materialColour * lightColour.rgb;
 
  	return float4(diffuseColour.xyz, 1.f);
 }
 
+float4 PS_PointLight(LightVolumeVertexOutput input) : SV_TARGET
+{
+	return point_light(input.vScreenPos, vLightPosition, vLightColour, vLightAtt);
+}
+
+// Every visible point light in one draw, the light info comes with the instance.
+struct PointLightInstance
+{
+	matrix matMVP;
+	float4 vPosition;
+	float4 vDirection;
+	float4 vColour;
+	float4 vAtt;
+	float4 vAmbient;
+};
+
+StructuredBuffer<PointLightInstance> pointLightInstances : register(t8);
+
+struct LightVolumeInstancedVertexOutput
+{
+    float4 vpos  : SV_POSITION;
+    float4 vScreenPos : TEXCOORD0;
+    nointerpolation uint instance : TEXCOORD1;
+};
+
+LightVolumeInstancedVertexOutput VS_LightVolume_Instanced(VertexInput input, uint instanceID : SV_InstanceID)
+{
+    LightVolumeInstancedVertexOutput output;
+    output.instance = instanceOffset + instanceID;
+    output.vpos  = mul(float4(input.pos.xyz, 1.0f), pointLightInstances[output.instance].matMVP);
+    output.vScreenPos = output.vpos;
+    return output;
+}
+
+float4 PS_PointLight_Instanced(LightVolumeInstancedVertexOutput input) : SV_TARGET
+{
+	PointLightInstance light = pointLightInstances[input.instance];
+	return point_light(input.vScreenPos, light.vPosition, light.vColour, light.vAtt);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Decals - 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,47 @@
+// G-buffer encode / decode, shared with the CPU.
+// C++ twin : SSAO/GBufferEncoding.h includes this file inside namespace hlsl, so
+// everything above the HLSL only block must stay in the subset ShaderMath.h
+// implements (no swizzles, no intrinsics it doesn't have).
+//
+// Layout
+//   t0 RGBA8_UNORM  : albedo rgb + baked ambient visibility (vertex colour alpha, 1 = unbaked).
+//   t1 RG16_SNORM   : world space normal, octahedral.
+//   t2 D24S8        : depth.
+
+// Folds the lower hemisphere over the diagonals of the octahedron.
+inline float2 oct_wrap(float2 v)
+{
+	return float2((1.0f - abs(v.y)) * (v.x >= 0.0f ? 1.0f : -1.0f),
+	              (1.0f - abs(v.x)) * (v.y >= 0.0f ? 1.0f : -1.0f));
+}
+
+// Unit normal to [-1, 1]^2.
+inline float2 encode_normal_oct(float3 n)
+{
+	float invL1 = 1.0f / (abs(n.x) + abs(n.y) + abs(n.z));
+	float2 p = float2(n.x * invL1, n.y * invL1);
+	return n.z >= 0.0f ? p : oct_wrap(p);
+}
+
+// [-1, 1]^2 back to a unit normal (Cigolle et al. 2014, branchless fold).
+inline float3 decode_normal_oct(float2 e)
+{
+	float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+	return normalize(n);
+}
+
+#ifndef __cplusplus
+
+// Normals are point loaded, filtering across the octahedron's folds gives garbage.
+float3 load_gbuffer_normal(Texture2D<float2> normals, float2 uv)
+{
+	uint width, height;
+	normals.GetDimensions(width, height);
+	int2 texel = min(int2(uv * float2(width, height)), int2(width, height) - 1);
+	return decode_normal_oct(normals.Load(int3(texel, 0)));
+}
+
+#endif
@@ -0,0 +1,134 @@
+// GENERATED by Tools/KernelGen - do not edit.
+// Regenerated as a pre-build step of the SSAO project.
+// C++ twin : SSAO/SSAOKernels.h
+
+#define KERNEL_MAX_TAPS 32
+#define NOISE_TILE_SIZE 64
+
+// cos, sin of (i * golden angle).
+static const float2 kGoldenSpiralDir[KERNEL_MAX_TAPS] = {
+	float2(1.0f, 0.0f),
+	float2(-0.737393796f, 0.67546314f),
+	float2(0.0874991715f, -0.99616462f),
+	float2(0.608351111f, 0.793668032f),
+	float2(-0.984687805f, -0.17432715f),
+	float2(0.843853951f, -0.536572933f),
+	float2(-0.259817898f, 0.965657651f),
+	float2(-0.460677564f, -0.88756758f),
+	float2(0.939220071f, 0.343315661f),
+	float2(-0.924471915f, 0.381250143f),
+	float2(0.424179018f, -0.905578375f),
+	float2(0.298896462f, 0.954285562f),
+	float2(-0.864989281f, -0.501790285f),
+	float2(0.976778448f, -0.214251801f),
+	float2(-0.575552344f, 0.817764938f),
+	float2(-0.127963692f, -0.991778851f),
+	float2(0.764268756f, 0.644897878f),
+	float2(-0.999171793f, 0.0406902097f),
+	float2(0.709296644f, -0.7049101f),
+	float2(-0.0468916111f, 0.998899996f),
+	float2(-0.640144348f, -0.768254638f),
+	float2(0.990965962f, 0.134113744f),
+	float2(-0.821321845f, 0.570465147f),
+	float2(0.220307127f, -0.975430548f),
+	float2(0.496412992f, 0.868086457f),
+	float2(-0.95241183f, -0.304814249f),
+	float2(0.908192337f, -0.418553084f),
+	float2(-0.38697952f, 0.922088325f),
+	float2(-0.337478995f, -0.941333055f),
+	float2(0.884689987f, 0.466179818f),
+	float2(-0.967250586f, 0.25382337f),
+	float2(0.541797459f, -0.840509057f),
+};
+
+// sqrt(i + 0.5), scale by 1/sqrt(taps) for a vogel disk.
+static const float kVogelRadius[KERNEL_MAX_TAPS] = {
+	0.707106769f,
+	1.22474492f,
+	1.58113885f,
+	1.87082875f,
+	2.12132025f,
+	2.34520793f,
+	2.54950976f,
+	2.73861289f,
+	2.91547585f,
+	3.08220696f,
+	3.24037027f,
+	3.39116502f,
+	3.53553391f,
+	3.67423463f,
+	3.8078866f,
+	3.93700385f,
+	4.06201935f,
+	4.18330002f,
+	4.30116272f,
+	4.4158802f,
+	4.52769279f,
+	4.63680935f,
+	4.74341631f,
+	4.84768009f,
+	4.94974756f,
+	5.04975224f,
+	5.14781523f,
+	5.2440443f,
+	5.33853912f,
+	5.43139029f,
+	5.52268028f,
+	5.61248589f,
+};
+
+// Progressive poisson disk in the unit disk, any prefix is well distributed.
+static const float2 kPoissonDisk[KERNEL_MAX_TAPS] = {
+	float2(-0.173145294f, -0.764762044f),
+	float2(0.315927505f, 0.846596599f),
+	float2(-0.865884185f, 0.416887641f),
+	float2(0.693664551f, 0.00225615501f),
+	float2(-0.00316607952f, 0.0304405689f),
+	float2(-0.643621445f, -0.211894512f),
+	float2(0.362381339f, -0.513149738f),
+	float2(-0.196625948f, 0.958272219f),
+	float2(0.875856042f, -0.439491034f),
+	float2(-0.00144839287f, 0.481521249f),
+	float2(-0.106405139f, -0.344973922f),
+	float2(0.668959498f, 0.391853929f),
+	float2(-0.446612358f, 0.152044415f),
+	float2(-0.502455711f, -0.807957411f),
+	float2(-0.359584689f, 0.613583207f),
+	float2(0.363578439f, 0.499293923f),
+	float2(0.384355903f, 0.0919265747f),
+	float2(0.398985982f, -0.90669024f),
+	float2(-0.803779244f, 0.10211122f),
+	float2(0.983530045f, 0.0656027794f),
+	float2(-0.731462717f, -0.514278054f),
+	float2(0.0825059414f, -0.871366501f),
+	float2(0.295850396f, -0.192440867f),
+	float2(0.648172498f, -0.744561553f),
+	float2(-0.388605595f, -0.119791389f),
+	float2(-0.511327982f, -0.402386069f),
+	float2(-0.612143636f, 0.399975777f),
+	float2(-0.60422039f, 0.693235874f),
+	float2(-0.902846575f, -0.169428468f),
+	float2(0.132890463f, 0.696843982f),
+	float2(0.679942131f, -0.25839138f),
+	float2(0.0600229502f, 0.98898983f),
+};
+
+// cos, sin of 2pi * interleaved gradient noise over a 4x4 tile, index y * 4 + x.
+static const float2 kTileRotation4x4[16] = {
+	float2(1.0f, 0.0f),
+	float2(-0.93935287f, -0.342952222f),
+	float2(0.764767826f, 0.644306004f),
+	float2(-0.497422099f, -0.86750865f),
+	float2(0.0811090916f, 0.996705234f),
+	float2(0.265632898f, -0.964074254f),
+	float2(-0.580155253f, 0.814505935f),
+	float2(0.824304521f, -0.566146612f),
+	float2(-0.986842632f, 0.161683723f),
+	float2(0.982443273f, 0.18656145f),
+	float2(-0.858878553f, -0.512179315f),
+	float2(0.631140649f, 0.775668383f),
+	float2(-0.241192222f, -0.970477343f),
+	float2(-0.106263898f, 0.994337976f),
+	float2(0.440828115f, -0.897591531f),
+	float2(-0.721920907f, 0.691975594f),
+};
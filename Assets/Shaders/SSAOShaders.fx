@@ -2,6 +2,10 @@
 // SSAO SHADERS
 ///////////////////////////////////////////////////////////////////////////////
 
+// Kernels and noise rotations generated by Tools/KernelGen.
+#include "SSAOKernels.hlsli"
+#include "GBufferEncoding.hlsli"
+
 cbuffer PerFrameCB : register(b0)
 {
 	float4x4 matProjection;
@@ -24,7 +28,11 @@ cbuffer SSAOCB : register(b1)
 	float g_bias;
 	int	  g_samples;
 	float g_maxDistance;
-	float _pad1[1];
+	float g_maxScreenRadius;
+	int   g_adaptiveBaseTaps;
+	float g_importanceVarianceScale;
+	float g_importanceEdgeScale;
+	float _pad1;
 }
 
 cbuffer BlurCB : register(b2)
@@ -35,12 +43,14 @@ cbuffer BlurCB : register(b2)
 }
 
 SamplerState linearMipSampler : register(s0);
+SamplerState pointClampSampler : register(s1);	// blurs whose windows mustn't wrap at the screen edges.
 
 // Gbuffer textures for lighting and Debug passes.
 Texture2D gBufferColourSpec : register(t0);
-Texture2D gBufferNormalPow : register(t1);
+Texture2D<float2> gBufferNormal : register(t1);
 Texture2D gBufferDepth : register(t2);
 
+// Blue noise tile from SSAOKernels::kNoiseTileRGBA, r = noise, gb = rotation (cos, sin).
 Texture2D randNormal : register(t3);
 
 //--------------------------------------------
@@ -76,12 +86,10 @@ VertexOutput VS_Passthrough(VertexInput input)
 //---------------------------------------------------------------------------------------------------
 //https://www.gamedev.net/articles/programming/graphics/a-simple-and-practical-approach-to-ssao-r2753
 //---------------------------------------------------------------------------------------------------
-float3 getPosition(float2 uv)
+// World position from depth, without discarding. fDepth is returned so callers can test for the clear value.
+float3 getPositionNoClip(float2 uv, out float fDepth)
 {
-	float fDepth = gBufferDepth.Sample(linearMipSampler, uv).r;
-
-	// discard fragments we didn't write in the Geometry pass.
-	clip(0.99999f - fDepth);
+	fDepth = gBufferDepth.Sample(linearMipSampler, uv).r;
 
 	float2 flipUV = uv.xy * float2(1, -1) + float2(0, 1);
 
@@ -93,14 +101,27 @@ float3 getPosition(float2 uv)
 	return worldPos.xyz;
 }
 
+float3 getPosition(float2 uv)
+{
+	float fDepth;
+	float3 worldPos = getPositionNoClip(uv, fDepth);
+
+	// discard fragments we didn't write in the Geometry pass.
+	clip(0.99999f - fDepth);
+
+	return worldPos;
+}
+
 float3 getNormal(float2 uv)
 {
-	return normalize(gBufferNormalPow.Sample(linearMipSampler, uv)).xyz;
+	return load_gbuffer_normal(gBufferNormal, uv);
 }
 
+// Per pixel rotation (cos, sin) from the tiled blue noise, a point load so no filtering or wrap sampler is needed.
 float2 getRandom(float2 uv)
 {
-	return normalize(randNormal.Sample(linearMipSampler, float2(screenW, screenH) * uv / random_size).xy * 2.0f - 1.0f);
+	int2 texel = int2(float2(screenW, screenH) * uv) & (NOISE_TILE_SIZE - 1);
+	return normalize(randNormal.Load(int3(texel, 0)).gb * 2.0f - 1.0f);
 }
 
 float doAmbientOcclusion(float2 tcoord, float2 uv, float3 p, float3 cnorm)
@@ -121,7 +142,6 @@ float doAmbientOcclusion(float2 tcoord, float2 uv, float3 p, float3 cnorm)
 float PS_SSAO_01(VertexOutput i) : SV_TARGET
 {
 	float o;
-	const float2 vec[4] = { float2(1,0),float2(-1,0), float2(0,1),float2(0,-1) };
 	float3 p = getPosition(i.uv);
 	float3 n = getNormal(i.uv);
 	float2 rand = getRandom(i.uv);
@@ -131,7 +151,7 @@ float PS_SSAO_01(VertexOutput i) : SV_TARGET
 	int iterations = g_samples;
 	for (int j = 0; j < iterations; ++j)
 	{
-		float2 coord1 = reflect(vec[j], rand)*rad;
+		float2 coord1 = reflect(kGoldenSpiralDir[j], rand)*rad;
 		float2 coord2 = float2(coord1.x*0.707 - coord1.y*0.707, coord1.x*0.707 + coord1.y*0.707);
 
 		ao += doAmbientOcclusion(i.uv, coord1*0.25, p, n);
@@ -151,13 +171,6 @@ float PS_SSAO_01(VertexOutput i) : SV_TARGET
 //https://www.shadertoy.com/view/Ms33WB -- appears to give a smoother final image...
 //---------------------------------------------------------------------------------------------------
 
-float hash12(float2 p)
-{
-	float3 p3 = frac(float3(p.xyx) * float3(0.1031, 0.11369, 0.13787)); //MOD3
-	p3 += dot(p3, p3.yzx + 19.19);
-	return frac((p3.x + p3.y) * p3.z);
-}
-
 float doSpiralAmbientOcclusion(float2 tcoord, float2 uv, float3 p, float3 cnorm)
 {
 	float3 sample = getPosition(tcoord + uv);
@@ -171,8 +184,6 @@ float doSpiralAmbientOcclusion(float2 tcoord, float2 uv, float3 p, float3 cnorm)
 	return val;
 }
 
-static float GOLDEN_ANGLE = 2.4;
-
 float PS_SSAO_02(VertexOutput i) : SV_TARGET
 {
 	float3 p = getPosition(i.uv);
@@ -183,38 +194,38 @@ float PS_SSAO_02(VertexOutput i) : SV_TARGET
 
 	float inv = 1.0 / float(g_samples*4);
 
-	float rotatePhase = hash12(i.uv*100.0f) * 6.28f;
+	// rand is (cos, sin) of the start phase, tap j's golden angle step is kGoldenSpiralDir[j] (SSAOKernels.hlsli).
 	float rStep = inv * rad;
 	float2 spiralUV;
 	float radius = 0.0f;
 
 	for (int j = 0; j < g_samples*4; j++) {
-		spiralUV.x = sin(rotatePhase);
-		spiralUV.y = cos(rotatePhase);
+		float2 dir = kGoldenSpiralDir[j];
+		spiralUV.x = rand.y * dir.x + rand.x * dir.y;	// sin(phase + j * golden angle)
+		spiralUV.y = rand.x * dir.x - rand.y * dir.y;	// cos(phase + j * golden angle)
 		radius += rStep;
 		ao += doSpiralAmbientOcclusion(i.uv, spiralUV * radius, p, n);
-		rotatePhase += GOLDEN_ANGLE;
 	}
 	ao *= inv;
 	return ao;
 }
 
 //---------------------------------------------------------------------------------------------------
-//GPU ZEN 1 -- Not Implemented...
+//GPU ZEN 1 -- Vogel disk sampling with an Alchemy style estimator
+//Sterna, W. Robust Screen Space Ambient Occlusion in 1ms in 1080p on PS4.
+//CPU mirror : SSAO/AOReference.cpp (ssao_vogel_alchemy)
 //---------------------------------------------------------------------------------------------------
 
 #define PI				3.1415f
 #define TWO_PI			2.0f * PI
 
-float2 VogelDiskOffset(int sampleIndex, float phi)
+// rotation is (cos, sin) of the per pixel phase, invSqrtTaps = 1 / sqrt(taps).
+float2 VogelDiskOffset(int sampleIndex, float2 rotation, float invSqrtTaps)
 {
-	float r = sqrt(sampleIndex + 0.5f) / sqrt((g_samples * 4));
-	float theta = sampleIndex * GOLDEN_ANGLE + phi;
-
-	float sine, cosine;
-	sincos(theta, sine, cosine);
+	float r = kVogelRadius[sampleIndex] * invSqrtTaps;
+	float2 dir = kGoldenSpiralDir[sampleIndex];
 
-	return float2(r * cosine, r * sine);
+	return r * float2(dir.x * rotation.x - dir.y * rotation.y, dir.x * rotation.y + dir.y * rotation.x);
 }
 
 float2 AlchemySpiralOffset(int sampleIndex, float phi)
@@ -239,36 +250,176 @@ float AlchemyNoise(int2 position_screen)
 	return 30.0f*(position_screen.x^position_screen.y) + 10.0f*(position_screen.x*position_screen.y);
 }
 
+// Occlusion from a single tap, v is the vector from the shaded point to the sample.
+float AlchemyTap(float3 v, float3 n, float viewZ)
+{
+	float vv = dot(v, v);
+	float falloff = smoothstep(g_maxDistance, g_maxDistance * 0.5, sqrt(vv));
+	return falloff * max(0.0f, dot(v, n) - g_bias * viewZ) / (vv + 0.001f);
+}
+
+// g_maxDistance is the world space radius, project it to a uv space ellipse.
+float2 AlchemyRadiusScreen(float viewZ)
+{
+	// _11/_22 already carry the aspect ratio, 0.5 maps clip space to uv.
+	float2 radius_screen = (0.5f * g_maxDistance / viewZ) * float2(matProjection._11, matProjection._22);
+
+	// Clamp close to the camera so taps stay in the texture cache, keeping the ellipse shape.
+	return radius_screen * min(1.0f, g_maxScreenRadius / max(radius_screen.x, radius_screen.y));
+}
+
+// World space radius the (possibly clamped) AlchemyRadiusScreen ellipse covers at viewZ.
+float AlchemyRadiusWorld(float2 radius_screen, float viewZ)
+{
+	return 2.0f * viewZ * radius_screen.x / matProjection._11;
+}
+
+// Fitted against GroundTruthAO at the default g_intensity of 2, which PS_SSAO_01 shares.
+#define ALCHEMY_RESOLVE_SCALE	1.25f
+
+// Alchemy normalisation, aoSum is already scaled by AlchemyRadiusWorld so the result is unitless.
+// Scaling by the radius actually sampled rather than g_maxDistance keeps clamped pixels near the
+// camera from over-occluding.
+float AlchemyResolve(float aoSum, int taps)
+{
+	return saturate(ALCHEMY_RESOLVE_SCALE * g_intensity * aoSum / taps);
+}
+
 float PS_SSAO_04(VertexOutput i) : SV_TARGET
 {
-	float2 radius_screen = float2(10,10);/*radius_world / i.vpos.z;
-	radius_screen = min(radius_screen, maxRadius_screen);
-	radius_screen.y *= aspect;*/
+	float3 p = getPosition(i.uv);
+	float3 n = getNormal(i.uv);
+	float viewZ = mul(float4(p, 1.0f), matView).z;
+	float2 radius_screen = AlchemyRadiusScreen(viewZ);
 
-	float noise = InterleavedGradientNoise(i.vpos.xy);
-	float alchemyNoise = AlchemyNoise((int2)i.vpos.xy);
+	// Fold the noise into a 4x4 tile so PS_BLUR_DENOISE_4X4 sees every rotation exactly once.
+	// kTileRotation4x4 holds the (cos, sin) of the interleaved gradient noise phase for each tile texel.
+	int2 tile = int2(i.vpos.xy) & 3;
+	float2 rotation = kTileRotation4x4[tile.y * 4 + tile.x];
 
+	int taps = g_samples * 4;
+	float invSqrtTaps = rsqrt((float)taps);
 	float ao = 0.0f;
 
-	for (int j = 0; j < g_samples*4; j++)
+	for (int j = 0; j < taps; j++)
 	{
-		float2 sampleOffset = 0.0f;
-		
-		sampleOffset = VogelDiskOffset(j, TWO_PI*noise);
-		//sampleOffset = AlchemySpiralOffset(j, alchemyNoise);
+		float2 sampleTexCoord = i.uv + radius_screen * VogelDiskOffset(j, rotation, invSqrtTaps);
 
-		float2 sampleTexCoord = i.uv + radius_screen * sampleOffset;
+		float sampleDepth;
+		float3 samplePosition = getPositionNoClip(sampleTexCoord, sampleDepth);
 
-		float3 samplePosition = getPosition(sampleTexCoord);
-		float3 v = samplePosition - i.vpos;
+		// taps landing on the cleared background don't occlude.
+		ao += step(sampleDepth, 0.99999f) * AlchemyTap(samplePosition - p, n, viewZ);
+	}
+
+	return AlchemyResolve(ao * AlchemyRadiusWorld(radius_screen, viewZ), taps);
+}
+
+//---------------------------------------------------------------------------------------------------
+//GPU ZEN 1 -- Adaptive sample count in the spirit of Scalable Adaptive SSAO
+//Strugar, F. Scalable Adaptive SSAO.
+//A cheap base pass takes g_adaptiveBaseTaps taps, an importance map is built from the local AO
+//variance and depth edges, then the adaptive pass only spends the remaining g_samples*4 taps where
+//the importance asks for them. Taps walk the progressive poisson disk so the adaptive pass carries
+//on from where the base pass stopped and every prefix stays well distributed.
+//CPU mirror : SSAO/AOReference.cpp (ssao_adaptive)
+//---------------------------------------------------------------------------------------------------
+
+Texture2D adaptiveBaseAO : register(t4);	// PS_SSAO_ADAPTIVE_BASE, unresolved mean of the base taps.
+Texture2D importanceMap : register(t5);		// PS_SSAO_IMPORTANCE, 0..1.
+
+// Alchemy sum of poisson disk taps [first, last), scaled by AlchemyRadiusWorld for AlchemyResolve.
+float AlchemyPoissonTaps(float2 uv, float3 p, float3 n, float viewZ, float2 radius_screen, float2 rotation, int first, int last)
+{
+	float ao = 0.0f;
+
+	for (int j = first; j < last; j++)
+	{
+		float2 dir = kPoissonDisk[j];
+		float2 offset = float2(dir.x * rotation.x - dir.y * rotation.y, dir.x * rotation.y + dir.y * rotation.x);
 
-		ao += max(0.0f, dot(v, getNormal(sampleTexCoord)) + 0.002f*i.vpos.z) / (dot(v, v) + 0.001f);
+		float sampleDepth;
+		float3 samplePosition = getPositionNoClip(uv + radius_screen * offset, sampleDepth);
+
+		ao += step(sampleDepth, 0.99999f) * AlchemyTap(samplePosition - p, n, viewZ);
 	}
 
-	ao = saturate(ao / (g_samples*4));
-	//ao = pow(ao, g_intensity);
+	return ao * AlchemyRadiusWorld(radius_screen, viewZ);
+}
 
-	return ao;
+float PS_SSAO_ADAPTIVE_BASE(VertexOutput i) : SV_TARGET
+{
+	float3 p = getPosition(i.uv);
+	float3 n = getNormal(i.uv);
+	float viewZ = mul(float4(p, 1.0f), matView).z;
+
+	int2 tile = int2(i.vpos.xy) & 3;
+	float2 rotation = kTileRotation4x4[tile.y * 4 + tile.x];
+
+	// Unresolved mean so the adaptive pass can fold it back into its own sum.
+	return AlchemyPoissonTaps(i.uv, p, n, viewZ, AlchemyRadiusScreen(viewZ), rotation, 0, g_adaptiveBaseTaps) / g_adaptiveBaseTaps;
+}
+
+float PS_SSAO_IMPORTANCE(VertexOutput i) : SV_TARGET
+{
+	float3 p = getPosition(i.uv);
+	float viewZ = mul(float4(p, 1.0f), matView).z;
+	int2 texel = int2(i.vpos.xy);
+
+	uint width, height;
+	adaptiveBaseAO.GetDimensions(width, height);
+	int2 maxTexel = int2(width, height) - 1;
+
+	// AO variance over the 3x3 neighbourhood of the resolved base estimate.
+	float sum = 0.0f;
+	float sumSq = 0.0f;
+	for (int y = -1; y <= 1; ++y)
+	{
+		for (int x = -1; x <= 1; ++x)
+		{
+			int2 neighbour = clamp(texel + int2(x, y), 0, maxTexel);
+			float ao = AlchemyResolve(adaptiveBaseAO.Load(int3(neighbour, 0)).r * g_adaptiveBaseTaps, g_adaptiveBaseTaps);
+			sum += ao;
+			sumSq += ao * ao;
+		}
+	}
+	float mean = sum / 9.0f;
+	float variance = max(0.0f, sumSq / 9.0f - mean * mean);
+
+	// Depth edges, relative view depth step to the 4 neighbours. The cleared background counts as an edge.
+	float2 texelUV = 1.0f / float2(width, height);
+	const float2 cross4[4] = { float2(1, 0), float2(-1, 0), float2(0, 1), float2(0, -1) };
+	float edge = 0.0f;
+	for (int k = 0; k < 4; ++k)
+	{
+		float neighbourDepth;
+		float3 neighbour = getPositionNoClip(i.uv + cross4[k] * texelUV, neighbourDepth);
+		float neighbourZ = mul(float4(neighbour, 1.0f), matView).z;
+		edge = max(edge, neighbourDepth < 0.99999f ? abs(neighbourZ - viewZ) / viewZ : 1.0f);
+	}
+
+	return saturate(g_importanceVarianceScale * sqrt(variance) + g_importanceEdgeScale * edge);
+}
+
+float PS_SSAO_ADAPTIVE(VertexOutput i) : SV_TARGET
+{
+	float3 p = getPosition(i.uv);
+	float3 n = getNormal(i.uv);
+	float viewZ = mul(float4(p, 1.0f), matView).z;
+
+	int2 texel = int2(i.vpos.xy);
+	int2 tile = texel & 3;
+	float2 rotation = kTileRotation4x4[tile.y * 4 + tile.x];
+
+	// Extra taps on top of the base ones, from none on flat open areas up to g_samples*4 in total.
+	float importance = importanceMap.Load(int3(texel, 0)).r;
+	int maxTaps = max(g_samples * 4, g_adaptiveBaseTaps);
+	int taps = g_adaptiveBaseTaps + (int)round(importance * (maxTaps - g_adaptiveBaseTaps));
+
+	float ao = adaptiveBaseAO.Load(int3(texel, 0)).r * g_adaptiveBaseTaps;
+	ao += AlchemyPoissonTaps(i.uv, p, n, viewZ, AlchemyRadiusScreen(viewZ), rotation, g_adaptiveBaseTaps, taps);
+
+	return AlchemyResolve(ao, taps);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -277,6 +428,14 @@ float PS_SSAO_04(VertexOutput i) : SV_TARGET
 
 Texture2D ssaoBuffer : register(t0);
 
+// Texel size of the bound source, for blurs whose input isn't sized by g_downsampleBlurFac.
+float2 SourceTexelSize()
+{
+	float width, height;
+	ssaoBuffer.GetDimensions(width, height);
+	return float2(1.0f / width, 1.0f / height);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // https://www.shadertoy.com/view/XdfGDH
 // A Slow Gaussian that calculates its weights adapted from ^^^
@@ -311,6 +470,25 @@ float PS_BLUR_GAUSS(VertexOutput input) : SV_TARGET
 	}
 
 	//read out the texels
+#if SHADER_MODEL >= 5
+	// 2x2 texels per fetch, 36 gathers instead of 121 samples. The last row / column of
+	// gathers hangs one texel past the kernel, weight 0.
+	for (int k = -kSize; k <= kSize; k += 2)
+	{
+		float wk0 = kernel[kSize + k];
+		float wk1 = k < kSize ? kernel[min(kSize + k + 1, mSize - 1)] : 0.0f;
+
+		for (int l = -kSize; l <= kSize; l += 2)
+		{
+			float wl0 = kernel[kSize + l];
+			float wl1 = l < kSize ? kernel[min(kSize + l + 1, mSize - 1)] : 0.0f;
+
+			// Centred on the corner shared by texels (k, l) and (k + 1, l + 1). Gather order is (0,1), (1,1), (1,0), (0,0).
+			float4 quad = ssaoBuffer.GatherRed(linearMipSampler, (input.vpos.xy + float2(k, l) + 0.5f) / RTSize);
+			final += dot(quad, float4(wk0 * wl1, wk1 * wl1, wk1 * wl0, wk0 * wl0));
+		}
+	}
+#else
 	for (int k = -kSize; k <= kSize; ++k)
 	{
 		for (int l = -kSize; l <= kSize; ++l)
@@ -319,6 +497,7 @@ float PS_BLUR_GAUSS(VertexOutput input) : SV_TARGET
 			final += kernel[kSize + l] * kernel[kSize + k] * samp.x;
 		}
 	}
+#endif
 
 	return float(final / (Z*Z));
 }
@@ -413,6 +592,118 @@ float PS_BLUR_GAUSS_YBI(VertexOutput input) : SV_TARGET
 	return output;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// 4x4 box denoise, pairs with the 4x4 interleaved gradient noise tile of PS_SSAO_04.
+// Any 4x4 window covers every tile rotation once so the noise averages out exactly. The tile is
+// indexed by SSAO target texels, so the window is too: it is centred on the source texel under the
+// pixel (the blur target can be another size) and clamps at the edges like denoise_4x4().
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+float PS_BLUR_DENOISE_4X4(VertexOutput input) : SV_TARGET
+{
+	float2 texel = SourceTexelSize();
+	float2 centre = floor(input.uv / texel) + 0.5f;
+
+	float output = 0.0f;
+
+#if SHADER_MODEL >= 5
+	// The same 16 texels as 4 gathers, each centred on the corner between a 2x2 block.
+	for (int y = -1; y < 2; y += 2)
+	{
+		for (int x = -1; x < 2; x += 2)
+		{
+			output += dot(ssaoBuffer.GatherRed(pointClampSampler, (centre + float2(x, y) - 0.5f) * texel), float4(1.0f, 1.0f, 1.0f, 1.0f));
+		}
+	}
+#else
+	// texels -2..+1 around the source texel, each tap on a texel centre.
+	for (int y = -2; y < 2; ++y)
+	{
+		for (int x = -2; x < 2; ++x)
+		{
+			output += ssaoBuffer.Sample(pointClampSampler, (centre + float2(x, y)) * texel).r;
+		}
+	}
+#endif
+
+	return output * (1.0f / 16.0f);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Fused separable gaussian, one compute pass instead of X then Y passes through a target.
+// A group loads its 16x16 tile plus a radius wide apron into shared memory once, blurs the rows
+// into a second shared buffer, then the columns straight into the output. The weights come from
+// BlurKernel (Framework/SeparableBlur.h), so the 9 tap gaussian iterated or a few box passes for
+// wider radii; blur_fused() is the CPU version.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if SHADER_MODEL >= 5
+#define FUSED_TILE 16
+#define FUSED_MAX_RADIUS 32
+#define FUSED_SPAN (FUSED_TILE + 2 * FUSED_MAX_RADIUS)
+
+cbuffer FusedBlurCB : register(b3)
+{
+	int    g_fusedRadius;
+	int3   _pad3;
+	float4 g_fusedWeights[(FUSED_MAX_RADIUS + 4) / 4];	// weight of offset i in [i / 4][i % 4].
+}
+
+RWTexture2D<float> blurOutput : register(u0);
+
+groupshared float gs_input[FUSED_SPAN * FUSED_SPAN];
+groupshared float gs_rows[FUSED_SPAN * FUSED_TILE];
+
+float fused_weight(int offset)
+{
+	offset = abs(offset);
+	return g_fusedWeights[offset >> 2][offset & 3];
+}
+
+[numthreads(FUSED_TILE, FUSED_TILE, 1)]
+void CS_BLUR_FUSED(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID, uint threadIndex : SV_GroupIndex)
+{
+	float2 RTSize = float2(screenW / g_downsampleBlurFac, screenH / g_downsampleBlurFac);
+
+	int radius = g_fusedRadius;
+	int span = FUSED_TILE + 2 * radius;
+	int2 origin = int2(groupId.xy) * FUSED_TILE - radius;
+
+	// Tile + apron, sampled like the pixel shader blurs so a smaller SSAO target is upsampled the same way.
+	for (int i = threadIndex; i < span * span; i += FUSED_TILE * FUSED_TILE)
+	{
+		int2 p = origin + int2(i % span, i / span);
+		gs_input[i] = ssaoBuffer.SampleLevel(linearMipSampler, (p + 0.5f) / RTSize, 0).r;
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	// Rows: every apron row, only the tile's columns.
+	for (int j = threadIndex; j < span * FUSED_TILE; j += FUSED_TILE * FUSED_TILE)
+	{
+		int row = j / FUSED_TILE;
+		int column = j % FUSED_TILE + radius;
+		float sum = 0.0f;
+		for (int k = -radius; k <= radius; ++k)
+		{
+			sum += gs_input[row * span + column + k] * fused_weight(k);
+		}
+		gs_rows[row * FUSED_TILE + j % FUSED_TILE] = sum;
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	// Columns, one output texel per thread.
+	float output = 0.0f;
+	for (int k = -radius; k <= radius; ++k)
+	{
+		output += gs_rows[(threadId.y + radius + k) * FUSED_TILE + threadId.x] * fused_weight(k);
+	}
+
+	int2 texel = int2(groupId.xy) * FUSED_TILE + int2(threadId.xy);
+	if (all(texel < int2(RTSize)))
+	{
+		blurOutput[texel] = output;
+	}
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Developed by Masaki Kawase, Bunkasha Games
 // Used in DOUBLE-S.T.E.A.L. (aka Wreckless)
@@ -489,4 +780,42 @@ float PS_BLUR_KAWASE_SML(VertexOutput input) : SV_TARGET
 	float cOut = DoKawase(input.uv, dUV);
 
 	return cOut;
-}
\ No newline at end of file
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dual filter, Marius Bjorge - Bandwidth-Efficient Rendering (SIGGRAPH 2015)
+// Kawase style taps on a pyramid: each down pass halves the target, each up pass doubles it back.
+// The levels have different sizes so texel sizes come from the bound source (SourceTexelSize()),
+// not g_downsampleBlurFac. blur_dual_filter() (Framework/KawaseBlur.h) is the CPU version.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Centre x4 plus the four corners of the output pixel (one source texel out on the diagonals).
+float PS_BLUR_DUAL_DOWN(VertexOutput input) : SV_TARGET
+{
+	float2 texel = SourceTexelSize();
+
+	float output = ssaoBuffer.Sample(linearMipSampler, input.uv).r * 4.0f;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(-texel.x, -texel.y)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2( texel.x, -texel.y)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2( texel.x,  texel.y)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(-texel.x,  texel.y)).r;
+
+	return output * (1.0f / 8.0f);
+}
+
+// One source texel out on the axes, half a texel out on the diagonals weighted x2.
+float PS_BLUR_DUAL_UP(VertexOutput input) : SV_TARGET
+{
+	float2 texel = SourceTexelSize();
+	float2 halfTexel = texel * 0.5f;
+
+	float output = ssaoBuffer.Sample(linearMipSampler, input.uv + float2(-texel.x, 0.0f)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2( texel.x, 0.0f)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(0.0f, -texel.y)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(0.0f,  texel.y)).r;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(-halfTexel.x, -halfTexel.y)).r * 2.0f;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2( halfTexel.x, -halfTexel.y)).r * 2.0f;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2( halfTexel.x,  halfTexel.y)).r * 2.0f;
+	output += ssaoBuffer.Sample(linearMipSampler, input.uv + float2(-halfTexel.x,  halfTexel.y)).r * 2.0f;
+
+	return output * (1.0f / 12.0f);
+}
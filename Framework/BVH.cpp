@@ -0,0 +1,416 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define BVH_SSE2 1
+#endif
+
+using hlsl::float3;
+
+namespace
+{
+	inline f32 axis_value(const float3& v, u32 axis) { return (&v.x)[axis]; }
+
+	inline float3 min3(const float3& a, const float3& b) { return float3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)); }
+	inline float3 max3(const float3& a, const float3& b) { return float3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)); }
+
+	inline f32 half_area(const float3& boundsMin, const float3& boundsMax)
+	{
+		const float3 e = boundsMax - boundsMin;
+		return e.x * e.y + e.y * e.z + e.z * e.x;
+	}
+
+	struct Box
+	{
+		float3 boundsMin = float3(FLT_MAX);
+		float3 boundsMax = float3(-FLT_MAX);
+
+		void grow(const float3& p) { boundsMin = min3(boundsMin, p); boundsMax = max3(boundsMax, p); }
+		void grow(const float3& bMin, const float3& bMax) { boundsMin = min3(boundsMin, bMin); boundsMax = max3(boundsMax, bMax); }
+		f32 area() const { return boundsMin.x > boundsMax.x ? 0.f : half_area(boundsMin, boundsMax); }
+	};
+
+	// Keeps 1 / d finite, so a slab test never does 0 * inf.
+	inline f32 safe_inverse(f32 d)
+	{
+		const f32 kMin = 1e-12f;
+		return 1.f / (std::fabs(d) < kMin ? (d < 0.f ? -kMin : kMin) : d);
+	}
+
+	// Slab test, the SSE2 lanes do the same ops in the same order.
+	inline bool hit_box(const BVH::Node& node, const float3& o, const float3& invD, f32 tMax)
+	{
+		const f32 t0x = (node.boundsMin.x - o.x) * invD.x, t1x = (node.boundsMax.x - o.x) * invD.x;
+		const f32 t0y = (node.boundsMin.y - o.y) * invD.y, t1y = (node.boundsMax.y - o.y) * invD.y;
+		const f32 t0z = (node.boundsMin.z - o.z) * invD.z, t1z = (node.boundsMax.z - o.z) * invD.z;
+		const f32 tNear = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::min(t0z, t1z));
+		const f32 tFar = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::max(t0z, t1z));
+		return tNear <= tFar && tFar > 0.f && tNear < tMax;
+	}
+
+	constexpr f32 kMinDeterminant = 1e-12f;
+
+	// Moller-Trumbore, two sided. Lowers t when the triangle is nearer.
+	inline void hit_triangle(const BVH::Triangle& tri, const float3& o, const float3& d, f32& t)
+	{
+		const float3 p = hlsl::cross(d, tri.e2);
+		const f32 det = hlsl::dot(tri.e1, p);
+		if (std::fabs(det) <= kMinDeterminant)
+			return;
+
+		const f32 invDet = 1.f / det;
+		const float3 s = o - tri.v0;
+		const f32 u = hlsl::dot(s, p) * invDet;
+		const float3 q = hlsl::cross(s, tri.e1);
+		const f32 v = hlsl::dot(d, q) * invDet;
+		const f32 hitT = hlsl::dot(tri.e2, q) * invDet;
+		if (u >= 0.f && u <= 1.f && v >= 0.f && u + v <= 1.f && hitT > 0.f && hitT < t)
+		{
+			t = hitT;
+		}
+	}
+}
+
+void BVH::clear()
+{
+	m_input.clear();
+	m_nodes.clear();
+	m_triangles.clear();
+	m_stats = Stats();
+}
+
+void BVH::add(const f32* pPositions, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount, const hlsl::float4x4& matModel)
+{
+	ASSERT(m_nodes.empty());
+
+	auto position = [&](u32 index)
+	{
+		ASSERT(index < vertexCount);
+		const f32* p = (const f32*)((const u8*)pPositions + (size_t)index * strideBytes);
+		return hlsl::mul(hlsl::float4(p[0], p[1], p[2], 1.f), matModel).xyz();
+	};
+
+	const u32 count = pIndices ? indexCount : vertexCount;
+	for (u32 i = 0; i + 2 < count; i += 3)
+	{
+		BuildTriangle tri;
+		for (u32 j = 0; j < 3; ++j)
+		{
+			tri.v[j] = position(pIndices ? pIndices[i + j] : i + j);
+		}
+		tri.boundsMin = min3(min3(tri.v[0], tri.v[1]), tri.v[2]);
+		tri.boundsMax = max3(max3(tri.v[0], tri.v[1]), tri.v[2]);
+		tri.centroid = (tri.boundsMin + tri.boundsMax) * 0.5f;
+		m_input.push_back(tri);
+	}
+}
+
+void BVH::build()
+{
+	m_nodes.clear();
+	m_triangles.clear();
+	m_stats = Stats();
+
+	const u32 count = (u32)m_input.size();
+	if (!count)
+		return;
+
+	std::vector<u32> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+
+	m_nodes.reserve(2 * (count / kMaxLeafTriangles + 1));
+	m_triangles.reserve(count);
+	m_nodes.push_back(Node());
+
+	struct Task
+	{
+		u32 node;
+		u32 begin;
+		u32 end;
+		u32 depth;
+	};
+	std::vector<Task> tasks;
+	tasks.push_back({ 0, 0, count, 1 });
+
+	f64 sahCost = 0.0;
+	f32 rootArea = 0.f;
+
+	while (!tasks.empty())
+	{
+		const Task task = tasks.back();
+		tasks.pop_back();
+
+		Box bounds, centroids;
+		for (u32 i = task.begin; i < task.end; ++i)
+		{
+			const BuildTriangle& tri = m_input[order[i]];
+			bounds.grow(tri.boundsMin, tri.boundsMax);
+			centroids.grow(tri.centroid);
+		}
+		m_nodes[task.node].boundsMin = bounds.boundsMin;
+		m_nodes[task.node].boundsMax = bounds.boundsMax;
+		m_stats.maxDepth = std::max(m_stats.maxDepth, task.depth);
+
+		const f32 area = bounds.area();
+		if (task.node == 0)
+		{
+			rootArea = std::max(area, FLT_MIN);
+		}
+
+		const u32 n = task.end - task.begin;
+		if (n <= kMaxLeafTriangles || task.depth >= kMaxDepth)
+		{
+			Node& leaf = m_nodes[task.node];
+			leaf.first = (u32)m_triangles.size();
+			leaf.count = (u16)n;
+			leaf.axis = 0;
+			for (u32 i = task.begin; i < task.end; ++i)
+			{
+				const BuildTriangle& tri = m_input[order[i]];
+				m_triangles.push_back({ tri.v[0], tri.v[1] - tri.v[0], tri.v[2] - tri.v[0] });
+			}
+			++m_stats.leaves;
+			sahCost += area / rootArea * n;
+			continue;
+		}
+
+		// Binned SAH over the centroids, the split between bins with the lowest area * count on both sides.
+		u32 bestAxis = 0;
+		u32 bestSplit = 0;
+		f32 bestCost = FLT_MAX;
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			const f32 lo = axis_value(centroids.boundsMin, axis);
+			const f32 extent = axis_value(centroids.boundsMax, axis) - lo;
+			if (extent <= 0.f)
+				continue;
+
+			Box bins[kBins];
+			u32 binCounts[kBins] = {};
+			const f32 scale = kBins / extent;
+			for (u32 i = task.begin; i < task.end; ++i)
+			{
+				const BuildTriangle& tri = m_input[order[i]];
+				const u32 bin = std::min(kBins - 1, (u32)((axis_value(tri.centroid, axis) - lo) * scale));
+				bins[bin].grow(tri.boundsMin, tri.boundsMax);
+				++binCounts[bin];
+			}
+
+			// Area * count of everything right of split, then sweep the left side towards it.
+			f32 rightCost[kBins];
+			Box right;
+			u32 rightCount = 0;
+			for (u32 split = kBins - 1; split > 0; --split)
+			{
+				right.grow(bins[split].boundsMin, bins[split].boundsMax);
+				rightCount += binCounts[split];
+				rightCost[split] = right.area() * rightCount;
+			}
+
+			Box left;
+			u32 leftCount = 0;
+			for (u32 split = 1; split < kBins; ++split)
+			{
+				left.grow(bins[split - 1].boundsMin, bins[split - 1].boundsMax);
+				leftCount += binCounts[split - 1];
+				const f32 cost = left.area() * leftCount + rightCost[split];
+				if (leftCount && leftCount < n && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		u32 middle = task.begin;
+		if (bestSplit)
+		{
+			const f32 lo = axis_value(centroids.boundsMin, bestAxis);
+			const f32 scale = kBins / (axis_value(centroids.boundsMax, bestAxis) - lo);
+			middle = (u32)(std::partition(order.begin() + task.begin, order.begin() + task.end, [&](u32 index)
+			{
+				const u32 bin = std::min(kBins - 1, (u32)((axis_value(m_input[index].centroid, bestAxis) - lo) * scale));
+				return bin < bestSplit;
+			}) - order.begin());
+		}
+
+		// Every centroid in one place, any split is as good as another.
+		if (middle == task.begin || middle == task.end)
+		{
+			middle = task.begin + n / 2;
+		}
+
+		const u32 children = (u32)m_nodes.size();
+		m_nodes.push_back(Node());
+		m_nodes.push_back(Node());
+
+		Node& node = m_nodes[task.node];
+		node.first = children;
+		node.count = 0;
+		node.axis = (u16)bestAxis;
+		sahCost += area / rootArea;
+
+		tasks.push_back({ children + 1, middle, task.end, task.depth + 1 });
+		tasks.push_back({ children, task.begin, middle, task.depth + 1 });
+	}
+
+	m_input.clear();
+	m_input.shrink_to_fit();
+
+	m_stats.triangles = (u32)m_triangles.size();
+	m_stats.nodes = (u32)m_nodes.size();
+	m_stats.sahCost = (f32)sahCost;
+}
+
+f32 BVH::closest_hit(const float3& origin, const float3& dir, f32 tMax) const
+{
+	if (m_nodes.empty() || tMax <= 0.f)
+		return tMax;
+
+	const float3 invD(safe_inverse(dir.x), safe_inverse(dir.y), safe_inverse(dir.z));
+
+	u32 stack[2 * kMaxDepth];
+	u32 top = 0;
+	stack[top++] = 0;
+
+	f32 t = tMax;
+	while (top)
+	{
+		const Node& node = m_nodes[stack[--top]];
+		if (!hit_box(node, origin, invD, t))
+			continue;
+
+		if (node.leaf())
+		{
+			for (u32 i = node.first; i < node.first + node.count; ++i)
+			{
+				hit_triangle(m_triangles[i], origin, dir, t);
+			}
+			continue;
+		}
+
+		// Far child first on the stack so the near one is walked first.
+		const bool leftFirst = axis_value(dir, node.axis) >= 0.f;
+		stack[top++] = leftFirst ? node.first + 1 : node.first;
+		stack[top++] = leftFirst ? node.first : node.first + 1;
+	}
+	return t;
+}
+
+#if BVH_SSE2
+void BVH::closest_hit_4(const Ray4& rays, f32 tOut[4]) const
+{
+	_mm_storeu_ps(tOut, _mm_loadu_ps(rays.tMax));
+	if (m_nodes.empty())
+		return;
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 minDet = _mm_set1_ps(kMinDeterminant);
+
+	const __m128 ox = _mm_loadu_ps(rays.ox), oy = _mm_loadu_ps(rays.oy), oz = _mm_loadu_ps(rays.oz);
+	const __m128 dx = _mm_loadu_ps(rays.dx), dy = _mm_loadu_ps(rays.dy), dz = _mm_loadu_ps(rays.dz);
+	f32 inv[3][4];
+	for (u32 i = 0; i < 4; ++i)
+	{
+		inv[0][i] = safe_inverse(rays.dx[i]);
+		inv[1][i] = safe_inverse(rays.dy[i]);
+		inv[2][i] = safe_inverse(rays.dz[i]);
+	}
+	const __m128 invX = _mm_loadu_ps(inv[0]), invY = _mm_loadu_ps(inv[1]), invZ = _mm_loadu_ps(inv[2]);
+	const __m128 active = _mm_cmpgt_ps(_mm_loadu_ps(rays.tMax), zero);
+	__m128 t = _mm_loadu_ps(rays.tMax);
+
+	// Front to back by the packet's average direction.
+	const f32 dirSum[3] = {
+		rays.dx[0] + rays.dx[1] + rays.dx[2] + rays.dx[3],
+		rays.dy[0] + rays.dy[1] + rays.dy[2] + rays.dy[3],
+		rays.dz[0] + rays.dz[1] + rays.dz[2] + rays.dz[3] };
+
+	u32 stack[2 * kMaxDepth];
+	u32 top = 0;
+	stack[top++] = 0;
+
+	while (top)
+	{
+		const Node& node = m_nodes[stack[--top]];
+
+		const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.x), ox), invX);
+		const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.x), ox), invX);
+		const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.y), oy), invY);
+		const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.y), oy), invY);
+		const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.z), oz), invZ);
+		const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.z), oz), invZ);
+		const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)), _mm_min_ps(t0z, t1z));
+		const __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)), _mm_max_ps(t0z, t1z));
+		const __m128 hit = _mm_and_ps(_mm_and_ps(active, _mm_cmple_ps(tNear, tFar)), _mm_and_ps(_mm_cmpgt_ps(tFar, zero), _mm_cmplt_ps(tNear, t)));
+		if (!_mm_movemask_ps(hit))
+			continue;
+
+		if (!node.leaf())
+		{
+			const bool leftFirst = dirSum[node.axis] >= 0.f;
+			stack[top++] = leftFirst ? node.first + 1 : node.first;
+			stack[top++] = leftFirst ? node.first : node.first + 1;
+			continue;
+		}
+
+		for (u32 i = node.first; i < node.first + node.count; ++i)
+		{
+			const Triangle& tri = m_triangles[i];
+			const __m128 e1x = _mm_set1_ps(tri.e1.x), e1y = _mm_set1_ps(tri.e1.y), e1z = _mm_set1_ps(tri.e1.z);
+			const __m128 e2x = _mm_set1_ps(tri.e2.x), e2y = _mm_set1_ps(tri.e2.y), e2z = _mm_set1_ps(tri.e2.z);
+
+			// p = cross(d, e2)
+			const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+			const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+			const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+			const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			const __m128 invDet = _mm_div_ps(one, det);
+
+			const __m128 sx = _mm_sub_ps(ox, _mm_set1_ps(tri.v0.x));
+			const __m128 sy = _mm_sub_ps(oy, _mm_set1_ps(tri.v0.y));
+			const __m128 sz = _mm_sub_ps(oz, _mm_set1_ps(tri.v0.z));
+			const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+			// q = cross(s, e1)
+			const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+			const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+			const __m128 hitT = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+			__m128 mask = _mm_cmpgt_ps(_mm_and_ps(det, absMask), minDet);
+			mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+			mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+			mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(hitT, zero), _mm_cmplt_ps(hitT, t)));
+			t = _mm_or_ps(_mm_and_ps(mask, hitT), _mm_andnot_ps(mask, t));
+		}
+	}
+	_mm_storeu_ps(tOut, t);
+}
+#else
+void BVH::closest_hit_4(const Ray4& rays, f32 tOut[4]) const
+{
+	for (u32 i = 0; i < 4; ++i)
+	{
+		tOut[i] = closest_hit(float3(rays.ox[i], rays.oy[i], rays.oz[i]), float3(rays.dx[i], rays.dy[i], rays.dz[i]), rays.tMax[i]);
+	}
+}
+#endif
+
+const char* bvh_isa()
+{
+#if BVH_SSE2
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "ShaderMath.h"
+
+#include <vector>
+
+//================================================================================
+// Bounding Volume Hierarchy
+// Triangle BVH for CPU ray casting. Meshes are added in world space (positions
+// times matModel, like the geometry pass) then build() splits them top down
+// with a binned surface area heuristic into leaves of at most kMaxLeafTriangles.
+//
+// Nodes are 32 bytes with both children next to each other, triangles are
+// stored in leaf order as a vertex and two edges for Moller-Trumbore.
+// closest_hit_4() walks four rays down together (an SSE2 op per slab / triangle
+// test when the target has it), which pays off when the rays start close to
+// each other - the AO rays of one pixel.
+//
+// Only standard headers so it builds with the CPU tools.
+//================================================================================
+class BVH
+{
+public:
+	static constexpr u32 kMaxLeafTriangles = 4;
+	static constexpr u32 kBins = 16;
+	static constexpr u32 kMaxDepth = 64;
+
+	struct Node
+	{
+		hlsl::float3 boundsMin;
+		u32 first;			// leaf: first triangle, interior: left child (right is first + 1).
+		hlsl::float3 boundsMax;
+		u16 count;			// triangles, 0 for interior nodes.
+		u16 axis;			// interior: split axis, for front to back traversal.
+
+		bool leaf() const { return count != 0; }
+	};
+
+	struct Triangle
+	{
+		hlsl::float3 v0;
+		hlsl::float3 e1;	// v1 - v0
+		hlsl::float3 e2;	// v2 - v0
+	};
+
+	struct Stats
+	{
+		u32 triangles = 0;
+		u32 nodes = 0;
+		u32 leaves = 0;
+		u32 maxDepth = 0;
+		f32 sahCost = 0.f;		// expected cost of a random ray, triangle tests and node visits at the same price.
+	};
+
+	// Four rays, lane i of each array. Lanes with tMax <= 0 are inactive.
+	struct Ray4
+	{
+		f32 ox[4], oy[4], oz[4];
+		f32 dx[4], dy[4], dz[4];
+		f32 tMax[4];
+	};
+
+	void clear();
+
+	// pPositions points at the first vertex's x, positions are strideBytes apart. pIndices is a u16
+	// triangle list, or null when the vertices are.
+	void add(const f32* pPositions, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount, const hlsl::float4x4& matModel);
+
+	// Builds the hierarchy over everything added since clear(), nothing can be added after.
+	void build();
+
+	// Distance to the nearest triangle along dir (needn't be normalised, t is in its units) in
+	// (0, tMax), tMax when there is none. Both faces are hit, like the app's raster states.
+	f32 closest_hit(const hlsl::float3& origin, const hlsl::float3& dir, f32 tMax) const;
+
+	// closest_hit() for four rays at once, tOut[i] as it would return for lane i.
+	void closest_hit_4(const Ray4& rays, f32 tOut[4]) const;
+
+	bool empty() const { return m_nodes.empty(); }
+	const Stats& stats() const { return m_stats; }
+	const std::vector<Node>& nodes() const { return m_nodes; }
+	const std::vector<Triangle>& triangles() const { return m_triangles; }
+
+private:
+	struct BuildTriangle
+	{
+		hlsl::float3 v[3];
+		hlsl::float3 boundsMin;
+		hlsl::float3 boundsMax;
+		hlsl::float3 centroid;
+	};
+
+	std::vector<BuildTriangle> m_input;
+	std::vector<Node> m_nodes;
+	std::vector<Triangle> m_triangles;
+	Stats m_stats;
+};
+
+// "SSE2" or "Scalar", what closest_hit_4() was compiled with.
+const char* bvh_isa();
@@ -0,0 +1,176 @@
+#include "CommandBuffer.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+
+//================================================================================
+// CommandBuffer
+//================================================================================
+
+void CommandBuffer::clear()
+{
+	m_words.clear();
+}
+
+void CommandBuffer::bind_shader(u32 shader)
+{
+	m_words.push_back((u32)RecordedOp::kBindShader);
+	m_words.push_back(shader);
+}
+
+void CommandBuffer::bind_mesh(u32 mesh)
+{
+	m_words.push_back((u32)RecordedOp::kBindMesh);
+	m_words.push_back(mesh);
+}
+
+void CommandBuffer::bind_material(u32 material)
+{
+	m_words.push_back((u32)RecordedOp::kBindMaterial);
+	m_words.push_back(material);
+}
+
+void CommandBuffer::draw(const DrawCommand& cmd)
+{
+	const u32 words[] = {
+		(u32)RecordedOp::kDraw,
+		(u32)cmd.key,
+		(u32)(cmd.key >> 32),
+		cmd.firstInstance,
+		cmd.instanceCount,
+		cmd.userData
+	};
+	m_words.insert(m_words.end(), words, words + 6);
+}
+
+void CommandBuffer::replay(DrawListBackend& backend) const
+{
+	const u32* p = m_words.data();
+	const u32* pEnd = p + m_words.size();
+
+	while (p < pEnd)
+	{
+		switch ((RecordedOp)p[0])
+		{
+		case RecordedOp::kBindShader:
+			backend.bind_shader(p[1]);
+			p += 2;
+			break;
+		case RecordedOp::kBindMesh:
+			backend.bind_mesh(p[1]);
+			p += 2;
+			break;
+		case RecordedOp::kBindMaterial:
+			backend.bind_material(p[1]);
+			p += 2;
+			break;
+		case RecordedOp::kDraw:
+		{
+			DrawCommand cmd;
+			cmd.key = (u64)p[1] | ((u64)p[2] << 32);
+			cmd.firstInstance = p[3];
+			cmd.instanceCount = p[4];
+			cmd.userData = p[5];
+			backend.draw(cmd);
+			p += 6;
+		}
+		break;
+		default:
+			ASSERT(!"Corrupt command buffer");
+			return;
+		}
+	}
+	ASSERT(p == pEnd);
+}
+
+void CommandBuffer::assign(const u32* pWords, u32 count)
+{
+	m_words.assign(pWords, pWords + count);
+}
+
+//================================================================================
+// RecordedPass
+//================================================================================
+
+void RecordedPass::replay(DrawListBackend& backend) const
+{
+	for (u32 i = 0; i < buffersUsed; ++i)
+	{
+		buffers[i].replay(backend);
+	}
+}
+
+//================================================================================
+// CommandRecorder
+//================================================================================
+
+CommandRecorder::CommandRecorder(u32 workers)
+{
+	if (!workers)
+	{
+		const u32 hardwareThreads = std::thread::hardware_concurrency();
+		workers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	for (u32 i = 0; i < workers; ++i)
+	{
+		m_workers.emplace_back(new JobQueue());
+		m_workers.back()->launch();
+		m_workers.back()->pushJob([i]
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "Recorder %u", i + 1);
+			TRACE_THREAD_NAME(name);
+		});
+	}
+}
+
+void CommandRecorder::record(const DrawList& list, u32 pass, RecordedPass& out)
+{
+	u32 first, count;
+	list.pass_range(pass, first, count);
+
+	const u32 maxRanges = (u32)m_workers.size() + 1;
+	const u32 ranges = std::max(1u, std::min(maxRanges, count / kMinDrawsPerRange));
+	const u32 perRange = (count + ranges - 1) / ranges;
+
+	if (out.buffers.size() < ranges)
+	{
+		out.buffers.resize(ranges);
+	}
+	out.buffersUsed = ranges;
+	out.stats = DrawListStats();
+
+	// Each range counts into its own stats, merged once everyone's done.
+	DrawListStats rangeStats[64];
+	ASSERT(ranges <= 64);
+
+	auto record_range = [&list, &out, &rangeStats, first, count, perRange](u32 range)
+	{
+		const u32 begin = std::min(count, range * perRange);
+		const u32 end = std::min(count, begin + perRange);
+		TRACE_SCOPE_CAT("job", "Record Command Buffer");
+
+		CommandBuffer& buffer = out.buffers[range];
+		buffer.clear();
+		list.submit_range(buffer, first + begin, end - begin, rangeStats[range]);
+	};
+
+	for (u32 range = 1; range < ranges; ++range)
+	{
+		m_workers[range - 1]->pushJob([&record_range, range] { record_range(range); });
+	}
+
+	record_range(0);
+
+	for (u32 range = 1; range < ranges; ++range)
+	{
+		m_workers[range - 1]->waitAll();
+	}
+
+	for (u32 range = 0; range < ranges; ++range)
+	{
+		out.stats.add(rangeStats[range]);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "DrawList.h"
+#include "JobQueue.h"
+
+#include <memory>
+#include <vector>
+
+//================================================================================
+// Command Buffers
+// A backend neutral recording of draw list calls. CommandBuffer is itself a
+// DrawListBackend, so DrawList::submit_range() into one records the binds and
+// draws as a stream of u32 words, and replay() plays them into any other
+// backend later (the D3D11 one, a counting one in a test, ...). The words are
+// plain data, they can be written out and loaded back with assign().
+//
+// CommandRecorder splits a pass of a sorted DrawList into disjoint ranges and
+// records each into its own buffer on a worker thread (JobQueue). Replaying the
+// buffers in range order gives the same draws as DrawList::submit(), each range
+// just starts with nothing bound.
+//================================================================================
+
+enum class RecordedOp : u32
+{
+	kBindShader,		// id
+	kBindMesh,			// id
+	kBindMaterial,		// id
+	kDraw,				// key lo, key hi, firstInstance, instanceCount, userData
+};
+
+class CommandBuffer final : public DrawListBackend
+{
+public:
+	void clear();
+	void reserve(u32 words) { m_words.reserve(words); }
+
+	// DrawListBackend, appends to the recording.
+	void bind_shader(u32 shader) override;
+	void bind_mesh(u32 mesh) override;
+	void bind_material(u32 material) override;
+	void draw(const DrawCommand& cmd) override;
+
+	// Plays the recording into backend, in order.
+	void replay(DrawListBackend& backend) const;
+
+	// The recording, and loading one back.
+	const std::vector<u32>& words() const { return m_words; }
+	void assign(const u32* pWords, u32 count);
+
+	bool empty() const { return m_words.empty(); }
+	u32 size_bytes() const { return (u32)(m_words.size() * sizeof(u32)); }
+
+private:
+	std::vector<u32> m_words;
+};
+
+// Buffers of one pass in draw order plus the draw list stats of recording them.
+struct RecordedPass
+{
+	std::vector<CommandBuffer> buffers;
+	u32 buffersUsed = 0;
+	DrawListStats stats;
+
+	void replay(DrawListBackend& backend) const;
+};
+
+class CommandRecorder
+{
+public:
+	// Below this a range isn't worth a thread, small passes are recorded on the calling thread.
+	static constexpr u32 kMinDrawsPerRange = 256;
+
+	// workers == 0 picks one less than the hardware threads.
+	explicit CommandRecorder(u32 workers = 0);
+
+	// Records pass of list (sorted) into out, blocks until done. The calling thread records the first range.
+	void record(const DrawList& list, u32 pass, RecordedPass& out);
+
+	u32 workers() const { return (u32)m_workers.size(); }
+
+private:
+	std::vector<std::unique_ptr<JobQueue>> m_workers;
+};
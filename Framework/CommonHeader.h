@@ -4,13 +4,11 @@
 // Common C/C++ headers from the standard
 //////////////////////////////////////////////////////////////////////////
 
-#include <cstdint>
-#include <cassert>
-#include <cmath>
 #include <cstdarg>
-#include <cstddef>
 #include <cstdio>
-#include <cstring>
+
+// Platform neutral typedefs and maths helpers.
+#include "CoreTypes.h"
 
 
 #include <algorithm>
@@ -56,33 +54,6 @@ using Microsoft::WRL::ComPtr;
 //////////////////////////////////////////////////////////////////////////
 #include "imgui/imgui.h"
 
-//////////////////////////////////////////////////////////////////////////
-// Common game industry typedefs
-//  * Very compact when used in expressions.
-//  * Express the size in bytes.
-//////////////////////////////////////////////////////////////////////////
-
-// Unsigned
-using u8 = uint8_t;
-using u16 = uint16_t;
-using u32 = uint32_t;
-using u64 = uint64_t;
-
-// Signed
-using s8 = int8_t;
-using s16 = int16_t;
-using s32 = int32_t;
-using s64 = int64_t;
-
-// Floating point
-using f32 = float;
-using f64 = double;
-
-// Memory
-using memtype_t = u8;
-constexpr u64 KB = 1024;
-constexpr u64 MB = 1024 * KB;
-
 // Vector maths.
 using v2 = DirectX::SimpleMath::Vector2;
 using v3 = DirectX::SimpleMath::Vector3;
@@ -92,11 +63,9 @@ using m3x3 = DirectX::XMFLOAT3X3;
 using quat = DirectX::SimpleMath::Quaternion;
 
 //////////////////////////////////////////////////////////////////////////
-// Useful assertion macro
+// COM release helper (ASSERT lives in CoreTypes.h)
 //////////////////////////////////////////////////////////////////////////
 
-#define ASSERT(x) if(!(x)){ __debugbreak(); }
-
 #define SAFE_RELEASE(ptr) if(ptr){ ptr->Release(); }
 
 // ========================================================
@@ -114,25 +83,9 @@ void debugF(const char * format, ...);
 
 
 // ========================================================
-// Frequently used maths
+// Frequently used maths (constants are in CoreTypes.h)
 // ========================================================
 
-constexpr f32 kfPI = 3.1415926535897931f;
-constexpr f32 kfHalfPI = 0.5f * kfPI;
-constexpr f32 kfTwoPI = 2.0f * kfPI;
-
-// Angle in degrees to angle in radians
-constexpr f32 degToRad(const f32 degrees)
-{
-	return degrees * kfPI / 180.0f;
-}
-
-// Angle in radians to angle in degrees
-constexpr f32 radToDeg(const f32 radians)
-{
-	return radians * 180.0f / kfPI;
-}
-
 // Random numbers (0, 1) and (-1, 1) for floats and vectors.
 inline f32 randf_norm() { return (float)rand() / RAND_MAX; }
 inline f32 randf() { return randf_norm() * 2.0f - 1.0f; }
@@ -0,0 +1,70 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+// Platform neutral core types.
+// Only standard headers in here so CPU side code (references, tools,
+// allocators...) can be compiled without windows or directX.
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////////
+// Common game industry typedefs
+//  * Very compact when used in expressions.
+//  * Express the size in bytes.
+//////////////////////////////////////////////////////////////////////////
+
+// Unsigned
+using u8 = uint8_t;
+using u16 = uint16_t;
+using u32 = uint32_t;
+using u64 = uint64_t;
+
+// Signed
+using s8 = int8_t;
+using s16 = int16_t;
+using s32 = int32_t;
+using s64 = int64_t;
+
+// Floating point
+using f32 = float;
+using f64 = double;
+
+// Memory
+using memtype_t = u8;
+constexpr u64 KB = 1024;
+constexpr u64 MB = 1024 * KB;
+
+//////////////////////////////////////////////////////////////////////////
+// Useful assertion macro
+//////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+	#define ASSERT(x) if(!(x)){ __debugbreak(); }
+#else
+	#define ASSERT(x) assert(x)
+#endif
+
+// ========================================================
+// Frequently used maths
+// ========================================================
+
+constexpr f32 kfPI = 3.1415926535897931f;
+constexpr f32 kfHalfPI = 0.5f * kfPI;
+constexpr f32 kfTwoPI = 2.0f * kfPI;
+
+// Angle in degrees to angle in radians
+constexpr f32 degToRad(const f32 degrees)
+{
+	return degrees * kfPI / 180.0f;
+}
+
+// Angle in radians to angle in degrees
+constexpr f32 radToDeg(const f32 radians)
+{
+	return radians * 180.0f / kfPI;
+}
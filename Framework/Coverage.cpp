@@ -0,0 +1,112 @@
+#include "Coverage.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr s64 kSubTexel = 256;	// D3D11 snaps vertices to 8 bits of sub texel precision.
+
+	struct Point
+	{
+		s64 x, y;	// sub texels, y down.
+	};
+
+	// > 0 when p is on the inside of a -> b for the winding rasterise_coverage() settles on.
+	inline s64 edge(const Point& a, const Point& b, s64 px, s64 py)
+	{
+		return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+	}
+
+	// First / last texel whose centre is at or after lo / at or before hi, clamped to >= 0 / -1.
+	inline s64 first_centre(s64 lo) { return lo <= kSubTexel / 2 ? 0 : (lo - kSubTexel / 2 + kSubTexel - 1) / kSubTexel; }
+	inline s64 last_centre(s64 hi) { return hi < kSubTexel / 2 ? -1 : (hi - kSubTexel / 2) / kSubTexel; }
+
+	// With y down and that winding a top edge runs right and a left edge runs up.
+	inline bool top_left(const Point& a, const Point& b)
+	{
+		const s64 dx = b.x - a.x;
+		const s64 dy = b.y - a.y;
+		return dy < 0 || (dy == 0 && dx > 0);
+	}
+}
+
+CoverageResult rasterise_coverage(const f32* pNdcXY, u32 triangles, u32 width, u32 height, std::vector<u8>* pCountsOut)
+{
+	std::vector<u8> localCounts;
+	std::vector<u8>& counts = pCountsOut ? *pCountsOut : localCounts;
+	counts.assign((size_t)width * height, 0);
+
+	for (u32 t = 0; t < triangles; ++t)
+	{
+		Point v[3];
+		for (u32 i = 0; i < 3; ++i)
+		{
+			const f32 ndcX = pNdcXY[(t * 3 + i) * 2 + 0];
+			const f32 ndcY = pNdcXY[(t * 3 + i) * 2 + 1];
+			v[i].x = (s64)std::llround((ndcX * 0.5f + 0.5f) * width * kSubTexel);
+			v[i].y = (s64)std::llround((0.5f - ndcY * 0.5f) * height * kSubTexel);
+		}
+
+		// One winding for every triangle, degenerate ones cover nothing.
+		const s64 area = edge(v[0], v[1], v[2].x, v[2].y);
+		if (area == 0)
+			continue;
+		if (area < 0)
+			std::swap(v[1], v[2]);
+
+		const bool topLeft[3] = { top_left(v[0], v[1]), top_left(v[1], v[2]), top_left(v[2], v[0]) };
+
+		// Texel centres inside the bounds, clipped to the target.
+		const s64 minX = std::min({ v[0].x, v[1].x, v[2].x });
+		const s64 maxX = std::max({ v[0].x, v[1].x, v[2].x });
+		const s64 minY = std::min({ v[0].y, v[1].y, v[2].y });
+		const s64 maxY = std::max({ v[0].y, v[1].y, v[2].y });
+		const s64 x0 = first_centre(minX);
+		const s64 x1 = std::min<s64>((s64)width - 1, last_centre(maxX));
+		const s64 y0 = first_centre(minY);
+		const s64 y1 = std::min<s64>((s64)height - 1, last_centre(maxY));
+
+		for (s64 y = y0; y <= y1; ++y)
+		{
+			const s64 py = y * kSubTexel + kSubTexel / 2;
+			u8* pRow = counts.data() + (size_t)y * width;
+			for (s64 x = x0; x <= x1; ++x)
+			{
+				const s64 px = x * kSubTexel + kSubTexel / 2;
+				const s64 e0 = edge(v[0], v[1], px, py);
+				const s64 e1 = edge(v[1], v[2], px, py);
+				const s64 e2 = edge(v[2], v[0], px, py);
+				const bool inside = (e0 > 0 || (e0 == 0 && topLeft[0]))
+					&& (e1 > 0 || (e1 == 0 && topLeft[1]))
+					&& (e2 > 0 || (e2 == 0 && topLeft[2]));
+				if (inside && pRow[x] < 255)
+					++pRow[x];
+			}
+		}
+	}
+
+	CoverageResult result;
+	for (u32 y = 0; y < height; ++y)
+	{
+		for (u32 x = 0; x < width; ++x)
+		{
+			const u8 count = counts[(size_t)y * width + x];
+			if (!count)
+			{
+				if (!result.uncovered)
+				{
+					result.firstUncoveredX = x;
+					result.firstUncoveredY = y;
+				}
+				++result.uncovered;
+			}
+			else
+			{
+				++result.covered;
+				result.overdrawn += count > 1 ? 1 : 0;
+			}
+		}
+	}
+	return result;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+//================================================================================
+// Coverage
+// Which texels of a target a draw writes, worked out on the CPU the way the
+// rasteriser does it: a texel is covered when its centre is inside a triangle,
+// vertices snap to 1/256 of a texel and edges through a centre follow the
+// top-left rule, so triangles sharing an edge cover its texels exactly once.
+//
+// The render graph uses it to drop clears on targets a pass overwrites anyway.
+// Triangles are NDC xy (x right, y up), three vertices each, either winding (no
+// culling). Only standard headers so it can be checked without a GPU.
+//================================================================================
+
+struct CoverageResult
+{
+	u32 covered = 0;			// texels at least one triangle covers.
+	u32 uncovered = 0;
+	u32 overdrawn = 0;			// texels more than one triangle covers.
+	u32 firstUncoveredX = 0;	// row major first, valid when uncovered != 0.
+	u32 firstUncoveredY = 0;
+
+	bool full() const { return uncovered == 0; }
+};
+
+// pCountsOut (optional) gets width * height triangle counts per texel, saturating at 255.
+CoverageResult rasterise_coverage(const f32* pNdcXY, u32 triangles, u32 width, u32 height, std::vector<u8>* pCountsOut = nullptr);
@@ -0,0 +1,294 @@
+#include "Culling.h"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define CULL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define CULL_SSE2 1
+#endif
+
+//================================================================================
+// Bounds
+//================================================================================
+
+Bounds Bounds::FromPoints(const f32* pPositions, u32 count, u32 strideBytes)
+{
+	Bounds b;
+	if (!count)
+		return b;
+
+	hlsl::float3 lo(pPositions[0], pPositions[1], pPositions[2]);
+	hlsl::float3 hi = lo;
+	for (u32 i = 1; i < count; ++i)
+	{
+		const f32* p = (const f32*)((const u8*)pPositions + (size_t)i * strideBytes);
+		lo = hlsl::float3(std::min(lo.x, p[0]), std::min(lo.y, p[1]), std::min(lo.z, p[2]));
+		hi = hlsl::float3(std::max(hi.x, p[0]), std::max(hi.y, p[1]), std::max(hi.z, p[2]));
+	}
+
+	b.center = (lo + hi) * 0.5f;
+	b.extents = (hi - lo) * 0.5f;
+
+	// Sphere around the box centre that actually touches the furthest point, usually a lot
+	// tighter than the box's corner.
+	f32 radiusSq = 0.f;
+	for (u32 i = 0; i < count; ++i)
+	{
+		const f32* p = (const f32*)((const u8*)pPositions + (size_t)i * strideBytes);
+		const hlsl::float3 d = hlsl::float3(p[0], p[1], p[2]) - b.center;
+		radiusSq = std::max(radiusSq, hlsl::dot(d, d));
+	}
+	b.radius = std::sqrt(radiusSq);
+
+	return b;
+}
+
+Bounds Bounds::FromSphere(const hlsl::float3& center, f32 radius)
+{
+	Bounds b;
+	b.center = center;
+	b.extents = hlsl::float3(radius);
+	b.radius = radius;
+	return b;
+}
+
+Bounds Bounds::transformed(const hlsl::float4x4& matModel) const
+{
+	const hlsl::float4x4& m = matModel;
+
+	Bounds b;
+	b.center = hlsl::mul(hlsl::float4(center, 1.f), m).xyz();
+
+	// Extents of the rotated box, |M| applied to the half size.
+	b.extents.x = std::fabs(m.m[0][0]) * extents.x + std::fabs(m.m[1][0]) * extents.y + std::fabs(m.m[2][0]) * extents.z;
+	b.extents.y = std::fabs(m.m[0][1]) * extents.x + std::fabs(m.m[1][1]) * extents.y + std::fabs(m.m[2][1]) * extents.z;
+	b.extents.z = std::fabs(m.m[0][2]) * extents.x + std::fabs(m.m[1][2]) * extents.y + std::fabs(m.m[2][2]) * extents.z;
+
+	const f32 scaleSq = std::max(std::max(
+		hlsl::dot(hlsl::float3(m.m[0][0], m.m[0][1], m.m[0][2]), hlsl::float3(m.m[0][0], m.m[0][1], m.m[0][2])),
+		hlsl::dot(hlsl::float3(m.m[1][0], m.m[1][1], m.m[1][2]), hlsl::float3(m.m[1][0], m.m[1][1], m.m[1][2]))),
+		hlsl::dot(hlsl::float3(m.m[2][0], m.m[2][1], m.m[2][2]), hlsl::float3(m.m[2][0], m.m[2][1], m.m[2][2])));
+	b.radius = radius * std::sqrt(scaleSq);
+
+	return b;
+}
+
+//================================================================================
+// Frustum
+//================================================================================
+
+Frustum Frustum::FromPlanes(const f32 (*pPlanes)[4])
+{
+	Frustum f;
+	for (u32 i = 0; i < 6; ++i)
+	{
+		const f32* p = pPlanes[i];
+		const f32 len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+		const f32 invLen = len > 0.f ? 1.f / len : 0.f;
+		f.x[i] = p[0] * invLen;
+		f.y[i] = p[1] * invLen;
+		f.z[i] = p[2] * invLen;
+		f.d[i] = p[3] * invLen;
+	}
+	return f;
+}
+
+Frustum Frustum::FromViewProjection(const hlsl::float4x4& matViewProj)
+{
+	// clip = mul(float4(p, 1), M), planes are combinations of M's columns. D3D clip space: -w <= x, y <= w, 0 <= z <= w.
+	const auto column = [&](u32 c) { return hlsl::float4(matViewProj.m[0][c], matViewProj.m[1][c], matViewProj.m[2][c], matViewProj.m[3][c]); };
+	const hlsl::float4 cx = column(0), cy = column(1), cz = column(2), cw = column(3);
+
+	const f32 planes[6][4] = {
+		{ cw.x - cx.x, cw.y - cx.y, cw.z - cx.z, cw.w - cx.w },	// right
+		{ cw.x + cx.x, cw.y + cx.y, cw.z + cx.z, cw.w + cx.w },	// left
+		{ cw.x + cy.x, cw.y + cy.y, cw.z + cy.z, cw.w + cy.w },	// bottom
+		{ cw.x - cy.x, cw.y - cy.y, cw.z - cy.z, cw.w - cy.w },	// top
+		{ cw.x - cz.x, cw.y - cz.y, cw.z - cz.z, cw.w - cz.w },	// far
+		{ cz.x, cz.y, cz.z, cz.w },								// near
+	};
+	return FromPlanes(planes);
+}
+
+//================================================================================
+// CullSet
+//================================================================================
+
+void CullSet::clear()
+{
+	m_cx.clear(); m_cy.clear(); m_cz.clear();
+	m_ex.clear(); m_ey.clear(); m_ez.clear();
+	m_radius.clear();
+	m_count = 0;
+}
+
+void CullSet::reserve(u32 count)
+{
+	const u32 padded = (count + 7) & ~7u;
+	m_cx.reserve(padded); m_cy.reserve(padded); m_cz.reserve(padded);
+	m_ex.reserve(padded); m_ey.reserve(padded); m_ez.reserve(padded);
+	m_radius.reserve(padded);
+}
+
+u32 CullSet::add(const Bounds& b)
+{
+	const u32 index = m_count++;
+	const u32 padded = (m_count + 7) & ~7u;
+	if (m_cx.size() < padded)
+	{
+		m_cx.resize(padded, 0.f); m_cy.resize(padded, 0.f); m_cz.resize(padded, 0.f);
+		m_ex.resize(padded, 0.f); m_ey.resize(padded, 0.f); m_ez.resize(padded, 0.f);
+		m_radius.resize(padded, 0.f);
+	}
+
+	m_cx[index] = b.center.x;
+	m_cy[index] = b.center.y;
+	m_cz[index] = b.center.z;
+	m_ex[index] = b.extents.x;
+	m_ey[index] = b.extents.y;
+	m_ez[index] = b.extents.z;
+	m_radius[index] = b.radius;
+	return index;
+}
+
+//================================================================================
+// Culling
+//================================================================================
+
+namespace
+{
+	// Appends base + bit for each set bit of the 8 bit mask, without branching on the bits.
+	inline u32 write_visible(u32* pOut, u32 count, u32 base, u32 mask)
+	{
+		for (u32 bit = 0; bit < 8; ++bit)
+		{
+			pOut[count] = base + bit;
+			count += (mask >> bit) & 1;
+		}
+		return count;
+	}
+}
+
+u32 cull_frustum_scalar(const Frustum& f, const CullSet& set, std::vector<u32>& visibleOut)
+{
+	visibleOut.resize(set.m_count);
+
+	u32 visible = 0;
+	for (u32 i = 0; i < set.m_count; ++i)
+	{
+		bool inside = true;
+		for (u32 p = 0; p < 6 && inside; ++p)
+		{
+			const f32 dist = f.x[p] * set.m_cx[i] + f.y[p] * set.m_cy[i] + f.z[p] * set.m_cz[i] + f.d[p];
+			const f32 reach = std::fabs(f.x[p]) * set.m_ex[i] + std::fabs(f.y[p]) * set.m_ey[i] + std::fabs(f.z[p]) * set.m_ez[i];
+			inside = dist + std::min(reach, set.m_radius[i]) >= 0.f;
+		}
+		if (inside)
+		{
+			visibleOut[visible++] = i;
+		}
+	}
+
+	visibleOut.resize(visible);
+	return visible;
+}
+
+u32 cull_frustum(const Frustum& f, const CullSet& set, std::vector<u32>& visibleOut)
+{
+#if CULL_AVX || CULL_SSE2
+	const u32 padded = (u32)set.m_cx.size();
+
+	// write_visible() writes all 8 lanes before advancing.
+	visibleOut.resize(padded);
+	u32* pOut = visibleOut.data();
+	u32 visible = 0;
+
+#if CULL_AVX
+	__m256 nx[6], ny[6], nz[6], nd[6], ax[6], ay[6], az[6];
+	for (u32 p = 0; p < 6; ++p)
+	{
+		nx[p] = _mm256_set1_ps(f.x[p]); ax[p] = _mm256_set1_ps(std::fabs(f.x[p]));
+		ny[p] = _mm256_set1_ps(f.y[p]); ay[p] = _mm256_set1_ps(std::fabs(f.y[p]));
+		nz[p] = _mm256_set1_ps(f.z[p]); az[p] = _mm256_set1_ps(std::fabs(f.z[p]));
+		nd[p] = _mm256_set1_ps(f.d[p]);
+	}
+	const __m256 zero = _mm256_setzero_ps();
+
+	for (u32 i = 0; i < padded; i += 8)
+	{
+		const __m256 cx = _mm256_loadu_ps(&set.m_cx[i]), cy = _mm256_loadu_ps(&set.m_cy[i]), cz = _mm256_loadu_ps(&set.m_cz[i]);
+		const __m256 ex = _mm256_loadu_ps(&set.m_ex[i]), ey = _mm256_loadu_ps(&set.m_ey[i]), ez = _mm256_loadu_ps(&set.m_ez[i]);
+		const __m256 r = _mm256_loadu_ps(&set.m_radius[i]);
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (u32 p = 0; p < 6; ++p)
+		{
+			const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[p], cx), _mm256_mul_ps(ny[p], cy)), _mm256_add_ps(_mm256_mul_ps(nz[p], cz), nd[p]));
+			const __m256 reach = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)), _mm256_mul_ps(az[p], ez));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, _mm256_min_ps(reach, r)), zero, _CMP_GE_OQ));
+		}
+
+		visible = write_visible(pOut, visible, i, (u32)_mm256_movemask_ps(inside));
+	}
+#else
+	__m128 nx[6], ny[6], nz[6], nd[6], ax[6], ay[6], az[6];
+	for (u32 p = 0; p < 6; ++p)
+	{
+		nx[p] = _mm_set1_ps(f.x[p]); ax[p] = _mm_set1_ps(std::fabs(f.x[p]));
+		ny[p] = _mm_set1_ps(f.y[p]); ay[p] = _mm_set1_ps(std::fabs(f.y[p]));
+		nz[p] = _mm_set1_ps(f.z[p]); az[p] = _mm_set1_ps(std::fabs(f.z[p]));
+		nd[p] = _mm_set1_ps(f.d[p]);
+	}
+	const __m128 zero = _mm_setzero_ps();
+
+	// 8 bounds per iteration as two independent halves, which keeps both SSE pipes busy.
+	for (u32 i = 0; i < padded; i += 8)
+	{
+		const __m128 cx0 = _mm_loadu_ps(&set.m_cx[i]), cx1 = _mm_loadu_ps(&set.m_cx[i + 4]);
+		const __m128 cy0 = _mm_loadu_ps(&set.m_cy[i]), cy1 = _mm_loadu_ps(&set.m_cy[i + 4]);
+		const __m128 cz0 = _mm_loadu_ps(&set.m_cz[i]), cz1 = _mm_loadu_ps(&set.m_cz[i + 4]);
+		const __m128 ex0 = _mm_loadu_ps(&set.m_ex[i]), ex1 = _mm_loadu_ps(&set.m_ex[i + 4]);
+		const __m128 ey0 = _mm_loadu_ps(&set.m_ey[i]), ey1 = _mm_loadu_ps(&set.m_ey[i + 4]);
+		const __m128 ez0 = _mm_loadu_ps(&set.m_ez[i]), ez1 = _mm_loadu_ps(&set.m_ez[i + 4]);
+		const __m128 r0 = _mm_loadu_ps(&set.m_radius[i]), r1 = _mm_loadu_ps(&set.m_radius[i + 4]);
+
+		__m128 inside0 = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		__m128 inside1 = inside0;
+		for (u32 p = 0; p < 6; ++p)
+		{
+			const __m128 dist0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx0), _mm_mul_ps(ny[p], cy0)), _mm_add_ps(_mm_mul_ps(nz[p], cz0), nd[p]));
+			const __m128 dist1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx1), _mm_mul_ps(ny[p], cy1)), _mm_add_ps(_mm_mul_ps(nz[p], cz1), nd[p]));
+			const __m128 reach0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex0), _mm_mul_ps(ay[p], ey0)), _mm_mul_ps(az[p], ez0));
+			const __m128 reach1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex1), _mm_mul_ps(ay[p], ey1)), _mm_mul_ps(az[p], ez1));
+			inside0 = _mm_and_ps(inside0, _mm_cmpge_ps(_mm_add_ps(dist0, _mm_min_ps(reach0, r0)), zero));
+			inside1 = _mm_and_ps(inside1, _mm_cmpge_ps(_mm_add_ps(dist1, _mm_min_ps(reach1, r1)), zero));
+		}
+
+		const u32 mask = (u32)_mm_movemask_ps(inside0) | ((u32)_mm_movemask_ps(inside1) << 4);
+		visible = write_visible(pOut, visible, i, mask);
+	}
+#endif
+
+	// Pads are all zero, a zero radius bound at the origin can pass so drop anything past the end.
+	while (visible && visibleOut[visible - 1] >= set.m_count)
+	{
+		--visible;
+	}
+	visibleOut.resize(visible);
+	return visible;
+#else
+	return cull_frustum_scalar(f, set, visibleOut);
+#endif
+}
+
+const char* cull_frustum_isa()
+{
+#if CULL_AVX
+	return "AVX";
+#elif CULL_SSE2
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "ShaderMath.h"
+
+#include <vector>
+
+//================================================================================
+// Frustum Culling
+// Meshes carry local bounds (an AABB and a sphere around the same centre), the
+// app transforms them into a CullSet each frame and cull_frustum() writes out the
+// indices that survive. The set is stored structure of arrays so 8 bounds are
+// tested against a plane per loop iteration (AVX, or two SSE halves).
+//
+// Only standard headers so it builds with the CPU benchmark.
+//================================================================================
+
+struct Bounds
+{
+	hlsl::float3 center;		// AABB centre, also the sphere centre.
+	hlsl::float3 extents;		// AABB half size.
+	f32 radius = 0.f;			// bounding sphere.
+
+	// pPositions points at the first x, positions are strideBytes apart.
+	static Bounds FromPoints(const f32* pPositions, u32 count, u32 strideBytes);
+
+	static Bounds FromSphere(const hlsl::float3& center, f32 radius);
+
+	// World bounds, the AABB of the transformed box and the sphere scaled by the largest axis scale.
+	Bounds transformed(const hlsl::float4x4& matModel) const;
+};
+
+// Planes with unit length normals, a point is inside when dot(n, p) + d >= 0 for all six.
+struct Frustum
+{
+	f32 x[6], y[6], z[6], d[6];
+
+	// From Camera::planes (or any ax + by + cz + d planes pointing inwards), renormalised on xyz.
+	static Frustum FromPlanes(const f32 (*pPlanes)[4]);
+
+	// Straight from a (row vector) view projection matrix.
+	static Frustum FromViewProjection(const hlsl::float4x4& matViewProj);
+};
+
+class CullSet
+{
+public:
+	void clear();
+	void reserve(u32 count);
+
+	// Returns the bounds' index, which is what cull_frustum() reports.
+	u32 add(const Bounds& worldBounds);
+
+	u32 size() const { return m_count; }
+
+private:
+	friend u32 cull_frustum(const Frustum& frustum, const CullSet& set, std::vector<u32>& visibleOut);
+	friend u32 cull_frustum_scalar(const Frustum& frustum, const CullSet& set, std::vector<u32>& visibleOut);
+
+	// Padded to a multiple of 8, pads are never reported.
+	std::vector<f32> m_cx, m_cy, m_cz;
+	std::vector<f32> m_ex, m_ey, m_ez;
+	std::vector<f32> m_radius;
+	u32 m_count = 0;
+};
+
+// Overwrites visibleOut with the indices of the bounds that touch the frustum, in increasing order.
+// A bound is rejected when its box or its sphere is fully behind any plane.
+u32 cull_frustum(const Frustum& frustum, const CullSet& set, std::vector<u32>& visibleOut);
+
+// One bound at a time, same answers. For validating / benchmarking the SIMD path.
+u32 cull_frustum_scalar(const Frustum& frustum, const CullSet& set, std::vector<u32>& visibleOut);
+
+// Which path cull_frustum() was compiled with: "AVX", "SSE2" or "Scalar".
+const char* cull_frustum_isa();
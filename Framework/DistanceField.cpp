@@ -0,0 +1,326 @@
+#include "DistanceField.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using hlsl::float3;
+
+namespace
+{
+	constexpr u32 kNoTriangle = ~0u;
+
+	inline f32 axis_value(const float3& v, u32 axis) { return (&v.x)[axis]; }
+
+	inline float3 min3(const float3& a, const float3& b) { return float3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)); }
+	inline float3 max3(const float3& a, const float3& b) { return float3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)); }
+
+	template <typename Fn>
+	void for_slices(WorkerPool* pPool, u32 slices, const Fn& fn)
+	{
+		if (pPool)
+		{
+			pPool->parallel_for(slices, 1, fn);
+		}
+		else
+		{
+			fn(0, slices);
+		}
+	}
+}
+
+f32 point_triangle_distance(const float3& p, const float3& a, const float3& b, const float3& c)
+{
+	// Real-Time Collision Detection 5.1.5, which Voronoi region of the triangle p is in.
+	const float3 ab = b - a;
+	const float3 ac = c - a;
+	const float3 ap = p - a;
+	const f32 d1 = hlsl::dot(ab, ap);
+	const f32 d2 = hlsl::dot(ac, ap);
+	if (d1 <= 0.f && d2 <= 0.f)
+		return hlsl::length(ap);
+
+	const float3 bp = p - b;
+	const f32 d3 = hlsl::dot(ab, bp);
+	const f32 d4 = hlsl::dot(ac, bp);
+	if (d3 >= 0.f && d4 <= d3)
+		return hlsl::length(bp);
+
+	const f32 vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+		return hlsl::length(ap - ab * (d1 / (d1 - d3)));
+
+	const float3 cp = p - c;
+	const f32 d5 = hlsl::dot(ab, cp);
+	const f32 d6 = hlsl::dot(ac, cp);
+	if (d6 >= 0.f && d5 <= d6)
+		return hlsl::length(cp);
+
+	const f32 vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+		return hlsl::length(ap - ac * (d2 / (d2 - d6)));
+
+	const f32 va = d3 * d6 - d5 * d4;
+	if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+		return hlsl::length(bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+	const f32 denom = 1.f / (va + vb + vc);
+	return hlsl::length(ap - ab * (vb * denom) - ac * (vc * denom));
+}
+
+void DistanceField::clear()
+{
+	m_triangles.clear();
+	m_distances.clear();
+	m_size[0] = m_size[1] = m_size[2] = 0;
+	m_stats = Stats();
+}
+
+void DistanceField::add(const f32* pPositions, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount, const hlsl::float4x4& matModel)
+{
+	auto position = [&](u32 index)
+	{
+		ASSERT(index < vertexCount);
+		const f32* p = (const f32*)((const u8*)pPositions + (size_t)index * strideBytes);
+		return hlsl::mul(hlsl::float4(p[0], p[1], p[2], 1.f), matModel).xyz();
+	};
+
+	const u32 count = pIndices ? indexCount : vertexCount;
+	for (u32 i = 0; i + 2 < count; i += 3)
+	{
+		Triangle tri;
+		tri.v0 = position(pIndices ? pIndices[i] : i);
+		tri.v1 = position(pIndices ? pIndices[i + 1] : i + 1);
+		tri.v2 = position(pIndices ? pIndices[i + 2] : i + 2);
+		m_triangles.push_back(tri);
+	}
+}
+
+float3 DistanceField::voxel_centre(u32 x, u32 y, u32 z) const
+{
+	return m_boundsMin + float3(x + 0.5f, y + 0.5f, z + 0.5f) * m_voxelSize;
+}
+
+void DistanceField::bake(const Desc& desc, WorkerPool* pPool)
+{
+	ASSERT(desc.voxelSize > 0.f && desc.maxResolution > 0);
+
+	m_distances.clear();
+	m_size[0] = m_size[1] = m_size[2] = 0;
+	m_stats = Stats();
+	m_stats.triangles = (u32)m_triangles.size();
+	if (m_triangles.empty())
+		return;
+
+	float3 boundsMin(FLT_MAX);
+	float3 boundsMax(-FLT_MAX);
+	for (const Triangle& tri : m_triangles)
+	{
+		boundsMin = min3(min3(boundsMin, tri.v0), min3(tri.v1, tri.v2));
+		boundsMax = max3(max3(boundsMax, tri.v0), max3(tri.v1, tri.v2));
+	}
+	boundsMin = max3(boundsMin, desc.clipMin);
+	boundsMax = min3(boundsMax, desc.clipMax);
+	ASSERT(boundsMin.x <= boundsMax.x && boundsMin.y <= boundsMax.y && boundsMin.z <= boundsMax.z);
+
+	m_boundsMin = boundsMin - float3(desc.padding);
+	const float3 extent = boundsMax + float3(desc.padding) - m_boundsMin;
+
+	m_voxelSize = std::max(desc.voxelSize, std::max(extent.x, std::max(extent.y, extent.z)) / desc.maxResolution);
+	for (u32 axis = 0; axis < 3; ++axis)
+	{
+		m_size[axis] = std::min(desc.maxResolution, std::max(1u, (u32)std::ceil(axis_value(extent, axis) / m_voxelSize)));
+	}
+	m_stats.voxels = m_size[0] * m_size[1] * m_size[2];
+	m_distances.assign(m_stats.voxels, FLT_MAX);
+
+	if (desc.method == Method::kExact)
+	{
+		bake_exact(pPool);
+	}
+	else
+	{
+		bake_jump_flood(pPool);
+	}
+}
+
+void DistanceField::bake_exact(WorkerPool* pPool)
+{
+	for_slices(pPool, m_size[2], [&](u32 begin, u32 end)
+	{
+		for (u32 z = begin; z < end; ++z)
+		{
+			for (u32 y = 0; y < m_size[1]; ++y)
+			{
+				for (u32 x = 0; x < m_size[0]; ++x)
+				{
+					const float3 p = voxel_centre(x, y, z);
+					f32 best = FLT_MAX;
+					for (const Triangle& tri : m_triangles)
+					{
+						best = std::min(best, point_triangle_distance(p, tri.v0, tri.v1, tri.v2));
+					}
+					m_distances[((size_t)z * m_size[1] + y) * m_size[0] + x] = best;
+				}
+			}
+		}
+	});
+}
+
+void DistanceField::bake_jump_flood(WorkerPool* pPool)
+{
+	const u32 sx = m_size[0], sy = m_size[1], sz = m_size[2];
+	const size_t voxels = (size_t)sx * sy * sz;
+	std::vector<u32> nearest[2] = { std::vector<u32>(voxels, kNoTriangle), std::vector<u32>(voxels, kNoTriangle) };
+	std::vector<f32>& distance = m_distances;
+
+	// Seeds: any surface through a voxel passes within half its diagonal of the centre, so no gaps.
+	const f32 seedRadius = m_voxelSize * 0.8660254f;
+	auto voxel_range = [&](f32 lo, f32 hi, u32 axis, s32& first, s32& last)
+	{
+		first = std::max(0, (s32)std::floor((lo - seedRadius - axis_value(m_boundsMin, axis)) / m_voxelSize - 0.5f));
+		last = std::min((s32)m_size[axis] - 1, (s32)std::ceil((hi + seedRadius - axis_value(m_boundsMin, axis)) / m_voxelSize - 0.5f));
+	};
+
+	for_slices(pPool, sz, [&](u32 begin, u32 end)
+	{
+		for (u32 t = 0; t < (u32)m_triangles.size(); ++t)
+		{
+			const Triangle& tri = m_triangles[t];
+			const float3 lo = min3(min3(tri.v0, tri.v1), tri.v2);
+			const float3 hi = max3(max3(tri.v0, tri.v1), tri.v2);
+
+			s32 x0, x1, y0, y1, z0, z1;
+			voxel_range(lo.z, hi.z, 2, z0, z1);
+			z0 = std::max(z0, (s32)begin);
+			z1 = std::min(z1, (s32)end - 1);
+			if (z0 > z1)
+				continue;
+			voxel_range(lo.x, hi.x, 0, x0, x1);
+			voxel_range(lo.y, hi.y, 1, y0, y1);
+
+			for (s32 z = z0; z <= z1; ++z)
+			{
+				for (s32 y = y0; y <= y1; ++y)
+				{
+					for (s32 x = x0; x <= x1; ++x)
+					{
+						const size_t v = ((size_t)z * sy + y) * sx + x;
+						const f32 d = point_triangle_distance(voxel_centre(x, y, z), tri.v0, tri.v1, tri.v2);
+						if (d <= seedRadius && d < distance[v])
+						{
+							distance[v] = d;
+							nearest[0][v] = t;
+						}
+					}
+				}
+			}
+		}
+	});
+
+	for (size_t v = 0; v < voxels; ++v)
+	{
+		m_stats.seeds += nearest[0][v] != kNoTriangle;
+	}
+
+	// Steps from half the largest axis (rounded up to a power of 2) down to 1, then 1 again (JFA+1).
+	u32 step = 1;
+	while (step * 2 < std::max(sx, std::max(sy, sz)))
+		step *= 2;
+
+	std::vector<f32> nextDistance(voxels);
+	u32 src = 0;
+	for (bool extra = false; step; )
+	{
+		const std::vector<u32>& in = nearest[src];
+		std::vector<u32>& out = nearest[src ^ 1];
+		const s32 s = (s32)step;
+
+		for_slices(pPool, sz, [&](u32 begin, u32 end)
+		{
+			for (u32 z = begin; z < end; ++z)
+			{
+				for (u32 y = 0; y < sy; ++y)
+				{
+					for (u32 x = 0; x < sx; ++x)
+					{
+						const size_t v = ((size_t)z * sy + y) * sx + x;
+						const float3 p = voxel_centre(x, y, z);
+						u32 best = in[v];
+						f32 bestDistance = distance[v];
+
+						for (s32 dz = -s; dz <= s; dz += s)
+						{
+							const s32 nz = (s32)z + dz;
+							if (nz < 0 || nz >= (s32)sz)
+								continue;
+							for (s32 dy = -s; dy <= s; dy += s)
+							{
+								const s32 ny = (s32)y + dy;
+								if (ny < 0 || ny >= (s32)sy)
+									continue;
+								for (s32 dx = -s; dx <= s; dx += s)
+								{
+									const s32 nx = (s32)x + dx;
+									if (nx < 0 || nx >= (s32)sx)
+										continue;
+
+									const u32 candidate = in[((size_t)nz * sy + ny) * sx + nx];
+									if (candidate == kNoTriangle || candidate == best)
+										continue;
+
+									const Triangle& tri = m_triangles[candidate];
+									const f32 d = point_triangle_distance(p, tri.v0, tri.v1, tri.v2);
+									if (d < bestDistance)
+									{
+										bestDistance = d;
+										best = candidate;
+									}
+								}
+							}
+						}
+
+						out[v] = best;
+						nextDistance[v] = bestDistance;
+					}
+				}
+			}
+		});
+
+		distance.swap(nextDistance);
+		src ^= 1;
+		++m_stats.passes;
+
+		if (step == 1 && !extra)
+		{
+			extra = true;
+		}
+		else
+		{
+			step /= 2;
+		}
+	}
+}
+
+f32 DistanceField::sample(const float3& p) const
+{
+	ASSERT(!m_distances.empty());
+
+	s32 i0[3], i1[3];
+	f32 f[3];
+	for (u32 axis = 0; axis < 3; ++axis)
+	{
+		const f32 g = std::min(std::max((axis_value(p, axis) - axis_value(m_boundsMin, axis)) / m_voxelSize - 0.5f, 0.f), (f32)(m_size[axis] - 1));
+		i0[axis] = (s32)g;
+		i1[axis] = std::min(i0[axis] + 1, (s32)m_size[axis] - 1);
+		f[axis] = g - i0[axis];
+	}
+
+	auto at = [&](s32 x, s32 y, s32 z) { return m_distances[((size_t)z * m_size[1] + y) * m_size[0] + x]; };
+	const f32 c00 = hlsl::lerp(at(i0[0], i0[1], i0[2]), at(i1[0], i0[1], i0[2]), f[0]);
+	const f32 c10 = hlsl::lerp(at(i0[0], i1[1], i0[2]), at(i1[0], i1[1], i0[2]), f[0]);
+	const f32 c01 = hlsl::lerp(at(i0[0], i0[1], i1[2]), at(i1[0], i0[1], i1[2]), f[0]);
+	const f32 c11 = hlsl::lerp(at(i0[0], i1[1], i1[2]), at(i1[0], i1[1], i1[2]), f[0]);
+	return hlsl::lerp(hlsl::lerp(c00, c10, f[1]), hlsl::lerp(c01, c11, f[1]), f[2]);
+}
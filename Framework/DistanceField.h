@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "ShaderMath.h"
+
+#include <vector>
+
+class WorkerPool;
+
+//================================================================================
+// Distance Field
+// Voxelises static triangles into a 3D volume of distances to the nearest one,
+// for distance field AO. Meshes are added in world space like BVH::add(), bake()
+// fits the volume around them (plus padding) and fills it with one of:
+//  - kExact : every voxel against every triangle. The reference, fine for a
+//    handful of boxes and planes.
+//  - kJumpFlood : voxels within half a diagonal of a triangle seed it, then
+//    log2(size) + 1 jump flooding passes (27 neighbours at halving steps) hand
+//    the nearest seed on. Each voxel keeps the triangle id, the distances are
+//    exact to that triangle, so the only error is a wrong nearest pick.
+// Passes go over z slices on the WorkerPool.
+//
+// Distances are unsigned: the room's planes are open surfaces with no inside.
+// AO marches away from the surface so it only ever reads the outside.
+//
+// Voxel (x, y, z) is centred on boundsMin + (xyz + 0.5) * voxelSize, like texel
+// centres, so the volume uploads as a Texture3D as is. Only standard headers
+// so it builds with the CPU tools.
+//================================================================================
+class DistanceField
+{
+public:
+	enum class Method : u8
+	{
+		kExact,
+		kJumpFlood,
+	};
+
+	struct Desc
+	{
+		f32 voxelSize = 0.5f;		// world units, grown if an axis would exceed maxResolution.
+		f32 padding = 4.f;			// world units around the triangles' bounds, the furthest AO reads.
+		u32 maxResolution = 256;	// voxels per axis.
+		Method method = Method::kJumpFlood;
+
+		// The volume covers the triangles' bounds within this box (before the padding), for ground
+		// planes much larger than the part that matters. kExact still measures every triangle,
+		// kJumpFlood only the ones that pass through the volume.
+		hlsl::float3 clipMin = hlsl::float3(-1e30f);
+		hlsl::float3 clipMax = hlsl::float3(1e30f);
+	};
+
+	struct Stats
+	{
+		u32 triangles = 0;
+		u32 voxels = 0;
+		u32 seeds = 0;			// kJumpFlood: voxels seeded by a triangle.
+		u32 passes = 0;			// kJumpFlood: flooding passes.
+	};
+
+	void clear();
+
+	// pPositions points at the first vertex's x, positions are strideBytes apart. pIndices is a u16
+	// triangle list, or null when the vertices are.
+	void add(const f32* pPositions, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount, const hlsl::float4x4& matModel);
+
+	// Sizes the volume around everything added since clear() and fills it.
+	void bake(const Desc& desc, WorkerPool* pPool = nullptr);
+
+	// Trilinear, clamped to the outer voxel centres like a CLAMP sampler.
+	f32 sample(const hlsl::float3& p) const;
+
+	f32 voxel(u32 x, u32 y, u32 z) const { return m_distances[((size_t)z * m_size[1] + y) * m_size[0] + x]; }
+
+	bool empty() const { return m_distances.empty(); }
+	u32 size(u32 axis) const { return m_size[axis]; }
+	f32 voxel_size() const { return m_voxelSize; }
+	const hlsl::float3& bounds_min() const { return m_boundsMin; }
+	const std::vector<f32>& distances() const { return m_distances; }
+	const Stats& stats() const { return m_stats; }
+
+private:
+	struct Triangle
+	{
+		hlsl::float3 v0, v1, v2;
+	};
+
+	hlsl::float3 voxel_centre(u32 x, u32 y, u32 z) const;
+	void bake_exact(WorkerPool* pPool);
+	void bake_jump_flood(WorkerPool* pPool);
+
+	std::vector<Triangle> m_triangles;
+	std::vector<f32> m_distances;
+	hlsl::float3 m_boundsMin;
+	f32 m_voxelSize = 0.f;
+	u32 m_size[3] = { 0, 0, 0 };
+	Stats m_stats;
+};
+
+// Distance from p to triangle (a, b, c), Ericson's closest point on a triangle.
+f32 point_triangle_distance(const hlsl::float3& p, const hlsl::float3& a, const hlsl::float3& b, const hlsl::float3& c);
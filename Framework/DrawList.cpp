@@ -0,0 +1,175 @@
+#include "DrawList.h"
+
+#include <algorithm>
+
+u64 make_draw_key(u32 pass, u32 shader, u32 mesh, u32 material)
+{
+	ASSERT(pass < (1u << kDrawKeyPassBits));
+	ASSERT(shader < (1u << kDrawKeyShaderBits));
+	ASSERT(mesh < (1u << kDrawKeyMeshBits));
+	ASSERT(material < (1u << kDrawKeyMaterialBits));
+
+	return ((u64)pass << kDrawKeyPassShift)
+		| ((u64)shader << kDrawKeyShaderShift)
+		| ((u64)mesh << kDrawKeyMeshShift)
+		| ((u64)material << kDrawKeyMaterialShift);
+}
+
+void DrawListStats::add(const DrawListStats& o)
+{
+	draws += o.draws;
+	shaderBinds += o.shaderBinds;
+	meshBinds += o.meshBinds;
+	materialBinds += o.materialBinds;
+	shaderBindsSkipped += o.shaderBindsSkipped;
+	meshBindsSkipped += o.meshBindsSkipped;
+	materialBindsSkipped += o.materialBindsSkipped;
+}
+
+void DrawList::clear()
+{
+	m_commands.clear();
+	m_stats = DrawListStats();
+	m_sorted = true;
+}
+
+void DrawList::reserve(u32 count)
+{
+	m_commands.reserve(count);
+	m_scratch.reserve(count);
+}
+
+void DrawList::add(u64 key, u32 firstInstance, u32 instanceCount, u32 userData)
+{
+	if (!m_commands.empty() && key < m_commands.back().key)
+	{
+		m_sorted = false;
+	}
+	m_commands.push_back({ key, firstInstance, instanceCount, userData });
+}
+
+void DrawList::sort()
+{
+	if (m_sorted)
+		return;
+
+	const u32 count = (u32)m_commands.size();
+
+	// One histogram per key byte in a single read, bytes every key agrees on need no pass.
+	u32 histograms[8][256] = {};
+	for (const DrawCommand& cmd : m_commands)
+	{
+		for (u32 b = 0; b < 8; ++b)
+		{
+			++histograms[b][(cmd.key >> (b * 8)) & 0xff];
+		}
+	}
+
+	m_scratch.resize(count);
+	DrawCommand* pSrc = m_commands.data();
+	DrawCommand* pDst = m_scratch.data();
+
+	for (u32 b = 0; b < 8; ++b)
+	{
+		u32* pHistogram = histograms[b];
+		if (pHistogram[(pSrc[0].key >> (b * 8)) & 0xff] == count)
+			continue;
+
+		u32 offset = 0;
+		for (u32 i = 0; i < 256; ++i)
+		{
+			const u32 n = pHistogram[i];
+			pHistogram[i] = offset;
+			offset += n;
+		}
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			pDst[pHistogram[(pSrc[i].key >> (b * 8)) & 0xff]++] = pSrc[i];
+		}
+		std::swap(pSrc, pDst);
+	}
+
+	if (pSrc != m_commands.data())
+	{
+		m_commands.swap(m_scratch);
+	}
+	m_sorted = true;
+}
+
+void DrawList::submit(DrawListBackend& backend, u32 pass)
+{
+	u32 first = 0;
+	u32 count = (u32)m_commands.size();
+	if (pass != kAllPasses)
+	{
+		pass_range(pass, first, count);
+	}
+	submit_range(backend, first, count, m_stats);
+}
+
+void DrawList::pass_range(u32 pass, u32& first, u32& count) const
+{
+	ASSERT(m_sorted);
+
+	const auto begin = std::lower_bound(m_commands.begin(), m_commands.end(), pass, [](const DrawCommand& cmd, u32 p) { return draw_key_pass(cmd.key) < p; });
+	const auto end = std::upper_bound(begin, m_commands.end(), pass, [](u32 p, const DrawCommand& cmd) { return p < draw_key_pass(cmd.key); });
+
+	first = (u32)(begin - m_commands.begin());
+	count = (u32)(end - begin);
+}
+
+void DrawList::submit_range(DrawListBackend& backend, u32 first, u32 count, DrawListStats& statsOut) const
+{
+	ASSERT(m_sorted);
+	ASSERT(first + count <= m_commands.size());
+
+	bool bound = false;
+	u32 shader = 0, mesh = 0, material = 0;
+
+	for (u32 i = first; i < first + count; ++i)
+	{
+		const DrawCommand& cmd = m_commands[i];
+
+		const u32 nextShader = draw_key_shader(cmd.key);
+		if (!bound || !m_filterRedundant || nextShader != shader)
+		{
+			backend.bind_shader(nextShader);
+			++statsOut.shaderBinds;
+		}
+		else
+		{
+			++statsOut.shaderBindsSkipped;
+		}
+
+		const u32 nextMesh = draw_key_mesh(cmd.key);
+		if (!bound || !m_filterRedundant || nextMesh != mesh)
+		{
+			backend.bind_mesh(nextMesh);
+			++statsOut.meshBinds;
+		}
+		else
+		{
+			++statsOut.meshBindsSkipped;
+		}
+
+		const u32 nextMaterial = draw_key_material(cmd.key);
+		if (!bound || !m_filterRedundant || nextMaterial != material)
+		{
+			backend.bind_material(nextMaterial);
+			++statsOut.materialBinds;
+		}
+		else
+		{
+			++statsOut.materialBindsSkipped;
+		}
+
+		bound = true;
+		shader = nextShader;
+		mesh = nextMesh;
+		material = nextMaterial;
+
+		backend.draw(cmd);
+		++statsOut.draws;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+//================================================================================
+// Draw List
+// Draws are recorded with a 64 bit sort key, most significant first:
+//
+//   pass : 8 | shader : 16 | mesh : 16 | material : 24
+//
+// sort() radix sorts them (stable, so draws with equal keys keep the order they
+// were recorded in) and submit() walks one pass in key order through a
+// DrawListBackend, only binding a shader / mesh / material when it differs from
+// the one already bound. The ids are whatever the backend indexes its tables
+// with, key order is draw order so pick them accordingly.
+//
+// Only standard headers, the recording, sorting and filtering run without a device.
+//================================================================================
+
+constexpr u32 kDrawKeyPassBits = 8;
+constexpr u32 kDrawKeyShaderBits = 16;
+constexpr u32 kDrawKeyMeshBits = 16;
+constexpr u32 kDrawKeyMaterialBits = 24;
+
+constexpr u32 kDrawKeyMaterialShift = 0;
+constexpr u32 kDrawKeyMeshShift = kDrawKeyMaterialShift + kDrawKeyMaterialBits;
+constexpr u32 kDrawKeyShaderShift = kDrawKeyMeshShift + kDrawKeyMeshBits;
+constexpr u32 kDrawKeyPassShift = kDrawKeyShaderShift + kDrawKeyShaderBits;
+
+u64 make_draw_key(u32 pass, u32 shader, u32 mesh, u32 material);
+
+inline u32 draw_key_pass(u64 key) { return (u32)(key >> kDrawKeyPassShift) & ((1u << kDrawKeyPassBits) - 1); }
+inline u32 draw_key_shader(u64 key) { return (u32)(key >> kDrawKeyShaderShift) & ((1u << kDrawKeyShaderBits) - 1); }
+inline u32 draw_key_mesh(u64 key) { return (u32)(key >> kDrawKeyMeshShift) & ((1u << kDrawKeyMeshBits) - 1); }
+inline u32 draw_key_material(u64 key) { return (u32)(key >> kDrawKeyMaterialShift) & ((1u << kDrawKeyMaterialBits) - 1); }
+
+struct DrawCommand
+{
+	u64 key;
+	u32 firstInstance;
+	u32 instanceCount;
+	u32 userData;		// passed through to the backend untouched
+};
+
+class DrawListBackend
+{
+public:
+	virtual ~DrawListBackend() {}
+
+	virtual void bind_shader(u32 shader) = 0;
+	virtual void bind_mesh(u32 mesh) = 0;
+	virtual void bind_material(u32 material) = 0;
+	virtual void draw(const DrawCommand& cmd) = 0;
+};
+
+// Accumulated over every submit() since clear().
+struct DrawListStats
+{
+	u32 draws = 0;
+
+	u32 shaderBinds = 0;
+	u32 meshBinds = 0;
+	u32 materialBinds = 0;
+
+	// Binds of what was already bound, not sent to the backend.
+	u32 shaderBindsSkipped = 0;
+	u32 meshBindsSkipped = 0;
+	u32 materialBindsSkipped = 0;
+
+	void add(const DrawListStats& o);
+
+	u32 binds() const { return shaderBinds + meshBinds + materialBinds; }
+	u32 binds_skipped() const { return shaderBindsSkipped + meshBindsSkipped + materialBindsSkipped; }
+};
+
+class DrawList
+{
+public:
+	static constexpr u32 kAllPasses = ~0u;
+
+	void clear();
+	void reserve(u32 count);
+
+	void add(u64 key, u32 firstInstance, u32 instanceCount, u32 userData = 0);
+
+	// Radix sort on the key, stable.
+	void sort();
+
+	// Draws pass's commands (or all of them) in their current order. Nothing is assumed
+	// bound at the start, so the first draw binds everything.
+	void submit(DrawListBackend& backend, u32 pass = kAllPasses);
+
+	// Where pass's commands are, after sort().
+	void pass_range(u32 pass, u32& first, u32& count) const;
+
+	// submit() for commands [first, first + count) counting into statsOut instead of stats().
+	// Doesn't touch the list, so disjoint ranges can be recorded from several threads.
+	void submit_range(DrawListBackend& backend, u32 first, u32 count, DrawListStats& statsOut) const;
+
+	bool filter_redundant() const { return m_filterRedundant; }
+
+	// Off sends every bind to the backend, for comparing.
+	void set_filter_redundant(bool filter) { m_filterRedundant = filter; }
+
+	const std::vector<DrawCommand>& commands() const { return m_commands; }
+	const DrawListStats& stats() const { return m_stats; }
+
+private:
+	std::vector<DrawCommand> m_commands;
+	std::vector<DrawCommand> m_scratch;
+	DrawListStats m_stats;
+	bool m_filterRedundant = true;
+	bool m_sorted = true;
+};
@@ -0,0 +1,166 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+//================================================================================
+// LinearArena
+//================================================================================
+
+namespace
+{
+	// Blocks are cache line aligned, allocations with more alignment than that still work,
+	// they pad inside the block.
+	constexpr size_t kBlockAlignment = 64;
+}
+
+LinearArena::LinearArena(size_t capacity, MemoryTag tag)
+	: m_tag(tag)
+{
+	if (capacity)
+	{
+		add_block(capacity);
+	}
+}
+
+LinearArena::~LinearArena()
+{
+	for (u32 i = 0; i < m_count; ++i)
+	{
+		MemoryTracker::deallocate(m_blocks[i].pBase);
+	}
+}
+
+void LinearArena::add_block(size_t size)
+{
+	ASSERT(m_count < kMaxBlocks);
+
+	Block& block = m_blocks[m_count++];
+	block.pBase = static_cast<u8*>(MemoryTracker::allocate(m_tag, size, kBlockAlignment));
+	block.size = size;
+	block.offset = 0;
+	ASSERT(block.pBase);
+}
+
+void* LinearArena::bump(size_t bytes, size_t alignment)
+{
+	Block& block = m_blocks[m_current];
+	const size_t start = (block.offset + alignment - 1) & ~(alignment - 1);
+	if (start + bytes > block.size)
+		return nullptr;
+
+	block.offset = start + bytes;
+	m_peak = std::max(m_peak, used());
+	return block.pBase + start;
+}
+
+void* LinearArena::allocate(size_t bytes, size_t alignment)
+{
+	ASSERT(alignment && !(alignment & (alignment - 1)));
+
+	if (m_count)
+	{
+		if (void* p = bump(bytes, alignment))
+			return p;
+
+		m_frozen += m_blocks[m_current].offset;
+		++m_current;
+	}
+
+	// Full. A block after the current one was left by a rewind, it's used again if it fits, otherwise
+	// those are too small to keep and make way for one as big as every block so far.
+	if (m_current == m_count || m_blocks[m_current].size < bytes + alignment)
+	{
+		while (m_count > m_current)
+		{
+			MemoryTracker::deallocate(m_blocks[--m_count].pBase);
+			m_blocks[m_count] = Block();
+		}
+		add_block(std::max(bytes + alignment, capacity()));
+		++m_grows;
+	}
+
+	return bump(bytes, alignment);
+}
+
+const char* LinearArena::copy_string(const char* pText)
+{
+	const size_t length = strlen(pText) + 1;
+	char* pCopy = static_cast<char*>(allocate(length, 1));
+	memcpy(pCopy, pText, length);
+	return pCopy;
+}
+
+LinearArena::Marker LinearArena::marker() const
+{
+	Marker marker;
+	marker.block = m_current;
+	marker.offset = m_count ? m_blocks[m_current].offset : 0;
+	return marker;
+}
+
+void LinearArena::rewind(const Marker& marker)
+{
+	if (!m_count)
+		return;
+
+	ASSERT(marker.block <= m_current);
+
+	// Back to the start of an arena that grew: one block for all of it, the heap isn't
+	// needed again until it outgrows that.
+	if (marker.block == 0 && marker.offset == 0 && m_count > 1)
+	{
+		const size_t total = capacity();
+		for (u32 i = 0; i < m_count; ++i)
+		{
+			MemoryTracker::deallocate(m_blocks[i].pBase);
+			m_blocks[i] = Block();
+		}
+		m_count = 0;
+		add_block(total);
+		m_current = 0;
+		m_frozen = 0;
+		return;
+	}
+
+	// Later blocks stay allocated, allocate() moves on to them again.
+	for (u32 i = marker.block + 1; i <= m_current; ++i)
+	{
+		m_blocks[i].offset = 0;
+	}
+	m_current = marker.block;
+	m_blocks[m_current].offset = marker.offset;
+
+	m_frozen = 0;
+	for (u32 i = 0; i < m_current; ++i)
+	{
+		m_frozen += m_blocks[i].offset;
+	}
+}
+
+size_t LinearArena::capacity() const
+{
+	size_t total = 0;
+	for (u32 i = 0; i < m_count; ++i)
+	{
+		total += m_blocks[i].size;
+	}
+	return total;
+}
+
+//================================================================================
+// FrameArena
+//================================================================================
+
+FrameArena::FrameArena(size_t capacity, MemoryTag tag)
+	: m_even(capacity, tag)
+	, m_odd(capacity, tag)
+	, m_pCurrent(&m_even)
+{
+}
+
+void FrameArena::begin_frame()
+{
+	m_pCurrent = &previous();
+	m_pCurrent->reset();
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "MemoryTracker.h"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//================================================================================
+// LinearArena
+// Bump allocator for memory that all dies together: allocating moves an offset,
+// freeing is rewinding to a marker or resetting the whole arena. Nothing is
+// given back one allocation at a time and no destructor ever runs, so it only
+// holds trivially destructible data (or containers on ArenaAllocator).
+//
+// Blocks come from MemoryTracker under the arena's tag. When the current one
+// is full another is added, at least as big as all of them together. Resetting
+// an arena that has grown swaps them for one block of that total, so after a
+// warm-up frame or two the arena is a single block that never goes back to
+// the heap.
+//
+// Not thread safe, one arena per thread that allocates.
+//================================================================================
+class LinearArena
+{
+public:
+	// Where allocation had got to, for rewind().
+	struct Marker
+	{
+		u32 block = 0;
+		size_t offset = 0;
+	};
+
+	explicit LinearArena(size_t capacity = 64 * KB, MemoryTag tag = MemoryTag::kTransient);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	// Uninitialised bytes, alignment is a power of two. Never null.
+	void* allocate(size_t bytes, size_t alignment = 16);
+
+	template <typename T>
+	T* allocate_array(size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+	// Copy of a null terminated string.
+	const char* copy_string(const char* pText);
+
+	// Free everything allocated since the marker was taken.
+	Marker marker() const;
+	void rewind(const Marker& marker);
+
+	// Free everything.
+	void reset() { rewind(Marker()); }
+
+	size_t used() const { return m_frozen + m_blocks[m_current].offset; }
+	size_t capacity() const;
+	size_t peak() const { return m_peak; }
+
+	// Blocks added because the arena was full, since the start.
+	u32 grows() const { return m_grows; }
+
+private:
+	static constexpr u32 kMaxBlocks = 16;
+
+	struct Block
+	{
+		u8* pBase = nullptr;
+		size_t size = 0;
+		size_t offset = 0;
+	};
+
+	void add_block(size_t size);
+	void* bump(size_t bytes, size_t alignment);
+
+	Block m_blocks[kMaxBlocks];
+	u32 m_count = 0;		// blocks allocated
+	u32 m_current = 0;		// block allocating
+	size_t m_frozen = 0;	// bytes used in the blocks before m_current
+	size_t m_peak = 0;
+	u32 m_grows = 0;
+	MemoryTag m_tag;
+};
+
+//================================================================================
+// FrameArena
+// Two LinearArenas taking turns a frame each. Memory allocated in a frame stays
+// valid through the next one, so a consumer that runs a frame behind (last
+// frame's names and lists in this frame's UI, a read back) can keep pointers
+// into it without copying.
+//================================================================================
+class FrameArena
+{
+public:
+	explicit FrameArena(size_t capacity = 64 * KB, MemoryTag tag = MemoryTag::kTransient);
+
+	// Start of a frame: the arena of two frames ago is reset and becomes current.
+	void begin_frame();
+
+	LinearArena& current() { return *m_pCurrent; }
+	LinearArena& previous() { return m_pCurrent == &m_even ? m_odd : m_even; }
+
+	void* allocate(size_t bytes, size_t alignment = 16) { return m_pCurrent->allocate(bytes, alignment); }
+	const char* copy_string(const char* pText) { return m_pCurrent->copy_string(pText); }
+
+private:
+	LinearArena m_even;
+	LinearArena m_odd;
+	LinearArena* m_pCurrent;
+};
+
+//================================================================================
+// ArenaScope
+// Scoped stack allocation on an arena: everything allocated while it is alive
+// is freed when it goes out of scope.
+//   ArenaScope scope(scratch);
+//   ArenaVector<u32> order(scratch);
+//================================================================================
+class ArenaScope
+{
+public:
+	explicit ArenaScope(LinearArena& arena) : m_arena(arena), m_marker(arena.marker()) {}
+	~ArenaScope() { m_arena.rewind(m_marker); }
+
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+	LinearArena& m_arena;
+	LinearArena::Marker m_marker;
+};
+
+//================================================================================
+// STL allocator on an arena. deallocate() does nothing, a vector that grows
+// leaves its old storage behind until the arena is reset, so reserve() what's
+// known up front.
+//================================================================================
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	// Not explicit, ArenaVector<u32> list(arena) reads better.
+	ArenaAllocator(LinearArena& arena) : m_pArena(&arena) {}
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& o) : m_pArena(o.arena()) {}
+
+	T* allocate(size_t count) { return m_pArena->allocate_array<T>(count); }
+	void deallocate(T*, size_t) {}
+
+	LinearArena* arena() const { return m_pArena; }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>& o) const { return m_pArena == o.arena(); }
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U>& o) const { return m_pArena != o.arena(); }
+
+private:
+	LinearArena* m_pArena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//================================================================================
+// ArenaFunction
+// A callable copied into an arena, for callbacks that live as long as the
+// arena's contents (render graph passes). Two pointers to copy, nothing to
+// free. The arena runs no destructors, so the callable must not need one:
+// lambdas capturing references, pointers and plain values.
+//================================================================================
+template <typename Signature>
+class ArenaFunction;
+
+template <typename R, typename... Args>
+class ArenaFunction<R(Args...)>
+{
+public:
+	ArenaFunction() = default;
+
+	template <typename Fn>
+	ArenaFunction(LinearArena& arena, const Fn& fn)
+	{
+		static_assert(std::is_trivially_destructible<Fn>::value, "The arena never runs destructors, capture references or plain values.");
+		m_pFn = new (arena.allocate(sizeof(Fn), alignof(Fn))) Fn(fn);
+		m_pCall = [](const void* pFn, Args... args) -> R { return (*static_cast<const Fn*>(pFn))(std::forward<Args>(args)...); };
+	}
+
+	explicit operator bool() const { return m_pCall != nullptr; }
+
+	R operator()(Args... args) const { return m_pCall(m_pFn, std::forward<Args>(args)...); }
+
+private:
+	const void* m_pFn = nullptr;
+	R (*m_pCall)(const void* pFn, Args... args) = nullptr;
+};
@@ -7,9 +7,17 @@
 //========================================================
 // Globals
 //========================================================
+#include "MemoryTracker.h"
+
+// Debug draw's scratch (the glyph bitmap) counts as UI.
+#define DD_MALLOC(size) MemoryTracker::allocate(MemoryTag::kUI, size)
+#define DD_MFREE(ptr) MemoryTracker::deallocate(ptr)
+
 #define DEBUG_DRAW_IMPLEMENTATION
 #include "Framework.h"
+#include "MemoryTrackerD3D11.h"
 #include "ShaderSet.h"
+#include "Trace.h"
 
 #include <cstdlib>
 #include <tuple>
@@ -331,6 +339,8 @@ public:
 
 	void onRender() override
 	{
+		TRACE_SCOPE("Frame");
+
 		const float clearColor[] = { 0, 0, 0, 0.f };
 		m_pDeviceContext->ClearRenderTargetView(m_pRenderTargetView.Get(), clearColor);
 
@@ -340,6 +350,7 @@ public:
 		{
 			m_pRenderCallback();
 		}	
+		TRACE_SCOPE("Present");
 		m_pSwapChain->Present(1, 0); // use VSYNC
 	}
 
@@ -362,6 +373,7 @@ public:
 		m_pRenderTargetView.Reset();
 
 		// Release depth buffer
+		untrack_gpu_resource_d3d11(MemoryTag::kRenderTarget, m_pDepthStencil.Get());
 		m_pDepthStencilView.Reset();
 		m_pDepthStencil.Reset();
 
@@ -551,6 +563,7 @@ private:
 		{
 			panicF("Failed to create Depth Buffer swap chain!");
 		}
+		track_gpu_resource_d3d11(MemoryTag::kRenderTarget, m_pDepthStencil.Get());
 
 		hr = m_pD3DDevice->CreateDepthStencilView(m_pDepthStencil.Get(), NULL, m_pDepthStencilView.GetAddressOf());
 		if (FAILED(hr))
@@ -580,6 +593,14 @@ public:
 		initBuffers();
 	}
 
+	~RenderInterfaceD3D11()
+	{
+		untrack_gpu_resource_d3d11(MemoryTag::kUI, constantBuffer.Get());
+		untrack_gpu_resource_d3d11(MemoryTag::kUI, lineVertexBuffer.Get());
+		untrack_gpu_resource_d3d11(MemoryTag::kUI, pointVertexBuffer.Get());
+		untrack_gpu_resource_d3d11(MemoryTag::kUI, glyphVertexBuffer.Get());
+	}
+
 	void setMvpMatrixPtr(const m4x4& mtx)
 	{
 		constantBufferData.mvpMatrix = DirectX::XMMATRIX(mtx);
@@ -644,6 +665,7 @@ public:
 			destroyGlyphTexture(texImpl);
 			return nullptr;
 		}
+		track_gpu_resource_d3d11(MemoryTag::kUI, texImpl->d3dTexPtr);
 		if (FAILED(d3dDevice->CreateShaderResourceView(texImpl->d3dTexPtr, nullptr, &texImpl->d3dTexSRV)))
 		{
 			errorF("CreateShaderResourceView failed!");
@@ -667,6 +689,7 @@ public:
 		{
 			if (texImpl->d3dSampler) { texImpl->d3dSampler->Release(); }
 			if (texImpl->d3dTexSRV) { texImpl->d3dTexSRV->Release(); }
+			untrack_gpu_resource_d3d11(MemoryTag::kUI, texImpl->d3dTexPtr);
 			if (texImpl->d3dTexPtr) { texImpl->d3dTexPtr->Release(); }
 			delete texImpl;
 		}
@@ -971,6 +994,11 @@ private:
 		{
 			panicF("Failed to create glyphs vertex buffer!");
 		}
+
+		track_gpu_resource_d3d11(MemoryTag::kUI, constantBuffer.Get());
+		track_gpu_resource_d3d11(MemoryTag::kUI, lineVertexBuffer.Get());
+		track_gpu_resource_d3d11(MemoryTag::kUI, pointVertexBuffer.Get());
+		track_gpu_resource_d3d11(MemoryTag::kUI, glyphVertexBuffer.Get());
 	}
 
 	void drawHelper(const int numVerts, const ShaderSet & ss,
@@ -1189,6 +1217,9 @@ static void inputUpdate(const Window & win)
 
 int framework_main(FrameworkApp& rApp, const char* pTitleString, HINSTANCE hInstance, int nCmdShow)
 {
+	// Before anything ImGui allocates, a block has to go back to the allocator it came from.
+	ImGui::GetIO().MemAllocFn = [](size_t size) { return MemoryTracker::allocate(MemoryTag::kUI, size); };
+	ImGui::GetIO().MemFreeFn = [](void* ptr) { MemoryTracker::deallocate(ptr); };
 
 	RenderWindowD3D11 renderWindow(hInstance, nCmdShow, pTitleString);
 	RenderInterfaceD3D11 renderInterface(renderWindow.m_pD3DDevice, renderWindow.m_pDeviceContext);
@@ -1212,8 +1243,17 @@ int framework_main(FrameworkApp& rApp, const char* pTitleString, HINSTANCE hInst
 	systems.height = Window::s_height;
 
 
+	// Startup is always traced, the app stops the recording when it has what it wants.
+	TRACE_THREAD_NAME("Main");
+#if TRACE_ENABLED
+	Trace::start();
+#endif
+
 	// Let the application initialise.
-	rApp.on_init(systems);
+	{
+		TRACE_SCOPE("on_init");
+		rApp.on_init(systems);
+	}
 
 	/////////////////////////////////////////////////////////////
 	// Lambda for handling screen resize.
@@ -1271,7 +1311,10 @@ int framework_main(FrameworkApp& rApp, const char* pTitleString, HINSTANCE hInst
 		camera.updateMatrices();
 
 		// Let the application update.
-		rApp.on_update(systems);
+		{
+			TRACE_SCOPE("on_update");
+			rApp.on_update(systems);
+		}
 
 
 		m4x4 mvpMatrix = camera.vpMatrix.Transpose();
@@ -1280,13 +1323,22 @@ int framework_main(FrameworkApp& rApp, const char* pTitleString, HINSTANCE hInst
 		renderInterface.setCameraFrame(camera.up, camera.right, camera.eye);
 
 		// Let the application render.
-		rApp.on_render(systems);
+		{
+			TRACE_SCOPE("on_render");
+			rApp.on_render(systems);
+		}
 
 		// Flush the debug draw queues:
-		dd::flush(systems.pDebugDrawContext);
+		{
+			TRACE_SCOPE("Debug Draw Flush");
+			dd::flush(systems.pDebugDrawContext);
+		}
 
 		// Flush Imgui draw queues
-		ImGui::Render();
+		{
+			TRACE_SCOPE("ImGui Render");
+			ImGui::Render();
+		}
 
 #ifdef DEAD
 		const double t1s = getTimeSeconds();
@@ -1542,8 +1594,10 @@ v3 Camera::rotateAroundAxis(const v3 & vec, const v3 & axis, const float angle)
 	return v3(x, y, z);
 }
 
-memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment, const u32 kZeroPadding)
+memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment, const u32 kZeroPadding, MemoryTag tag)
 {
+	TRACE_SCOPE_CAT("load", "Load File");
+
 	std::ifstream hFile;
 
 	hFile.open(pstrName, std::ios::binary);
@@ -1554,7 +1608,7 @@ memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment
 		hFile.seekg(0, std::ios::beg);
 
 		rLengthOut = length;
-		memtype_t* pMemory = (memtype_t*)_aligned_malloc(length + kZeroPadding, kAlignment);
+		memtype_t* pMemory = (memtype_t*)MemoryTracker::allocate(tag, length + kZeroPadding, kAlignment);
 		ASSERT(pMemory);
 
 		hFile.read((char*)pMemory, length);
@@ -1573,5 +1627,5 @@ memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment
 
 void release_loaded_file(memtype_t* ptr)
 {
-	if (ptr) _aligned_free(ptr);
+	MemoryTracker::deallocate(ptr);
 }
@@ -6,6 +6,7 @@
 //================================================================================================
 
 #include "CommonHeader.h"
+#include "MemoryTracker.h"
 
 //================================================================================
 // Time releated functions
@@ -183,8 +184,8 @@ void drawText(dd::ContextHandle ctx);
 // File loading
 //================================================================================
 
-// Loads an entire file into an allocated memory block.
-memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment, const u32 kZeroPadding);
+// Loads an entire file into an allocated memory block, counted against tag.
+memtype_t* load_file(const char* pstrName, u32& rLengthOut, const u32 kAlignment, const u32 kZeroPadding, MemoryTag tag = MemoryTag::kTransient);
 
 // Release a previously allocated block.
 void release_loaded_file(memtype_t* ptr);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//================================================================================
+// FunctionRef
+// Non-owning reference to a callable, for parameters that are only called
+// before the function returns (WorkerPool::parallel_for, RenderGraph setup).
+// Two pointers, so unlike std::function it never allocates however much the
+// lambda captures. The callable has to outlive it: a temporary passed straight
+// to a call is fine, storing one is not.
+//================================================================================
+template <typename Signature>
+class FunctionRef;
+
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)>
+{
+public:
+	template <typename Fn, typename = typename std::enable_if<!std::is_same<typename std::decay<Fn>::type, FunctionRef>::value>::type>
+	FunctionRef(Fn&& fn)
+		: m_pFn((void*)std::addressof(fn))
+		, m_pCall([](void* pFn, Args... args) -> R { return (*static_cast<typename std::remove_reference<Fn>::type*>(pFn))(std::forward<Args>(args)...); })
+	{
+	}
+
+	R operator()(Args... args) const { return m_pCall(m_pFn, std::forward<Args>(args)...); }
+
+private:
+	void* m_pFn;
+	R (*m_pCall)(void* pFn, Args... args);
+};
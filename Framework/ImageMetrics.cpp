@@ -0,0 +1,489 @@
+#include "ImageMetrics.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define METRICS_SSE2 1
+#endif
+
+namespace ImageMetrics
+{
+	namespace
+	{
+		// Texels per partial sum. Fixed so the totals add up in the same order on any pool.
+		constexpr u32 kSumChunk = 4096;
+
+		// SSIM's window and constants, for a dynamic range of 1.
+		constexpr f32 kSsimSigma = 1.5f;
+		constexpr s32 kSsimRadius = 5;
+		constexpr f32 kSsimC1 = 0.01f * 0.01f;
+		constexpr f32 kSsimC2 = 0.03f * 0.03f;
+
+		// FLIP's achromatic contrast sensitivity (a gaussian of variance b1 / 2 pi^2 degrees), feature
+		// detector width, exponents and colour error compression.
+		constexpr f32 kFlipCsfSigmaDegrees = 0.0154306f;
+		constexpr f32 kFlipFeatureWidth = 0.082f;
+		constexpr f32 kFlipQc = 0.7f;
+		constexpr f32 kFlipQf = 0.5f;
+		constexpr f32 kFlipPc = 0.4f;
+		constexpr f32 kFlipPt = 0.95f;
+		// Hunt adjusted HyAB distance between green and blue ^ qc, FLIP's largest colour error.
+		constexpr f32 kFlipCmax = 41.2752f;
+
+		struct Kernel
+		{
+			s32 radius = 0;
+			std::vector<f32> weights;	// weights[radius + i] for offset i.
+
+			u32 taps() const { return (u32)weights.size(); }
+		};
+
+		Kernel gaussian(f32 sigma, s32 radius)
+		{
+			Kernel k;
+			k.radius = radius;
+			k.weights.resize(2 * radius + 1);
+			f32 sum = 0.f;
+			for (s32 i = -radius; i <= radius; ++i)
+			{
+				k.weights[radius + i] = std::exp(-(f32)(i * i) / (2.f * sigma * sigma));
+				sum += k.weights[radius + i];
+			}
+			for (f32& w : k.weights)
+			{
+				w /= sum;
+			}
+			return k;
+		}
+
+		// First (edges) or second (points) derivative of a gaussian. Like FLIP the positive and the
+		// negative weights are scaled to sum to 1 and -1 apiece.
+		Kernel gaussian_derivative(f32 sigma, s32 radius, u32 order)
+		{
+			Kernel k;
+			k.radius = radius;
+			k.weights.resize(2 * radius + 1);
+			f32 positive = 0.f;
+			f32 negative = 0.f;
+			for (s32 i = -radius; i <= radius; ++i)
+			{
+				const f32 x = (f32)i;
+				const f32 g = std::exp(-x * x / (2.f * sigma * sigma));
+				const f32 w = order == 1 ? -x * g : (x * x / (sigma * sigma) - 1.f) * g;
+				k.weights[radius + i] = w;
+				(w > 0.f ? positive : negative) += w;
+			}
+			for (f32& w : k.weights)
+			{
+				w = w > 0.f ? w / positive : (w < 0.f ? w / -negative : 0.f);
+			}
+			return k;
+		}
+
+		void for_rows(u32 height, WorkerPool* pPool, const WorkerPool::RangeFn& fn)
+		{
+			if (pPool)
+			{
+				pPool->parallel_for(height, 8, fn);
+			}
+			else
+			{
+				fn(0, height);
+			}
+		}
+
+		void for_texels(u32 count, WorkerPool* pPool, const WorkerPool::RangeFn& fn)
+		{
+			if (pPool)
+			{
+				pPool->parallel_for(count, kSumChunk, fn);
+			}
+			else
+			{
+				fn(0, count);
+			}
+		}
+
+		// chunkSum(begin, end) over kSumChunk sized chunks of [0, count), added up in chunk order.
+		template <typename ChunkSum>
+		f64 chunked_sum(u32 count, WorkerPool* pPool, const ChunkSum& chunkSum)
+		{
+			const u32 chunks = (count + kSumChunk - 1) / kSumChunk;
+			std::vector<f64> partial(chunks, 0.0);
+			auto sums = [&](u32 begin, u32 end)
+			{
+				for (u32 c = begin; c < end; ++c)
+				{
+					partial[c] = chunkSum(c * kSumChunk, std::min(count, (c + 1) * kSumChunk));
+				}
+			};
+
+			if (pPool)
+			{
+				pPool->parallel_for(chunks, 1, sums);
+			}
+			else
+			{
+				sums(0, chunks);
+			}
+
+			f64 sum = 0.0;
+			for (f64 p : partial)
+			{
+				sum += p;
+			}
+			return sum;
+		}
+
+		// pOut[x] = sum of pRows[t][x] * weights[t], 4 texels at a time. The scalar tail adds the taps
+		// in the same order so every texel rounds the same way.
+		void weighted_sum(const f32* const* pRows, const Kernel& k, f32* pOut, u32 width)
+		{
+			u32 x = 0;
+#if METRICS_SSE2
+			for (; x + 4 <= width; x += 4)
+			{
+				__m128 sum = _mm_setzero_ps();
+				for (u32 t = 0; t < k.taps(); ++t)
+				{
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pRows[t] + x), _mm_set1_ps(k.weights[t])));
+				}
+				_mm_storeu_ps(pOut + x, sum);
+			}
+#endif
+			for (; x < width; ++x)
+			{
+				f32 sum = 0.f;
+				for (u32 t = 0; t < k.taps(); ++t)
+				{
+					sum += pRows[t][x] * k.weights[t];
+				}
+				pOut[x] = sum;
+			}
+		}
+
+		inline u32 clamp_index(s32 i, u32 size)
+		{
+			return (u32)std::min(std::max(i, 0), (s32)size - 1);
+		}
+
+		// kx along the rows into pScratch, then ky down the columns into pOut. Edges clamp.
+		void convolve(const f32* pIn, f32* pOut, f32* pScratch, u32 width, u32 height, const Kernel& kx, const Kernel& ky, WorkerPool* pPool)
+		{
+			for_rows(height, pPool, [&](u32 begin, u32 end)
+			{
+				// The row with the apron clamped in, each tap then reads it at an offset.
+				std::vector<f32> padded(width + 2 * kx.radius);
+				std::vector<const f32*> rows(kx.taps());
+				for (u32 t = 0; t < kx.taps(); ++t)
+				{
+					rows[t] = padded.data() + t;
+				}
+
+				for (u32 y = begin; y < end; ++y)
+				{
+					const f32* pRow = pIn + (size_t)y * width;
+					for (u32 i = 0; i < padded.size(); ++i)
+					{
+						padded[i] = pRow[clamp_index((s32)i - kx.radius, width)];
+					}
+					weighted_sum(rows.data(), kx, pScratch + (size_t)y * width, width);
+				}
+			});
+
+			for_rows(height, pPool, [&](u32 begin, u32 end)
+			{
+				std::vector<const f32*> rows(ky.taps());
+				for (u32 y = begin; y < end; ++y)
+				{
+					for (u32 t = 0; t < ky.taps(); ++t)
+					{
+						rows[t] = pScratch + (size_t)clamp_index((s32)y + (s32)t - ky.radius, height) * width;
+					}
+					weighted_sum(rows.data(), ky, pOut + (size_t)y * width, width);
+				}
+			});
+		}
+
+		// CIE L* of luminance y, white at 1.
+		inline f32 lightness(f32 y)
+		{
+			const f32 kDelta = 6.f / 29.f;
+			const f32 f = y > kDelta * kDelta * kDelta ? std::cbrt(y) : y / (3.f * kDelta * kDelta) + 4.f / 29.f;
+			return 116.f * f - 16.f;
+		}
+
+		inline f32 saturate(f32 v)
+		{
+			return std::min(std::max(v, 0.f), 1.f);
+		}
+	}
+
+	f64 mse(const f32* pReference, const f32* pTest, u32 width, u32 height, WorkerPool* pPool)
+	{
+		const u32 count = width * height;
+		if (!count)
+			return 0.0;
+
+		const f64 sum = chunked_sum(count, pPool, [&](u32 begin, u32 end)
+		{
+			u32 i = begin;
+			f32 sum = 0.f;
+#if METRICS_SSE2
+			__m128 sum4 = _mm_setzero_ps();
+			for (; i + 4 <= end; i += 4)
+			{
+				const __m128 d = _mm_sub_ps(_mm_loadu_ps(pTest + i), _mm_loadu_ps(pReference + i));
+				sum4 = _mm_add_ps(sum4, _mm_mul_ps(d, d));
+			}
+			alignas(16) f32 lanes[4];
+			_mm_store_ps(lanes, sum4);
+			sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+			for (; i < end; ++i)
+			{
+				const f32 d = pTest[i] - pReference[i];
+				sum += d * d;
+			}
+			return (f64)sum;
+		});
+		return sum / count;
+	}
+
+	f32 psnr(f64 mse)
+	{
+		return mse > 0.0 ? std::min(kMaxPsnr, (f32)(10.0 * std::log10(1.0 / mse))) : kMaxPsnr;
+	}
+
+	f32 ssim(const f32* pReference, const f32* pTest, u32 width, u32 height, std::vector<f32>* pMap, WorkerPool* pPool)
+	{
+		const u32 count = width * height;
+		if (!count)
+			return 1.f;
+
+		// x^2, y^2 and xy, then the window over all five.
+		std::vector<f32> planes[8];
+		for (std::vector<f32>& plane : planes)
+		{
+			plane.resize(count);
+		}
+		std::vector<f32>& xx = planes[0];
+		std::vector<f32>& yy = planes[1];
+		std::vector<f32>& xy = planes[2];
+		std::vector<f32>& muX = planes[3];
+		std::vector<f32>& muY = planes[4];
+		std::vector<f32>& sigmaXX = planes[5];
+		std::vector<f32>& sigmaYY = planes[6];
+		std::vector<f32>& sigmaXY = planes[7];
+
+		for_texels(count, pPool, [&](u32 begin, u32 end)
+		{
+			u32 i = begin;
+#if METRICS_SSE2
+			for (; i + 4 <= end; i += 4)
+			{
+				const __m128 x = _mm_loadu_ps(pReference + i);
+				const __m128 y = _mm_loadu_ps(pTest + i);
+				_mm_storeu_ps(&xx[i], _mm_mul_ps(x, x));
+				_mm_storeu_ps(&yy[i], _mm_mul_ps(y, y));
+				_mm_storeu_ps(&xy[i], _mm_mul_ps(x, y));
+			}
+#endif
+			for (; i < end; ++i)
+			{
+				xx[i] = pReference[i] * pReference[i];
+				yy[i] = pTest[i] * pTest[i];
+				xy[i] = pReference[i] * pTest[i];
+			}
+		});
+
+		const Kernel window = gaussian(kSsimSigma, kSsimRadius);
+		std::vector<f32> scratch(count);
+		convolve(pReference, muX.data(), scratch.data(), width, height, window, window, pPool);
+		convolve(pTest, muY.data(), scratch.data(), width, height, window, window, pPool);
+		convolve(xx.data(), sigmaXX.data(), scratch.data(), width, height, window, window, pPool);
+		convolve(yy.data(), sigmaYY.data(), scratch.data(), width, height, window, window, pPool);
+		convolve(xy.data(), sigmaXY.data(), scratch.data(), width, height, window, window, pPool);
+
+		// The map goes into xx, done with it.
+		f32* pSsim = xx.data();
+		for_texels(count, pPool, [&](u32 begin, u32 end)
+		{
+			u32 i = begin;
+#if METRICS_SSE2
+			const __m128 c1 = _mm_set1_ps(kSsimC1);
+			const __m128 c2 = _mm_set1_ps(kSsimC2);
+			const __m128 two = _mm_set1_ps(2.f);
+			for (; i + 4 <= end; i += 4)
+			{
+				const __m128 mx = _mm_loadu_ps(&muX[i]);
+				const __m128 my = _mm_loadu_ps(&muY[i]);
+				const __m128 mxx = _mm_mul_ps(mx, mx);
+				const __m128 myy = _mm_mul_ps(my, my);
+				const __m128 mxy = _mm_mul_ps(mx, my);
+				const __m128 vx = _mm_sub_ps(_mm_loadu_ps(&sigmaXX[i]), mxx);
+				const __m128 vy = _mm_sub_ps(_mm_loadu_ps(&sigmaYY[i]), myy);
+				const __m128 cxy = _mm_sub_ps(_mm_loadu_ps(&sigmaXY[i]), mxy);
+				const __m128 numerator = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(two, mxy), c1), _mm_add_ps(_mm_mul_ps(two, cxy), c2));
+				const __m128 denominator = _mm_mul_ps(_mm_add_ps(_mm_add_ps(mxx, myy), c1), _mm_add_ps(_mm_add_ps(vx, vy), c2));
+				_mm_storeu_ps(pSsim + i, _mm_div_ps(numerator, denominator));
+			}
+#endif
+			for (; i < end; ++i)
+			{
+				const f32 mxx = muX[i] * muX[i];
+				const f32 myy = muY[i] * muY[i];
+				const f32 mxy = muX[i] * muY[i];
+				const f32 numerator = (2.f * mxy + kSsimC1) * (2.f * (sigmaXY[i] - mxy) + kSsimC2);
+				const f32 denominator = (mxx + myy + kSsimC1) * ((sigmaXX[i] - mxx) + (sigmaYY[i] - myy) + kSsimC2);
+				pSsim[i] = numerator / denominator;
+			}
+		});
+
+		const f64 sum = chunked_sum(count, pPool, [&](u32 begin, u32 end)
+		{
+			f64 sum = 0.0;
+			for (u32 i = begin; i < end; ++i)
+			{
+				sum += pSsim[i];
+			}
+			return sum;
+		});
+
+		if (pMap)
+		{
+			pMap->swap(xx);
+		}
+		return (f32)(sum / count);
+	}
+
+	f32 flip(const f32* pReference, const f32* pTest, u32 width, u32 height, const Params& params, std::vector<f32>* pMap
+		, f32* pMax, WorkerPool* pPool)
+	{
+		const u32 count = width * height;
+		if (pMax)
+		{
+			*pMax = 0.f;
+		}
+		if (!count)
+			return 0.f;
+
+		const f32 csfSigma = kFlipCsfSigmaDegrees * params.pixelsPerDegree;
+		const Kernel csf = gaussian(csfSigma, std::max(1, (s32)std::ceil(3.f * csfSigma)));
+
+		const f32 featureSigma = 0.5f * kFlipFeatureWidth * params.pixelsPerDegree;
+		const s32 featureRadius = std::max(1, (s32)std::ceil(3.f * featureSigma));
+		const Kernel smooth = gaussian(featureSigma, featureRadius);
+		const Kernel edge = gaussian_derivative(featureSigma, featureRadius, 1);
+		const Kernel point = gaussian_derivative(featureSigma, featureRadius, 2);
+
+		// Reference then test: the eye filtered image, then the edge and point responses x and y.
+		enum
+		{
+			kFiltered,
+			kEdgeX,
+			kEdgeY,
+			kPointX,
+			kPointY,
+			kPlanes
+		};
+		std::vector<f32> planes[2][kPlanes];
+		std::vector<f32> clamped(count);
+		std::vector<f32> scratch(count);
+		const f32* pImages[2] = { pReference, pTest };
+		for (u32 image = 0; image < 2; ++image)
+		{
+			for (std::vector<f32>& plane : planes[image])
+			{
+				plane.resize(count);
+			}
+
+			for_texels(count, pPool, [&](u32 begin, u32 end)
+			{
+				for (u32 i = begin; i < end; ++i)
+				{
+					clamped[i] = saturate(pImages[image][i]);
+				}
+			});
+
+			std::vector<f32>* pOut = planes[image];
+			convolve(clamped.data(), pOut[kFiltered].data(), scratch.data(), width, height, csf, csf, pPool);
+			convolve(clamped.data(), pOut[kEdgeX].data(), scratch.data(), width, height, edge, smooth, pPool);
+			convolve(clamped.data(), pOut[kEdgeY].data(), scratch.data(), width, height, smooth, edge, pPool);
+			convolve(clamped.data(), pOut[kPointX].data(), scratch.data(), width, height, point, smooth, pPool);
+			convolve(clamped.data(), pOut[kPointY].data(), scratch.data(), width, height, smooth, point, pPool);
+		}
+
+		// The error map goes into clamped, done with it.
+		f32* pError = clamped.data();
+		for_texels(count, pPool, [&](u32 begin, u32 end)
+		{
+			const std::vector<f32>* r = planes[0];
+			const std::vector<f32>* t = planes[1];
+			const f32 pcCmax = kFlipPc * kFlipCmax;
+			for (u32 i = begin; i < end; ++i)
+			{
+				// Achromatic HyAB is the L* difference.
+				const f32 colour = std::pow(std::fabs(lightness(saturate(r[kFiltered][i])) - lightness(saturate(t[kFiltered][i]))), kFlipQc);
+				const f32 colourError = colour < pcCmax ? colour * (kFlipPt / pcCmax)
+					: kFlipPt + (colour - pcCmax) / (kFlipCmax - pcCmax) * (1.f - kFlipPt);
+
+				const f32 edgeR = std::sqrt(r[kEdgeX][i] * r[kEdgeX][i] + r[kEdgeY][i] * r[kEdgeY][i]);
+				const f32 edgeT = std::sqrt(t[kEdgeX][i] * t[kEdgeX][i] + t[kEdgeY][i] * t[kEdgeY][i]);
+				const f32 pointR = std::sqrt(r[kPointX][i] * r[kPointX][i] + r[kPointY][i] * r[kPointY][i]);
+				const f32 pointT = std::sqrt(t[kPointX][i] * t[kPointX][i] + t[kPointY][i] * t[kPointY][i]);
+				const f32 feature = std::max(std::fabs(edgeR - edgeT), std::fabs(pointR - pointT)) * 0.70710678f;
+				const f32 featureError = std::pow(std::min(feature, 1.f), kFlipQf);
+
+				pError[i] = std::pow(colourError, 1.f - featureError);
+			}
+		});
+
+		f32 maxError = 0.f;
+		const f64 sum = chunked_sum(count, pPool, [&](u32 begin, u32 end)
+		{
+			f64 sum = 0.0;
+			for (u32 i = begin; i < end; ++i)
+			{
+				sum += pError[i];
+			}
+			return sum;
+		});
+		for (u32 i = 0; i < count; ++i)
+		{
+			maxError = std::max(maxError, pError[i]);
+		}
+
+		if (pMax)
+		{
+			*pMax = maxError;
+		}
+		if (pMap)
+		{
+			pMap->swap(clamped);
+		}
+		return (f32)(sum / count);
+	}
+
+	Scores compare(const f32* pReference, const f32* pTest, u32 width, u32 height, const Params& params, Maps* pMaps, WorkerPool* pPool)
+	{
+		Scores scores;
+		scores.mse = mse(pReference, pTest, width, height, pPool);
+		scores.psnr = psnr(scores.mse);
+		scores.ssim = ssim(pReference, pTest, width, height, pMaps ? &pMaps->ssim : nullptr, pPool);
+		scores.flip = flip(pReference, pTest, width, height, params, pMaps ? &pMaps->flip : nullptr, &scores.flipMax, pPool);
+		return scores;
+	}
+
+	const char* isa()
+	{
+#if METRICS_SSE2
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+class WorkerPool;
+
+//================================================================================
+// Image Metrics
+// How close an AO buffer is to a reference (ray traced, or many taps), so a
+// configuration's quality can sit next to its frame time:
+//  - PSNR : 10 log10(1 / MSE). Every texel counts the same.
+//  - SSIM : Wang et al. 2004, an 11 tap gaussian window (sigma 1.5) over the
+//    means, variances and covariance. Catches noise and blur that a small MSE
+//    hides.
+//  - FLIP : the achromatic half of NVIDIA's FLIP (Andersson et al. 2020). Both
+//    images go through the eye's contrast sensitivity at pixelsPerDegree, the
+//    L* difference is compressed the way FLIP does, then raised by the
+//    difference in edges and points. A per texel error map, 0 equal to 1 as far
+//    apart as FLIP goes.
+//
+// Images are single channel f32 planes, row major, holding displayed linear
+// intensity in [0, 1] (pass visibility, 1 - obscurance). Filters are separable,
+// edges clamp. Rows go over a WorkerPool, the filter and per texel loops take 4
+// texels at a time with SSE2. Sums are per fixed chunk so the scores don't
+// depend on the thread count. Only standard headers so it builds with the CPU
+// tools.
+//================================================================================
+namespace ImageMetrics
+{
+	// PSNR of identical images, instead of infinity.
+	constexpr f32 kMaxPsnr = 100.f;
+
+	struct Params
+	{
+		// FLIP's default: a 0.7 m wide 3840 pixel monitor 0.7 m away.
+		f32 pixelsPerDegree = 67.f;
+	};
+
+	struct Scores
+	{
+		f64 mse = 0.0;
+		f32 psnr = kMaxPsnr;
+		f32 ssim = 1.f;
+		f32 flip = 0.f;			// mean of the error map.
+		f32 flipMax = 0.f;
+	};
+
+	// Optional per texel outputs of compare(), resized to width * height.
+	struct Maps
+	{
+		std::vector<f32> ssim;
+		std::vector<f32> flip;
+	};
+
+	f64 mse(const f32* pReference, const f32* pTest, u32 width, u32 height, WorkerPool* pPool = nullptr);
+	f32 psnr(f64 mse);
+
+	// Mean SSIM, pMap gets the per texel values when not null.
+	f32 ssim(const f32* pReference, const f32* pTest, u32 width, u32 height, std::vector<f32>* pMap = nullptr, WorkerPool* pPool = nullptr);
+
+	// Mean FLIP, pMap gets the error map when not null.
+	f32 flip(const f32* pReference, const f32* pTest, u32 width, u32 height, const Params& params, std::vector<f32>* pMap = nullptr
+		, f32* pMax = nullptr, WorkerPool* pPool = nullptr);
+
+	Scores compare(const f32* pReference, const f32* pTest, u32 width, u32 height, const Params& params, Maps* pMaps = nullptr
+		, WorkerPool* pPool = nullptr);
+
+	// "SSE2" or "Scalar", what the filters were compiled with.
+	const char* isa();
+}
@@ -0,0 +1,50 @@
+#include "InstanceBatch.h"
+
+#include <algorithm>
+
+void InstanceBatcher::clear()
+{
+	m_keys.clear();
+	m_items.clear();
+	m_sortedItems.clear();
+	m_batches.clear();
+}
+
+void InstanceBatcher::reserve(u32 count)
+{
+	m_keys.reserve(count);
+	m_items.reserve(count);
+	m_sortedItems.reserve(count);
+}
+
+void InstanceBatcher::add(u32 shader, u32 mesh, u32 item)
+{
+	ASSERT(shader <= kMaxId && mesh <= kMaxId);
+
+	m_keys.push_back(((u64)shader << 48) | ((u64)mesh << 32) | (u64)m_items.size());
+	m_items.push_back(item);
+}
+
+void InstanceBatcher::build()
+{
+	// The add order in the low bits makes every key unique, so a plain sort is stable.
+	std::sort(m_keys.begin(), m_keys.end());
+
+	m_sortedItems.resize(m_keys.size());
+	m_batches.clear();
+
+	for (u32 i = 0; i < (u32)m_keys.size(); ++i)
+	{
+		const u64 key = m_keys[i];
+		const u32 shader = (u32)(key >> 48);
+		const u32 mesh = (u32)(key >> 32) & kMaxId;
+
+		m_sortedItems[i] = m_items[(u32)key];
+
+		if (m_batches.empty() || m_batches.back().shader != shader || m_batches.back().mesh != mesh)
+		{
+			m_batches.push_back({ shader, mesh, i, 0 });
+		}
+		++m_batches.back().instanceCount;
+	}
+}
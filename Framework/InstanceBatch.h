@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+//================================================================================
+// Instance Batching
+// Draws are added as (shader, mesh, item) where the ids are whatever the caller
+// indexes its shaders / meshes / per-instance data with. build() sorts them by
+// shader then mesh, keeping the order they were added in within a batch, and
+// groups the runs. Upload per-instance data in items() order and each batch is
+// one instanced draw over [firstInstance, firstInstance + instanceCount).
+//
+// Only standard headers, no device needed to drive it.
+//================================================================================
+
+struct InstanceBatch
+{
+	u32 shader;
+	u32 mesh;
+	u32 firstInstance;
+	u32 instanceCount;
+};
+
+class InstanceBatcher
+{
+public:
+	static constexpr u32 kMaxId = 0xffff;
+
+	void clear();
+	void reserve(u32 count);
+
+	// shader and mesh must be <= kMaxId.
+	void add(u32 shader, u32 mesh, u32 item);
+
+	void build();
+
+	// Valid after build().
+	const std::vector<InstanceBatch>& batches() const { return m_batches; }
+	const std::vector<u32>& items() const { return m_sortedItems; }
+
+	u32 size() const { return (u32)m_items.size(); }
+
+private:
+	std::vector<u64> m_keys;		// shader:16 | mesh:16 | add order:32
+	std::vector<u32> m_items;		// in add order
+	std::vector<u32> m_sortedItems;
+	std::vector<InstanceBatch> m_batches;
+};
@@ -4,7 +4,7 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
+#include <vector>
 
 // ========================================================
 // class JobQueue
@@ -40,7 +40,12 @@ public:
 	void pushJob(Job job)
 	{
 		std::lock_guard<std::mutex> lock(mutex);
-		queue.push(std::move(job));
+		if (count == jobs.size())
+		{
+			grow();
+		}
+		jobs[(head + count) % jobs.size()] = std::move(job);
+		++count;
 		condition.notify_one();
 	}
 
@@ -48,7 +53,7 @@ public:
 	void waitAll()
 	{
 		std::unique_lock<std::mutex> lock(mutex);
-		condition.wait(lock, [this]() { return queue.empty(); });
+		condition.wait(lock, [this]() { return count == 0; });
 	}
 
 private:
@@ -59,28 +64,50 @@ private:
 			Job job;
 			{
 				std::unique_lock<std::mutex> lock(mutex);
-				condition.wait(lock, [this] { return !queue.empty() || terminating; });
+				condition.wait(lock, [this] { return count != 0 || terminating; });
 				if (terminating)
 				{
 					break;
 				}
-				job = queue.front();
+				job = std::move(jobs[head]);
 			}
 
 			job();
+			job = nullptr;
 
 			{
+				// Stays counted until it's done, waitAll() waits for the job not the queue.
 				std::lock_guard<std::mutex> lock(mutex);
-				queue.pop();
+				jobs[head] = nullptr;
+				head = (head + 1) % jobs.size();
+				--count;
 				condition.notify_one();
 			}
 		}
 	}
 
+	// Double the ring, the pending jobs move to the front in order.
+	void grow()
+	{
+		std::vector<Job> grown(jobs.empty() ? 4 : jobs.size() * 2);
+		for (size_t i = 0; i < count; ++i)
+		{
+			grown[i] = std::move(jobs[(head + i) % jobs.size()]);
+		}
+		jobs.swap(grown);
+		head = 0;
+	}
+
 	bool terminating = false;
 
 	std::thread worker;
-	std::queue<Job> queue;
+
+	// Ring of pending jobs, the running one included. It only grows when every slot is taken,
+	// so once it has been as deep as it gets pushing a job costs no allocation (std::queue's
+	// deque allocated a block per job with MSVC).
+	std::vector<Job> jobs;
+	size_t head = 0;
+	size_t count = 0;
 	std::mutex mutex;
 	std::condition_variable condition;
 };
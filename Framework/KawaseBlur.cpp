@@ -0,0 +1,144 @@
+#include "KawaseBlur.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	// Bilinear tap at (sx, sy) in source texels (texel centres at + 0.5), clamped like the targets' edges.
+	inline f32 sample_bilinear(const f32* pIn, u32 width, u32 height, f32 sx, f32 sy)
+	{
+		const f32 fx = sx - 0.5f;
+		const f32 fy = sy - 0.5f;
+		const f32 x0f = std::floor(fx);
+		const f32 y0f = std::floor(fy);
+		const f32 tx = fx - x0f;
+		const f32 ty = fy - y0f;
+
+		const s32 maxX = (s32)width - 1;
+		const s32 maxY = (s32)height - 1;
+		const s32 x0 = std::min(std::max((s32)x0f, 0), maxX);
+		const s32 x1 = std::min(std::max((s32)x0f + 1, 0), maxX);
+		const s32 y0 = std::min(std::max((s32)y0f, 0), maxY);
+		const s32 y1 = std::min(std::max((s32)y0f + 1, 0), maxY);
+
+		const f32* pRow0 = pIn + (size_t)y0 * width;
+		const f32* pRow1 = pIn + (size_t)y1 * width;
+		const f32 top = pRow0[x0] + (pRow0[x1] - pRow0[x0]) * tx;
+		const f32 bottom = pRow1[x0] + (pRow1[x1] - pRow1[x0]) * tx;
+		return top + (bottom - top) * ty;
+	}
+
+	// fn(x, y, sx, sy) for every output texel, (sx, sy) is its centre in source texels. Rows go over pPool.
+	template <typename Fn>
+	void for_each_texel(u32 inWidth, u32 inHeight, f32* pOut, u32 outWidth, u32 outHeight, WorkerPool* pPool, const Fn& fn)
+	{
+		const f32 scaleX = (f32)inWidth / outWidth;
+		const f32 scaleY = (f32)inHeight / outHeight;
+
+		auto rows = [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; ++y)
+			{
+				const f32 sy = (y + 0.5f) * scaleY;
+				f32* pRow = pOut + (size_t)y * outWidth;
+				for (u32 x = 0; x < outWidth; ++x)
+				{
+					pRow[x] = fn((x + 0.5f) * scaleX, sy);
+				}
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(outHeight, 16, rows);
+		}
+		else
+		{
+			rows(0, outHeight);
+		}
+	}
+}
+
+void kawase_pass(const f32* pIn, f32* pOut, u32 width, u32 height, u32 distance, WorkerPool* pPool)
+{
+	const f32 d = distance + 0.5f;
+	for_each_texel(width, height, pOut, width, height, pPool, [&](f32 sx, f32 sy)
+	{
+		return (sample_bilinear(pIn, width, height, sx - d, sy + d)
+			+ sample_bilinear(pIn, width, height, sx + d, sy + d)
+			+ sample_bilinear(pIn, width, height, sx + d, sy - d)
+			+ sample_bilinear(pIn, width, height, sx - d, sy - d)) * 0.25f;
+	});
+}
+
+void dual_filter_down(const f32* pIn, u32 inWidth, u32 inHeight, f32* pOut, u32 outWidth, u32 outHeight, WorkerPool* pPool)
+{
+	for_each_texel(inWidth, inHeight, pOut, outWidth, outHeight, pPool, [&](f32 sx, f32 sy)
+	{
+		f32 sum = sample_bilinear(pIn, inWidth, inHeight, sx, sy) * 4.f;
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx - 1.f, sy - 1.f);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx + 1.f, sy - 1.f);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx + 1.f, sy + 1.f);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx - 1.f, sy + 1.f);
+		return sum * (1.f / 8.f);
+	});
+}
+
+void dual_filter_up(const f32* pIn, u32 inWidth, u32 inHeight, f32* pOut, u32 outWidth, u32 outHeight, WorkerPool* pPool)
+{
+	for_each_texel(inWidth, inHeight, pOut, outWidth, outHeight, pPool, [&](f32 sx, f32 sy)
+	{
+		f32 sum = sample_bilinear(pIn, inWidth, inHeight, sx - 1.f, sy);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx + 1.f, sy);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx, sy - 1.f);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx, sy + 1.f);
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx - 0.5f, sy - 0.5f) * 2.f;
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx + 0.5f, sy - 0.5f) * 2.f;
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx + 0.5f, sy + 0.5f) * 2.f;
+		sum += sample_bilinear(pIn, inWidth, inHeight, sx - 0.5f, sy + 0.5f) * 2.f;
+		return sum * (1.f / 12.f);
+	});
+}
+
+void blur_dual_filter(const f32* pIn, f32* pOut, u32 width, u32 height, u32 levels, WorkerPool* pPool)
+{
+	ASSERT(levels > 0 && levels <= kDualFilterMaxLevels);
+
+	// levels + 1 images, [0] is only ever the input.
+	std::vector<f32> pyramid[kDualFilterMaxLevels + 1];
+	for (u32 level = 1; level <= levels; ++level)
+	{
+		pyramid[level].resize((size_t)dual_filter_level_size(width, level) * dual_filter_level_size(height, level));
+	}
+
+	const f32* pSrc = pIn;
+	for (u32 level = 1; level <= levels; ++level)
+	{
+		dual_filter_down(pSrc, dual_filter_level_size(width, level - 1), dual_filter_level_size(height, level - 1)
+			, pyramid[level].data(), dual_filter_level_size(width, level), dual_filter_level_size(height, level), pPool);
+		pSrc = pyramid[level].data();
+	}
+
+	// Back up, each level overwrites the one it was downsampled into. The last writes the output.
+	for (u32 level = levels; level > 0; --level)
+	{
+		f32* pDst = level == 1 ? pOut : pyramid[level - 1].data();
+		dual_filter_up(pyramid[level].data(), dual_filter_level_size(width, level), dual_filter_level_size(height, level)
+			, pDst, dual_filter_level_size(width, level - 1), dual_filter_level_size(height, level - 1), pPool);
+	}
+}
+
+f32 dual_filter_fetches(u32 levels)
+{
+	// Down pass into level i covers 1/4^i of the texels with 5 taps, the up pass out of it 1/4^(i-1) with 8.
+	f32 fetches = 0.f;
+	for (u32 level = 1; level <= levels; ++level)
+	{
+		const f32 area = 1.f / (f32)(1u << (2 * level));
+		fetches += area * 5.f + area * 4.f * 8.f;
+	}
+	return fetches;
+}
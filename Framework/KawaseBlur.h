@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+//================================================================================
+// Kawase Blurs
+// CPU twins of PS_BLUR_KAWASE and the dual filter pyramid (PS_BLUR_DUAL_DOWN /
+// PS_BLUR_DUAL_UP in SSAOShaders.fx), taps are bilinear like the GPU's.
+//
+// The plain Kawase blur runs every iteration at full size with 4 taps a pixel,
+// the radius only grows by the kernel distance each pass. The dual filter halves
+// the target on the way down (5 taps) and doubles it on the way back up (8 taps),
+// each level doubles the radius while the work shrinks by 4, so large radii cost
+// little more than small ones.
+//
+// Single channel f32 planes, row major, edges clamp. Only standard headers so it
+// builds with the CPU benchmark.
+//================================================================================
+
+class WorkerPool;
+
+constexpr u32 kDualFilterMaxLevels = 6;
+
+// Size of pyramid level [level] for a width / height image, level 0 is the image.
+inline u32 dual_filter_level_size(u32 size, u32 level) { return (size >> level) ? (size >> level) : 1; }
+
+// One PS_BLUR_KAWASE iteration, 4 taps (distance + 0.5) texels out on the diagonals.
+void kawase_pass(const f32* pIn, f32* pOut, u32 width, u32 height, u32 distance, WorkerPool* pPool = nullptr);
+
+// PS_BLUR_DUAL_DOWN, centre x4 plus the 4 diagonal corners of the output pixel, outWidth x outHeight
+// is normally half the input.
+void dual_filter_down(const f32* pIn, u32 inWidth, u32 inHeight, f32* pOut, u32 outWidth, u32 outHeight, WorkerPool* pPool = nullptr);
+
+// PS_BLUR_DUAL_UP, 4 taps one source texel out on the axes and 4 (x2) half a texel out on the
+// diagonals, outWidth x outHeight is normally twice the input.
+void dual_filter_up(const f32* pIn, u32 inWidth, u32 inHeight, f32* pOut, u32 outWidth, u32 outHeight, WorkerPool* pPool = nullptr);
+
+// levels down passes then levels up passes back to width x height.
+void blur_dual_filter(const f32* pIn, f32* pOut, u32 width, u32 height, u32 levels, WorkerPool* pPool = nullptr);
+
+// Texture fetches per output texel, for comparing against the other blurs' costs.
+f32 dual_filter_fetches(u32 levels);
@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* pPath)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const void* pData = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!pData)
+	{
+		if (hMapping)
+			CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_hFile = hFile;
+	m_hMapping = hMapping;
+	m_pData = (const u8*)pData;
+	m_size = (u64)size.QuadPart;
+#else
+	const int fd = ::open(pPath, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* pData = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping holds its own reference to the file.
+	::close(fd);
+	if (pData == MAP_FAILED)
+		return false;
+
+	m_pData = (const u8*)pData;
+	m_size = (u64)info.st_size;
+#endif
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (!m_pData)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_pData);
+	CloseHandle((HANDLE)m_hMapping);
+	CloseHandle((HANDLE)m_hFile);
+	m_hMapping = nullptr;
+	m_hFile = nullptr;
+#else
+	munmap((void*)m_pData, (size_t)m_size);
+#endif
+	m_pData = nullptr;
+	m_size = 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+//================================================================================
+// MappedFile
+// A whole file mapped read only into the address space, so large captures are
+// paged in as they are read instead of copied up front. Views into data() stay
+// valid until close(). MapViewOfFile on Windows, mmap elsewhere. Only standard
+// and OS headers (in the .cpp) so it builds with the CPU tools.
+//================================================================================
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Closes what was open first. False when the file can't be opened, is empty or can't be mapped.
+	bool open(const char* pPath);
+	void close();
+
+	bool is_open() const { return m_pData != nullptr; }
+	const u8* data() const { return m_pData; }
+	u64 size() const { return m_size; }
+
+private:
+	const u8* m_pData = nullptr;
+	u64 m_size = 0;
+
+#ifdef _WIN32
+	void* m_hFile = nullptr;
+	void* m_hMapping = nullptr;
+#endif
+};
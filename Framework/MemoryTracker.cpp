@@ -0,0 +1,252 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace MemoryTracker
+{
+	namespace
+	{
+		constexpr u32 kTags = (u32)MemoryTag::kCount;
+		constexpr u32 kDomains = (u32)MemoryDomain::kCount;
+		constexpr u32 kTotal = kTags;	// counter slot of the whole domain
+		constexpr u32 kBlockMagic = 0x4D454D54;	// 'MEMT'
+
+		struct Counter
+		{
+			std::atomic<u64> current{ 0 };
+			std::atomic<u64> peak{ 0 };
+			std::atomic<u64> budget{ 0 };
+			std::atomic<u64> allocations{ 0 };
+			std::atomic<u32> live{ 0 };
+			std::atomic<bool> over{ false };
+		};
+
+		// Constant initialised, so allocations from other statics' constructors are counted.
+		Counter g_counters[kDomains][kTags + 1];
+		std::atomic<u32> g_warnings{ 0 };
+		std::atomic<u64> g_heapAllocations{ 0 };
+		std::atomic<WarningFn> g_warningFn{ nullptr };
+
+		// Sits right before the pointer allocate() returns.
+		struct BlockHeader
+		{
+			void* pBase;
+			u64 bytes;
+			u32 tag;
+			u32 magic;
+		};
+
+		const char* kTagNames[kTags] = { "Mesh", "Texture", "Render Target", "Transient", "UI" };
+		const char* kDomainNames[kDomains] = { "RAM", "VRAM" };
+
+		void warn(const char* pWhat, MemoryDomain domain, u64 bytes, u64 budget)
+		{
+			char message[160];
+			snprintf(message, sizeof(message), "Memory budget exceeded: %s %s at %.2f MB, budget %.2f MB", pWhat, domain_name(domain)
+				, bytes / (f64)MB, budget / (f64)MB);
+
+			g_warnings.fetch_add(1, std::memory_order_relaxed);
+			const WarningFn fn = g_warningFn.load(std::memory_order_acquire);
+			if (fn)
+			{
+				fn(message);
+			}
+			else
+			{
+				fprintf(stderr, "%s\n", message);
+			}
+		}
+
+		void add(Counter& counter, const char* pWhat, MemoryDomain domain, u64 bytes)
+		{
+			const u64 current = counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			counter.allocations.fetch_add(1, std::memory_order_relaxed);
+			counter.live.fetch_add(1, std::memory_order_relaxed);
+
+			u64 peak = counter.peak.load(std::memory_order_relaxed);
+			while (current > peak && !counter.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+			{
+			}
+
+			const u64 budget = counter.budget.load(std::memory_order_relaxed);
+			if (budget && current > budget && !counter.over.exchange(true, std::memory_order_relaxed))
+			{
+				warn(pWhat, domain, current, budget);
+			}
+		}
+
+		void subtract(Counter& counter, u64 bytes)
+		{
+			const u64 current = counter.current.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+			counter.live.fetch_sub(1, std::memory_order_relaxed);
+
+			const u64 budget = counter.budget.load(std::memory_order_relaxed);
+			if (!budget || current <= budget)
+			{
+				counter.over.store(false, std::memory_order_relaxed);
+			}
+		}
+
+		MemoryStats to_stats(const Counter& counter)
+		{
+			MemoryStats stats;
+			stats.currentBytes = counter.current.load(std::memory_order_relaxed);
+			stats.peakBytes = counter.peak.load(std::memory_order_relaxed);
+			stats.budgetBytes = counter.budget.load(std::memory_order_relaxed);
+			stats.allocations = counter.allocations.load(std::memory_order_relaxed);
+			stats.liveAllocations = counter.live.load(std::memory_order_relaxed);
+			stats.overBudget = stats.budgetBytes && stats.currentBytes > stats.budgetBytes;
+			return stats;
+		}
+	}
+
+	const char* tag_name(MemoryTag tag)
+	{
+		return (u32)tag < kTags ? kTagNames[(u32)tag] : "Unknown";
+	}
+
+	const char* domain_name(MemoryDomain domain)
+	{
+		return (u32)domain < kDomains ? kDomainNames[(u32)domain] : "Unknown";
+	}
+
+	void on_allocate(MemoryTag tag, MemoryDomain domain, u64 bytes)
+	{
+		ASSERT((u32)tag < kTags && (u32)domain < kDomains);
+		add(g_counters[(u32)domain][(u32)tag], tag_name(tag), domain, bytes);
+		add(g_counters[(u32)domain][kTotal], "Total", domain, bytes);
+	}
+
+	void on_free(MemoryTag tag, MemoryDomain domain, u64 bytes)
+	{
+		ASSERT((u32)tag < kTags && (u32)domain < kDomains);
+		subtract(g_counters[(u32)domain][(u32)tag], bytes);
+		subtract(g_counters[(u32)domain][kTotal], bytes);
+	}
+
+	void* allocate(MemoryTag tag, size_t bytes, size_t alignment)
+	{
+		ASSERT(alignment && !(alignment & (alignment - 1)));
+		alignment = alignment < alignof(BlockHeader) ? alignof(BlockHeader) : alignment;
+
+		void* pBase = malloc(bytes + sizeof(BlockHeader) + alignment - 1);
+		if (!pBase)
+			return nullptr;
+		g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		const uintptr_t user = ((uintptr_t)pBase + sizeof(BlockHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		BlockHeader* pHeader = (BlockHeader*)user - 1;
+		pHeader->pBase = pBase;
+		pHeader->bytes = bytes;
+		pHeader->tag = (u32)tag;
+		pHeader->magic = kBlockMagic;
+
+		on_allocate(tag, MemoryDomain::kCPU, bytes);
+		return (void*)user;
+	}
+
+	void deallocate(void* p)
+	{
+		if (!p)
+			return;
+
+		BlockHeader* pHeader = (BlockHeader*)p - 1;
+		ASSERT(pHeader->magic == kBlockMagic);	// not from allocate(), or freed twice
+		pHeader->magic = 0;
+
+		on_free((MemoryTag)pHeader->tag, MemoryDomain::kCPU, pHeader->bytes);
+		free(pHeader->pBase);
+	}
+
+	void set_budget(MemoryTag tag, MemoryDomain domain, u64 bytes)
+	{
+		Counter& counter = g_counters[(u32)domain][(u32)tag];
+		counter.budget.store(bytes, std::memory_order_relaxed);
+		counter.over.store(bytes && counter.current.load(std::memory_order_relaxed) > bytes, std::memory_order_relaxed);
+	}
+
+	void set_budget(MemoryDomain domain, u64 bytes)
+	{
+		Counter& counter = g_counters[(u32)domain][kTotal];
+		counter.budget.store(bytes, std::memory_order_relaxed);
+		counter.over.store(bytes && counter.current.load(std::memory_order_relaxed) > bytes, std::memory_order_relaxed);
+	}
+
+	MemoryStats stats(MemoryTag tag, MemoryDomain domain)
+	{
+		return to_stats(g_counters[(u32)domain][(u32)tag]);
+	}
+
+	MemoryStats stats(MemoryDomain domain)
+	{
+		return to_stats(g_counters[(u32)domain][kTotal]);
+	}
+
+	u32 budget_warnings()
+	{
+		return g_warnings.load(std::memory_order_relaxed);
+	}
+
+	void set_warning_handler(WarningFn fn)
+	{
+		g_warningFn.store(fn, std::memory_order_release);
+	}
+
+	void reset_peaks()
+	{
+		for (u32 domain = 0; domain < kDomains; ++domain)
+		{
+			for (u32 slot = 0; slot <= kTags; ++slot)
+			{
+				Counter& counter = g_counters[domain][slot];
+				counter.peak.store(counter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+	}
+
+	u64 heap_allocations()
+	{
+		return g_heapAllocations.load(std::memory_order_relaxed);
+	}
+}
+
+#if MEMORY_COUNT_HEAP
+//================================================================================
+// Global operator new / delete, counted. Everything else about them is the
+// default: malloc / free, std::bad_alloc when the heap is out.
+//================================================================================
+void* operator new(size_t bytes)
+{
+	MemoryTracker::g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	void* p = malloc(bytes ? bytes : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t bytes)
+{
+	return operator new(bytes);
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept
+{
+	MemoryTracker::g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return malloc(bytes ? bytes : 1);
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t& nothrow) noexcept
+{
+	return operator new(bytes, nothrow);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+#endif
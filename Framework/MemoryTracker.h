@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <new>
+#include <vector>
+
+//================================================================================
+// MemoryTracker
+// Bytes held per subsystem, in RAM and (estimated) video memory, against
+// budgets, so a fixed budget on a constrained target is something you can
+// watch rather than something you find out about.
+//
+// Each tag counts its current and peak bytes, its live allocations, and every
+// allocation since the start. Counting comes from two places:
+//  - allocate() / deallocate() and TrackedAllocator (for STL containers). Each
+//    block keeps its tag and size in a small header, so freeing it needs
+//    neither.
+//  - on_allocate() / on_free(), for memory something else owns: D3D resources
+//    (MemoryTrackerD3D11.h estimates their bytes from the desc) and containers
+//    whose type is part of an interface.
+//
+// An allocation that takes a tag, or a whole domain, over its budget calls the
+// warning handler once. It can warn again after the tag drops back under.
+//
+// heap_allocations() counts every trip to the general heap, tagged or not: with
+// MEMORY_COUNT_HEAP (1 by default) this file replaces the global operator new /
+// delete to count them. Sample it once a frame, after warm-up the difference
+// should be 0.
+//
+// Counters are atomics, workers allocate too. Only standard headers so it
+// builds with the CPU tools.
+//================================================================================
+#ifndef MEMORY_COUNT_HEAP
+#define MEMORY_COUNT_HEAP 1
+#endif
+
+enum class MemoryTag : u32
+{
+	kMesh,			// vertex / index data, CPU copies and loader scratch
+	kTexture,		// loaded and generated textures
+	kRenderTarget,	// render graph targets, the depth buffer
+	kTransient,		// per frame uploads, instance data, read backs, loaded files
+	kUI,			// ImGui and debug draw
+	kCount
+};
+
+enum class MemoryDomain : u32
+{
+	kCPU,
+	kGPU,
+	kCount
+};
+
+struct MemoryStats
+{
+	u64 currentBytes = 0;
+	u64 peakBytes = 0;
+	u64 budgetBytes = 0;		// 0, no budget
+	u64 allocations = 0;		// since the start
+	u32 liveAllocations = 0;
+	bool overBudget = false;
+};
+
+namespace MemoryTracker
+{
+	using WarningFn = void(*)(const char* pMessage);
+
+	const char* tag_name(MemoryTag tag);
+	const char* domain_name(MemoryDomain domain);
+
+	// Counts memory allocated / freed elsewhere.
+	void on_allocate(MemoryTag tag, MemoryDomain domain, u64 bytes);
+	void on_free(MemoryTag tag, MemoryDomain domain, u64 bytes);
+
+	// Counted heap block, alignment is a power of two. Null when the heap is out.
+	void* allocate(MemoryTag tag, size_t bytes, size_t alignment = 16);
+	void deallocate(void* p);
+
+	// 0 removes the budget. The domain overloads are the budget of every tag together.
+	void set_budget(MemoryTag tag, MemoryDomain domain, u64 bytes);
+	void set_budget(MemoryDomain domain, u64 bytes);
+
+	MemoryStats stats(MemoryTag tag, MemoryDomain domain);
+	MemoryStats stats(MemoryDomain domain);
+
+	// Times a budget was exceeded since the start.
+	u32 budget_warnings();
+
+	// Called with each warning, stderr by default. Null restores the default.
+	void set_warning_handler(WarningFn fn);
+
+	// Peaks back to the current bytes, e.g. after loading.
+	void reset_peaks();
+
+	// Global operator new calls and allocate() blocks since the start.
+	u64 heap_allocations();
+}
+
+//================================================================================
+// STL allocator counting against a tag:
+//   TrackedVector<MeshVertex, MemoryTag::kMesh> vertices;
+//================================================================================
+template <typename T, MemoryTag Tag>
+class TrackedAllocator
+{
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind { using other = TrackedAllocator<U, Tag>; };
+
+	TrackedAllocator() = default;
+	template <typename U>
+	TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+
+	T* allocate(size_t count)
+	{
+		void* p = MemoryTracker::allocate(Tag, count * sizeof(T), alignof(T) > 16 ? alignof(T) : 16);
+		if (!p)
+			throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+
+	void deallocate(T* p, size_t)
+	{
+		MemoryTracker::deallocate(p);
+	}
+
+	template <typename U>
+	bool operator==(const TrackedAllocator<U, Tag>&) const { return true; }
+	template <typename U>
+	bool operator!=(const TrackedAllocator<U, Tag>&) const { return false; }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
@@ -0,0 +1,223 @@
+#include "MemoryTrackerD3D11.h"
+
+namespace
+{
+	bool is_block_compressed(DXGI_FORMAT format)
+	{
+		return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM)
+			|| (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+	}
+
+	u32 full_mip_chain(u32 width, u32 height, u32 depth)
+	{
+		u32 size = std::max(width, std::max(height, depth));
+		u32 levels = 1;
+		while (size > 1)
+		{
+			size >>= 1;
+			++levels;
+		}
+		return levels;
+	}
+}
+
+u32 dxgi_bits_per_texel(DXGI_FORMAT format)
+{
+	switch (format)
+	{
+	case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+	case DXGI_FORMAT_R32G32B32A32_UINT:
+	case DXGI_FORMAT_R32G32B32A32_SINT:
+		return 128;
+
+	case DXGI_FORMAT_R32G32B32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32_FLOAT:
+	case DXGI_FORMAT_R32G32B32_UINT:
+	case DXGI_FORMAT_R32G32B32_SINT:
+		return 96;
+
+	case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+	case DXGI_FORMAT_R16G16B16A16_UNORM:
+	case DXGI_FORMAT_R16G16B16A16_UINT:
+	case DXGI_FORMAT_R16G16B16A16_SNORM:
+	case DXGI_FORMAT_R16G16B16A16_SINT:
+	case DXGI_FORMAT_R32G32_TYPELESS:
+	case DXGI_FORMAT_R32G32_FLOAT:
+	case DXGI_FORMAT_R32G32_UINT:
+	case DXGI_FORMAT_R32G32_SINT:
+	case DXGI_FORMAT_R32G8X24_TYPELESS:
+	case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+	case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
+	case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
+		return 64;
+
+	case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+	case DXGI_FORMAT_R10G10B10A2_UNORM:
+	case DXGI_FORMAT_R10G10B10A2_UINT:
+	case DXGI_FORMAT_R11G11B10_FLOAT:
+	case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+	case DXGI_FORMAT_R8G8B8A8_UINT:
+	case DXGI_FORMAT_R8G8B8A8_SNORM:
+	case DXGI_FORMAT_R8G8B8A8_SINT:
+	case DXGI_FORMAT_R16G16_TYPELESS:
+	case DXGI_FORMAT_R16G16_FLOAT:
+	case DXGI_FORMAT_R16G16_UNORM:
+	case DXGI_FORMAT_R16G16_UINT:
+	case DXGI_FORMAT_R16G16_SNORM:
+	case DXGI_FORMAT_R16G16_SINT:
+	case DXGI_FORMAT_R32_TYPELESS:
+	case DXGI_FORMAT_D32_FLOAT:
+	case DXGI_FORMAT_R32_FLOAT:
+	case DXGI_FORMAT_R32_UINT:
+	case DXGI_FORMAT_R32_SINT:
+	case DXGI_FORMAT_R24G8_TYPELESS:
+	case DXGI_FORMAT_D24_UNORM_S8_UINT:
+	case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
+	case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
+	case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+	case DXGI_FORMAT_B8G8R8A8_UNORM:
+	case DXGI_FORMAT_B8G8R8X8_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+	case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+	case DXGI_FORMAT_B8G8R8X8_TYPELESS:
+	case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+		return 32;
+
+	case DXGI_FORMAT_R8G8_TYPELESS:
+	case DXGI_FORMAT_R8G8_UNORM:
+	case DXGI_FORMAT_R8G8_UINT:
+	case DXGI_FORMAT_R8G8_SNORM:
+	case DXGI_FORMAT_R8G8_SINT:
+	case DXGI_FORMAT_R16_TYPELESS:
+	case DXGI_FORMAT_R16_FLOAT:
+	case DXGI_FORMAT_D16_UNORM:
+	case DXGI_FORMAT_R16_UNORM:
+	case DXGI_FORMAT_R16_UINT:
+	case DXGI_FORMAT_R16_SNORM:
+	case DXGI_FORMAT_R16_SINT:
+	case DXGI_FORMAT_B5G6R5_UNORM:
+	case DXGI_FORMAT_B5G5R5A1_UNORM:
+		return 16;
+
+	case DXGI_FORMAT_R8_TYPELESS:
+	case DXGI_FORMAT_R8_UNORM:
+	case DXGI_FORMAT_R8_UINT:
+	case DXGI_FORMAT_R8_SNORM:
+	case DXGI_FORMAT_R8_SINT:
+	case DXGI_FORMAT_A8_UNORM:
+	case DXGI_FORMAT_BC2_TYPELESS:
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC2_UNORM_SRGB:
+	case DXGI_FORMAT_BC3_TYPELESS:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_TYPELESS:
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC5_SNORM:
+	case DXGI_FORMAT_BC6H_TYPELESS:
+	case DXGI_FORMAT_BC6H_UF16:
+	case DXGI_FORMAT_BC6H_SF16:
+	case DXGI_FORMAT_BC7_TYPELESS:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return 8;
+
+	case DXGI_FORMAT_BC1_TYPELESS:
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_TYPELESS:
+	case DXGI_FORMAT_BC4_UNORM:
+	case DXGI_FORMAT_BC4_SNORM:
+		return 4;
+
+	case DXGI_FORMAT_R1_UNORM:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+u64 gpu_texture_bytes_d3d11(DXGI_FORMAT format, u32 width, u32 height, u32 depth, u32 mipLevels, u32 arraySize, u32 samples)
+{
+	const u32 bits = dxgi_bits_per_texel(format);
+	const bool blocks = is_block_compressed(format);
+	if (!mipLevels)
+	{
+		mipLevels = full_mip_chain(width, height, depth);
+	}
+
+	u64 bytes = 0;
+	for (u32 mip = 0; mip < mipLevels; ++mip)
+	{
+		u64 w = std::max(1u, width >> mip);
+		u64 h = std::max(1u, height >> mip);
+		const u64 d = std::max(1u, depth >> mip);
+		if (blocks)
+		{
+			// Whole 4x4 blocks, a 1x1 mip still takes one.
+			w = (w + 3) & ~3ull;
+			h = (h + 3) & ~3ull;
+		}
+		bytes += (w * h * d * bits + 7) / 8;
+	}
+	return bytes * std::max(1u, arraySize) * std::max(1u, samples);
+}
+
+u64 gpu_resource_bytes_d3d11(ID3D11Resource* pResource)
+{
+	if (!pResource)
+		return 0;
+
+	D3D11_RESOURCE_DIMENSION dimension;
+	pResource->GetType(&dimension);
+	switch (dimension)
+	{
+	case D3D11_RESOURCE_DIMENSION_BUFFER:
+	{
+		D3D11_BUFFER_DESC desc;
+		static_cast<ID3D11Buffer*>(pResource)->GetDesc(&desc);
+		return desc.ByteWidth;
+	}
+	case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
+	{
+		D3D11_TEXTURE1D_DESC desc;
+		static_cast<ID3D11Texture1D*>(pResource)->GetDesc(&desc);
+		return gpu_texture_bytes_d3d11(desc.Format, desc.Width, 1, 1, desc.MipLevels, desc.ArraySize, 1);
+	}
+	case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		static_cast<ID3D11Texture2D*>(pResource)->GetDesc(&desc);
+		return gpu_texture_bytes_d3d11(desc.Format, desc.Width, desc.Height, 1, desc.MipLevels, desc.ArraySize, desc.SampleDesc.Count);
+	}
+	case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
+	{
+		D3D11_TEXTURE3D_DESC desc;
+		static_cast<ID3D11Texture3D*>(pResource)->GetDesc(&desc);
+		return gpu_texture_bytes_d3d11(desc.Format, desc.Width, desc.Height, desc.Depth, desc.MipLevels, 1, 1);
+	}
+	default:
+		return 0;
+	}
+}
+
+void track_gpu_resource_d3d11(MemoryTag tag, ID3D11Resource* pResource)
+{
+	if (pResource)
+	{
+		MemoryTracker::on_allocate(tag, MemoryDomain::kGPU, gpu_resource_bytes_d3d11(pResource));
+	}
+}
+
+void untrack_gpu_resource_d3d11(MemoryTag tag, ID3D11Resource* pResource)
+{
+	if (pResource)
+	{
+		MemoryTracker::on_free(tag, MemoryDomain::kGPU, gpu_resource_bytes_d3d11(pResource));
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CommonHeader.h"
+#include "MemoryTracker.h"
+
+//================================================================================
+// Video memory estimates of D3D11 resources, for MemoryTracker's GPU domain.
+// Bytes come from the desc: every mip, array slice and sample, block
+// compressed formats by 4x4 block. Drivers pad and align on top, so this is
+// the floor of what the resource costs.
+//
+// Track a resource right after creating it and untrack it right before the
+// release that destroys it, with the same tag.
+//================================================================================
+
+// Bits per texel, block compressed formats per texel on average (BC1 4, BC3 8). 0 when unknown.
+u32 dxgi_bits_per_texel(DXGI_FORMAT format);
+
+// mipLevels 0 is the whole chain.
+u64 gpu_texture_bytes_d3d11(DXGI_FORMAT format, u32 width, u32 height, u32 depth, u32 mipLevels, u32 arraySize, u32 samples);
+
+// Buffers, 1D / 2D / 3D textures. 0 for null.
+u64 gpu_resource_bytes_d3d11(ID3D11Resource* pResource);
+
+void track_gpu_resource_d3d11(MemoryTag tag, ID3D11Resource* pResource);
+void untrack_gpu_resource_d3d11(MemoryTag tag, ID3D11Resource* pResource);
@@ -1,9 +1,19 @@
 
 #include "Mesh.h"
+#include "Trace.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tinyobjloader/tiny_obj_loader.h"
 
+namespace
+{
+	// The CPU copies are counted as one allocation, from init_buffers() to release().
+	u64 cpu_copy_bytes(const Mesh& mesh)
+	{
+		return mesh.cpu_vertices().capacity() * sizeof(MeshVertex) + mesh.cpu_indices().capacity() * sizeof(u16);
+	}
+}
+
 Mesh::Mesh()
 	: m_pVertexBuffer(nullptr)
 	, m_pIndexBuffer(nullptr)
@@ -13,8 +23,28 @@ Mesh::Mesh()
 
 Mesh::~Mesh()
 {
+	release();
+}
+
+void Mesh::release()
+{
+	if (m_pVertexBuffer)
+	{
+		MemoryTracker::on_free(MemoryTag::kMesh, MemoryDomain::kCPU, cpu_copy_bytes(*this));
+	}
+	untrack_gpu_resource_d3d11(MemoryTag::kMesh, m_pVertexBuffer);
+	untrack_gpu_resource_d3d11(MemoryTag::kMesh, m_pIndexBuffer);
+
 	SAFE_RELEASE(m_pVertexBuffer);
 	SAFE_RELEASE(m_pIndexBuffer);
+	m_pVertexBuffer = nullptr;
+	m_pIndexBuffer = nullptr;
+	m_vertices = 0;
+	m_indices = 0;
+
+	// Swapped out rather than cleared so the memory goes back.
+	std::vector<MeshVertex>().swap(m_cpuVertices);
+	std::vector<u16>().swap(m_cpuIndices);
 }
 
 void Mesh::init_buffers(ID3D11Device* pDevice, const MeshVertex* pVertices, const u32 kNumVerts, const u16* pIndices, const u32 kNumIndices)
@@ -34,6 +64,7 @@ void Mesh::init_buffers(ID3D11Device* pDevice, const MeshVertex* pVertices, cons
 
 		HRESULT hr = pDevice->CreateBuffer(&desc, &data, &m_pVertexBuffer);
 		ASSERT(!FAILED(hr));
+		track_gpu_resource_d3d11(MemoryTag::kMesh, m_pVertexBuffer);
 	}
 
 	// Create an index buffer
@@ -50,10 +81,17 @@ void Mesh::init_buffers(ID3D11Device* pDevice, const MeshVertex* pVertices, cons
 
 		HRESULT hr = pDevice->CreateBuffer(&desc, &data, &m_pIndexBuffer);
 		ASSERT(!FAILED(hr));
+		track_gpu_resource_d3d11(MemoryTag::kMesh, m_pIndexBuffer);
 	}
 
 	m_vertices = kNumVerts;
 	m_indices = kNumIndices;
+
+	m_bounds = Bounds::FromPoints(&pVertices[0].pos.x, kNumVerts, sizeof(MeshVertex));
+
+	m_cpuVertices.assign(pVertices, pVertices + kNumVerts);
+	m_cpuIndices.assign(pIndices, pIndices + (pIndices ? kNumIndices : 0));
+	MemoryTracker::on_allocate(MemoryTag::kMesh, MemoryDomain::kCPU, cpu_copy_bytes(*this));
 }
 
 void Mesh::bind(ID3D11DeviceContext* pContext) const
@@ -83,6 +121,18 @@ void Mesh::draw(ID3D11DeviceContext* pContext) const
 	}
 }
 
+void Mesh::draw_instanced(ID3D11DeviceContext* pContext, const u32 kInstances) const
+{
+	if (m_pIndexBuffer)
+	{
+		pContext->DrawIndexedInstanced(m_indices, kInstances, 0, 0, 0);
+	}
+	else
+	{
+		pContext->DrawInstanced(m_vertices, kInstances, 0, 0);
+	}
+}
+
 // Computes tangents using Lengyel's method for an indexed triangle list.
 // Tangents are computed as a 4d vector where w stores the sign need to reconstruct a bitangent in the shader.
 void compute_tangents_lengyel(MeshVertex* pVertices, u32 kVertices, const u16* pIndices, u32 kIndices)
@@ -91,13 +141,12 @@ void compute_tangents_lengyel(MeshVertex* pVertices, u32 kVertices, const u16* p
 
 	const u32 kTris = kIndices / 3;
 
-	// Tangents are accumulated so we need some space to work in.
-	v3* buffer = new v3[kVertices * 2];
-	memset(buffer, 0, sizeof(v3) * kVertices * 2);
+	// Tangents are accumulated so we need some space to work in (zeroed by v3's constructor).
+	TrackedVector<v3, MemoryTag::kMesh> buffer(kVertices * 2);
 
 	// offsets into the buffer;
-	v3* tan1 = buffer;
-	v3* tan2 = buffer + kVertices;
+	v3* tan1 = buffer.data();
+	v3* tan2 = buffer.data() + kVertices;
 
 	// Step through each triangle.
 	for (u32 iTri = 0; iTri < kTris; ++iTri)
@@ -156,9 +205,6 @@ void compute_tangents_lengyel(MeshVertex* pVertices, u32 kVertices, const u16* p
 		XMStoreFloat4(&pVertices[i].tangent, tangent);
 		pVertices[i].tangent.w = XMVectorGetX(bitangent) < 0.f ? -1.0f : 1.0f; // sign
 	}
-
-	// cleanup the temp buffer
-	delete[] buffer;
 }
 
 void create_mesh_cube(ID3D11Device* pDevice, Mesh& rMeshOut, const f32 kHalfSize)
@@ -297,11 +343,13 @@ void create_mesh_quad_xy(ID3D11Device* pDevice, Mesh& rMeshOut, const f32 kHalfS
 
 void create_mesh_from_obj(ID3D11Device* pDevice, Mesh& rMeshOut, const char* pFilename, const f32 kScale)
 {
+	TRACE_SCOPE_CAT("load", "Load OBJ");
+
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
 	std::vector<tinyobj::material_t> materials;
 
-	std::vector<MeshVertex> meshVertices;
+	TrackedVector<MeshVertex, MemoryTag::kMesh> meshVertices;
 
 	std::string err;
 	bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &err, pFilename);
@@ -317,7 +365,9 @@ void create_mesh_from_obj(ID3D11Device* pDevice, Mesh& rMeshOut, const char* pFi
 	// Loop over shapes
 	for (size_t s = 0; s < shapes.size(); s++) {
 
+		// One vertex per face corner, sized up front rather than grown.
 		meshVertices.clear();
+		meshVertices.reserve(shapes[s].mesh.indices.size());
 
 		// Loop over faces(polygon)
 		size_t index_offset = 0;
@@ -375,7 +425,7 @@ void create_mesh_from_obj(ID3D11Device* pDevice, Mesh& rMeshOut, const char* pFi
 		}
 
 		// Make a sequential index buffer so we can use the tangent calculation function
-		std::vector<u16> m_indices(meshVertices.size());
+		TrackedVector<u16, MemoryTag::kMesh> m_indices(meshVertices.size());
 		for (u32 i = 0; i < meshVertices.size(); ++i)
 		{
 			m_indices[i] = i;
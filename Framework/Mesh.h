@@ -2,6 +2,11 @@
 
 #include "CommonHeader.h"
 #include "VertexFormats.h"
+#include "ShaderSet.h"
+#include "Culling.h"
+#include "MemoryTrackerD3D11.h"
+
+#include <vector>
 
 
 using MeshVertex = Vertex_Pos3fColour4ubNormal3fTangent3fTex2f; // vertex type
@@ -18,9 +23,15 @@ public:
 	~Mesh();
 
 	void init_buffers(ID3D11Device* pDevice, const MeshVertex* pVertices, const u32 kNumVerts, const u16* pIndices, const u32 kNumIndices);
+
+	// Releases the buffers and CPU copies, init_buffers() can be called again (the buffers are immutable).
+	void release();
 	void bind(ID3D11DeviceContext* pContext) const;
 	void draw(ID3D11DeviceContext* pContext) const;
 
+	// Draws the mesh kInstances times, the shader fetches per instance data with SV_InstanceID (see InstanceBuffer).
+	void draw_instanced(ID3D11DeviceContext* pContext, const u32 kInstances) const;
+
 	// Accessors.
 	const ID3D11Buffer* vertex_buffer() const { return m_pVertexBuffer; }
 	const ID3D11Buffer* index_buffer() const { return m_pIndexBuffer; }
@@ -37,11 +48,90 @@ public:
 	void set_vertices(u32 v) { m_vertices = v; }
 	void set_indices(u32 i) { m_indices = i; }
 
+	// Local space bounds of the vertices, computed in init_buffers().
+	const Bounds& bounds() const { return m_bounds; }
+	void set_bounds(const Bounds& b) { m_bounds = b; }
+
+	// CPU copies of what init_buffers() uploaded, for the software rasterizer.
+	const std::vector<MeshVertex>& cpu_vertices() const { return m_cpuVertices; }
+	const std::vector<u16>& cpu_indices() const { return m_cpuIndices; }
+
 private:
 	ID3D11Buffer* m_pVertexBuffer;
 	ID3D11Buffer* m_pIndexBuffer;
 	u32 m_vertices;
 	u32 m_indices;
+	Bounds m_bounds;
+	std::vector<MeshVertex> m_cpuVertices;
+	std::vector<u16> m_cpuIndices;
+};
+
+//================================================================================
+// InstanceBuffer
+// Per instance data for Mesh::draw_instanced() in a dynamic structured buffer.
+// SV_InstanceID always starts at 0 in D3D11, so when several batches share the
+// buffer the shader adds the batch's first instance from a constant.
+// Grows to the largest count pushed, never shrinks.
+//================================================================================
+template<typename InstanceType>
+class InstanceBuffer
+{
+public:
+	InstanceBuffer() {}
+	~InstanceBuffer() { release(); }
+
+	InstanceBuffer(const InstanceBuffer&) = delete;
+	InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+	void push(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, const InstanceType* pInstances, const u32 kCount)
+	{
+		if (!kCount)
+			return;
+
+		if (kCount > m_capacity)
+		{
+			release();
+
+			m_capacity = 64;
+			while (m_capacity < kCount)
+				m_capacity *= 2;
+
+			m_pBuffer = create_structured_buffer<InstanceType>(pDevice, m_capacity);
+			m_pView = create_structured_buffer_view(pDevice, m_pBuffer);
+			track_gpu_resource_d3d11(MemoryTag::kTransient, m_pBuffer);
+		}
+
+		D3D11_MAPPED_SUBRESOURCE subresource;
+		if (!FAILED(pContext->Map(m_pBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &subresource)))
+		{
+			memcpy(subresource.pData, pInstances, sizeof(InstanceType) * kCount);
+			pContext->Unmap(m_pBuffer, 0);
+		}
+	}
+
+	// Binds to the vertex and pixel shader.
+	void bind(ID3D11DeviceContext* pContext, const u32 kSlot) const
+	{
+		pContext->VSSetShaderResources(kSlot, 1, &m_pView);
+		pContext->PSSetShaderResources(kSlot, 1, &m_pView);
+	}
+
+	void release()
+	{
+		untrack_gpu_resource_d3d11(MemoryTag::kTransient, m_pBuffer);
+		SAFE_RELEASE(m_pView);
+		SAFE_RELEASE(m_pBuffer);
+		m_pView = nullptr;
+		m_pBuffer = nullptr;
+		m_capacity = 0;
+	}
+
+	u32 capacity() const { return m_capacity; }
+
+private:
+	ID3D11Buffer* m_pBuffer = nullptr;
+	ID3D11ShaderResourceView* m_pView = nullptr;
+	u32 m_capacity = 0;
 };
 
 //================================================================================
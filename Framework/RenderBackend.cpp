@@ -0,0 +1,115 @@
+#include "RenderBackend.h"
+
+//================================================================================
+// RenderBackendGraph
+//================================================================================
+
+RenderBackendGraph::~RenderBackendGraph()
+{
+	release();
+}
+
+void RenderBackendGraph::release()
+{
+	for (const std::unique_ptr<RBTexture>& pTexture : m_transients)
+	{
+		if (pTexture->valid())
+		{
+			m_backend.destroy_texture(*pTexture);
+		}
+	}
+	m_transients.clear();
+	m_imports.clear();
+	m_importCount = 0;
+}
+
+void* RenderBackendGraph::import(RBTexture texture)
+{
+	if (m_importCount == m_imports.size())
+	{
+		m_imports.emplace_back(new RBTexture());
+	}
+	RBTexture* pTexture = m_imports[m_importCount++].get();
+	*pTexture = texture;
+	return pTexture;
+}
+
+void* RenderBackendGraph::acquire_transient(u32 index, const RGTextureDesc& desc)
+{
+	while (m_transients.size() <= index)
+	{
+		m_transients.emplace_back(new RBTexture());
+	}
+
+	RBTexture& texture = *m_transients[index];
+	const RTPoolKey key = RTPoolKey::From(desc);
+	if (texture.valid() && m_backend.texture_key(texture) != key)
+	{
+		m_backend.destroy_texture(texture);
+		texture = RBTexture();
+	}
+	if (!texture.valid())
+	{
+		texture = m_backend.create_texture(key);
+	}
+	return &texture;
+}
+
+void RenderBackendGraph::begin_pass(const RGPassInfo& pass)
+{
+	// Every pass binds its own reads, nothing read last pass can still be bound when it becomes a target.
+	m_backend.unbind_resources();
+
+	RBTexture colour[RenderBackend::kMaxColourTargets];
+	ASSERT(pass.colourTargets.size() <= RenderBackend::kMaxColourTargets);
+	for (u32 i = 0; i < pass.colourTargets.size(); ++i)
+	{
+		const RGBinding& binding = pass.colourTargets[i];
+		if (!binding.pResource)
+			continue;
+
+		colour[i] = *static_cast<const RBTexture*>(binding.pResource);
+		if (binding.load == RGLoadOp::kClear)
+		{
+			m_backend.clear_target(colour[i], binding.pDesc->clearValue);
+		}
+	}
+
+	RBTexture depth;
+	if (pass.depthTarget.pResource)
+	{
+		depth = *static_cast<const RBTexture*>(pass.depthTarget.pResource);
+		if (pass.depthTarget.load == RGLoadOp::kClear)
+		{
+			m_backend.clear_target(depth, pass.depthTarget.pDesc->clearValue);
+		}
+	}
+
+	if (!pass.colourTargets.empty() || depth.valid())
+	{
+		m_backend.set_targets(colour, (u32)pass.colourTargets.size(), depth);
+	}
+	else if (!pass.unorderedAccess.empty())
+	{
+		// Whatever the last pass rendered to may be this one's input.
+		m_backend.set_targets(nullptr, 0, RBTexture());
+	}
+
+	for (const RGBinding& binding : pass.shaderResources)
+	{
+		m_backend.bind_texture(binding.slot, *static_cast<const RBTexture*>(binding.pResource));
+	}
+	for (const RGBinding& binding : pass.unorderedAccess)
+	{
+		m_backend.bind_uav(binding.slot, *static_cast<const RBTexture*>(binding.pResource));
+	}
+}
+
+void RenderBackendGraph::end_pass(const RGPassInfo& pass)
+{
+	// A UAV left bound would stop the next pass reading the texture.
+	if (!pass.unorderedAccess.empty())
+	{
+		m_backend.unbind_resources();
+	}
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+
+#include <memory>
+#include <vector>
+
+//================================================================================
+// RenderBackend
+// The calls a frame is made of (buffers, textures, targets, pipeline and
+// resource binds, draw / dispatch) behind handles, so frame code doesn't see
+// the API it runs on. RenderBackendD3D11 forwards to a device and context,
+// RenderBackendCPU keeps everything in memory and runs a C++ function per
+// pipeline, which needs no window or GPU.
+//
+// Pipelines are made by each backend from its own kind of program (a ShaderSet,
+// a CPU function) under a name, frame code finds them by that name. Textures
+// are described by an RTPoolKey and hold rg_bytes_per_texel() texels, row major.
+//
+// RenderBackendGraph runs a RenderGraph on any backend, passes get RBTextures
+// through rg_texture().
+//
+// Only standard headers.
+//================================================================================
+
+// Index into a backend's table of Tag things, ~0u when there is none.
+template<typename Tag>
+struct RBHandle
+{
+	u32 index = ~0u;
+
+	bool valid() const { return index != ~0u; }
+	bool operator==(const RBHandle& o) const { return index == o.index; }
+	bool operator!=(const RBHandle& o) const { return index != o.index; }
+};
+
+using RBBuffer = RBHandle<struct RBBufferTag>;
+using RBTexture = RBHandle<struct RBTextureTag>;
+using RBPipeline = RBHandle<struct RBPipelineTag>;
+
+enum class RBBufferType : u8
+{
+	kVertex,
+	kIndex,			// u16 indices, what Mesh uses.
+	kConstant,
+	kStructured,	// read through bind_buffer(), stride is the element size.
+};
+
+struct RBBufferDesc
+{
+	RBBufferType type = RBBufferType::kVertex;
+	u32 size = 0;
+	u32 stride = 0;			// vertex or structure size.
+	bool dynamic = false;	// rewritten with update_buffer().
+
+	static RBBufferDesc Create(RBBufferType type, u32 size, u32 stride = 0, bool dynamic = false)
+	{
+		RBBufferDesc desc;
+		desc.type = type;
+		desc.size = size;
+		desc.stride = stride;
+		desc.dynamic = dynamic;
+		return desc;
+	}
+};
+
+enum class RBPipelineType : u8
+{
+	kGraphics,
+	kCompute,
+};
+
+// Accumulated since reset_stats().
+struct RBStats
+{
+	u32 draws = 0;
+	u32 dispatches = 0;
+	u32 pipelineBinds = 0;
+	u32 resourceBinds = 0;		// buffers, textures and UAVs.
+	u32 clears = 0;
+	u64 uploadedBytes = 0;		// create / update data.
+	u64 readBackBytes = 0;
+};
+
+class RenderBackend
+{
+public:
+	static constexpr u32 kMaxColourTargets = 8;
+	static constexpr u32 kMaxConstantSlots = 14;
+	static constexpr u32 kMaxTextureSlots = 16;	// textures and structured buffers share the slots.
+	static constexpr u32 kMaxUAVSlots = 8;
+
+	virtual ~RenderBackend() {}
+
+	virtual const char* name() const = 0;
+
+	//-- Resources
+	virtual RBBuffer create_buffer(const RBBufferDesc& desc, const void* pData = nullptr) = 0;
+	virtual void update_buffer(RBBuffer buffer, const void* pData, u32 size) = 0;
+	virtual void destroy_buffer(RBBuffer buffer) = 0;
+
+	// pTexels (optional) is tightly packed.
+	virtual RBTexture create_texture(const RTPoolKey& key, const void* pTexels = nullptr) = 0;
+	virtual void destroy_texture(RBTexture texture) = 0;
+	virtual const RTPoolKey& texture_key(RBTexture texture) const = 0;
+
+	// Copies the texels out tightly packed. Waits for the GPU, only for validation / tools.
+	virtual void read_texture(RBTexture texture, void* pTexelsOut) = 0;
+
+	// Pipeline the backend registered under pName, invalid when there is none.
+	virtual RBPipeline find_pipeline(const char* pName) const = 0;
+
+	//-- Commands
+	// The viewport covers the first target (or the depth target).
+	virtual void set_targets(const RBTexture* pColour, u32 colourCount, RBTexture depth) = 0;
+
+	// Colour targets to value, depth stencil ones to depth value[0] and stencil value[1].
+	virtual void clear_target(RBTexture target, const f32 value[4]) = 0;
+
+	virtual void bind_pipeline(RBPipeline pipeline) = 0;
+	virtual void bind_vertex_buffer(RBBuffer buffer) = 0;
+	virtual void bind_index_buffer(RBBuffer buffer) = 0;
+	virtual void bind_constants(u32 slot, RBBuffer buffer) = 0;
+	virtual void bind_buffer(u32 slot, RBBuffer buffer) = 0;
+	virtual void bind_texture(u32 slot, RBTexture texture) = 0;
+	virtual void bind_uav(u32 slot, RBTexture texture) = 0;
+
+	// Drops the texture, structured buffer and UAV binds, before their textures become targets.
+	virtual void unbind_resources() = 0;
+
+	virtual void draw(u32 vertexCount, u32 firstVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) = 0;
+	virtual void draw_indexed(u32 indexCount, u32 firstIndex = 0, s32 baseVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) = 0;
+	virtual void dispatch(u32 groupsX, u32 groupsY, u32 groupsZ = 1) = 0;
+
+	const RBStats& stats() const { return m_stats; }
+	void reset_stats() { m_stats = RBStats(); }
+
+protected:
+	RBStats m_stats;
+};
+
+// Slots for a backend's resources, freed indices are reused.
+template<typename T>
+class RBTable
+{
+public:
+	u32 add(const T& item)
+	{
+		if (!m_free.empty())
+		{
+			const u32 index = m_free.back();
+			m_free.pop_back();
+			m_items[index] = item;
+			m_live[index] = true;
+			return index;
+		}
+		m_items.push_back(item);
+		m_live.push_back(true);
+		return (u32)m_items.size() - 1;
+	}
+
+	void remove(u32 index)
+	{
+		ASSERT(live(index));
+		m_items[index] = T();
+		m_live[index] = false;
+		m_free.push_back(index);
+	}
+
+	bool live(u32 index) const { return index < m_items.size() && m_live[index]; }
+
+	T& operator[](u32 index) { ASSERT(live(index)); return m_items[index]; }
+	const T& operator[](u32 index) const { ASSERT(live(index)); return m_items[index]; }
+
+	// Every slot, live or not.
+	u32 capacity() const { return (u32)m_items.size(); }
+
+	void clear()
+	{
+		m_items.clear();
+		m_live.clear();
+		m_free.clear();
+	}
+
+private:
+	std::vector<T> m_items;
+	std::vector<bool> m_live;
+	std::vector<u32> m_free;
+};
+
+//================================================================================
+// RenderBackendGraph
+// RenderGraph execution on a RenderBackend. Transients get a texture per
+// physical index, kept from frame to frame while the desc stays the same.
+// Passes get their targets set, cleared and their reads / UAVs bound.
+//================================================================================
+class RenderBackendGraph : public RenderGraphBackend
+{
+public:
+	explicit RenderBackendGraph(RenderBackend& backend) : m_backend(backend) {}
+	~RenderBackendGraph();
+
+	// Destroy the transients.
+	void release();
+
+	// Start of the frame, drops last frame's imports.
+	void begin_frame() { m_importCount = 0; }
+
+	// What to hand RenderGraph::import_texture() for a texture the caller owns, valid for the frame.
+	void* import(RBTexture texture);
+
+	RenderBackend& backend() { return m_backend; }
+
+	void* acquire_transient(u32 index, const RGTextureDesc& desc) override;
+	void begin_pass(const RGPassInfo& pass) override;
+	void end_pass(const RGPassInfo& pass) override;
+
+private:
+	RenderBackend& m_backend;
+
+	// Boxed so the pointers the graph holds stay put. Import boxes are reused frame to frame.
+	std::vector<std::unique_ptr<RBTexture>> m_transients;
+	std::vector<std::unique_ptr<RBTexture>> m_imports;
+	u32 m_importCount = 0;
+};
+
+// Short hand for passes, the resource must have been declared by the pass.
+inline RBTexture rg_texture(const RGPassContext& ctx, RGResource resource)
+{
+	return *static_cast<const RBTexture*>(ctx.get(resource));
+}
@@ -0,0 +1,375 @@
+#include "RenderBackendCPU.h"
+
+#include <algorithm>
+
+//================================================================================
+// Formats
+//================================================================================
+
+u16 rb_f32_to_half(f32 value)
+{
+	u32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const u16 sign = (u16)((bits >> 16) & 0x8000);
+	const u32 magnitude = bits & 0x7FFFFFFF;
+
+	// 65536 and up, infinity and NaN.
+	if (magnitude >= 0x47800000)
+	{
+		return (u16)(sign | (magnitude > 0x7F800000 ? 0x7E00 : 0x7C00));
+	}
+
+	// Below 2^-14 the half is subnormal, a fixed 2^-24 step.
+	if (magnitude < 0x38800000)
+	{
+		f32 a;
+		memcpy(&a, &magnitude, sizeof(a));
+		return (u16)(sign | (u16)std::nearbyint(a * 16777216.f));
+	}
+
+	// Drop 13 mantissa bits rounding to nearest even, rebias the exponent from 127 to 15. A carry
+	// out of the mantissa bumps the exponent, up to infinity past 65504.
+	const u32 rounded = magnitude + 0xFFF + ((magnitude >> 13) & 1);
+	return (u16)(sign | ((rounded - 0x38000000) >> 13));
+}
+
+f32 rb_half_to_f32(u16 half)
+{
+	const u32 sign = (u32)(half & 0x8000) << 16;
+	const u32 exponent = (half >> 10) & 0x1F;
+	const u32 mantissa = half & 0x3FF;
+
+	if (exponent == 0)
+	{
+		const f32 value = mantissa / 16777216.f;
+		return sign ? -value : value;
+	}
+
+	const u32 bits = sign | (exponent == 31 ? 0x7F800000 | (mantissa << 13) : ((exponent + 112) << 23) | (mantissa << 13));
+	f32 value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+namespace
+{
+	inline u8 to_unorm8(f32 v) { return (u8)std::lround(std::min(std::max(v, 0.f), 1.f) * 255.f); }
+	inline s16 to_snorm16(f32 v) { return (s16)std::lround(std::min(std::max(v, -1.f), 1.f) * 32767.f); }
+
+	// One texel of value in format, what a clear writes.
+	void encode_texel(RGFormat format, const f32 value[4], u8* pOut)
+	{
+		switch (format)
+		{
+		case RGFormat::kR8_UNORM:
+			pOut[0] = to_unorm8(value[0]);
+			break;
+		case RGFormat::kR16_FLOAT:
+		{
+			const u16 h = rb_f32_to_half(value[0]);
+			memcpy(pOut, &h, sizeof(h));
+			break;
+		}
+		case RGFormat::kR32_FLOAT:
+			memcpy(pOut, value, sizeof(f32));
+			break;
+		case RGFormat::kRG16_FLOAT:
+		case RGFormat::kRGBA16_FLOAT:
+		{
+			const u32 channels = format == RGFormat::kRG16_FLOAT ? 2 : 4;
+			for (u32 c = 0; c < channels; ++c)
+			{
+				const u16 h = rb_f32_to_half(value[c]);
+				memcpy(pOut + c * sizeof(u16), &h, sizeof(h));
+			}
+			break;
+		}
+		case RGFormat::kRG16_SNORM:
+		{
+			const s16 texel[2] = { to_snorm16(value[0]), to_snorm16(value[1]) };
+			memcpy(pOut, texel, sizeof(texel));
+			break;
+		}
+		case RGFormat::kRGBA8_UNORM:
+			for (u32 c = 0; c < 4; ++c)
+			{
+				pOut[c] = to_unorm8(value[c]);
+			}
+			break;
+		case RGFormat::kD24_UNORM_S8_UINT:
+		{
+			// Depth in the low 24 bits, stencil in the top 8.
+			const u32 depth = (u32)std::nearbyint(std::min(std::max(value[0], 0.f), 1.f) * 16777215.f);
+			const u32 texel = depth | ((u32)value[1] << 24);
+			memcpy(pOut, &texel, sizeof(texel));
+			break;
+		}
+		default:
+			ASSERT(false);
+			break;
+		}
+	}
+}
+
+//================================================================================
+// RBCpuTexture
+//================================================================================
+
+f32 RBCpuTexture::load_r(u32 x, u32 y) const
+{
+	switch (key.format)
+	{
+	case RGFormat::kR8_UNORM:	return row<u8>(y)[x] / 255.f;
+	case RGFormat::kR16_FLOAT:	return rb_half_to_f32(row<u16>(y)[x]);
+	case RGFormat::kR32_FLOAT:	return row<f32>(y)[x];
+	default:					ASSERT(false); return 0.f;
+	}
+}
+
+void RBCpuTexture::store_r(u32 x, u32 y, f32 value)
+{
+	switch (key.format)
+	{
+	case RGFormat::kR8_UNORM:	row<u8>(y)[x] = to_unorm8(value); break;
+	case RGFormat::kR16_FLOAT:	row<u16>(y)[x] = rb_f32_to_half(value); break;
+	case RGFormat::kR32_FLOAT:	row<f32>(y)[x] = value; break;
+	default:					ASSERT(false); break;
+	}
+}
+
+//================================================================================
+// RenderBackendCPU
+//================================================================================
+
+RBPipeline RenderBackendCPU::add_pipeline(const char* pName, RBPipelineType type, const RBCpuProgram& program)
+{
+	ASSERT(!find_pipeline(pName).valid());
+
+	Pipeline pipeline;
+	pipeline.name = pName;
+	pipeline.type = type;
+	pipeline.program = program;
+	m_pipelines.push_back(pipeline);
+	return RBPipeline{ (u32)m_pipelines.size() - 1 };
+}
+
+RBBuffer RenderBackendCPU::create_buffer(const RBBufferDesc& desc, const void* pData)
+{
+	RBCpuBuffer buffer;
+	buffer.desc = desc;
+	buffer.bytes.assign(desc.size, 0);
+	if (pData)
+	{
+		memcpy(buffer.bytes.data(), pData, desc.size);
+		m_stats.uploadedBytes += desc.size;
+	}
+	return RBBuffer{ m_buffers.add(buffer) };
+}
+
+void RenderBackendCPU::update_buffer(RBBuffer buffer, const void* pData, u32 size)
+{
+	RBCpuBuffer& entry = m_buffers[buffer.index];
+	ASSERT(size <= entry.desc.size);
+	memcpy(entry.bytes.data(), pData, size);
+	m_stats.uploadedBytes += size;
+}
+
+void RenderBackendCPU::destroy_buffer(RBBuffer buffer)
+{
+	m_buffers.remove(buffer.index);
+}
+
+RBTexture RenderBackendCPU::create_texture(const RTPoolKey& key, const void* pTexels)
+{
+	RBCpuTexture texture;
+	texture.key = key;
+	texture.texels.assign((size_t)key.size_bytes(), 0);
+	if (pTexels)
+	{
+		memcpy(texture.texels.data(), pTexels, texture.texels.size());
+		m_stats.uploadedBytes += key.size_bytes();
+	}
+	return RBTexture{ m_textures.add(texture) };
+}
+
+void RenderBackendCPU::destroy_texture(RBTexture texture)
+{
+	m_textures.remove(texture.index);
+}
+
+void RenderBackendCPU::read_texture(RBTexture texture, void* pTexelsOut)
+{
+	const RBCpuTexture& entry = m_textures[texture.index];
+	memcpy(pTexelsOut, entry.texels.data(), entry.texels.size());
+	m_stats.readBackBytes += entry.texels.size();
+}
+
+RBPipeline RenderBackendCPU::find_pipeline(const char* pName) const
+{
+	for (u32 i = 0; i < m_pipelines.size(); ++i)
+	{
+		if (m_pipelines[i].name == pName)
+			return RBPipeline{ i };
+	}
+	return RBPipeline();
+}
+
+void RenderBackendCPU::set_targets(const RBTexture* pColour, u32 colourCount, RBTexture depth)
+{
+	ASSERT(colourCount <= kMaxColourTargets);
+	for (u32 i = 0; i < kMaxColourTargets; ++i)
+	{
+		m_bindings.targets[i] = i < colourCount ? pColour[i] : RBTexture();
+	}
+	m_bindings.targetCount = colourCount;
+	m_bindings.depth = depth;
+}
+
+void RenderBackendCPU::clear_target(RBTexture target, const f32 value[4])
+{
+	RBCpuTexture& entry = m_textures[target.index];
+	const u32 bytes = rg_bytes_per_texel(entry.key.format);
+
+	u8 texel[16];
+	encode_texel(entry.key.format, value, texel);
+
+	// The first row texel by texel, then the rest of the texture from it.
+	const size_t rowBytes = (size_t)entry.key.width * bytes;
+	for (u32 x = 0; x < entry.key.width; ++x)
+	{
+		memcpy(entry.texels.data() + (size_t)x * bytes, texel, bytes);
+	}
+	for (u32 y = 1; y < entry.key.height; ++y)
+	{
+		memcpy(entry.texels.data() + y * rowBytes, entry.texels.data(), rowBytes);
+	}
+	++m_stats.clears;
+}
+
+void RenderBackendCPU::bind_pipeline(RBPipeline pipeline)
+{
+	ASSERT(pipeline.index < m_pipelines.size());
+	m_bound = pipeline;
+	++m_stats.pipelineBinds;
+}
+
+void RenderBackendCPU::bind_vertex_buffer(RBBuffer buffer)
+{
+	m_bindings.vertices = buffer;
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::bind_index_buffer(RBBuffer buffer)
+{
+	m_bindings.indices = buffer;
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::bind_constants(u32 slot, RBBuffer buffer)
+{
+	ASSERT(slot < kMaxConstantSlots);
+	m_bindings.constants[slot] = buffer;
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::bind_buffer(u32 slot, RBBuffer buffer)
+{
+	ASSERT(slot < kMaxTextureSlots);
+	m_bindings.buffers[slot] = buffer;
+	m_bindings.textures[slot] = RBTexture();
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::bind_texture(u32 slot, RBTexture texture)
+{
+	ASSERT(slot < kMaxTextureSlots);
+	m_bindings.textures[slot] = texture;
+	m_bindings.buffers[slot] = RBBuffer();
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::bind_uav(u32 slot, RBTexture texture)
+{
+	ASSERT(slot < kMaxUAVSlots);
+	m_bindings.uavs[slot] = texture;
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendCPU::unbind_resources()
+{
+	std::fill(std::begin(m_bindings.buffers), std::end(m_bindings.buffers), RBBuffer());
+	std::fill(std::begin(m_bindings.textures), std::end(m_bindings.textures), RBTexture());
+	std::fill(std::begin(m_bindings.uavs), std::end(m_bindings.uavs), RBTexture());
+}
+
+void RenderBackendCPU::draw(u32 vertexCount, u32 firstVertex, u32 instanceCount, u32 firstInstance)
+{
+	RBCpuCall call;
+	call.count = vertexCount;
+	call.first = firstVertex;
+	call.instanceCount = instanceCount;
+	call.firstInstance = firstInstance;
+	run(RBPipelineType::kGraphics, call);
+	++m_stats.draws;
+}
+
+void RenderBackendCPU::draw_indexed(u32 indexCount, u32 firstIndex, s32 baseVertex, u32 instanceCount, u32 firstInstance)
+{
+	RBCpuCall call;
+	call.indexed = true;
+	call.count = indexCount;
+	call.first = firstIndex;
+	call.baseVertex = baseVertex;
+	call.instanceCount = instanceCount;
+	call.firstInstance = firstInstance;
+	run(RBPipelineType::kGraphics, call);
+	++m_stats.draws;
+}
+
+void RenderBackendCPU::dispatch(u32 groupsX, u32 groupsY, u32 groupsZ)
+{
+	RBCpuCall call;
+	call.groups[0] = groupsX;
+	call.groups[1] = groupsY;
+	call.groups[2] = groupsZ;
+	run(RBPipelineType::kCompute, call);
+	++m_stats.dispatches;
+}
+
+void RenderBackendCPU::run(RBPipelineType type, const RBCpuCall& call)
+{
+	ASSERT(m_bound.valid() && m_pipelines[m_bound.index].type == type);
+
+	// Resolved now, the tables may have moved since the binds.
+	RBCpuState state;
+	state.pPool = m_pPool;
+	if (type == RBPipelineType::kGraphics)
+	{
+		for (u32 i = 0; i < m_bindings.targetCount; ++i)
+		{
+			state.pTargets[i] = m_bindings.targets[i].valid() ? &m_textures[m_bindings.targets[i].index] : nullptr;
+		}
+		state.targetCount = m_bindings.targetCount;
+		state.pDepth = m_bindings.depth.valid() ? &m_textures[m_bindings.depth.index] : nullptr;
+		state.pVertices = m_bindings.vertices.valid() ? &m_buffers[m_bindings.vertices.index] : nullptr;
+		state.pIndices = m_bindings.indices.valid() ? &m_buffers[m_bindings.indices.index] : nullptr;
+	}
+	for (u32 i = 0; i < kMaxConstantSlots; ++i)
+	{
+		state.pConstants[i] = m_bindings.constants[i].valid() ? &m_buffers[m_bindings.constants[i].index] : nullptr;
+	}
+	for (u32 i = 0; i < kMaxTextureSlots; ++i)
+	{
+		state.pBuffers[i] = m_bindings.buffers[i].valid() ? &m_buffers[m_bindings.buffers[i].index] : nullptr;
+		state.pTextures[i] = m_bindings.textures[i].valid() ? &m_textures[m_bindings.textures[i].index] : nullptr;
+	}
+	if (type == RBPipelineType::kCompute)
+	{
+		for (u32 i = 0; i < kMaxUAVSlots; ++i)
+		{
+			state.pUAVs[i] = m_bindings.uavs[i].valid() ? &m_textures[m_bindings.uavs[i].index] : nullptr;
+		}
+	}
+
+	m_pipelines[m_bound.index].program(state, call);
+}
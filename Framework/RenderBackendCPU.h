@@ -0,0 +1,159 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <functional>
+#include <string>
+
+class WorkerPool;
+
+//================================================================================
+// RenderBackendCPU
+// Headless RenderBackend: buffers and textures are plain memory in their GPU
+// layouts, a pipeline is a C++ function (RBCpuProgram) that draw / dispatch
+// call with what is bound. Programs are the CPU twins of the shaders, they
+// write the bound targets / UAVs themselves (honouring whatever states the
+// shader set would use) and can split the work over the backend's WorkerPool.
+//
+// Nothing in here needs a window or a GPU, so frames built on RenderBackend run
+// on Linux servers and CI.
+//================================================================================
+
+struct RBCpuTexture
+{
+	RTPoolKey key;
+	std::vector<u8> texels;		// tightly packed rows.
+
+	template<typename T>
+	T* row(u32 y) { return (T*)(texels.data() + (size_t)y * key.width * rg_bytes_per_texel(key.format)); }
+	template<typename T>
+	const T* row(u32 y) const { return (const T*)(texels.data() + (size_t)y * key.width * rg_bytes_per_texel(key.format)); }
+
+	// Single channel formats (R8_UNORM, R16_FLOAT, R32_FLOAT) as f32, stores round like the hardware.
+	f32 load_r(u32 x, u32 y) const;
+	void store_r(u32 x, u32 y, f32 value);
+};
+
+struct RBCpuBuffer
+{
+	RBBufferDesc desc;
+	std::vector<u8> bytes;
+
+	template<typename T>
+	const T* as() const { ASSERT(bytes.size() >= sizeof(T)); return (const T*)bytes.data(); }
+	u32 elements() const { return desc.stride ? (u32)(bytes.size() / desc.stride) : 0; }
+};
+
+// The bindings a program runs with, null where nothing is bound.
+struct RBCpuState
+{
+	RBCpuTexture* pTargets[RenderBackend::kMaxColourTargets] = {};
+	u32 targetCount = 0;
+	RBCpuTexture* pDepth = nullptr;
+
+	const RBCpuBuffer* pVertices = nullptr;
+	const RBCpuBuffer* pIndices = nullptr;
+	const RBCpuBuffer* pConstants[RenderBackend::kMaxConstantSlots] = {};
+	const RBCpuBuffer* pBuffers[RenderBackend::kMaxTextureSlots] = {};
+	const RBCpuTexture* pTextures[RenderBackend::kMaxTextureSlots] = {};
+	RBCpuTexture* pUAVs[RenderBackend::kMaxUAVSlots] = {};
+
+	WorkerPool* pPool = nullptr;	// may be null.
+
+	// b[slot] as the CPU copy of its cbuffer.
+	template<typename T>
+	const T& constants(u32 slot) const { ASSERT(pConstants[slot]); return *pConstants[slot]->as<T>(); }
+};
+
+// Arguments of the draw / dispatch.
+struct RBCpuCall
+{
+	bool indexed = false;
+	u32 count = 0;				// vertices or indices.
+	u32 first = 0;
+	s32 baseVertex = 0;
+	u32 instanceCount = 0;
+	u32 firstInstance = 0;
+	u32 groups[3] = {};			// dispatch.
+};
+
+using RBCpuProgram = std::function<void(const RBCpuState& state, const RBCpuCall& call)>;
+
+class RenderBackendCPU final : public RenderBackend
+{
+public:
+	// Programs get pPool (optional) to spread their work over.
+	explicit RenderBackendCPU(WorkerPool* pPool = nullptr) : m_pPool(pPool) {}
+
+	RBPipeline add_pipeline(const char* pName, RBPipelineType type, const RBCpuProgram& program);
+
+	RBCpuTexture& native(RBTexture texture) { return m_textures[texture.index]; }
+	const RBCpuTexture& native(RBTexture texture) const { return m_textures[texture.index]; }
+	const RBCpuBuffer& native(RBBuffer buffer) const { return m_buffers[buffer.index]; }
+
+	const char* name() const override { return "CPU"; }
+
+	RBBuffer create_buffer(const RBBufferDesc& desc, const void* pData = nullptr) override;
+	void update_buffer(RBBuffer buffer, const void* pData, u32 size) override;
+	void destroy_buffer(RBBuffer buffer) override;
+
+	RBTexture create_texture(const RTPoolKey& key, const void* pTexels = nullptr) override;
+	void destroy_texture(RBTexture texture) override;
+	const RTPoolKey& texture_key(RBTexture texture) const override { return m_textures[texture.index].key; }
+	void read_texture(RBTexture texture, void* pTexelsOut) override;
+
+	RBPipeline find_pipeline(const char* pName) const override;
+
+	void set_targets(const RBTexture* pColour, u32 colourCount, RBTexture depth) override;
+	void clear_target(RBTexture target, const f32 value[4]) override;
+
+	void bind_pipeline(RBPipeline pipeline) override;
+	void bind_vertex_buffer(RBBuffer buffer) override;
+	void bind_index_buffer(RBBuffer buffer) override;
+	void bind_constants(u32 slot, RBBuffer buffer) override;
+	void bind_buffer(u32 slot, RBBuffer buffer) override;
+	void bind_texture(u32 slot, RBTexture texture) override;
+	void bind_uav(u32 slot, RBTexture texture) override;
+	void unbind_resources() override;
+
+	void draw(u32 vertexCount, u32 firstVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) override;
+	void draw_indexed(u32 indexCount, u32 firstIndex = 0, s32 baseVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) override;
+	void dispatch(u32 groupsX, u32 groupsY, u32 groupsZ = 1) override;
+
+private:
+	struct Pipeline
+	{
+		std::string name;
+		RBPipelineType type = RBPipelineType::kGraphics;
+		RBCpuProgram program;
+	};
+
+	// Handles rather than pointers, the tables move when they grow.
+	struct Bindings
+	{
+		RBTexture targets[kMaxColourTargets];
+		u32 targetCount = 0;
+		RBTexture depth;
+		RBBuffer vertices;
+		RBBuffer indices;
+		RBBuffer constants[kMaxConstantSlots];
+		RBBuffer buffers[kMaxTextureSlots];
+		RBTexture textures[kMaxTextureSlots];
+		RBTexture uavs[kMaxUAVSlots];
+	};
+
+	void run(RBPipelineType type, const RBCpuCall& call);
+
+	WorkerPool* m_pPool;
+
+	RBTable<RBCpuBuffer> m_buffers;
+	RBTable<RBCpuTexture> m_textures;
+	std::vector<Pipeline> m_pipelines;
+
+	RBPipeline m_bound;
+	Bindings m_bindings;
+};
+
+// R16_FLOAT conversions, round to nearest even like the hardware.
+u16 rb_f32_to_half(f32 value);
+f32 rb_half_to_f32(u16 half);
@@ -0,0 +1,395 @@
+#include "RenderBackendD3D11.h"
+#include "MemoryTrackerD3D11.h"
+#include "ShaderSet.h"
+
+namespace
+{
+	// Geometry is mesh memory, constants and structured data change per frame.
+	MemoryTag buffer_memory_tag(RBBufferType type)
+	{
+		return type == RBBufferType::kVertex || type == RBBufferType::kIndex ? MemoryTag::kMesh : MemoryTag::kTransient;
+	}
+}
+
+RenderBackendD3D11::~RenderBackendD3D11()
+{
+	release();
+}
+
+void RenderBackendD3D11::init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+{
+	m_pDevice = pDevice;
+	m_pContext = pContext;
+}
+
+void RenderBackendD3D11::release()
+{
+	for (u32 i = 0; i < m_buffers.capacity(); ++i)
+	{
+		if (m_buffers.live(i))
+		{
+			destroy_buffer(RBBuffer{ i });
+		}
+	}
+	for (u32 i = 0; i < m_textures.capacity(); ++i)
+	{
+		if (m_textures.live(i))
+		{
+			destroy_texture(RBTexture{ i });
+		}
+	}
+	m_buffers.clear();
+	m_textures.clear();
+	m_pipelines.clear();
+	m_bound = RBPipeline();
+}
+
+RBPipeline RenderBackendD3D11::add_pipeline(const char* pName, const ShaderSet& shaders, RBPipelineType type)
+{
+	ASSERT(!find_pipeline(pName).valid());
+
+	Pipeline pipeline;
+	pipeline.name = pName;
+	pipeline.pShaders = &shaders;
+	pipeline.type = type;
+	m_pipelines.push_back(pipeline);
+	return RBPipeline{ (u32)m_pipelines.size() - 1 };
+}
+
+RBTexture RenderBackendD3D11::import_texture(const RGTextureD3D11& texture, const RTPoolKey& key)
+{
+	Texture entry;
+	entry.texture = texture;
+	entry.key = key;
+	entry.imported = true;
+	return RBTexture{ m_textures.add(entry) };
+}
+
+//================================================================================
+// Resources
+//================================================================================
+
+RBBuffer RenderBackendD3D11::create_buffer(const RBBufferDesc& desc, const void* pData)
+{
+	Buffer buffer;
+	buffer.desc = desc;
+
+	D3D11_BUFFER_DESC bufferDesc = {};
+	bufferDesc.ByteWidth = desc.size;
+	bufferDesc.Usage = desc.dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
+	bufferDesc.CPUAccessFlags = desc.dynamic ? D3D11_CPU_ACCESS_WRITE : 0;
+	switch (desc.type)
+	{
+	case RBBufferType::kVertex:
+		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		break;
+	case RBBufferType::kIndex:
+		bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		break;
+	case RBBufferType::kConstant:
+		// Constant buffers come in whole constants.
+		bufferDesc.ByteWidth = (desc.size + 15) & ~15u;
+		bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		break;
+	case RBBufferType::kStructured:
+		bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+		bufferDesc.StructureByteStride = desc.stride;
+		break;
+	}
+
+	// The padding of a constant buffer is never read, but creation wants all of it.
+	std::vector<u8> padded;
+	if (pData && bufferDesc.ByteWidth != desc.size)
+	{
+		padded.assign(bufferDesc.ByteWidth, 0);
+		memcpy(padded.data(), pData, desc.size);
+		pData = padded.data();
+	}
+
+	D3D11_SUBRESOURCE_DATA initial = {};
+	initial.pSysMem = pData;
+
+	HRESULT hr = m_pDevice->CreateBuffer(&bufferDesc, pData ? &initial : NULL, &buffer.pBuffer);
+	if (FAILED(hr))
+	{
+		panicF("Failed to create %u byte buffer", desc.size);
+	}
+	track_gpu_resource_d3d11(buffer_memory_tag(desc.type), buffer.pBuffer);
+
+	if (desc.type == RBBufferType::kStructured)
+	{
+		buffer.pSRV = create_structured_buffer_view(m_pDevice, buffer.pBuffer);
+	}
+
+	m_stats.uploadedBytes += pData ? desc.size : 0;
+	return RBBuffer{ m_buffers.add(buffer) };
+}
+
+void RenderBackendD3D11::update_buffer(RBBuffer buffer, const void* pData, u32 size)
+{
+	const Buffer& entry = m_buffers[buffer.index];
+	ASSERT(size <= entry.desc.size);
+
+	if (entry.desc.dynamic)
+	{
+		D3D11_MAPPED_SUBRESOURCE subresource;
+		if (!FAILED(m_pContext->Map(entry.pBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &subresource)))
+		{
+			memcpy(subresource.pData, pData, size);
+			m_pContext->Unmap(entry.pBuffer, 0);
+		}
+	}
+	else
+	{
+		// Constant buffers can only be updated whole.
+		D3D11_BOX box = { 0, 0, 0, size, 1, 1 };
+		m_pContext->UpdateSubresource(entry.pBuffer, 0, entry.desc.type == RBBufferType::kConstant ? NULL : &box, pData, 0, 0);
+	}
+	m_stats.uploadedBytes += size;
+}
+
+void RenderBackendD3D11::destroy_buffer(RBBuffer buffer)
+{
+	Buffer& entry = m_buffers[buffer.index];
+	untrack_gpu_resource_d3d11(buffer_memory_tag(entry.desc.type), entry.pBuffer);
+	SAFE_RELEASE(entry.pSRV);
+	SAFE_RELEASE(entry.pBuffer);
+	m_buffers.remove(buffer.index);
+}
+
+RBTexture RenderBackendD3D11::create_texture(const RTPoolKey& key, const void* pTexels)
+{
+	Texture entry;
+	entry.key = key;
+	create_rg_texture_d3d11(m_pDevice, key, entry.texture);
+
+	if (pTexels)
+	{
+		// Depth stencil resources can't be updated from the CPU.
+		ASSERT(!(key.bindFlags & kRTBindDepthStencil));
+		m_pContext->UpdateSubresource(entry.texture.pTexture, 0, NULL, pTexels, key.width * rg_bytes_per_texel(key.format), 0);
+		m_stats.uploadedBytes += key.size_bytes();
+	}
+
+	return RBTexture{ m_textures.add(entry) };
+}
+
+void RenderBackendD3D11::destroy_texture(RBTexture texture)
+{
+	Texture& entry = m_textures[texture.index];
+	if (!entry.imported)
+	{
+		entry.texture.release();
+	}
+	m_textures.remove(texture.index);
+}
+
+void RenderBackendD3D11::read_texture(RBTexture texture, void* pTexelsOut)
+{
+	const Texture& entry = m_textures[texture.index];
+
+	D3D11_TEXTURE2D_DESC desc;
+	entry.texture.pTexture->GetDesc(&desc);
+	desc.Usage = D3D11_USAGE_STAGING;
+	desc.BindFlags = 0;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+	desc.MiscFlags = 0;
+
+	ID3D11Texture2D* pStaging = nullptr;
+	if (FAILED(m_pDevice->CreateTexture2D(&desc, NULL, &pStaging)))
+	{
+		panicF("Failed to create staging texture for read back");
+	}
+	track_gpu_resource_d3d11(MemoryTag::kTransient, pStaging);
+
+	m_pContext->CopyResource(pStaging, entry.texture.pTexture);
+
+	const u32 rowBytes = entry.key.width * rg_bytes_per_texel(entry.key.format);
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (!FAILED(m_pContext->Map(pStaging, 0, D3D11_MAP_READ, 0, &mapped)))
+	{
+		for (u32 y = 0; y < entry.key.height; ++y)
+		{
+			memcpy((u8*)pTexelsOut + (size_t)y * rowBytes, (const u8*)mapped.pData + (size_t)y * mapped.RowPitch, rowBytes);
+		}
+		m_pContext->Unmap(pStaging, 0);
+	}
+
+	untrack_gpu_resource_d3d11(MemoryTag::kTransient, pStaging);
+	SAFE_RELEASE(pStaging);
+	m_stats.readBackBytes += entry.key.size_bytes();
+}
+
+RBPipeline RenderBackendD3D11::find_pipeline(const char* pName) const
+{
+	for (u32 i = 0; i < m_pipelines.size(); ++i)
+	{
+		if (m_pipelines[i].name == pName)
+			return RBPipeline{ i };
+	}
+	return RBPipeline();
+}
+
+//================================================================================
+// Commands
+//================================================================================
+
+void RenderBackendD3D11::set_targets(const RBTexture* pColour, u32 colourCount, RBTexture depth)
+{
+	ASSERT(colourCount <= kMaxColourTargets);
+
+	ID3D11RenderTargetView* views[kMaxColourTargets] = {};
+	const RTPoolKey* pViewportKey = nullptr;
+	for (u32 i = 0; i < colourCount; ++i)
+	{
+		if (!pColour[i].valid())
+			continue;
+
+		const Texture& entry = m_textures[pColour[i].index];
+		views[i] = entry.texture.pRTV;
+		pViewportKey = pViewportKey ? pViewportKey : &entry.key;
+	}
+
+	ID3D11DepthStencilView* pDepthView = nullptr;
+	if (depth.valid())
+	{
+		const Texture& entry = m_textures[depth.index];
+		pDepthView = entry.texture.pDSV;
+		pViewportKey = pViewportKey ? pViewportKey : &entry.key;
+	}
+
+	m_pContext->OMSetRenderTargets(colourCount, views, pDepthView);
+
+	if (pViewportKey)
+	{
+		D3D11_VIEWPORT viewport = {};
+		viewport.Width = (f32)pViewportKey->width;
+		viewport.Height = (f32)pViewportKey->height;
+		viewport.MinDepth = 0.f;
+		viewport.MaxDepth = 1.f;
+		m_pContext->RSSetViewports(1, &viewport);
+	}
+}
+
+void RenderBackendD3D11::clear_target(RBTexture target, const f32 value[4])
+{
+	const Texture& entry = m_textures[target.index];
+	if (entry.texture.pDSV)
+	{
+		m_pContext->ClearDepthStencilView(entry.texture.pDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, value[0], (u8)value[1]);
+	}
+	else
+	{
+		ASSERT(entry.texture.pRTV);
+		m_pContext->ClearRenderTargetView(entry.texture.pRTV, value);
+	}
+	++m_stats.clears;
+}
+
+void RenderBackendD3D11::bind_pipeline(RBPipeline pipeline)
+{
+	const Pipeline& entry = m_pipelines[pipeline.index];
+	entry.pShaders->bind(m_pContext);
+	if (entry.type == RBPipelineType::kGraphics)
+	{
+		m_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	}
+	m_bound = pipeline;
+	++m_stats.pipelineBinds;
+}
+
+void RenderBackendD3D11::bind_vertex_buffer(RBBuffer buffer)
+{
+	const Buffer& entry = m_buffers[buffer.index];
+	const UINT stride = entry.desc.stride;
+	const UINT offset = 0;
+	m_pContext->IASetVertexBuffers(0, 1, &entry.pBuffer, &stride, &offset);
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendD3D11::bind_index_buffer(RBBuffer buffer)
+{
+	m_pContext->IASetIndexBuffer(m_buffers[buffer.index].pBuffer, DXGI_FORMAT_R16_UINT, 0);
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendD3D11::bind_constants(u32 slot, RBBuffer buffer)
+{
+	ASSERT(slot < kMaxConstantSlots);
+	ID3D11Buffer* pBuffer = m_buffers[buffer.index].pBuffer;
+	m_pContext->VSSetConstantBuffers(slot, 1, &pBuffer);
+	m_pContext->PSSetConstantBuffers(slot, 1, &pBuffer);
+	m_pContext->CSSetConstantBuffers(slot, 1, &pBuffer);
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendD3D11::bind_buffer(u32 slot, RBBuffer buffer)
+{
+	bind_shader_resource(slot, m_buffers[buffer.index].pSRV);
+}
+
+void RenderBackendD3D11::bind_texture(u32 slot, RBTexture texture)
+{
+	bind_shader_resource(slot, m_textures[texture.index].texture.pSRV);
+}
+
+void RenderBackendD3D11::bind_shader_resource(u32 slot, ID3D11ShaderResourceView* pView)
+{
+	// Binds can come before the pipeline (RenderBackendGraph binds the pass's reads first), every stage gets them.
+	ASSERT(slot < kMaxTextureSlots && pView);
+	m_pContext->VSSetShaderResources(slot, 1, &pView);
+	m_pContext->PSSetShaderResources(slot, 1, &pView);
+	m_pContext->CSSetShaderResources(slot, 1, &pView);
+	m_boundShaderResources = std::max(m_boundShaderResources, slot + 1);
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendD3D11::bind_uav(u32 slot, RBTexture texture)
+{
+	ASSERT(slot < kMaxUAVSlots);
+	ID3D11UnorderedAccessView* pView = m_textures[texture.index].texture.pUAV;
+	ASSERT(pView);
+	m_pContext->CSSetUnorderedAccessViews(slot, 1, &pView, nullptr);
+	m_boundUAVs = std::max(m_boundUAVs, slot + 1);
+	++m_stats.resourceBinds;
+}
+
+void RenderBackendD3D11::unbind_resources()
+{
+	ID3D11ShaderResourceView* srvClear[kMaxTextureSlots] = {};
+	ID3D11UnorderedAccessView* uavClear[kMaxUAVSlots] = {};
+	if (m_boundShaderResources)
+	{
+		m_pContext->VSSetShaderResources(0, m_boundShaderResources, srvClear);
+		m_pContext->PSSetShaderResources(0, m_boundShaderResources, srvClear);
+		m_pContext->CSSetShaderResources(0, m_boundShaderResources, srvClear);
+		m_boundShaderResources = 0;
+	}
+	if (m_boundUAVs)
+	{
+		m_pContext->CSSetUnorderedAccessViews(0, m_boundUAVs, uavClear, nullptr);
+		m_boundUAVs = 0;
+	}
+}
+
+void RenderBackendD3D11::draw(u32 vertexCount, u32 firstVertex, u32 instanceCount, u32 firstInstance)
+{
+	ASSERT(m_bound.valid() && m_pipelines[m_bound.index].type == RBPipelineType::kGraphics);
+	m_pContext->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
+	++m_stats.draws;
+}
+
+void RenderBackendD3D11::draw_indexed(u32 indexCount, u32 firstIndex, s32 baseVertex, u32 instanceCount, u32 firstInstance)
+{
+	ASSERT(m_bound.valid() && m_pipelines[m_bound.index].type == RBPipelineType::kGraphics);
+	m_pContext->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+	++m_stats.draws;
+}
+
+void RenderBackendD3D11::dispatch(u32 groupsX, u32 groupsY, u32 groupsZ)
+{
+	ASSERT(m_bound.valid() && m_pipelines[m_bound.index].type == RBPipelineType::kCompute);
+	m_pContext->Dispatch(groupsX, groupsY, groupsZ);
+	++m_stats.dispatches;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CommonHeader.h"
+#include "RenderBackend.h"
+#include "RenderGraphD3D11.h"
+
+#include <string>
+
+struct ShaderSet;
+
+//================================================================================
+// RenderBackendD3D11
+// RenderBackend over an existing device and immediate context. Pipelines are
+// the app's ShaderSets, textures are RGTextureD3D11s with a view per bind flag,
+// constant buffers and shader resources go to the VS, PS and CS slots at once.
+// Graphics pipelines draw triangle lists.
+//================================================================================
+class RenderBackendD3D11 final : public RenderBackend
+{
+public:
+	~RenderBackendD3D11();
+
+	void init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+
+	// Destroy everything the backend created, imports are left alone.
+	void release();
+
+	// shaders must outlive the backend.
+	RBPipeline add_pipeline(const char* pName, const ShaderSet& shaders, RBPipelineType type);
+
+	// A texture created elsewhere, views and all. Never released by the backend, destroy_texture() forgets it.
+	RBTexture import_texture(const RGTextureD3D11& texture, const RTPoolKey& key);
+
+	const RGTextureD3D11& native(RBTexture texture) const { return m_textures[texture.index].texture; }
+	ID3D11Buffer* native(RBBuffer buffer) const { return m_buffers[buffer.index].pBuffer; }
+
+	const char* name() const override { return "D3D11"; }
+
+	RBBuffer create_buffer(const RBBufferDesc& desc, const void* pData = nullptr) override;
+	void update_buffer(RBBuffer buffer, const void* pData, u32 size) override;
+	void destroy_buffer(RBBuffer buffer) override;
+
+	RBTexture create_texture(const RTPoolKey& key, const void* pTexels = nullptr) override;
+	void destroy_texture(RBTexture texture) override;
+	const RTPoolKey& texture_key(RBTexture texture) const override { return m_textures[texture.index].key; }
+	void read_texture(RBTexture texture, void* pTexelsOut) override;
+
+	RBPipeline find_pipeline(const char* pName) const override;
+
+	void set_targets(const RBTexture* pColour, u32 colourCount, RBTexture depth) override;
+	void clear_target(RBTexture target, const f32 value[4]) override;
+
+	void bind_pipeline(RBPipeline pipeline) override;
+	void bind_vertex_buffer(RBBuffer buffer) override;
+	void bind_index_buffer(RBBuffer buffer) override;
+	void bind_constants(u32 slot, RBBuffer buffer) override;
+	void bind_buffer(u32 slot, RBBuffer buffer) override;
+	void bind_texture(u32 slot, RBTexture texture) override;
+	void bind_uav(u32 slot, RBTexture texture) override;
+	void unbind_resources() override;
+
+	void draw(u32 vertexCount, u32 firstVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) override;
+	void draw_indexed(u32 indexCount, u32 firstIndex = 0, s32 baseVertex = 0, u32 instanceCount = 1, u32 firstInstance = 0) override;
+	void dispatch(u32 groupsX, u32 groupsY, u32 groupsZ = 1) override;
+
+private:
+	struct Buffer
+	{
+		ID3D11Buffer* pBuffer = nullptr;
+		ID3D11ShaderResourceView* pSRV = nullptr;	// structured buffers.
+		RBBufferDesc desc;
+	};
+
+	struct Texture
+	{
+		RGTextureD3D11 texture;
+		RTPoolKey key;
+		bool imported = false;
+	};
+
+	struct Pipeline
+	{
+		std::string name;
+		const ShaderSet* pShaders = nullptr;
+		RBPipelineType type = RBPipelineType::kGraphics;
+	};
+
+	void bind_shader_resource(u32 slot, ID3D11ShaderResourceView* pView);
+
+	ID3D11Device* m_pDevice = nullptr;
+	ID3D11DeviceContext* m_pContext = nullptr;
+
+	RBTable<Buffer> m_buffers;
+	RBTable<Texture> m_textures;
+	std::vector<Pipeline> m_pipelines;
+
+	RBPipeline m_bound;
+	u32 m_boundShaderResources = 0;		// slots [0, n) may be bound, PS and CS.
+	u32 m_boundUAVs = 0;
+};
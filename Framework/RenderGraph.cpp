@@ -0,0 +1,649 @@
+#include "RenderGraph.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
+
+//================================================================================
+// Format / state helpers
+//================================================================================
+
+u32 rg_bytes_per_texel(RGFormat format)
+{
+	switch (format)
+	{
+	case RGFormat::kR8_UNORM:			return 1;
+	case RGFormat::kR16_FLOAT:			return 2;
+	case RGFormat::kR32_FLOAT:			return 4;
+	case RGFormat::kRG16_FLOAT:			return 4;
+	case RGFormat::kRG16_SNORM:			return 4;
+	case RGFormat::kRGBA8_UNORM:		return 4;
+	case RGFormat::kRGBA16_FLOAT:		return 8;
+	case RGFormat::kD24_UNORM_S8_UINT:	return 4;
+	default:							return 0;
+	}
+}
+
+const char* rg_format_name(RGFormat format)
+{
+	switch (format)
+	{
+	case RGFormat::kR8_UNORM:			return "R8_UNORM";
+	case RGFormat::kR16_FLOAT:			return "R16_FLOAT";
+	case RGFormat::kR32_FLOAT:			return "R32_FLOAT";
+	case RGFormat::kRG16_FLOAT:			return "RG16_FLOAT";
+	case RGFormat::kRG16_SNORM:			return "RG16_SNORM";
+	case RGFormat::kRGBA8_UNORM:		return "RGBA8_UNORM";
+	case RGFormat::kRGBA16_FLOAT:		return "RGBA16_FLOAT";
+	case RGFormat::kD24_UNORM_S8_UINT:	return "D24_UNORM_S8_UINT";
+	default:							return "Unknown";
+	}
+}
+
+const char* rg_state_name(RGState state)
+{
+	switch (state)
+	{
+	case RGState::kRenderTarget:	return "RenderTarget";
+	case RGState::kDepthWrite:		return "DepthWrite";
+	case RGState::kShaderResource:	return "ShaderResource";
+	case RGState::kUnorderedAccess:	return "UnorderedAccess";
+	default:						return "Undefined";
+	}
+}
+
+//================================================================================
+// RGPassBuilder
+//================================================================================
+
+void RGPassBuilder::read(RGResource resource, u32 slot)
+{
+	ASSERT(resource.valid());
+	m_graph.m_passes[m_pass].reads.push_back({ resource.index, RGState::kShaderResource, slot, RGLoadOp::kLoad });
+}
+
+void RGPassBuilder::write(RGResource resource, u32 target, RGLoadOp load)
+{
+	ASSERT(resource.valid() && !m_graph.m_resources[resource.index].desc.is_depth());
+	m_graph.m_passes[m_pass].writes.push_back({ resource.index, RGState::kRenderTarget, target, load });
+}
+
+void RGPassBuilder::write_depth(RGResource resource, RGLoadOp load)
+{
+	ASSERT(resource.valid() && m_graph.m_resources[resource.index].desc.is_depth());
+	m_graph.m_passes[m_pass].writes.push_back({ resource.index, RGState::kDepthWrite, 0, load });
+}
+
+void RGPassBuilder::write_uav(RGResource resource, u32 slot)
+{
+	ASSERT(resource.valid() && !m_graph.m_resources[resource.index].desc.is_depth());
+
+	RGTextureDesc& desc = m_graph.m_resources[resource.index].desc;
+	ASSERT(!m_graph.m_resources[resource.index].imported || desc.unorderedAccess);
+	desc.unorderedAccess = true;
+
+	m_graph.m_passes[m_pass].writes.push_back({ resource.index, RGState::kUnorderedAccess, slot, RGLoadOp::kDontCare });
+}
+
+void RGPassBuilder::side_effect()
+{
+	m_graph.m_passes[m_pass].sideEffect = true;
+}
+
+void RGPassBuilder::cover(const RGCoverage& coverage)
+{
+	ASSERT(coverage.pNdcXY && coverage.triangles);
+	m_graph.m_passes[m_pass].coverage = coverage;
+}
+
+//================================================================================
+// RGCoverage
+//================================================================================
+
+RGCoverage RGCoverage::FullScreenQuad()
+{
+	// create_mesh_quad_xy vertices (-1,-1) (1,-1) (1,1) (-1,1), indices 0 1 2, 0 2 3.
+	static const f32 kQuad[] = {
+		-1.f, -1.f,  1.f, -1.f,  1.f, 1.f,
+		-1.f, -1.f,  1.f,  1.f, -1.f, 1.f,
+	};
+
+	RGCoverage coverage;
+	coverage.pNdcXY = kQuad;
+	coverage.triangles = 2;
+	return coverage;
+}
+
+//================================================================================
+// RGPassContext
+//================================================================================
+
+void* RGPassContext::get(RGResource resource) const
+{
+	const RenderGraph::Resource& r = m_graph.m_resources[resource.index];
+	return r.imported ? r.pExternal : m_graph.m_physicalResources[r.physical];
+}
+
+const RGTextureDesc& RGPassContext::desc(RGResource resource) const
+{
+	return m_graph.m_resources[resource.index].desc;
+}
+
+//================================================================================
+// RenderGraph
+//================================================================================
+
+void RenderGraph::reset()
+{
+	m_resources.clear();
+	m_passes.clear();
+	m_order.clear();
+	m_physical.clear();
+	m_physicalResources.clear();
+	m_stats = RGStats();
+	m_coverageReports.clear();
+	m_compiled = false;
+
+	// Names and lists of two frames ago go, last frame's stay readable.
+	m_arena.begin_frame();
+}
+
+RGResource RenderGraph::create_texture(const char* pName, const RGTextureDesc& desc)
+{
+	Resource r;
+	r.pName = m_arena.copy_string(pName);
+	r.desc = desc;
+	m_resources.push_back(r);
+	return RGResource{ (u32)m_resources.size() - 1 };
+}
+
+RGResource RenderGraph::import_texture(const char* pName, const RGTextureDesc& desc, void* pResource, RGState initialState)
+{
+	Resource r;
+	r.pName = m_arena.copy_string(pName);
+	r.desc = desc;
+	r.imported = true;
+	r.pExternal = pResource;
+	r.initialState = initialState;
+	m_resources.push_back(r);
+	return RGResource{ (u32)m_resources.size() - 1 };
+}
+
+void RenderGraph::push_pass(const char* pName, const SetupFn& setup, const ExecuteFn& execute)
+{
+	Pass pass(m_arena.current());
+	pass.pName = m_arena.copy_string(pName);
+	pass.execute = execute;
+	m_passes.push_back(std::move(pass));
+
+	RGPassBuilder builder(*this, (u32)m_passes.size() - 1);
+	setup(builder);
+}
+
+u32 RenderGraph::pass_index(const char* pName) const
+{
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		if (!strcmp(m_passes[i].pName, pName))
+			return i;
+	}
+	return ~0u;
+}
+
+bool RenderGraph::compile()
+{
+	TRACE_SCOPE("Render Graph Compile");
+
+	m_order.clear();
+	m_physical.clear();
+	m_stats = RGStats();
+
+	// Every working set below comes from m_scratch and goes back here.
+	ArenaScope scratch(m_scratch);
+
+	// Reading a transient nobody wrote earlier is always a bug, it would sample whatever the
+	// physical texture last held. Dependencies only point back to earlier passes, so the one
+	// cycle a graph can have is a pass reading a texture it also writes.
+	ArenaVector<bool> written(m_resources.size(), false, m_scratch);
+	for (const Pass& pass : m_passes)
+	{
+		for (const RGAccess& a : pass.reads)
+		{
+			if (!m_resources[a.resource].imported && !written[a.resource])
+				return false;
+			if (std::any_of(pass.writes.begin(), pass.writes.end(), [&](const RGAccess& w) { return w.resource == a.resource; }))
+				return false;
+		}
+		for (const RGAccess& a : pass.writes)
+		{
+			written[a.resource] = true;
+		}
+	}
+
+	skip_covered_clears();
+	build_dependencies();
+	cull();
+	if (!sort())
+		return false;
+	alias_transients();
+	place_barriers();
+
+	m_stats.passes = (u32)m_order.size();
+	m_stats.culledPasses = (u32)(m_passes.size() - m_order.size());
+	m_compiled = true;
+	return true;
+}
+
+// Clearing a target the pass then draws over completely is pure bandwidth, the blur chains
+// did it every iteration. Only the load op changes so the dependencies are the same either way.
+void RenderGraph::skip_covered_clears()
+{
+	m_coverageReports.clear();
+
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		Pass& pass = m_passes[i];
+		for (RGAccess& a : pass.writes)
+		{
+			if (a.state != RGState::kRenderTarget)
+				continue;
+
+			const RGTextureDesc& desc = m_resources[a.resource].desc;
+			const bool declared = pass.coverage.triangles != 0;
+
+			if (m_validateCoverage && (declared || a.load == RGLoadOp::kDontCare))
+			{
+				RGCoverageReport report;
+				report.pass = i;
+				report.resource = a.resource;
+				report.declared = declared;
+				if (declared)
+				{
+					report.coverage = rasterise_coverage(pass.coverage.pNdcXY, pass.coverage.triangles, desc.width, desc.height);
+				}
+				else
+				{
+					report.coverage.uncovered = desc.width * desc.height;
+				}
+				m_coverageReports.push_back(report);
+			}
+
+			if (declared && a.load == RGLoadOp::kClear && covers(pass.coverage, desc.width, desc.height))
+			{
+				a.load = RGLoadOp::kDontCare;
+				++m_stats.skippedClears;
+			}
+		}
+	}
+}
+
+// FNV-1a over the vertices, a few dozen bytes for the passes that declare coverage.
+static u64 hash_vertices(const f32* pNdcXY, u32 triangles)
+{
+	u64 h = 0xCBF29CE484222325ull;
+	const u8* p = (const u8*)pNdcXY;
+	for (size_t i = 0; i < (size_t)triangles * 6 * sizeof(f32); ++i)
+	{
+		h = (h ^ p[i]) * 0x100000001B3ull;
+	}
+	return h;
+}
+
+bool RenderGraph::covers(const RGCoverage& coverage, u32 width, u32 height)
+{
+	const u64 vertexHash = hash_vertices(coverage.pNdcXY, coverage.triangles);
+	for (const CoverageCacheEntry& e : m_coverageCache)
+	{
+		if (e.vertexHash == vertexHash && e.triangles == coverage.triangles && e.width == width && e.height == height)
+			return e.full;
+	}
+
+	const bool full = rasterise_coverage(coverage.pNdcXY, coverage.triangles, width, height).full();
+	m_coverageCache.push_back({ vertexHash, coverage.triangles, width, height, full });
+	return full;
+}
+
+// Dependencies follow declaration order :
+//  read after write - the reader depends on the last writer.
+//  write after read - the writer waits for everyone that read the previous contents.
+//  write after write - kept in order, and a kLoad write also consumes the previous contents.
+void RenderGraph::build_dependencies()
+{
+	const u32 kNone = ~0u;
+	ArenaVector<u32> lastWriter(m_resources.size(), kNone, m_scratch);
+	ArenaVector<ArenaVector<u32>> readersSinceWrite(m_resources.size(), ArenaVector<u32>(m_scratch), m_scratch);
+
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		Pass& pass = m_passes[i];
+		pass.dependencies.clear();
+		pass.culled = false;
+
+		for (const RGAccess& a : pass.reads)
+		{
+			if (lastWriter[a.resource] != kNone)
+				pass.dependencies.push_back(lastWriter[a.resource]);
+		}
+
+		for (const RGAccess& a : pass.writes)
+		{
+			if (lastWriter[a.resource] != kNone)
+				pass.dependencies.push_back(lastWriter[a.resource]);
+
+			for (u32 reader : readersSinceWrite[a.resource])
+			{
+				pass.dependencies.push_back(reader);
+			}
+		}
+
+		std::sort(pass.dependencies.begin(), pass.dependencies.end());
+		pass.dependencies.erase(std::unique(pass.dependencies.begin(), pass.dependencies.end()), pass.dependencies.end());
+
+		for (const RGAccess& a : pass.reads)
+		{
+			readersSinceWrite[a.resource].push_back(i);
+		}
+		for (const RGAccess& a : pass.writes)
+		{
+			lastWriter[a.resource] = i;
+			readersSinceWrite[a.resource].clear();
+		}
+	}
+}
+
+// A pass is needed if it has side effects, writes an imported texture, or produces something
+// a needed pass consumes.
+void RenderGraph::cull()
+{
+	const u32 kNone = ~0u;
+	ArenaVector<bool> live(m_passes.size(), false, m_scratch);
+
+	// Producer of every consumed resource, per pass, walking declaration order again.
+	ArenaVector<ArenaVector<u32>> producers(m_passes.size(), ArenaVector<u32>(m_scratch), m_scratch);
+	ArenaVector<u32> lastWriter(m_resources.size(), kNone, m_scratch);
+
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		const Pass& pass = m_passes[i];
+		for (const RGAccess& a : pass.reads)
+		{
+			if (lastWriter[a.resource] != kNone)
+				producers[i].push_back(lastWriter[a.resource]);
+		}
+		for (const RGAccess& a : pass.writes)
+		{
+			if (a.load == RGLoadOp::kLoad && lastWriter[a.resource] != kNone)
+				producers[i].push_back(lastWriter[a.resource]);
+		}
+		for (const RGAccess& a : pass.writes)
+		{
+			lastWriter[a.resource] = i;
+		}
+	}
+
+	ArenaVector<u32> stack(m_scratch);
+	stack.reserve(m_passes.size());
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		const Pass& pass = m_passes[i];
+		bool root = pass.sideEffect;
+		for (const RGAccess& a : pass.writes)
+		{
+			root |= m_resources[a.resource].imported;
+		}
+
+		if (root)
+		{
+			live[i] = true;
+			stack.push_back(i);
+		}
+	}
+
+	while (!stack.empty())
+	{
+		const u32 i = stack.back();
+		stack.pop_back();
+		for (u32 p : producers[i])
+		{
+			if (!live[p])
+			{
+				live[p] = true;
+				stack.push_back(p);
+			}
+		}
+	}
+
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		m_passes[i].culled = !live[i];
+	}
+}
+
+// Kahn's algorithm over the live passes, always taking the earliest declared ready pass so the
+// result stays as close to the declaration order as the dependencies allow.
+bool RenderGraph::sort()
+{
+	ArenaVector<u32> pending(m_passes.size(), 0, m_scratch);
+	ArenaVector<ArenaVector<u32>> dependents(m_passes.size(), ArenaVector<u32>(m_scratch), m_scratch);
+
+	u32 live = 0;
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		if (m_passes[i].culled)
+			continue;
+
+		++live;
+		for (u32 d : m_passes[i].dependencies)
+		{
+			if (!m_passes[d].culled)
+			{
+				++pending[i];
+				dependents[d].push_back(i);
+			}
+		}
+	}
+
+	ArenaVector<u32> ready(m_scratch);
+	ready.reserve(m_passes.size());
+	for (u32 i = 0; i < m_passes.size(); ++i)
+	{
+		if (!m_passes[i].culled && pending[i] == 0)
+			ready.push_back(i);
+	}
+
+	while (!ready.empty())
+	{
+		auto it = std::min_element(ready.begin(), ready.end());
+		const u32 i = *it;
+		ready.erase(it);
+		m_order.push_back(i);
+
+		for (u32 d : dependents[i])
+		{
+			if (--pending[d] == 0)
+				ready.push_back(d);
+		}
+	}
+
+	return m_order.size() == live;
+}
+
+// Greedy first fit : walk the passes in order, a transient takes a free physical texture with a
+// compatible description at its first use and hands it back after its last use.
+void RenderGraph::alias_transients()
+{
+	for (Resource& r : m_resources)
+	{
+		r.physical = ~0u;
+		r.firstUse = ~0u;
+		r.lastUse = 0;
+	}
+
+	for (u32 pos = 0; pos < m_order.size(); ++pos)
+	{
+		const Pass& pass = m_passes[m_order[pos]];
+		auto touch = [&](const RGAccess& a)
+		{
+			Resource& r = m_resources[a.resource];
+			r.firstUse = std::min(r.firstUse, pos);
+			r.lastUse = std::max(r.lastUse, pos);
+		};
+		std::for_each(pass.reads.begin(), pass.reads.end(), touch);
+		std::for_each(pass.writes.begin(), pass.writes.end(), touch);
+	}
+
+	ArenaVector<u32> freeList(m_scratch);
+	freeList.reserve(m_resources.size());
+	for (u32 pos = 0; pos < m_order.size(); ++pos)
+	{
+		for (u32 i = 0; i < m_resources.size(); ++i)
+		{
+			Resource& r = m_resources[i];
+			if (r.imported || r.firstUse != pos)
+				continue;
+
+			auto it = std::find_if(freeList.begin(), freeList.end(), [&](u32 p) { return m_physical[p].compatible(r.desc); });
+			if (it != freeList.end())
+			{
+				r.physical = *it;
+				freeList.erase(it);
+			}
+			else
+			{
+				r.physical = (u32)m_physical.size();
+				m_physical.push_back(r.desc);
+			}
+
+			++m_stats.transients;
+			m_stats.transientBytes += r.desc.size_bytes();
+		}
+
+		// Released after the pass so a pass never reads and writes the same physical texture.
+		for (u32 i = 0; i < m_resources.size(); ++i)
+		{
+			const Resource& r = m_resources[i];
+			if (!r.imported && r.physical != ~0u && r.lastUse == pos)
+				freeList.push_back(r.physical);
+		}
+	}
+
+	m_stats.physicalTransients = (u32)m_physical.size();
+	for (const RGTextureDesc& desc : m_physical)
+	{
+		m_stats.physicalBytes += desc.size_bytes();
+	}
+}
+
+void RenderGraph::place_barriers()
+{
+	// State is tracked per physical texture, imported ones after the transients.
+	const u32 physicalCount = (u32)m_physical.size();
+	ArenaVector<RGState> state(physicalCount + m_resources.size(), RGState::kUndefined, m_scratch);
+	ArenaVector<u32> owner(physicalCount, ~0u, m_scratch);
+
+	for (u32 i = 0; i < m_resources.size(); ++i)
+	{
+		state[physicalCount + i] = m_resources[i].initialState;
+	}
+
+	for (u32 passIndex : m_order)
+	{
+		Pass& pass = m_passes[passIndex];
+		pass.barriers.clear();
+
+		auto transition = [&](const RGAccess& a)
+		{
+			const Resource& r = m_resources[a.resource];
+			const u32 key = r.imported ? physicalCount + a.resource : r.physical;
+
+			bool aliasing = false;
+			if (!r.imported && owner[key] != a.resource)
+			{
+				// The texture held another transient, its contents mean nothing to this one.
+				aliasing = owner[key] != ~0u;
+				owner[key] = a.resource;
+				state[key] = RGState::kUndefined;
+			}
+
+			if (state[key] != a.state || aliasing)
+			{
+				pass.barriers.push_back({ a.resource, state[key], a.state, aliasing });
+				state[key] = a.state;
+			}
+		};
+		std::for_each(pass.reads.begin(), pass.reads.end(), transition);
+		std::for_each(pass.writes.begin(), pass.writes.end(), transition);
+
+		m_stats.barriers += (u32)pass.barriers.size();
+	}
+}
+
+void RenderGraph::execute(RenderGraphBackend& backend)
+{
+	ASSERT(m_compiled);
+
+	backend.begin_execute((u32)m_physical.size());
+
+	m_physicalResources.resize(m_physical.size());
+	for (u32 i = 0; i < m_physical.size(); ++i)
+	{
+		m_physicalResources[i] = backend.acquire_transient(i, m_physical[i]);
+	}
+
+	RGPassInfo& info = m_passInfo;
+	for (u32 passIndex : m_order)
+	{
+		const Pass& pass = m_passes[passIndex];
+		TRACE_SCOPE_CAT("pass", pass.pName);
+
+		info.pName = pass.pName;
+		info.colourTargets.clear();
+		info.depthTarget = RGBinding{ nullptr, nullptr, 0, RGLoadOp::kDontCare };
+		info.shaderResources.clear();
+		info.unorderedAccess.clear();
+		info.barriers.assign(pass.barriers.begin(), pass.barriers.end());
+		info.barrierResources.clear();
+
+		RGPassContext ctx(*this, info);
+		auto binding = [&](const RGAccess& a)
+		{
+			return RGBinding{ ctx.get(RGResource{ a.resource }), &m_resources[a.resource].desc, a.slot, a.load };
+		};
+
+		for (const RGAccess& a : pass.writes)
+		{
+			if (a.state == RGState::kDepthWrite)
+			{
+				info.depthTarget = binding(a);
+				continue;
+			}
+
+			if (a.state == RGState::kUnorderedAccess)
+			{
+				info.unorderedAccess.push_back(binding(a));
+				continue;
+			}
+
+			if (info.colourTargets.size() <= a.slot)
+				info.colourTargets.resize(a.slot + 1, RGBinding{ nullptr, nullptr, 0, RGLoadOp::kDontCare });
+			info.colourTargets[a.slot] = binding(a);
+		}
+
+		for (const RGAccess& a : pass.reads)
+		{
+			info.shaderResources.push_back(binding(a));
+		}
+
+		for (const RGBarrier& b : pass.barriers)
+		{
+			info.barrierResources.push_back(ctx.get(RGResource{ b.resource }));
+		}
+
+		backend.begin_pass(info);
+		if (pass.execute)
+		{
+			pass.execute(ctx);
+		}
+		backend.end_pass(info);
+	}
+}
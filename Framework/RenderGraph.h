@@ -0,0 +1,352 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "Coverage.h"
+#include "FrameArena.h"
+#include "FunctionRef.h"
+
+#include <vector>
+
+//================================================================================
+// RenderGraph
+// Passes declare which named textures they read and write, the graph then works
+// out the execution order, culls passes nothing consumes, aliases transient
+// textures whose lifetimes don't overlap onto the same physical texture and
+// records the state transitions (barriers) each pass needs. Passes that say
+// what they draw (RGCoverage) lose the clears of targets they fully cover.
+//
+// Compilation only deals in indices and descriptions so it runs without a
+// device. Execution goes through a RenderGraphBackend (RenderGraphD3D11.h).
+//
+// Rebuilding it every frame costs no heap allocation once warmed up: names,
+// access lists and execute callbacks go to a FrameArena, compile()'s working
+// sets to a scratch arena, and the pass / resource arrays keep their capacity.
+// The arena is double buffered, names handed out stay valid until the reset()
+// after next.
+//
+// Typical frame:
+//   graph.reset();
+//   RGResource ao = graph.create_texture("SSAO", desc);
+//   graph.add_pass("SSAO", [&](RGPassBuilder& b) { b.read(depth, 2); b.write(ao); }, [&](const RGPassContext& ctx) { draw... });
+//   graph.compile();
+//   graph.execute(backend);
+//================================================================================
+
+enum class RGFormat : u8
+{
+	kUnknown,
+	kR8_UNORM,
+	kR16_FLOAT,
+	kR32_FLOAT,
+	kRG16_FLOAT,
+	kRG16_SNORM,
+	kRGBA8_UNORM,
+	kRGBA16_FLOAT,
+	kD24_UNORM_S8_UINT,
+};
+
+u32 rg_bytes_per_texel(RGFormat format);
+const char* rg_format_name(RGFormat format);
+
+struct RGTextureDesc
+{
+	u32 width = 0;
+	u32 height = 0;
+	RGFormat format = RGFormat::kUnknown;
+	f32 clearValue[4] = { 0.f, 0.f, 0.f, 0.f };	// colour, or depth in [0] / stencil in [1].
+	bool unorderedAccess = false;				// also a compute UAV, set by RGPassBuilder::write_uav on transients.
+
+	static RGTextureDesc Create(u32 width, u32 height, RGFormat format)
+	{
+		RGTextureDesc desc;
+		desc.width = width;
+		desc.height = height;
+		desc.format = format;
+		return desc;
+	}
+
+	u64 size_bytes() const { return (u64)width * height * rg_bytes_per_texel(format); }
+	bool is_depth() const { return format == RGFormat::kD24_UNORM_S8_UINT; }
+
+	// Textures are interchangeable for aliasing when these match, the clear value is per use.
+	bool compatible(const RGTextureDesc& o) const { return width == o.width && height == o.height && format == o.format && unorderedAccess == o.unorderedAccess; }
+};
+
+// What happens to a render target's contents when a pass binds it.
+enum class RGLoadOp : u8
+{
+	kLoad,		// keep what's there, makes the pass depend on the previous writer.
+	kClear,		// clear to the desc clear value.
+	kDontCare,	// every texel gets overwritten.
+};
+
+enum class RGState : u8
+{
+	kUndefined,
+	kRenderTarget,
+	kDepthWrite,
+	kShaderResource,
+	kUnorderedAccess,
+};
+
+const char* rg_state_name(RGState state);
+
+struct RGResource
+{
+	u32 index = ~0u;
+
+	bool valid() const { return index != ~0u; }
+	bool operator==(const RGResource& o) const { return index == o.index; }
+	bool operator!=(const RGResource& o) const { return index != o.index; }
+};
+
+// Screen space triangles a pass's draws rasterise, NDC xy with 3 vertices per triangle. The graph
+// keeps the pointer until compile(), which reads the vertices, so they can be rebuilt each frame
+// in the same storage: the coverage cache is keyed by their contents, not where they are.
+struct RGCoverage
+{
+	const f32* pNdcXY = nullptr;
+	u32 triangles = 0;
+
+	// The two triangles create_mesh_quad_xy(.., 1.0f) draws, what the full screen passes use.
+	static RGCoverage FullScreenQuad();
+};
+
+struct RGAccess
+{
+	u32 resource;
+	RGState state;
+	u32 slot;			// shader resource slot, render target index or UAV slot.
+	RGLoadOp load;
+};
+
+struct RGBarrier
+{
+	u32 resource;
+	RGState before;
+	RGState after;
+	bool aliasing;		// first use of a physical texture that held another transient.
+};
+
+class RenderGraph;
+
+class RGPassBuilder
+{
+public:
+	// Sample the texture in the pixel shader at t[slot].
+	void read(RGResource resource, u32 slot);
+
+	// Bind as colour target [target].
+	void write(RGResource resource, u32 target = 0, RGLoadOp load = RGLoadOp::kClear);
+
+	// Bind as the depth stencil target.
+	void write_depth(RGResource resource, RGLoadOp load = RGLoadOp::kClear);
+
+	// Bind as compute shader UAV u[slot], the pass writes it with a Dispatch. Nothing is cleared,
+	// the shader is expected to write every texel. Makes it a compute pass, reads go to the CS too.
+	void write_uav(RGResource resource, u32 slot = 0);
+
+	// Keep the pass even if nothing reads what it writes.
+	void side_effect();
+
+	// The pass only draws these triangles and its shaders never discard, so kClear colour targets
+	// they cover completely are bound kDontCare instead.
+	void cover(const RGCoverage& coverage);
+
+private:
+	friend class RenderGraph;
+	RGPassBuilder(RenderGraph& graph, u32 pass) : m_graph(graph), m_pass(pass) {}
+
+	RenderGraph& m_graph;
+	u32 m_pass;
+};
+
+// Resolved binding handed to the backend and the pass, pResource is the backend's texture.
+struct RGBinding
+{
+	void* pResource;
+	const RGTextureDesc* pDesc;
+	u32 slot;
+	RGLoadOp load;
+};
+
+struct RGPassInfo
+{
+	const char* pName;
+	std::vector<RGBinding> colourTargets;	// indexed by target.
+	RGBinding depthTarget;					// pResource is null when there is none.
+	std::vector<RGBinding> shaderResources;
+	std::vector<RGBinding> unorderedAccess;	// not empty for compute passes.
+	std::vector<RGBarrier> barriers;
+	std::vector<void*> barrierResources;	// backend texture for each barrier.
+};
+
+class RGPassContext
+{
+public:
+	// Backend texture for a resource the pass declared.
+	void* get(RGResource resource) const;
+	const RGTextureDesc& desc(RGResource resource) const;
+	const RGPassInfo& info() const { return m_info; }
+
+private:
+	friend class RenderGraph;
+	RGPassContext(const RenderGraph& graph, const RGPassInfo& info) : m_graph(graph), m_info(info) {}
+
+	const RenderGraph& m_graph;
+	const RGPassInfo& m_info;
+};
+
+class RenderGraphBackend
+{
+public:
+	virtual ~RenderGraphBackend() {}
+
+	// Start of execute(), physicalCount textures will be acquired. Backends can drop any extras they cached.
+	virtual void begin_execute(u32 /*physicalCount*/) {}
+
+	// Physical transient [index] for this frame. Called once per physical texture before any pass runs.
+	virtual void* acquire_transient(u32 index, const RGTextureDesc& desc) = 0;
+
+	// Apply the barriers, bind targets / shader resources / UAVs and honour the load ops.
+	virtual void begin_pass(const RGPassInfo& pass) = 0;
+	virtual void end_pass(const RGPassInfo& pass) = 0;
+};
+
+struct RGStats
+{
+	u32 passes = 0;
+	u32 culledPasses = 0;
+	u32 transients = 0;
+	u32 physicalTransients = 0;
+	u32 barriers = 0;
+	u64 transientBytes = 0;		// if every transient had its own texture.
+	u64 physicalBytes = 0;		// after aliasing.
+	u32 skippedClears = 0;		// kClear targets a declared coverage fills completely.
+};
+
+// Coverage validation, one per colour target of a pass that declared coverage or binds kDontCare.
+struct RGCoverageReport
+{
+	u32 pass;
+	u32 resource;
+	bool declared;				// false: kDontCare without a coverage, nothing backs it up.
+	CoverageResult coverage;	// of the declared triangles on the target.
+};
+
+class RenderGraph
+{
+public:
+	using SetupFn = FunctionRef<void(RGPassBuilder&)>;
+	using ExecuteFn = ArenaFunction<void(const RGPassContext&)>;
+
+	// Drop all passes and resources, the graph is rebuilt every frame.
+	void reset();
+
+	// Texture owned by the graph, only alive between its first and last use.
+	RGResource create_texture(const char* pName, const RGTextureDesc& desc);
+
+	// Texture owned elsewhere (G-buffer, swap chain). Writing one keeps the pass alive.
+	RGResource import_texture(const char* pName, const RGTextureDesc& desc, void* pResource, RGState initialState = RGState::kUndefined);
+
+	// setup runs now. execute is copied into the graph's arena and runs in execute(), so what it
+	// captures can't need destroying: references, pointers, plain values.
+	template <typename Execute>
+	void add_pass(const char* pName, const SetupFn& setup, const Execute& execute)
+	{
+		push_pass(pName, setup, ExecuteFn(m_arena.current(), execute));
+	}
+
+	// Order, cull, alias and place barriers. Returns false if a transient is read before anything
+	// wrote it, or on a dependency cycle (a pass reading a texture it writes).
+	bool compile();
+
+	void execute(RenderGraphBackend& backend);
+
+	// When on, compile() rasterises every declared coverage again (no cache) and reports
+	// each colour target that relies on it. Off by default.
+	void set_coverage_validation(bool enable) { m_validateCoverage = enable; }
+	bool coverage_validation() const { return m_validateCoverage; }
+	const std::vector<RGCoverageReport>& coverage_reports() const { return m_coverageReports; }
+
+	//-- Results of compile(), for debugging and tests.
+	const RGStats& stats() const { return m_stats; }
+	const std::vector<u32>& order() const { return m_order; }	// pass indices in execution order.
+	bool is_culled(u32 pass) const { return m_passes[pass].culled; }
+	u32 pass_index(const char* pName) const;
+	const char* pass_name(u32 pass) const { return m_passes[pass].pName; }
+	u32 physical_index(RGResource resource) const { return m_resources[resource.index].physical; }
+	const ArenaVector<RGBarrier>& barriers(u32 pass) const { return m_passes[pass].barriers; }
+	const char* resource_name(u32 resource) const { return m_resources[resource].pName; }
+
+private:
+	friend class RGPassBuilder;
+	friend class RGPassContext;
+
+	struct Resource
+	{
+		const char* pName = nullptr;
+		RGTextureDesc desc;
+		bool imported = false;
+		void* pExternal = nullptr;
+		RGState initialState = RGState::kUndefined;
+
+		// compile()
+		u32 physical = ~0u;
+		u32 firstUse = ~0u;		// positions in m_order.
+		u32 lastUse = 0;
+	};
+
+	struct Pass
+	{
+		explicit Pass(LinearArena& arena) : reads(arena), writes(arena), dependencies(arena), barriers(arena) {}
+
+		const char* pName = nullptr;
+		ArenaVector<RGAccess> reads;
+		ArenaVector<RGAccess> writes;
+		ExecuteFn execute;
+		bool sideEffect = false;
+		RGCoverage coverage;
+
+		// compile()
+		bool culled = false;
+		ArenaVector<u32> dependencies;	// passes that must run first.
+		ArenaVector<RGBarrier> barriers;
+	};
+
+	struct CoverageCacheEntry
+	{
+		u64 vertexHash;
+		u32 triangles;
+		u32 width;
+		u32 height;
+		bool full;
+	};
+
+	void push_pass(const char* pName, const SetupFn& setup, const ExecuteFn& execute);
+	void skip_covered_clears();
+	bool covers(const RGCoverage& coverage, u32 width, u32 height);
+	void build_dependencies();
+	void cull();
+	bool sort();
+	void alias_transients();
+	void place_barriers();
+
+	std::vector<Resource> m_resources;
+	std::vector<Pass> m_passes;
+	std::vector<u32> m_order;
+	std::vector<RGTextureDesc> m_physical;
+	std::vector<void*> m_physicalResources;
+	RGStats m_stats;
+	bool m_compiled = false;
+
+	FrameArena m_arena{ 16 * KB };		// names, access lists, callbacks: until the reset() after next
+	LinearArena m_scratch{ 16 * KB };	// compile()'s working sets
+	RGPassInfo m_passInfo;				// execute()'s, kept for the capacity of its lists
+
+	// Kept across reset(), the same passes draw the same geometry into the same sizes every frame.
+	// Keyed by a hash of the vertices, the same pointer can hold other triangles next frame.
+	std::vector<CoverageCacheEntry> m_coverageCache;
+	bool m_validateCoverage = false;
+	std::vector<RGCoverageReport> m_coverageReports;
+};
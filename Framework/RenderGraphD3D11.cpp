@@ -0,0 +1,303 @@
+#include "RenderGraphD3D11.h"
+#include "MemoryTrackerD3D11.h"
+
+//================================================================================
+// Formats
+//================================================================================
+
+DXGI_FORMAT rg_texture_format_d3d11(RGFormat format)
+{
+	switch (format)
+	{
+	case RGFormat::kR8_UNORM:			return DXGI_FORMAT_R8_UNORM;
+	case RGFormat::kR16_FLOAT:			return DXGI_FORMAT_R16_FLOAT;
+	case RGFormat::kR32_FLOAT:			return DXGI_FORMAT_R32_FLOAT;
+	case RGFormat::kRG16_FLOAT:			return DXGI_FORMAT_R16G16_FLOAT;
+	case RGFormat::kRG16_SNORM:			return DXGI_FORMAT_R16G16_SNORM;
+	case RGFormat::kRGBA8_UNORM:		return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case RGFormat::kRGBA16_FLOAT:		return DXGI_FORMAT_R16G16B16A16_FLOAT;
+	case RGFormat::kD24_UNORM_S8_UINT:	return DXGI_FORMAT_R24G8_TYPELESS;	// Typeless because we are binding as SRV and DepthStencilView
+	default:							return DXGI_FORMAT_UNKNOWN;
+	}
+}
+
+DXGI_FORMAT rg_target_format_d3d11(RGFormat format)
+{
+	return format == RGFormat::kD24_UNORM_S8_UINT ? DXGI_FORMAT_D24_UNORM_S8_UINT : rg_texture_format_d3d11(format);
+}
+
+DXGI_FORMAT rg_shader_resource_format_d3d11(RGFormat format)
+{
+	return format == RGFormat::kD24_UNORM_S8_UINT ? DXGI_FORMAT_R24_UNORM_X8_TYPELESS : rg_texture_format_d3d11(format);
+}
+
+//================================================================================
+// RGTextureD3D11
+//================================================================================
+
+void RGTextureD3D11::release()
+{
+	untrack_gpu_resource_d3d11(MemoryTag::kRenderTarget, pTexture);
+	SAFE_RELEASE(pUAV);
+	SAFE_RELEASE(pSRV);
+	SAFE_RELEASE(pRTV);
+	SAFE_RELEASE(pDSV);
+	SAFE_RELEASE(pTexture);
+	*this = RGTextureD3D11();
+}
+
+void create_rg_texture_d3d11(ID3D11Device* pDevice, const RTPoolKey& key, RGTextureD3D11& rOut)
+{
+	HRESULT hr;
+
+	D3D11_TEXTURE2D_DESC texDesc;
+	texDesc.Width = key.width;
+	texDesc.Height = key.height;
+	texDesc.MipLevels = 1;
+	texDesc.ArraySize = 1;
+	texDesc.Format = rg_texture_format_d3d11(key.format);
+	texDesc.SampleDesc.Count = 1;
+	texDesc.SampleDesc.Quality = 0;
+	texDesc.Usage = D3D11_USAGE_DEFAULT;
+	texDesc.BindFlags = 0;
+	texDesc.BindFlags |= (key.bindFlags & kRTBindRenderTarget) ? D3D11_BIND_RENDER_TARGET : 0;
+	texDesc.BindFlags |= (key.bindFlags & kRTBindDepthStencil) ? D3D11_BIND_DEPTH_STENCIL : 0;
+	texDesc.BindFlags |= (key.bindFlags & kRTBindShaderResource) ? D3D11_BIND_SHADER_RESOURCE : 0;
+	texDesc.BindFlags |= (key.bindFlags & kRTBindUnorderedAccess) ? D3D11_BIND_UNORDERED_ACCESS : 0;
+	texDesc.CPUAccessFlags = 0;
+	texDesc.MiscFlags = 0;
+
+	hr = pDevice->CreateTexture2D(&texDesc, NULL, &rOut.pTexture);
+	if (FAILED(hr))
+	{
+		panicF("Failed to create %ux%u %s render target", key.width, key.height, rg_format_name(key.format));
+	}
+	track_gpu_resource_d3d11(MemoryTag::kRenderTarget, rOut.pTexture);
+
+	if (key.bindFlags & kRTBindDepthStencil)
+	{
+		D3D11_DEPTH_STENCIL_VIEW_DESC depthDesc = {};
+		depthDesc.Format = rg_target_format_d3d11(key.format);
+		depthDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+		depthDesc.Texture2D.MipSlice = 0;
+
+		hr = pDevice->CreateDepthStencilView(rOut.pTexture, &depthDesc, &rOut.pDSV);
+		if (FAILED(hr))
+		{
+			panicF("Failed to create Depth Stencil View of render target");
+		}
+	}
+
+	if (key.bindFlags & kRTBindRenderTarget)
+	{
+		hr = pDevice->CreateRenderTargetView(rOut.pTexture, NULL, &rOut.pRTV);
+		if (FAILED(hr))
+		{
+			panicF("Failed to create Render Target View of render target");
+		}
+	}
+
+	if (key.bindFlags & kRTBindShaderResource)
+	{
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Format = rg_shader_resource_format_d3d11(key.format);
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MostDetailedMip = 0;
+		srvDesc.Texture2D.MipLevels = 1;
+
+		hr = pDevice->CreateShaderResourceView(rOut.pTexture, &srvDesc, &rOut.pSRV);
+		if (FAILED(hr))
+		{
+			panicF("Failed to create SRV of render target");
+		}
+	}
+
+	if (key.bindFlags & kRTBindUnorderedAccess)
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = rg_texture_format_d3d11(key.format);
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
+		uavDesc.Texture2D.MipSlice = 0;
+
+		hr = pDevice->CreateUnorderedAccessView(rOut.pTexture, &uavDesc, &rOut.pUAV);
+		if (FAILED(hr))
+		{
+			panicF("Failed to create UAV of render target");
+		}
+	}
+}
+
+//================================================================================
+// RenderTargetAllocatorD3D11
+//================================================================================
+
+void* RenderTargetAllocatorD3D11::create_target(const RTPoolKey& key)
+{
+	RGTextureD3D11* pTarget = new RGTextureD3D11();
+	create_rg_texture_d3d11(m_pDevice, key, *pTarget);
+	return pTarget;
+}
+
+void RenderTargetAllocatorD3D11::destroy_target(void* pTarget)
+{
+	RGTextureD3D11* pTexture = static_cast<RGTextureD3D11*>(pTarget);
+	pTexture->release();
+	delete pTexture;
+}
+
+//================================================================================
+// RenderGraphD3D11
+//================================================================================
+
+RenderGraphD3D11::~RenderGraphD3D11()
+{
+	release();
+}
+
+void RenderGraphD3D11::init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+{
+	m_allocator.init(pDevice);
+	m_pContext = pContext;
+}
+
+void RenderGraphD3D11::release()
+{
+	m_pool.clear();
+}
+
+RGTextureD3D11& RenderGraphD3D11::acquire_target(const RGTextureDesc& desc)
+{
+	return *static_cast<RGTextureD3D11*>(m_pool.acquire(RTPoolKey::From(desc)));
+}
+
+void RenderGraphD3D11::unbind_shader_resources()
+{
+	ID3D11ShaderResourceView* srvClear[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+	if (m_boundShaderResources)
+	{
+		m_pContext->PSSetShaderResources(0, m_boundShaderResources, srvClear);
+		m_boundShaderResources = 0;
+	}
+}
+
+void* RenderGraphD3D11::acquire_transient(u32 /*index*/, const RGTextureDesc& desc)
+{
+	// The graph already shares physical textures within the frame, the pool carries them over to the next.
+	return m_pool.acquire(RTPoolKey::From(desc));
+}
+
+void RenderGraphD3D11::begin_pass(const RGPassInfo& pass)
+{
+	// A texture can't be a target while it is still bound for reading.
+	for (const RGBarrier& b : pass.barriers)
+	{
+		if ((b.after == RGState::kRenderTarget || b.after == RGState::kDepthWrite || b.after == RGState::kUnorderedAccess) && b.before != b.after)
+		{
+			unbind_shader_resources();
+			break;
+		}
+	}
+
+	if (!pass.unorderedAccess.empty())
+	{
+		begin_compute_pass(pass);
+		return;
+	}
+
+	ID3D11RenderTargetView* views[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+	ID3D11DepthStencilView* pDepthView = nullptr;
+	const RGTextureDesc* pTargetDesc = nullptr;
+
+	for (u32 i = 0; i < pass.colourTargets.size(); ++i)
+	{
+		const RGBinding& binding = pass.colourTargets[i];
+		if (!binding.pResource)
+			continue;
+
+		const RGTextureD3D11& texture = *static_cast<const RGTextureD3D11*>(binding.pResource);
+		views[i] = texture.pRTV;
+		pTargetDesc = pTargetDesc ? pTargetDesc : binding.pDesc;
+
+		if (binding.load == RGLoadOp::kClear)
+		{
+			m_pContext->ClearRenderTargetView(texture.pRTV, binding.pDesc->clearValue);
+		}
+	}
+
+	if (pass.depthTarget.pResource)
+	{
+		const RGTextureD3D11& texture = *static_cast<const RGTextureD3D11*>(pass.depthTarget.pResource);
+		pDepthView = texture.pDSV;
+		pTargetDesc = pTargetDesc ? pTargetDesc : pass.depthTarget.pDesc;
+
+		if (pass.depthTarget.load == RGLoadOp::kClear)
+		{
+			const f32* clearValue = pass.depthTarget.pDesc->clearValue;
+			m_pContext->ClearDepthStencilView(pDepthView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, clearValue[0], (u8)clearValue[1]);
+		}
+	}
+
+	if (pTargetDesc)
+	{
+		m_pContext->OMSetRenderTargets((UINT)pass.colourTargets.size(), views, pDepthView);
+
+		// The viewport always covers the whole target.
+		D3D11_VIEWPORT viewport = {};
+		viewport.Width = (f32)pTargetDesc->width;
+		viewport.Height = (f32)pTargetDesc->height;
+		viewport.MinDepth = 0.f;
+		viewport.MaxDepth = 1.f;
+		m_pContext->RSSetViewports(1, &viewport);
+	}
+
+	for (const RGBinding& binding : pass.shaderResources)
+	{
+		const RGTextureD3D11& texture = *static_cast<const RGTextureD3D11*>(binding.pResource);
+		m_pContext->PSSetShaderResources(binding.slot, 1, &texture.pSRV);
+		m_boundShaderResources = std::max(m_boundShaderResources, binding.slot + 1);
+	}
+}
+
+void RenderGraphD3D11::end_pass(const RGPassInfo& pass)
+{
+	// Bindings stay until a later pass needs to write one of them, see begin_pass. Except
+	// compute ones, a UAV left bound would null any later SRV of the same texture.
+	if (!pass.unorderedAccess.empty())
+	{
+		ID3D11ShaderResourceView* srvClear[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+		ID3D11UnorderedAccessView* uavClear[D3D11_PS_CS_UAV_REGISTER_COUNT] = {};
+
+		u32 srvCount = 0;
+		for (const RGBinding& binding : pass.shaderResources)
+		{
+			srvCount = std::max(srvCount, binding.slot + 1);
+		}
+		u32 uavCount = 0;
+		for (const RGBinding& binding : pass.unorderedAccess)
+		{
+			uavCount = std::max(uavCount, binding.slot + 1);
+		}
+
+		m_pContext->CSSetShaderResources(0, srvCount, srvClear);
+		m_pContext->CSSetUnorderedAccessViews(0, uavCount, uavClear, nullptr);
+	}
+}
+
+void RenderGraphD3D11::begin_compute_pass(const RGPassInfo& pass)
+{
+	// Whatever the last graphics pass rendered to may be this pass's input, unbind it or the SRV gets dropped.
+	m_pContext->OMSetRenderTargets(0, nullptr, nullptr);
+
+	for (const RGBinding& binding : pass.shaderResources)
+	{
+		const RGTextureD3D11& texture = *static_cast<const RGTextureD3D11*>(binding.pResource);
+		m_pContext->CSSetShaderResources(binding.slot, 1, &texture.pSRV);
+	}
+
+	for (const RGBinding& binding : pass.unorderedAccess)
+	{
+		const RGTextureD3D11& texture = *static_cast<const RGTextureD3D11*>(binding.pResource);
+		ASSERT(texture.pUAV);
+		m_pContext->CSSetUnorderedAccessViews(binding.slot, 1, &texture.pUAV, nullptr);
+	}
+}
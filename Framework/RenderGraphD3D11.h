@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CommonHeader.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+
+//================================================================================
+// D3D11 backend for the RenderGraph.
+// D3D11 tracks hazards itself so barriers turn into unbinding shader resources
+// before a texture becomes a target again, which keeps the debug layer quiet.
+//================================================================================
+
+// A texture and its views, the void* the D3D11 backend hands to passes points at one of these.
+struct RGTextureD3D11
+{
+	ID3D11Texture2D* pTexture = nullptr;
+	ID3D11RenderTargetView* pRTV = nullptr;
+	ID3D11DepthStencilView* pDSV = nullptr;
+	ID3D11ShaderResourceView* pSRV = nullptr;
+	ID3D11UnorderedAccessView* pUAV = nullptr;
+
+	void release();
+};
+
+// Texture format, plus the formats to view it with (depth is typeless so it can be sampled).
+DXGI_FORMAT rg_texture_format_d3d11(RGFormat format);
+DXGI_FORMAT rg_target_format_d3d11(RGFormat format);
+DXGI_FORMAT rg_shader_resource_format_d3d11(RGFormat format);
+
+// Creates the texture plus a view for each bind flag in the key.
+void create_rg_texture_d3d11(ID3D11Device* pDevice, const RTPoolKey& key, RGTextureD3D11& rOut);
+
+// Short hand for passes, the resource must have been declared by the pass.
+inline RGTextureD3D11& rg_d3d11(const RGPassContext& ctx, RGResource resource)
+{
+	return *static_cast<RGTextureD3D11*>(ctx.get(resource));
+}
+
+// RenderTargetPool allocator, targets are heap allocated RGTextureD3D11s.
+class RenderTargetAllocatorD3D11 : public RTPoolAllocator
+{
+public:
+	void init(ID3D11Device* pDevice) { m_pDevice = pDevice; }
+
+	void* create_target(const RTPoolKey& key) override;
+	void destroy_target(void* pTarget) override;
+
+private:
+	ID3D11Device* m_pDevice = nullptr;
+};
+
+class RenderGraphD3D11 : public RenderGraphBackend
+{
+public:
+	RenderGraphD3D11() : m_pool(m_allocator) {}
+	~RenderGraphD3D11();
+
+	void init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+
+	// Destroy every pooled target.
+	void release();
+
+	// Start of the frame, everything acquired last frame goes back to the pool.
+	void begin_frame() { m_pool.begin_frame(); }
+
+	// Target for the rest of this frame from the same pool as the transients, for textures
+	// the app imports into the graph (G-buffer).
+	RGTextureD3D11& acquire_target(const RGTextureDesc& desc);
+
+	// Unbind everything the graph bound as a shader resource.
+	void unbind_shader_resources();
+
+	const RenderTargetPool& pool() const { return m_pool; }
+	RenderTargetPool& pool() { return m_pool; }
+
+	void* acquire_transient(u32 index, const RGTextureDesc& desc) override;
+	void begin_pass(const RGPassInfo& pass) override;
+	void end_pass(const RGPassInfo& pass) override;
+
+private:
+	void begin_compute_pass(const RGPassInfo& pass);
+
+	ID3D11DeviceContext* m_pContext = nullptr;
+	RenderTargetAllocatorD3D11 m_allocator;
+	RenderTargetPool m_pool;
+	u32 m_boundShaderResources = 0;		// slots [0, n) may hold graph textures.
+};
@@ -0,0 +1,114 @@
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+
+RenderTargetPool::RenderTargetPool(RTPoolAllocator& allocator, u32 maxIdleFrames)
+	: m_allocator(allocator)
+	, m_maxIdleFrames(maxIdleFrames)
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+	clear();
+}
+
+void RenderTargetPool::begin_frame()
+{
+	++m_frame;
+
+	m_stats.created = 0;
+	m_stats.reused = 0;
+	m_stats.evicted = 0;
+
+	for (u32 i = 0; i < m_entries.size();)
+	{
+		Entry& e = m_entries[i];
+		e.inUse = false;
+
+		if (m_frame - e.lastUsedFrame > m_maxIdleFrames)
+		{
+			destroy(i);
+			++m_stats.evicted;
+			continue;
+		}
+		++i;
+	}
+
+	m_stats.inUseTargets = 0;
+}
+
+void* RenderTargetPool::acquire(const RTPoolKey& key)
+{
+	// Most recently used match first, keeps the same target for a pass frame to frame.
+	Entry* pBest = nullptr;
+	for (Entry& e : m_entries)
+	{
+		if (!e.inUse && e.key == key && (!pBest || e.lastUsedFrame > pBest->lastUsedFrame))
+		{
+			pBest = &e;
+		}
+	}
+
+	if (pBest)
+	{
+		++m_stats.reused;
+	}
+	else
+	{
+		Entry e;
+		e.key = key;
+		e.pTarget = m_allocator.create_target(key);
+		e.lastUsedFrame = m_frame;
+		e.inUse = false;
+		m_entries.push_back(e);
+		pBest = &m_entries.back();
+
+		++m_stats.created;
+		++m_stats.liveTargets;
+		m_stats.liveBytes += key.size_bytes();
+		m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.liveBytes);
+	}
+
+	pBest->inUse = true;
+	pBest->lastUsedFrame = m_frame;
+	++m_stats.inUseTargets;
+
+	return pBest->pTarget;
+}
+
+void RenderTargetPool::release(void* pTarget)
+{
+	for (Entry& e : m_entries)
+	{
+		if (e.pTarget == pTarget)
+		{
+			ASSERT(e.inUse);
+			e.inUse = false;
+			--m_stats.inUseTargets;
+			return;
+		}
+	}
+	ASSERT(!"Target doesn't belong to this pool");
+}
+
+void RenderTargetPool::clear()
+{
+	while (!m_entries.empty())
+	{
+		destroy((u32)m_entries.size() - 1);
+	}
+	m_stats.inUseTargets = 0;
+}
+
+void RenderTargetPool::destroy(u32 entry)
+{
+	const Entry e = m_entries[entry];
+	m_entries[entry] = m_entries.back();
+	m_entries.pop_back();
+
+	m_allocator.destroy_target(e.pTarget);
+
+	--m_stats.liveTargets;
+	m_stats.liveBytes -= e.key.size_bytes();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "RenderGraph.h"
+
+#include <vector>
+
+//================================================================================
+// RenderTargetPool
+// Render targets keyed by (width, height, format, bind flags). Everything handed
+// out is returned to the pool at the start of the next frame, a target that
+// isn't asked for again within maxIdleFrames is destroyed. So changing a target
+// size costs one creation and the old size ages out instead of being torn down
+// on the spot, and going back to a size that is still pooled costs nothing.
+//
+// The policy only deals in keys and opaque pointers, creation goes through an
+// RTPoolAllocator (RenderGraphD3D11.h) so it can be driven without a device.
+//================================================================================
+
+enum RTBindFlags : u32
+{
+	kRTBindRenderTarget = 1 << 0,
+	kRTBindDepthStencil = 1 << 1,
+	kRTBindShaderResource = 1 << 2,
+	kRTBindUnorderedAccess = 1 << 3,
+};
+
+struct RTPoolKey
+{
+	u32 width = 0;
+	u32 height = 0;
+	RGFormat format = RGFormat::kUnknown;
+	u32 bindFlags = 0;
+
+	// Sampled render target (and UAV if the desc asks), or sampled depth stencil for depth formats.
+	static RTPoolKey From(const RGTextureDesc& desc)
+	{
+		RTPoolKey key;
+		key.width = desc.width;
+		key.height = desc.height;
+		key.format = desc.format;
+		key.bindFlags = (desc.is_depth() ? kRTBindDepthStencil : kRTBindRenderTarget) | kRTBindShaderResource;
+		if (desc.unorderedAccess)
+		{
+			key.bindFlags |= kRTBindUnorderedAccess;
+		}
+		return key;
+	}
+
+	u64 size_bytes() const { return (u64)width * height * rg_bytes_per_texel(format); }
+
+	bool operator==(const RTPoolKey& o) const { return width == o.width && height == o.height && format == o.format && bindFlags == o.bindFlags; }
+	bool operator!=(const RTPoolKey& o) const { return !(*this == o); }
+};
+
+class RTPoolAllocator
+{
+public:
+	virtual ~RTPoolAllocator() {}
+
+	virtual void* create_target(const RTPoolKey& key) = 0;
+	virtual void destroy_target(void* pTarget) = 0;
+};
+
+struct RTPoolStats
+{
+	u32 liveTargets = 0;
+	u32 inUseTargets = 0;
+	u64 liveBytes = 0;
+	u64 peakBytes = 0;
+
+	// this frame
+	u32 created = 0;
+	u32 reused = 0;
+	u32 evicted = 0;
+};
+
+class RenderTargetPool
+{
+public:
+	static constexpr u32 kDefaultMaxIdleFrames = 30;
+
+	explicit RenderTargetPool(RTPoolAllocator& allocator, u32 maxIdleFrames = kDefaultMaxIdleFrames);
+	~RenderTargetPool();
+
+	// Return every target to the pool and destroy the ones that have sat idle too long.
+	void begin_frame();
+
+	// Free target with a matching key, or a new one. Stays in use until release() or the next frame.
+	void* acquire(const RTPoolKey& key);
+
+	// Hand a target back early so something else can have it this frame.
+	void release(void* pTarget);
+
+	// Destroy every target, in use or not.
+	void clear();
+
+	void set_max_idle_frames(u32 frames) { m_maxIdleFrames = frames; }
+	u32 max_idle_frames() const { return m_maxIdleFrames; }
+
+	u64 frame() const { return m_frame; }
+	const RTPoolStats& stats() const { return m_stats; }
+
+private:
+	struct Entry
+	{
+		RTPoolKey key;
+		void* pTarget;
+		u64 lastUsedFrame;
+		bool inUse;
+	};
+
+	void destroy(u32 entry);
+
+	RTPoolAllocator& m_allocator;
+	std::vector<Entry> m_entries;
+	u32 m_maxIdleFrames;
+	u64 m_frame = 0;
+	RTPoolStats m_stats;
+};
@@ -0,0 +1,276 @@
+#include "SeparableBlur.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//================================================================================
+// BlurKernel
+//================================================================================
+
+// Discrete weights of the 9 tap kernel, the linear fetches below pair them up.
+static const f32 kGauss9Weights[5] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
+
+const f32 LinearGaussTaps::kOffsets[kFetches] = { 0.0f, 1.3846153846f, 3.2307692308f };
+const f32 LinearGaussTaps::kWeights[kFetches] = { 0.2270270270f, 0.3162162162f, 0.0702702703f };
+
+BlurKernel BlurKernel::Gauss9(u32 iterations)
+{
+	BlurKernel gauss9;
+	gauss9.radius = 4;
+	for (s32 i = 0; i < 5; ++i)
+	{
+		gauss9.weights[4 + i] = gauss9.weights[4 - i] = kGauss9Weights[i];
+	}
+
+	BlurKernel kernel = gauss9;
+	for (u32 i = 1; i < iterations; ++i)
+	{
+		kernel = kernel.convolved(gauss9);
+	}
+	return kernel;
+}
+
+BlurKernel BlurKernel::Box(u32 radius, u32 iterations)
+{
+	ASSERT(radius > 0 && iterations > 0 && radius * iterations <= kMaxRadius);
+
+	BlurKernel box;
+	box.radius = radius;
+	for (u32 i = 0; i < box.taps(); ++i)
+	{
+		box.weights[i] = 1.f / box.taps();
+	}
+
+	BlurKernel kernel = box;
+	for (u32 i = 1; i < iterations; ++i)
+	{
+		kernel = kernel.convolved(box);
+	}
+	kernel.boxRadius = radius;
+	kernel.boxIterations = iterations;
+	return kernel;
+}
+
+BlurKernel BlurKernel::convolved(const BlurKernel& o) const
+{
+	ASSERT(radius + o.radius <= kMaxRadius);
+
+	BlurKernel result;
+	result.radius = radius + o.radius;
+	for (u32 a = 0; a < taps(); ++a)
+	{
+		for (u32 b = 0; b < o.taps(); ++b)
+		{
+			result.weights[a + b] += weights[a] * o.weights[b];
+		}
+	}
+	return result;
+}
+
+f32 BlurKernel::sigma() const
+{
+	f64 variance = 0.0;
+	for (s32 i = -(s32)radius; i <= (s32)radius; ++i)
+	{
+		variance += (f64)weight(i) * i * i;
+	}
+	return (f32)std::sqrt(variance);
+}
+
+//================================================================================
+// Reference
+//================================================================================
+
+void blur_separable(const f32* pIn, f32* pOut, u32 width, u32 height, const BlurKernel& kernel)
+{
+	const s32 r = (s32)kernel.radius;
+	std::vector<f32> rows((size_t)width * height);
+
+	for (u32 y = 0; y < height; ++y)
+	{
+		const f32* pRow = pIn + (size_t)y * width;
+		for (u32 x = 0; x < width; ++x)
+		{
+			f32 sum = 0.f;
+			for (s32 i = -r; i <= r; ++i)
+			{
+				const s32 sx = std::min(std::max((s32)x + i, 0), (s32)width - 1);
+				sum += pRow[sx] * kernel.weight(i);
+			}
+			rows[(size_t)y * width + x] = sum;
+		}
+	}
+
+	for (u32 y = 0; y < height; ++y)
+	{
+		for (u32 x = 0; x < width; ++x)
+		{
+			f32 sum = 0.f;
+			for (s32 i = -r; i <= r; ++i)
+			{
+				const s32 sy = std::min(std::max((s32)y + i, 0), (s32)height - 1);
+				sum += rows[(size_t)sy * width + x] * kernel.weight(i);
+			}
+			pOut[(size_t)y * width + x] = sum;
+		}
+	}
+}
+
+//================================================================================
+// Fused
+//================================================================================
+
+namespace
+{
+	// Scratch for one tile, span = tile + 2 * radius on each axis that needs the apron.
+	struct TileScratch
+	{
+		std::vector<f32> input;		// span x span
+		std::vector<f32> rows;		// span rows of tile texels
+		std::vector<f32> line[2];	// box ping-pong
+	};
+
+	// One per thread that blurs, it keeps its capacity so a frame's blur doesn't go back to the heap.
+	thread_local TileScratch t_tileScratch;
+
+	// out[i] = sum of in[i + t] * w[t], n outputs from n + 2r inputs, stride apart.
+	inline void convolve_line(const f32* pIn, u32 inStride, f32* pOut, u32 outStride, u32 n, const BlurKernel& kernel)
+	{
+		const u32 taps = kernel.taps();
+		for (u32 i = 0; i < n; ++i)
+		{
+			const f32* p = pIn + (size_t)i * inStride;
+			f32 sum = 0.f;
+			for (u32 t = 0; t < taps; ++t)
+			{
+				sum += p[(size_t)t * inStride] * kernel.weights[t];
+			}
+			pOut[(size_t)i * outStride] = sum;
+		}
+	}
+
+	// boxIterations sliding sums, each pass turns n + 2r inputs into n outputs.
+	inline void box_line(const f32* pIn, u32 inStride, f32* pOut, u32 outStride, u32 n, const BlurKernel& kernel, TileScratch& scratch)
+	{
+		const u32 r = kernel.boxRadius;
+		const u32 window = 2 * r + 1;
+		const f32 scale = 1.f / window;
+
+		u32 length = n + 2 * kernel.radius;
+		f32* pSrc = scratch.line[0].data();
+		for (u32 i = 0; i < length; ++i)
+		{
+			pSrc[i] = pIn[(size_t)i * inStride];
+		}
+
+		for (u32 pass = 0; pass < kernel.boxIterations; ++pass)
+		{
+			f32* pDst = scratch.line[(pass + 1) & 1].data();
+
+			f32 sum = 0.f;
+			for (u32 i = 0; i < window; ++i)
+			{
+				sum += pSrc[i];
+			}
+
+			const u32 outLength = length - 2 * r;
+			pDst[0] = sum * scale;
+			for (u32 i = 1; i < outLength; ++i)
+			{
+				sum += pSrc[i + 2 * r] - pSrc[i - 1];
+				pDst[i] = sum * scale;
+			}
+
+			pSrc = pDst;
+			length = outLength;
+		}
+
+		for (u32 i = 0; i < n; ++i)
+		{
+			pOut[(size_t)i * outStride] = pSrc[i];
+		}
+	}
+
+	void blur_tile(const f32* pIn, f32* pOut, u32 width, u32 height, const BlurKernel& kernel, u32 tileX, u32 tileY, TileScratch& scratch)
+	{
+		const u32 r = kernel.radius;
+		const u32 x0 = tileX * kFusedBlurTile;
+		const u32 y0 = tileY * kFusedBlurTile;
+		const u32 tileW = std::min(kFusedBlurTile, width - x0);
+		const u32 tileH = std::min(kFusedBlurTile, height - y0);
+		const u32 spanW = tileW + 2 * r;
+		const u32 spanH = tileH + 2 * r;
+
+		// Tile plus apron, once, clamping at the image edges.
+		for (u32 y = 0; y < spanH; ++y)
+		{
+			const s32 sy = std::min(std::max((s32)(y0 + y) - (s32)r, 0), (s32)height - 1);
+			const f32* pRow = pIn + (size_t)sy * width;
+			f32* pDst = scratch.input.data() + (size_t)y * spanW;
+			for (u32 x = 0; x < spanW; ++x)
+			{
+				const s32 sx = std::min(std::max((s32)(x0 + x) - (s32)r, 0), (s32)width - 1);
+				pDst[x] = pRow[sx];
+			}
+		}
+
+		const bool box = kernel.boxIterations > 0;
+
+		// Rows, every row of the span (the columns need the apron rows) but only the tile's columns.
+		for (u32 y = 0; y < spanH; ++y)
+		{
+			const f32* pSrc = scratch.input.data() + (size_t)y * spanW;
+			f32* pDst = scratch.rows.data() + (size_t)y * tileW;
+			if (box)
+				box_line(pSrc, 1, pDst, 1, tileW, kernel, scratch);
+			else
+				convolve_line(pSrc, 1, pDst, 1, tileW, kernel);
+		}
+
+		// Columns, straight into the output.
+		for (u32 x = 0; x < tileW; ++x)
+		{
+			const f32* pSrc = scratch.rows.data() + x;
+			f32* pDst = pOut + (size_t)y0 * width + x0 + x;
+			if (box)
+				box_line(pSrc, tileW, pDst, width, tileH, kernel, scratch);
+			else
+				convolve_line(pSrc, tileW, pDst, width, tileH, kernel);
+		}
+	}
+}
+
+void blur_fused(const f32* pIn, f32* pOut, u32 width, u32 height, const BlurKernel& kernel, WorkerPool* pPool)
+{
+	if (!width || !height)
+		return;
+
+	const u32 tilesX = (width + kFusedBlurTile - 1) / kFusedBlurTile;
+	const u32 tilesY = (height + kFusedBlurTile - 1) / kFusedBlurTile;
+	const u32 span = kFusedBlurTile + 2 * kernel.radius;
+
+	auto blur_tiles = [&](u32 begin, u32 end)
+	{
+		TileScratch& scratch = t_tileScratch;
+		scratch.input.resize((size_t)span * span);
+		scratch.rows.resize((size_t)span * kFusedBlurTile);
+		scratch.line[0].resize(span);
+		scratch.line[1].resize(span);
+
+		for (u32 tile = begin; tile < end; ++tile)
+		{
+			blur_tile(pIn, pOut, width, height, kernel, tile % tilesX, tile / tilesX, scratch);
+		}
+	};
+
+	if (pPool)
+	{
+		pPool->parallel_for(tilesX * tilesY, 1, blur_tiles);
+	}
+	else
+	{
+		blur_tiles(0, tilesX * tilesY);
+	}
+}
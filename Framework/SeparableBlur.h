@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+//================================================================================
+// Separable Blur
+// CPU twin of CS_BLUR_FUSED (SSAOShaders.fx). Instead of a full X pass and a full
+// Y pass through memory, the image is cut into tiles: each tile loads itself plus
+// an apron of kernel radius texels once, blurs the rows into a small buffer and
+// then the columns straight into the output. Tiles are independent so they are
+// shared out over a WorkerPool.
+//
+// Kernels are symmetric weight tables. Gauss9 is the 9 tap kernel the 5 linear
+// fetches of PS_BLUR_GAUSS_X / _Y add up to, convolved n times it is the same as
+// running those passes n times. Box kernels iterated a few times approach a
+// gaussian of any radius, and the fused blur runs them as sliding sums so the
+// cost doesn't grow with the radius.
+//
+// Single channel f32 planes, row major, edges clamp. Only standard headers so it
+// builds with the CPU benchmark.
+//================================================================================
+
+class WorkerPool;
+
+struct BlurKernel
+{
+	static constexpr u32 kMaxRadius = 32;
+
+	u32 radius = 0;
+	f32 weights[2 * kMaxRadius + 1] = {};	// weights[radius + i] for offset i, sums to 1.
+
+	// Set by Box(), the fused blur runs these as sliding sums instead of the weights.
+	u32 boxRadius = 0;
+	u32 boxIterations = 0;
+
+	// PS_BLUR_GAUSS_X then _Y, iterations times.
+	static BlurKernel Gauss9(u32 iterations = 1);
+
+	// iterations box passes of 2 * radius + 1 taps, radius * iterations <= kMaxRadius.
+	static BlurKernel Box(u32 radius, u32 iterations);
+
+	// Applying this then o, as one kernel. Drops the box shortcut.
+	BlurKernel convolved(const BlurKernel& o) const;
+
+	u32 taps() const { return 2 * radius + 1; }
+	f32 weight(s32 offset) const { return weights[(s32)radius + offset]; }
+
+	// Standard deviation in texels, how wide the kernel effectively is.
+	f32 sigma() const;
+};
+
+// The 5 linear fetches of PS_BLUR_GAUSS_X / _Y, offsets in texels from the centre.
+struct LinearGaussTaps
+{
+	static constexpr u32 kFetches = 3;	// centre + two each side.
+	static const f32 kOffsets[kFetches];
+	static const f32 kWeights[kFetches];
+};
+
+// Tile size of blur_fused() (the GPU one uses 16, see CS_BLUR_FUSED).
+constexpr u32 kFusedBlurTile = 64;
+
+// Full X pass into a temporary then a full Y pass, on the calling thread. The reference
+// blur_fused() is checked against.
+void blur_separable(const f32* pIn, f32* pOut, u32 width, u32 height, const BlurKernel& kernel);
+
+// Tiled, fused X + Y. Tiles go over pPool when there is one. Matches blur_separable() up to
+// float rounding (sliding sums for box kernels).
+void blur_fused(const f32* pIn, f32* pOut, u32 width, u32 height, const BlurKernel& kernel, WorkerPool* pPool = nullptr);
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <algorithm>
+
+//================================================================================
+// HLSL style maths for CPU ports of shader code.
+// The names deliberately follow HLSL so a CPU reference reads like the .fx it
+// mirrors. Matrices follow the same row-vector convention as mul(v, M) on the
+// (un-transposed) m4x4 values the app builds before uploading them.
+//================================================================================
+namespace hlsl
+{
+
+struct float2
+{
+	f32 x, y;
+
+	float2() : x(0.f), y(0.f) {}
+	explicit float2(f32 s) : x(s), y(s) {}
+	float2(f32 _x, f32 _y) : x(_x), y(_y) {}
+
+	float2 operator+(const float2& o) const { return float2(x + o.x, y + o.y); }
+	float2 operator-(const float2& o) const { return float2(x - o.x, y - o.y); }
+	float2 operator*(const float2& o) const { return float2(x * o.x, y * o.y); }
+	float2 operator/(const float2& o) const { return float2(x / o.x, y / o.y); }
+	float2 operator*(f32 s) const { return float2(x * s, y * s); }
+	float2 operator/(f32 s) const { return float2(x / s, y / s); }
+	float2& operator+=(const float2& o) { x += o.x; y += o.y; return *this; }
+};
+
+struct float3
+{
+	f32 x, y, z;
+
+	float3() : x(0.f), y(0.f), z(0.f) {}
+	explicit float3(f32 s) : x(s), y(s), z(s) {}
+	float3(f32 _x, f32 _y, f32 _z) : x(_x), y(_y), z(_z) {}
+
+	float3 operator+(const float3& o) const { return float3(x + o.x, y + o.y, z + o.z); }
+	float3 operator-(const float3& o) const { return float3(x - o.x, y - o.y, z - o.z); }
+	float3 operator*(const float3& o) const { return float3(x * o.x, y * o.y, z * o.z); }
+	float3 operator*(f32 s) const { return float3(x * s, y * s, z * s); }
+	float3 operator/(f32 s) const { return float3(x / s, y / s, z / s); }
+	float3 operator-() const { return float3(-x, -y, -z); }
+	float3& operator+=(const float3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+};
+
+struct float4
+{
+	f32 x, y, z, w;
+
+	float4() : x(0.f), y(0.f), z(0.f), w(0.f) {}
+	float4(f32 _x, f32 _y, f32 _z, f32 _w) : x(_x), y(_y), z(_z), w(_w) {}
+	float4(const float3& v, f32 _w) : x(v.x), y(v.y), z(v.z), w(_w) {}
+
+	float3 xyz() const { return float3(x, y, z); }
+	float4 operator/(f32 s) const { return float4(x / s, y / s, z / s, w / s); }
+};
+
+// Row major 4x4, laid out exactly like DirectX::SimpleMath::Matrix so the app can memcpy.
+struct float4x4
+{
+	f32 m[4][4];
+
+	static float4x4 identity()
+	{
+		float4x4 r = {};
+		r.m[0][0] = r.m[1][1] = r.m[2][2] = r.m[3][3] = 1.f;
+		return r;
+	}
+
+	static float4x4 from_array(const f32* p)
+	{
+		float4x4 r;
+		memcpy(r.m, p, sizeof(r.m));
+		return r;
+	}
+};
+
+inline float2 operator*(f32 s, const float2& v) { return v * s; }
+inline float3 operator*(f32 s, const float3& v) { return v * s; }
+
+inline f32 dot(const float2& a, const float2& b) { return a.x * b.x + a.y * b.y; }
+inline f32 dot(const float3& a, const float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline float3 cross(const float3& a, const float3& b) { return float3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); }
+inline f32 length(const float3& v) { return std::sqrt(dot(v, v)); }
+
+inline float3 normalize(const float3& v)
+{
+	const f32 l = length(v);
+	return l > 0.f ? v / l : v;
+}
+
+inline f32 saturate(f32 v) { return std::min(std::max(v, 0.f), 1.f); }
+inline f32 frac(f32 v) { return v - std::floor(v); }
+inline f32 lerp(f32 a, f32 b, f32 t) { return a + (b - a) * t; }
+inline f32 step(f32 edge, f32 x) { return x >= edge ? 1.f : 0.f; }
+
+inline f32 smoothstep(f32 e0, f32 e1, f32 x)
+{
+	const f32 t = saturate((x - e0) / (e1 - e0));
+	return t * t * (3.f - 2.f * t);
+}
+
+// mul(v, M) with v as a row vector.
+inline float4 mul(const float4& v, const float4x4& M)
+{
+	float4 r;
+	r.x = v.x * M.m[0][0] + v.y * M.m[1][0] + v.z * M.m[2][0] + v.w * M.m[3][0];
+	r.y = v.x * M.m[0][1] + v.y * M.m[1][1] + v.z * M.m[2][1] + v.w * M.m[3][1];
+	r.z = v.x * M.m[0][2] + v.y * M.m[1][2] + v.z * M.m[2][2] + v.w * M.m[3][2];
+	r.w = v.x * M.m[0][3] + v.y * M.m[1][3] + v.z * M.m[2][3] + v.w * M.m[3][3];
+	return r;
+}
+
+// mul(A, B), A then B for row vectors.
+inline float4x4 mul(const float4x4& A, const float4x4& B)
+{
+	float4x4 r;
+	for (u32 i = 0; i < 4; ++i)
+	{
+		for (u32 j = 0; j < 4; ++j)
+		{
+			r.m[i][j] = A.m[i][0] * B.m[0][j] + A.m[i][1] * B.m[1][j] + A.m[i][2] * B.m[2][j] + A.m[i][3] * B.m[3][j];
+		}
+	}
+	return r;
+}
+
+// mul(v, (float3x3)M) - rotates a direction by the upper 3x3.
+inline float3 mul3x3(const float3& v, const float4x4& M)
+{
+	return float3(
+		v.x * M.m[0][0] + v.y * M.m[1][0] + v.z * M.m[2][0],
+		v.x * M.m[0][1] + v.y * M.m[1][1] + v.z * M.m[2][1],
+		v.x * M.m[0][2] + v.y * M.m[1][2] + v.z * M.m[2][2]);
+}
+
+} // namespace hlsl
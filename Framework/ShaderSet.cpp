@@ -1,5 +1,6 @@
 #include "CommonHeader.h"
 #include "ShaderSet.h"
+#include "Trace.h"
 
 #include <d3dcompiler.h>
 
@@ -25,7 +26,9 @@ void compileShaderFromFile(const char * fileName, const char * entryPoint, const
 	size_t numChars;
 	mbstowcs_s(&numChars, fileNameW, MAX_PATH, fileName, MAX_PATH);
 
-	D3D_SHADER_MACRO macros[] = { {NULL, NULL} };
+	// SHADER_MODEL is 4 or 5, lets shaders use SM5 only instructions (Gather*, ...) with a fallback.
+	const char* shaderModelDefine = shaderModel[3] == '5' ? "5" : "4";
+	D3D_SHADER_MACRO macros[] = { { "SHADER_MODEL", shaderModelDefine }, {NULL, NULL} };
 
 	ComPtr<ID3DBlob> pErrorBlob;
 	HRESULT hr = D3DCompileFromFile(fileNameW, macros, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, shaderModel,
@@ -44,8 +47,12 @@ ShaderSet::ShaderSet()
 
 void ShaderSet::init(ID3D11Device* device, const ShaderSetDesc& desc, const InputLayoutDesc & layout)
 {
+	TRACE_SCOPE_CAT("load", "Compile Shader Set");
+
 	ComPtr<ID3DBlob> blobs[ShaderStage::kMaxStages];
-	static const char* profiles[ShaderStage::kMaxStages] = { "vs_4_0", "hs_4_0" ,"ds_4_0" ,"gs_4_0" ,"ps_4_0" ,"cs_4_0" };
+	static const char* profiles4[ShaderStage::kMaxStages] = { "vs_4_0", "hs_4_0" ,"ds_4_0" ,"gs_4_0" ,"ps_4_0" ,"cs_4_0" };
+	static const char* profiles5[ShaderStage::kMaxStages] = { "vs_5_0", "hs_5_0" ,"ds_5_0" ,"gs_5_0" ,"ps_5_0" ,"cs_5_0" };
+	const char** profiles = device->GetFeatureLevel() >= D3D_FEATURE_LEVEL_11_0 ? profiles5 : profiles4;
 
 	// Compile each stage we set an entry point for.
 	for (u32 i = 0; i < ShaderStage::kMaxStages; ++i)
@@ -118,18 +125,21 @@ void ShaderSet::init(ID3D11Device* device, const ShaderSetDesc& desc, const Inpu
 		hr = device->CreateComputeShader(blobs[ShaderStage::kCompute]->GetBufferPointer(), blobs[ShaderStage::kCompute]->GetBufferSize(), nullptr, cs.GetAddressOf());
 		if (FAILED(hr))
 		{
-			panicF("Failed to create pixel shader");
+			panicF("Failed to create compute shader");
 		}
 	}
 
-	// Create vertex input layout:
-	hr = device->CreateInputLayout(std::get<0>(layout), std::get<1>(layout),
-		blobs[ShaderStage::kVertex]->GetBufferPointer(),
-		blobs[ShaderStage::kVertex]->GetBufferSize(),
-		inputLayout.GetAddressOf());
-	if (FAILED(hr))
+	// Create vertex input layout, compute only sets have none:
+	if (blobs[ShaderStage::kVertex])
 	{
-		panicF("Failed to create vertex layout!");
+		hr = device->CreateInputLayout(std::get<0>(layout), std::get<1>(layout),
+			blobs[ShaderStage::kVertex]->GetBufferPointer(),
+			blobs[ShaderStage::kVertex]->GetBufferSize(),
+			inputLayout.GetAddressOf());
+		if (FAILED(hr))
+		{
+			panicF("Failed to create vertex layout!");
+		}
 	}
 }
 
@@ -38,6 +38,14 @@ struct ShaderSetDesc
 		return desc;
 	}
 
+	static ShaderSetDesc Create_CS(const char* fName, const char* csEntry)
+	{
+		ShaderSetDesc desc = {};
+		desc.filename = fName;
+		desc.entryPoints[ShaderStage::kCompute] = csEntry;
+		return desc;
+	}
+
 	static ShaderSetDesc Create_VS_GS_PS(const char* fName, const char* vsEntry, const char* gsEntry, const char* psEntry)
 	{
 		ShaderSetDesc desc = {};
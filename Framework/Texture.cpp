@@ -1,4 +1,6 @@
 #include "Texture.h"
+#include "MemoryTrackerD3D11.h"
+#include "Trace.h"
 #include "DirectXTK/DDSTextureLoader.h"
 #include "DirectXTK/WICTextureLoader.h"
 
@@ -11,12 +13,22 @@ Texture::Texture()
 
 Texture::~Texture()
 {
+	release();
+}
+
+void Texture::release()
+{
+	untrack_gpu_resource_d3d11(MemoryTag::kTexture, m_pTexture);
 	SAFE_RELEASE(m_pTextureView);
 	SAFE_RELEASE(m_pTexture);
+	m_pTextureView = nullptr;
+	m_pTexture = nullptr;
 }
 
 void Texture::init_from_dds(ID3D11Device* pDevice, const char* pFilename)
 {
+	TRACE_SCOPE_CAT("load", "Load Texture");
+
 	wchar_t fileNameW[MAX_PATH];
 	size_t numChars;
 	mbstowcs_s(&numChars, fileNameW, MAX_PATH, pFilename, MAX_PATH);
@@ -26,10 +38,13 @@ void Texture::init_from_dds(ID3D11Device* pDevice, const char* pFilename)
 	{
 		panicF("Could not load texture : %s ", pFilename);
 	}
+	track_gpu_resource_d3d11(MemoryTag::kTexture, m_pTexture);
 }
 
 void Texture::init_from_image(ID3D11Device* pDevice, const char* pFilename, bool bGenerateMips)
 {
+	TRACE_SCOPE_CAT("load", "Load Texture");
+
 	wchar_t fileNameW[MAX_PATH];
 	size_t numChars;
 	mbstowcs_s(&numChars, fileNameW, MAX_PATH, pFilename, MAX_PATH);
@@ -39,6 +54,71 @@ void Texture::init_from_image(ID3D11Device* pDevice, const char* pFilename, bool
 	{
 		panicF("Could not load texture : %s ", pFilename);
 	}
+	track_gpu_resource_d3d11(MemoryTag::kTexture, m_pTexture);
+}
+
+void Texture::init_from_memory(ID3D11Device* pDevice, u32 width, u32 height, DXGI_FORMAT format, const void* pTexels, u32 rowPitch)
+{
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = width;
+	desc.Height = height;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = format;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA data = {};
+	data.pSysMem = pTexels;
+	data.SysMemPitch = rowPitch;
+
+	ID3D11Texture2D* pTexture2D = nullptr;
+	HRESULT hr = pDevice->CreateTexture2D(&desc, &data, &pTexture2D);
+	if (FAILED(hr))
+	{
+		panicF("Could not create texture from memory : %u x %u ", width, height);
+	}
+	m_pTexture = pTexture2D;
+	track_gpu_resource_d3d11(MemoryTag::kTexture, m_pTexture);
+
+	hr = pDevice->CreateShaderResourceView(m_pTexture, nullptr, &m_pTextureView);
+	if (FAILED(hr))
+	{
+		panicF("Could not create texture view : %u x %u ", width, height);
+	}
+}
+
+void Texture::init_from_memory_3d(ID3D11Device* pDevice, u32 width, u32 height, u32 depth, DXGI_FORMAT format, const void* pTexels, u32 texelBytes)
+{
+	D3D11_TEXTURE3D_DESC desc = {};
+	desc.Width = width;
+	desc.Height = height;
+	desc.Depth = depth;
+	desc.MipLevels = 1;
+	desc.Format = format;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA data = {};
+	data.pSysMem = pTexels;
+	data.SysMemPitch = width * texelBytes;
+	data.SysMemSlicePitch = width * height * texelBytes;
+
+	ID3D11Texture3D* pTexture3D = nullptr;
+	HRESULT hr = pDevice->CreateTexture3D(&desc, &data, &pTexture3D);
+	if (FAILED(hr))
+	{
+		panicF("Could not create 3D texture from memory : %u x %u x %u ", width, height, depth);
+	}
+	m_pTexture = pTexture3D;
+	track_gpu_resource_d3d11(MemoryTag::kTexture, m_pTexture);
+
+	hr = pDevice->CreateShaderResourceView(m_pTexture, nullptr, &m_pTextureView);
+	if (FAILED(hr))
+	{
+		panicF("Could not create texture view : %u x %u x %u ", width, height, depth);
+	}
 }
 
 void Texture::bind(ID3D11DeviceContext* pDeviceContext, ShaderStage::ShaderStageEnum stage, u32 slot) const
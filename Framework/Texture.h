@@ -17,6 +17,14 @@ public:
 	// Initialize from a non-dds image files such as JPEG, or PNG
 	void init_from_image(ID3D11Device* pDevice, const char* pFilename, bool bGenerateMips);
 
+	// Initialize a single mip 2D texture from texels already in memory (e.g. generated tables).
+	void init_from_memory(ID3D11Device* pDevice, u32 width, u32 height, DXGI_FORMAT format, const void* pTexels, u32 rowPitch);
+
+	// Same for a single mip 3D texture (e.g. a baked distance field), tightly packed rows and slices.
+	void init_from_memory_3d(ID3D11Device* pDevice, u32 width, u32 height, u32 depth, DXGI_FORMAT format, const void* pTexels, u32 texelBytes);
+
+	void release();
+
 	// bind to the pipeline on a particular shader and slot
 	void bind(ID3D11DeviceContext* pDeviceContext, ShaderStage::ShaderStageEnum stage, u32 slot) const;
 
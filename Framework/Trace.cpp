@@ -0,0 +1,280 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Trace
+{
+	namespace
+	{
+		// The GPU track, threads count up from 1 in the order they first record.
+		constexpr u32 kGpuTrack = 0;
+
+		struct Event
+		{
+			const char* pCategory;
+			u64 start;
+			u64 duration;
+			u16 depth;
+			u16 gpu;
+			char name[kMaxName];
+		};
+
+		struct ThreadBuffer
+		{
+			u32 track = 0;
+			std::string name;					// under Registry::mutex, set_thread_name() can rename
+			std::unique_ptr<Event[]> events;
+			std::atomic<u32> count{ 0 };		// written by the owning thread only
+			std::atomic<u32> dropped{ 0 };
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+		};
+
+		// Never destroyed, workers can still finish a scope while statics go away.
+		Registry& registry()
+		{
+			static Registry* s_pRegistry = new Registry();
+			return *s_pRegistry;
+		}
+
+		// Outside the registry so a scope that isn't recorded costs one load, no static init guard.
+		std::atomic<bool> g_recording{ false };
+
+		thread_local ThreadBuffer* t_pBuffer = nullptr;
+		thread_local char t_name[kMaxName] = {};
+		thread_local u32 t_depth = 0;
+
+		void copy_name(char* pDest, const char* pName)
+		{
+			u32 length = 0;
+			while (pName[length] && length + 1 < kMaxName)
+			{
+				pDest[length] = pName[length];
+				++length;
+			}
+			pDest[length] = '\0';
+		}
+
+		ThreadBuffer& thread_buffer()
+		{
+			if (t_pBuffer)
+				return *t_pBuffer;
+
+			Registry& r = registry();
+			std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+			buffer->events.reset(new Event[kEventsPerThread]);
+
+			std::lock_guard<std::mutex> lock(r.mutex);
+			buffer->track = (u32)r.buffers.size() + 1;
+			if (t_name[0])
+			{
+				buffer->name = t_name;
+			}
+			else
+			{
+				char name[32];
+				snprintf(name, sizeof(name), "Thread %u", buffer->track);
+				buffer->name = name;
+			}
+			t_pBuffer = buffer.get();
+			r.buffers.push_back(std::move(buffer));
+			return *t_pBuffer;
+		}
+
+		void record(const char* pCategory, const char* pName, u64 startNs, u64 durationNs, u32 depth, bool gpu)
+		{
+			ThreadBuffer& buffer = thread_buffer();
+			const u32 index = buffer.count.load(std::memory_order_relaxed);
+			if (index >= kEventsPerThread)
+			{
+				buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			Event& event = buffer.events[index];
+			event.pCategory = pCategory;
+			event.start = startNs;
+			event.duration = durationNs;
+			event.depth = (u16)depth;
+			event.gpu = gpu ? 1 : 0;
+			copy_name(event.name, pName);
+
+			// write_json() reads up to count, the event has to be there first.
+			buffer.count.store(index + 1, std::memory_order_release);
+		}
+
+		void write_string(FILE* pFile, const char* pText)
+		{
+			fputc('"', pFile);
+			for (const char* p = pText; *p; ++p)
+			{
+				if (*p == '"' || *p == '\\')
+				{
+					fputc('\\', pFile);
+					fputc(*p, pFile);
+				}
+				else if ((u8)*p < 0x20)
+				{
+					fprintf(pFile, "\\u%04x", (u32)(u8)*p);
+				}
+				else
+				{
+					fputc(*p, pFile);
+				}
+			}
+			fputc('"', pFile);
+		}
+
+		void write_track_name(FILE* pFile, u32 track, const char* pName)
+		{
+			fprintf(pFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", track);
+			write_string(pFile, pName);
+			fprintf(pFile, "}},\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}", track, track);
+		}
+	}
+
+	u64 now_ns()
+	{
+		static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+		return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+	}
+
+	void start()
+	{
+		now_ns();
+		g_recording.store(true, std::memory_order_relaxed);
+	}
+
+	void stop()
+	{
+		g_recording.store(false, std::memory_order_relaxed);
+	}
+
+	bool recording()
+	{
+		return g_recording.load(std::memory_order_relaxed);
+	}
+
+	void clear()
+	{
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers)
+		{
+			buffer->count.store(0, std::memory_order_relaxed);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void set_thread_name(const char* pName)
+	{
+		copy_name(t_name, pName);
+		if (t_pBuffer)
+		{
+			std::lock_guard<std::mutex> lock(registry().mutex);
+			t_pBuffer->name = t_name;
+		}
+	}
+
+	void complete(const char* pCategory, const char* pName, u64 startNs, u64 durationNs, u32 depth)
+	{
+		if (recording())
+		{
+			record(pCategory, pName, startNs, durationNs, depth, false);
+		}
+	}
+
+	void gpu_interval(const char* pName, u64 startNs, u64 durationNs)
+	{
+		if (recording())
+		{
+			record("gpu", pName, startNs, durationNs, 0, true);
+		}
+	}
+
+	Stats stats()
+	{
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+
+		Stats result;
+		result.threads = (u32)r.buffers.size();
+		for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers)
+		{
+			result.events += buffer->count.load(std::memory_order_acquire);
+			result.dropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	bool write_json(const char* pPath)
+	{
+		FILE* pFile = fopen(pPath, "w");
+		if (!pFile)
+			return false;
+
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+
+		fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+		write_track_name(pFile, kGpuTrack, "GPU");
+		for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers)
+		{
+			fprintf(pFile, ",\n");
+			write_track_name(pFile, buffer->track, buffer->name.c_str());
+		}
+
+		for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers)
+		{
+			const u32 count = buffer->count.load(std::memory_order_acquire);
+			for (u32 i = 0; i < count; ++i)
+			{
+				const Event& event = buffer->events[i];
+				fprintf(pFile, ",\n{\"name\":");
+				write_string(pFile, event.name);
+				fprintf(pFile, ",\"cat\":");
+				write_string(pFile, event.pCategory);
+				fprintf(pFile, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"depth\":%u}}"
+					, event.start / 1000.0, event.duration / 1000.0, event.gpu ? kGpuTrack : buffer->track, (u32)event.depth);
+			}
+		}
+		fprintf(pFile, "\n]}\n");
+
+		const bool ok = !ferror(pFile);
+		fclose(pFile);
+		return ok;
+	}
+
+	Scope::Scope(const char* pCategory, const char* pName)
+		: m_pCategory(pCategory)
+		, m_pName(pName)
+		, m_start(0)
+		, m_active(recording())
+	{
+		if (m_active)
+		{
+			m_start = now_ns();
+			++t_depth;
+		}
+	}
+
+	// Kept even when stop() came in between, so a trace never ends on a half open scope.
+	Scope::~Scope()
+	{
+		if (m_active)
+		{
+			--t_depth;
+			record(m_pCategory, m_pName, m_start, now_ns() - m_start, t_depth, false);
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+//================================================================================
+// Trace
+// Scoped CPU timings and GPU intervals written out as Chrome trace-event JSON,
+// which chrome://tracing and ui.perfetto.dev both open. One track per thread
+// (the main thread, WorkerPool / CommandRecorder workers), scopes nest by time
+// on their track, GPU intervals go on a track of their own.
+//
+//   TRACE_SCOPE("Geometry");				// until the end of the block
+//   TRACE_SCOPE_CAT("job", "Blur Tiles");
+//   TRACE_GPU("SSAO", cpuStartNs, gpuNs);	// an interval measured elsewhere
+//
+// Each thread records into its own fixed buffer, registered once on its first
+// event: the owner is the only writer and publishes each event with a release
+// store of its count, so recording takes no lock. Names are copied (up to
+// kMaxName - 1 characters), render graph pass names don't outlive the frame.
+// A full buffer drops events and counts them.
+//
+// Nothing is kept unless start() was called. With TRACE_ENABLED 0 the macros
+// compile to nothing, the functions stay for the UI. Only standard headers so
+// it builds with the CPU tools.
+//================================================================================
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+namespace Trace
+{
+	constexpr u32 kMaxName = 36;
+	constexpr u32 kEventsPerThread = 64 * 1024;
+
+	struct Stats
+	{
+		u32 threads = 0;
+		u64 events = 0;
+		u64 dropped = 0;
+	};
+
+	// Nanoseconds since the first call, what every event is timed with.
+	u64 now_ns();
+
+	void start();
+	void stop();
+	bool recording();
+
+	// Forget every event. Only between frames, with no scope open on another thread.
+	void clear();
+
+	// Label of the calling thread's track, "Thread <n>" otherwise.
+	void set_thread_name(const char* pName);
+
+	// A scope that began at startNs, on the calling thread's track.
+	void complete(const char* pCategory, const char* pName, u64 startNs, u64 durationNs, u32 depth);
+
+	// An interval on the GPU track, startNs on the now_ns() clock.
+	void gpu_interval(const char* pName, u64 startNs, u64 durationNs);
+
+	Stats stats();
+
+	// Everything recorded so far, as {"traceEvents": [...]}. False when the file can't be written.
+	bool write_json(const char* pPath);
+
+	class Scope
+	{
+	public:
+		Scope(const char* pCategory, const char* pName);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char* m_pCategory;
+		const char* m_pName;
+		u64 m_start;
+		bool m_active;
+	};
+}
+
+#if TRACE_ENABLED
+	#define TRACE_CONCAT_(a, b) a##b
+	#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+	#define TRACE_SCOPE_CAT(category, name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+	#define TRACE_SCOPE(name) TRACE_SCOPE_CAT("cpu", name)
+	#define TRACE_GPU(name, startNs, durationNs) Trace::gpu_interval(name, startNs, durationNs)
+	#define TRACE_THREAD_NAME(name) Trace::set_thread_name(name)
+#else
+	#define TRACE_SCOPE_CAT(category, name) ((void)0)
+	#define TRACE_SCOPE(name) ((void)0)
+	#define TRACE_GPU(name, startNs, durationNs) ((void)0)
+	#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,85 @@
+#include "UploadRing.h"
+
+#include <algorithm>
+
+UploadRing::UploadRing(u32 capacity, u32 alignment)
+	: m_capacity(capacity)
+	, m_alignment(alignment)
+{
+	ASSERT(alignment && (alignment & (alignment - 1)) == 0);
+	ASSERT(capacity % alignment == 0);
+}
+
+void UploadRing::begin_frame()
+{
+	m_staging.clear();
+	m_committed = false;
+
+	m_stats.frameBytes = 0;
+	m_stats.frameAllocations = 0;
+}
+
+void* UploadRing::allocate(u32 size, UploadAllocation& out)
+{
+	ASSERT(!m_committed);
+
+	const u32 alignedSize = (size + m_alignment - 1) & ~(m_alignment - 1);
+
+	out.offset = (u32)m_staging.size();
+	out.size = size;
+
+	m_staging.resize(m_staging.size() + alignedSize);
+
+	++m_stats.frameAllocations;
+	m_stats.frameBytes += alignedSize;
+
+	return m_staging.data() + out.offset;
+}
+
+UploadAllocation UploadRing::allocate(const void* pData, u32 size)
+{
+	UploadAllocation a;
+	memcpy(allocate(size, a), pData, size);
+	return a;
+}
+
+UploadPlacement UploadRing::commit()
+{
+	ASSERT(!m_committed);
+
+	UploadPlacement placement;
+	placement.size = frame_size();
+	placement.grew = false;
+
+	if (placement.size > m_capacity)
+	{
+		while (m_capacity < placement.size)
+			m_capacity *= 2;
+
+		placement.grew = true;
+		++m_stats.grows;
+	}
+
+	if (m_first || placement.grew || m_head + placement.size > m_capacity)
+	{
+		if (!m_first)
+			++m_stats.wraps;
+
+		placement.base = 0;
+		placement.discard = true;
+	}
+	else
+	{
+		placement.base = m_head;
+		placement.discard = false;
+	}
+
+	m_first = false;
+	m_base = placement.base;
+	m_head = placement.base + placement.size;
+	m_committed = true;
+
+	m_stats.peakFrameBytes = std::max(m_stats.peakFrameBytes, m_stats.frameBytes);
+
+	return placement;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+//================================================================================
+// UploadRing
+// Bookkeeping for streaming a frame's constants through one big dynamic buffer.
+// During the frame allocate() copies each block into CPU staging at an aligned
+// offset from the start of the frame's data. commit() then places the whole
+// frame in the ring in one go: straight after the previous frame when it fits
+// (written without overwriting what the GPU may still be reading), otherwise
+// back at 0 with the old contents discarded. A frame bigger than the ring grows
+// it. So a frame's constants are one contiguous write, and a binding is the
+// ring offset of its block.
+//
+// Only standard headers, the GPU side is UploadRingD3D11.
+//================================================================================
+
+// offset is from the start of the frame's data, UploadRing::ring_offset() after commit().
+struct UploadAllocation
+{
+	u32 offset = 0;
+	u32 size = 0;
+};
+
+struct UploadPlacement
+{
+	u32 base;			// ring offset of the frame's data
+	u32 size;			// bytes to write at base
+	bool discard;		// back at the start of the ring, nothing before base is needed any more
+	bool grew;			// capacity() went up, the buffer needs recreating (discard is set too)
+};
+
+struct UploadRingStats
+{
+	u32 frameBytes = 0;
+	u32 peakFrameBytes = 0;
+	u32 frameAllocations = 0;
+	u32 wraps = 0;
+	u32 grows = 0;
+};
+
+class UploadRing
+{
+public:
+	// alignment must be a power of two, capacity a multiple of it.
+	UploadRing(u32 capacity, u32 alignment);
+
+	// Drops the last frame's staging, its placement stays reserved until the next commit.
+	void begin_frame();
+
+	// Reserves size bytes (rounded up to the alignment) and returns where to write them.
+	void* allocate(u32 size, UploadAllocation& out);
+
+	UploadAllocation allocate(const void* pData, u32 size);
+
+	UploadPlacement commit();
+
+	u32 ring_offset(const UploadAllocation& a) const { ASSERT(m_committed); return m_base + a.offset; }
+
+	// The frame's data, frame_size() bytes, to be written at the committed base.
+	const u8* staging() const { return m_staging.data(); }
+	u32 frame_size() const { return (u32)m_staging.size(); }
+
+	u32 capacity() const { return m_capacity; }
+	u32 alignment() const { return m_alignment; }
+	u32 head() const { return m_head; }
+
+	const UploadRingStats& stats() const { return m_stats; }
+
+private:
+	std::vector<u8> m_staging;
+	u32 m_capacity;
+	u32 m_alignment;
+	u32 m_head = 0;		// end of the last committed frame
+	u32 m_base = 0;
+	bool m_committed = false;
+	bool m_first = true;
+	UploadRingStats m_stats;
+};
@@ -0,0 +1,167 @@
+#include "UploadRingD3D11.h"
+#include "MemoryTrackerD3D11.h"
+
+UploadRingD3D11::~UploadRingD3D11()
+{
+	release();
+}
+
+void UploadRingD3D11::init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+{
+	m_pDevice = pDevice;
+	m_pContext = pContext;
+
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	if (!FAILED(pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)))
+		&& options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+	{
+		HRESULT hr = pContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&m_pContext1);
+		if (FAILED(hr))
+		{
+			m_pContext1 = nullptr;
+		}
+	}
+
+	if (m_pContext1)
+	{
+		create_buffer();
+	}
+}
+
+void UploadRingD3D11::release()
+{
+	untrack_gpu_resource_d3d11(MemoryTag::kTransient, m_pBuffer);
+	SAFE_RELEASE(m_pBuffer);
+	m_pBuffer = nullptr;
+	SAFE_RELEASE(m_pContext1);
+	m_pContext1 = nullptr;
+
+	for (u32 stage = 0; stage < kStages; ++stage)
+	{
+		for (u32 i = 0; i < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT; ++i)
+		{
+			untrack_gpu_resource_d3d11(MemoryTag::kTransient, m_pFallback[stage][i]);
+			SAFE_RELEASE(m_pFallback[stage][i]);
+			m_pFallback[stage][i] = nullptr;
+			m_fallbackSize[stage][i] = 0;
+		}
+	}
+}
+
+void UploadRingD3D11::create_buffer()
+{
+	untrack_gpu_resource_d3d11(MemoryTag::kTransient, m_pBuffer);
+	SAFE_RELEASE(m_pBuffer);
+	m_pBuffer = nullptr;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = m_ring.capacity();
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT hr = m_pDevice->CreateBuffer(&desc, NULL, &m_pBuffer);
+	ASSERT(!FAILED(hr) && m_pBuffer);
+	track_gpu_resource_d3d11(MemoryTag::kTransient, m_pBuffer);
+}
+
+void UploadRingD3D11::commit()
+{
+	const UploadPlacement placement = m_ring.commit();
+
+	if (!m_pContext1 || !placement.size)
+		return;
+
+	if (placement.grew)
+	{
+		create_buffer();
+	}
+
+	const D3D11_MAP mapType = placement.discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+
+	D3D11_MAPPED_SUBRESOURCE subresource;
+	if (!FAILED(m_pContext->Map(m_pBuffer, 0, mapType, 0, &subresource)))
+	{
+		memcpy((u8*)subresource.pData + placement.base, m_ring.staging(), placement.size);
+		m_pContext->Unmap(m_pBuffer, 0);
+	}
+}
+
+ID3D11Buffer* UploadRingD3D11::fallback_buffer(u32 stage, u32 slot, const UploadAllocation& a)
+{
+	ASSERT(slot < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
+
+	ID3D11Buffer*& rpBuffer = m_pFallback[stage][slot];
+	u32& rSize = m_fallbackSize[stage][slot];
+
+	const u32 size = (a.size + 15) & ~15u;
+	if (rSize < size)
+	{
+		untrack_gpu_resource_d3d11(MemoryTag::kTransient, rpBuffer);
+		SAFE_RELEASE(rpBuffer);
+
+		D3D11_BUFFER_DESC desc = {};
+		desc.ByteWidth = size;
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		HRESULT hr = m_pDevice->CreateBuffer(&desc, NULL, &rpBuffer);
+		ASSERT(!FAILED(hr) && rpBuffer);
+		track_gpu_resource_d3d11(MemoryTag::kTransient, rpBuffer);
+		rSize = size;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE subresource;
+	if (!FAILED(m_pContext->Map(rpBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &subresource)))
+	{
+		memcpy(subresource.pData, m_ring.staging() + a.offset, a.size);
+		m_pContext->Unmap(rpBuffer, 0);
+	}
+	return rpBuffer;
+}
+
+void UploadRingD3D11::bind_vs(u32 slot, const UploadAllocation& a)
+{
+	if (m_pContext1)
+	{
+		const UINT firstConstant = m_ring.ring_offset(a) / 16;
+		const UINT numConstants = ((a.size + kAlignment - 1) & ~(kAlignment - 1)) / 16;
+		m_pContext1->VSSetConstantBuffers1(slot, 1, &m_pBuffer, &firstConstant, &numConstants);
+	}
+	else
+	{
+		ID3D11Buffer* pBuffer = fallback_buffer(0, slot, a);
+		m_pContext->VSSetConstantBuffers(slot, 1, &pBuffer);
+	}
+}
+
+void UploadRingD3D11::bind_ps(u32 slot, const UploadAllocation& a)
+{
+	if (m_pContext1)
+	{
+		const UINT firstConstant = m_ring.ring_offset(a) / 16;
+		const UINT numConstants = ((a.size + kAlignment - 1) & ~(kAlignment - 1)) / 16;
+		m_pContext1->PSSetConstantBuffers1(slot, 1, &m_pBuffer, &firstConstant, &numConstants);
+	}
+	else
+	{
+		ID3D11Buffer* pBuffer = fallback_buffer(1, slot, a);
+		m_pContext->PSSetConstantBuffers(slot, 1, &pBuffer);
+	}
+}
+
+void UploadRingD3D11::bind_cs(u32 slot, const UploadAllocation& a)
+{
+	if (m_pContext1)
+	{
+		const UINT firstConstant = m_ring.ring_offset(a) / 16;
+		const UINT numConstants = ((a.size + kAlignment - 1) & ~(kAlignment - 1)) / 16;
+		m_pContext1->CSSetConstantBuffers1(slot, 1, &m_pBuffer, &firstConstant, &numConstants);
+	}
+	else
+	{
+		ID3D11Buffer* pBuffer = fallback_buffer(2, slot, a);
+		m_pContext->CSSetConstantBuffers(slot, 1, &pBuffer);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CommonHeader.h"
+#include "UploadRing.h"
+
+//================================================================================
+// UploadRingD3D11
+// The frame's constant buffers as blocks of one big dynamic constant buffer,
+// bound with VS/PS/CSSetConstantBuffers1 offsets. commit() writes the whole frame
+// with a single Map, NO_OVERWRITE after the previous frame or DISCARD when the
+// ring wraps.
+//
+// Both need D3D 11.1 (ConstantBufferOffsetting, MapNoOverwriteOnDynamicConstantBuffer).
+// Without them every bind is a WRITE_DISCARD of a small buffer per slot, which
+// is what push_constant_buffer does per draw.
+//================================================================================
+class UploadRingD3D11
+{
+public:
+	// Offsets are in 16 constant (256 byte) steps.
+	static constexpr u32 kAlignment = 256;
+	static constexpr u32 kDefaultCapacity = 1 * (u32)MB;
+
+	UploadRingD3D11() : m_ring(kDefaultCapacity, kAlignment) {}
+	~UploadRingD3D11();
+
+	void init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+	void release();
+
+	void begin_frame() { m_ring.begin_frame(); }
+
+	template<typename ConstantBufferType>
+	UploadAllocation push(const ConstantBufferType& rData) { return m_ring.allocate(&rData, sizeof(ConstantBufferType)); }
+
+	// Writes the frame, after the last push and before the first bind.
+	void commit();
+
+	void bind_vs(u32 slot, const UploadAllocation& a);
+	void bind_ps(u32 slot, const UploadAllocation& a);
+	void bind_cs(u32 slot, const UploadAllocation& a);
+
+	bool offsets_supported() const { return m_pContext1 != nullptr; }
+	const UploadRingStats& stats() const { return m_ring.stats(); }
+	u32 capacity() const { return m_ring.capacity(); }
+
+private:
+	void create_buffer();
+	ID3D11Buffer* fallback_buffer(u32 stage, u32 slot, const UploadAllocation& a);
+
+	UploadRing m_ring;
+
+	ID3D11Device* m_pDevice = nullptr;
+	ID3D11DeviceContext* m_pContext = nullptr;
+	ID3D11DeviceContext1* m_pContext1 = nullptr;
+	ID3D11Buffer* m_pBuffer = nullptr;
+
+	// 11.0 path, one per stage (VS, PS, CS) and slot sized to the biggest block bound there.
+	static constexpr u32 kStages = 3;
+	ID3D11Buffer* m_pFallback[kStages][D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT] = {};
+	u32 m_fallbackSize[kStages][D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT] = {};
+};
@@ -0,0 +1,56 @@
+#include "WorkerPool.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+
+WorkerPool::WorkerPool(u32 workers)
+{
+	if (!workers)
+	{
+		const u32 hardwareThreads = std::thread::hardware_concurrency();
+		workers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	for (u32 i = 0; i < workers; ++i)
+	{
+		m_workers.emplace_back(new JobQueue());
+		m_workers.back()->launch();
+		m_workers.back()->pushJob([i]
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "Worker %u", i + 1);
+			TRACE_THREAD_NAME(name);
+		});
+	}
+}
+
+void WorkerPool::parallel_for(u32 count, u32 minPerRange, const RangeFn& fn)
+{
+	if (!count)
+		return;
+
+	const u32 ranges = std::max(1u, std::min(threads(), count / std::max(minPerRange, 1u)));
+	const u32 perRange = (count + ranges - 1) / ranges;
+
+	for (u32 range = 1; range < ranges; ++range)
+	{
+		const u32 begin = std::min(count, range * perRange);
+		const u32 end = std::min(count, begin + perRange);
+		m_workers[range - 1]->pushJob([&fn, begin, end]
+		{
+			TRACE_SCOPE_CAT("job", "parallel_for");
+			fn(begin, end);
+		});
+	}
+
+	{
+		TRACE_SCOPE_CAT("job", "parallel_for");
+		fn(0, std::min(count, perRange));
+	}
+
+	for (u32 range = 1; range < ranges; ++range)
+	{
+		m_workers[range - 1]->waitAll();
+	}
+}
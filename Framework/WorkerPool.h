@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "FunctionRef.h"
+#include "JobQueue.h"
+
+#include <memory>
+#include <vector>
+
+//================================================================================
+// WorkerPool
+// A fixed set of JobQueue threads for CPU loops that split into independent
+// ranges (image rows / tiles, rays, ...). parallel_for() hands one contiguous
+// range to each worker, runs the first range on the calling thread and blocks
+// until every range is done, the same shape as CommandRecorder::record().
+// Since it blocks, fn is only referenced (FunctionRef), a loop costs no heap
+// allocation however much its lambda captures.
+//================================================================================
+class WorkerPool
+{
+public:
+	using RangeFn = FunctionRef<void(u32 begin, u32 end)>;
+
+	// workers == 0 picks one less than the hardware threads.
+	explicit WorkerPool(u32 workers = 0);
+
+	// fn over [0, count) in at most threads() ranges of at least minPerRange items each.
+	void parallel_for(u32 count, u32 minPerRange, const RangeFn& fn);
+
+	u32 workers() const { return (u32)m_workers.size(); }
+	u32 threads() const { return workers() + 1; }
+
+private:
+	std::vector<std::unique_ptr<JobQueue>> m_workers;
+};
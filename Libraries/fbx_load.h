@@ -37,12 +37,27 @@ bool create_mesh_from_fbx(ID3D11Device* pDevice, Mesh& meshOut, const std::strin
 		return false;
 	}
 
-	std::vector<MeshVertex> vertices;
-	std::vector<u16> indices;
+	TrackedVector<MeshVertex, MemoryTag::kMesh> vertices;
+	TrackedVector<u16, MemoryTag::kMesh> indices;
 	int indexOffset = 0;
 
 	if (scene->HasMeshes())
 	{
+		// Sized up front, growing them a vertex at a time copies the whole scene several times over.
+		size_t vertexCount = 0;
+		size_t indexCount = 0;
+		for (int i = 0; i < scene->mNumMeshes; ++i)
+		{
+			const aiMesh* mesh = scene->mMeshes[i];
+			vertexCount += mesh->mNumVertices;
+			for (int f = 0; f < mesh->mNumFaces; ++f)
+			{
+				indexCount += mesh->mFaces[f].mNumIndices;
+			}
+		}
+		vertices.reserve(vertexCount);
+		indices.reserve(indexCount);
+
 		for (int i = 0; i < scene->mNumMeshes; ++i)
 		{
 			aiMesh* mesh = scene->mMeshes[i];
@@ -86,4 +101,5 @@ bool create_mesh_from_fbx(ID3D11Device* pDevice, Mesh& meshOut, const std::strin
 	}
 
 	meshOut.init_buffers(pDevice, &vertices[0], vertices.size(), &indices[0], indices.size());
+	return true;
 }
\ No newline at end of file
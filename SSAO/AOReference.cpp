@@ -0,0 +1,558 @@
+#include "AOReference.h"
+#include "SSAOKernels.h"
+#include "SeparableBlur.h"
+#include "KawaseBlur.h"
+#include "WorkerPool.h"
+
+using namespace hlsl;
+
+namespace AOReference
+{
+	float3 get_position(const GBuffer& gbuffer, float2 uv, f32& rDepthOut)
+	{
+		const s32 x = std::min(std::max((s32)std::floor(uv.x * gbuffer.width), 0), (s32)gbuffer.width - 1);
+		const s32 y = std::min(std::max((s32)std::floor(uv.y * gbuffer.height), 0), (s32)gbuffer.height - 1);
+		rDepthOut = gbuffer.depth[y * gbuffer.width + x];
+
+		const float2 flipUV(uv.x, 1.f - uv.y);
+
+		float4 clipPos(flipUV.x * 2.f - 1.f, flipUV.y * 2.f - 1.f, rDepthOut, 1.f);
+		float4 viewPos = mul(clipPos, gbuffer.matInverseProjection);
+		viewPos = viewPos / viewPos.w;
+		return mul(viewPos, gbuffer.matInverseView).xyz();
+	}
+
+	float3 get_normal(const GBuffer& gbuffer, float2 uv)
+	{
+		const s32 x = std::min(std::max((s32)std::floor(uv.x * gbuffer.width), 0), (s32)gbuffer.width - 1);
+		const s32 y = std::min(std::max((s32)std::floor(uv.y * gbuffer.height), 0), (s32)gbuffer.height - 1);
+		return normalize(gbuffer.normal[y * gbuffer.width + x]);
+	}
+
+	float2 get_random(u32 x, u32 y)
+	{
+		const u32 mask = SSAOKernels::kNoiseTileSize - 1;
+		const u32 rgba = SSAOKernels::kNoiseTileRGBA[(y & mask) * SSAOKernels::kNoiseTileSize + (x & mask)];
+
+		// .gb * 2 - 1, then normalize as the shader does.
+		const float2 r(((rgba >> 8) & 0xff) / 255.f * 2.f - 1.f, ((rgba >> 16) & 0xff) / 255.f * 2.f - 1.f);
+		const f32 l = std::sqrt(dot(r, r));
+		return l > 0.f ? r / l : r;
+	}
+
+	float2 tile_rotation_4x4(u32 x, u32 y)
+	{
+		const f32* r = SSAOKernels::kTileRotation4x4[(y & 3) * 4 + (x & 3)];
+		return float2(r[0], r[1]);
+	}
+
+	float2 vogel_disk_offset(u32 sampleIndex, float2 rotation, f32 invSqrtTaps)
+	{
+		const f32 r = SSAOKernels::kVogelRadius[sampleIndex] * invSqrtTaps;
+		const f32* dir = SSAOKernels::kGoldenSpiralDir[sampleIndex];
+		return float2(dir[0] * rotation.x - dir[1] * rotation.y, dir[0] * rotation.y + dir[1] * rotation.x) * r;
+	}
+
+	// doSpiralAmbientOcclusion
+	static f32 spiral_tap(const float3& diff, const float3& n, const Params& params)
+	{
+		const f32 l = length(diff);
+		const float3 v = diff / l;
+		const f32 d = l * params.scale;
+
+		f32 val = std::max(0.f, dot(n, v) - params.bias) * (1.f / (1.f + d));
+		val *= smoothstep(params.maxDistance, params.maxDistance * 0.5f, l);
+		return val;
+	}
+
+	// ssao_spiral's pixels, tap j in direction dir(j, rand) (rand the pixel's noise tile rotation).
+	template <typename DirFn>
+	static void spiral_pixels(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool, const DirFn& dir)
+	{
+		out.resize(gbuffer.width, gbuffer.height);
+
+		const f32 inv = 1.f / taps;
+
+		auto rows = [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; ++y)
+			{
+				for (u32 x = 0; x < gbuffer.width; ++x)
+				{
+					const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+					f32 depth;
+					const float3 p = get_position(gbuffer, uv, depth);
+					if (depth >= kClearDepth)
+						continue;	// clip()
+
+					const float3 n = get_normal(gbuffer, uv);
+					const f32 rStep = inv * params.sampleRadius / p.z;
+
+					const float2 rand = get_random(x, y);
+					f32 radius = 0.f;
+					f32 ao = 0.f;
+					bool clipped = false;
+
+					for (u32 j = 0; j < taps && !clipped; ++j)
+					{
+						radius += rStep;
+						const float2 sampleUV = uv + dir(j, rand) * radius;
+
+						f32 sampleDepth;
+						const float3 s = get_position(gbuffer, sampleUV, sampleDepth);
+
+						// The shader clips inside getPosition so a background tap kills the pixel.
+						clipped = sampleDepth >= kClearDepth;
+						ao += spiral_tap(s - p, n, params);
+					}
+
+					out.at(x, y) = clipped ? 0.f : ao * inv;
+				}
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(gbuffer.height, 8, rows);
+		}
+		else
+		{
+			rows(0, gbuffer.height);
+		}
+	}
+
+	// Tap i of a golden angle spiral, what SSAOKernels' tables hold for the first kMaxTaps.
+	static float2 golden_spiral_dir(u32 i)
+	{
+		const f32 angle = i * 2.39996323f;
+		return float2(std::cos(angle), std::sin(angle));
+	}
+
+	void ssao_spiral(const GBuffer& gbuffer, const Params& params, Image& out)
+	{
+		spiral_pixels(gbuffer, params, params.taps(), out, nullptr, [](u32 j, float2 rand)
+		{
+			const f32* dir = SSAOKernels::kGoldenSpiralDir[j];
+			return float2(rand.y * dir[0] + rand.x * dir[1], rand.x * dir[0] - rand.y * dir[1]);
+		});
+	}
+
+	void ssao_spiral_converged(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool)
+	{
+		spiral_pixels(gbuffer, params, taps, out, pPool, [](u32 j, float2) { return golden_spiral_dir(j); });
+	}
+
+	// AlchemyTap
+	static f32 alchemy_tap(const float3& v, const float3& n, f32 viewZ, const Params& params)
+	{
+		const f32 vv = dot(v, v);
+		const f32 falloff = smoothstep(params.maxDistance, params.maxDistance * 0.5f, std::sqrt(vv));
+		return falloff * std::max(0.f, dot(v, n) - params.bias * viewZ) / (vv + 0.001f);
+	}
+
+	// AlchemyRadiusScreen
+	static float2 alchemy_radius_screen(const GBuffer& gbuffer, const Params& params, f32 viewZ)
+	{
+		const float2 radiusScreen = float2(gbuffer.matProjection.m[0][0], gbuffer.matProjection.m[1][1]) * (0.5f * params.maxDistance / viewZ);
+		return radiusScreen * std::min(1.f, params.maxScreenRadius / std::max(radiusScreen.x, radiusScreen.y));
+	}
+
+	// AlchemyRadiusWorld
+	static f32 alchemy_radius_world(const GBuffer& gbuffer, float2 radiusScreen, f32 viewZ)
+	{
+		return 2.f * viewZ * radiusScreen.x / gbuffer.matProjection.m[0][0];
+	}
+
+	// ALCHEMY_RESOLVE_SCALE
+	static const f32 kAlchemyResolveScale = 1.25f;
+
+	// AlchemyResolve, aoSum is already scaled by alchemy_radius_world().
+	static f32 alchemy_resolve(f32 aoSum, u32 taps, const Params& params)
+	{
+		return saturate(kAlchemyResolveScale * params.intensity * aoSum / taps);
+	}
+
+	// ssao_vogel_alchemy's pixels, tap j at offset(j, x, y) on the unit disk.
+	template <typename OffsetFn>
+	static void vogel_alchemy_pixels(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool, const OffsetFn& offset)
+	{
+		out.resize(gbuffer.width, gbuffer.height);
+
+		auto rows = [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; ++y)
+			{
+				for (u32 x = 0; x < gbuffer.width; ++x)
+				{
+					const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+					f32 depth;
+					const float3 p = get_position(gbuffer, uv, depth);
+					if (depth >= kClearDepth)
+						continue;	// clip()
+
+					const float3 n = get_normal(gbuffer, uv);
+					const f32 viewZ = mul(float4(p, 1.f), gbuffer.matView).z;
+					const float2 radiusScreen = alchemy_radius_screen(gbuffer, params, viewZ);
+
+					f32 ao = 0.f;
+					for (u32 j = 0; j < taps; ++j)
+					{
+						const float2 sampleUV = uv + radiusScreen * offset(j, x, y);
+
+						f32 sampleDepth;
+						const float3 s = get_position(gbuffer, sampleUV, sampleDepth);
+						if (sampleDepth < kClearDepth)
+						{
+							ao += alchemy_tap(s - p, n, viewZ, params);
+						}
+					}
+
+					out.at(x, y) = alchemy_resolve(ao * alchemy_radius_world(gbuffer, radiusScreen, viewZ), taps, params);
+				}
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(gbuffer.height, 8, rows);
+		}
+		else
+		{
+			rows(0, gbuffer.height);
+		}
+	}
+
+	void ssao_vogel_alchemy(const GBuffer& gbuffer, const Params& params, Image& out, WorkerPool* pPool)
+	{
+		const f32 invSqrtTaps = 1.f / std::sqrt((f32)params.taps());
+		vogel_alchemy_pixels(gbuffer, params, params.taps(), out, pPool, [invSqrtTaps](u32 j, u32 x, u32 y)
+		{
+			return vogel_disk_offset(j, tile_rotation_4x4(x, y), invSqrtTaps);
+		});
+	}
+
+	void ssao_vogel_alchemy_converged(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool)
+	{
+		const f32 invTaps = 1.f / taps;
+		vogel_alchemy_pixels(gbuffer, params, taps, out, pPool, [invTaps](u32 j, u32, u32)
+		{
+			return golden_spiral_dir(j) * std::sqrt((j + 0.5f) * invTaps);
+		});
+	}
+
+	// AlchemyPoissonTaps
+	static f32 alchemy_poisson_taps(const GBuffer& gbuffer, const Params& params, float2 uv, const float3& p, const float3& n,
+		f32 viewZ, float2 radiusScreen, float2 rotation, u32 first, u32 last)
+	{
+		f32 ao = 0.f;
+		for (u32 j = first; j < last; ++j)
+		{
+			const f32* dir = SSAOKernels::kPoissonDisk[j];
+			const float2 offset(dir[0] * rotation.x - dir[1] * rotation.y, dir[0] * rotation.y + dir[1] * rotation.x);
+
+			f32 sampleDepth;
+			const float3 s = get_position(gbuffer, uv + radiusScreen * offset, sampleDepth);
+			if (sampleDepth < kClearDepth)
+			{
+				ao += alchemy_tap(s - p, n, viewZ, params);
+			}
+		}
+		return ao * alchemy_radius_world(gbuffer, radiusScreen, viewZ);
+	}
+
+	void ssao_adaptive_base(const GBuffer& gbuffer, const Params& params, Image& baseOut)
+	{
+		baseOut.resize(gbuffer.width, gbuffer.height);
+
+		for (u32 y = 0; y < gbuffer.height; ++y)
+		{
+			for (u32 x = 0; x < gbuffer.width; ++x)
+			{
+				const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+				f32 depth;
+				const float3 p = get_position(gbuffer, uv, depth);
+				if (depth >= kClearDepth)
+					continue;	// clip()
+
+				const float3 n = get_normal(gbuffer, uv);
+				const f32 viewZ = mul(float4(p, 1.f), gbuffer.matView).z;
+
+				const f32 ao = alchemy_poisson_taps(gbuffer, params, uv, p, n, viewZ, alchemy_radius_screen(gbuffer, params, viewZ),
+					tile_rotation_4x4(x, y), 0, params.adaptiveBaseTaps);
+				baseOut.at(x, y) = ao / params.adaptiveBaseTaps;
+			}
+		}
+	}
+
+	void ssao_importance(const GBuffer& gbuffer, const Params& params, const Image& base, Image& importanceOut)
+	{
+		importanceOut.resize(gbuffer.width, gbuffer.height);
+
+		const float2 texelUV(1.f / gbuffer.width, 1.f / gbuffer.height);
+		const float2 cross4[4] = { float2(1.f, 0.f), float2(-1.f, 0.f), float2(0.f, 1.f), float2(0.f, -1.f) };
+
+		for (u32 y = 0; y < gbuffer.height; ++y)
+		{
+			for (u32 x = 0; x < gbuffer.width; ++x)
+			{
+				const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+				f32 depth;
+				const float3 p = get_position(gbuffer, uv, depth);
+				if (depth >= kClearDepth)
+					continue;	// clip()
+
+				const f32 viewZ = mul(float4(p, 1.f), gbuffer.matView).z;
+
+				f32 sum = 0.f;
+				f32 sumSq = 0.f;
+				for (s32 dy = -1; dy <= 1; ++dy)
+				{
+					for (s32 dx = -1; dx <= 1; ++dx)
+					{
+						const f32 ao = alchemy_resolve(base.load((s32)x + dx, (s32)y + dy) * params.adaptiveBaseTaps, params.adaptiveBaseTaps, params);
+						sum += ao;
+						sumSq += ao * ao;
+					}
+				}
+				const f32 mean = sum / 9.f;
+				const f32 variance = std::max(0.f, sumSq / 9.f - mean * mean);
+
+				f32 edge = 0.f;
+				for (const float2& d : cross4)
+				{
+					f32 neighbourDepth;
+					const float3 neighbour = get_position(gbuffer, uv + d * texelUV, neighbourDepth);
+					const f32 neighbourZ = mul(float4(neighbour, 1.f), gbuffer.matView).z;
+					edge = std::max(edge, neighbourDepth < kClearDepth ? std::abs(neighbourZ - viewZ) / viewZ : 1.f);
+				}
+
+				// The GPU target is R8_UNORM.
+				const f32 importance = params.importanceVarianceScale * std::sqrt(variance) + params.importanceEdgeScale * edge;
+				importanceOut.at(x, y) = quantise(importance, Storage::kR8_UNORM);
+			}
+		}
+	}
+
+	AdaptiveStats ssao_adaptive(const GBuffer& gbuffer, const Params& params, Image& out, Image* pImportanceOut)
+	{
+		Image base;
+		Image importance;
+		ssao_adaptive_base(gbuffer, params, base);
+		ssao_importance(gbuffer, params, base, importance);
+
+		out.resize(gbuffer.width, gbuffer.height);
+
+		AdaptiveStats stats;
+		stats.fixedTaps = params.taps();
+		stats.minTaps = ~0u;
+
+		const u32 maxTaps = std::max(params.taps(), params.adaptiveBaseTaps);
+
+		for (u32 y = 0; y < gbuffer.height; ++y)
+		{
+			for (u32 x = 0; x < gbuffer.width; ++x)
+			{
+				const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+				f32 depth;
+				const float3 p = get_position(gbuffer, uv, depth);
+				if (depth >= kClearDepth)
+					continue;	// clip()
+
+				const float3 n = get_normal(gbuffer, uv);
+				const f32 viewZ = mul(float4(p, 1.f), gbuffer.matView).z;
+
+				const u32 taps = params.adaptiveBaseTaps + (u32)std::round(importance.at(x, y) * (maxTaps - params.adaptiveBaseTaps));
+
+				f32 ao = base.at(x, y) * params.adaptiveBaseTaps;
+				ao += alchemy_poisson_taps(gbuffer, params, uv, p, n, viewZ, alchemy_radius_screen(gbuffer, params, viewZ),
+					tile_rotation_4x4(x, y), params.adaptiveBaseTaps, taps);
+				out.at(x, y) = alchemy_resolve(ao, taps, params);
+
+				++stats.shadedPixels;
+				stats.totalTaps += taps;
+				stats.minTaps = std::min(stats.minTaps, taps);
+				stats.maxTaps = std::max(stats.maxTaps, taps);
+			}
+		}
+
+		if (stats.shadedPixels == 0)
+		{
+			stats.minTaps = 0;
+		}
+
+		if (pImportanceOut)
+		{
+			*pImportanceOut = std::move(importance);
+		}
+
+		return stats;
+	}
+
+	f32 quantise(f32 v, Storage storage)
+	{
+		switch (storage)
+		{
+		case Storage::kR8_UNORM:
+			return std::round(saturate(v) * 255.f) / 255.f;
+
+		case Storage::kR16_FLOAT:
+		{
+			// 11 significant bits, subnormal below 2^-14 with a fixed 2^-24 step. AO never gets near the top of the range.
+			const f32 a = std::min(std::abs(v), 65504.f);
+			if (a < 6.10351562e-5f)
+			{
+				return std::copysign(std::nearbyint(a * 16777216.f) / 16777216.f, v);
+			}
+			int exponent;
+			const f32 mantissa = std::frexp(a, &exponent);
+			return std::copysign(std::ldexp(std::nearbyint(mantissa * 2048.f), exponent - 11), v);
+		}
+
+		case Storage::kFloat:
+		default:
+			return v;
+		}
+	}
+
+	void quantise(Image& image, Storage storage)
+	{
+		for (f32& t : image.texels)
+		{
+			t = quantise(t, storage);
+		}
+	}
+
+	ImageError compare(const Image& reference, const Image& test)
+	{
+		ASSERT(reference.width == test.width && reference.height == test.height);
+
+		ImageError error;
+		f64 sumSq = 0.0;
+		for (size_t i = 0; i < reference.texels.size(); ++i)
+		{
+			const f32 d = std::abs(reference.texels[i] - test.texels[i]);
+			error.maxAbs = std::max(error.maxAbs, d);
+			sumSq += (f64)d * d;
+		}
+		error.rms = reference.texels.empty() ? 0.f : (f32)std::sqrt(sumSq / reference.texels.size());
+		return error;
+	}
+
+	// Discrete weights of the shaders' 5 fetch kernel, each linear fetch covers two of them.
+	static const f32 kGauss9Weights[5] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
+
+	static void gauss_9(const Image& in, Image& out, s32 stepX, s32 stepY)
+	{
+		out.resize(in.width, in.height);
+
+		for (u32 y = 0; y < in.height; ++y)
+		{
+			for (u32 x = 0; x < in.width; ++x)
+			{
+				f32 sum = in.at(x, y) * kGauss9Weights[0];
+				for (s32 i = 1; i < 5; ++i)
+				{
+					sum += in.load((s32)x + i * stepX, (s32)y + i * stepY) * kGauss9Weights[i];
+					sum += in.load((s32)x - i * stepX, (s32)y - i * stepY) * kGauss9Weights[i];
+				}
+				out.at(x, y) = sum;
+			}
+		}
+	}
+
+	void gauss_9_x(const Image& in, Image& out)
+	{
+		gauss_9(in, out, 1, 0);
+	}
+
+	void gauss_9_y(const Image& in, Image& out)
+	{
+		gauss_9(in, out, 0, 1);
+	}
+
+	void denoise_4x4(const Image& in, Image& out)
+	{
+		out.resize(in.width, in.height);
+
+		for (u32 y = 0; y < in.height; ++y)
+		{
+			for (u32 x = 0; x < in.width; ++x)
+			{
+				f32 sum = 0.f;
+				for (s32 dy = -2; dy < 2; ++dy)
+				{
+					for (s32 dx = -2; dx < 2; ++dx)
+					{
+						sum += in.load((s32)x + dx, (s32)y + dy);
+					}
+				}
+				out.at(x, y) = sum * (1.f / 16.f);
+			}
+		}
+	}
+
+	StorageError blur_storage_error(const Image& ao, BlurChain chain, u32 iterations
+		, Storage aoStorage, Storage blurStorage, Storage outputStorage
+		, const BlurKernel* pFusedKernel, WorkerPool* pPool)
+	{
+		StorageError error;
+
+		Image reference = ao;
+		Image quantised = ao;
+		quantise(quantised, aoStorage);
+		error.ao = compare(reference, quantised);
+
+		// Each pass reads the previous target and writes the next, only the quantised chain rounds.
+		ASSERT(chain != BlurChain::kFused || pFusedKernel);
+		u32 passes = 1;
+		if (chain == BlurChain::kFastGauss || chain == BlurChain::kDualFilter)
+		{
+			passes = iterations * 2;
+		}
+		Image scratch;
+		for (u32 pass = 0; pass < passes; ++pass)
+		{
+			const Storage storage = pass + 1 == passes ? outputStorage : blurStorage;
+			for (Image* pImage : { &reference, &quantised })
+			{
+				if (chain == BlurChain::kDenoise4x4)
+				{
+					denoise_4x4(*pImage, scratch);
+				}
+				else if (chain == BlurChain::kFused)
+				{
+					scratch.resize(pImage->width, pImage->height);
+					blur_fused(pImage->texels.data(), scratch.texels.data(), pImage->width, pImage->height, *pFusedKernel, pPool);
+				}
+				else if (chain == BlurChain::kDualFilter)
+				{
+					// Down into level pass + 1, then back up into level passes - pass - 1.
+					const u32 level = pass < iterations ? pass + 1 : passes - pass - 1;
+					scratch.resize(dual_filter_level_size(ao.width, level), dual_filter_level_size(ao.height, level));
+					if (pass < iterations)
+						dual_filter_down(pImage->texels.data(), pImage->width, pImage->height, scratch.texels.data(), scratch.width, scratch.height, pPool);
+					else
+						dual_filter_up(pImage->texels.data(), pImage->width, pImage->height, scratch.texels.data(), scratch.width, scratch.height, pPool);
+				}
+				else if (pass & 1)
+				{
+					gauss_9_y(*pImage, scratch);
+				}
+				else
+				{
+					gauss_9_x(*pImage, scratch);
+				}
+				std::swap(*pImage, scratch);
+			}
+			quantise(quantised, storage);
+		}
+
+		error.blurred = compare(reference, quantised);
+		return error;
+	}
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "ShaderMath.h"
+
+#include <vector>
+
+struct BlurKernel;
+class WorkerPool;
+
+//================================================================================
+// CPU reference implementations of the SSAO shaders.
+// Each function mirrors a pixel shader in SSAOShaders.fx one pixel at a time so
+// results can be checked / compared offline without a GPU.
+// Differences to the GPU path: depth is point sampled and uvs are clamped.
+//================================================================================
+namespace AOReference
+{
+	using hlsl::float2;
+	using hlsl::float3;
+	using hlsl::float4x4;
+
+	// Single channel float image, matches the single channel AO targets.
+	struct Image
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<f32> texels;
+
+		void resize(u32 w, u32 h, f32 fill = 0.f)
+		{
+			width = w;
+			height = h;
+			texels.assign(w * h, fill);
+		}
+
+		f32& at(u32 x, u32 y) { return texels[y * width + x]; }
+		f32 at(u32 x, u32 y) const { return texels[y * width + x]; }
+
+		// Clamp-to-edge load.
+		f32 load(s32 x, s32 y) const
+		{
+			x = std::min(std::max(x, 0), (s32)width - 1);
+			y = std::min(std::max(y, 0), (s32)height - 1);
+			return texels[y * width + x];
+		}
+	};
+
+	// CPU copy of the G-buffer plus the PerFrameCB matrices the SSAO shaders read.
+	// Matrices are the un-transposed m4x4 values (see ShaderMath.h).
+	struct GBuffer
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<f32> depth;		// hardware depth, >= kClearDepth means nothing was drawn.
+		std::vector<float3> normal;	// world space normals.
+
+		float4x4 matProjection = float4x4::identity();
+		float4x4 matView = float4x4::identity();
+		float4x4 matInverseProjection = float4x4::identity();
+		float4x4 matInverseView = float4x4::identity();
+
+		void resize(u32 w, u32 h)
+		{
+			width = w;
+			height = h;
+			depth.assign(w * h, 1.f);
+			normal.assign(w * h, float3(0.f, 1.f, 0.f));
+		}
+	};
+
+	constexpr f32 kClearDepth = 0.99999f;
+
+	// How an AO / blur target stores its texels. Conversions round to nearest like the
+	// hardware's, R8_UNORM clamps to [0, 1].
+	enum class Storage : u8
+	{
+		kFloat,
+		kR16_FLOAT,
+		kR8_UNORM,
+	};
+
+	f32 quantise(f32 v, Storage storage);
+	void quantise(Image& image, Storage storage);
+
+	struct ImageError
+	{
+		f32 maxAbs = 0.f;
+		f32 rms = 0.f;
+
+		// In R8 steps, the unit the error is easiest to judge in.
+		f32 max_steps() const { return maxAbs * 255.f; }
+		f32 rms_steps() const { return rms * 255.f; }
+	};
+
+	ImageError compare(const Image& reference, const Image& test);
+
+	// Mirrors SSAOCBData.
+	struct Params
+	{
+		f32 sampleRadius = 0.1f;
+		f32 intensity = 2.0f;
+		f32 scale = 0.121f;
+		f32 bias = 0.01f;
+		u32 samples = 2;			// taps are samples * 4, as in the shaders. At most SSAOKernels::kMaxTaps.
+		f32 maxDistance = 2.0f;
+		f32 maxScreenRadius = 0.1f;
+		u32 adaptiveBaseTaps = 4;			// ssao_adaptive, taps every pixel pays.
+		f32 importanceVarianceScale = 4.0f;	// ssao_adaptive, weight of the local AO std deviation.
+		f32 importanceEdgeScale = 8.0f;		// ssao_adaptive, weight of the relative depth step.
+
+		u32 taps() const { return samples * 4; }
+	};
+
+	// Tap counts spent by ssao_adaptive, over the pixels that weren't clipped.
+	struct AdaptiveStats
+	{
+		u64 shadedPixels = 0;
+		u64 totalTaps = 0;
+		u32 minTaps = 0;
+		u32 maxTaps = 0;
+		u32 fixedTaps = 0;		// what every pixel pays with the non adaptive techniques.
+
+		f32 average_taps() const { return shadedPixels ? (f32)totalTaps / shadedPixels : 0.f; }
+	};
+
+	// Shader helpers.
+	float3 get_position(const GBuffer& gbuffer, float2 uv, f32& rDepthOut);
+	float3 get_normal(const GBuffer& gbuffer, float2 uv);
+	float2 get_random(u32 x, u32 y);			// blue noise tile rotation (cos, sin).
+	float2 tile_rotation_4x4(u32 x, u32 y);		// kTileRotation4x4 (cos, sin).
+	float2 vogel_disk_offset(u32 sampleIndex, float2 rotation, f32 invSqrtTaps);
+
+	// PS_SSAO_02 - spiral kernel.
+	void ssao_spiral(const GBuffer& gbuffer, const Params& params, Image& out);
+
+	// PS_SSAO_04 - vogel disk + alchemy estimator. Rows are shared out over pPool when there is one.
+	void ssao_vogel_alchemy(const GBuffer& gbuffer, const Params& params, Image& out, WorkerPool* pPool = nullptr);
+
+	// What PS_SSAO_02 / PS_SSAO_04 converge to with more taps: the same taps and resolve at any tap
+	// count, the kernel generated (golden angle directions, sqrt(i + 0.5) radii as in SSAOKernels)
+	// and not rotated per pixel. Calibrations report their ground truth error as the estimator's bias,
+	// what is left once the sampling noise of a few taps is gone.
+	void ssao_spiral_converged(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool = nullptr);
+	void ssao_vogel_alchemy_converged(const GBuffer& gbuffer, const Params& params, u32 taps, Image& out, WorkerPool* pPool = nullptr);
+
+	// PS_SSAO_ADAPTIVE_BASE - raw mean of the first adaptiveBaseTaps poisson taps.
+	void ssao_adaptive_base(const GBuffer& gbuffer, const Params& params, Image& baseOut);
+
+	// PS_SSAO_IMPORTANCE - AO variance and depth edges, quantised like the R8 target.
+	void ssao_importance(const GBuffer& gbuffer, const Params& params, const Image& base, Image& importanceOut);
+
+	// All three adaptive passes ending with PS_SSAO_ADAPTIVE. Returns how many taps were spent.
+	AdaptiveStats ssao_adaptive(const GBuffer& gbuffer, const Params& params, Image& out, Image* pImportanceOut = nullptr);
+
+	// PS_BLUR_GAUSS_X / PS_BLUR_GAUSS_Y, the 5 linear fetches as the 9 discrete taps they add up to.
+	void gauss_9_x(const Image& in, Image& out);
+	void gauss_9_y(const Image& in, Image& out);
+
+	// PS_BLUR_DENOISE_4X4.
+	void denoise_4x4(const Image& in, Image& out);
+
+	enum class BlurChain : u8
+	{
+		kFastGauss,		// iterations of gauss_9_x then gauss_9_y.
+		kDenoise4x4,
+		kFused,			// CS_BLUR_FUSED with the given kernel, one pass so one rounding.
+		kDualFilter,	// PS_BLUR_DUAL_DOWN / _UP, iterations levels down and back up.
+	};
+
+	struct StorageError
+	{
+		ImageError ao;			// the AO target against f32 AO.
+		ImageError blurred;		// the end of the quantised blur chain against the f32 chain.
+	};
+
+	// Runs ao through the blur chain twice, once in f32 and once quantising every target
+	// like the GPU's (aoStorage for the AO, blurStorage between passes, outputStorage for
+	// the last pass) and reports how far apart they end up. kFused needs pFusedKernel, pPool is optional.
+	StorageError blur_storage_error(const Image& ao, BlurChain chain, u32 iterations
+		, Storage aoStorage, Storage blurStorage, Storage outputStorage
+		, const BlurKernel* pFusedKernel = nullptr, WorkerPool* pPool = nullptr);
+}
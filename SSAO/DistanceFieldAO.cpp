@@ -0,0 +1,90 @@
+#include "DistanceFieldAO.h"
+#include "DistanceField.h"
+#include "WorkerPool.h"
+
+#include <cmath>
+
+using namespace hlsl;
+
+namespace DistanceFieldAO
+{
+	Constants constants(const DistanceField& field, const Params& params, f32 weight)
+	{
+		Constants c = {};
+		c.boundsMin = field.bounds_min();
+		c.maxDistance = params.maxDistance;
+		c.invExtent = float3(1.f / (field.size(0) * field.voxel_size()), 1.f / (field.size(1) * field.voxel_size()), 1.f / (field.size(2) * field.voxel_size()));
+		c.surfaceBias = params.surfaceBias > 0.f ? params.surfaceBias : field.voxel_size();
+		c.steps = (s32)params.steps;
+		c.weight = weight;
+		return c;
+	}
+
+	f32 occlusion(const DistanceField& field, const float3& p, const float3& n, const Params& params)
+	{
+		// Same basis as the shader (Duff et al. 2017).
+		const f32 s = n.z >= 0.f ? 1.f : -1.f;
+		const f32 a = -1.f / (s + n.z);
+		const f32 b = n.x * n.y * a;
+		const float3 t(1.f + s * n.x * n.x * a, s * b, -s * n.x);
+		const float3 bt(b, s + n.y * n.y * a, -n.y);
+
+		const f32 sinTilt = std::sin(kConeTilt);
+		const f32 cosTilt = std::cos(kConeTilt);
+		const float3 directions[kCones] = { n, t * sinTilt + n * cosTilt, t * -sinTilt + n * cosTilt, bt * sinTilt + n * cosTilt, bt * -sinTilt + n * cosTilt };
+		const f32 weights[kCones] = { 1.f, cosTilt, cosTilt, cosTilt, cosTilt };
+
+		const f32 bias = params.surfaceBias > 0.f ? params.surfaceBias : field.voxel_size();
+		const float3 origin = p + n * bias;
+		const f32 invSteps = 1.f / params.steps;
+
+		f32 visibility = 0.f;
+		f32 weightSum = 0.f;
+		for (u32 c = 0; c < kCones; ++c)
+		{
+			f32 cone = 1.f;
+			for (u32 i = 0; i < params.steps; ++i)
+			{
+				const f32 k = (i + 1) * invSteps;
+				const f32 distance = params.maxDistance * k * k;
+				const f32 d = field.sample(origin + directions[c] * distance);
+				cone = std::min(cone, saturate(d / (distance * kConeTanHalfAngle)));
+			}
+			visibility += cone * weights[c];
+			weightSum += weights[c];
+		}
+		return 1.f - visibility / weightSum;
+	}
+
+	void render(const AOReference::GBuffer& gbuffer, const DistanceField& field, const Params& params, AOReference::Image& out, WorkerPool* pPool)
+	{
+		out.resize(gbuffer.width, gbuffer.height);
+
+		auto rows = [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; ++y)
+			{
+				for (u32 x = 0; x < gbuffer.width; ++x)
+				{
+					const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+					f32 depth;
+					const float3 p = AOReference::get_position(gbuffer, uv, depth);
+					if (depth >= AOReference::kClearDepth)
+						continue;
+
+					out.at(x, y) = occlusion(field, p, AOReference::get_normal(gbuffer, uv), params);
+				}
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(gbuffer.height, 4, rows);
+		}
+		else
+		{
+			rows(0, gbuffer.height);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AOReference.h"
+
+class DistanceField;
+class WorkerPool;
+
+//================================================================================
+// Distance Field AO
+// CPU reference of distance_field_ao() in DeferredShaders.fx: ambient obscurance
+// of the static geometry baked into a DistanceField, from a few volume fetches
+// per pixel instead of screen space taps, so it has no screen edge or
+// disocclusion artifacts.
+//
+// kCones cones cover the hemisphere (one along the normal, a ring of four
+// tilted kConeTilt away). Each steps out to maxDistance, a cone's visibility is
+// the least distance / cone radius over its steps, and the cones are averaged
+// with cosine weights. The lighting pass takes the min of this and the SSAO.
+//================================================================================
+namespace DistanceFieldAO
+{
+	using hlsl::float3;
+
+	constexpr u32 kCones = 5;
+	constexpr f32 kConeTilt = 1.0471976f;		// 60 degrees.
+	constexpr f32 kConeTanHalfAngle = 0.6f;		// ~31 degrees, the five overlap a little.
+
+	struct Params
+	{
+		f32 maxDistance = 4.f;		// world units, keep it within the field's padding.
+		u32 steps = 4;				// per cone, squared spacing so the near ones are dense.
+		f32 surfaceBias = 0.f;		// origin offset along the normal, world units. 0 = one voxel.
+	};
+
+	// DistanceFieldCB (b4), what the app uploads for the lighting pass.
+	struct Constants
+	{
+		float3 boundsMin;
+		f32 maxDistance;
+		float3 invExtent;		// world to uvw.
+		f32 surfaceBias;
+		s32 steps;
+		f32 weight;				// 0 = off.
+		f32 padding[2];
+	};
+
+	Constants constants(const DistanceField& field, const Params& params, f32 weight);
+
+	// Obscurance at world position p with unit normal n, 0 open to 1 closed.
+	f32 occlusion(const DistanceField& field, const float3& p, const float3& n, const Params& params);
+
+	// occlusion() for every drawn pixel of gbuffer, 0 elsewhere like the AO targets. Rows over pPool.
+	void render(const AOReference::GBuffer& gbuffer, const DistanceField& field, const Params& params, AOReference::Image& out, WorkerPool* pPool = nullptr);
+}
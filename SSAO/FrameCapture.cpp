@@ -0,0 +1,139 @@
+#include "FrameCapture.h"
+#include "GBufferEncoding.h"
+#include "WorkerPool.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace FrameCapture
+{
+	static u64 align_up(u64 offset)
+	{
+		return (offset + kAlignment - 1) & ~(u64)(kAlignment - 1);
+	}
+
+	bool save(const char* pPath, const Frame& frame)
+	{
+		ASSERT(frame.pDepth && frame.pNormal && frame.pColourSpec);
+
+		const u64 planeBytes = (u64)frame.width * frame.height * sizeof(u32);
+		const void* pSources[(u32)Section::kCount] = { frame.pDepth, frame.pNormal, frame.pColourSpec, &frame.perFrame, &frame.ssao };
+		const u64 sizes[(u32)Section::kCount] = { planeBytes, planeBytes, planeBytes, sizeof(frame.perFrame), sizeof(frame.ssao) };
+
+		Header header = {};
+		memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version = kVersion;
+		header.width = frame.width;
+		header.height = frame.height;
+		header.sectionCount = (u32)Section::kCount;
+
+		u64 offset = align_up(sizeof(Header));
+		for (u32 s = 0; s < (u32)Section::kCount; ++s)
+		{
+			header.sections[s].offset = offset;
+			header.sections[s].bytes = sizes[s];
+			header.sections[s].rowPitch = s <= (u32)Section::kColourSpec ? frame.width * (u32)sizeof(u32) : 0;
+			offset = align_up(offset + sizes[s]);
+		}
+
+		std::ofstream out(pPath, std::ios::binary);
+		if (!out)
+			return false;
+
+		static const char kZeros[kAlignment] = {};
+		out.write((const char*)&header, sizeof(header));
+		u64 written = sizeof(header);
+		for (u32 s = 0; s < (u32)Section::kCount; ++s)
+		{
+			out.write(kZeros, (std::streamsize)(header.sections[s].offset - written));
+			out.write((const char*)pSources[s], (std::streamsize)sizes[s]);
+			written = header.sections[s].offset + sizes[s];
+		}
+		// Pad the last section too, so every section is whole pages.
+		out.write(kZeros, (std::streamsize)(align_up(written) - written));
+		return (bool)out;
+	}
+
+	bool Replay::open(const char* pPath)
+	{
+		close();
+		if (!m_file.open(pPath))
+			return false;
+
+		const Header* pHeader = (const Header*)m_file.data();
+		bool valid = m_file.size() >= sizeof(Header) && !memcmp(pHeader->magic, kMagic, sizeof(kMagic)) && pHeader->version == kVersion
+			&& pHeader->sectionCount >= (u32)Section::kCount && pHeader->width && pHeader->height;
+
+		const u64 planeBytes = valid ? (u64)pHeader->width * pHeader->height * sizeof(u32) : 0;
+		const u64 sizes[(u32)Section::kCount] = { planeBytes, planeBytes, planeBytes, sizeof(SSAOFrame::PerFrameConstants), sizeof(SSAOFrame::SSAOConstants) };
+		for (u32 s = 0; valid && s < (u32)Section::kCount; ++s)
+		{
+			const SectionEntry& entry = pHeader->sections[s];
+			valid = entry.offset % kAlignment == 0 && entry.bytes == sizes[s] && entry.offset + entry.bytes <= m_file.size();
+		}
+
+		if (!valid)
+		{
+			m_file.close();
+			return false;
+		}
+		m_pHeader = pHeader;
+		return true;
+	}
+
+	void Replay::close()
+	{
+		m_pHeader = nullptr;
+		m_file.close();
+	}
+
+	AOReference::Params Replay::params() const
+	{
+		const SSAOFrame::SSAOConstants& c = ssao();
+		AOReference::Params params;
+		params.sampleRadius = c.sampleRadius;
+		params.intensity = c.intensity;
+		params.scale = c.scale;
+		params.bias = c.bias;
+		params.samples = (u32)c.samples;
+		params.maxDistance = c.maxDistance;
+		params.maxScreenRadius = c.maxScreenRadius;
+		params.adaptiveBaseTaps = (u32)c.adaptiveBaseTaps;
+		params.importanceVarianceScale = c.importanceVarianceScale;
+		params.importanceEdgeScale = c.importanceEdgeScale;
+		return params;
+	}
+
+	void Replay::decode(AOReference::GBuffer& gbuffer, WorkerPool* pPool) const
+	{
+		const u32 w = width();
+		const u32 h = height();
+		gbuffer.resize(w, h);
+
+		const SSAOFrame::PerFrameConstants& perFrame = per_frame();
+		gbuffer.matProjection = perFrame.matProjection;
+		gbuffer.matView = perFrame.matView;
+		gbuffer.matInverseProjection = perFrame.matInverseProjection;
+		gbuffer.matInverseView = perFrame.matInverseView;
+
+		const u32* pDepth = depth();
+		const u32* pNormal = normal();
+		auto rows = [&](u32 begin, u32 end)
+		{
+			for (size_t i = (size_t)begin * w; i < (size_t)end * w; ++i)
+			{
+				gbuffer.depth[i] = (pDepth[i] & 0xFFFFFF) / 16777215.f;
+				gbuffer.normal[i] = GBufferEncoding::unpack_normal(pNormal[i]);
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(h, 16, rows);
+		}
+		else
+		{
+			rows(0, h);
+		}
+	}
+}
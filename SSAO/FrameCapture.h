@@ -0,0 +1,104 @@
+#pragma once
+
+#include "AOReference.h"
+#include "MappedFile.h"
+#include "SSAOFrame.h"
+
+class WorkerPool;
+
+//================================================================================
+// Frame Capture
+// One frame of the app's G-buffer and constants in a single file, so a frame
+// seen in the field can be replayed offline by the CPU ports of the passes
+// (AOReference, blur_fused, SSAOFrameCPU) and kept as a benchmark.
+//
+// Layout: a Header, then one section per Section id at a kAlignment (page)
+// aligned offset. The planes are the targets' texels exactly as the GPU holds
+// them, width * height u32s in tightly packed rows: D24S8 depth, RG16_SNORM
+// octahedral normals (GBufferEncoding) and RGBA8 colour + baked visibility.
+// The constants are SSAOFrame's mirrors of PerFrameCB (matrices un-transposed)
+// and SSAOCB. Little endian, as written.
+//
+// Replay maps the file (MappedFile) and hands out pointers straight into it,
+// so opening a capture costs nothing until the texels are read.
+//================================================================================
+namespace FrameCapture
+{
+	constexpr char kMagic[4] = { 'S', 'S', 'F', 'C' };
+	constexpr u32 kVersion = 1;
+	constexpr u32 kAlignment = 4096;
+
+	enum class Section : u32
+	{
+		kDepth,
+		kNormal,
+		kColourSpec,
+		kPerFrame,
+		kSSAO,
+		kCount
+	};
+
+	struct SectionEntry
+	{
+		u64 offset;			// from the start of the file, a multiple of kAlignment.
+		u64 bytes;
+		u32 rowPitch;		// planes only, bytes between rows.
+		u32 padding;
+	};
+
+	struct Header
+	{
+		char magic[4];
+		u32 version;
+		u32 width;
+		u32 height;
+		u32 sectionCount;
+		u32 padding[3];
+		SectionEntry sections[(u32)Section::kCount];
+	};
+
+	// What save() writes, the planes width * height texels each.
+	struct Frame
+	{
+		u32 width = 0;
+		u32 height = 0;
+		const u32* pDepth = nullptr;		// D24S8, depth in the low 24 bits.
+		const u32* pNormal = nullptr;		// RG16_SNORM, GBufferEncoding::pack_normal().
+		const u32* pColourSpec = nullptr;	// RGBA8, GBufferEncoding::pack_albedo_spec().
+		SSAOFrame::PerFrameConstants perFrame = {};
+		SSAOFrame::SSAOConstants ssao = {};
+	};
+
+	bool save(const char* pPath, const Frame& frame);
+
+	class Replay
+	{
+	public:
+		// Maps pPath and checks the header and every section fits. False leaves nothing open.
+		bool open(const char* pPath);
+		void close();
+
+		bool is_open() const { return m_pHeader != nullptr; }
+		u32 width() const { return m_pHeader->width; }
+		u32 height() const { return m_pHeader->height; }
+
+		// Straight into the mapping, valid until close().
+		const u32* depth() const { return (const u32*)section(Section::kDepth); }
+		const u32* normal() const { return (const u32*)section(Section::kNormal); }
+		const u32* colour_spec() const { return (const u32*)section(Section::kColourSpec); }
+		const SSAOFrame::PerFrameConstants& per_frame() const { return *(const SSAOFrame::PerFrameConstants*)section(Section::kPerFrame); }
+		const SSAOFrame::SSAOConstants& ssao() const { return *(const SSAOFrame::SSAOConstants*)section(Section::kSSAO); }
+
+		// The captured SSAOCB as the CPU reference's params.
+		AOReference::Params params() const;
+
+		// Depth and normals decoded like the shaders read them, matrices from the PerFrameCB. Rows over pPool.
+		void decode(AOReference::GBuffer& gbuffer, WorkerPool* pPool = nullptr) const;
+
+	private:
+		const u8* section(Section s) const { return m_file.data() + m_pHeader->sections[(u32)s].offset; }
+
+		MappedFile m_file;
+		const Header* m_pHeader = nullptr;
+	};
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ShaderMath.h"
+
+#include <cmath>
+
+//================================================================================
+// CPU side of the packed G-buffer, see Assets/Shaders/GBufferEncoding.hlsli.
+// The encode / decode functions are the shader's own source compiled as C++, the
+// pack / unpack helpers here add the UNORM / SNORM conversions the hardware does
+// on write and read so CPU references see exactly what the shaders see.
+//================================================================================
+namespace hlsl
+{
+	using std::abs;
+
+	#include "../Assets/Shaders/GBufferEncoding.hlsli"
+}
+
+namespace GBufferEncoding
+{
+	using hlsl::float2;
+	using hlsl::float3;
+	using hlsl::float4;
+
+	// D3D float -> SNORM / UNORM conversion, round to nearest.
+	inline s16 to_snorm16(f32 v) { return (s16)std::lround(std::min(std::max(v, -1.f), 1.f) * 32767.f); }
+	inline f32 from_snorm16(s16 v) { return std::max(v / 32767.f, -1.f); }
+	inline u8 to_unorm8(f32 v) { return (u8)std::lround(hlsl::saturate(v) * 255.f); }
+	inline f32 from_unorm8(u8 v) { return v / 255.f; }
+
+	// One RG16_SNORM texel, x in the low 16 bits like the texture memory.
+	inline u32 pack_normal(const float3& n)
+	{
+		const float2 e = hlsl::encode_normal_oct(n);
+		return (u16)to_snorm16(e.x) | ((u32)(u16)to_snorm16(e.y) << 16);
+	}
+
+	inline float3 unpack_normal(u32 texel)
+	{
+		return hlsl::decode_normal_oct(float2(from_snorm16((s16)(texel & 0xFFFF)), from_snorm16((s16)(texel >> 16))));
+	}
+
+	// One RGBA8_UNORM texel, r in the low byte.
+	inline u32 pack_albedo_spec(const float4& c)
+	{
+		return to_unorm8(c.x) | (to_unorm8(c.y) << 8) | (to_unorm8(c.z) << 16) | ((u32)to_unorm8(c.w) << 24);
+	}
+
+	inline float4 unpack_albedo_spec(u32 texel)
+	{
+		return float4(from_unorm8(texel & 0xFF), from_unorm8((texel >> 8) & 0xFF), from_unorm8((texel >> 16) & 0xFF), from_unorm8(texel >> 24));
+	}
+
+	struct RoundTripError
+	{
+		f32 normalMaxDegrees = 0.f;
+		f32 normalMeanDegrees = 0.f;
+		f32 albedoMax = 0.f;		// largest absolute error of any channel.
+	};
+
+	// Packs and unpacks a Fibonacci sphere of normals (poles and fold edges included) and
+	// every 8 bit ramp value. 16 bit octahedral should stay under ~0.004 degrees, albedo
+	// under half a step.
+	inline RoundTripError round_trip_error(u32 normalSamples = 65536)
+	{
+		RoundTripError error;
+
+		const float3 axes[] = { float3(1.f, 0.f, 0.f), float3(-1.f, 0.f, 0.f), float3(0.f, 1.f, 0.f), float3(0.f, -1.f, 0.f), float3(0.f, 0.f, 1.f), float3(0.f, 0.f, -1.f) };
+		f64 sum = 0.0;
+		const auto check = [&](const float3& n)
+		{
+			// atan2 rather than acos, acos of a float dot can't resolve thousandths of a degree.
+			const float3 d = unpack_normal(pack_normal(n));
+			const f32 degrees = std::atan2(hlsl::length(hlsl::cross(n, d)), hlsl::dot(n, d)) * (180.f / 3.14159265f);
+			error.normalMaxDegrees = std::max(error.normalMaxDegrees, degrees);
+			sum += degrees;
+		};
+
+		for (const float3& n : axes)
+		{
+			check(n);
+		}
+
+		const f32 goldenAngle = 2.39996323f;
+		for (u32 i = 0; i < normalSamples; ++i)
+		{
+			const f32 z = 1.f - (2.f * i + 1.f) / normalSamples;
+			const f32 r = std::sqrt(std::max(1.f - z * z, 0.f));
+			const f32 phi = goldenAngle * i;
+			check(hlsl::normalize(float3(r * std::cos(phi), r * std::sin(phi), z)));
+		}
+		error.normalMeanDegrees = (f32)(sum / (normalSamples + 6));
+
+		for (u32 i = 0; i < 1024; ++i)
+		{
+			const f32 v = i / 1023.f;
+			const float4 c = unpack_albedo_spec(pack_albedo_spec(float4(v, v, v, v)));
+			error.albedoMax = std::max(error.albedoMax, std::abs(c.x - v));
+		}
+
+		return error;
+	}
+}
@@ -0,0 +1,272 @@
+#include "GroundTruthAO.h"
+#include "BVH.h"
+#include "WorkerPool.h"
+
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+using namespace hlsl;
+
+namespace GroundTruthAO
+{
+	// Van der Corput in base 2, the second Hammersley coordinate.
+	static f32 radical_inverse(u32 i)
+	{
+		i = (i << 16) | (i >> 16);
+		i = ((i & 0x55555555u) << 1) | ((i & 0xAAAAAAAAu) >> 1);
+		i = ((i & 0x33333333u) << 2) | ((i & 0xCCCCCCCCu) >> 2);
+		i = ((i & 0x0F0F0F0Fu) << 4) | ((i & 0xF0F0F0F0u) >> 4);
+		i = ((i & 0x00FF00FFu) << 8) | ((i & 0xFF00FF00u) >> 8);
+		return (i >> 8) * (1.f / 16777216.f);
+	}
+
+	u32 hash(u32 x)
+	{
+		x ^= x >> 16;
+		x *= 0x7FEB352Du;
+		x ^= x >> 15;
+		x *= 0x846CA68Bu;
+		x ^= x >> 16;
+		return x;
+	}
+
+	// Orthonormal basis around n (Duff et al. 2017).
+	static void tangent_frame(const float3& n, float3& t, float3& b)
+	{
+		const f32 s = n.z >= 0.f ? 1.f : -1.f;
+		const f32 a = -1.f / (s + n.z);
+		const f32 c = n.x * n.y * a;
+		t = float3(1.f + s * n.x * n.x * a, s * c, -s * n.x);
+		b = float3(c, s + n.y * n.y * a, -n.y);
+	}
+
+	f32 obscurance(const BVH& bvh, const float3& origin, const float3& n, u32 rays, f32 maxDistance, u32 seed, u32* pHits)
+	{
+		ASSERT(rays && !(rays & 3));
+
+		float3 t, b;
+		tangent_frame(n, t, b);
+
+		// Cranley-Patterson rotation of the Hammersley set.
+		const u32 h = hash(seed);
+		const f32 r1 = (h & 0xFFFF) * (1.f / 65536.f);
+		const f32 r2 = (h >> 16) * (1.f / 65536.f);
+		const f32 invRays = 1.f / rays;
+
+		f32 occlusion = 0.f;
+		u32 hits = 0;
+		BVH::Ray4 packet;
+		for (u32 first = 0; first < rays; first += 4)
+		{
+			for (u32 lane = 0; lane < 4; ++lane)
+			{
+				const u32 i = first + lane;
+				const f32 u1 = frac((i + 0.5f) * invRays + r1);
+				const f32 u2 = frac(radical_inverse(i) + r2);
+
+				// Cosine weighted, so an unweighted mean of the hits is the cosine weighted obscurance.
+				const f32 r = std::sqrt(u1);
+				const f32 phi = 6.28318531f * u2;
+				const float3 d = t * (r * std::cos(phi)) + b * (r * std::sin(phi)) + n * std::sqrt(std::max(0.f, 1.f - u1));
+
+				packet.ox[lane] = origin.x;
+				packet.oy[lane] = origin.y;
+				packet.oz[lane] = origin.z;
+				packet.dx[lane] = d.x;
+				packet.dy[lane] = d.y;
+				packet.dz[lane] = d.z;
+				packet.tMax[lane] = maxDistance;
+			}
+
+			f32 hitT[4];
+			bvh.closest_hit_4(packet, hitT);
+			for (u32 lane = 0; lane < 4; ++lane)
+			{
+				if (hitT[lane] < maxDistance)
+				{
+					occlusion += smoothstep(maxDistance, maxDistance * 0.5f, hitT[lane]);
+					++hits;
+				}
+			}
+		}
+
+		if (pHits)
+		{
+			*pHits = hits;
+		}
+		return occlusion * invRays;
+	}
+
+	Stats render(const AOReference::GBuffer& gbuffer, const BVH& bvh, const Params& params, AOReference::Image& out, WorkerPool* pPool)
+	{
+		out.resize(gbuffer.width, gbuffer.height);
+
+		const u32 rays = std::max(4u, (params.raysPerPixel + 3) & ~3u);
+		std::atomic<u64> pixels(0), hits(0);
+
+		auto rows = [&](u32 begin, u32 end)
+		{
+			u64 rowPixels = 0, rowHits = 0;
+			for (u32 y = begin; y < end; ++y)
+			{
+				for (u32 x = 0; x < gbuffer.width; ++x)
+				{
+					const float2 uv((x + 0.5f) / gbuffer.width, (y + 0.5f) / gbuffer.height);
+
+					f32 depth;
+					const float3 p = AOReference::get_position(gbuffer, uv, depth);
+					if (depth >= AOReference::kClearDepth)
+						continue;
+
+					const float3 n = AOReference::get_normal(gbuffer, uv);
+					const f32 viewZ = mul(float4(p, 1.f), gbuffer.matView).z;
+					const float3 origin = p + n * (params.rayBias * viewZ);
+
+					u32 pixelHits;
+					out.at(x, y) = obscurance(bvh, origin, n, rays, params.maxDistance, hash(y * gbuffer.width + x) ^ params.seed, &pixelHits);
+					rowHits += pixelHits;
+					++rowPixels;
+				}
+			}
+			pixels += rowPixels;
+			hits += rowHits;
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(gbuffer.height, 4, rows);
+		}
+		else
+		{
+			rows(0, gbuffer.height);
+		}
+
+		Stats stats;
+		stats.pixels = pixels;
+		stats.rays = stats.pixels * rays;
+		stats.hits = hits;
+		return stats;
+	}
+
+	f32 fit_gain(const AOReference::GBuffer& gbuffer, const AOReference::Image& reference, const AOReference::Image& test)
+	{
+		ASSERT(reference.width == test.width && reference.height == test.height);
+		ASSERT(reference.width == gbuffer.width && reference.height == gbuffer.height);
+
+		f64 rt = 0.0, tt = 0.0;
+		for (size_t i = 0; i < test.texels.size(); ++i)
+		{
+			if (gbuffer.depth[i] < AOReference::kClearDepth)
+			{
+				rt += (f64)reference.texels[i] * test.texels[i];
+				tt += (f64)test.texels[i] * test.texels[i];
+			}
+		}
+		return tt > 0.0 ? (f32)(rt / tt) : 1.f;
+	}
+
+	AOReference::ImageError compare_drawn(const AOReference::GBuffer& gbuffer, const AOReference::Image& reference, const AOReference::Image& test, f32 gain)
+	{
+		ASSERT(reference.width == test.width && reference.height == test.height);
+		ASSERT(reference.width == gbuffer.width && reference.height == gbuffer.height);
+
+		AOReference::ImageError error;
+		f64 sumSq = 0.0;
+		u64 count = 0;
+		for (size_t i = 0; i < test.texels.size(); ++i)
+		{
+			if (gbuffer.depth[i] >= AOReference::kClearDepth)
+				continue;
+
+			const f32 d = std::abs(reference.texels[i] - saturate(test.texels[i] * gain));
+			error.maxAbs = std::max(error.maxAbs, d);
+			sumSq += (f64)d * d;
+			++count;
+		}
+		error.rms = count ? (f32)std::sqrt(sumSq / count) : 0.f;
+		return error;
+	}
+
+	// One technique's rows, technique(params, out) at each tap count and converged(out) at kConvergedTaps.
+	template <typename TechniqueFn, typename ConvergedFn>
+	static std::vector<Calibration> calibrate(const AOReference::GBuffer& gbuffer, const AOReference::Image& groundTruth
+		, AOReference::Params params, u32 maxSamples, Calibration* pConvergedOut, const TechniqueFn& technique, const ConvergedFn& converged)
+	{
+		auto compare = [&](const AOReference::Image& ao, Calibration& row)
+		{
+			row.error = compare_drawn(gbuffer, groundTruth, ao);
+			row.gain = fit_gain(gbuffer, groundTruth, ao);
+			row.fittedError = compare_drawn(gbuffer, groundTruth, ao, row.gain);
+		};
+
+		std::vector<Calibration> rows;
+		AOReference::Image ao;
+		for (u32 samples = 1; samples <= maxSamples; ++samples)
+		{
+			params.samples = samples;
+
+			Calibration row;
+			row.taps = params.taps();
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			technique(params, ao);
+			row.milliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			compare(ao, row);
+			rows.push_back(row);
+		}
+
+		if (pConvergedOut)
+		{
+			*pConvergedOut = Calibration();
+			pConvergedOut->taps = kConvergedTaps;
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			converged(ao);
+			pConvergedOut->milliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			compare(ao, *pConvergedOut);
+		}
+		return rows;
+	}
+
+	std::vector<Calibration> calibrate_spiral(const AOReference::GBuffer& gbuffer, const AOReference::Image& groundTruth
+		, AOReference::Params params, u32 maxSamples, WorkerPool* pPool, Calibration* pConvergedOut)
+	{
+		return calibrate(gbuffer, groundTruth, params, maxSamples, pConvergedOut
+			, [&](const AOReference::Params& p, AOReference::Image& out) { AOReference::ssao_spiral(gbuffer, p, out); }
+			, [&](AOReference::Image& out) { AOReference::ssao_spiral_converged(gbuffer, params, kConvergedTaps, out, pPool); });
+	}
+
+	std::vector<Calibration> calibrate_vogel_alchemy(const AOReference::GBuffer& gbuffer, const AOReference::Image& groundTruth
+		, AOReference::Params params, u32 maxSamples, WorkerPool* pPool, Calibration* pConvergedOut)
+	{
+		return calibrate(gbuffer, groundTruth, params, maxSamples, pConvergedOut
+			, [&](const AOReference::Params& p, AOReference::Image& out) { AOReference::ssao_vogel_alchemy(gbuffer, p, out, pPool); }
+			, [&](AOReference::Image& out) { AOReference::ssao_vogel_alchemy_converged(gbuffer, params, kConvergedTaps, out, pPool); });
+	}
+
+	u32 cheapest_acceptable(const std::vector<Calibration>& rows, f32 toleranceSteps)
+	{
+		ASSERT(!rows.empty());
+
+		f32 best = FLT_MAX;
+		for (const Calibration& row : rows)
+		{
+			best = std::min(best, row.fittedError.rms_steps());
+		}
+
+		// The best row is always acceptable.
+		u32 cheapest = (u32)rows.size();
+		for (u32 i = 0; i < rows.size(); ++i)
+		{
+			if (rows[i].fittedError.rms_steps() <= best + toleranceSteps && (cheapest == rows.size() || rows[i].taps < rows[cheapest].taps))
+			{
+				cheapest = i;
+			}
+		}
+		return cheapest;
+	}
+}
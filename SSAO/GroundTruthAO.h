@@ -0,0 +1,83 @@
+#pragma once
+
+#include "AOReference.h"
+
+#include <vector>
+
+class BVH;
+class WorkerPool;
+
+//================================================================================
+// Ray Traced Ground Truth AO
+// World space ambient obscurance for every drawn pixel of a G-buffer, from
+// cosine weighted rays cast against a BVH of the whole scene (not just what is
+// on screen). A ray that hits within maxDistance occludes by the shaders'
+// falloff, smoothstep(maxDistance, maxDistance / 2, t), so the result is what
+// the screen space techniques estimate with the same g_maxDistance, and
+// fit_gain() takes out how each normalises it. What is left of a technique's
+// error at its converged tap count is the estimator's bias, which more taps
+// don't remove (see calibrate_spiral()).
+//
+// Rays are stratified per pixel (Hammersley, offset by a per pixel hash) and
+// cast four at a time with BVH::closest_hit_4(), rows over the WorkerPool.
+//================================================================================
+namespace GroundTruthAO
+{
+	using hlsl::float3;
+
+	struct Params
+	{
+		u32 raysPerPixel = 64;		// rounded up to a multiple of 4.
+		f32 maxDistance = 2.0f;		// g_maxDistance.
+		f32 rayBias = 0.002f;		// origin offset along the normal, times view depth (D24 steps grow with it).
+		u32 seed = 0;
+	};
+
+	struct Stats
+	{
+		u64 pixels = 0;
+		u64 rays = 0;
+		u64 hits = 0;				// within maxDistance.
+	};
+
+	// Obscurance from origin over the hemisphere around unit n, 0 open to 1 closed: rays (a multiple
+	// of 4) cosine weighted directions, the Hammersley set shifted by hash(seed), each hit within
+	// maxDistance weighted by the falloff. pHits gets how many rays hit.
+	f32 obscurance(const BVH& bvh, const float3& origin, const float3& n, u32 rays, f32 maxDistance, u32 seed, u32* pHits = nullptr);
+
+	// Integer hash for per pixel / per vertex seeds.
+	u32 hash(u32 x);
+
+	// out is 0 where nothing was drawn, like the AO targets.
+	Stats render(const AOReference::GBuffer& gbuffer, const BVH& bvh, const Params& params, AOReference::Image& out, WorkerPool* pPool = nullptr);
+
+	// Least squares gain g minimising |reference - g * test| over the drawn pixels. Intensity is an
+	// artistic scale on top of the estimate, g takes it out of the comparison.
+	f32 fit_gain(const AOReference::GBuffer& gbuffer, const AOReference::Image& reference, const AOReference::Image& test);
+
+	// AOReference::compare() over the drawn pixels only, test scaled by gain and saturated.
+	AOReference::ImageError compare_drawn(const AOReference::GBuffer& gbuffer, const AOReference::Image& reference, const AOReference::Image& test, f32 gain = 1.f);
+
+	// Taps of the converged estimates (AOReference::ssao_*_converged) that report an estimator's bias.
+	constexpr u32 kConvergedTaps = 256;
+
+	struct Calibration
+	{
+		u32 taps = 0;
+		f32 milliseconds = 0.f;				// CPU reference time, only meaningful relative to the other rows.
+		AOReference::ImageError error;		// as is.
+		AOReference::ImageError fittedError;	// after the gain.
+		f32 gain = 1.f;
+	};
+
+	// A technique at samples 1..maxSamples (4 taps each) against groundTruth, params' other values as
+	// they are. pConvergedOut gets the technique at kConvergedTaps, its fitted error is the bias no tap
+	// count gets under: when the rows sit on it, more taps buy nothing and that bias is the result.
+	std::vector<Calibration> calibrate_spiral(const AOReference::GBuffer& gbuffer, const AOReference::Image& groundTruth
+		, AOReference::Params params, u32 maxSamples, WorkerPool* pPool = nullptr, Calibration* pConvergedOut = nullptr);
+	std::vector<Calibration> calibrate_vogel_alchemy(const AOReference::GBuffer& gbuffer, const AOReference::Image& groundTruth
+		, AOReference::Params params, u32 maxSamples, WorkerPool* pPool = nullptr, Calibration* pConvergedOut = nullptr);
+
+	// Index of the cheapest row whose fitted rms is within toleranceSteps (R8 steps) of the best row's.
+	u32 cheapest_acceptable(const std::vector<Calibration>& rows, f32 toleranceSteps);
+}
@@ -0,0 +1,313 @@
+#include "SSAOFrame.h"
+
+#include <chrono>
+
+namespace
+{
+	using namespace SSAOFrame;
+
+	// Times a pass's execute into timings.
+	template<typename Fn>
+	void timed(std::vector<PassTiming>& timings, const char* pName, const Fn& fn)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		fn();
+		const std::chrono::duration<f64, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+		timings.push_back(PassTiming{ pName, elapsed.count() });
+	}
+}
+
+SSAOFrame::Renderer::Renderer(RenderBackend& backend)
+	: m_backend(backend)
+	, m_graphBackend(backend)
+{
+	// create_mesh_quad_xy's two triangles, the GPU's full screen passes draw them.
+	const RGCoverage quad = RGCoverage::FullScreenQuad();
+	Vertex vertices[6] = {};
+	for (u32 i = 0; i < 6; ++i)
+	{
+		vertices[i].position = float3(quad.pNdcXY[i * 2 + 0], quad.pNdcXY[i * 2 + 1], 0.f);
+		vertices[i].normal = float3(0.f, 0.f, -1.f);
+	}
+	m_fullScreenQuad = m_backend.create_buffer(RBBufferDesc::Create(RBBufferType::kVertex, sizeof(vertices), sizeof(Vertex)), vertices);
+}
+
+SSAOFrame::Renderer::~Renderer()
+{
+	m_graphBackend.release();
+
+	for (const MeshBuffers& mesh : m_meshes)
+	{
+		m_backend.destroy_buffer(mesh.vertices);
+		m_backend.destroy_buffer(mesh.indices);
+	}
+
+	RBBuffer* buffers[] = { &m_instances, &m_fullScreenQuad, &m_perFrame, &m_ssao, &m_light, &m_fusedBlur };
+	for (RBBuffer* pBuffer : buffers)
+	{
+		if (pBuffer->valid())
+		{
+			m_backend.destroy_buffer(*pBuffer);
+		}
+	}
+	if (m_output.valid())
+	{
+		m_backend.destroy_texture(m_output);
+	}
+}
+
+u32 SSAOFrame::Renderer::add_mesh(const Vertex* pVertices, u32 vertexCount, const u16* pIndices, u32 indexCount)
+{
+	ASSERT(indexCount % 3 == 0);
+
+	MeshBuffers mesh;
+	mesh.vertices = m_backend.create_buffer(RBBufferDesc::Create(RBBufferType::kVertex, vertexCount * sizeof(Vertex), sizeof(Vertex)), pVertices);
+	mesh.indices = m_backend.create_buffer(RBBufferDesc::Create(RBBufferType::kIndex, indexCount * sizeof(u16), sizeof(u16)), pIndices);
+	mesh.indexCount = indexCount;
+	m_meshes.push_back(mesh);
+	return (u32)m_meshes.size() - 1;
+}
+
+void SSAOFrame::Renderer::clear_instances()
+{
+	for (MeshBuffers& mesh : m_meshes)
+	{
+		mesh.instances.clear();
+	}
+}
+
+void SSAOFrame::Renderer::add_instance(u32 mesh, const float4x4& matModel)
+{
+	m_meshes[mesh].instances.push_back(matModel);
+}
+
+RBBuffer SSAOFrame::Renderer::constants(RBBuffer& buffer, const void* pData, u32 size)
+{
+	if (!buffer.valid())
+	{
+		buffer = m_backend.create_buffer(RBBufferDesc::Create(RBBufferType::kConstant, size, 0, true), pData);
+	}
+	else
+	{
+		m_backend.update_buffer(buffer, pData, size);
+	}
+	return buffer;
+}
+
+void SSAOFrame::Renderer::create_targets(u32 width, u32 height)
+{
+	RTPoolKey key;
+	key.width = width;
+	key.height = height;
+	key.format = RGFormat::kRGBA8_UNORM;
+	key.bindFlags = kRTBindRenderTarget | kRTBindShaderResource;
+
+	if (m_output.valid() && m_backend.texture_key(m_output) == key)
+		return;
+
+	if (m_output.valid())
+	{
+		m_backend.destroy_texture(m_output);
+	}
+	m_output = m_backend.create_texture(key);
+}
+
+void SSAOFrame::Renderer::upload_constants(const Camera& camera, const Settings& settings)
+{
+	PerFrameConstants perFrame = {};
+	perFrame.matProjection = camera.matProjection;
+	perFrame.matView = camera.matView;
+	perFrame.matViewProjection = hlsl::mul(camera.matView, camera.matProjection);
+	perFrame.matInverseProjection = camera.matInverseProjection;
+	perFrame.matInverseView = camera.matInverseView;
+	perFrame.screenW = (f32)settings.width;
+	perFrame.screenH = (f32)settings.height;
+	constants(m_perFrame, &perFrame, sizeof(perFrame));
+
+	const AOReference::Params& ao = settings.ao;
+	SSAOConstants ssao = {};
+	ssao.sampleRadius = ao.sampleRadius;
+	ssao.intensity = ao.intensity;
+	ssao.scale = ao.scale;
+	ssao.bias = ao.bias;
+	ssao.samples = (s32)ao.samples;
+	ssao.maxDistance = ao.maxDistance;
+	ssao.maxScreenRadius = ao.maxScreenRadius;
+	ssao.adaptiveBaseTaps = (s32)ao.adaptiveBaseTaps;
+	ssao.importanceVarianceScale = ao.importanceVarianceScale;
+	ssao.importanceEdgeScale = ao.importanceEdgeScale;
+	constants(m_ssao, &ssao, sizeof(ssao));
+
+	FusedBlurConstants blur = {};
+	blur.radius = (s32)settings.blur.radius;
+	for (u32 i = 0; i <= settings.blur.radius; ++i)
+	{
+		blur.weights[i] = settings.blur.weight((s32)i);
+	}
+	constants(m_fusedBlur, &blur, sizeof(blur));
+
+	const float3 direction = hlsl::normalize(settings.lightDirection);
+	LightConstants light = {};
+	light.direction = float4(direction.x, direction.y, direction.z, 0.f);
+	light.colour = float4(settings.lightColour.x, settings.lightColour.y, settings.lightColour.z, 1.f);
+	light.ambient = float4(settings.ambient.x, settings.ambient.y, settings.ambient.z, 0.f);
+	constants(m_light, &light, sizeof(light));
+
+	// Every mesh's instances back to back, each mesh draws its run.
+	const float4x4 matViewProjection = perFrame.matViewProjection;
+	m_instanceData.clear();
+	for (const MeshBuffers& mesh : m_meshes)
+	{
+		for (const float4x4& matModel : mesh.instances)
+		{
+			m_instanceData.push_back(GeometryInstance{ matModel, hlsl::mul(matModel, matViewProjection) });
+		}
+	}
+
+	const u32 instances = std::max<u32>(1, (u32)m_instanceData.size());
+	if (instances > m_instanceCapacity)
+	{
+		if (m_instances.valid())
+		{
+			m_backend.destroy_buffer(m_instances);
+		}
+		m_instanceCapacity = std::max(instances, m_instanceCapacity * 2);
+		m_instances = m_backend.create_buffer(RBBufferDesc::Create(RBBufferType::kStructured, m_instanceCapacity * sizeof(GeometryInstance), sizeof(GeometryInstance), true));
+	}
+	if (!m_instanceData.empty())
+	{
+		m_backend.update_buffer(m_instances, m_instanceData.data(), (u32)(m_instanceData.size() * sizeof(GeometryInstance)));
+	}
+}
+
+void SSAOFrame::Renderer::render(const Camera& camera, const Settings& settings)
+{
+	m_timings.clear();
+
+	const RBPipeline geometry = m_backend.find_pipeline(kGeometryPipeline);
+	const RBPipeline ssao = m_backend.find_pipeline(kSSAOPipeline);
+	const RBPipeline blur = m_backend.find_pipeline(kBlurPipeline);
+	const RBPipeline lighting = m_backend.find_pipeline(kLightingPipeline);
+	ASSERT(geometry.valid() && ssao.valid() && blur.valid() && lighting.valid());
+
+	timed(m_timings, "Upload", [&]()
+		{
+			create_targets(settings.width, settings.height);
+			upload_constants(camera, settings);
+		});
+
+	const u32 width = settings.width;
+	const u32 height = settings.height;
+
+	m_graph.reset();
+	m_graphBackend.begin_frame();
+
+	// Same formats and clears as the app's G-buffer.
+	RGTextureDesc colourDesc = RGTextureDesc::Create(width, height, RGFormat::kRGBA8_UNORM);
+	RGTextureDesc normalDesc = RGTextureDesc::Create(width, height, RGFormat::kRG16_SNORM);
+	RGTextureDesc depthDesc = RGTextureDesc::Create(width, height, RGFormat::kD24_UNORM_S8_UINT);
+	depthDesc.clearValue[0] = 1.f;
+	RGTextureDesc aoDesc = RGTextureDesc::Create(width, height, RGFormat::kR8_UNORM);
+	RGTextureDesc blurDesc = aoDesc;
+	blurDesc.unorderedAccess = true;
+
+	const RGResource colourSpec = m_graph.create_texture("GBuffer ColourSpec", colourDesc);
+	const RGResource normal = m_graph.create_texture("GBuffer Normal", normalDesc);
+	const RGResource depth = m_graph.create_texture("GBuffer Depth", depthDesc);
+	const RGResource ao = m_graph.create_texture("SSAO", aoDesc);
+	const RGResource blurred = m_graph.create_texture("SSAO Blurred", blurDesc);
+	const RGResource output = m_graph.import_texture("Output", RGTextureDesc::Create(width, height, RGFormat::kRGBA8_UNORM), m_graphBackend.import(m_output));
+
+	m_graph.add_pass("Geometry",
+		[&](RGPassBuilder& builder)
+		{
+			builder.write(colourSpec, 0);
+			builder.write(normal, 1);
+			builder.write_depth(depth);
+		},
+		[this, geometry](const RGPassContext&)
+		{
+			timed(m_timings, "Geometry", [&]()
+				{
+					m_backend.bind_pipeline(geometry);
+					m_backend.bind_constants(kPerFrameSlot, m_perFrame);
+					m_backend.bind_buffer(kInstanceSlot, m_instances);
+
+					u32 firstInstance = 0;
+					for (const MeshBuffers& mesh : m_meshes)
+					{
+						if (mesh.instances.empty())
+							continue;
+
+						m_backend.bind_vertex_buffer(mesh.vertices);
+						m_backend.bind_index_buffer(mesh.indices);
+						m_backend.draw_indexed(mesh.indexCount, 0, 0, (u32)mesh.instances.size(), firstInstance);
+						firstInstance += (u32)mesh.instances.size();
+					}
+				});
+		});
+
+	m_graph.add_pass("SSAO",
+		[&](RGPassBuilder& builder)
+		{
+			builder.read(normal, 1);
+			builder.read(depth, 2);
+			builder.write(ao);
+			builder.cover(RGCoverage::FullScreenQuad());
+		},
+		[this, ssao](const RGPassContext&)
+		{
+			timed(m_timings, "SSAO", [&]()
+				{
+					m_backend.bind_pipeline(ssao);
+					m_backend.bind_constants(kPerFrameSlot, m_perFrame);
+					m_backend.bind_constants(kSSAOSlot, m_ssao);
+					m_backend.bind_vertex_buffer(m_fullScreenQuad);
+					m_backend.draw(6);
+				});
+		});
+
+	m_graph.add_pass("Fused Gauss",
+		[&](RGPassBuilder& builder)
+		{
+			builder.read(ao, 0);
+			builder.write_uav(blurred, 0);
+		},
+		[this, blur, width, height](const RGPassContext&)
+		{
+			timed(m_timings, "Fused Gauss", [&]()
+				{
+					m_backend.bind_pipeline(blur);
+					m_backend.bind_constants(kPerFrameSlot, m_perFrame);
+					m_backend.bind_constants(kFusedBlurSlot, m_fusedBlur);
+					m_backend.dispatch((width + kBlurGroupSize - 1) / kBlurGroupSize, (height + kBlurGroupSize - 1) / kBlurGroupSize);
+				});
+		});
+
+	m_graph.add_pass("Lighting",
+		[&](RGPassBuilder& builder)
+		{
+			builder.read(colourSpec, 0);
+			builder.read(normal, 1);
+			builder.read(depth, 2);
+			builder.read(blurred, 3);
+			builder.write(output);
+			builder.cover(RGCoverage::FullScreenQuad());
+		},
+		[this, lighting](const RGPassContext&)
+		{
+			timed(m_timings, "Lighting", [&]()
+				{
+					m_backend.bind_pipeline(lighting);
+					m_backend.bind_constants(kPerFrameSlot, m_perFrame);
+					m_backend.bind_constants(kLightSlot, m_light);
+					m_backend.bind_vertex_buffer(m_fullScreenQuad);
+					m_backend.draw(6);
+				});
+		});
+
+	const bool compiled = m_graph.compile();
+	ASSERT(compiled);
+	(void)compiled;
+	m_graph.execute(m_graphBackend);
+}
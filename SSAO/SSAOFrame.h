@@ -0,0 +1,187 @@
+#pragma once
+
+#include "AOReference.h"
+#include "RenderBackend.h"
+#include "SeparableBlur.h"
+
+#include <memory>
+#include <vector>
+
+class RenderBackendCPU;
+
+//================================================================================
+// SSAO Frame
+// The deferred SSAO frame (geometry, SSAO, fused blur, directional light)
+// written against RenderBackend and a RenderGraph, so it runs on any backend:
+// with RenderBackendCPU and add_cpu_pipelines() it needs no window or GPU and
+// can be profiled on Linux machines.
+//
+// Constant buffers mirror the app's cbuffers and bind to the same registers
+// (DeferredShaders.fx / SSAOShaders.fx). The CPU pipelines are the references
+// the app checks its shaders against: SoftRaster for VS / PS_Geometry_NoTex,
+// AOReference::ssao_vogel_alchemy for PS_SSAO_04, blur_fused for
+// CS_BLUR_FUSED and PS_DirectionalLight at texel centres.
+//================================================================================
+namespace SSAOFrame
+{
+	using hlsl::float3;
+	using hlsl::float4;
+	using hlsl::float4x4;
+
+	constexpr const char* kGeometryPipeline = "Geometry NoTex";
+	constexpr const char* kSSAOPipeline = "SSAO Vogel Alchemy";
+	constexpr const char* kBlurPipeline = "Fused Gauss";
+	constexpr const char* kLightingPipeline = "Directional Light";
+
+	// Registers, as in the shaders.
+	constexpr u32 kPerFrameSlot = 0;	// b0
+	constexpr u32 kSSAOSlot = 1;		// b1
+	constexpr u32 kLightSlot = 2;		// b2
+	constexpr u32 kFusedBlurSlot = 3;	// b3
+	constexpr u32 kInstanceSlot = 8;	// t8
+
+	constexpr u32 kBlurGroupSize = 16;	// CS_BLUR_FUSED's FUSED_TILE.
+
+	struct Vertex
+	{
+		float3 position;
+		float3 normal;
+	};
+
+	// Matrices un-transposed (row vectors), the D3D11 backend's uploads would need them transposed.
+	struct PerFrameConstants
+	{
+		float4x4 matProjection;
+		float4x4 matView;
+		float4x4 matViewProjection;
+		float4x4 matInverseProjection;
+		float4x4 matInverseView;
+		f32 time;
+		f32 screenW;
+		f32 screenH;
+		f32 padding;
+	};
+
+	struct GeometryInstance
+	{
+		float4x4 matModel;
+		float4x4 matMVP;
+	};
+
+	struct SSAOConstants
+	{
+		f32 randomSize;
+		f32 sampleRadius;
+		f32 intensity;
+		f32 scale;
+		f32 bias;
+		s32 samples;
+		f32 maxDistance;
+		f32 maxScreenRadius;
+		s32 adaptiveBaseTaps;
+		f32 importanceVarianceScale;
+		f32 importanceEdgeScale;
+		f32 padding;
+	};
+
+	struct FusedBlurConstants
+	{
+		s32 radius;
+		s32 padding[3];
+		f32 weights[BlurKernel::kMaxRadius + 4];	// offset 0..radius.
+	};
+
+	struct LightConstants
+	{
+		float4 position;		// w == 0, directional.
+		float4 direction;		// towards the light.
+		float4 colour;
+		float4 attenuation;
+		float4 ambient;
+	};
+
+	struct Settings
+	{
+		u32 width = 1280;
+		u32 height = 720;
+		AOReference::Params ao;
+		BlurKernel blur = BlurKernel::Gauss9(3);
+		float3 lightDirection = float3(0.f, 1.f, 0.f);		// towards the light.
+		float3 lightColour = float3(1.f, 1.f, 1.f);
+		float3 ambient = float3(0.3f, 0.3f, 0.3f);
+	};
+
+	struct Camera
+	{
+		float4x4 matView = float4x4::identity();
+		float4x4 matProjection = float4x4::identity();
+		float4x4 matInverseView = float4x4::identity();
+		float4x4 matInverseProjection = float4x4::identity();
+	};
+
+	struct PassTiming
+	{
+		const char* pName;
+		f64 milliseconds;
+	};
+
+	class Renderer
+	{
+	public:
+		explicit Renderer(RenderBackend& backend);
+		~Renderer();
+
+		// Triangle list, u16 indices like Mesh. Returns the mesh's id.
+		u32 add_mesh(const Vertex* pVertices, u32 vertexCount, const u16* pIndices, u32 indexCount);
+
+		// Instances to draw next render(), one instanced draw per mesh.
+		void clear_instances();
+		void add_instance(u32 mesh, const float4x4& matModel);
+
+		// Records and executes the frame. Every pipeline must exist on the backend.
+		void render(const Camera& camera, const Settings& settings);
+
+		// Lit RGBA8 result of the last render(), kept until the next one.
+		RBTexture output() const { return m_output; }
+
+		// Per pass, in execution order. Only the CPU time of recording / running the pass, a GPU
+		// backend would need queries.
+		const std::vector<PassTiming>& timings() const { return m_timings; }
+
+		const RenderGraph& graph() const { return m_graph; }
+
+	private:
+		struct MeshBuffers
+		{
+			RBBuffer vertices;
+			RBBuffer indices;
+			u32 indexCount = 0;
+			std::vector<float4x4> instances;
+		};
+
+		void create_targets(u32 width, u32 height);
+		void upload_constants(const Camera& camera, const Settings& settings);
+		RBBuffer constants(RBBuffer& buffer, const void* pData, u32 size);
+
+		RenderBackend& m_backend;
+		RenderGraph m_graph;
+		RenderBackendGraph m_graphBackend;
+
+		std::vector<MeshBuffers> m_meshes;
+		std::vector<GeometryInstance> m_instanceData;
+		u32 m_instanceCapacity = 0;
+		RBBuffer m_instances;
+		RBBuffer m_fullScreenQuad;
+
+		RBBuffer m_perFrame;
+		RBBuffer m_ssao;
+		RBBuffer m_light;
+		RBBuffer m_fusedBlur;
+
+		RBTexture m_output;
+		std::vector<PassTiming> m_timings;
+	};
+
+	// The CPU versions of the frame's pipelines.
+	void add_cpu_pipelines(RenderBackendCPU& backend);
+}
@@ -0,0 +1,258 @@
+#include "SSAOFrame.h"
+#include "SoftRasterizer.h"
+#include "GBufferEncoding.h"
+#include "RenderBackendCPU.h"
+#include "WorkerPool.h"
+
+//================================================================================
+// CPU pipelines of the SSAO frame. Each program keeps its scratch between calls
+// (the rasterizer's bins, the decoded G-buffer, the blur planes) so a steady
+// frame doesn't reallocate.
+//================================================================================
+namespace
+{
+	using namespace SSAOFrame;
+
+	// fn over rows [0, height), over the pool when there is one.
+	template<typename Fn>
+	void for_rows(WorkerPool* pPool, u32 height, const Fn& fn)
+	{
+		if (pPool)
+		{
+			pPool->parallel_for(height, 16, fn);
+		}
+		else
+		{
+			fn(0, height);
+		}
+	}
+
+	// VS_Geometry_Instanced + PS_Geometry_NoTex: colour / spec to target 0, normals to target 1, D24S8 depth.
+	struct GeometryProgram
+	{
+		std::unique_ptr<SoftRaster::Rasterizer> pRasterizer;
+		std::vector<SoftRaster::Draw> draws;
+		SoftRaster::MeshView mesh;
+
+		void operator()(const RBCpuState& state, const RBCpuCall& call)
+		{
+			ASSERT(call.indexed && state.pVertices && state.pIndices && state.pBuffers[kInstanceSlot]);
+			ASSERT(state.targetCount >= 2 && state.pTargets[0] && state.pTargets[1] && state.pDepth);
+			ASSERT(state.pTargets[0]->key.format == RGFormat::kRGBA8_UNORM);
+			ASSERT(state.pTargets[1]->key.format == RGFormat::kRG16_SNORM);
+			ASSERT(state.pDepth->key.format == RGFormat::kD24_UNORM_S8_UINT);
+
+			if (!pRasterizer)
+			{
+				pRasterizer.reset(new SoftRaster::Rasterizer(state.pPool));
+			}
+
+			const RBCpuBuffer& vertices = *state.pVertices;
+			const u32 stride = vertices.desc.stride;
+			ASSERT(stride >= sizeof(Vertex) && call.baseVertex >= 0);
+			mesh.pVertices = vertices.bytes.data() + (size_t)call.baseVertex * stride;
+			mesh.vertexCount = vertices.elements() - (u32)call.baseVertex;
+			mesh.stride = stride;
+			mesh.positionOffset = offsetof(Vertex, position);
+			mesh.normalOffset = offsetof(Vertex, normal);
+			mesh.pIndices = (const u16*)state.pIndices->bytes.data() + call.first;
+			mesh.indexCount = call.count;
+
+			const RBCpuBuffer& instanceBuffer = *state.pBuffers[kInstanceSlot];
+			ASSERT(call.firstInstance + call.instanceCount <= instanceBuffer.elements());
+			const GeometryInstance* pInstances = instanceBuffer.as<GeometryInstance>() + call.firstInstance;
+
+			draws.resize(call.instanceCount);
+			for (u32 i = 0; i < call.instanceCount; ++i)
+			{
+				draws[i] = SoftRaster::Draw();
+				draws[i].pMesh = &mesh;
+				draws[i].matModel = pInstances[i].matModel;
+				draws[i].matMVP = pInstances[i].matMVP;
+			}
+
+			SoftRaster::Targets targets;
+			targets.width = state.pTargets[0]->key.width;
+			targets.height = state.pTargets[0]->key.height;
+			targets.pColourSpec = state.pTargets[0]->row<u32>(0);
+			targets.pNormal = state.pTargets[1]->row<u32>(0);
+			targets.pDepthStencil = state.pDepth->row<u32>(0);
+
+			// Earlier draws of the pass are in the targets already.
+			pRasterizer->render(draws.data(), (u32)draws.size(), targets, true);
+		}
+	};
+
+	// PS_SSAO_04 over the whole target.
+	struct SSAOProgram
+	{
+		AOReference::GBuffer gbuffer;
+		AOReference::Image ao;
+
+		void operator()(const RBCpuState& state, const RBCpuCall&)
+		{
+			const RBCpuTexture& normal = *state.pTextures[1];
+			const RBCpuTexture& depth = *state.pTextures[2];
+			RBCpuTexture& target = *state.pTargets[0];
+			ASSERT(normal.key.format == RGFormat::kRG16_SNORM && depth.key.format == RGFormat::kD24_UNORM_S8_UINT);
+
+			const u32 width = target.key.width;
+			const u32 height = target.key.height;
+			ASSERT(normal.key.width == width && normal.key.height == height);
+
+			const PerFrameConstants& perFrame = state.constants<PerFrameConstants>(kPerFrameSlot);
+			const SSAOConstants& constants = state.constants<SSAOConstants>(kSSAOSlot);
+
+			if (gbuffer.width != width || gbuffer.height != height)
+			{
+				gbuffer.resize(width, height);
+			}
+			gbuffer.matProjection = perFrame.matProjection;
+			gbuffer.matView = perFrame.matView;
+			gbuffer.matInverseProjection = perFrame.matInverseProjection;
+			gbuffer.matInverseView = perFrame.matInverseView;
+
+			for_rows(state.pPool, height, [&](u32 begin, u32 end)
+			{
+				for (u32 y = begin; y < end; ++y)
+				{
+					const u32* pNormals = normal.row<u32>(y);
+					const u32* pDepths = depth.row<u32>(y);
+					for (u32 x = 0; x < width; ++x)
+					{
+						gbuffer.normal[y * width + x] = GBufferEncoding::unpack_normal(pNormals[x]);
+						gbuffer.depth[y * width + x] = (pDepths[x] & 0xFFFFFF) / 16777215.f;
+					}
+				}
+			});
+
+			AOReference::Params params;
+			params.sampleRadius = constants.sampleRadius;
+			params.intensity = constants.intensity;
+			params.scale = constants.scale;
+			params.bias = constants.bias;
+			params.samples = (u32)constants.samples;
+			params.maxDistance = constants.maxDistance;
+			params.maxScreenRadius = constants.maxScreenRadius;
+			AOReference::ssao_vogel_alchemy(gbuffer, params, ao, state.pPool);
+
+			// clip() leaves the background alone, it is whatever the target was cleared to.
+			for_rows(state.pPool, height, [&](u32 begin, u32 end)
+			{
+				for (u32 y = begin; y < end; ++y)
+				{
+					for (u32 x = 0; x < width; ++x)
+					{
+						if (gbuffer.depth[y * width + x] < AOReference::kClearDepth)
+						{
+							target.store_r(x, y, ao.at(x, y));
+						}
+					}
+				}
+			});
+		}
+	};
+
+	// CS_BLUR_FUSED, t0 into u0.
+	struct BlurProgram
+	{
+		std::vector<f32> input;
+		std::vector<f32> output;
+
+		void operator()(const RBCpuState& state, const RBCpuCall&)
+		{
+			const RBCpuTexture& source = *state.pTextures[0];
+			RBCpuTexture& target = *state.pUAVs[0];
+			const u32 width = target.key.width;
+			const u32 height = target.key.height;
+			ASSERT(source.key.width == width && source.key.height == height);
+
+			const FusedBlurConstants& constants = state.constants<FusedBlurConstants>(kFusedBlurSlot);
+			BlurKernel kernel;
+			kernel.radius = (u32)constants.radius;
+			ASSERT(kernel.radius <= BlurKernel::kMaxRadius);
+			for (u32 i = 0; i <= kernel.radius; ++i)
+			{
+				kernel.weights[kernel.radius + i] = constants.weights[i];
+				kernel.weights[kernel.radius - i] = constants.weights[i];
+			}
+
+			input.resize((size_t)width * height);
+			output.resize((size_t)width * height);
+			for_rows(state.pPool, height, [&](u32 begin, u32 end)
+			{
+				for (u32 y = begin; y < end; ++y)
+				{
+					for (u32 x = 0; x < width; ++x)
+					{
+						input[y * width + x] = source.load_r(x, y);
+					}
+				}
+			});
+
+			blur_fused(input.data(), output.data(), width, height, kernel, state.pPool);
+
+			for_rows(state.pPool, height, [&](u32 begin, u32 end)
+			{
+				for (u32 y = begin; y < end; ++y)
+				{
+					for (u32 x = 0; x < width; ++x)
+					{
+						target.store_r(x, y, output[y * width + x]);
+					}
+				}
+			});
+		}
+	};
+
+	// PS_DirectionalLight at texel centres (its linear samples land on them), into an RGBA8 target.
+	void lighting_program(const RBCpuState& state, const RBCpuCall&)
+	{
+		const RBCpuTexture& colourSpec = *state.pTextures[0];
+		const RBCpuTexture& normal = *state.pTextures[1];
+		const RBCpuTexture& ssao = *state.pTextures[3];
+		RBCpuTexture& target = *state.pTargets[0];
+		ASSERT(target.key.format == RGFormat::kRGBA8_UNORM);
+
+		const LightConstants& light = state.constants<LightConstants>(kLightSlot);
+		const float3 direction(light.direction.x, light.direction.y, light.direction.z);
+		const float3 colour(light.colour.x, light.colour.y, light.colour.z);
+		const float3 ambient(light.ambient.x, light.ambient.y, light.ambient.z);
+
+		const u32 width = target.key.width;
+		for_rows(state.pPool, target.key.height, [&](u32 begin, u32 end)
+		{
+			for (u32 y = begin; y < end; ++y)
+			{
+				const u32* pColours = colourSpec.row<u32>(y);
+				const u32* pNormals = normal.row<u32>(y);
+				u32* pOut = target.row<u32>(y);
+				for (u32 x = 0; x < width; ++x)
+				{
+					const float4 albedoSpec = GBufferEncoding::unpack_albedo_spec(pColours[x]);
+					const float3 N = GBufferEncoding::unpack_normal(pNormals[x]);
+
+					const f32 diffuse = std::max(hlsl::dot(direction, N), 0.f);
+					const f32 occlusion = 1.f - ssao.load_r(x, y);
+					const f32 baked = hlsl::lerp(1.f, albedoSpec.w, light.ambient.w);
+					const float3 lit = ambient * (occlusion * baked) + float3(albedoSpec.x, albedoSpec.y, albedoSpec.z) * colour * diffuse;
+
+					pOut[x] = GBufferEncoding::pack_albedo_spec(float4(lit.x, lit.y, lit.z, 1.f));
+				}
+			}
+		});
+	}
+}
+
+void SSAOFrame::add_cpu_pipelines(RenderBackendCPU& backend)
+{
+	// The programs are copied into std::functions, shared_ptr keeps one scratch per pipeline.
+	std::shared_ptr<GeometryProgram> pGeometry(new GeometryProgram());
+	std::shared_ptr<SSAOProgram> pSSAO(new SSAOProgram());
+	std::shared_ptr<BlurProgram> pBlur(new BlurProgram());
+
+	backend.add_pipeline(kGeometryPipeline, RBPipelineType::kGraphics, [pGeometry](const RBCpuState& state, const RBCpuCall& call) { (*pGeometry)(state, call); });
+	backend.add_pipeline(kSSAOPipeline, RBPipelineType::kGraphics, [pSSAO](const RBCpuState& state, const RBCpuCall& call) { (*pSSAO)(state, call); });
+	backend.add_pipeline(kBlurPipeline, RBPipelineType::kCompute, [pBlur](const RBCpuState& state, const RBCpuCall& call) { (*pBlur)(state, call); });
+	backend.add_pipeline(kLightingPipeline, RBPipelineType::kGraphics, lighting_program);
+}
@@ -0,0 +1,655 @@
+// GENERATED by Tools/KernelGen - do not edit.
+// Regenerated as a pre-build step of the SSAO project.
+#pragma once
+
+#include "CoreTypes.h"
+
+namespace SSAOKernels
+{
+	constexpr u32 kMaxTaps = 32;
+	constexpr u32 kNoiseTileSize = 64;
+
+	// cos, sin of (i * golden angle).
+	constexpr f32 kGoldenSpiralDir[kMaxTaps][2] = {
+		{ 1.0f, 0.0f },
+		{ -0.737393796f, 0.67546314f },
+		{ 0.0874991715f, -0.99616462f },
+		{ 0.608351111f, 0.793668032f },
+		{ -0.984687805f, -0.17432715f },
+		{ 0.843853951f, -0.536572933f },
+		{ -0.259817898f, 0.965657651f },
+		{ -0.460677564f, -0.88756758f },
+		{ 0.939220071f, 0.343315661f },
+		{ -0.924471915f, 0.381250143f },
+		{ 0.424179018f, -0.905578375f },
+		{ 0.298896462f, 0.954285562f },
+		{ -0.864989281f, -0.501790285f },
+		{ 0.976778448f, -0.214251801f },
+		{ -0.575552344f, 0.817764938f },
+		{ -0.127963692f, -0.991778851f },
+		{ 0.764268756f, 0.644897878f },
+		{ -0.999171793f, 0.0406902097f },
+		{ 0.709296644f, -0.7049101f },
+		{ -0.0468916111f, 0.998899996f },
+		{ -0.640144348f, -0.768254638f },
+		{ 0.990965962f, 0.134113744f },
+		{ -0.821321845f, 0.570465147f },
+		{ 0.220307127f, -0.975430548f },
+		{ 0.496412992f, 0.868086457f },
+		{ -0.95241183f, -0.304814249f },
+		{ 0.908192337f, -0.418553084f },
+		{ -0.38697952f, 0.922088325f },
+		{ -0.337478995f, -0.941333055f },
+		{ 0.884689987f, 0.466179818f },
+		{ -0.967250586f, 0.25382337f },
+		{ 0.541797459f, -0.840509057f },
+	};
+
+	// sqrt(i + 0.5), scale by 1/sqrt(taps) for a vogel disk.
+	constexpr f32 kVogelRadius[kMaxTaps] = {
+		0.707106769f,
+		1.22474492f,
+		1.58113885f,
+		1.87082875f,
+		2.12132025f,
+		2.34520793f,
+		2.54950976f,
+		2.73861289f,
+		2.91547585f,
+		3.08220696f,
+		3.24037027f,
+		3.39116502f,
+		3.53553391f,
+		3.67423463f,
+		3.8078866f,
+		3.93700385f,
+		4.06201935f,
+		4.18330002f,
+		4.30116272f,
+		4.4158802f,
+		4.52769279f,
+		4.63680935f,
+		4.74341631f,
+		4.84768009f,
+		4.94974756f,
+		5.04975224f,
+		5.14781523f,
+		5.2440443f,
+		5.33853912f,
+		5.43139029f,
+		5.52268028f,
+		5.61248589f,
+	};
+
+	// Progressive poisson disk in the unit disk, any prefix is well distributed.
+	constexpr f32 kPoissonDisk[kMaxTaps][2] = {
+		{ -0.173145294f, -0.764762044f },
+		{ 0.315927505f, 0.846596599f },
+		{ -0.865884185f, 0.416887641f },
+		{ 0.693664551f, 0.00225615501f },
+		{ -0.00316607952f, 0.0304405689f },
+		{ -0.643621445f, -0.211894512f },
+		{ 0.362381339f, -0.513149738f },
+		{ -0.196625948f, 0.958272219f },
+		{ 0.875856042f, -0.439491034f },
+		{ -0.00144839287f, 0.481521249f },
+		{ -0.106405139f, -0.344973922f },
+		{ 0.668959498f, 0.391853929f },
+		{ -0.446612358f, 0.152044415f },
+		{ -0.502455711f, -0.807957411f },
+		{ -0.359584689f, 0.613583207f },
+		{ 0.363578439f, 0.499293923f },
+		{ 0.384355903f, 0.0919265747f },
+		{ 0.398985982f, -0.90669024f },
+		{ -0.803779244f, 0.10211122f },
+		{ 0.983530045f, 0.0656027794f },
+		{ -0.731462717f, -0.514278054f },
+		{ 0.0825059414f, -0.871366501f },
+		{ 0.295850396f, -0.192440867f },
+		{ 0.648172498f, -0.744561553f },
+		{ -0.388605595f, -0.119791389f },
+		{ -0.511327982f, -0.402386069f },
+		{ -0.612143636f, 0.399975777f },
+		{ -0.60422039f, 0.693235874f },
+		{ -0.902846575f, -0.169428468f },
+		{ 0.132890463f, 0.696843982f },
+		{ 0.679942131f, -0.25839138f },
+		{ 0.0600229502f, 0.98898983f },
+	};
+
+	// cos, sin of 2pi * interleaved gradient noise over a 4x4 tile, index y * 4 + x.
+	constexpr f32 kTileRotation4x4[16][2] = {
+		{ 1.0f, 0.0f },
+		{ -0.93935287f, -0.342952222f },
+		{ 0.764767826f, 0.644306004f },
+		{ -0.497422099f, -0.86750865f },
+		{ 0.0811090916f, 0.996705234f },
+		{ 0.265632898f, -0.964074254f },
+		{ -0.580155253f, 0.814505935f },
+		{ 0.824304521f, -0.566146612f },
+		{ -0.986842632f, 0.161683723f },
+		{ 0.982443273f, 0.18656145f },
+		{ -0.858878553f, -0.512179315f },
+		{ 0.631140649f, 0.775668383f },
+		{ -0.241192222f, -0.970477343f },
+		{ -0.106263898f, 0.994337976f },
+		{ 0.440828115f, -0.897591531f },
+		{ -0.721920907f, 0.691975594f },
+	};
+
+	// RGBA8 blue noise tile : r = noise, gb = (cos, sin) of 2pi * noise as unorm, a = 1.
+	constexpr u32 kNoiseTileRGBA[kNoiseTileSize * kNoiseTileSize] = {
+		0xFF2C1F9Du, 0xFF37E8E6u, 0xFF5C058Bu, 0xFFFE8D3Bu, 0xFF07A8CCu, 0xFFA80772u, 0xFFE93758u, 0xFF007FBFu,
+		0xFF202BA2u, 0xFF87FF02u, 0xFF69FDF8u, 0xFFCAE719u, 0xFF940279u, 0xFF1638A7u, 0xFFA8F80Du, 0xFF80007Fu,
+		0xFF41EFEAu, 0xFFF14553u, 0xFF98FD08u, 0xFF2B209Du, 0xFFCC1966u, 0xFF49F3EDu, 0xFF6E0185u, 0xFFDDD621u,
+		0xFFDC285Fu, 0xFF1F2CA2u, 0xFF59F9F2u, 0xFF049DC9u, 0xFFE3CF24u, 0xFF68FDF7u, 0xFFBBF014u, 0xFFFE6F45u,
+		0xFF48F2EDu, 0xFF81FF01u, 0xFF055DB4u, 0xFFFC6449u, 0xFFCBE71Au, 0xFF81007Fu, 0xFF0174BCu, 0xFF21D6DDu,
+		0xFF9F0475u, 0xFF13C2D6u, 0xFFDB275Fu, 0xFF0E45ACu, 0xFFFE7144u, 0xFF06A6CCu, 0xFF9CFC09u, 0xFFFAA434u,
+		0xFF2E1D9Bu, 0xFFAEF60Fu, 0xFF56078Du, 0xFFEEBF2Bu, 0xFF212AA2u, 0xFFFF7A42u, 0xFF9C0376u, 0xFF4F098Fu,
+		0xFFA3FA0Bu, 0xFF59F9F3u, 0xFF2526A0u, 0xFF039CC9u, 0xFF3CECE8u, 0xFF1140AAu, 0xFFC31469u, 0xFF6EFEF9u,
+		0xFFE02C5Du, 0xFFEAC528u, 0xFF018EC4u, 0xFF1B31A5u, 0xFF49F3EDu, 0xFFD1E21Cu, 0xFF22D6DEu, 0xFFB6F312u,
+		0xFFC21369u, 0xFF05A2CAu, 0xFFDD295Eu, 0xFF0460B5u, 0xFFFB614Au, 0xFF039CC8u, 0xFF1ED2DCu, 0xFFFF7743u,
+		0xFF0173BBu, 0xFFB10A6Fu, 0xFF30E3E4u, 0xFF88007Du, 0xFFEBC429u, 0xFF0295C6u, 0xFFF9594Cu, 0xFF381698u,
+		0xFF0083C0u, 0xFFA10475u, 0xFFFE7045u, 0xFF80007Fu, 0xFF301C9Bu, 0xFFF04354u, 0xFF1836A6u, 0xFF920179u,
+		0xFFE8C927u, 0xFF27249Fu, 0xFFF9A534u, 0xFFC0126Au, 0xFF07AACDu, 0xFFECC229u, 0xFFFF7543u, 0xFF2B209Du,
+		0xFFF7AC31u, 0xFFFB5F4Au, 0xFFBDEF14u, 0xFF4CF4EEu, 0xFFB20B6Fu, 0xFF59068Cu, 0xFF055DB4u, 0xFF90017Au,
+		0xFF0CB5D1u, 0xFF026AB8u, 0xFFC71668u, 0xFF48F2EDu, 0xFFC9E819u, 0xFF06A6CCu, 0xFF66FCF7u, 0xFFE4CE25u,
+		0xFF0294C6u, 0xFFFB9D36u, 0xFFE83758u, 0xFFC9E819u, 0xFF990377u, 0xFFF7AC31u, 0xFF007FBFu, 0xFFFF7F40u,
+		0xFF20D4DDu, 0xFF91017Au, 0xFF82FF01u, 0xFFD01C64u, 0xFFF6AE31u, 0xFFF9584Cu, 0xFF1140AAu, 0xFF490C92u,
+		0xFFFF8040u, 0xFF35E7E6u, 0xFFF4B22Fu, 0xFF5A068Bu, 0xFF51F6F0u, 0xFFEDC12Au, 0xFFCF1C64u, 0xFF4B0B91u,
+		0xFFF7AD31u, 0xFFD5DE1Eu, 0xFF0089C2u, 0xFFFF7B41u, 0xFF21D5DDu, 0xFF1835A6u, 0xFF83FF01u, 0xFF71FEFAu,
+		0xFFF6AF30u, 0xFFCBE61Au, 0xFF26DBE0u, 0xFF93FE06u, 0xFF0DB8D2u, 0xFFFD9439u, 0xFF2CE0E2u, 0xFF0085C1u,
+		0xFFCA1866u, 0xFF15C5D7u, 0xFF75FFFCu, 0xFF58068Cu, 0xFF1539A7u, 0xFF44F0EBu, 0xFFDF2B5Du, 0xFFB2F511u,
+		0xFF0757B2u, 0xFF34E7E5u, 0xFF4D0B90u, 0xFF018CC3u, 0xFFFB9F36u, 0xFFC4EB17u, 0xFF63FCF6u, 0xFFDD295Eu,
+		0xFFE0D223u, 0xFFFF833Fu, 0xFF16C6D7u, 0xFFED3F55u, 0xFF7B0081u, 0xFF0C4AAEu, 0xFFE5325Au, 0xFF371698u,
+		0xFFBA0E6Cu, 0xFF2BDFE2u, 0xFF680287u, 0xFF0FBCD3u, 0xFFFA5C4Bu, 0xFF53F7F0u, 0xFF480D92u, 0xFFBFEE15u,
+		0xFF1638A7u, 0xFFF6514Fu, 0xFF63FCF6u, 0xFF421094u, 0xFF0461B5u, 0xFF10BDD4u, 0xFF85007Eu, 0xFF79FFFDu,
+		0xFFDAD920u, 0xFF9A0377u, 0xFF1835A6u, 0xFFC1ED16u, 0xFFB60C6Du, 0xFF2A219Du, 0xFF8DFE04u, 0xFF6CFDF9u,
+		0xFF1835A6u, 0xFF12C0D5u, 0xFFDF2B5Du, 0xFF430F94u, 0xFFCAE719u, 0xFFEB3B57u, 0xFFB30B6Fu, 0xFF0BB4D0u,
+		0xFF7A0081u, 0xFF0852B1u, 0xFFD92460u, 0xFF0075BCu, 0xFFB10A6Fu, 0xFFD6DD1Eu, 0xFF650388u, 0xFFA2FA0Bu,
+		0xFF401195u, 0xFFF8574Du, 0xFFC5EB17u, 0xFFEE3F55u, 0xFF94FD07u, 0xFF950278u, 0xFF0081C0u, 0xFF62FBF5u,
+		0xFF780082u, 0xFFC31369u, 0xFF89FF03u, 0xFF1E2EA3u, 0xFFEB3B57u, 0xFF11BFD4u, 0xFF3E1295u, 0xFFFC6548u,
+		0xFF44F0EBu, 0xFF1A33A5u, 0xFF91FE06u, 0xFF3D1296u, 0xFFF7AC31u, 0xFF21D5DDu, 0xFFABF80Eu, 0xFFFF893Du,
+		0xFF0461B6u, 0xFFBDEF15u, 0xFF133CA9u, 0xFFEBC329u, 0xFF2F1C9Bu, 0xFF8DFE04u, 0xFFB00970u, 0xFF09AECEu,
+		0xFF640388u, 0xFFFD9539u, 0xFF0298C7u, 0xFFDCD721u, 0xFFA60673u, 0xFFADF70Fu, 0xFFFC9938u, 0xFFEB3B57u,
+		0xFF0366B7u, 0xFF1BCEDAu, 0xFFFD6C46u, 0xFF018EC4u, 0xFF27DBE0u, 0xFFF04454u, 0xFF016EBAu, 0xFFA20574u,
+		0xFFFC6648u, 0xFF750083u, 0xFF9EFB0Au, 0xFF0659B3u, 0xFF5AF9F3u, 0xFF640388u, 0xFF026CB9u, 0xFFFF873Du,
+		0xFFF04453u, 0xFF46F1ECu, 0xFF56078Du, 0xFFFF7C41u, 0xFF7DFFFEu, 0xFF0E45ACu, 0xFFDF2B5Du, 0xFF41EEEAu,
+		0xFFFC9B37u, 0xFF039BC8u, 0xFFA10575u, 0xFF055BB4u, 0xFF29DDE1u, 0xFFFAA235u, 0xFF421094u, 0xFFD7DC1Fu,
+		0xFFF44B51u, 0xFF0BB2D0u, 0xFFFE8B3Cu, 0xFF78FFFDu, 0xFF9E0476u, 0xFFF0BB2Cu, 0xFF0952B0u, 0xFFA3FA0Bu,
+		0xFF6C0286u, 0xFFB80D6Du, 0xFF0293C6u, 0xFF78FFFDu, 0xFFFA5C4Bu, 0xFFAF0970u, 0xFF0084C1u, 0xFF4AF3EEu,
+		0xFFF6514Fu, 0xFF91017Au, 0xFF7BFFFDu, 0xFFD62261u, 0xFF0174BCu, 0xFF2ADEE1u, 0xFFED3E56u, 0xFFE2D124u,
+		0xFF0173BBu, 0xFFA7F90Du, 0xFF7E0080u, 0xFF22D6DDu, 0xFFE12D5Cu, 0xFF4CF4EEu, 0xFF008AC3u, 0xFF57078Du,
+		0xFF8EFE05u, 0xFF391697u, 0xFFD31F63u, 0xFFAAF80Eu, 0xFF730183u, 0xFFFD9539u, 0xFF0BB4D1u, 0xFFCBE61Au,
+		0xFF29DDE1u, 0xFFEFBD2Bu, 0xFF40EEEAu, 0xFFA90772u, 0xFFFE923Au, 0xFFE5CC25u, 0xFF1CCFDAu, 0xFFB7F212u,
+		0xFF1737A7u, 0xFFE9C728u, 0xFFAFF610u, 0xFF29229Eu, 0xFFEFBD2Bu, 0xFF13C2D6u, 0xFFFD6A47u, 0xFF0268B8u,
+		0xFFD2E11Du, 0xFF57F8F2u, 0xFF25259Fu, 0xFFEBC429u, 0xFF05A4CBu, 0xFFCA1866u, 0xFFFE6E45u, 0xFF1CD0DBu,
+		0xFF1B31A4u, 0xFFE3CF24u, 0xFF045FB5u, 0xFF690287u, 0xFFCDE51Au, 0xFF28DCE0u, 0xFFD72361u, 0xFF049FC9u,
+		0xFF31E4E4u, 0xFFFAA235u, 0xFFE63459u, 0xFFCCE51Au, 0xFF1042ABu, 0xFFE7CA27u, 0xFF81007Fu, 0xFF2526A0u,
+		0xFFF1BA2Cu, 0xFF0297C7u, 0xFF9EFB0Au, 0xFFFF7643u, 0xFF7B0081u, 0xFFF9A633u, 0xFF0B4BAEu, 0xFF72FEFBu,
+		0xFFCD1A65u, 0xFF44F0EBu, 0xFFF44C50u, 0xFF1140AAu, 0xFFFF823Fu, 0xFF2A219Du, 0xFFE5CD25u, 0xFFC21369u,
+		0xFF06A7CCu, 0xFFF9A833u, 0xFF39EAE7u, 0xFF0C4AAEu, 0xFF73FEFBu, 0xFFE4CE25u, 0xFF133DA9u, 0xFFD11E63u,
+		0xFF4E0A90u, 0xFF0087C2u, 0xFFFA5D4Bu, 0xFF28239Eu, 0xFF0399C7u, 0xFFDC285Eu, 0xFF33199Au, 0xFF52F7F0u,
+		0xFFBF116Au, 0xFF049FC9u, 0xFF36E8E6u, 0xFFEB3B57u, 0xFF7C0081u, 0xFF87FF03u, 0xFFAA0772u, 0xFF311B9Au,
+		0xFF6F0185u, 0xFFDC285Fu, 0xFFFF7742u, 0xFF770082u, 0xFFB3F411u, 0xFF70FEFAu, 0xFF094FB0u, 0xFF9EFB0Au,
+		0xFF88007Du, 0xFFD42062u, 0xFF34E6E5u, 0xFFFB604Au, 0xFF007DBFu, 0xFF28239Eu, 0xFFFF873Du, 0xFF8E017Bu,
+		0xFFDED522u, 0xFF26259Fu, 0xFF0172BBu, 0xFF630388u, 0xFF3DECE9u, 0xFF07A9CDu, 0xFF88FF03u, 0xFFDA265Fu,
+		0xFF18CAD8u, 0xFF440F93u, 0xFFBF116Au, 0xFF35E7E6u, 0xFF05A4CBu, 0xFFB4F411u, 0xFF4D0A90u, 0xFFFF7A41u,
+		0xFFCCE61Au, 0xFF321A9Au, 0xFFEEBE2Bu, 0xFF0FBBD3u, 0xFF94FD07u, 0xFF9B0377u, 0xFF25D9DFu, 0xFFFD6947u,
+		0xFF65FCF6u, 0xFF85007Eu, 0xFFCCE61Au, 0xFFFB5E4Bu, 0xFFB10A6Fu, 0xFF331A9Au, 0xFFFE6E45u, 0xFF5AF9F3u,
+		0xFFA5F90Cu, 0xFF0B4BAEu, 0xFFC41469u, 0xFFC6E918u, 0xFF7DFFFEu, 0xFF8FFE05u, 0xFF89007Du, 0xFFF5B030u,
+		0xFF490C91u, 0xFFFF7942u, 0xFF980278u, 0xFF007ABDu, 0xFF143BA8u, 0xFF44F0EBu, 0xFF049DC9u, 0xFFF4B32Fu,
+		0xFF16C7D7u, 0xFF99FC08u, 0xFF018CC3u, 0xFF39EAE7u, 0xFFEB3C57u, 0xFF4C0B90u, 0xFFA80772u, 0xFF0296C6u,
+		0xFF5CFAF3u, 0xFFF8A932u, 0xFF341899u, 0xFF9BFC09u, 0xFFBC0F6Bu, 0xFF5EFAF4u, 0xFFB3F411u, 0xFF460E93u,
+		0xFFF7524Fu, 0xFF60FBF5u, 0xFF9DFC09u, 0xFFA40574u, 0xFFFF823Fu, 0xFFF34A51u, 0xFF56078Du, 0xFF6BFDF8u,
+		0xFFC4EB17u, 0xFFFC6349u, 0xFF065AB3u, 0xFFDFD422u, 0xFF2327A0u, 0xFFE93858u, 0xFF15C5D7u, 0xFF960278u,
+		0xFF31E4E4u, 0xFF0193C5u, 0xFF740183u, 0xFFC61568u, 0xFF63FCF6u, 0xFF0657B2u, 0xFF4B0B91u, 0xFFB2F411u,
+		0xFF1D2FA3u, 0xFFE22F5Cu, 0xFF016DB9u, 0xFF52088Eu, 0xFF05A3CBu, 0xFF87FF02u, 0xFF1ACCD9u, 0xFF80007Fu,
+		0xFFE73559u, 0xFFFBA035u, 0xFF12C1D5u, 0xFF54088Eu, 0xFFFE7244u, 0xFF0756B2u, 0xFF16C7D8u, 0xFFF44C51u,
+		0xFF0170BAu, 0xFF96FD07u, 0xFF22D6DEu, 0xFFD1E21Cu, 0xFFFC9A37u, 0xFFD01D64u, 0xFFBCF014u, 0xFFF14553u,
+		0xFF72FEFBu, 0xFFBE116Bu, 0xFF0C49ADu, 0xFFF8A833u, 0xFF1C30A4u, 0xFFDBD821u, 0xFFFE923Au, 0xFFF44D50u,
+		0xFFD0E21Cu, 0xFF016FBAu, 0xFF770082u, 0xFF0BB3D0u, 0xFFEBC429u, 0xFFEF4154u, 0xFF07A8CCu, 0xFF0B4CAEu,
+		0xFF1BCEDAu, 0xFFCA1866u, 0xFF039BC8u, 0xFFF3B52Eu, 0xFF202BA2u, 0xFF1DD0DBu, 0xFF0365B7u, 0xFFFBA135u,
+		0xFF1638A7u, 0xFF7F0080u, 0xFF5DFAF4u, 0xFFFE8F3Bu, 0xFFA80772u, 0xFF4FF5EFu, 0xFFEBC528u, 0xFF1834A6u,
+		0xFFE73559u, 0xFFA0FB0Bu, 0xFFFF7742u, 0xFF007CBEu, 0xFFD9DA20u, 0xFFFC9D36u, 0xFFF24752u, 0xFF0087C2u,
+		0xFFE2D024u, 0xFF17C8D8u, 0xFFFE8F3Bu, 0xFF30E3E4u, 0xFFEEBF2Bu, 0xFFCD1A65u, 0xFF0460B5u, 0xFFDED522u,
+		0xFF0399C8u, 0xFF4AF3EEu, 0xFF8A007Cu, 0xFFE3D024u, 0xFF2BDFE2u, 0xFFCC1A65u, 0xFF2426A0u, 0xFFD4DF1Du,
+		0xFF64FCF6u, 0xFFC61568u, 0xFF3B1496u, 0xFFF54F50u, 0xFF6AFDF8u, 0xFF51098Fu, 0xFF1F2CA2u, 0xFF026CB9u,
+		0xFFFF863Eu, 0xFF53088Eu, 0xFFCEE41Bu, 0xFF8D017Bu, 0xFF20D3DCu, 0xFF0076BCu, 0xFF46F1ECu, 0xFF2C1F9Du,
+		0xFF15C6D7u, 0xFFDE2A5Eu, 0xFFFF7643u, 0xFF50F6F0u, 0xFF1835A6u, 0xFF5E058Au, 0xFFAC0871u, 0xFFFAA434u,
+		0xFFCDE51Au, 0xFFFF7F40u, 0xFF50098Fu, 0xFF4EF5EFu, 0xFFBDEF14u, 0xFFCD1A65u, 0xFFD7DC1Fu, 0xFFA50673u,
+		0xFF05A3CBu, 0xFFE73559u, 0xFFA6F90Cu, 0xFF018FC4u, 0xFF5C058Bu, 0xFF85FF02u, 0xFF0077BCu, 0xFFFE933Au,
+		0xFFA00475u, 0xFF6BFDF8u, 0xFF53088Eu, 0xFF1F2DA3u, 0xFFE3305Bu, 0xFF0CB6D1u, 0xFF760083u, 0xFF54F8F1u,
+		0xFFAD0971u, 0xFF3B1496u, 0xFF9FFB0Au, 0xFF8D017Bu, 0xFFEE4155u, 0xFF5FFBF5u, 0xFF450E93u, 0xFFFF873Du,
+		0xFF28239Eu, 0xFFB1F510u, 0xFF0F43ABu, 0xFFF54E50u, 0xFF007BBEu, 0xFFC0ED16u, 0xFFFE903Au, 0xFF92017Au,
+		0xFF09AECEu, 0xFFE6CC26u, 0xFF1042ABu, 0xFF0CB6D1u, 0xFFA00475u, 0xFFEBC329u, 0xFF1ACCDAu, 0xFF86007Du,
+		0xFFE0D223u, 0xFF09AFCFu, 0xFF51F6F0u, 0xFFFA5D4Bu, 0xFFD31F62u, 0xFFABF70Eu, 0xFFBB0F6Cu, 0xFF670287u,
+		0xFF8AFF03u, 0xFF1041ABu, 0xFF9E0476u, 0xFFB9F113u, 0xFFFD9738u, 0xFF28DCE0u, 0xFF83FF01u, 0xFF75FFFCu,
+		0xFF016FBAu, 0xFF8E017Bu, 0xFF133DA9u, 0xFFF14553u, 0xFF0AB1CFu, 0xFF6E0185u, 0xFF41EFEAu, 0xFFFD6747u,
+		0xFF26DADFu, 0xFFECC329u, 0xFF321A9Au, 0xFF2FE2E3u, 0xFFFE6D46u, 0xFFC41468u, 0xFF3B1497u, 0xFF11BFD4u,
+		0xFF0B4CAEu, 0xFFF2B82Du, 0xFF07AACDu, 0xFFB8F212u, 0xFFA70673u, 0xFF30E3E4u, 0xFF82FF01u, 0xFFF5B22Fu,
+		0xFF0756B2u, 0xFFFD6B46u, 0xFF77FFFCu, 0xFF018BC3u, 0xFF1042ABu, 0xFFC8E819u, 0xFF9D0476u, 0xFF3DECE9u,
+		0xFFED3E56u, 0xFFBB0F6Cu, 0xFFF6AF30u, 0xFF67FDF7u, 0xFFA30574u, 0xFF421094u, 0xFF43F0EBu, 0xFF0D48ADu,
+		0xFFE6345Au, 0xFF650388u, 0xFFFF823Fu, 0xFFAFF60Fu, 0xFF045EB5u, 0xFFFC6548u, 0xFFA0FB0Au, 0xFF48F2EDu,
+		0xFFE22F5Cu, 0xFF2C209Du, 0xFF88FF03u, 0xFF008AC3u, 0xFF3B1497u, 0xFFF0BB2Cu, 0xFF0BB4D0u, 0xFFFF853Eu,
+		0xFF7AFFFDu, 0xFFE8C827u, 0xFF2DE1E2u, 0xFF0295C6u, 0xFFD42062u, 0xFF0364B6u, 0xFFF95A4Cu, 0xFF351899u,
+		0xFFE83758u, 0xFF2EE1E3u, 0xFFE9C728u, 0xFF8EFE05u, 0xFF0659B3u, 0xFFF8AA32u, 0xFF2D1F9Cu, 0xFFAEF60Fu,
+		0xFF5A068Cu, 0xFF016DB9u, 0xFFD01D64u, 0xFFC7E918u, 0xFF0C4AAEu, 0xFF76FFFCu, 0xFFF34952u, 0xFFBCF014u,
+		0xFF33E6E5u, 0xFFC91767u, 0xFFFB5F4Au, 0xFF47F2ECu, 0xFFFE8E3Bu, 0xFF133DA9u, 0xFF421094u, 0xFFC51568u,
+		0xFF09AFCFu, 0xFFE02D5Cu, 0xFFBFEE15u, 0xFF6A0286u, 0xFFF9A733u, 0xFFFA5E4Bu, 0xFF09AECEu, 0xFF9CFC09u,
+		0xFF0170BAu, 0xFF1ACCD9u, 0xFF391597u, 0xFF06A6CCu, 0xFF82FF01u, 0xFFFD6947u, 0xFF0FBBD3u, 0xFFA5F90Cu,
+		0xFFFAA334u, 0xFF0076BCu, 0xFF34E6E5u, 0xFFD21E63u, 0xFF57F8F2u, 0xFF5D058Bu, 0xFF0296C7u, 0xFFB30B6Fu,
+		0xFFFF7842u, 0xFF0658B2u, 0xFFAA0772u, 0xFFFC9B37u, 0xFF33E6E5u, 0xFF0B4CAFu, 0xFF89007Cu, 0xFFEE4055u,
+		0xFF055DB4u, 0xFF430F94u, 0xFFF8544Eu, 0xFF6C0186u, 0xFF26259Fu, 0xFFD8DB1Fu, 0xFF0CB5D1u, 0xFF7F0080u,
+		0xFFB2F510u, 0xFF0294C6u, 0xFFB70D6Du, 0xFF65FCF7u, 0xFF920179u, 0xFFDC285Eu, 0xFF0084C1u, 0xFF7EFFFEu,
+		0xFFB50C6Eu, 0xFFFF883Du, 0xFF11BED4u, 0xFF7D0080u, 0xFFF7AD31u, 0xFF0399C7u, 0xFFE1D124u, 0xFF760082u,
+		0xFF2C1F9Cu, 0xFF8CFE04u, 0xFF055DB4u, 0xFF630389u, 0xFF0190C4u, 0xFFC8E819u, 0xFFF9584Du, 0xFF42EFEBu,
+		0xFFD5DE1Eu, 0xFF1A32A5u, 0xFF26DADFu, 0xFFBE106Bu, 0xFF4BF4EEu, 0xFF4B0B91u, 0xFF0950B0u, 0xFFEEC02Au,
+		0xFF660388u, 0xFFFF7A41u, 0xFFCFE31Bu, 0xFF7E0080u, 0xFFE4315Bu, 0xFF016EBAu, 0xFFBD106Bu, 0xFF55078Du,
+		0xFF79FFFDu, 0xFFC3EC17u, 0xFFA70673u, 0xFF2A219Eu, 0xFFF1B92Du, 0xFFEA3958u, 0xFF133CA9u, 0xFFC8E818u,
+		0xFF2BDFE1u, 0xFFEAC628u, 0xFF75FFFCu, 0xFF620389u, 0xFFF6504Fu, 0xFFD4DF1Du, 0xFF50F6F0u, 0xFFB4F411u,
+		0xFF049EC9u, 0xFFC0116Au, 0xFFA4FA0Cu, 0xFFF6AF30u, 0xFF64FCF6u, 0xFFA20574u, 0xFFFF823Fu, 0xFF4AF3EDu,
+		0xFFF6AD31u, 0xFF440F93u, 0xFFFC6648u, 0xFF28239Eu, 0xFFFE8D3Bu, 0xFF16C7D7u, 0xFFDFD422u, 0xFFF44C51u,
+		0xFF0A4FAFu, 0xFF8CFE04u, 0xFF5BFAF3u, 0xFFF14653u, 0xFF1E2DA3u, 0xFFB30B6Eu, 0xFF23D7DEu, 0xFFFF7F40u,
+		0xFFE5325Au, 0xFF5DFAF4u, 0xFF9A0377u, 0xFFDDD621u, 0xFFD82361u, 0xFF1ACDDAu, 0xFF8A007Cu, 0xFF007DBEu,
+		0xFFFF863Eu, 0xFF52088Eu, 0xFFECC229u, 0xFF0173BBu, 0xFF8AFF03u, 0xFFDD295Eu, 0xFF23D8DEu, 0xFFA90772u,
+		0xFF7AFFFDu, 0xFFD62161u, 0xFF3BEBE8u, 0xFF1737A7u, 0xFFEDC12Au, 0xFF54F7F1u, 0xFFD2E11Cu, 0xFFFF7E40u,
+		0xFF202BA2u, 0xFF0399C7u, 0xFFFD6C46u, 0xFF0EBAD2u, 0xFF86FF02u, 0xFF1FD3DCu, 0xFFFB9E36u, 0xFF371798u,
+		0xFF7B0081u, 0xFF07A9CDu, 0xFFD82360u, 0xFFB8F213u, 0xFF17C9D8u, 0xFF2B209Du, 0xFFCE1B65u, 0xFF57078Du,
+		0xFFFC9B37u, 0xFF3AEAE7u, 0xFF1A33A5u, 0xFF10BED4u, 0xFFE6335Au, 0xFF99FC08u, 0xFF1C30A4u, 0xFF0172BBu,
+		0xFFCF1C64u, 0xFF0FBCD3u, 0xFFC1ED16u, 0xFF0365B7u, 0xFF38E9E7u, 0xFFA1FB0Bu, 0xFF3F1295u, 0xFF8C017Cu,
+		0xFFF3B52Eu, 0xFF0293C6u, 0xFF450E93u, 0xFFDCD821u, 0xFF3CEBE8u, 0xFF9BFC09u, 0xFF4C0B90u, 0xFF0085C1u,
+		0xFFC6EA18u, 0xFF049FC9u, 0xFFFD9738u, 0xFF2328A1u, 0xFF7BFFFEu, 0xFFF8AA32u, 0xFF0853B1u, 0xFF97FD08u,
+		0xFF67FDF7u, 0xFF970278u, 0xFFEF4155u, 0xFF14C4D6u, 0xFFFF7D41u, 0xFF2E1D9Cu, 0xFFD3E01Du, 0xFFFE8D3Bu,
+		0xFF1D2FA4u, 0xFFA7F90Du, 0xFF0082C0u, 0xFFFA5B4Cu, 0xFF11C0D5u, 0xFF6A0286u, 0xFF0C49ADu, 0xFF27DBE0u,
+		0xFF90017Au, 0xFFDF2B5Du, 0xFFE2D124u, 0xFF6D0185u, 0xFF0268B8u, 0xFF960278u, 0xFF6DFEF9u, 0xFF0082C0u,
+		0xFFF34A51u, 0xFF9AFC08u, 0xFF3D1396u, 0xFF0854B1u, 0xFF9C0376u, 0xFFFF8040u, 0xFF0078BDu, 0xFF1BCEDAu,
+		0xFFDFD422u, 0xFF90017Au, 0xFFFF7942u, 0xFF0074BCu, 0xFF51098Fu, 0xFF24D8DFu, 0xFFF7544Eu, 0xFFE0D323u,
+		0xFF680287u, 0xFF2CE0E2u, 0xFFF34952u, 0xFFEFBD2Bu, 0xFF630389u, 0xFFE93858u, 0xFF09AFCFu, 0xFF143BA8u,
+		0xFF49F3EDu, 0xFFFC6349u, 0xFF9F0475u, 0xFF026AB8u, 0xFFD52162u, 0xFFFD6A47u, 0xFF0853B1u, 0xFFF8AA32u,
+		0xFF1FD2DCu, 0xFF58068Cu, 0xFFFA5C4Bu, 0xFF0172BBu, 0xFFA6F90Cu, 0xFF450E93u, 0xFFF14553u, 0xFFBC0F6Cu,
+		0xFF27239Eu, 0xFF049FC9u, 0xFFB4F411u, 0xFF123EA9u, 0xFF730183u, 0xFF63FCF6u, 0xFF0365B7u, 0xFFF04453u,
+		0xFF05A2CAu, 0xFF50098Fu, 0xFFFB9F36u, 0xFFA30574u, 0xFF9BFC09u, 0xFFCF1C64u, 0xFFF3B62Eu, 0xFFF24852u,
+		0xFF96FD07u, 0xFF1ACDDAu, 0xFF3E1296u, 0xFF5AF9F3u, 0xFFD31F63u, 0xFFFC6249u, 0xFFB1F510u, 0xFFC51568u,
+		0xFFEDC02Au, 0xFF4EF5EFu, 0xFFFF7942u, 0xFF0192C5u, 0xFFF4B22Fu, 0xFF64FCF6u, 0xFF8BFF04u, 0xFFF95A4Cu,
+		0xFF0D48ADu, 0xFF71FEFAu, 0xFFD01C64u, 0xFFC1ED16u, 0xFFEDC22Au, 0xFF0A4FAFu, 0xFF8C017Bu, 0xFF7FFFFFu,
+		0xFFB0F510u, 0xFF153AA8u, 0xFF9A0377u, 0xFF018CC3u, 0xFFC31369u, 0xFF6EFEF9u, 0xFFFF8040u, 0xFFB3F411u,
+		0xFFCF1C64u, 0xFF17C9D8u, 0xFFC0EE16u, 0xFFFD9639u, 0xFF08ABCDu, 0xFF6E0185u, 0xFF4FF5EFu, 0xFF9E0476u,
+		0xFF1836A6u, 0xFFE7CA27u, 0xFF10BED4u, 0xFFE22E5Cu, 0xFF760082u, 0xFF08ADCEu, 0xFF38E9E7u, 0xFFDDD622u,
+		0xFFF9A633u, 0xFFFC6349u, 0xFF48F2EDu, 0xFFD21E63u, 0xFFF1BA2Du, 0xFFB70D6Du, 0xFFABF70Eu, 0xFF18CAD9u,
+		0xFF8D017Bu, 0xFFDBD821u, 0xFF2BDFE2u, 0xFF2B209Du, 0xFF70FEFAu, 0xFF0460B5u, 0xFF4A0C91u, 0xFF4BF4EEu,
+		0xFF0078BDu, 0xFFFBA035u, 0xFF0B4CAEu, 0xFFC6EA18u, 0xFFF8A932u, 0xFF1736A6u, 0xFF15C6D7u, 0xFF56078Du,
+		0xFF0462B6u, 0xFF930179u, 0xFF11BFD4u, 0xFFE3305Bu, 0xFFD7DC1Fu, 0xFF1D2EA3u, 0xFF6F0185u, 0xFFDE2A5Eu,
+		0xFF411194u, 0xFFA9F80Eu, 0xFF049EC9u, 0xFF740183u, 0xFF55F8F1u, 0xFFC71667u, 0xFFFC9C37u, 0xFF05A3CBu,
+		0xFFDA265Fu, 0xFFFF833Fu, 0xFF50F6F0u, 0xFF80FF00u, 0xFF212AA1u, 0xFFDBD821u, 0xFF055CB4u, 0xFF6A0286u,
+		0xFFEBC429u, 0xFF2229A1u, 0xFF84007Eu, 0xFF6DFEF9u, 0xFF381698u, 0xFFE9C628u, 0xFFAFF610u, 0xFFD11E63u,
+		0xFF6FFEFAu, 0xFF91FE05u, 0xFFB50C6Eu, 0xFF52F7F0u, 0xFFD4DF1Eu, 0xFFFF7B41u, 0xFFA20574u, 0xFF143BA8u,
+		0xFF16C7D7u, 0xFF5B058Bu, 0xFF0366B7u, 0xFFD7DC1Fu, 0xFF27DCE0u, 0xFF0297C7u, 0xFF55078Du, 0xFFF8AA32u,
+		0xFF49F3EDu, 0xFFCB1866u, 0xFF016FBAu, 0xFFEB3C57u, 0xFFC1ED16u, 0xFFFE8E3Bu, 0xFF05A4CBu, 0xFFCDE41Bu,
+		0xFF780082u, 0xFFB60C6Eu, 0xFFF44C51u, 0xFF2BDFE1u, 0xFF06A5CBu, 0xFF8A007Cu, 0xFFD7DD1Fu, 0xFF43F0EBu,
+		0xFFFD9339u, 0xFF1C30A4u, 0xFFCAE719u, 0xFF51098Fu, 0xFF2FE2E3u, 0xFFBC0F6Bu, 0xFF0298C7u, 0xFF36E8E6u,
+		0xFFE9C728u, 0xFF15C6D7u, 0xFFEF4254u, 0xFF26249Fu, 0xFFFD6847u, 0xFF0CB5D1u, 0xFF92FE06u, 0xFF440F93u,
+		0xFF0079BDu, 0xFFE5CC26u, 0xFF60048Au, 0xFF08ADCEu, 0xFFFA5C4Bu, 0xFF26DADFu, 0xFFA90772u, 0xFF04A0CAu,
+		0xFF43F0EBu, 0xFFF54F50u, 0xFF007EBFu, 0xFF86FF02u, 0xFFED3E56u, 0xFF32E5E5u, 0xFF0269B8u, 0xFFF7534Eu,
+		0xFF351899u, 0xFF88007Du, 0xFF0854B1u, 0xFFF7AB32u, 0xFF1A32A5u, 0xFF018FC4u, 0xFFB3F411u, 0xFF62FCF6u,
+		0xFFE12E5Cu, 0xFF84FF01u, 0xFFAE0970u, 0xFF2F1C9Bu, 0xFFFF833Fu, 0xFFE93758u, 0xFF0952B0u, 0xFFFB604Au,
+		0xFF1933A5u, 0xFFA0FB0Au, 0xFFFF7E40u, 0xFF610489u, 0xFF0EBAD3u, 0xFF990377u, 0xFFDD295Eu, 0xFF1E2DA3u,
+		0xFFFE7344u, 0xFF68FDF8u, 0xFF610489u, 0xFF91FE06u, 0xFF361899u, 0xFFFF7842u, 0xFF008AC3u, 0xFFEC3C56u,
+		0xFF8CFE04u, 0xFFCF1C64u, 0xFF7CFFFEu, 0xFFFB5F4Au, 0xFF0B4BAEu, 0xFFFBA135u, 0xFFB5F312u, 0xFFFF7C41u,
+		0xFF0757B2u, 0xFF9D0376u, 0xFFFAA235u, 0xFF007CBEu, 0xFFCFE31Bu, 0xFF5C058Bu, 0xFF40EEEAu, 0xFFF54F50u,
+		0xFF1E2DA3u, 0xFF30E3E4u, 0xFFCB1966u, 0xFFCEE41Bu, 0xFF351899u, 0xFFF9A733u, 0xFFEB3A57u, 0xFF9AFC08u,
+		0xFF470D92u, 0xFFFAA235u, 0xFF22D6DEu, 0xFFB90E6Du, 0xFF123EA9u, 0xFF980278u, 0xFF0EB9D2u, 0xFFFE8B3Cu,
+		0xFF0089C2u, 0xFF36E7E6u, 0xFFFE6C46u, 0xFF21D5DDu, 0xFFCE1B64u, 0xFF3F1195u, 0xFFFB604Au, 0xFF700185u,
+		0xFF0173BBu, 0xFFFE933Au, 0xFF0EBAD3u, 0xFF4FF5EFu, 0xFF81007Fu, 0xFF99FC08u, 0xFF73FEFBu, 0xFFE2D024u,
+		0xFF980278u, 0xFF0086C1u, 0xFF5EFBF4u, 0xFFEFBE2Bu, 0xFF0E46ACu, 0xFF3CECE8u, 0xFFE2D024u, 0xFF1DD0DBu,
+		0xFFA3FA0Cu, 0xFF039AC8u, 0xFFEEBF2Au, 0xFF0364B6u, 0xFFCE1B65u, 0xFF71FEFAu, 0xFFAB0772u, 0xFF3E1295u,
+		0xFF20D4DDu, 0xFF007ABDu, 0xFFA50674u, 0xFFABF70Eu, 0xFF19CBD9u, 0xFF7F0080u, 0xFF5CFAF4u, 0xFFC61668u,
+		0xFF52088Eu, 0xFF4FF5EFu, 0xFF81FF00u, 0xFF2DE1E2u, 0xFFC11269u, 0xFF055BB3u, 0xFFF2B72Eu, 0xFF940279u,
+		0xFFB3F411u, 0xFFFF7743u, 0xFF055CB4u, 0xFF67FDF7u, 0xFF9D0376u, 0xFF0082C0u, 0xFF4BF4EEu, 0xFF0D48ADu,
+		0xFFC21369u, 0xFFCEE41Bu, 0xFF0659B3u, 0xFFFE6E45u, 0xFFD9DA20u, 0xFFF8A833u, 0xFF5F048Au, 0xFFBAF113u,
+		0xFFEDC02Au, 0xFFE73459u, 0xFFCBE61Au, 0xFF610489u, 0xFF96FD07u, 0xFF0AB0CFu, 0xFFF1B92Du, 0xFF33E5E5u,
+		0xFFD3E01Du, 0xFF202CA2u, 0xFFF24852u, 0xFFC4EB17u, 0xFF0086C1u, 0xFFD42062u, 0xFF1ACDDAu, 0xFF4A0C91u,
+		0xFF0AB0CFu, 0xFFF7534Eu, 0xFF351899u, 0xFFC41468u, 0xFF84FF01u, 0xFFFB604Au, 0xFF5A068Cu, 0xFF0461B6u,
+		0xFFC1126Au, 0xFF421094u, 0xFFF04454u, 0xFF41EFEAu, 0xFFFE923Au, 0xFFB0F510u, 0xFFEAC628u, 0xFF0854B1u,
+		0xFFFC6449u, 0xFFF5B130u, 0xFF5B058Bu, 0xFF06A6CCu, 0xFFE5CD25u, 0xFF321B9Au, 0xFFF8574Du, 0xFF0089C2u,
+		0xFFD1E11Cu, 0xFFEA3958u, 0xFF0F44ACu, 0xFF7F0080u, 0xFFFF7D41u, 0xFF6DFEF9u, 0xFFE02C5Du, 0xFF1DD0DBu,
+		0xFF039AC8u, 0xFF720184u, 0xFFEEBE2Bu, 0xFFEF4254u, 0xFFA3FA0Bu, 0xFF670287u, 0xFFE3D024u, 0xFFFF823Fu,
+		0xFF12C1D5u, 0xFF77FFFCu, 0xFF770082u, 0xFF3E1296u, 0xFF5DFAF4u, 0xFF1BCEDAu, 0xFF0951B0u, 0xFFC31369u,
+		0xFF3C1396u, 0xFF06A6CCu, 0xFF9C0376u, 0xFF026CB9u, 0xFF5FFBF5u, 0xFFF24752u, 0xFF133DA9u, 0xFF92017Au,
+		0xFFD21E63u, 0xFF7CFFFEu, 0xFF5F048Au, 0xFFF4B42Fu, 0xFF0C49ADu, 0xFF361798u, 0xFFCEE41Bu, 0xFFB90E6Du,
+		0xFFFC9D36u, 0xFFBCF014u, 0xFF31E4E4u, 0xFF790082u, 0xFF018EC4u, 0xFF6DFEF9u, 0xFFE3305Bu, 0xFFFAA334u,
+		0xFF39E9E7u, 0xFFD1E21Cu, 0xFF0E45ACu, 0xFFA40574u, 0xFF0DB9D2u, 0xFF2E1E9Cu, 0xFF33E5E5u, 0xFF83007Eu,
+		0xFFCBE61Au, 0xFF53F7F1u, 0xFF202BA2u, 0xFFFF7C41u, 0xFFDE295Eu, 0xFF0363B6u, 0xFF96FD07u, 0xFF23D7DEu,
+		0xFF1F2CA2u, 0xFFFE8E3Bu, 0xFF10BDD4u, 0xFFE6CB26u, 0xFF331A9Au, 0xFFA7F90Du, 0xFF123EA9u, 0xFFDCD721u,
+		0xFFC0116Au, 0xFF45F1EBu, 0xFF2D1E9Cu, 0xFF1BCEDAu, 0xFF113FAAu, 0xFF0DB8D2u, 0xFFD31F63u, 0xFF29219Eu,
+		0xFF930279u, 0xFFF14553u, 0xFF95FD07u, 0xFF0295C6u, 0xFFE02C5Du, 0xFFACF70Eu, 0xFFFD6748u, 0xFF47F2ECu,
+		0xFF89FF03u, 0xFF73FEFBu, 0xFFF8A932u, 0xFF2328A0u, 0xFFDCD721u, 0xFFAE0970u, 0xFF1ACDDAu, 0xFFA1FB0Bu,
+		0xFF018CC3u, 0xFFFE7344u, 0xFF09AECEu, 0xFFA30574u, 0xFF40EEEAu, 0xFFFE8C3Cu, 0xFFF6504Fu, 0xFF045FB5u,
+		0xFF56F8F2u, 0xFF1C30A4u, 0xFFE83659u, 0xFFDCD721u, 0xFFFF843Eu, 0xFF212AA2u, 0xFFB8F213u, 0xFF0BB3D0u,
+		0xFF8C017Bu, 0xFFFE6E45u, 0xFF05A4CBu, 0xFFC0EE15u, 0xFF660388u, 0xFFFA5B4Cu, 0xFF0171BAu, 0xFFDF2B5Du,
+		0xFF0AB1D0u, 0xFFBE106Bu, 0xFF9DFC09u, 0xFF2CE0E2u, 0xFF8C017Cu, 0xFF67FDF7u, 0xFFBA0E6Cu, 0xFFF7AD31u,
+		0xFF770082u, 0xFF77FFFCu, 0xFFBE106Bu, 0xFF0083C0u, 0xFFEF4254u, 0xFF0AB2D0u, 0xFF5F048Au, 0xFFF9594Cu,
+		0xFF016EBAu, 0xFF8CFE04u, 0xFFFE8C3Cu, 0xFFB40B6Eu, 0xFFD5DE1Eu, 0xFFFD6B46u, 0xFF57F9F2u, 0xFFB2F510u,
+		0xFF039DC9u, 0xFFEBC429u, 0xFF026AB8u, 0xFFFE903Au, 0xFF9B0377u, 0xFF1F2CA2u, 0xFF049EC9u, 0xFF7B0081u,
+		0xFF0D47ADu, 0xFFF7534Eu, 0xFFCD1A65u, 0xFF14C3D6u, 0xFFFE6D46u, 0xFF411094u, 0xFFFC9A37u, 0xFF0755B1u,
+		0xFFE9C728u, 0xFF3D1396u, 0xFFB9F113u, 0xFFE12E5Cu, 0xFF8BFE04u, 0xFF018DC3u, 0xFF2FE3E3u, 0xFF630389u,
+		0xFF9AFC09u, 0xFFA70673u, 0xFF12C1D5u, 0xFF0A4EAFu, 0xFF20D4DDu, 0xFFB90D6Du, 0xFF480D92u, 0xFF0854B1u,
+		0xFFE3CF25u, 0xFF7FFFFFu, 0xFF27249Fu, 0xFFD72261u, 0xFFF6AF30u, 0xFF62FBF5u, 0xFF85FF02u, 0xFFFE903Bu,
+		0xFF4F0A8Fu, 0xFF0C49ADu, 0xFFEF4254u, 0xFF0088C2u, 0xFFFAA135u, 0xFFD4DF1Du, 0xFF470D92u, 0xFF07A9CDu,
+		0xFFE32F5Bu, 0xFFA7F90Du, 0xFF53088Eu, 0xFFC9E819u, 0xFF4DF5EFu, 0xFFA10575u, 0xFFF4B32Fu, 0xFF60FBF5u,
+		0xFF371798u, 0xFFD62261u, 0xFF0296C6u, 0xFF7DFFFEu, 0xFF460E93u, 0xFF0267B7u, 0xFF84007Eu, 0xFFFB9E36u,
+		0xFF2DE0E2u, 0xFF1934A6u, 0xFFC61568u, 0xFF54F7F1u, 0xFF13C2D5u, 0xFFD5DE1Eu, 0xFFE93858u, 0xFFFB9E36u,
+		0xFF1CCFDBu, 0xFFC3EC17u, 0xFF0082C0u, 0xFF80007Fu, 0xFF9BFC09u, 0xFF3FEDE9u, 0xFFDA2560u, 0xFF5CFAF4u,
+		0xFF89007Cu, 0xFF24D8DFu, 0xFF0E46ACu, 0xFF60FBF5u, 0xFF480D92u, 0xFF970278u, 0xFFE0D323u, 0xFFD92460u,
+		0xFF007BBEu, 0xFFF2B72Du, 0xFFFE6D46u, 0xFF610489u, 0xFF96FD07u, 0xFFF7AB32u, 0xFF57F8F2u, 0xFFF95A4Cu,
+		0xFFCF1C64u, 0xFF58068Cu, 0xFF97FD07u, 0xFF24D9DFu, 0xFF0293C6u, 0xFFB10A6Fu, 0xFF1835A6u, 0xFF1ED2DCu,
+		0xFFE8C927u, 0xFF74FEFBu, 0xFFC5EA18u, 0xFF660388u, 0xFF123DA9u, 0xFF10BDD4u, 0xFFFD6B46u, 0xFF0755B2u,
+		0xFFE5CC26u, 0xFF34E6E5u, 0xFFFB6249u, 0xFF1A33A5u, 0xFFFD9539u, 0xFF0363B6u, 0xFF9FFB0Au, 0xFF15C6D7u,
+		0xFFFE6F45u, 0xFFC2ED16u, 0xFF740183u, 0xFFF2B82Du, 0xFFF44C51u, 0xFF98FD08u, 0xFF018DC4u, 0xFFE5335Au,
+		0xFF4B0B91u, 0xFFFF7543u, 0xFFBAF113u, 0xFF620389u, 0xFFF4B42Fu, 0xFF411094u, 0xFF3EEDE9u, 0xFFB50C6Eu,
+		0xFF740083u, 0xFF341999u, 0xFFF1BA2Cu, 0xFF2BDFE2u, 0xFF1D2FA3u, 0xFF026BB9u, 0xFF620389u, 0xFFC0ED16u,
+		0xFFEC3D56u, 0xFFFD9439u, 0xFFB40B6Eu, 0xFFFC6249u, 0xFFF5B030u, 0xFF1DD1DBu, 0xFF1B32A5u, 0xFFFF7942u,
+		0xFF6CFDF9u, 0xFF311B9Au, 0xFF04A0CAu, 0xFF4AF3EDu, 0xFFD92560u, 0xFF82007Fu, 0xFF0190C5u, 0xFFAFF60Fu,
+		0xFF1DD1DBu, 0xFF007FBFu, 0xFFFF893Du, 0xFFF44B51u, 0xFF0A4EAFu, 0xFFCCE51Au, 0xFF6F0185u, 0xFFF6514Fu,
+		0xFF0081C0u, 0xFF9E0476u, 0xFFFD6847u, 0xFF3CECE8u, 0xFFD72361u, 0xFF8DFE04u, 0xFF47F2ECu, 0xFF9C0376u,
+		0xFF2F1D9Bu, 0xFF0170BAu, 0xFF0EB9D2u, 0xFFB20A6Fu, 0xFF38E9E7u, 0xFFDF2B5Du, 0xFF6B0286u, 0xFF133CA9u,
+		0xFFBD106Bu, 0xFF35E7E6u, 0xFF2328A1u, 0xFF0FBCD3u, 0xFF9F0475u, 0xFF42EFEBu, 0xFF2B209Du, 0xFFC7E918u,
+		0xFF6CFDF9u, 0xFFA40574u, 0xFF1BCEDAu, 0xFF0A4EAFu, 0xFFFA5D4Bu, 0xFF0080BFu, 0xFFA8F80Du, 0xFF0268B8u,
+		0xFFFE7244u, 0xFF52F6F0u, 0xFFE4315Au, 0xFFAD0871u, 0xFFD6DD1Eu, 0xFFF8554Eu, 0xFFF6AF30u, 0xFF07A9CDu,
+		0xFF321A9Au, 0xFF0075BCu, 0xFFD2E11Cu, 0xFF09AFCFu, 0xFF065AB3u, 0xFFEA3957u, 0xFFC2EC16u, 0xFF0FBBD3u,
+		0xFF8A007Cu, 0xFFA9F80Du, 0xFFEC3D56u, 0xFFD3E01Du, 0xFF0269B8u, 0xFF27DBE0u, 0xFFFF8040u, 0xFF361899u,
+		0xFFAD0971u, 0xFFE7CA26u, 0xFF89007Du, 0xFF40EEEAu, 0xFF470D92u, 0xFFF2B82Du, 0xFF31E4E4u, 0xFFC91767u,
+		0xFFB4F411u, 0xFF3A1497u, 0xFF0CB5D1u, 0xFFE1D223u, 0xFF25259Fu, 0xFF750083u, 0xFFEC3C56u, 0xFFC4EB17u,
+		0xFFFF8A3Cu, 0xFFD21E63u, 0xFF88FF03u, 0xFFEFBD2Bu, 0xFF381698u, 0xFFD7DC1Fu, 0xFF06A5CBu, 0xFFFE913Au,
+		0xFFE4CE25u, 0xFF007ABEu, 0xFFED3D56u, 0xFFDBD820u, 0xFF0755B2u, 0xFFF8AB32u, 0xFFCB1966u, 0xFF09ADCEu,
+		0xFFE6CC26u, 0xFF0460B5u, 0xFFE83758u, 0xFF83FF01u, 0xFF990377u, 0xFF78FFFCu, 0xFFD72361u, 0xFFE6CB26u,
+		0xFF1B31A4u, 0xFF90FE05u, 0xFF07A9CDu, 0xFFFD9838u, 0xFF7BFFFEu, 0xFF0088C2u, 0xFFC21369u, 0xFF39EAE7u,
+		0xFF81FF00u, 0xFF6FFEFAu, 0xFF84007Eu, 0xFF3B1497u, 0xFFACF70Eu, 0xFF54F7F1u, 0xFF5B058Bu, 0xFFCC1A65u,
+		0xFFEEBF2Bu, 0xFF065AB3u, 0xFF470D92u, 0xFFA10475u, 0xFFF1BA2Cu, 0xFF1A32A5u, 0xFFC8E819u, 0xFFE6335Au,
+		0xFF0853B1u, 0xFF66FCF7u, 0xFF2427A0u, 0xFFB5F312u, 0xFFE4315Bu, 0xFF0077BCu, 0xFFFF7D40u, 0xFF202BA2u,
+		0xFF4FF6EFu, 0xFFFBA035u, 0xFF055BB3u, 0xFFB40B6Eu, 0xFFFF873Du, 0xFF20D4DCu, 0xFF0460B5u, 0xFF70FEFAu,
+		0xFF05A3CBu, 0xFF5E048Au, 0xFF42EFEBu, 0xFF90017Au, 0xFF0083C0u, 0xFFF6514Fu, 0xFF29DDE1u, 0xFFA20574u,
+		0xFF6AFDF8u, 0xFF53088Eu, 0xFF83FF01u, 0xFF58F9F2u, 0xFFFE7045u, 0xFF660388u, 0xFF26DADFu, 0xFFF9594Cu,
+		0xFF7A0081u, 0xFFFD9738u, 0xFF3DEDE9u, 0xFF301C9Bu, 0xFF0DB8D2u, 0xFFFF8B3Cu, 0xFF670287u, 0xFF2ADEE1u,
+		0xFFEC3C56u, 0xFF960278u, 0xFF045EB5u, 0xFF6C0286u, 0xFF351899u, 0xFFA5F90Cu, 0xFF83007Fu, 0xFF1539A8u,
+		0xFFFF7942u, 0xFFDB275Fu, 0xFFEFBE2Bu, 0xFF33E5E5u, 0xFFC51568u, 0xFFFE913Au, 0xFF1141AAu, 0xFF039CC8u,
+		0xFF44F0EBu, 0xFFFF833Fu, 0xFF16C8D8u, 0xFF76FFFCu, 0xFFFB5E4Au, 0xFF5F048Au, 0xFF50F6EFu, 0xFF0AB2D0u,
+		0xFF86FF02u, 0xFFF8564Du, 0xFFFC9C37u, 0xFF08ABCDu, 0xFFB80D6Du, 0xFF76FFFCu, 0xFF8FFE05u, 0xFF04A0CAu,
+		0xFF640388u, 0xFFE5325Au, 0xFF9BFC09u, 0xFF68FDF8u, 0xFF018CC3u, 0xFFB6F312u, 0xFFF7AB32u, 0xFF430F93u,
+		0xFFE1D123u, 0xFFF9584Du, 0xFF0D48ADu, 0xFFFD9838u, 0xFF7BFFFEu, 0xFF9CFC09u, 0xFF2A219Du, 0xFFBDEF14u,
+		0xFFFD6847u, 0xFF0B4CAEu, 0xFF90017Au, 0xFFC81767u, 0xFF039AC8u, 0xFFBEEF15u, 0xFF123EA9u, 0xFF95FD07u,
+		0xFF3A1597u, 0xFF0298C7u, 0xFFCFE31Bu, 0xFFCA1866u, 0xFFEAC628u, 0xFF143BA8u, 0xFFBFEE15u, 0xFF0294C6u,
+		0xFFECC229u, 0xFF62FCF6u, 0xFFB9F113u, 0xFFFC6548u, 0xFF0CB6D1u, 0xFFE02C5Du, 0xFF2ADEE1u, 0xFFE0D323u,
+		0xFF4A0C91u, 0xFF18CAD8u, 0xFF0A4DAFu, 0xFFFA5E4Bu, 0xFF0081C0u, 0xFF8E017Bu, 0xFF89FF03u, 0xFFF54F50u,
+		0xFFCEE41Bu, 0xFF26259Fu, 0xFFDE2A5Du, 0xFF92FE06u, 0xFF007EBFu, 0xFFC31469u, 0xFFE1D223u, 0xFF91017Au,
+		0xFF4C0B90u, 0xFF23D7DEu, 0xFF0267B8u, 0xFF6B0286u, 0xFFE2D124u, 0xFF123EA9u, 0xFF8B007Cu, 0xFFF6504Fu,
+		0xFFDDD721u, 0xFF10BED4u, 0xFF92017Au, 0xFF401195u, 0xFFFA5B4Bu, 0xFFC51568u, 0xFF1042ABu, 0xFFE5335Au,
+		0xFF9A0377u, 0xFF16C7D7u, 0xFFC1ED16u, 0xFF4D0B90u, 0xFFE83658u, 0xFF045FB5u, 0xFF730184u, 0xFF039CC8u,
+		0xFFE3305Bu, 0xFF11BFD4u, 0xFFFAA334u, 0xFF29DEE1u, 0xFF311B9Bu, 0xFFE12D5Cu, 0xFF72FEFBu, 0xFF0079BDu,
+		0xFFBD106Bu, 0xFF5CFAF4u, 0xFFFE7244u, 0xFF6F0185u, 0xFF0172BBu, 0xFF58F9F2u, 0xFFB50C6Eu, 0xFF470D92u,
+		0xFFFF833Fu, 0xFF1638A7u, 0xFFC71667u, 0xFF3EEDE9u, 0xFFD2E11Du, 0xFF0B4CAEu, 0xFFFB9E36u, 0xFFF04354u,
+		0xFF039BC8u, 0xFFA80772u, 0xFFA7F90Du, 0xFF60048Au, 0xFFE1D223u, 0xFF7FFFFFu, 0xFF13C3D6u, 0xFF4F0A8Fu,
+		0xFFAB0871u, 0xFF0088C2u, 0xFF7C0081u, 0xFFFBA035u, 0xFF143BA8u, 0xFF3BEBE8u, 0xFFFF7A42u, 0xFF0294C6u,
+		0xFFF4B32Fu, 0xFFD21E63u, 0xFFACF70Fu, 0xFF4BF4EEu, 0xFFF24653u, 0xFF14C5D7u, 0xFFF9A534u, 0xFF2C1F9Cu,
+		0xFF3BEBE8u, 0xFF0F43ABu, 0xFFFE903Bu, 0xFFE4CE25u, 0xFF17C8D8u, 0xFF83007Eu, 0xFF3EEDE9u, 0xFF0191C5u,
+		0xFFA5F90Cu, 0xFF60FBF5u, 0xFFC71667u, 0xFF08ADCEu, 0xFFE5CD25u, 0xFFB30B6Fu, 0xFFFF863Eu, 0xFF42EFEAu,
+		0xFFEBC528u, 0xFF3C1396u, 0xFFA8F90Du, 0xFF0363B6u, 0xFFDCD721u, 0xFFFF8B3Cu, 0xFF970278u, 0xFFEDC12Au,
+		0xFFF34A51u, 0xFFAAF80Eu, 0xFF1B31A4u, 0xFF1FD3DCu, 0xFFED3F55u, 0xFF95FD07u, 0xFFF95A4Cu, 0xFF0AB1CFu,
+		0xFF24D9DFu, 0xFF60048Au, 0xFF0190C5u, 0xFFF4B42Fu, 0xFFA40574u, 0xFF52088Eu, 0xFF69FDF8u, 0xFF0268B8u,
+		0xFFC6EA18u, 0xFF53F7F0u, 0xFFFD9738u, 0xFF06A7CCu, 0xFF2229A1u, 0xFFE6345Au, 0xFFFB9E36u, 0xFF026BB9u,
+		0xFFE8C827u, 0xFF63FCF6u, 0xFFC5EA18u, 0xFF08ABCDu, 0xFF411194u, 0xFFBAF113u, 0xFFE02C5Du, 0xFF0C4AAEu,
+		0xFF59F9F2u, 0xFF29229Eu, 0xFF9D0476u, 0xFFFF883Du, 0xFF3F1195u, 0xFFC1ED16u, 0xFF0087C2u, 0xFFD21F63u,
+		0xFFA2FA0Bu, 0xFFC0126Au, 0xFF5DFAF4u, 0xFF0076BCu, 0xFF2427A0u, 0xFF80FF00u, 0xFFFF7B41u, 0xFFECC22Au,
+		0xFF3A1497u, 0xFF055CB4u, 0xFFFF7443u, 0xFF2328A1u, 0xFF56F8F1u, 0xFF007ABEu, 0xFFD2E01Du, 0xFF1B31A4u,
+		0xFFD01D64u, 0xFF66FCF7u, 0xFF6E0185u, 0xFFEF4254u, 0xFF49F3EDu, 0xFF54088Eu, 0xFF18C9D8u, 0xFF1638A7u,
+		0xFF34E6E5u, 0xFF4E0A90u, 0xFF07AACDu, 0xFFF1B92Du, 0xFF950279u, 0xFF36E8E6u, 0xFF28239Eu, 0xFFD0E21Cu,
+		0xFFDE2A5Eu, 0xFF85FF02u, 0xFFF34952u, 0xFF2D1F9Cu, 0xFF1ED1DCu, 0xFFFF7E40u, 0xFF91FE06u, 0xFF88007Du,
+		0xFFD62261u, 0xFF311B9Bu, 0xFFF7534Eu, 0xFF25D9DFu, 0xFFB60C6Eu, 0xFFBEEF15u, 0xFF371798u, 0xFF20D4DDu,
+		0xFFC91767u, 0xFFFE6F45u, 0xFF2EE2E3u, 0xFFF54D50u, 0xFFAA0772u, 0xFF1CCFDBu, 0xFF700185u, 0xFF98FD08u,
+		0xFFF7544Eu, 0xFFDADA20u, 0xFF04A1CAu, 0xFF0A4DAFu, 0xFF28DDE0u, 0xFFB90E6Cu, 0xFF61FBF5u, 0xFFFF7643u,
+		0xFF0170BAu, 0xFF730184u, 0xFFF7544Eu, 0xFFCCE51Au, 0xFFDA265Fu, 0xFF51F6F0u, 0xFF630389u, 0xFF21D5DDu,
+		0xFFEC3D56u, 0xFF81007Fu, 0xFFF4B32Fu, 0xFF8FFE05u, 0xFF640388u, 0xFFF8574Du, 0xFF2DE1E3u, 0xFF9C0377u,
+		0xFFB6F312u, 0xFF0076BCu, 0xFFFF7842u, 0xFFAC0871u, 0xFF0296C6u, 0xFF92FE06u, 0xFFFB6149u, 0xFFCAE719u,
+		0xFF84007Eu, 0xFFFB9D36u, 0xFFCE1B65u, 0xFFB9F113u, 0xFF0267B7u, 0xFFFD9439u, 0xFF7A0081u, 0xFF0951B0u,
+		0xFF3FEDE9u, 0xFF8A007Cu, 0xFF71FEFAu, 0xFFBFEE15u, 0xFF0172BBu, 0xFFD01D64u, 0xFF07AACDu, 0xFF1933A5u,
+		0xFFF2B72Du, 0xFF0074BCu, 0xFF750083u, 0xFF8EFE05u, 0xFF1042ABu, 0xFF4CF4EEu, 0xFFFC6249u, 0xFF83007Eu,
+		0xFFA9F80Du, 0xFF1736A6u, 0xFF58068Cu, 0xFF0362B6u, 0xFFE5CC26u, 0xFFFF893Du, 0xFF6DFEF9u, 0xFF0085C1u,
+		0xFF55078Du, 0xFF21D5DDu, 0xFFF7AC31u, 0xFFDF2C5Du, 0xFF8CFE04u, 0xFF690287u, 0xFFE7CB26u, 0xFF430F94u,
+		0xFF1DD0DBu, 0xFFC2EC16u, 0xFF08ACCEu, 0xFF50098Fu, 0xFFF6AE31u, 0xFF0295C6u, 0xFFB00A70u, 0xFF0E45ACu,
+		0xFFD0E21Cu, 0xFF0080C0u, 0xFF11BFD5u, 0xFF38E9E7u, 0xFFD92560u, 0xFFBEEE15u, 0xFF4E0A90u, 0xFF0AB1CFu,
+		0xFFFD9439u, 0xFF20D4DDu, 0xFF28239Eu, 0xFFE4CE25u, 0xFF0F43ABu, 0xFFD11D63u, 0xFF08ACCEu, 0xFF055EB4u,
+		0xFFE73559u, 0xFF52F7F0u, 0xFF0088C2u, 0xFF341999u, 0xFF7CFFFEu, 0xFFE83659u, 0xFF0FBCD3u, 0xFFF0BB2Cu,
+		0xFF007BBEu, 0xFFFD9738u, 0xFF0E46ACu, 0xFFFC6448u, 0xFF710184u, 0xFFE7CA26u, 0xFF4DF4EEu, 0xFFFA5D4Bu,
+		0xFF28DCE0u, 0xFFD6DE1Eu, 0xFF6FFEFAu, 0xFFDB275Fu, 0xFFF8A932u, 0xFF018FC4u, 0xFFDCD721u, 0xFF0757B2u,
+		0xFF46F1ECu, 0xFFF6AF30u, 0xFFDE2A5Du, 0xFF84FF01u, 0xFF10BDD4u, 0xFF1E2DA3u, 0xFFBB0F6Cu, 0xFFCCE51Au,
+		0xFFD82460u, 0xFF153AA8u, 0xFF81007Fu, 0xFF75FFFCu, 0xFFFA5C4Bu, 0xFF0AB1D0u, 0xFF055CB4u, 0xFFE83758u,
+		0xFFFB9F36u, 0xFF1C30A4u, 0xFFAE0970u, 0xFF2CDFE2u, 0xFF0756B2u, 0xFFF7524Eu, 0xFFB5F311u, 0xFFFE8F3Bu,
+		0xFF5BFAF3u, 0xFFCB1966u, 0xFFFD6748u, 0xFF930279u, 0xFF0A4FAFu, 0xFF039BC8u, 0xFFF2B82Du, 0xFF1637A7u,
+		0xFFF24752u, 0xFF7D0080u, 0xFFA6F90Cu, 0xFF38E9E7u, 0xFFFC9A37u, 0xFF77FFFCu, 0xFF401195u, 0xFFF4B32Fu,
+		0xFF22D7DEu, 0xFF87FF02u, 0xFFFC6349u, 0xFFA70673u, 0xFFD8DC1Fu, 0xFF480D92u, 0xFFA2FA0Bu, 0xFFB00A70u,
+		0xFF341999u, 0xFFDADA20u, 0xFF13C3D6u, 0xFFB30B6Fu, 0xFF35E7E6u, 0xFF2526A0u, 0xFFB1F510u, 0xFF4E0A90u,
+		0xFFB60C6Eu, 0xFF0297C7u, 0xFFFF7543u, 0xFF401195u, 0xFF13C2D6u, 0xFFA90772u, 0xFF57078Du, 0xFFF04354u,
+		0xFF0DB7D2u, 0xFFA00475u, 0xFF0192C5u, 0xFF3EEDE9u, 0xFF86007Eu, 0xFFEE4055u, 0xFF026AB8u, 0xFFF3B62Eu,
+		0xFF46F2ECu, 0xFFFF7E40u, 0xFFB6F312u, 0xFF0173BBu, 0xFF331999u, 0xFFD3E01Du, 0xFF990377u, 0xFF2FE2E3u,
+		0xFF97FD07u, 0xFF7FFFFFu, 0xFFFF7B41u, 0xFFE0D323u, 0xFFCA1866u, 0xFF6AFDF8u, 0xFF212AA1u, 0xFF09AFCFu,
+		0xFF4E0A90u, 0xFF9EFB0Au, 0xFF2526A0u, 0xFFDAD920u, 0xFFFE923Au, 0xFF42EFEBu, 0xFFB80D6Du, 0xFF87FF02u,
+		0xFF6EFEF9u, 0xFFC91767u, 0xFF0192C5u, 0xFF59068Cu, 0xFFF04354u, 0xFF8F017Bu, 0xFFD7DC1Fu, 0xFFBB0F6Cu,
+		0xFF2229A1u, 0xFF790082u, 0xFF1041ABu, 0xFF18CAD9u, 0xFFFF7D41u, 0xFF055CB4u, 0xFF47F2ECu, 0xFFF8564Du,
+		0xFF05A2CAu, 0xFFD62261u, 0xFF51098Fu, 0xFF97FD08u, 0xFFF9A733u, 0xFF0086C1u, 0xFFDD285Eu, 0xFFFD9339u,
+		0xFF0E45ACu, 0xFFBBF014u, 0xFF8F017Au, 0xFF0363B6u, 0xFFADF60Fu, 0xFFFF813Fu, 0xFF69FDF8u, 0xFF94FD07u,
+		0xFF3C1396u, 0xFFFF7443u, 0xFFC9E819u, 0xFF301C9Bu, 0xFFFD9838u, 0xFFB0F510u, 0xFF24D8DEu, 0xFF331999u,
+		0xFF039DC9u, 0xFFAF0970u, 0xFF18CAD9u, 0xFFEEC02Au, 0xFFC31369u, 0xFF49F3EDu, 0xFFFE8D3Bu, 0xFF0D47ADu,
+		0xFFD31F63u, 0xFF82007Fu, 0xFF007BBEu, 0xFF321A9Au, 0xFF8DFE04u, 0xFF6D0186u, 0xFFF0BB2Cu, 0xFFAA0772u,
+		0xFFF54E50u, 0xFF1FD2DCu, 0xFF0173BBu, 0xFF75FFFCu, 0xFF600489u, 0xFFEA3A57u, 0xFF381697u, 0xFF1ACCD9u,
+		0xFF0951B0u, 0xFFFAA334u, 0xFFDBD920u, 0xFF1934A5u, 0xFF0DB7D2u, 0xFFAEF60Fu, 0xFF32E5E5u, 0xFF007FBFu,
+		0xFFFF8A3Cu, 0xFFC3EC17u, 0xFF65FCF6u, 0xFFEFBE2Bu, 0xFFD92560u, 0xFF0AB2D0u, 0xFF84007Eu, 0xFFCAE719u,
+		0xFF6CFEF9u, 0xFFFF7842u, 0xFF28DCE0u, 0xFF0269B8u, 0xFFF14553u, 0xFF7BFFFDu, 0xFF980278u, 0xFF06A5CBu,
+		0xFF55F8F1u, 0xFFEC3D56u, 0xFF1DD1DBu, 0xFFE7C927u, 0xFF37E9E7u, 0xFF1736A7u, 0xFFE02D5Cu, 0xFF007DBEu,
+		0xFFE8C827u, 0xFF4DF4EEu, 0xFF0950B0u, 0xFFC91767u, 0xFF7BFFFEu, 0xFF4F0A8Fu, 0xFFFE7144u, 0xFF7B0081u,
+		0xFFA1FA0Bu, 0xFFF14653u, 0xFF1934A6u, 0xFF650388u, 0xFFFD6847u, 0xFF0191C5u, 0xFFBEEE15u, 0xFF60048Au,
+		0xFF0FBBD3u, 0xFFF0BC2Cu, 0xFFF34A51u, 0xFF35E7E6u, 0xFF05A1CAu, 0xFFFD6B46u, 0xFF25D9DFu, 0xFF0364B6u,
+		0xFFD8DC1Fu, 0xFF82007Fu, 0xFFF7AB31u, 0xFFC1126Au, 0xFFA8F80Du, 0xFF008AC3u, 0xFFFF7742u, 0xFFCCE61Au,
+		0xFF690287u, 0xFFF8554Du, 0xFF56F8F2u, 0xFFB40B6Eu, 0xFFFF7842u, 0xFF0B4DAFu, 0xFF650388u, 0xFFF9594Cu,
+		0xFF12C0D5u, 0xFFC81767u, 0xFF0075BCu, 0xFF5C058Bu, 0xFF99FC08u, 0xFF29229Eu, 0xFFF8A932u, 0xFF0F43ABu,
+		0xFF9FFB0Au, 0xFF88007Du, 0xFFE9C727u, 0xFF1C2FA4u, 0xFF750083u, 0xFFD5DE1Eu, 0xFF301C9Bu, 0xFFA4FA0Cu,
+		0xFFF2B72Eu, 0xFF670287u, 0xFF2328A0u, 0xFFFB614Au, 0xFFBF116Au, 0xFF750083u, 0xFFF6B030u, 0xFF26DADFu,
+		0xFFC41468u, 0xFF670287u, 0xFFF34A51u, 0xFF018BC3u, 0xFFE6CB26u, 0xFF0CB6D1u, 0xFFD52162u, 0xFF4EF5EFu,
+		0xFFEBC429u, 0xFF007DBEu, 0xFF67FDF7u, 0xFF81FF01u, 0xFF2ADEE1u, 0xFF27249Fu, 0xFFEE4155u, 0xFF60FBF5u,
+		0xFFABF70Eu, 0xFF1737A7u, 0xFF58068Cu, 0xFFC7E918u, 0xFFA00475u, 0xFF133DA9u, 0xFFAFF60Fu, 0xFFD72361u,
+		0xFF4EF5EFu, 0xFF2F1D9Bu, 0xFFFB614Au, 0xFF15C5D7u, 0xFF0E46ACu, 0xFFE8C927u, 0xFF4DF5EEu, 0xFF980278u,
+		0xFF007DBFu, 0xFF0FBCD3u, 0xFF460E92u, 0xFF9AFC08u, 0xFF42EFEAu, 0xFFF1B92Du, 0xFFDC275Fu, 0xFF5FFBF5u,
+		0xFFE4CE25u, 0xFF2F1D9Bu, 0xFFF54D50u, 0xFF27DBE0u, 0xFFAD0871u, 0xFF5CFAF4u, 0xFFF24852u, 0xFFBF116Au,
+		0xFF391597u, 0xFF008BC3u, 0xFFE12D5Cu, 0xFF43F0EBu, 0xFFFF863Eu, 0xFF0EB9D2u, 0xFFF8564Du, 0xFF2CE0E2u,
+		0xFF0170BAu, 0xFFD11D64u, 0xFF8AFF03u, 0xFF76FFFCu, 0xFF06A7CCu, 0xFFC7E918u, 0xFF045EB4u, 0xFF351899u,
+		0xFFB5F311u, 0xFF0CB5D1u, 0xFFFBA035u, 0xFF8EFE05u, 0xFF8E017Bu, 0xFF1934A5u, 0xFFBCF014u, 0xFF0756B2u,
+		0xFFA00475u, 0xFF450E93u, 0xFFFE923Au, 0xFFD62261u, 0xFF8D017Bu, 0xFFF4B42Eu, 0xFF016DB9u, 0xFFC21369u,
+		0xFFFE7344u, 0xFF0298C7u, 0xFF52F7F0u, 0xFFFC9937u, 0xFFEA3958u, 0xFF61FBF5u, 0xFF53088Eu, 0xFFFE8C3Cu,
+		0xFF0191C5u, 0xFF82FF01u, 0xFF37E9E7u, 0xFF490C91u, 0xFFE63459u, 0xFF0BB3D0u, 0xFF1F2CA2u, 0xFFD01D64u,
+		0xFFF5B030u, 0xFFBDEF14u, 0xFFDE2A5Eu, 0xFF0269B8u, 0xFF7F0080u, 0xFF039AC8u, 0xFF391597u, 0xFF93FD06u,
+		0xFF065AB3u, 0xFF8D017Bu, 0xFFB8F213u, 0xFFFE8C3Cu, 0xFF0191C5u, 0xFFDED522u, 0xFF0267B7u, 0xFF31E4E4u,
+		0xFFFE913Au, 0xFF15C6D7u, 0xFFCDE51Bu, 0xFFA60673u, 0xFF86FF02u, 0xFF0853B1u, 0xFF54078Du, 0xFFB00A70u,
+		0xFFFE8B3Cu, 0xFF11BFD5u, 0xFF0854B1u, 0xFFFC9C37u, 0xFF4A0C91u, 0xFFEE4055u, 0xFF5BFAF3u, 0xFFFF853Eu,
+		0xFF940279u, 0xFF0D48ADu, 0xFF61FBF5u, 0xFF480D92u, 0xFF2EE1E3u, 0xFFEF4155u, 0xFFF7AB32u, 0xFF06A7CCu,
+		0xFFFA5D4Bu, 0xFF3AEBE8u, 0xFFDAD920u, 0xFF0754B1u, 0xFF12C2D5u, 0xFFCBE61Au, 0xFF4E0A90u, 0xFF2FE2E3u,
+		0xFF960278u, 0xFFE0D323u, 0xFFD82460u, 0xFF212AA1u, 0xFF016EBAu, 0xFFE9C728u, 0xFF09ADCEu, 0xFF8C017Cu,
+		0xFF1539A7u, 0xFFF3B52Eu, 0xFFA60673u, 0xFFBFEE15u, 0xFFFE913Au, 0xFF8B017Cu, 0xFF93FE06u, 0xFFFE7045u,
+		0xFF72FEFBu, 0xFF1637A7u, 0xFF23D7DEu, 0xFFFE8F3Bu, 0xFFF44B51u, 0xFFD0E31Cu, 0xFFAB0871u, 0xFF24D8DEu,
+		0xFFFD9539u, 0xFF05A2CAu, 0xFF43F0EBu, 0xFF0D47ADu, 0xFF50098Fu, 0xFFFD6A47u, 0xFF780082u, 0xFFB6F312u,
+		0xFF0B4DAFu, 0xFFF44D50u, 0xFF4C0B90u, 0xFF0077BDu, 0xFF59F9F3u, 0xFFD82460u, 0xFFDAD920u, 0xFF68FDF7u,
+		0xFFB4F411u, 0xFF460E93u, 0xFF940279u, 0xFFDAD920u, 0xFF007BBEu, 0xFFAC0871u, 0xFF92FE06u, 0xFF13C2D6u,
+		0xFFF64F4Fu, 0xFFDFD422u, 0xFFCE1B64u, 0xFFFE6C46u, 0xFF016FBAu, 0xFFAF0970u, 0xFF64FCF6u, 0xFF371698u,
+		0xFF94FD07u, 0xFFC21269u, 0xFF049EC9u, 0xFF5E048Au, 0xFFF7524Fu, 0xFF79FFFDu, 0xFFFF863Eu, 0xFF9AFC09u,
+		0xFF0755B1u, 0xFF1ED2DCu, 0xFF760083u, 0xFF92FE06u, 0xFF36E8E6u, 0xFFBA0E6Cu, 0xFFC5EA17u, 0xFFF34952u,
+		0xFF7DFFFEu, 0xFFDC275Fu, 0xFF0080BFu, 0xFF0950B0u, 0xFF65FCF7u, 0xFF311B9Au, 0xFF1ED1DBu, 0xFF0362B6u,
+		0xFF720184u, 0xFFBA0E6Cu, 0xFFE7CA26u, 0xFF2A219Du, 0xFF0BB2D0u, 0xFF7CFFFEu, 0xFF0F43ABu, 0xFFFB5F4Au,
+		0xFF5F048Au, 0xFFDA265Fu, 0xFFF1BA2Cu, 0xFFC1126Au, 0xFF82FF01u, 0xFF4CF4EEu, 0xFF0BB4D1u, 0xFFD72361u,
+		0xFF6BFDF9u, 0xFFEAC528u, 0xFF2EE2E3u, 0xFFFE7145u, 0xFF6D0185u, 0xFFF8A833u, 0xFF0297C7u, 0xFF27239Fu,
+		0xFFFC6548u, 0xFF3DECE9u, 0xFFE5325Au, 0xFF1CD0DBu, 0xFFFD6A47u, 0xFF43F0EBu, 0xFF153AA8u, 0xFF630389u,
+		0xFF0084C1u, 0xFF40EEEAu, 0xFF2F1D9Bu, 0xFFAAF80Eu, 0xFF13C3D6u, 0xFFD8DB1Fu, 0xFFFF813Fu, 0xFF790082u,
+		0xFF1FD3DCu, 0xFF1835A6u, 0xFFFE7244u, 0xFFA4FA0Cu, 0xFFB10A6Fu, 0xFF202BA2u, 0xFF018EC4u, 0xFFEA3A57u,
+		0xFF401195u, 0xFFF9A534u, 0xFF0081C0u, 0xFFF8554Eu, 0xFF3C1496u, 0xFFFF813Fu, 0xFF22D6DEu, 0xFF460E92u,
+		0xFFA5F90Cu, 0xFF0DB8D2u, 0xFF6C0286u, 0xFFF8564Du, 0xFFECC329u, 0xFFC81667u, 0xFFCDE51Bu, 0xFFF24752u,
+		0xFF07ABCDu, 0xFFAEF60Fu, 0xFF3FEEE9u, 0xFF5C058Bu, 0xFF88FF03u, 0xFFC91866u, 0xFFEEC02Au, 0xFF018BC3u,
+		0xFFC5EB17u, 0xFF59F9F3u, 0xFF3A1597u, 0xFF19CBD9u, 0xFFF54E50u, 0xFF1C30A4u, 0xFFF5B22Fu, 0xFFA00475u,
+		0xFFBEEF15u, 0xFF361798u, 0xFFBD106Bu, 0xFFA9F80Du, 0xFF143CA8u, 0xFF23D7DEu, 0xFFF04354u, 0xFF9D0376u,
+		0xFF016DB9u, 0xFFF2B82Du, 0xFF1737A7u, 0xFFA3FA0Bu, 0xFF341999u, 0xFFE7CA26u, 0xFFD52162u, 0xFFF9A534u,
+		0xFFBFEE15u, 0xFFB60C6Eu, 0xFF0366B7u, 0xFFF5B130u, 0xFF650388u, 0xFF143AA8u, 0xFF008AC2u, 0xFFC4EB17u,
+		0xFFE12D5Cu, 0xFFE8C827u, 0xFF56F8F2u, 0xFF045FB5u, 0xFF1CCFDBu, 0xFFECC329u, 0xFFCB1966u, 0xFF4AF3EDu,
+		0xFFD6DD1Eu, 0xFFAD0871u, 0xFF73FEFBu, 0xFFB8F213u, 0xFF04A0CAu, 0xFF9A0377u, 0xFF0363B6u, 0xFFF7AD31u,
+		0xFF1C2FA4u, 0xFFFF7C41u, 0xFFCFE31Bu, 0xFF3FEEEAu, 0xFF0296C7u, 0xFF5D058Bu, 0xFF50F6EFu, 0xFFF2B82Du,
+		0xFF3D1396u, 0xFFFF7F40u, 0xFFE4325Au, 0xFF0082C0u, 0xFF960278u, 0xFFFE7344u, 0xFF26259Fu, 0xFF32E4E4u,
+		0xFFED3E56u, 0xFF123FAAu, 0xFFA9F80Du, 0xFF91017Au, 0xFF0171BBu, 0xFFD8DB1Fu, 0xFF5A068Cu, 0xFF0193C5u,
+		0xFF0F44ACu, 0xFFEF4154u, 0xFF0DB8D2u, 0xFF016CB9u, 0xFFE4CE25u, 0xFF87007Du, 0xFF92FE06u, 0xFF45F1ECu,
+		0xFFC3EB17u, 0xFF6B0286u, 0xFF09AFCFu, 0xFFB50C6Eu, 0xFF31E4E4u, 0xFF720184u, 0xFF039AC8u, 0xFF7AFFFDu,
+		0xFF3C1496u, 0xFFFF803Fu, 0xFF2CE0E2u, 0xFFE12D5Cu, 0xFF6FFEFAu, 0xFFFC6449u, 0xFFBF116Au, 0xFF47F2ECu,
+		0xFF2C1F9Cu, 0xFF08ACCEu, 0xFF9C0376u, 0xFFFD9639u, 0xFF430F94u, 0xFFB5F312u, 0xFF690287u, 0xFF09B0CFu,
+		0xFF0C4AAEu, 0xFFFE7144u, 0xFF2426A0u, 0xFFDA2660u, 0xFF40EEEAu, 0xFFE1D223u, 0xFFEB3B57u, 0xFF58F9F2u,
+		0xFF84007Eu, 0xFF1CCFDAu, 0xFFB80D6Du, 0xFF2D1E9Cu, 0xFF8AFF03u, 0xFFFF843Eu, 0xFF1639A7u, 0xFF0085C1u,
+		0xFFB20A6Fu, 0xFF67FDF7u, 0xFF0C49ADu, 0xFFF7AC31u, 0xFF37E8E6u, 0xFF0EBAD3u, 0xFFB6F312u, 0xFF710184u,
+		0xFFB30B6Fu, 0xFFEAC528u, 0xFF0BB3D0u, 0xFFFF883Du, 0xFF5EFBF4u, 0xFFE3305Bu, 0xFF29DDE1u, 0xFFFE7443u,
+		0xFF4EF5EFu, 0xFF8E017Bu, 0xFFFC9D36u, 0xFF7AFFFDu, 0xFFD62261u, 0xFF2427A0u, 0xFF04A0CAu, 0xFFFF7F40u,
+		0xFFCE1B65u, 0xFF74FFFBu, 0xFFF6504Fu, 0xFFDBD820u, 0xFF055CB4u, 0xFFFF843Eu, 0xFF9CFC09u, 0xFFEA3A57u,
+		0xFF18C9D8u, 0xFF7D0080u, 0xFF89FF03u, 0xFF1D2EA3u, 0xFF970278u, 0xFFAFF610u, 0xFF19CBD9u, 0xFFF6AE31u,
+		0xFFF8574Du, 0xFF620489u, 0xFFBCF014u, 0xFFE5335Au, 0xFF65FCF7u, 0xFF0085C1u, 0xFFF9A733u, 0xFFF54D50u,
+		0xFF85FF02u, 0xFF14C3D6u, 0xFF7A0081u, 0xFFF0BB2Cu, 0xFF0D46ACu, 0xFF6B0286u, 0xFF8AFF03u, 0xFF0399C7u,
+		0xFFD92560u, 0xFFE7C927u, 0xFF0364B7u, 0xFFF34952u, 0xFF20D4DDu, 0xFF9F0475u, 0xFFE93858u, 0xFFA6F90Du,
+		0xFF14C4D6u, 0xFFD9DA20u, 0xFF740083u, 0xFFA4FA0Cu, 0xFFF34A51u, 0xFF4F0A8Fu, 0xFF0756B2u, 0xFFFC9A37u,
+		0xFF6CFEF9u, 0xFF0364B7u, 0xFFF95A4Cu, 0xFF490C91u, 0xFFC8E918u, 0xFF2427A0u, 0xFFB10A6Fu, 0xFF8EFE05u,
+		0xFFECC329u, 0xFF018EC4u, 0xFFB1F510u, 0xFF4B0B91u, 0xFFFE7344u, 0xFF33E6E5u, 0xFFEFBD2Bu, 0xFF59068Cu,
+		0xFF0E46ACu, 0xFF018CC3u, 0xFFFC9C36u, 0xFF411094u, 0xFFDB265Fu, 0xFF51F6F0u, 0xFF89007Cu, 0xFF0A4EAFu,
+		0xFFE1D223u, 0xFF007BBEu, 0xFFF24852u, 0xFF0CB6D1u, 0xFFE6CB26u, 0xFF007EBFu, 0xFF490C91u, 0xFF0757B2u,
+		0xFF80FF00u, 0xFF0077BDu, 0xFF25DADFu, 0xFF1638A7u, 0xFFFC6648u, 0xFFB50C6Eu, 0xFF31E4E4u, 0xFF29229Eu,
+		0xFFC61568u, 0xFF52F6F0u, 0xFFC7E918u, 0xFF0086C1u, 0xFFFF843Eu, 0xFF18CBD9u, 0xFF381698u, 0xFFFE6D46u,
+		0xFF0A4FAFu, 0xFFADF70Fu, 0xFF72FEFBu, 0xFF760083u, 0xFFF5B12Fu, 0xFF0075BCu, 0xFF3CEBE8u, 0xFF680287u,
+		0xFFFB5F4Au, 0xFF26249Fu, 0xFFC71667u, 0xFF016CB9u, 0xFF5FFBF4u, 0xFFDDD622u, 0xFFD52162u, 0xFF06A5CBu,
+		0xFF8BFE04u, 0xFF7D0080u, 0xFF30E3E4u, 0xFFBA0E6Cu, 0xFF008BC3u, 0xFFFAA434u, 0xFF0EB9D2u, 0xFF640388u,
+		0xFFD42062u, 0xFF1F2CA2u, 0xFF1FD3DCu, 0xFFAD0871u, 0xFFC9E819u, 0xFF0365B7u, 0xFFE5325Au, 0xFF19CCD9u,
+		0xFFD4DF1Du, 0xFFA50673u, 0xFF86FF02u, 0xFF22D6DDu, 0xFF0079BDu, 0xFFC4EB17u, 0xFF29229Eu, 0xFFFC6648u,
+		0xFFB40B6Eu, 0xFF41EFEAu, 0xFFF9A534u, 0xFF57068Cu, 0xFF54F7F1u, 0xFFFF8A3Cu, 0xFFEE3F55u, 0xFFA30574u,
+		0xFF7CFFFEu, 0xFFCC1A65u, 0xFFECC229u, 0xFF85007Eu, 0xFFD6DD1Eu, 0xFF055BB4u, 0xFFB0F510u, 0xFF86007Du,
+		0xFF026BB9u, 0xFFFC9938u, 0xFF3F1295u, 0xFFA60673u, 0xFFE4315Bu, 0xFF6FFEFAu, 0xFFDBD920u, 0xFFC0126Au,
+		0xFF3BEBE8u, 0xFF52098Eu, 0xFFFE8C3Cu, 0xFF0191C5u, 0xFFCEE41Bu, 0xFF361798u, 0xFFBEEF15u, 0xFF0852B1u,
+		0xFFFBA135u, 0xFF2DE1E3u, 0xFF049FC9u, 0xFFFF843Eu, 0xFF311B9Au, 0xFFAA0772u, 0xFF29DDE1u, 0xFFFD6748u,
+		0xFF2E1E9Cu, 0xFFE4315Bu, 0xFFDDD621u, 0xFF1539A7u, 0xFF9FFB0Au, 0xFF76FFFCu, 0xFFFB5F4Au, 0xFF055EB4u,
+		0xFF41EEEAu, 0xFFFF8A3Cu, 0xFFEA3A57u, 0xFF311B9Au, 0xFF55F8F1u, 0xFF7A0081u, 0xFF9EFB0Au, 0xFF2E1D9Cu,
+		0xFFFA5C4Bu, 0xFF4BF4EEu, 0xFF1E2DA3u, 0xFFF14653u, 0xFF950279u, 0xFFF0BC2Cu, 0xFF14C4D6u, 0xFF0192C5u,
+		0xFFB7F212u, 0xFF391597u, 0xFF0461B5u, 0xFFC8E918u, 0xFFBD106Bu, 0xFF1041AAu, 0xFF35E7E6u, 0xFFD5DE1Eu,
+		0xFF26259Fu, 0xFFFF853Eu, 0xFF0294C6u, 0xFF3EEDE9u, 0xFF381698u, 0xFF16C7D7u, 0xFFFE7443u, 0xFF6EFEF9u,
+		0xFFE0D323u, 0xFFEE4055u, 0xFF39EAE7u, 0xFF07A9CDu, 0xFF9DFC09u, 0xFF2129A1u, 0xFF87007Du, 0xFF11BED4u,
+		0xFFF4B32Fu, 0xFF1933A5u, 0xFFA20575u, 0xFFE3305Bu, 0xFF51F6F0u, 0xFFFD6847u, 0xFFCD1B65u, 0xFF77FFFCu,
+		0xFFA50673u, 0xFF85FF02u, 0xFFE83659u, 0xFFEAC628u, 0xFF17C9D8u, 0xFFBAF114u, 0xFF5B058Bu, 0xFFF3B62Eu,
+		0xFF0084C1u, 0xFF4EF5EFu, 0xFFFD9638u, 0xFF19CBD9u, 0xFFD82460u, 0xFF82007Fu, 0xFF371798u, 0xFFC5EA17u,
+		0xFF91017Au, 0xFF9CFC09u, 0xFF0079BDu, 0xFFF1B92Du, 0xFFF9584Cu, 0xFF05A4CBu, 0xFFC0116Au, 0xFF38E9E7u,
+		0xFFF3B52Eu, 0xFF720184u, 0xFF05A3CBu, 0xFFFF893Du, 0xFF6EFEFAu, 0xFF4C0B90u, 0xFFD82460u, 0xFFFC9C37u,
+		0xFF5EFBF4u, 0xFFE32F5Bu, 0xFF8F017Bu, 0xFFFF7543u, 0xFF0192C5u, 0xFF95FD07u, 0xFF730184u, 0xFFFAA434u,
+		0xFF1BCDDAu, 0xFF670287u, 0xFFF14653u, 0xFF98FD08u, 0xFFDC285Eu, 0xFFF2B72Du, 0xFF56078Du, 0xFFD52162u,
+		0xFF018DC4u, 0xFF710184u, 0xFFBCF014u, 0xFF0A4DAFu, 0xFFF7544Eu, 0xFFF8AA32u, 0xFF0078BDu, 0xFFB7F212u,
+		0xFFF34952u, 0xFF05A1CAu, 0xFF90FE05u, 0xFF1BCEDAu, 0xFF0D47ADu, 0xFF700184u, 0xFF11C0D5u, 0xFFE8C927u,
+		0xFF0087C2u, 0xFF54088Eu, 0xFF58F9F2u, 0xFF7B0081u, 0xFF1140AAu, 0xFFF6514Fu, 0xFF7DFFFEu, 0xFF0A4EAFu,
+		0xFFC9E719u, 0xFFA30574u, 0xFF3F1195u, 0xFF026AB8u, 0xFFFF7B41u, 0xFF3AEAE8u, 0xFFEFBE2Bu, 0xFF07A8CCu,
+		0xFF1736A6u, 0xFF70FEFAu, 0xFF700184u, 0xFF14C4D6u, 0xFF113FAAu, 0xFFD8DB1Fu, 0xFFFE8E3Bu, 0xFF0084C1u,
+		0xFF0B4BAEu, 0xFFAAF80Eu, 0xFFD52162u, 0xFFD9DA20u, 0xFF0853B1u, 0xFF94FD06u, 0xFF2ADEE1u, 0xFF82007Fu,
+		0xFF1B31A4u, 0xFF9DFB0Au, 0xFF11C0D5u, 0xFF74FFFBu, 0xFFE93858u, 0xFF301C9Bu, 0xFF08ABCDu, 0xFFD42062u,
+		0xFF0174BBu, 0xFFC6EA18u, 0xFF0951B0u, 0xFF6AFDF8u, 0xFF970278u, 0xFF04A1CAu, 0xFF113FAAu, 0xFF8FFE05u,
+		0xFF25D9DFu, 0xFF1B31A4u, 0xFFFF7B41u, 0xFFBC0F6Bu, 0xFF5AF9F3u, 0xFF1FD3DCu, 0xFF450E93u, 0xFFD42062u,
+		0xFF69FDF8u, 0xFF660388u, 0xFFFE6F45u, 0xFFE2D024u, 0xFFBB0F6Cu, 0xFFFB9F36u, 0xFF9DFB0Au, 0xFF25269Fu,
+		0xFFFA5B4Bu, 0xFF0C4AAEu, 0xFFCAE719u, 0xFFC51468u, 0xFF0083C0u, 0xFF9CFC09u, 0xFF950279u, 0xFFDD295Eu,
+		0xFF0DB8D2u, 0xFFF54E50u, 0xFFABF70Eu, 0xFF680287u, 0xFFD5DE1Eu, 0xFF0080BFu, 0xFFAE0970u, 0xFFEE4055u,
+		0xFFFE7444u, 0xFFE1D124u, 0xFFD11E63u, 0xFFADF70Fu, 0xFFAF0970u, 0xFF66FCF7u, 0xFF4A0C91u, 0xFFED3E56u,
+		0xFFAB0871u, 0xFF61FBF5u, 0xFF440F93u, 0xFF19CCD9u, 0xFFA50673u, 0xFFFD6947u, 0xFF0268B8u, 0xFFD6DD1Eu,
+		0xFFF9574Du, 0xFF0077BDu, 0xFFF0BC2Cu, 0xFF55078Du, 0xFFD0E21Cu, 0xFF3DECE9u, 0xFFFD6748u, 0xFFAAF80Eu,
+		0xFF9B0377u, 0xFF2ADEE1u, 0xFFFE7045u, 0xFF2427A0u, 0xFFD1E11Cu, 0xFFFF893Du, 0xFF4DF5EFu, 0xFFF7524Eu,
+		0xFF9E0476u, 0xFFF5B130u, 0xFF0BB4D0u, 0xFF52098Eu, 0xFFD3E01Du, 0xFF9B0377u, 0xFFFF853Eu, 0xFF0C49ADu,
+		0xFFEAC528u, 0xFF0365B7u, 0xFF32E5E4u, 0xFF2D1E9Cu, 0xFF0089C2u, 0xFF3EEDE9u, 0xFF5B058Bu, 0xFFD92560u,
+		0xFF0AB1CFu, 0xFFF6AE30u, 0xFF3AEAE7u, 0xFFFF883Du, 0xFF10BDD4u, 0xFFEDC12Au, 0xFF1F2DA3u, 0xFF30E3E4u,
+		0xFFFAA334u, 0xFF28229Eu, 0xFF68FDF7u, 0xFF14C4D6u, 0xFFE73659u, 0xFF2229A1u, 0xFF8CFE04u, 0xFF1DD0DBu,
+		0xFF0192C5u, 0xFF391597u, 0xFF0658B3u, 0xFF3BEBE8u, 0xFFFD6A47u, 0xFF212AA1u, 0xFF93FD06u, 0xFF0DB7D2u,
+		0xFFDFD423u, 0xFFFE7144u, 0xFF0078BDu, 0xFFF6AD31u, 0xFF1934A6u, 0xFF3FEEEAu, 0xFFC11269u, 0xFF0CB6D1u,
+		0xFF3F1295u, 0xFF37E8E7u, 0xFFAC0871u, 0xFF0D47ADu, 0xFFFD9838u, 0xFF8B017Cu, 0xFF0950B0u, 0xFF5DFAF4u,
+		0xFF3C1396u, 0xFFF5B030u, 0xFFCC1966u, 0xFF610489u, 0xFF14C4D6u, 0xFF065AB3u, 0xFFB70D6Du, 0xFFC3EB17u,
+		0xFF321A9Au, 0xFF7EFFFFu, 0xFFA0FB0Au, 0xFF0658B3u, 0xFFE73659u, 0xFF0190C5u, 0xFF81FF00u, 0xFF45F1ECu,
+		0xFFB90E6Cu, 0xFFADF60Fu, 0xFF86007Du, 0xFFE73559u, 0xFFB8F213u, 0xFFF8554Eu, 0xFF0951B0u, 0xFF5AF9F3u,
+		0xFFAEF60Fu, 0xFF8B017Cu, 0xFF331A9Au, 0xFFEC3D56u, 0xFF6A0287u, 0xFF47F2EDu, 0xFFFD6C46u, 0xFF51098Fu,
+		0xFF88FF03u, 0xFF018FC4u, 0xFFC61568u, 0xFFF5B12Fu, 0xFF8C017Bu, 0xFF55F8F1u, 0xFFFC9B37u, 0xFF6C0186u,
+		0xFFB3F411u, 0xFFE83659u, 0xFFFD9638u, 0xFF06A6CCu, 0xFF680287u, 0xFFEEBF2Au, 0xFF29DDE1u, 0xFF930279u,
+		0xFF1140AAu, 0xFF34E6E5u, 0xFFBDEF15u, 0xFF6D0185u, 0xFFEC3C56u, 0xFFACF70Eu, 0xFFF2B92Du, 0xFF6A0286u,
+		0xFFFE913Au, 0xFFE5335Au, 0xFFB9F113u, 0xFF06A8CCu, 0xFFCC1965u, 0xFF1CCFDBu, 0xFFEDC12Au, 0xFFE22F5Bu,
+		0xFFCDE51Au, 0xFF039CC8u, 0xFF54F7F1u, 0xFFA2FA0Bu, 0xFFF04453u, 0xFFEAC628u, 0xFF4C0B91u, 0xFF1ED2DCu,
+		0xFF0075BCu, 0xFFFD6947u, 0xFFCC1A65u, 0xFF36E7E6u, 0xFFF1BA2Cu, 0xFF17C9D8u, 0xFF202BA2u, 0xFF5D058Au,
+		0xFFFD6748u, 0xFF0AB0CFu, 0xFFFC9B37u, 0xFF5FFBF4u, 0xFFA40574u, 0xFF12C1D5u, 0xFFD8DB1Fu, 0xFFFE8F3Bu,
+		0xFFBA0E6Cu, 0xFF25D9DFu, 0xFF007EBFu, 0xFFA4FA0Cu, 0xFF123EA9u, 0xFFB60C6Du, 0xFFD4DF1Du, 0xFF06A7CCu,
+		0xFF980278u, 0xFFFC6448u, 0xFF0659B3u, 0xFFB2F411u, 0xFF0298C7u, 0xFFFA5B4Cu, 0xFF0B4BAEu, 0xFF33E5E5u,
+		0xFFAF0970u, 0xFF63FCF6u, 0xFF85007Eu, 0xFFBAF113u, 0xFFEE4055u, 0xFF016EBAu, 0xFFD11D63u, 0xFFFC9938u,
+		0xFF50098Fu, 0xFFF24752u, 0xFFB80D6Du, 0xFF08ADCEu, 0xFF78FFFDu, 0xFF2D1E9Cu, 0xFF007FBFu, 0xFF4AF3EDu,
+		0xFF90FE05u, 0xFF0659B3u, 0xFF6BFDF8u, 0xFFFD6B46u, 0xFF460D92u, 0xFF84FF02u, 0xFF0083C0u, 0xFF7C0081u,
+		0xFF2229A1u, 0xFFFE8E3Bu, 0xFF055DB4u, 0xFF940279u, 0xFF32E5E5u, 0xFF0089C2u, 0xFFE22E5Cu, 0xFFFAA235u,
+		0xFF930179u, 0xFFDED522u, 0xFF690287u, 0xFF27249Fu, 0xFFF6504Fu, 0xFF87007Du, 0xFFD9DB1Fu, 0xFFE22E5Cu,
+		0xFF2EE1E3u, 0xFF1736A6u, 0xFF4D0A90u, 0xFF016DB9u, 0xFFF0BC2Cu, 0xFF2328A0u, 0xFF7E0080u, 0xFF039CC8u,
+		0xFF3D1396u, 0xFFFC6349u, 0xFFE4CD25u, 0xFF66FCF7u, 0xFFFBA035u, 0xFF0171BBu, 0xFFDB265Fu, 0xFF71FEFAu,
+		0xFF1A32A5u, 0xFFE2D024u, 0xFF6E0185u, 0xFF21D5DDu, 0xFF3A1597u, 0xFFD2E11Cu, 0xFFC81767u, 0xFFF0BC2Cu,
+		0xFF2B209Du, 0xFF0076BCu, 0xFFE3CF25u, 0xFF1FD3DCu, 0xFF153AA8u, 0xFF7AFFFDu, 0xFFB5F312u, 0xFF0298C7u,
+		0xFF50F6EFu, 0xFF80FF00u, 0xFF0267B7u, 0xFFFE8C3Cu, 0xFFD3DF1Du, 0xFF950279u, 0xFFFF7A42u, 0xFFCA1866u,
+		0xFF12C1D5u, 0xFF29229Eu, 0xFF790081u, 0xFFDED522u, 0xFF2FE2E3u, 0xFF1A32A5u, 0xFFF9594Cu, 0xFF73FEFBu,
+		0xFF0BB3D0u, 0xFFEE3F55u, 0xFF470D92u, 0xFFDFD323u, 0xFFFF7643u, 0xFF212AA1u, 0xFF84FF01u, 0xFF61FBF5u,
+		0xFF1539A8u, 0xFF0295C6u, 0xFF53F7F1u, 0xFFB1F510u, 0xFF0080BFu, 0xFFFF813Fu, 0xFF74FEFBu, 0xFF0171BBu,
+		0xFFF3B62Eu, 0xFFC2EC16u, 0xFFEB3A57u, 0xFF8DFE04u, 0xFF27DBE0u, 0xFFFF7543u, 0xFFD52161u, 0xFF79FFFDu,
+		0xFFBAF113u, 0xFF0461B5u, 0xFFE12E5Cu, 0xFF9B0377u, 0xFF18CAD9u, 0xFF56078Du, 0xFFBBF014u, 0xFFFE903Au,
+		0xFF10BDD4u, 0xFFF04354u, 0xFF48F2EDu, 0xFFFAA334u, 0xFFDF2B5Du, 0xFF7EFFFEu, 0xFF59068Cu, 0xFF10BED4u,
+		0xFFA3FA0Cu, 0xFFFB5E4Au, 0xFF620489u, 0xFFC71667u, 0xFFF9A633u, 0xFF3E1295u, 0xFFFC6349u, 0xFF780082u,
+		0xFFE6CC26u, 0xFF2229A1u, 0xFF24D8DEu, 0xFF421094u, 0xFFE4315Bu, 0xFF2DE0E2u, 0xFF1041AAu, 0xFFDFD422u,
+		0xFFF9584Du, 0xFFB20A6Fu, 0xFFF9A633u, 0xFF0297C7u, 0xFFDD295Eu, 0xFF990377u, 0xFFFC9938u, 0xFFC6EA18u,
+		0xFFAF0970u, 0xFF93FD06u, 0xFF19CCD9u, 0xFFC81667u, 0xFF45F1ECu, 0xFF7E0080u, 0xFF0DB7D1u, 0xFFBE116Bu,
+		0xFFC0EE15u, 0xFFEB3B57u, 0xFFFC9A37u, 0xFFAE0970u, 0xFF27DCE0u, 0xFF3D1396u, 0xFF99FC08u, 0xFFB20B6Fu,
+		0xFF710184u, 0xFF039BC8u, 0xFF69FDF8u, 0xFFBD106Bu, 0xFF5E058Au, 0xFF007CBEu, 0xFFA1FA0Bu, 0xFF143AA8u,
+		0xFFF9A633u, 0xFF5E048Au, 0xFF09AECFu, 0xFF2D1E9Cu, 0xFF8BFF04u, 0xFFF6524Fu, 0xFF0084C1u, 0xFFA90772u,
+		0xFF430F93u, 0xFFA6F90Cu, 0xFF123FAAu, 0xFF9F0476u, 0xFF045FB5u, 0xFF84FF02u, 0xFF0087C2u, 0xFFFF8A3Du,
+		0xFF36E8E6u, 0xFF0852B0u, 0xFF5BFAF3u, 0xFF08ACCEu, 0xFF8BFE04u, 0xFFA30574u, 0xFF14C5D7u, 0xFF045FB5u,
+		0xFFC81767u, 0xFFF9594Cu, 0xFF92017Au, 0xFFF3B52Eu, 0xFF007ABDu, 0xFF98FD08u, 0xFF5C058Bu, 0xFF64FCF6u,
+		0xFF0088C2u, 0xFFC2EC16u, 0xFF53F7F1u, 0xFF143BA8u, 0xFFA8F80Du, 0xFF46F1ECu, 0xFF0171BBu, 0xFF4D0A90u,
+		0xFF2DE1E3u, 0xFFF9A733u, 0xFF1A33A5u, 0xFF007CBEu, 0xFFB1F510u, 0xFFFD9838u, 0xFF3A1597u, 0xFFFB604Au,
+		0xFF2EE2E3u, 0xFF59068Cu, 0xFF0BB3D0u, 0xFF0755B1u, 0xFFE5CD25u, 0xFFDB275Fu, 0xFF0F44ACu, 0xFF13C3D6u,
+		0xFFFD9339u, 0xFF2A219Du, 0xFFFD6947u, 0xFF0950B0u, 0xFFD0E21Cu, 0xFF46F1ECu, 0xFFF14653u, 0xFF15C5D7u,
+		0xFFC51468u, 0xFF3CECE8u, 0xFFD1E11Cu, 0xFFFF7E40u, 0xFF5BFAF3u, 0xFF1140AAu, 0xFF21D5DDu, 0xFFDED522u,
+		0xFF58F9F2u, 0xFFC91866u, 0xFF04A1CAu, 0xFFDCD821u, 0xFFFE7045u, 0xFF1ED2DCu, 0xFFED3E56u, 0xFF8F017Au,
+		0xFFCD1A65u, 0xFFC9E719u, 0xFFFD9439u, 0xFFE73559u, 0xFF1E2EA3u, 0xFF45F1ECu, 0xFFCFE31Bu, 0xFFFD9639u,
+		0xFF6BFDF8u, 0xFF06A5CBu, 0xFFC3EC17u, 0xFF59F9F3u, 0xFFC41468u, 0xFF17C8D8u, 0xFFFD9838u, 0xFFE93958u,
+		0xFF361798u, 0xFF8F017Bu, 0xFFFF7643u, 0xFF57078Du, 0xFFF44B51u, 0xFF0EBAD3u, 0xFFDFD422u, 0xFFDA2560u,
+		0xFF0658B2u, 0xFF8B007Cu, 0xFFFB6249u, 0xFF6AFDF8u, 0xFFE4315Bu, 0xFF0659B3u, 0xFFD3E01Du, 0xFF0078BDu,
+		0xFFF4B42Eu, 0xFF1D2FA3u, 0xFF90FE05u, 0xFFFE6D46u, 0xFF6D0186u, 0xFF5CFAF3u, 0xFFF8564Du, 0xFFD4DF1Eu,
+		0xFF45F1ECu, 0xFFD32062u, 0xFFE5CD25u, 0xFF0FBCD3u, 0xFF85007Eu, 0xFFFAA135u, 0xFF301C9Bu, 0xFFE3CF24u,
+		0xFF720184u, 0xFFFB6149u, 0xFF007CBEu, 0xFFAC0871u, 0xFFF3B62Eu, 0xFFD31F62u, 0xFF7E0080u, 0xFFFE7244u,
+		0xFF0366B7u, 0xFFFB9F36u, 0xFF59068Cu, 0xFF39EAE7u, 0xFF2228A1u, 0xFF730183u, 0xFFEDC12Au, 0xFF133CA9u,
+		0xFF05A3CBu, 0xFF361798u, 0xFF86007Du, 0xFF018FC4u, 0xFFE9C827u, 0xFF5D058Bu, 0xFFED3F55u, 0xFF143CA8u,
+		0xFFA0FB0Bu, 0xFF700184u, 0xFF0852B0u, 0xFFFE6E45u, 0xFF1E2EA3u, 0xFF780082u, 0xFFCFE31Bu, 0xFF0A4EAFu,
+		0xFF3AEAE8u, 0xFF89FF03u, 0xFF26DBE0u, 0xFF055BB3u, 0xFFF5B22Fu, 0xFF7C0081u, 0xFF2A219Du, 0xFFFE6D46u,
+		0xFF56F8F2u, 0xFFB7F212u, 0xFF3B1497u, 0xFFDED622u, 0xFF770082u, 0xFF12C0D5u, 0xFFB00A70u, 0xFF79FFFDu,
+		0xFF87007Du, 0xFFE63459u, 0xFF4CF4EEu, 0xFFC1126Au, 0xFF1ACDDAu, 0xFFADF70Fu, 0xFF440F93u, 0xFF026BB9u,
+		0xFF83007Eu, 0xFFA6F90Du, 0xFF2BDFE2u, 0xFF411094u, 0xFFE93858u, 0xFF04A0CAu, 0xFFA70673u, 0xFF0267B7u,
+		0xFF56F8F1u, 0xFF95FD07u, 0xFF1D2FA4u, 0xFF25DADFu, 0xFF3E1295u, 0xFF07A8CCu, 0xFFB0F610u, 0xFF27249Fu,
+		0xFF2FE3E3u, 0xFF91FE06u, 0xFFF8564Du, 0xFFD72361u, 0xFFB9F213u, 0xFF007EBFu, 0xFF5EFAF4u, 0xFFACF70Fu,
+		0xFFFC6548u, 0xFF4CF4EEu, 0xFFD6DD1Eu, 0xFF0D47ACu, 0xFFFE6F45u, 0xFF0DB7D1u, 0xFFB70D6Du, 0xFF2CE0E2u,
+		0xFF401195u, 0xFFDC285Fu, 0xFFEDC02Au, 0xFF3DECE9u, 0xFFA2FA0Bu, 0xFFF6524Fu, 0xFF05A2CAu, 0xFFA80673u,
+		0xFFEEBF2Bu, 0xFFD21F63u, 0xFF0190C4u, 0xFFD0E31Cu, 0xFFB80D6Du, 0xFF78FFFDu, 0xFF90FE05u, 0xFF018DC4u,
+		0xFFEFBD2Bu, 0xFF0CB5D1u, 0xFFBF116Au, 0xFF2ADEE1u, 0xFFFF853Eu, 0xFF2327A0u, 0xFFF54E50u, 0xFFA0FB0Au,
+		0xFF1ED1DBu, 0xFFDED522u, 0xFF0081C0u, 0xFF2B209Du, 0xFFFAA434u, 0xFF049EC9u, 0xFFA60673u, 0xFFFF843Eu,
+		0xFF07AACDu, 0xFF1D2EA3u, 0xFFB90E6Cu, 0xFFFF813Fu, 0xFF83FF01u, 0xFF73FEFBu, 0xFFC2EC16u, 0xFFFF7C41u,
+		0xFF0AB0CFu, 0xFFDB275Fu, 0xFF80007Fu, 0xFFC0ED16u, 0xFFF24753u, 0xFFE9C827u, 0xFF7FFFFFu, 0xFFE6335Au,
+		0xFFA10475u, 0xFF450E93u, 0xFF08ACCEu, 0xFF70FEFAu, 0xFFA60673u, 0xFFFD9539u, 0xFFE22F5Cu, 0xFF54088Eu,
+		0xFFF8A932u, 0xFFAB0871u, 0xFF19CBD9u, 0xFFCE1B65u, 0xFF74FEFBu, 0xFF97FD08u, 0xFF0363B6u, 0xFFFF7D40u,
+		0xFFD9DB1Fu, 0xFF17C8D8u, 0xFF0086C1u, 0xFFBC0F6Bu, 0xFF55078Du, 0xFF026BB9u, 0xFF7EFFFFu, 0xFFFF883Du,
+		0xFF0EB9D2u, 0xFF6D0185u, 0xFFFC6648u, 0xFF4A0C91u, 0xFF17C9D8u, 0xFFEA3957u, 0xFF1141AAu, 0xFFAB0871u,
+		0xFF5A068Cu, 0xFFF6504Fu, 0xFF0F43ABu, 0xFF0079BDu, 0xFFA9F80Eu, 0xFF3AEBE8u, 0xFFF5B130u, 0xFF50098Fu,
+		0xFF0F44ABu, 0xFFFE8D3Cu, 0xFFA90772u, 0xFFB7F212u, 0xFFEF4254u, 0xFF1042ABu, 0xFFE3CF24u, 0xFF7EFFFFu,
+		0xFFF24852u, 0xFFF3B62Eu, 0xFF57F8F2u, 0xFF018DC4u, 0xFF2C1F9Cu, 0xFFCB1966u, 0xFF123FAAu, 0xFF5F048Au,
+		0xFFDDD621u, 0xFF0950B0u, 0xFFFC9C37u, 0xFF3FEDE9u, 0xFF016DB9u, 0xFF6B0286u, 0xFF0F44ABu, 0xFFF6AE31u,
+		0xFF16C8D8u, 0xFFD2E01Du, 0xFF0756B2u, 0xFFF0BC2Cu, 0xFF331A9Au, 0xFF23D7DEu, 0xFF0658B2u, 0xFF0EBAD3u,
+		0xFF9FFB0Au, 0xFF0362B6u, 0xFFF54E50u, 0xFFBBF014u, 0xFF6F0185u, 0xFF2E1E9Cu, 0xFFF3B52Eu, 0xFF55F8F1u,
+		0xFF87007Du, 0xFFF7544Eu, 0xFF341999u, 0xFFFE923Au, 0xFF28DCE0u, 0xFFE6CB26u, 0xFFDE2A5Eu, 0xFF2F1D9Bu,
+		0xFFC7E918u, 0xFF0E45ACu, 0xFF62FCF6u, 0xFFF9A633u, 0xFF0269B8u, 0xFFBBF014u, 0xFFFF873Du, 0xFF12C1D5u,
+		0xFF3BEBE8u, 0xFFA1FB0Bu, 0xFFF8A833u, 0xFFE22F5Bu, 0xFF5D058Bu, 0xFFBC0F6Cu, 0xFF0366B7u, 0xFF08ABCEu,
+		0xFFE02C5Du, 0xFF710184u, 0xFF0FBBD3u, 0xFF5FFBF5u, 0xFF490C92u, 0xFF32E5E4u, 0xFFD42062u, 0xFF8FFE05u,
+		0xFF54088Eu, 0xFF0462B6u, 0xFFCEE41Bu, 0xFF7C0080u, 0xFFE8C927u, 0xFF37E8E6u, 0xFFF44B51u, 0xFF23D8DEu,
+		0xFFB70D6Du, 0xFF6DFEF9u, 0xFFF8554Du, 0xFF039DC9u, 0xFFBE106Bu, 0xFF80FF00u, 0xFF28DCE0u, 0xFFF7534Eu,
+		0xFF016FBAu, 0xFFC41469u, 0xFFFE7344u, 0xFF790082u, 0xFF98FD08u, 0xFFF44C51u, 0xFFD9DA20u, 0xFF7D0080u,
+	};
+}
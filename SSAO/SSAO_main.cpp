@@ -7,12 +7,34 @@
 #include "ShaderSet.h"
 #include "Mesh.h"
 #include "Texture.h"
+#include "Trace.h"
 
 #include <vector>
-#include <queue>
+#include <string>
+#include <chrono>
 
 #include "..\Libraries\fbx_load.h"
 #include "Samplers.h"
+#include "SSAOKernels.h"
+#include "AOReference.h"
+#include "GBufferEncoding.h"
+#include "RenderGraph.h"
+#include "RenderGraphD3D11.h"
+#include "InstanceBatch.h"
+#include "DrawList.h"
+#include "CommandBuffer.h"
+#include "UploadRingD3D11.h"
+#include "SeparableBlur.h"
+#include "KawaseBlur.h"
+#include "WorkerPool.h"
+#include "SoftRasterizer.h"
+#include "BVH.h"
+#include "GroundTruthAO.h"
+#include "VertexAO.h"
+#include "DistanceField.h"
+#include "DistanceFieldAO.h"
+#include "FrameCapture.h"
+
 
 //-- flag for collecting data as csv file
 #define COLLECT_DATA 0
@@ -36,11 +58,26 @@ constexpr u32 kLightGridSize = 24;
 
 constexpr u16	kRoomPlanes = 3;	//Planes count for scene
 constexpr int	kNumBoxes = 5;		//Box count for scene
+constexpr u32	kInstanceSlot = 8;	//t8, per instance data of the instanced draws (DeferredShaders.fx)
 
 constexpr u8	MAX_TARGET_DOWNSIZE = 4;			//Max downsize ^n resolution
-constexpr int	MAX_FRAMES_FOR_PROFILE_QUEUE = 60;	//Limit profiling (DX Internal Queries) to 60 entries in the queue
+constexpr int	MAX_FRAMES_FOR_PROFILE_QUEUE = 60;	//Frame times kept for the timing graph
+constexpr u32	kProfileFramesInFlight = 8;			//Query sets waiting on the GPU, a frame isn't profiled when they're all in use
+constexpr u32	kHeapWarmUpFrames = 4;				//Frames before a heap allocation in the frame counts as one too many
 constexpr float kTargetFrameTimeMs = 16.7f;			//Whole frame time in ms (60fps) for graph scaling
 
+//Memory budgets per tag (RAM, VRAM), 0 for none. VRAM is estimated from the resource descs.
+constexpr u64	kMemoryBudgets[(u32)MemoryTag::kCount][(u32)MemoryDomain::kCount] =
+{
+	{ 128 * MB, 64 * MB },	//Mesh
+	{ 0, 256 * MB },		//Texture
+	{ 0, 256 * MB },		//Render Target
+	{ 64 * MB, 32 * MB },	//Transient
+	{ 16 * MB, 16 * MB },	//UI
+};
+constexpr u64	kMemoryBudgetRAM = 256 * MB;
+constexpr u64	kMemoryBudgetVRAM = 512 * MB;
+
 //================================================================================
 // SSAO APPLICATION
 //================================================================================
@@ -56,6 +93,7 @@ public:
 
 		u64 sData, eData;
 		D3D11_QUERY_DATA_TIMESTAMP_DISJOINT dData;
+		u64 cpuStart;	//Trace::now_ns() when the start timestamp was issued
 	};
 
 	//-- Constant Buffers
@@ -72,7 +110,14 @@ public:
 		f32  m_padding;
 	};
 
-	struct PerDrawCBData
+	// Instanced draws : first instance of the batch in the instance buffer.
+	struct PerBatchCBData
+	{
+		u32 m_instanceOffset;
+		u32 m_padding[3];
+	};
+
+	struct GeometryInstance
 	{
 		m4x4 m_matModel;
 		m4x4 m_matMVP;
@@ -87,7 +132,11 @@ public:
 		float g_bias;
 		int g_samples;
 		float g_maxDistance;
-		float g_pad[1];
+		float g_maxScreenRadius;
+		int g_adaptiveBaseTaps;
+		float g_importanceVarianceScale;
+		float g_importanceEdgeScale;
+		float _pad1;
 	};
 
 	struct BlurCBData
@@ -97,6 +146,14 @@ public:
 		float _pad2[2];
 	};
 
+	//Mirrors FusedBlurCB, weights of offsets 0..kMaxRadius
+	struct FusedBlurCBData
+	{
+		int g_fusedRadius;
+		int _pad3[3];
+		float g_fusedWeights[BlurKernel::kMaxRadius + 4];
+	};
+
 	//-- Lights...
 	enum ELightType
 	{
@@ -121,6 +178,12 @@ public:
 		ELightType m_type;
 	};
 
+	struct PointLightInstance
+	{
+		m4x4 m_matMVP;
+		LightInfo m_light;
+	};
+
 	//-- Application Functions...
 	void on_init(SystemsInterface& systems) override
 	{
@@ -130,41 +193,37 @@ public:
 		systems.pCamera->look_at(v3(0.f, 3.f, 0.f));
 
 		//Frame Profiling
-		init_profile_queue();
+		init_profile_queue(systems.pD3DDevice);
+
+		//Memory budgets, a warning the first time a tag goes over
+		MemoryTracker::set_warning_handler([](const char* pMessage) { debugF("%s\n", pMessage); });
+		for (u32 tag = 0; tag < (u32)MemoryTag::kCount; ++tag)
+		{
+			for (u32 domain = 0; domain < (u32)MemoryDomain::kCount; ++domain)
+			{
+				MemoryTracker::set_budget((MemoryTag)tag, (MemoryDomain)domain, kMemoryBudgets[tag][domain]);
+			}
+		}
+		MemoryTracker::set_budget(MemoryDomain::kCPU, kMemoryBudgetRAM);
+		MemoryTracker::set_budget(MemoryDomain::kGPU, kMemoryBudgetVRAM);
 
 		//Data collection
 #if COLLECT_DATA == 1
 		g_dataCollection.reserve(kEntriesToCollect);
 #endif
-		create_shaders(systems);
-
-		create_gbuffer(systems.pD3DDevice, systems.pD3DContext, systems.width, systems.height);
-
-		create_postfx_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
-		
-		create_ssao_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
+		{
+			TRACE_SCOPE_CAT("load", "Create Shaders");
+			create_shaders(systems);
+		}
 
-		create_blur_downsample_viewport(systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
-		
-		create_ssao_downsample_viewport(systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
+		// G-buffer, SSAO and blur targets come from the render target pool, created the first frame they're used.
+		m_renderGraphBackend.init(systems.pD3DDevice, systems.pD3DContext);
 
 		// create fullscreen quad for post-fx / lighting passes. (-1, 1) in XY
 		create_mesh_quad_xy(systems.pD3DDevice, m_fullScreenQuad, 1.0f);
 
-		// Create Per Frame Constant Buffer.
-		m_pPerFrameCB = create_constant_buffer<PerFrameCBData>(systems.pD3DDevice);
-
-		// Create Per Draw Constant Buffer.
-		m_pPerDrawCB = create_constant_buffer<PerDrawCBData>(systems.pD3DDevice);
-
-		// Create Per Light Constant Buffer.
-		m_pLightInfoCB = create_constant_buffer<LightInfo>(systems.pD3DDevice);
-
-		//create blur CB
-		m_pBlurCBData = create_constant_buffer<BlurCBData>(systems.pD3DDevice);
-
-		//SSAO constant buffer
-		m_pSSAOCB = create_constant_buffer<SSAOCBData>(systems.pD3DDevice);
+		// Every constant buffer (per frame, SSAO, blur, per batch, light info) is a block of the upload ring.
+		m_uploadRing.init(systems.pD3DDevice, systems.pD3DContext);
 
 		// Initialize a mesh from an .OBJ file
 		create_mesh_from_obj(systems.pD3DDevice, m_plane, "../Assets/Models/plane.obj", 2.f);
@@ -184,26 +243,57 @@ public:
 		m_pSamplerState[kPoint] = create_point_sampler(systems.pD3DDevice, D3D11_TEXTURE_ADDRESS_WRAP);
 		m_pSamplerState[kBiLinear] = create_bilinear_sampler(systems.pD3DDevice, D3D11_TEXTURE_ADDRESS_WRAP);
 
+		// The distance field reads its outer voxels past the edge rather than wrapping to the far side.
+		m_pDistanceFieldSampler = create_bilinear_sampler(systems.pD3DDevice, D3D11_TEXTURE_ADDRESS_CLAMP);
+
+		// The denoise's 4x4 window clamps at the screen edges like its CPU port, wrapping would
+		// average in the far side's AO.
+		m_pBlurClampSampler = create_point_sampler(systems.pD3DDevice, D3D11_TEXTURE_ADDRESS_CLAMP);
+
 		// Setup per-frame data
 		m_perFrameCBData.m_time = 0.0f;
 		m_perFrameCBData.m_screenW = systems.width;
 		m_perFrameCBData.m_screenH = systems.height;
 
 		//Stanford Dragon model -- converted from -- http://www.graphics.stanford.edu/data/3Dscanrep/
-		bool mOk = create_mesh_from_fbx(systems.pD3DDevice, m_s_dragon, "../Assets/Models/s_dragon/stanford-dragon.fbx");
+		bool mOk;
+		{
+			TRACE_SCOPE_CAT("load", "Load FBX");
+			mOk = create_mesh_from_fbx(systems.pD3DDevice, m_s_dragon, "../Assets/Models/s_dragon/stanford-dragon.fbx");
+		}
 		if (!mOk)
 		{
 			panicF("Error Loading FBX");
 		}
 
-		//random normal lookup tex
-		m_rndnrm.init_from_image(systems.pD3DDevice, "../Assets/Textures/rnd_nrm.png", false);
+		//Dragon self occlusion baked into the vertex alpha, the first run writes the cache next to the model
+		bake_vertex_ao(systems.pD3DDevice, m_s_dragon, "../Assets/Models/s_dragon/stanford-dragon.vao");
+
+		//what DrawItem::mesh / DrawItem::shader index
+		m_pSceneMeshes[kSceneMesh_Plane] = &m_plane;
+		m_pSceneMeshes[kSceneMesh_Dragon] = &m_s_dragon;
+		m_pSceneMeshes[kSceneMesh_Box] = &m_box;
+		m_pSceneMeshes[kSceneMesh_FullScreenQuad] = &m_fullScreenQuad;
+		m_pSceneMeshes[kSceneMesh_LightVolume] = &m_lightVolumeSphere;
+		m_pSceneShaders[kSceneShader_NoTex] = &m_geometryNoTex;
+		m_pSceneShaders[kSceneShader_DirectionalLight] = &m_directionalLightShader;
+		m_pSceneShaders[kSceneShader_PointLight] = &m_pointLightShader;
+
+		m_drawBackend.pApp = this;
+		m_drawBackend.pContext = systems.pD3DContext;
+
+		//blue noise rotation tile, generated at build time by Tools/KernelGen so there is no image decode at startup.
+		m_rndnrm.init_from_memory(systems.pD3DDevice, SSAOKernels::kNoiseTileSize, SSAOKernels::kNoiseTileSize,
+			DXGI_FORMAT_R8G8B8A8_UNORM, SSAOKernels::kNoiseTileRGBA, SSAOKernels::kNoiseTileSize * sizeof(u32));
 
 		//setup plane transforms
 		m_mmRoomPlanes[0] = m4x4::CreateTranslation(0.f, 0.f, 0.f);
 		m_mmRoomPlanes[1] = m4x4::CreateRotationX(degToRad(90)) * m4x4::CreateTranslation(v3(0, 15, -15));
 		m_mmRoomPlanes[2] = m4x4::CreateRotationX(degToRad(90))* m4x4::CreateRotationY(degToRad(90)) * m4x4::CreateTranslation(v3(-15, 15, 0));
 
+		//Everything static into the distance field, for the AO past the screen's edges
+		bake_distance_field(systems.pD3DDevice);
+
 		// create additive render states.
 		{
 			// Additive
@@ -233,7 +323,7 @@ public:
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		);
 		m_geometryNoTex.init(systems.pD3DDevice
-			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/DeferredShaders.fx", "VS_Geometry", "PS_Geometry_NoTex")
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/DeferredShaders.fx", "VS_Geometry_Instanced", "PS_Geometry_NoTex")
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		);
 
@@ -243,7 +333,7 @@ public:
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		);
 		m_pointLightShader.init(systems.pD3DDevice
-			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/DeferredShaders.fx", "VS_LightVolume", "PS_PointLight")
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/DeferredShaders.fx", "VS_LightVolume_Instanced", "PS_PointLight_Instanced")
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		); 
 
@@ -256,10 +346,22 @@ public:
 			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_SSAO_02")
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		);
-		/*m_SSAOShaders[KGPUZENAlchemy].init(systems.pD3DDevice
+		m_SSAOShaders[kVogelAlchemySSAO].init(systems.pD3DDevice
 			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_SSAO_04")
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
-		);*/
+		);
+		m_SSAOShaders[kAdaptiveSSAO].init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_SSAO_ADAPTIVE")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
+		m_adaptiveBase.init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_SSAO_ADAPTIVE_BASE")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
+		m_importance.init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_SSAO_IMPORTANCE")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
 		
 		m_GaussBlur.init(systems.pD3DDevice
 			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_BLUR_GAUSS")
@@ -277,6 +379,29 @@ public:
 			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_BLUR_KAWASE")
 			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
 		);
+		m_denoise4x4.init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_BLUR_DENOISE_4X4")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
+
+		m_dualDown.init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_BLUR_DUAL_DOWN")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
+		m_dualUp.init(systems.pD3DDevice
+			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/SSAOShaders.fx", "VS_Passthrough", "PS_BLUR_DUAL_UP")
+			, { VertexFormatTraits<MeshVertex>::desc, VertexFormatTraits<MeshVertex>::size }
+		);
+
+		//Compute needs SM5, below FL11 the fused gauss falls back to the fast gauss passes
+		m_fusedBlurSupported = systems.pD3DDevice->GetFeatureLevel() >= D3D_FEATURE_LEVEL_11_0;
+		if (m_fusedBlurSupported)
+		{
+			m_fusedBlur.init(systems.pD3DDevice
+				, ShaderSetDesc::Create_CS("../Assets/Shaders/SSAOShaders.fx", "CS_BLUR_FUSED")
+				, { nullptr, 0 }
+			);
+		}
 
 		m_ssaoDebugShader.init(systems.pD3DDevice
 			, ShaderSetDesc::Create_VS_PS("../Assets/Shaders/DeferredShaders.fx", "VS_Passthrough", "PS_SSAODebug")
@@ -323,10 +448,28 @@ public:
 				m_lights.push_back(l);
 			}
 		}
+		m_maxLights = m_lights.size();
 	}
 
 	void on_update(SystemsInterface& systems) override
 	{
+		//Heap allocations since the last update, the whole of the last frame
+		const u64 heapAllocations = MemoryTracker::heap_allocations();
+		m_heapAllocationsLastFrame = heapAllocations - m_heapAllocations;
+		m_heapAllocations = heapAllocations;
+		++m_framesUpdated;
+
+		//The framework traces startup, that stops after the first frame. A recording stops after m_traceFrames.
+		if (m_traceFramesLeft && --m_traceFramesLeft == 0)
+		{
+			Trace::stop();
+			if (m_traceSaveWhenDone)
+			{
+				save_trace();
+				m_traceSaveWhenDone = false;
+			}
+		}
+
 		//////////////////////////////////////////////////////////////////////////
 		// Create profiling window
 		//////////////////////////////////////////////////////////////////////////
@@ -336,24 +479,71 @@ public:
 			ImGui::Checkbox("Enable Profiling", &m_enableProfiling);
 
 			float averageFrame(0);
-
-			//Copy data over for now... 
-			int elm = 0;
-			for (float f : m_frameData._Get_container())
+			for (u32 i = 0; i < m_frameTimesCount; ++i)
 			{
-				test_data[elm++] = f;
-				averageFrame += f;
+				averageFrame += m_frameTimes[i];
 			}
 			
-			char buffer[16];	//Collect an average of all samples...
-			averageFrame /= MAX_FRAMES_FOR_PROFILE_QUEUE;
+			char buffer[32];	//Collect an average of all samples...
+			averageFrame /= std::max(m_frameTimesCount, 1u);
 			sprintf(buffer, "AVG: %f", averageFrame);
 
-			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Technique Timing (ms):", m_profilingDataQueue.size());
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Technique Timing (ms):");
 			ImVec2 plotextent(ImGui::GetContentRegionAvailWidth(), 100);
-			ImGui::PlotLines("Technique (ms)", &test_data[0], m_frameData.size(), 0, buffer, 0, kTargetFrameTimeMs, plotextent);
+			ImGui::PlotLines("Technique (ms)", m_frameTimes, (int)m_frameTimesCount, (int)m_frameTimesHead, buffer, 0, kTargetFrameTimeMs, plotextent);
+
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Profiling Query Queue Sz: %u", m_profileCount);
+
+			//Anything above zero after the first frames is a per frame heap allocation to find
+			const bool heapWarm = m_framesUpdated > kHeapWarmUpFrames;
+			ImGui::TextColored(heapWarm && m_heapAllocationsLastFrame ? ImVec4(1, 0, 0, 1) : ImVec4(0, 1, 0, 1), "Heap allocations last frame: %llu"
+				, (unsigned long long)m_heapAllocationsLastFrame);
+
+			//Chrome / Perfetto trace of the next frames, saved as trace_NNN.json when they're in
+			ImGui::SliderInt("Trace Frames", &m_traceFrames, 1, 120);
+			if (ImGui::Button("Record Trace"))
+			{
+				Trace::clear();
+				Trace::start();
+				m_traceFramesLeft = m_traceFrames + 1;
+				m_traceSaveWhenDone = true;
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Save Trace"))
+			{
+				save_trace();
+			}
+			const Trace::Stats traceStats = Trace::stats();
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Trace: %s, %llu events on %u threads, %llu dropped", Trace::recording() ? "recording" : "stopped"
+				, (unsigned long long)traceStats.events, traceStats.threads, (unsigned long long)traceStats.dropped);
+			if (!m_traceStatus.empty())
+			{
+				ImGui::TextColored(ImVec4(0, 1, 0, 1), "%s", m_traceStatus.c_str());
+			}
 
-			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Profiling Query Queue Sz: %i", m_profilingDataQueue.size());
+			//Memory per tag, red when over its budget
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Memory (MB current / peak / budget, allocations):");
+			for (u32 tag = 0; tag <= (u32)MemoryTag::kCount; ++tag)
+			{
+				for (u32 domain = 0; domain < (u32)MemoryDomain::kCount; ++domain)
+				{
+					const bool total = tag == (u32)MemoryTag::kCount;
+					const MemoryStats stats = total ? MemoryTracker::stats((MemoryDomain)domain) : MemoryTracker::stats((MemoryTag)tag, (MemoryDomain)domain);
+					if (!stats.allocations && !stats.budgetBytes)
+						continue;
+
+					ImGui::TextColored(stats.overBudget ? ImVec4(1, 0, 0, 1) : ImVec4(0, 1, 0, 1), "%-13s %-4s %7.2f / %7.2f / %7.2f, %u live, %llu total"
+						, total ? "Total" : MemoryTracker::tag_name((MemoryTag)tag), MemoryTracker::domain_name((MemoryDomain)domain)
+						, stats.currentBytes / (f64)MB, stats.peakBytes / (f64)MB, stats.budgetBytes / (f64)MB
+						, stats.liveAllocations, (unsigned long long)stats.allocations);
+				}
+			}
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Budget warnings: %u", MemoryTracker::budget_warnings());
+			ImGui::SameLine();
+			if (ImGui::Button("Reset Peaks"))
+			{
+				MemoryTracker::reset_peaks();
+			}
 
 #if COLLECT_DATA == 1	//send data to csv
 			if (m_enableProfiling) {
@@ -366,7 +556,7 @@ public:
 				{
 					data_out d;
 					//Record data
-					d.frameTime = m_frameData.front();
+					d.frameTime = m_frameTimesCount ? m_frameTimes[(m_frameTimesHead + m_frameTimesCount - 1) % MAX_FRAMES_FOR_PROFILE_QUEUE] : 0.0f;
 					d.blur = m_blurSelect;
 					d.ssao = m_ssaoSelect;
 					d.sampler = m_samplerSelect;
@@ -413,17 +603,129 @@ public:
 		//Another value to play with for comparison with spiral kernel
 		ImGui::SliderFloat("Max Distance", &m_maxDistance, 0.0f, 4.0f);
 
+		//Vogel / Alchemy uses max distance as its world radius, clamp the projected size (uv units)
+		ImGui::SliderFloat("Max Screen Radius", &m_maxScreenRadius, 0.01f, 0.5f);
+
+		//Adaptive: base taps every pixel pays, the rest (up to Samples * 4) go where the importance map asks
+		if (m_ssaoSelect == kAdaptiveSSAO)
+		{
+			ImGui::SliderInt("Adaptive Base Taps", &m_adaptiveBaseTaps, 1, SSAOKernels::kMaxTaps);
+			ImGui::SliderFloat("Importance: AO Variance", &m_importanceVarianceScale, 0.0f, 16.0f);
+			ImGui::SliderFloat("Importance: Depth Edges", &m_importanceEdgeScale, 0.0f, 32.0f);
+
+			if (ImGui::Button("Run CPU Reference"))
+			{
+				m_runAdaptiveReference = true;
+			}
+			if (m_adaptiveStats.shadedPixels)
+			{
+				ImGui::TextColored(ImVec4(0, 1, 0, 1), "Taps/pixel: %.2f avg (%u..%u) vs %u fixed"
+					, m_adaptiveStats.average_taps(), m_adaptiveStats.minTaps, m_adaptiveStats.maxTaps, m_adaptiveStats.fixedTaps);
+			}
+		}
+
 		//-- Downsampling
 		ImGui::TextColored(ImVec4(1, 1, 0, 1), "PostFx Pipeline");
-		if (ImGui::SliderInt("SSAO Target DownSize ^(n)", &m_ssaoTargetDownSize, 1, MAX_TARGET_DOWNSIZE))
+		ImGui::SliderInt("SSAO Target DownSize ^(n)", &m_ssaoTargetDownSize, 1, MAX_TARGET_DOWNSIZE);
+		ImGui::SliderInt("Blur Target DownSize ^(n)", &m_blurTargetDownSize, 1, MAX_TARGET_DOWNSIZE);
+
+		//AO is one channel, R8 stores it in a quarter of the bytes the old RGBA16F targets used, R16F in half.
+		ImGui::Combo("SSAO Storage", &m_aoStorage[kAOStage_SSAO], m_aoStorageNames, kMaxAOStorages);
+		ImGui::Combo("Blur Storage", &m_aoStorage[kAOStage_Blur], m_aoStorageNames, kMaxAOStorages);
+		ImGui::Combo("Blur Output Storage", &m_aoStorage[kAOStage_BlurOutput], m_aoStorageNames, kMaxAOStorages);
+
+		//CPU reference of the current technique and blur, f32 against the storage above
+		if (ImGui::Button("Measure Storage Error"))
+		{
+			m_runStorageReference = true;
+		}
+		if (m_storageErrorValid)
+		{
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "AO error: %.2f max, %.3f rms (R8 steps)", m_storageError.ao.max_steps(), m_storageError.ao.rms_steps());
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Blurred error: %.2f max, %.3f rms (R8 steps)", m_storageError.blurred.max_steps(), m_storageError.blurred.rms_steps());
+		}
+
+		//G-buffer and constants of the next frame to a file, for CaptureReplay / the CPU passes
+		if (ImGui::Button("Capture Frame"))
+		{
+			m_runCapture = true;
+		}
+		if (!m_captureStatus.empty())
+		{
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "%s", m_captureStatus.c_str());
+		}
+
+		//The visible draws through the CPU rasterizer, against the GPU's G-buffer
+		if (ImGui::Button("Compare Software G-buffer"))
 		{
-			create_ssao_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
-			create_ssao_downsample_viewport(systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
+			m_runSoftRasterCompare = true;
 		}
-		if (ImGui::SliderInt("Blur Target DownSize ^(n)", &m_blurTargetDownSize, 1, MAX_TARGET_DOWNSIZE))
+		if (m_softRasterCompare.valid)
 		{
-			create_postfx_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
-			create_blur_downsample_viewport(systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
+			const SoftRaster::Stats& stats = m_softRasterCompare.stats;
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "CPU G-buffer: %.2f ms (%s, %u threads), %u tris, %u clipped, %u culled, %u bins"
+				, m_softRasterCompare.milliseconds, SoftRaster::rasterizer_isa(), m_workerPool.threads()
+				, stats.triangles, stats.clippedTriangles, stats.culledTriangles, stats.binnedTriangles);
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "vs GPU: %u coverage diffs, depth %u max / %.2f mean D24 steps, normals %.3f max degrees"
+				, m_softRasterCompare.coverageDiffs, m_softRasterCompare.depthMaxSteps, m_softRasterCompare.depthMeanSteps, m_softRasterCompare.normalMaxDegrees);
+		}
+
+		//Baked vertex AO on the ambient, under the SSAO (which then only needs the contact detail)
+		ImGui::Checkbox("Baked Vertex AO", &m_bakedAO);
+		ImGui::TextColored(ImVec4(0, 1, 0, 1), "Baked: %u vertices, %s %.1f ms", m_vertexAO.vertices, m_vertexAO.cached ? "cache load" : "bake", m_vertexAO.milliseconds);
+
+		//Cone traced AO of the static geometry's distance field, the darker of it and the SSAO
+		ImGui::Checkbox("Distance Field AO", &m_distanceFieldAO);
+		ImGui::SliderFloat("Distance Field AO Weight", &m_distanceFieldWeight, 0.0f, 1.0f);
+		ImGui::SliderFloat("Distance Field AO Distance", &m_distanceFieldParams.maxDistance, 0.5f, m_distanceFieldDesc.padding);
+		ImGui::SliderInt("Distance Field AO Steps", &m_distanceFieldSteps, 1, 8);
+		ImGui::SliderFloat("Distance Field Voxel Size", &m_distanceFieldDesc.voxelSize, 0.125f, 1.0f);
+		int method = (int)m_distanceFieldDesc.method;
+		if (ImGui::Combo("Distance Field Bake", &method, "Exact\0Jump Flood\0"))
+		{
+			m_distanceFieldDesc.method = (DistanceField::Method)method;
+		}
+		if (ImGui::Button("Rebake Distance Field"))
+		{
+			bake_distance_field(systems.pD3DDevice);
+		}
+		if (!m_distanceField.empty())
+		{
+			const DistanceField::Stats& stats = m_distanceField.stats();
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Distance field: %ux%ux%u of %.2f, %u tris, %u seeds, %u passes, %.1f ms on %u threads"
+				, m_distanceField.size(0), m_distanceField.size(1), m_distanceField.size(2), m_distanceField.voxel_size()
+				, stats.triangles, stats.seeds, stats.passes, m_distanceFieldMilliseconds, m_workerPool.threads());
+		}
+
+		//Ray traced AO of the read back G-buffer, the error of every spiral and Vogel / Alchemy tap count
+		//against it and the estimator's bias at the technique's converged tap count
+		ImGui::SliderInt("Ground Truth Rays/Pixel", &m_groundTruthRays, 4, 256);
+		ImGui::SliderFloat("Calibration Tolerance (R8 steps)", &m_groundTruthTolerance, 0.0f, 4.0f);
+		if (ImGui::Button("Ray Traced Ground Truth"))
+		{
+			m_runGroundTruth = true;
+		}
+		if (m_groundTruth.valid)
+		{
+			const BVH::Stats& bvh = m_groundTruth.bvh;
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "BVH: %u tris, %u nodes, depth %u, SAH %.1f, %.1f ms (%s)"
+				, bvh.triangles, bvh.nodes, bvh.maxDepth, bvh.sahCost, m_groundTruth.bvhMilliseconds, bvh_isa());
+			ImGui::TextColored(ImVec4(0, 1, 0, 1), "Ground truth: %.1f ms, %.2f Mrays/s on %u threads"
+				, m_groundTruth.milliseconds, m_groundTruth.stats.rays / (m_groundTruth.milliseconds * 1e3f), m_workerPool.threads());
+			auto calibration = [](const char* pName, const std::vector<GroundTruthAO::Calibration>& rows, u32 cheapest, const GroundTruthAO::Calibration& converged)
+			{
+				ImGui::TextColored(ImVec4(1, 1, 0, 1), "%s against the ground truth", pName);
+				for (u32 i = 0; i < rows.size(); ++i)
+				{
+					const GroundTruthAO::Calibration& row = rows[i];
+					ImGui::TextColored(i == cheapest ? ImVec4(1, 1, 0, 1) : ImVec4(0, 1, 0, 1), "%2u taps: rms %.2f, fitted (x%.2f) rms %.2f R8 steps%s"
+						, row.taps, row.error.rms_steps(), row.gain, row.fittedError.rms_steps(), i == cheapest ? " <- cheapest" : "");
+				}
+				ImGui::TextColored(ImVec4(0, 1, 0, 1), "%u taps: rms %.2f, fitted (x%.2f) rms %.2f R8 steps, the estimator's bias"
+					, converged.taps, converged.error.rms_steps(), converged.gain, converged.fittedError.rms_steps());
+			};
+			calibration("Spiral", m_groundTruth.spiralRows, m_groundTruth.spiralCheapest, m_groundTruth.spiralConverged);
+			calibration("Vogel / Alchemy", m_groundTruth.rows, m_groundTruth.cheapest, m_groundTruth.converged);
 		}
 		//--
 
@@ -437,6 +739,24 @@ public:
 				m_blurSelect < kMaxBlurs - 1 ? ++m_blurSelect : m_blurSelect = 0;
 			}
 			ImGui::TextColored(ImVec4(1, 0, 1, 1), "Blur: %s", m_blurNames[m_blurSelect].c_str());
+
+			if (m_blurSelect == kFusedGauss)
+			{
+				//Box radius 0 is the 9 tap gaussian iterated, otherwise iterated box passes for wider blurs
+				ImGui::SliderInt("Fused Box Radius", &m_fusedBoxRadius, 0, BlurKernel::kMaxRadius);
+				const int maxIterations = m_fusedBoxRadius ? BlurKernel::kMaxRadius / m_fusedBoxRadius : BlurKernel::kMaxRadius / 4;
+				ImGui::SliderInt("Fused Iterations", &m_fusedIterations, 1, maxIterations);
+				m_fusedIterations = std::min(m_fusedIterations, maxIterations);
+				ImGui::Text("Radius %u, sigma %.2f texels%s", fused_blur_kernel().radius, fused_blur_kernel().sigma()
+					, m_fusedBlurSupported ? "" : " (no FL11, fast gauss)");
+			}
+
+			if (m_blurSelect == kDualFilter)
+			{
+				//Each level doubles the radius, the extra passes are on targets a quarter the size
+				ImGui::SliderInt("Dual Filter Levels", &m_dualFilterLevels, 1, kDualFilterMaxLevels);
+				ImGui::Text("%.2f fetches per texel", dual_filter_fetches(m_dualFilterLevels));
+			}
 		}
 		//--
 
@@ -476,851 +796,1326 @@ public:
 		auto ctx = systems.pDebugDrawContext;
 		dd::axisTriad(ctx, (const float*)& m4x4::Identity, 0.1f, 15.0f);
 
-		// Push Per Frame Data to GPU
-		D3D11_MAPPED_SUBRESOURCE subresource;
-		if (!FAILED(systems.pD3DContext->Map(m_pPerFrameCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &subresource)))
-		{
-			memcpy(subresource.pData, &m_perFrameCBData, sizeof(PerFrameCBData));
-			systems.pD3DContext->Unmap(m_pPerFrameCB, 0);
-		}
-
-		//=======================================================================================
-		// The Geometry Pass.
-		// Draw our scene into the GBuffer, capturing all the information we need for lighting.
-		//=======================================================================================
+		// This frame's constants are pushed while recording / building the graph and written in one go before it runs.
+		m_uploadRing.begin_frame();
 
-		// Bind the G Buffer to the output merger
-		// Here we are binding multiple render targets (MRT)
-		systems.pD3DContext->OMSetRenderTargets(kMaxGBufferColourTargets, m_pGBufferTargetViews, m_pGBufferDepthView);
+		m_perFrameConstants = m_uploadRing.push(m_perFrameCBData);
 
-		// Clear colour and depth
-		f32 clearValue[] = { 0.f, 0.f, 0.f, 0.f };
-		systems.pD3DContext->ClearRenderTargetView(m_pGBufferTargetViews[kGBufferColourSpec], clearValue);
-		f32 normalClearValue[] = { 0.5f, 0.5f, 0.5f, 0.f };
-		systems.pD3DContext->ClearRenderTargetView(m_pGBufferTargetViews[kGBufferNormalPow], normalClearValue);
-		systems.pD3DContext->ClearDepthStencilView(m_pGBufferDepthView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.f, 0);
+		//Fill the SSAO CB, bound by the SSAO and blur passes
+		m_SSAOCBData.g_sample_rad = m_sample_rad;
+		m_SSAOCBData.g_intensity = m_intensity;
+		m_SSAOCBData.g_scale = m_scale;
+		m_SSAOCBData.g_bias = m_bias;
+		m_SSAOCBData.random_size = (float)SSAOKernels::kNoiseTileSize;
+		m_SSAOCBData.g_samples = m_samples_mult;
+		m_SSAOCBData.g_maxDistance = m_maxDistance;
+		m_SSAOCBData.g_maxScreenRadius = m_maxScreenRadius;
+		m_SSAOCBData.g_adaptiveBaseTaps = m_adaptiveBaseTaps;
+		m_SSAOCBData.g_importanceVarianceScale = m_importanceVarianceScale;
+		m_SSAOCBData.g_importanceEdgeScale = m_importanceEdgeScale;
 
-		// Bind Constant Buffers, to both PS and VS stages
-		ID3D11Buffer* buffers[] = { m_pPerFrameCB, m_pPerDrawCB };
-		systems.pD3DContext->VSSetConstantBuffers(0, 2, buffers);
-		systems.pD3DContext->PSSetConstantBuffers(0, 2, buffers);
+		m_ssaoConstants = m_uploadRing.push(m_SSAOCBData);
 
-		// Bind a sampler state
-		ID3D11SamplerState* samplers[] = { m_pSamplerState[m_samplerSelect] };
-		systems.pD3DContext->PSSetSamplers(0, 1, samplers);
+		//Distance field AO, read by the directional light
+		m_distanceFieldParams.steps = (u32)m_distanceFieldSteps;
+		const f32 distanceFieldWeight = m_distanceFieldAO && !m_distanceField.empty() ? m_distanceFieldWeight : 0.f;
+		m_distanceFieldConstants = m_uploadRing.push(DistanceFieldAO::constants(m_distanceField, m_distanceFieldParams, distanceFieldWeight));
 
-		// Opaque blend
-		systems.pD3DContext->OMSetBlendState(m_pBlendStates[BlendStates::kOpaque], kBlendFactor, kSampleMask);
+		m_BlurCBData.g_downsampleBlurFac = m_blurTargetDownSize;
+		m_BlurCBData.g_kawaseIteration = 0;
 
-		// draw a plane
+		//Lighting controls, read by the lighting pass
+		ImGui::Checkbox("SSAO Buffer Debug", &m_ssaoDebugEnabled);
+		if (!m_ssaoDebugEnabled)
 		{
-			//No Texture Shader
-			m_geometryNoTex.bind(systems.pD3DContext);
+			ImGui::SliderInt("Lights", &m_maxLights, 1, m_lights.size());
 
-			m_plane.bind(systems.pD3DContext);
-
-			for (int i(0); i < kRoomPlanes; ++i)
-			{
-				// Compute MVP matrix.
-				m4x4 matMVP = m_mmRoomPlanes[i] * systems.pCamera->vpMatrix;
-
-				// Update Per Draw Data
-				m_perDrawCBData.m_matModel = m_mmRoomPlanes[i].Transpose();
-				m_perDrawCBData.m_matMVP = matMVP.Transpose();
+			static v3 light_dir = { 0.5773, 0.5773, 0.5773 };
+			ImGui::SliderFloat3("Light Direction", (float*)&light_dir, 1.0f, -1.f);
+			light_dir.Normalize();
+			m_lights.front().m_shaderInfo.m_vDirection = v4(light_dir.x, light_dir.y, light_dir.z, 1.f);
 
-				// Push to GPU
-				push_constant_buffer(systems.pD3DContext, m_pPerDrawCB, m_perDrawCBData);
+			static v4 light_col = v4(1.f, 0.7f, .6f, 0.f) * 0.2f;
+			ImGui::ColorEdit4("Light Colour", (float*)&light_col);
+			m_lights.front().m_shaderInfo.m_vColour = light_col;
 
-				// Draw the mesh.
-				m_plane.draw(systems.pD3DContext);
-			}
+			static v4 light_amb = v4(0.15, 0.15, 0.2, 1);
+			ImGui::ColorEdit3("Light Ambient", (float*)&light_amb);
+			light_amb.w = m_bakedAO ? 1.f : 0.f;
+			m_lights.front().m_shaderInfo.m_vAmbient = light_amb;
 		}
 
-		// draw stanford dragon
-		for (int i(0); i < 3; ++i)
-		{
-			m_s_dragon.bind(systems.pD3DContext);
-
-			// Compute MVP matrix.
-			m4x4 matModel = m4x4::CreateRotationY(degToRad(-135)) * m4x4::CreateTranslation(v3(i * 4, 0, i * 4));
-			m4x4 matMVP = matModel * systems.pCamera->vpMatrix;
-
-			// Update Per Draw Data
-			m_perDrawCBData.m_matModel = matModel.Transpose();
-			m_perDrawCBData.m_matMVP = matMVP.Transpose();
-
-			// Push to GPU
-			push_constant_buffer(systems.pD3DContext, m_pPerDrawCB, m_perDrawCBData);
+		//=======================================================================================
+		// Build the frame as a render graph.
+		// Passes declare what they read and write, the graph orders them, shares transient
+		// targets between passes whose lifetimes don't overlap and does the binding / clearing.
+		//=======================================================================================
 
-			// Draw the mesh.
-			m_s_dragon.draw(systems.pD3DContext);
-		}
+		cull_scene(systems);
+		record_draws(systems);
 
-		//draw cubes
-		m_box.bind(systems.pD3DContext);
+		FrameProfile* pProfile = nullptr;	// set by the AO technique's first pass when it's profiled
 
-		for (m4x4 m : m_boxes)
-		{
+		// Last frame's targets go back to the pool.
+		m_renderGraphBackend.begin_frame();
+		m_renderGraph.reset();
 
-			// Compute MVP matrix.
-			m4x4 matModel = m;
-			m4x4 matMVP = matModel * systems.pCamera->vpMatrix;
+		const GBufferResources gbuffer = import_gbuffer(systems);
 
-			// Update Per Draw Data
-			m_perDrawCBData.m_matModel = matModel.Transpose();
-			m_perDrawCBData.m_matMVP = matMVP.Transpose();
+		m_backBuffer.pRTV = systems.pSwapRenderTarget;
+		const RGResource backBuffer = m_renderGraph.import_texture("Back Buffer"
+			, RGTextureDesc::Create(systems.width, systems.height, RGFormat::kRGBA8_UNORM), &m_backBuffer);
 
-			// Push to GPU
-			push_constant_buffer(systems.pD3DContext, m_pPerDrawCB, m_perDrawCBData);
+		add_geometry_pass(systems, gbuffer);
 
-			// Draw the mesh.
-			m_box.draw(systems.pD3DContext);
+		RGResource ao = add_ssao_passes(systems, gbuffer, pProfile);
+		if (m_blurOn)
+		{
+			ao = add_blur_passes(systems, ao);
 		}
 
-		//=======================================================================================
-		// SSAO
-		// Read the GBuffer textures, reconstruct depth and do AO
-		//=======================================================================================
+		add_lighting_pass(systems, gbuffer, ao, backBuffer, pProfile);
 
-		FrameProfile frame;
-
-		//Begin profiling for the technique
-		if (m_enableProfiling)
+		if (!m_renderGraph.compile())
 		{
-			begin_profile_frame(frame, systems.pD3DDevice, systems.pD3DContext);
+			panicF("Failed to compile the frame's render graph");
 		}
+		m_uploadRing.commit();
+		m_renderGraph.execute(m_renderGraphBackend);
 
-		//Move into ssao viewport dimensions
-		systems.pD3DContext->RSSetViewports(1, &m_ssaoViewport);
-
-		systems.pD3DContext->ClearRenderTargetView(m_pSSAORTV, clearValue);
-
-		// Here we are binding the SSAO buffer as render target
-		ID3D11RenderTargetView* views[] = { m_pSSAORTV, 0 };
-		systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
-
-		systems.pD3DContext->OMSetBlendState(m_pBlendStates[BlendStates::kOpaque], kBlendFactor, kSampleMask);
-
-		//Fill the CB
-		m_SSAOCBData.g_sample_rad = m_sample_rad;
-		m_SSAOCBData.g_intensity = m_intensity;
-		m_SSAOCBData.g_scale = m_scale;
-		m_SSAOCBData.g_bias = m_bias;
-		m_SSAOCBData.random_size = 64.0f;
-		m_SSAOCBData.g_samples = m_samples_mult;
-		m_SSAOCBData.g_maxDistance = m_maxDistance;
+		ImGui::Text("Culling (%s): %u / %u draws, %u / %u lights", cull_frustum_isa(), (u32)m_visibleDraws.size(), (u32)m_drawItems.size()
+			, (u32)m_visibleLights.size(), (u32)m_maxLights);
+		ImGui::Text("Instancing: %u scene batches, %u point lights in 1 draw", (u32)m_drawBatcher.batches().size(), (u32)m_pointLightInstanceData.size());
 
-		// Push Data to GPU
-		D3D11_MAPPED_SUBRESOURCE sr;
-		if (!FAILED(systems.pD3DContext->Map(m_pSSAOCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &sr)))
+		DrawListStats drawStats;
+		u32 commandBuffers = 0;
+		for (const RecordedPass& pass : m_recordedPasses)
 		{
-			memcpy(sr.pData, &m_SSAOCBData, sizeof(SSAOCBData));
-			systems.pD3DContext->Unmap(m_pSSAOCB, 0);
+			drawStats.add(pass.stats);
+			commandBuffers += pass.buffersUsed;
 		}
+		ImGui::Text("Draw list: %u draws, %u binds, %u redundant binds skipped", drawStats.draws, drawStats.binds(), drawStats.binds_skipped());
+		ImGui::Text("Command buffers: %u recorded, %u worker threads", commandBuffers, m_commandRecorder.workers());
 
-		// Bind Constant Buffers, to both PS and VS stages
-		ID3D11Buffer* ssaoBuffers[] = { m_pPerFrameCB, m_pSSAOCB, NULL };
-		systems.pD3DContext->PSSetConstantBuffers(0, 2, ssaoBuffers);
+		const UploadRingStats& uploadStats = m_uploadRing.stats();
+		ImGui::Text("Constants: %u blocks, %.1f KB in %u KB ring (%s), %u wraps", uploadStats.frameAllocations, uploadStats.frameBytes / 1024.0f
+			, m_uploadRing.capacity() / 1024, m_uploadRing.offsets_supported() ? "11.1 offsets" : "11.0 fallback", uploadStats.wraps);
 
-		// Bind our GBuffer textures as inputs to the pixel shader
-		systems.pD3DContext->PSSetShaderResources(0, 3, m_pGBufferTextureViews);
+		const RGStats& graphStats = m_renderGraph.stats();
+		ImGui::Text("Render Graph: %u passes (%u culled), %u barriers, %u clears skipped", graphStats.passes, graphStats.culledPasses, graphStats.barriers, graphStats.skippedClears);
 
-		// Bind a random normal map for help with sampling
-		m_rndnrm.bind(systems.pD3DContext, ShaderStage::kPixel, 3);
+		//CPU rasterises each pass's declared coverage on its targets, lists any texel it would leave stale
+		bool validateCoverage = m_renderGraph.coverage_validation();
+		if (ImGui::Checkbox("Validate Target Coverage", &validateCoverage))
+		{
+			m_renderGraph.set_coverage_validation(validateCoverage);
+		}
+		if (validateCoverage)
 		{
-			m_SSAOShaders[m_ssaoSelect].bind(systems.pD3DContext);
+			u32 uncoveredTargets = 0;
+			for (const RGCoverageReport& report : m_renderGraph.coverage_reports())
+			{
+				if (report.coverage.full())
+					continue;
 
-			m_fullScreenQuad.bind(systems.pD3DContext);
-			m_fullScreenQuad.draw(systems.pD3DContext);
+				++uncoveredTargets;
+				ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s -> %s: %u texels uncovered (first %u, %u)%s", m_renderGraph.pass_name(report.pass)
+					, m_renderGraph.resource_name(report.resource), report.coverage.uncovered, report.coverage.firstUncoveredX, report.coverage.firstUncoveredY
+					, report.declared ? "" : ", kDontCare without coverage");
+			}
+			if (!uncoveredTargets)
+			{
+				ImGui::TextColored(ImVec4(0, 1, 0, 1), "%u covered targets, no uncovered texels", (u32)m_renderGraph.coverage_reports().size());
+			}
 		}
+		ImGui::Text("Transients: %u -> %u targets, %.2f MB -> %.2f MB", graphStats.transients, graphStats.physicalTransients
+			, graphStats.transientBytes / (1024.f * 1024.f), graphStats.physicalBytes / (1024.f * 1024.f));
+
+		const RTPoolStats& poolStats = m_renderGraphBackend.pool().stats();
+		ImGui::Text("Target Pool: %u targets, %.2f MB (peak %.2f MB), %u new / %u reused / %u evicted", poolStats.liveTargets
+			, poolStats.liveBytes / (1024.f * 1024.f), poolStats.peakBytes / (1024.f * 1024.f), poolStats.created, poolStats.reused, poolStats.evicted);
 
 		//=======================================================================================
-		// Blur Post FX
-		// Read the SSAO texture, Blur the result by ping-ponging render targets
+		// End all draws...
 		//=======================================================================================
 
-		//Move into blur texture viewport dimensions
-		systems.pD3DContext->RSSetViewports(1, &m_blurViewport);
+		// Unbind all the SRVs because we need them as targets next frame
+		m_renderGraphBackend.unbind_shader_resources();
 
-		m_BlurCBData.g_downsampleBlurFac = m_blurTargetDownSize;
-		m_BlurCBData.g_kawaseIteration = 0;
+		// re-bind depth for debugging output.
+		ID3D11RenderTargetView* views[] = { systems.pSwapRenderTarget, 0 };
+		systems.pD3DContext->OMSetRenderTargets(2, views, m_pGBuffer[kGBufferDepth]->pDSV);
+	}
 
-		// Push Data to GPU
-		D3D11_MAPPED_SUBRESOURCE sr_blur;
-		if (!FAILED(systems.pD3DContext->Map(m_pBlurCBData, 0, D3D11_MAP_WRITE_DISCARD, 0, &sr_blur)))
-		{
-			memcpy(sr_blur.pData, &m_BlurCBData, sizeof(BlurCBData));
-			systems.pD3DContext->Unmap(m_pBlurCBData, 0);
-		}
+	void on_resize(SystemsInterface& systems) override
+	{
+		// Nothing to recreate, the next frame asks the pool for targets at the new size and
+		// the old sizes age out of it.
+	}
 
-		// Bind Constant Buffers, to both PS and VS stages
-		ssaoBuffers[2] = { m_pBlurCBData };
-		systems.pD3DContext->PSSetConstantBuffers(0, 3, ssaoBuffers);
+	void on_shutdown(SystemsInterface& systems) override
+	{
+		m_renderGraphBackend.release();
+		m_uploadRing.release();
+		release_profile_queue();
 
-		//use this to figure out which blur to use after ping-ponging
-		int useBlurSRV = 1;
+#if COLLECT_DATA == 1
+		//TO THE DATA FILE FOR TIMING ANALYSIS!
+		std::fstream datalog;
+		datalog.open("Analysis/datalog.csv", std::ios::in | std::ios::app);
+		datalog.seekp(0, std::ios::end);
 
-		if (m_blurOn)
+		int f = datalog.tellg();
+		if (f == 0)  //if we have an empty file, add the col heads
 		{
-			switch (m_blurSelect)
-			{
-			case BlurType::kKawase:
-				DoKawase(5, systems, sr_blur);
-				break;
-			case BlurType::kKawaseMedium:
-				DoKawase(4, systems, sr_blur);
-				break;
-			case BlurType::kKawaseSmall:
-				DoKawase(3, systems, sr_blur);
-				break;
-			case BlurType::kSlowGauss:
-				systems.pD3DContext->ClearRenderTargetView(m_pBlurSSAORTV[1], clearValue);
+			datalog << "Technique Time (ms), SSAO, SSAO DownSample x, SSAO Num Samples, Blur, Blur DownSample x, Sampler Type\n";
+		}
 
-				// Here we are binding the Blur RTV buffer as render target
-				views[0] = m_pBlurSSAORTV[1];
-				systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		for(const auto& d : g_dataCollection)
+		{
+		datalog << std::fixed << d.frameTime << ","
+			<< m_ssaoNames[d.ssao] << ","
+			<< d.ssaoDS << ","
+			<< d.ssaoSamp * 4 << ","
+			<< m_blurNames[d.blur] << ","
+			<< d.blurDS << ","
+			<< m_samplerNames[d.sampler]
+#if defined _DEBUG
+			<< ", Debug"
+#else
+			<< ", Release"
+#endif
+			<< std::endl;
+		}
+#endif
+	}
 
-				// Bind our ssao texture as input to the pixel shader
-				systems.pD3DContext->PSSetShaderResources(0, 1, &m_pSSAOSRV);
+private:
 
-				{
-					m_GaussBlur.bind(systems.pD3DContext);
+	enum EGBufferConstants
+	{
+		kGBufferColourSpec, // RGBA8 Target, Albido Colour RGB + Baked Ambient Visibility.
+		kGBufferNormal, // RG16 SNORM Target, octahedral Normal (GBufferEncoding.hlsli).
+		kGBufferDepth, // D24S8 Depth Target.
 
-					m_fullScreenQuad.bind(systems.pD3DContext);
-					m_fullScreenQuad.draw(systems.pD3DContext);
-				}
-				break;
+		kMaxGBufferColourTargets = 2,
+		kMaxGBufferTextures = 3
+	};
 
-			case BlurType::kFastGauss:
-			default:
-				DoFastGauss(3, systems);
-				break;
-			}
-		}
+	//-- Render graph passes
+	struct GBufferResources
+	{
+		RGResource colour;
+		RGResource normal;
+		RGResource depth;
 
-		//End the technique and try profile
-		if (m_enableProfiling)
+		//G-buffer as t0 - t2, the layout every deferred / SSAO shader expects
+		void read(RGPassBuilder& builder) const
 		{
-			end_profile_frame(frame, systems.pD3DContext);
-			profile_oldest_frame(systems.pD3DContext);
+			builder.read(colour, kGBufferColourSpec);
+			builder.read(normal, kGBufferNormal);
+			builder.read(depth, kGBufferDepth);
 		}
+	};
 
-		//=======================================================================================
-		// The Lighting
-		// Read the GBuffer textures, and "draw" light volumes for each of our lights.
-		// We use additive blending on the result.
-		//=======================================================================================
+	GBufferResources import_gbuffer(SystemsInterface& systems)
+	{
+		// 8 bytes a pixel for both colour targets, down from 16 with two RGBA16F targets.
+		RGTextureDesc colourDesc = RGTextureDesc::Create(systems.width, systems.height, RGFormat::kRGBA8_UNORM);
 
-		//Back to fullscreen pass viewport
-		systems.pD3DContext->RSSetViewports(1, &m_fsViewport);
+		// Clears to (0, 0), which decodes to +z.
+		RGTextureDesc normalDesc = RGTextureDesc::Create(systems.width, systems.height, RGFormat::kRG16_SNORM);
 
-		systems.pD3DContext->ClearRenderTargetView(systems.pSwapRenderTarget, clearValue);
+		RGTextureDesc depthDesc = RGTextureDesc::Create(systems.width, systems.height, RGFormat::kD24_UNORM_S8_UINT);
+		depthDesc.clearValue[0] = 1.f;
 
-		// Bind the swapchain target to the render target
-		// Make sure to unbind other gbuffer targets and depth
-		views[0] = systems.pSwapRenderTarget;
-		systems.pD3DContext->OMSetRenderTargets(2, views, 0);
+		// Pooled rather than transient, we still want depth after the graph for debug drawing.
+		m_pGBuffer[kGBufferColourSpec] = &m_renderGraphBackend.acquire_target(colourDesc);
+		m_pGBuffer[kGBufferNormal] = &m_renderGraphBackend.acquire_target(normalDesc);
+		m_pGBuffer[kGBufferDepth] = &m_renderGraphBackend.acquire_target(depthDesc);
 
-		// Bind our GBuffer textures & ssao buffer as inputs to the pixel shader
-		systems.pD3DContext->PSSetShaderResources(0, 3, m_pGBufferTextureViews);
+		GBufferResources gbuffer;
+		gbuffer.colour = m_renderGraph.import_texture("GBuffer Colour Spec", colourDesc, m_pGBuffer[kGBufferColourSpec]);
+		gbuffer.normal = m_renderGraph.import_texture("GBuffer Normal", normalDesc, m_pGBuffer[kGBufferNormal]);
+		gbuffer.depth = m_renderGraph.import_texture("GBuffer Depth", depthDesc, m_pGBuffer[kGBufferDepth]);
+		return gbuffer;
+	}
 
-		if (m_blurOn)
-		{
-			//Set the blur view as resource for next pass
-			systems.pD3DContext->PSSetShaderResources(3, 1, &m_pBlurSSAOSRV[useBlurSRV]);
-		}
-		else
-		{
-			//Direct bind the ssao buffer to the final lighting stage
-			systems.pD3DContext->PSSetShaderResources(3, 1, &m_pSSAOSRV);
-		}
+	//=======================================================================================
+	// The Geometry Pass.
+	// Draw our scene into the GBuffer, capturing all the information we need for lighting.
+	//=======================================================================================
+	void add_geometry_pass(SystemsInterface& systems, const GBufferResources& gbuffer)
+	{
+		m_renderGraph.add_pass("Geometry",
+			[&](RGPassBuilder& builder)
+			{
+				builder.write(gbuffer.colour, kGBufferColourSpec);
+				builder.write(gbuffer.normal, kGBufferNormal);
+				builder.write_depth(gbuffer.depth);
+			},
+			[this, &systems](const RGPassContext&)
+			{
+				draw_scene(systems);
 
-		// Bind SSAO Debugging shader.
-		static bool bDebugEnabled = false;
-		ImGui::Checkbox("SSAO Buffer Debug", &bDebugEnabled);
-		if (bDebugEnabled)
-		{
-			m_ssaoDebugShader.bind(systems.pD3DContext);
+				if (m_runCapture)
+				{
+					capture_frame(systems);
+					m_runCapture = false;
+				}
 
-			// ... and draw a full screen quad.
-			m_fullScreenQuad.bind(systems.pD3DContext);
-			m_fullScreenQuad.draw(systems.pD3DContext);
-		}
-		else
-		{
-			// if we are not debugging the we bind the lighting shader and start accumulating light volumes.
-			// bind the light constant buffer
-			systems.pD3DContext->PSSetConstantBuffers(2, 1, &m_pLightInfoCB);
+				if (m_runAdaptiveReference || m_runStorageReference || m_runSoftRasterCompare || m_runGroundTruth)
+				{
+					AOReference::GBuffer gbufferCopy;
+					read_back_gbuffer(systems, gbufferCopy);
+
+					// CPU reference of the adaptive technique, reports the taps it spends per pixel.
+					if (m_runAdaptiveReference)
+					{
+						AOReference::Image ao;
+						m_adaptiveStats = AOReference::ssao_adaptive(gbufferCopy, reference_params(), ao);
+					}
+
+					// Quantisation error of the AO / blur storage, at full resolution.
+					if (m_runStorageReference)
+					{
+						m_storageError = run_storage_reference(gbufferCopy);
+						m_storageErrorValid = true;
+					}
+
+					if (m_runSoftRasterCompare)
+					{
+						compare_soft_gbuffer(systems, gbufferCopy);
+					}
+
+					if (m_runGroundTruth)
+					{
+						run_ground_truth(gbufferCopy);
+					}
+
+					m_runAdaptiveReference = false;
+					m_runStorageReference = false;
+					m_runSoftRasterCompare = false;
+					m_runGroundTruth = false;
+				}
+			});
+	}
 
-			static int maxLights = m_lights.size();
-			ImGui::SliderInt("Lights", &maxLights, 1, m_lights.size());
+	void draw_scene(SystemsInterface& systems)
+	{
+		// Bind Constant Buffers, to both PS and VS stages
+		m_uploadRing.bind_vs(0, m_perFrameConstants);
+		m_uploadRing.bind_ps(0, m_perFrameConstants);
 
-			static v3 light_dir = { 0.5773, 0.5773, 0.5773 };
-			ImGui::SliderFloat3("Light Direction", (float*)&light_dir, 1.0f, -1.f);
-			light_dir.Normalize();
-			m_lights.front().m_shaderInfo.m_vDirection = v4(light_dir.x, light_dir.y, light_dir.z, 1.f);
+		// Bind a sampler state
+		ID3D11SamplerState* samplers[] = { m_pSamplerState[m_samplerSelect] };
+		systems.pD3DContext->PSSetSamplers(0, 1, samplers);
 
-			static v4 light_col = v4(1.f, 0.7f, .6f, 0.f) * 0.2f;
-			ImGui::ColorEdit4("Light Colour", (float*)&light_col);
-			m_lights.front().m_shaderInfo.m_vColour = light_col;
+		// Opaque blend
+		systems.pD3DContext->OMSetBlendState(m_pBlendStates[BlendStates::kOpaque], kBlendFactor, kSampleMask);
 
-			static v4 light_amb = v4(0.15, 0.15, 0.2, 1);
-			ImGui::ColorEdit4("Light Ambient", (float*)&light_amb);
-			m_lights.front().m_shaderInfo.m_vAmbient = light_amb;
+		m_geometryInstances.bind(systems.pD3DContext, kInstanceSlot);
 
-			for (u32 i = 0; i < (u32)maxLights; ++i)
-			{
-				auto& rLight(m_lights[i]);
-				// For drawing a directional light which hits everywhere we draw a full screen quad.
+		m_recordedPasses[kDrawPass_Geometry].replay(m_drawBackend);
+	}
 
-				// Update and the light info constants.
-				push_constant_buffer(systems.pD3DContext, m_pLightInfoCB, rLight.m_shaderInfo);
+	//Records this frame's draws into m_drawList, sorted, with their instance data uploaded, then into command buffers.
+	void record_draws(SystemsInterface& systems)
+	{
+		TRACE_SCOPE("Record Draws");
 
-				switch (rLight.m_type)
-				{
-				case kLightType_Directional:
-				{
-					m_directionalLightShader.bind(systems.pD3DContext);
-					m_fullScreenQuad.bind(systems.pD3DContext);
-					m_fullScreenQuad.draw(systems.pD3DContext);
+		m_drawList.clear();
 
-					// Additive blend so we accumulate for later lights
-					systems.pD3DContext->OMSetBlendState(m_pBlendStates[BlendStates::kAdditive], kBlendFactor, kSampleMask);
-				}
-				break;
-				case kLightType_Point:
-				{
-					m_pointLightShader.bind(systems.pD3DContext);
+		// Group what survived cull_scene() by shader and mesh, one instanced draw per group.
+		m_drawBatcher.clear();
+		for (u32 i : m_visibleDraws)
+		{
+			m_drawBatcher.add(m_drawItems[i].shader, m_drawItems[i].mesh, i);
+		}
+		m_drawBatcher.build();
 
-					// Compute Light MVP matrix.
-					m4x4 matModel = m4x4::CreateScale(rLight.m_shaderInfo.m_vAtt.w);
-					matModel *= m4x4::CreateTranslation(v3(rLight.m_shaderInfo.m_vPosition));
-					m4x4 matMVP = matModel * systems.pCamera->vpMatrix;
+		m_geometryInstanceData.clear();
+		for (u32 i : m_drawBatcher.items())
+		{
+			const m4x4& matModel = m_drawItems[i].matModel;
+			m_geometryInstanceData.push_back({ matModel.Transpose(), (matModel * systems.pCamera->vpMatrix).Transpose() });
+		}
+		m_geometryInstances.push(systems.pD3DDevice, systems.pD3DContext, m_geometryInstanceData.data(), (u32)m_geometryInstanceData.size());
 
-					// Update Per Draw Data
-					m_perDrawCBData.m_matMVP = matMVP.Transpose();
-					push_constant_buffer(systems.pD3DContext, m_pPerDrawCB, m_perDrawCBData);
+		for (const InstanceBatch& batch : m_drawBatcher.batches())
+		{
+			const PerBatchCBData batchData = { batch.firstInstance };
+			m_drawList.add(make_draw_key(kDrawPass_Geometry, batch.shader, batch.mesh, 0), batch.firstInstance, batch.instanceCount
+				, m_uploadRing.push(batchData).offset);
+		}
 
-					m_lightVolumeSphere.bind(systems.pD3DContext);
-					m_lightVolumeSphere.draw(systems.pD3DContext);
-				}
+		// Lights -- a full screen quad per directional light, the visible point light volumes in one instanced draw.
+		m_pointLightInstanceData.clear();
+		for (u32 i : m_visibleLights)
+		{
+			const Light& rLight = m_lights[i];
+
+			switch (rLight.m_type)
+			{
+			case kLightType_Directional:
+				m_drawList.add(make_draw_key(kDrawPass_Lighting, kSceneShader_DirectionalLight, kSceneMesh_FullScreenQuad, 0), 0, 1
+					, m_uploadRing.push(rLight.m_shaderInfo).offset);
 				break;
-				case kLightType_Spot:
-					break;
-				default:
-					break;
+			case kLightType_Point:
+			{
+				// Compute Light MVP matrix.
+				m4x4 matModel = m4x4::CreateScale(rLight.m_shaderInfo.m_vAtt.w);
+				matModel *= m4x4::CreateTranslation(v3(rLight.m_shaderInfo.m_vPosition));
+				m4x4 matMVP = matModel * systems.pCamera->vpMatrix;
 
-				}
+				m_pointLightInstanceData.push_back({ matMVP.Transpose(), rLight.m_shaderInfo });
+			}
+			break;
+			case kLightType_Spot:
+				break;
+			default:
+				break;
 			}
 		}
-		
-		//=======================================================================================
-		// End all draws...
-		//=======================================================================================
 
-		// Unbind all the SRVs because we need them as targets next frame
-		ID3D11ShaderResourceView* srvClear[] = { 0,0,0 };
-		systems.pD3DContext->PSSetShaderResources(0, 3, srvClear);
+		if (!m_pointLightInstanceData.empty())
+		{
+			m_pointLightInstances.push(systems.pD3DDevice, systems.pD3DContext, m_pointLightInstanceData.data(), (u32)m_pointLightInstanceData.size());
+			const PerBatchCBData batchData = { 0 };
+			m_drawList.add(make_draw_key(kDrawPass_Lighting, kSceneShader_PointLight, kSceneMesh_LightVolume, 0), 0, (u32)m_pointLightInstanceData.size()
+				, m_uploadRing.push(batchData).offset);
+		}
 
-		// re-bind depth for debugging output.
-		systems.pD3DContext->OMSetRenderTargets(2, views, m_pGBufferDepthView);
-	}
+		m_drawList.sort();
 
-	void on_resize(SystemsInterface& systems) override
-	{
-		create_gbuffer(systems.pD3DDevice, systems.pD3DContext, systems.width, systems.height);
-		create_postfx_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
-		create_ssao_resources(systems.pD3DDevice, systems.pD3DContext, systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
-		create_blur_downsample_viewport(systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize);
-		create_ssao_downsample_viewport(systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize);
+		// Each pass into command buffers, big passes spread over the recorder's workers. The
+		// graph's passes then only replay them.
+		for (u32 pass = 0; pass < kMaxDrawPasses; ++pass)
+		{
+			m_commandRecorder.record(m_drawList, pass, m_recordedPasses[pass]);
+		}
 	}
 
-	void on_shutdown(SystemsInterface& systems) override
+	//DrawBackend::draw(), the binds have been done by the draw list / command buffer.
+	void issue_draw(ID3D11DeviceContext* pContext, const DrawCommand& cmd)
 	{
-#if COLLECT_DATA == 1
-		//TO THE DATA FILE FOR TIMING ANALYSIS!
-		std::fstream datalog;
-		datalog.open("Analysis/datalog.csv", std::ios::in | std::ios::app);
-		datalog.seekp(0, std::ios::end);
+		const Mesh& mesh = *m_pSceneMeshes[draw_key_mesh(cmd.key)];
 
-		int f = datalog.tellg();
-		if (f == 0)  //if we have an empty file, add the col heads
+		// userData is the offset of the draw's constants in this frame's upload ring data.
+		if (draw_key_shader(cmd.key) == kSceneShader_DirectionalLight)
 		{
-			datalog << "Technique Time (ms), SSAO, SSAO DownSample x, SSAO Num Samples, Blur, Blur DownSample x, Sampler Type\n";
-		}
+			// Directional lights hit everywhere, a full screen quad with the light info constants.
+			m_uploadRing.bind_ps(2, { cmd.userData, (u32)sizeof(LightInfo) });
+			mesh.draw(pContext);
 
-		for(const auto& d : g_dataCollection)
-		{
-		datalog << std::fixed << d.frameTime << ","
-			<< m_ssaoNames[d.ssao] << ","
-			<< d.ssaoDS << ","
-			<< d.ssaoSamp * 4 << ","
-			<< m_blurNames[d.blur] << ","
-			<< d.blurDS << ","
-			<< m_samplerNames[d.sampler]
-#if defined _DEBUG
-			<< ", Debug"
-#else
-			<< ", Release"
-#endif
-			<< std::endl;
+			// Additive blend so we accumulate for later lights
+			pContext->OMSetBlendState(m_pBlendStates[BlendStates::kAdditive], kBlendFactor, kSampleMask);
+			return;
 		}
-#endif
-	}
 
-private:
+		m_uploadRing.bind_vs(3, { cmd.userData, (u32)sizeof(PerBatchCBData) });
 
-	enum EGBufferConstants
-	{
-		kGBufferColourSpec, // f16 Target, Albido Colour RGB + Specular Intensity.
-		kGBufferNormalPow, // f16 Target Nsormal + Specular Power.
-		kGBufferDepth, // f32 Depth Target.
+		mesh.draw_instanced(pContext, cmd.instanceCount);
+	}
 
-		kMaxGBufferColourTargets = 2,
-		kMaxGBufferTextures = 3
-	};
+	//-- Culling
+	void add_draw(u32 shader, u32 mesh, const m4x4& matModel)
+	{
+		m_drawItems.push_back({ shader, mesh, matModel });
+		m_drawCullSet.add(m_pSceneMeshes[mesh]->bounds().transformed(hlsl::float4x4::from_array((const f32*)&matModel)));
+	}
 
-	void create_gbuffer(ID3D11Device* pD3DDevice, ID3D11DeviceContext* pD3DContext, u32 width, u32 height)
+	//Fills the visible draw and light lists for this frame from the camera frustum
+	void cull_scene(SystemsInterface& systems)
 	{
-		HRESULT hr;
+		TRACE_SCOPE("Cull Scene");
 
-		// Release all outstanding references to the swap chain's buffers.
-		pD3DContext->OMSetRenderTargets(0, 0, 0);
+		const Frustum frustum = Frustum::FromPlanes(reinterpret_cast<const f32(*)[4]>(systems.pCamera->planes));
 
-		// destroy old g-buffer views.
-		SAFE_RELEASE(m_pGBufferDepthView);
+		//Scene
+		m_drawItems.clear();
+		m_drawCullSet.clear();
 
-		for (u32 i = 0; i < kMaxGBufferColourTargets; ++i)
+		for (int i(0); i < kRoomPlanes; ++i)
 		{
-			SAFE_RELEASE(m_pGBufferTargetViews[i]);
+			add_draw(kSceneShader_NoTex, kSceneMesh_Plane, m_mmRoomPlanes[i]);
 		}
 
-		// destroy old g-buffer textures.
-		for (u32 i = 0; i < kMaxGBufferTextures; ++i)
+		// stanford dragons
+		for (int i(0); i < 3; ++i)
 		{
-			SAFE_RELEASE(m_pGBufferTexture[i]);
-			SAFE_RELEASE(m_pGBufferTextureViews[i]);
+			add_draw(kSceneShader_NoTex, kSceneMesh_Dragon, dragon_transform(i));
 		}
 
-		// Create a colour buffers
-		for (u32 i = 0; i < kMaxGBufferColourTargets; ++i)
+		for (const m4x4& m : m_boxes)
 		{
-			D3D11_TEXTURE2D_DESC desc;
-			desc.Width = width;
-			desc.Height = height;
-			desc.MipLevels = 1;
-			desc.ArraySize = 1;
-			desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; // 4 component f16 targets
-			desc.SampleDesc.Count = 1;
-			desc.SampleDesc.Quality = 0;
-			desc.Usage = D3D11_USAGE_DEFAULT;
-			desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-			desc.CPUAccessFlags = 0;
-			desc.MiscFlags = 0;
+			add_draw(kSceneShader_NoTex, kSceneMesh_Box, m);
+		}
 
-			hr = pD3DDevice->CreateTexture2D(&desc, NULL, &m_pGBufferTexture[i]);
-			if (FAILED(hr))
-			{
-				panicF("Failed colour texture for GBuffer");
-			}
+		cull_frustum(frustum, m_drawCullSet, m_visibleDraws);
 
-			// render target views.
-			hr = pD3DDevice->CreateRenderTargetView(m_pGBufferTexture[i], NULL, &m_pGBufferTargetViews[i]);
-			if (FAILED(hr))
+		//Lights -- directional lights touch everything, point lights are culled by their volume
+		m_visibleLights.clear();
+		m_lightCullSet.clear();
+		m_lightCullIndices.clear();
+
+		for (u32 i = 0; i < (u32)m_maxLights; ++i)
+		{
+			const Light& rLight = m_lights[i];
+			if (rLight.m_type != kLightType_Point)
 			{
-				panicF("Failed colour target view for GBuffer");
+				m_visibleLights.push_back(i);
+				continue;
 			}
 
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-			srvDesc.Format = desc.Format;
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-			srvDesc.Texture2D.MipLevels = 1;
+			m4x4 matModel = m4x4::CreateScale(rLight.m_shaderInfo.m_vAtt.w);
+			matModel *= m4x4::CreateTranslation(v3(rLight.m_shaderInfo.m_vPosition));
 
-			hr = pD3DDevice->CreateShaderResourceView(m_pGBufferTexture[i], &srvDesc, &m_pGBufferTextureViews[i]);
-			if (FAILED(hr))
-			{
-				panicF("Failed to create SRV of Target for GBuffer");
-			}
+			m_lightCullSet.add(m_lightVolumeSphere.bounds().transformed(hlsl::float4x4::from_array((const f32*)&matModel)));
+			m_lightCullIndices.push_back(i);
 		}
 
-		// Create a depth buffer
+		cull_frustum(frustum, m_lightCullSet, m_visibleCulledLights);
+		for (u32 i : m_visibleCulledLights)
+		{
+			m_visibleLights.push_back(m_lightCullIndices[i]);
+		}
+	}
+
+	//=======================================================================================
+	// SSAO
+	// Read the GBuffer textures, reconstruct depth and do AO into a new SSAO sized target.
+	//=======================================================================================
+	RGResource add_ssao_passes(SystemsInterface& systems, const GBufferResources& gbuffer, FrameProfile*& pProfile)
+	{
+		const RGTextureDesc ssaoDesc = RGTextureDesc::Create(systems.width / m_ssaoTargetDownSize, systems.height / m_ssaoTargetDownSize, ao_storage_format(kAOStage_SSAO));
+		const RGResource ao = m_renderGraph.create_texture("SSAO", ssaoDesc);
+
+		if (m_ssaoSelect != kAdaptiveSSAO)
 		{
-			D3D11_TEXTURE2D_DESC desc;
-			desc.Width = width;
-			desc.Height = height;
-			desc.MipLevels = 1;
-			desc.ArraySize = 1;
-			desc.Format = DXGI_FORMAT_R24G8_TYPELESS; // Typeless because we are binding as SRV and DepthStencilView
-			desc.SampleDesc.Count = 1;
-			desc.SampleDesc.Quality = 0;
-			desc.Usage = D3D11_USAGE_DEFAULT;
-			desc.BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE;
-			desc.CPUAccessFlags = 0;
-			desc.MiscFlags = 0;
+			m_renderGraph.add_pass("SSAO",
+				[&](RGPassBuilder& builder)
+				{
+					gbuffer.read(builder);
+					builder.write(ao);
+				},
+				[this, &systems, &pProfile](const RGPassContext&)
+				{
+					//Begin profiling for the technique
+					if (m_enableProfiling)
+					{
+						pProfile = begin_profile_frame(systems.pD3DContext);
+					}
+
+					bind_ssao_inputs(systems);
+					m_SSAOShaders[m_ssaoSelect].bind(systems.pD3DContext);
+
+					m_fullScreenQuad.bind(systems.pD3DContext);
+					m_fullScreenQuad.draw(systems.pD3DContext);
+				});
+			return ao;
+		}
+
+		//Adaptive SSAO : base taps -> importance map -> extra taps where needed
+		RGTextureDesc importanceDesc = ssaoDesc;
+		importanceDesc.format = RGFormat::kR8_UNORM;	// importance 0..1
+
+		RGTextureDesc baseDesc = ssaoDesc;
+		baseDesc.format = RGFormat::kR16_FLOAT;	// base AO, unnormalised so it can exceed 1, whatever the storage policy
+
+		const RGResource base = m_renderGraph.create_texture("Adaptive Base", baseDesc);
+		const RGResource importance = m_renderGraph.create_texture("Adaptive Importance", importanceDesc);
 
-			hr = pD3DDevice->CreateTexture2D(&desc, NULL, &m_pGBufferTexture[kGBufferDepth]);
-			if (FAILED(hr))
+		m_renderGraph.add_pass("Adaptive Base",
+			[&](RGPassBuilder& builder)
 			{
-				panicF("Failed to create Depth Buffer for GBuffer");
-			}
+				gbuffer.read(builder);
+				builder.write(base);
+			},
+			[this, &systems, &pProfile](const RGPassContext&)
+			{
+				if (m_enableProfiling)
+				{
+					pProfile = begin_profile_frame(systems.pD3DContext);
+				}
 
-			D3D11_DEPTH_STENCIL_VIEW_DESC depthDesc = {};
-			depthDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT; // View suitable for writing depth
-			depthDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-			depthDesc.Texture2D.MipSlice = 0;
+				bind_ssao_inputs(systems);
+				m_adaptiveBase.bind(systems.pD3DContext);
 
-			hr = pD3DDevice->CreateDepthStencilView(m_pGBufferTexture[kGBufferDepth], &depthDesc, &m_pGBufferDepthView);
-			if (FAILED(hr))
+				m_fullScreenQuad.bind(systems.pD3DContext);
+				m_fullScreenQuad.draw(systems.pD3DContext);
+			});
+
+		m_renderGraph.add_pass("Adaptive Importance",
+			[&](RGPassBuilder& builder)
 			{
-				panicF("Failed to create Depth Stencil View for GBuffer");
-			}
+				gbuffer.read(builder);
+				builder.read(base, 4);
+				builder.write(importance);
+			},
+			[this, &systems](const RGPassContext&)
+			{
+				bind_ssao_inputs(systems);
+				m_importance.bind(systems.pD3DContext);
+
+				m_fullScreenQuad.bind(systems.pD3DContext);
+				m_fullScreenQuad.draw(systems.pD3DContext);
+			});
+
+		m_renderGraph.add_pass("Adaptive SSAO",
+			[&](RGPassBuilder& builder)
+			{
+				gbuffer.read(builder);
+				builder.read(base, 4);
+				builder.read(importance, 5);
+				builder.write(ao);
+			},
+			[this, &systems](const RGPassContext&)
+			{
+				bind_ssao_inputs(systems);
+				m_SSAOShaders[kAdaptiveSSAO].bind(systems.pD3DContext);
+
+				m_fullScreenQuad.bind(systems.pD3DContext);
+				m_fullScreenQuad.draw(systems.pD3DContext);
+			});
+
+		return ao;
+	}
+
+	//CBs, blend state and the noise tile every SSAO pass uses, the graph binds the G-buffer
+	void bind_ssao_inputs(SystemsInterface& systems)
+	{
+		systems.pD3DContext->OMSetBlendState(m_pBlendStates[BlendStates::kOpaque], kBlendFactor, kSampleMask);
 
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-			srvDesc.Format = DXGI_FORMAT_R24_UNORM_X8_TYPELESS; // View suitable for decoding full 24bits of depth to red channel.
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-			srvDesc.Texture2D.MipLevels = 1;
+		m_uploadRing.bind_ps(0, m_perFrameConstants);
+		m_uploadRing.bind_ps(1, m_ssaoConstants);
 
-			hr = pD3DDevice->CreateShaderResourceView(m_pGBufferTexture[kGBufferDepth], &srvDesc, &m_pGBufferTextureViews[kGBufferDepth]);
-			if (FAILED(hr))
+		// Bind a random normal map for help with sampling
+		m_rndnrm.bind(systems.pD3DContext, ShaderStage::kPixel, 3);
+	}
+
+	//=======================================================================================
+	// Blur Post FX
+	// Each blur pass reads the previous result and writes a new blur sized target, the
+	// graph puts them back on the same couple of textures (what the ping-pong did by hand).
+	//=======================================================================================
+	RGResource add_blur_passes(SystemsInterface& systems, RGResource ao)
+	{
+		// Passes in between use the blur storage, the last one (what lighting reads) the output storage.
+		const RGTextureDesc blurDesc = RGTextureDesc::Create(systems.width / m_blurTargetDownSize, systems.height / m_blurTargetDownSize, ao_storage_format(kAOStage_Blur));
+		RGTextureDesc outputDesc = blurDesc;
+		outputDesc.format = ao_storage_format(kAOStage_BlurOutput);
+
+		switch (m_blurSelect)
+		{
+		case BlurType::kKawase:
+			return add_kawase_passes(systems, ao, blurDesc, outputDesc, 5);
+		case BlurType::kKawaseMedium:
+			return add_kawase_passes(systems, ao, blurDesc, outputDesc, 4);
+		case BlurType::kKawaseSmall:
+			return add_kawase_passes(systems, ao, blurDesc, outputDesc, 3);
+		case BlurType::kSlowGauss:
+			return add_blur_pass(systems, "Slow Gauss", m_GaussBlur, ao, outputDesc);
+		case BlurType::kDenoise4x4:
+			return add_blur_pass(systems, "Denoise 4x4", m_denoise4x4, ao, outputDesc);
+		case BlurType::kDualFilter:
+			return add_dual_filter_passes(systems, ao, blurDesc, outputDesc, m_dualFilterLevels);
+		case BlurType::kFusedGauss:
+			if (m_fusedBlurSupported)
 			{
-				panicF("Failed to create SRV of Depth for GBuffer");
+				return add_fused_blur_pass(systems, ao, outputDesc);
 			}
+			return add_fast_gauss_passes(systems, ao, blurDesc, outputDesc, 3);
+		case BlurType::kFastGauss:
+		default:
+			return add_fast_gauss_passes(systems, ao, blurDesc, outputDesc, 3);
 		}
+	}
+
+	//One full screen pass of a blur shader, ssaoBuffer (t0) is the input
+	RGResource add_blur_pass(SystemsInterface& systems, const char* pName, const ShaderSet& shader, RGResource input, const RGTextureDesc& desc, int kawaseIteration = 0)
+	{
+		const RGResource output = m_renderGraph.create_texture(pName, desc);
+
+		BlurCBData blurData = m_BlurCBData;
+		blurData.g_kawaseIteration = kawaseIteration;
+		const UploadAllocation blurConstants = m_uploadRing.push(blurData);
 
-		//Create the full screen viewport
-		m_fsViewport.Width = width;
-		m_fsViewport.Height = height;
-		m_fsViewport.TopLeftX = 0;
-		m_fsViewport.TopLeftY = 0;
-		m_fsViewport.MinDepth = 0;
-		m_fsViewport.MaxDepth = 1;
+		m_renderGraph.add_pass(pName,
+			[&](RGPassBuilder& builder)
+			{
+				builder.read(input, 0);
+				builder.write(output);
+				builder.cover(RGCoverage::FullScreenQuad());	// every blur writes each texel, no clear needed
+			},
+			[this, &systems, &shader, blurConstants](const RGPassContext&)
+			{
+				m_uploadRing.bind_ps(0, m_perFrameConstants);
+				m_uploadRing.bind_ps(1, m_ssaoConstants);
+				m_uploadRing.bind_ps(2, blurConstants);
+				systems.pD3DContext->PSSetSamplers(1, 1, &m_pBlurClampSampler);
+
+				shader.bind(systems.pD3DContext);
+
+				m_fullScreenQuad.bind(systems.pD3DContext);
+				m_fullScreenQuad.draw(systems.pD3DContext);
+			});
+
+		return output;
 	}
 
-	void create_blur_downsample_viewport(float width, float height)
+	RGResource add_kawase_passes(SystemsInterface& systems, RGResource ao, const RGTextureDesc& desc, const RGTextureDesc& outputDesc, int iterations)
 	{
-		//Create the downsample screen viewport
-		m_blurViewport.Width = width;
-		m_blurViewport.Height = height;
-		m_blurViewport.TopLeftX = 0;
-		m_blurViewport.TopLeftY = 0;
-		m_blurViewport.MinDepth = 0;
-		m_blurViewport.MaxDepth = 1;
+		for (int i(0); i < iterations; ++i)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "Kawase %d", i);
+			ao = add_blur_pass(systems, name, m_kawase, ao, i == iterations - 1 ? outputDesc : desc, i);
+		}
+		return ao;
 	}
 
-	void create_ssao_downsample_viewport(float width, float height)
+	RGResource add_fast_gauss_passes(SystemsInterface& systems, RGResource ao, const RGTextureDesc& desc, const RGTextureDesc& outputDesc, int iterations)
 	{
-		//Create the downsample screen viewport
-		m_ssaoViewport.Width = width;
-		m_ssaoViewport.Height = height;
-		m_ssaoViewport.TopLeftX = 0;
-		m_ssaoViewport.TopLeftY = 0;
-		m_ssaoViewport.MinDepth = 0;
-		m_ssaoViewport.MaxDepth = 1;
+		for (int i(0); i < iterations; ++i)
+		{
+			ao = add_blur_pass(systems, "Fast Gauss X", m_GaussX, ao, desc);
+			ao = add_blur_pass(systems, "Fast Gauss Y", m_GaussY, ao, i == iterations - 1 ? outputDesc : desc);
+		}
+		return ao;
 	}
 
-	void create_postfx_resources(ID3D11Device* pD3DDevice, ID3D11DeviceContext* pD3DContext, u32 width, u32 height)
+	//Down to levels half size targets and back up, the last up pass writes the blur sized output
+	RGResource add_dual_filter_passes(SystemsInterface& systems, RGResource ao, const RGTextureDesc& desc, const RGTextureDesc& outputDesc, int levels)
 	{
-		HRESULT hr;
+		for (int level(1); level <= levels; ++level)
+		{
+			RGTextureDesc levelDesc = desc;
+			levelDesc.width = dual_filter_level_size(desc.width, level);
+			levelDesc.height = dual_filter_level_size(desc.height, level);
+
+			char name[32];
+			snprintf(name, sizeof(name), "Dual Down %d", level);
+			ao = add_blur_pass(systems, name, m_dualDown, ao, levelDesc);
+		}
 
-		for (int i(0); i < 2; ++i)
+		for (int level(levels - 1); level >= 0; --level)
 		{
-			SAFE_RELEASE(m_pBlurSSAORTV[i]);
-			SAFE_RELEASE(m_pBlurSSAOTextures[i]);
-			SAFE_RELEASE(m_pBlurSSAOSRV[i]);
+			RGTextureDesc levelDesc = level ? desc : outputDesc;
+			levelDesc.width = dual_filter_level_size(desc.width, level);
+			levelDesc.height = dual_filter_level_size(desc.height, level);
 
-			// Create a colour buffers
-			D3D11_TEXTURE2D_DESC desc;
-			desc.Width = width;
-			desc.Height = height;
-			desc.MipLevels = 1;
-			desc.ArraySize = 1;
-			desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; // 4 component f16 targets
-			desc.SampleDesc.Count = 1;
-			desc.SampleDesc.Quality = 0;
-			desc.Usage = D3D11_USAGE_DEFAULT;
-			desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-			desc.CPUAccessFlags = 0;
-			desc.MiscFlags = 0;
+			char name[32];
+			snprintf(name, sizeof(name), "Dual Up %d", level);
+			ao = add_blur_pass(systems, name, m_dualUp, ao, levelDesc);
+		}
+		return ao;
+	}
 
-			hr = pD3DDevice->CreateTexture2D(&desc, NULL, &m_pBlurSSAOTextures[i]);
-			if (FAILED(hr))
-			{
-				panicF("Failed colour texture for PostFx");
-			}
+	BlurKernel fused_blur_kernel() const
+	{
+		return m_fusedBoxRadius ? BlurKernel::Box(m_fusedBoxRadius, m_fusedIterations) : BlurKernel::Gauss9(m_fusedIterations);
+	}
 
-			// render target views.
-			hr = pD3DDevice->CreateRenderTargetView(m_pBlurSSAOTextures[i], NULL, &m_pBlurSSAORTV[i]);
-			if (FAILED(hr))
-			{
-				panicF("Failed colour target view for PostFx");
-			}
+	//Both directions in one compute pass, the tile and its apron stay in shared memory in between
+	RGResource add_fused_blur_pass(SystemsInterface& systems, RGResource input, const RGTextureDesc& desc)
+	{
+		const RGResource output = m_renderGraph.create_texture("Fused Gauss", desc);
+
+		const BlurKernel kernel = fused_blur_kernel();
+		FusedBlurCBData fusedData = {};
+		fusedData.g_fusedRadius = kernel.radius;
+		for (u32 i = 0; i <= kernel.radius; ++i)
+		{
+			fusedData.g_fusedWeights[i] = kernel.weight(i);
+		}
 
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-			srvDesc.Format = desc.Format;
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-			srvDesc.Texture2D.MipLevels = 1;
+		const UploadAllocation blurConstants = m_uploadRing.push(m_BlurCBData);
+		const UploadAllocation fusedConstants = m_uploadRing.push(fusedData);
 
-			hr = pD3DDevice->CreateShaderResourceView(m_pBlurSSAOTextures[i], &srvDesc, &m_pBlurSSAOSRV[i]);
-			if (FAILED(hr))
+		m_renderGraph.add_pass("Fused Gauss",
+			[&](RGPassBuilder& builder)
 			{
-				panicF("Failed to create SRV of Target for PostFx");
-			}
-		}
+				builder.read(input, 0);
+				builder.write_uav(output, 0);
+			},
+			[this, &systems, desc, blurConstants, fusedConstants](const RGPassContext&)
+			{
+				m_uploadRing.bind_cs(0, m_perFrameConstants);
+				m_uploadRing.bind_cs(2, blurConstants);
+				m_uploadRing.bind_cs(3, fusedConstants);
+
+				ID3D11SamplerState* samplers[] = { m_pSamplerState[m_samplerSelect] };
+				systems.pD3DContext->CSSetSamplers(0, 1, samplers);
+
+				m_fusedBlur.bind(systems.pD3DContext);
+
+				const u32 kTile = 16;	// FUSED_TILE
+				systems.pD3DContext->Dispatch((desc.width + kTile - 1) / kTile, (desc.height + kTile - 1) / kTile, 1);
+			});
+
+		return output;
 	}
 
-	void create_ssao_resources(ID3D11Device* pD3DDevice, ID3D11DeviceContext* pD3DContext, u32 width, u32 height)
+	RGFormat ao_storage_format(u32 stage) const
 	{
-		HRESULT hr;
+		return m_aoStorage[stage] == kAOStorage_R8 ? RGFormat::kR8_UNORM : RGFormat::kR16_FLOAT;
+	}
 
-		SAFE_RELEASE(m_pSSAORTV);
-		SAFE_RELEASE(m_pSSAOTexture);
-		SAFE_RELEASE(m_pSSAOSRV);
+	AOReference::Storage ao_reference_storage(u32 stage) const
+	{
+		return m_aoStorage[stage] == kAOStorage_R8 ? AOReference::Storage::kR8_UNORM : AOReference::Storage::kR16_FLOAT;
+	}
 
-		// Create a colour buffers
-		D3D11_TEXTURE2D_DESC desc;
-		desc.Width = width;
-		desc.Height = height;
-		desc.MipLevels = 1;
-		desc.ArraySize = 1;
-		desc.Format = DXGI_FORMAT_R16_FLOAT; // 1 component f16 target
-		desc.SampleDesc.Count = 1;
-		desc.SampleDesc.Quality = 0;
-		desc.Usage = D3D11_USAGE_DEFAULT;
-		desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-		desc.CPUAccessFlags = 0;
-		desc.MiscFlags = 0;	//Allows mip generation with context->GenerateMips()
+	//AO of the current technique (Vogel / Alchemy for the ones without a CPU port) through the current blur.
+	AOReference::StorageError run_storage_reference(const AOReference::GBuffer& gbuffer)
+	{
+		const AOReference::Params params = reference_params();
 
-		hr = pD3DDevice->CreateTexture2D(&desc, NULL, &m_pSSAOTexture);
-		if (FAILED(hr))
+		AOReference::Image ao;
+		switch (m_ssaoSelect)
 		{
-			panicF("Failed colour texture for SSAO");
+		case kSpiralSSAO:
+			AOReference::ssao_spiral(gbuffer, params, ao);
+			break;
+		case kAdaptiveSSAO:
+			AOReference::ssao_adaptive(gbuffer, params, ao);
+			break;
+		default:
+			AOReference::ssao_vogel_alchemy(gbuffer, params, ao, &m_workerPool);
+			break;
 		}
 
-		// render target views.
-		hr = pD3DDevice->CreateRenderTargetView(m_pSSAOTexture, NULL, &m_pSSAORTV);
-		if (FAILED(hr))
+		// Only the fast gauss, the fused gauss, the dual filter and the denoise have CPU ports, the other blurs are measured as the fast gauss.
+		AOReference::BlurChain chain = AOReference::BlurChain::kFastGauss;
+		u32 iterations = 3;
+		if (m_blurSelect == kDenoise4x4)
+		{
+			chain = AOReference::BlurChain::kDenoise4x4;
+		}
+		else if (m_blurSelect == kDualFilter)
+		{
+			chain = AOReference::BlurChain::kDualFilter;
+			iterations = m_dualFilterLevels;
+		}
+		else if (m_blurSelect == kFusedGauss && m_fusedBlurSupported)
+		{
+			chain = AOReference::BlurChain::kFused;
+		}
+		if (!m_blurOn)
 		{
-			panicF("Failed colour target view for SSAO");
+			// No blur, the SSAO target is what lighting reads.
+			return AOReference::blur_storage_error(ao, AOReference::BlurChain::kFastGauss, 0, ao_reference_storage(kAOStage_SSAO), AOReference::Storage::kFloat, AOReference::Storage::kFloat);
 		}
+		const BlurKernel fusedKernel = fused_blur_kernel();
+		return AOReference::blur_storage_error(ao, chain, iterations
+			, ao_reference_storage(kAOStage_SSAO), ao_reference_storage(kAOStage_Blur), ao_reference_storage(kAOStage_BlurOutput)
+			, &fusedKernel, &m_workerPool);
+	}
+
+	//=======================================================================================
+	// The Lighting
+	// Read the GBuffer textures and the final AO, and "draw" light volumes for each of our
+	// lights. We use additive blending on the result.
+	//=======================================================================================
+	void add_lighting_pass(SystemsInterface& systems, const GBufferResources& gbuffer, RGResource ao, RGResource backBuffer, FrameProfile*& pProfile)
+	{
+		m_renderGraph.add_pass("Lighting",
+			[&](RGPassBuilder& builder)
+			{
+				gbuffer.read(builder);
+				builder.read(ao, 3);
+				builder.write(backBuffer);
+			},
+			[this, &systems, &pProfile](const RGPassContext&)
+			{
+				//End the technique and try profile
+				if (m_enableProfiling)
+				{
+					end_profile_frame(pProfile, systems.pD3DContext);
+					profile_oldest_frames(systems.pD3DContext);
+				}
 
-		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Format = desc.Format;
-		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.MipLevels = 1;
+				if (m_ssaoDebugEnabled)
+				{
+					// Bind SSAO Debugging shader.
+					m_ssaoDebugShader.bind(systems.pD3DContext);
 
-		hr = pD3DDevice->CreateShaderResourceView(m_pSSAOTexture, &srvDesc, &m_pSSAOSRV);
-		if (FAILED(hr))
+					// ... and draw a full screen quad.
+					m_fullScreenQuad.bind(systems.pD3DContext);
+					m_fullScreenQuad.draw(systems.pD3DContext);
+				}
+				else
+				{
+					draw_lights(systems);
+				}
+			});
+	}
+
+	void draw_lights(SystemsInterface& systems)
+	{
+		// bind the per frame constants, the light info / per batch ones are bound per draw
+		m_uploadRing.bind_vs(0, m_perFrameConstants);
+		m_uploadRing.bind_ps(0, m_perFrameConstants);
+
+		// distance field AO for the directional light, off through the weight when there is no field
+		m_uploadRing.bind_ps(4, m_distanceFieldConstants);
+		if (!m_distanceField.empty())
 		{
-			panicF("Failed to create SRV of Target for SSAO");
+			m_distanceFieldTexture.bind(systems.pD3DContext, ShaderStage::kPixel, 4);
+			systems.pD3DContext->PSSetSamplers(1, 1, &m_pDistanceFieldSampler);
 		}
+
+		m_pointLightInstances.bind(systems.pD3DContext, kInstanceSlot);
+
+		m_recordedPasses[kDrawPass_Lighting].replay(m_drawBackend);
 	}
 
-	//Blurs
-	void DoKawase(int iterations, SystemsInterface& systems, D3D11_MAPPED_SUBRESOURCE& blurBuffer)
+	AOReference::Params reference_params() const
 	{
-		int useBlurSRV = 1;	//which SRV to use in ping-ponging the blur targets
-		f32 clearValue[] = { 0.f, 0.f, 0.f, 0.f };	//clear rtv to...
-		ID3D11RenderTargetView* views[] = { 0, 0 };
+		AOReference::Params params;
+		params.sampleRadius = m_sample_rad;
+		params.intensity = m_intensity;
+		params.scale = m_scale;
+		params.bias = m_bias;
+		params.samples = m_samples_mult;
+		params.maxDistance = m_maxDistance;
+		params.maxScreenRadius = m_maxScreenRadius;
+		params.adaptiveBaseTaps = m_adaptiveBaseTaps;
+		params.importanceVarianceScale = m_importanceVarianceScale;
+		params.importanceEdgeScale = m_importanceEdgeScale;
+		return params;
+	}
 
-		for (int i(0); i < iterations; ++i)
+	//The visible draws through SoftRaster::Rasterizer, compared texel by texel with the read back G-buffer
+	void compare_soft_gbuffer(SystemsInterface& systems, const AOReference::GBuffer& gpu)
+	{
+		for (u32 mesh = 0; mesh < kMaxSceneMeshes; ++mesh)
+		{
+			const Mesh& rMesh = *m_pSceneMeshes[mesh];
+			SoftRaster::MeshView& view = m_softMeshes[mesh];
+			view.pVertices = (const u8*)rMesh.cpu_vertices().data();
+			view.vertexCount = (u32)rMesh.cpu_vertices().size();
+			view.stride = sizeof(MeshVertex);
+			view.positionOffset = offsetof(MeshVertex, pos);
+			view.normalOffset = offsetof(MeshVertex, normal);
+			view.colourOffset = offsetof(MeshVertex, colour);
+			view.pIndices = rMesh.cpu_indices().empty() ? nullptr : rMesh.cpu_indices().data();
+			view.indexCount = (u32)rMesh.cpu_indices().size();
+		}
+
+		// Same matrices as record_draws() pushes in GeometryInstance, un-transposed.
+		std::vector<SoftRaster::Draw> draws;
+		for (u32 i : m_visibleDraws)
 		{
-			m_BlurCBData.g_kawaseIteration = i;
+			const DrawItem& item = m_drawItems[i];
+			const m4x4 matMVP = item.matModel * systems.pCamera->vpMatrix;
+
+			SoftRaster::Draw draw;
+			draw.pMesh = &m_softMeshes[item.mesh];
+			draw.matModel = hlsl::float4x4::from_array((const f32*)&item.matModel);
+			draw.matMVP = hlsl::float4x4::from_array((const f32*)&matMVP);
+			draws.push_back(draw);
+		}
 
-			// Push Data to GPU
-			if (!FAILED(systems.pD3DContext->Map(m_pBlurCBData, 0, D3D11_MAP_WRITE_DISCARD, 0, &blurBuffer)))
+		SoftRasterCompare& result = m_softRasterCompare;
+		result = SoftRasterCompare();
+		SoftRaster::GBuffer cpu;
+		cpu.resize(gpu.width, gpu.height);
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		SoftRaster::Rasterizer rasterizer(&m_workerPool);
+		result.stats = rasterizer.render(draws.data(), (u32)draws.size(), cpu);
+		result.milliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		f64 depthSum = 0.0;
+		u32 depthTexels = 0;
+		for (u32 y = 0; y < gpu.height; ++y)
+		{
+			for (u32 x = 0; x < gpu.width; ++x)
 			{
-				memcpy(blurBuffer.pData, &m_BlurCBData, sizeof(BlurCBData));
-				systems.pD3DContext->Unmap(m_pBlurCBData, 0);
+				const u32 texel = y * gpu.width + x;
+				const u32 cpuDepth = cpu.depthStencil[texel] & 0xFFFFFF;
+				const u32 gpuDepth = (u32)std::lround(gpu.depth[texel] * 16777215.f);
+				const bool cpuDrawn = cpuDepth != 0xFFFFFF;
+				const bool gpuDrawn = gpuDepth != 0xFFFFFF;
+				if (cpuDrawn != gpuDrawn)
+				{
+					++result.coverageDiffs;
+					continue;
+				}
+				if (!cpuDrawn)
+					continue;
+
+				const u32 steps = cpuDepth > gpuDepth ? cpuDepth - gpuDepth : gpuDepth - cpuDepth;
+				result.depthMaxSteps = std::max(result.depthMaxSteps, steps);
+				depthSum += steps;
+				++depthTexels;
+
+				const hlsl::float3 n = GBufferEncoding::unpack_normal(cpu.normal[texel]);
+				const hlsl::float3& m = gpu.normal[texel];
+				const f32 degrees = std::atan2(hlsl::length(hlsl::cross(n, m)), hlsl::dot(n, m)) * (180.f / 3.14159265f);
+				result.normalMaxDegrees = std::max(result.normalMaxDegrees, degrees);
 			}
+		}
+		result.depthMeanSteps = depthTexels ? (f32)(depthSum / depthTexels) : 0.f;
+		result.valid = true;
+	}
 
-			//set the blur data constant buffer
-			systems.pD3DContext->PSSetConstantBuffers(2, 1, &m_pBlurCBData);
+	//Ray traces the whole scene (not only the visible draws, occluders can be off screen) from the
+	//read back G-buffer, then calibrates the spiral and Vogel / Alchemy references' tap counts
+	void run_ground_truth(const AOReference::GBuffer& gbuffer)
+	{
+		GroundTruthResult& result = m_groundTruth;
+		result = GroundTruthResult();
 
-			//select Target
-			(i % 2 == 0) ?
-				systems.pD3DContext->ClearRenderTargetView(m_pBlurSSAORTV[1], clearValue) :
-				systems.pD3DContext->ClearRenderTargetView(m_pBlurSSAORTV[0], clearValue);
+		auto start = std::chrono::high_resolution_clock::now();
+		BVH bvh;
+		for (const DrawItem& item : m_drawItems)
+		{
+			const Mesh& rMesh = *m_pSceneMeshes[item.mesh];
+			const std::vector<MeshVertex>& vertices = rMesh.cpu_vertices();
+			const std::vector<u16>& indices = rMesh.cpu_indices();
+			bvh.add((const f32*)((const u8*)vertices.data() + offsetof(MeshVertex, pos)), (u32)vertices.size(), sizeof(MeshVertex), indices.empty() ? nullptr : indices.data(), (u32)indices.size()
+				, hlsl::float4x4::from_array((const f32*)&item.matModel));
+		}
+		bvh.build();
+		result.bvhMilliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		result.bvh = bvh.stats();
+
+		GroundTruthAO::Params params;
+		params.raysPerPixel = m_groundTruthRays;
+		params.maxDistance = m_maxDistance;
+
+		AOReference::Image groundTruth;
+		start = std::chrono::high_resolution_clock::now();
+		result.stats = GroundTruthAO::render(gbuffer, bvh, params, groundTruth, &m_workerPool);
+		result.milliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		result.spiralRows = GroundTruthAO::calibrate_spiral(gbuffer, groundTruth, reference_params(), SSAOKernels::kMaxTaps / 4, &m_workerPool, &result.spiralConverged);
+		result.spiralCheapest = GroundTruthAO::cheapest_acceptable(result.spiralRows, m_groundTruthTolerance);
+		result.rows = GroundTruthAO::calibrate_vogel_alchemy(gbuffer, groundTruth, reference_params(), SSAOKernels::kMaxTaps / 4, &m_workerPool, &result.converged);
+		result.cheapest = GroundTruthAO::cheapest_acceptable(result.rows, m_groundTruthTolerance);
+		result.valid = true;
+	}
+
+	//Loads the mesh's baked AO from pCachePath, or bakes it and writes the cache, then rebuilds the
+	//buffers with it in the vertex alpha
+	void bake_vertex_ao(ID3D11Device* pDevice, Mesh& rMesh, const char* pCachePath)
+	{
+		TRACE_SCOPE_CAT("load", "Bake Vertex AO");
+
+		std::vector<MeshVertex> vertices = rMesh.cpu_vertices();
+		const std::vector<u16> indices = rMesh.cpu_indices();
+		const f32* pPositions = (const f32*)((const u8*)vertices.data() + offsetof(MeshVertex, pos));
+		const f32* pNormals = (const f32*)((const u8*)vertices.data() + offsetof(MeshVertex, normal));
+		const u16* pIndices = indices.empty() ? nullptr : indices.data();
 
-			// Here we are binding the Blur RTV buffer as render target
-			views[0] = (i % 2 == 0) ? m_pBlurSSAORTV[1] : m_pBlurSSAORTV[0];
-			systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		const auto start = std::chrono::high_resolution_clock::now();
+		const VertexAO::Params params;
+		const u64 key = VertexAO::cache_key(pPositions, pNormals, (u32)vertices.size(), sizeof(MeshVertex), pIndices, (u32)indices.size(), params);
 
-			// Bind our ssao texture as input to the pixel shader
-			if (i != 0)
+		std::vector<u8> alpha;
+		m_vertexAO.cached = VertexAO::load_cache(pCachePath, key, (u32)vertices.size(), alpha);
+		if (!m_vertexAO.cached)
+		{
+			std::vector<f32> visibility;
+			VertexAO::bake(pPositions, pNormals, (u32)vertices.size(), sizeof(MeshVertex), pIndices, (u32)indices.size(), params, visibility, &m_workerPool);
+
+			alpha.resize(visibility.size());
+			for (size_t i = 0; i < visibility.size(); ++i)
 			{
-				(i % 2 == 0) ?
-					systems.pD3DContext->PSSetShaderResources(0, 1, &m_pBlurSSAOSRV[0]) :
-					systems.pD3DContext->PSSetShaderResources(0, 1, &m_pBlurSSAOSRV[1]);
-				(i % 2 == 0) ?
-					useBlurSRV = 1 :
-					useBlurSRV = 0;
+				alpha[i] = VertexAO::to_alpha(visibility[i]);
 			}
-			else
+			if (!VertexAO::save_cache(pCachePath, key, alpha))
 			{
-				systems.pD3DContext->PSSetShaderResources(0, 1, &m_pSSAOSRV);
+				debugF("Couldn't write the vertex AO cache %s\n", pCachePath);
 			}
+		}
 
-			//do the blur pass
-			{
-				m_kawase.bind(systems.pD3DContext);
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			vertices[i].colour = VertexAO::pack(vertices[i].colour, alpha[i]);
+		}
+		rMesh.release();
+		rMesh.init_buffers(pDevice, vertices.data(), (u32)vertices.size(), pIndices, (u32)indices.size());
 
-				m_fullScreenQuad.bind(systems.pD3DContext);
-				m_fullScreenQuad.draw(systems.pD3DContext);
-			}
+		m_vertexAO.vertices = (u32)vertices.size();
+		m_vertexAO.milliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	static m4x4 dragon_transform(int i)
+	{
+		return m4x4::CreateRotationY(degToRad(-135)) * m4x4::CreateTranslation(v3(i * 4, 0, i * 4));
+	}
+
+	static void add_to_distance_field(DistanceField& field, const Mesh& rMesh, const m4x4& matModel)
+	{
+		const std::vector<MeshVertex>& vertices = rMesh.cpu_vertices();
+		const std::vector<u16>& indices = rMesh.cpu_indices();
+		field.add((const f32*)((const u8*)vertices.data() + offsetof(MeshVertex, pos)), (u32)vertices.size(), sizeof(MeshVertex)
+			, indices.empty() ? nullptr : indices.data(), (u32)indices.size(), hlsl::float4x4::from_array((const f32*)&matModel));
+	}
+
+	//Bakes the room, boxes and dragons (they never move) with m_distanceFieldDesc and uploads it as an R32 volume
+	void bake_distance_field(ID3D11Device* pDevice)
+	{
+		TRACE_SCOPE_CAT("load", "Bake Distance Field");
+
+		const auto start = std::chrono::high_resolution_clock::now();
+
+		m_distanceField.clear();
+		for (int i(0); i < kRoomPlanes; ++i)
+		{
+			add_to_distance_field(m_distanceField, m_plane, m_mmRoomPlanes[i]);
+		}
+		for (int i(0); i < 3; ++i)
+		{
+			add_to_distance_field(m_distanceField, m_s_dragon, dragon_transform(i));
 		}
+		for (const m4x4& m : m_boxes)
+		{
+			add_to_distance_field(m_distanceField, m_box, m);
+		}
+		m_distanceField.bake(m_distanceFieldDesc, &m_workerPool);
+
+		m_distanceFieldTexture.release();
+		m_distanceFieldTexture.init_from_memory_3d(pDevice, m_distanceField.size(0), m_distanceField.size(1), m_distanceField.size(2)
+			, DXGI_FORMAT_R32_FLOAT, m_distanceField.distances().data(), sizeof(f32));
 
-		//unbind for safety
-		views[0] = 0;
-		systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		m_distanceFieldMilliseconds = std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 	}
 
-	void DoFastGauss(int iterations, SystemsInterface& systems)
+	//Copy a G-buffer target's texels back as they are, 4 bytes each. Stalls on the GPU, only for debugging / validation.
+	void read_back_texels(SystemsInterface& systems, u32 target, std::vector<u32>& texels)
 	{
-		ID3D11RenderTargetView* views[] = { 0, 0 };
-		f32 clearValue[] = { 0.f, 0.f, 0.f, 0.f };	//clear rtv to...
+		D3D11_TEXTURE2D_DESC desc;
+		m_pGBuffer[target]->pTexture->GetDesc(&desc);
+		desc.Usage = D3D11_USAGE_STAGING;
+		desc.BindFlags = 0;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
 
-		for (int i(0); i < iterations; ++i)
+		ID3D11Texture2D* pStaging = nullptr;
+		if (FAILED(systems.pD3DDevice->CreateTexture2D(&desc, NULL, &pStaging)))
 		{
-			//X
-			systems.pD3DContext->ClearRenderTargetView(m_pBlurSSAORTV[0], clearValue);
+			panicF("Failed to create staging texture for GBuffer read back");
+		}
+		track_gpu_resource_d3d11(MemoryTag::kTransient, pStaging);
 
-			// Here we are binding the Blur RTV buffer as render target
-			views[0] = m_pBlurSSAORTV[0];
-			systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		systems.pD3DContext->CopyResource(pStaging, m_pGBuffer[target]->pTexture);
 
-			// Bind our ssao texture as input to the pixel shader
-			if (i != 0)
-			{
-				systems.pD3DContext->PSSetShaderResources(0, 1, &m_pBlurSSAOSRV[1]);
-			}
-			else
+		texels.assign(desc.Width * desc.Height, 0);
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		if (!FAILED(systems.pD3DContext->Map(pStaging, 0, D3D11_MAP_READ, 0, &mapped)))
+		{
+			for (u32 y = 0; y < desc.Height; ++y)
 			{
-				systems.pD3DContext->PSSetShaderResources(0, 1, &m_pSSAOSRV);
+				memcpy(&texels[y * desc.Width], (const u8*)mapped.pData + y * mapped.RowPitch, desc.Width * sizeof(u32));
 			}
+			systems.pD3DContext->Unmap(pStaging, 0);
+		}
 
-			{
-				m_GaussX.bind(systems.pD3DContext);
+		untrack_gpu_resource_d3d11(MemoryTag::kTransient, pStaging);
+		SAFE_RELEASE(pStaging);
+	}
 
-				m_fullScreenQuad.bind(systems.pD3DContext);
-				m_fullScreenQuad.draw(systems.pD3DContext);
-			}
+	//Copy the G-buffer back for the CPU references. Stalls on the GPU, only for debugging / validation.
+	void read_back_gbuffer(SystemsInterface& systems, AOReference::GBuffer& gbuffer)
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		m_pGBuffer[kGBufferNormal]->pTexture->GetDesc(&desc);
 
-			//Y
-			systems.pD3DContext->ClearRenderTargetView(m_pBlurSSAORTV[1], clearValue);
+		// Un-transposed, AOReference uses the same row-vector mul as the shaders.
+		const m4x4 matInverseProj = systems.pCamera->projMatrix.Invert();
+		const m4x4 matInverseView = systems.pCamera->viewMatrix.Invert();
 
-			// Here we are binding the Blur RTV buffer as render target
-			views[0] = m_pBlurSSAORTV[1];
-			systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		gbuffer.resize(desc.Width, desc.Height);
+		gbuffer.matProjection = hlsl::float4x4::from_array((const f32*)&systems.pCamera->projMatrix);
+		gbuffer.matView = hlsl::float4x4::from_array((const f32*)&systems.pCamera->viewMatrix);
+		gbuffer.matInverseProjection = hlsl::float4x4::from_array((const f32*)&matInverseProj);
+		gbuffer.matInverseView = hlsl::float4x4::from_array((const f32*)&matInverseView);
 
-			// Bind our ssao texture as input to the pixel shader
-			systems.pD3DContext->PSSetShaderResources(0, 1, &m_pBlurSSAOSRV[0]);
+		std::vector<u32> texels;
+		read_back_texels(systems, kGBufferDepth, texels);
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			// R24G8, depth in the low 24 bits.
+			gbuffer.depth[i] = (texels[i] & 0xFFFFFF) / 16777215.f;
+		}
 
-			{
-				m_GaussY.bind(systems.pD3DContext);
+		read_back_texels(systems, kGBufferNormal, texels);
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			// Same decode as the shaders, including the SNORM quantisation.
+			gbuffer.normal[i] = GBufferEncoding::unpack_normal(texels[i]);
+		}
+	}
 
-				m_fullScreenQuad.bind(systems.pD3DContext);
-				m_fullScreenQuad.draw(systems.pD3DContext);
-			}
+	//The G-buffer as it is and this frame's PerFrameCB / SSAOCB into the next capture_NNN.ssfc in the working directory
+	void capture_frame(SystemsInterface& systems)
+	{
+		std::vector<u32> planes[kMaxGBufferTextures];
+		for (u32 t = 0; t < kMaxGBufferTextures; ++t)
+		{
+			read_back_texels(systems, t, planes[t]);
 		}
 
-		//unbind for safety
-		views[0] = 0;
-		systems.pD3DContext->OMSetRenderTargets(2, views, NULL);
+		D3D11_TEXTURE2D_DESC desc;
+		m_pGBuffer[kGBufferNormal]->pTexture->GetDesc(&desc);
+
+		// The capture holds the matrices un-transposed, like SSAOFrame uploads them.
+		const m4x4 matViewProj = systems.pCamera->viewMatrix * systems.pCamera->projMatrix;
+		const m4x4 matInverseProj = systems.pCamera->projMatrix.Invert();
+		const m4x4 matInverseView = systems.pCamera->viewMatrix.Invert();
+
+		FrameCapture::Frame frame;
+		frame.width = desc.Width;
+		frame.height = desc.Height;
+		frame.pDepth = planes[kGBufferDepth].data();
+		frame.pNormal = planes[kGBufferNormal].data();
+		frame.pColourSpec = planes[kGBufferColourSpec].data();
+		frame.perFrame.matProjection = hlsl::float4x4::from_array((const f32*)&systems.pCamera->projMatrix);
+		frame.perFrame.matView = hlsl::float4x4::from_array((const f32*)&systems.pCamera->viewMatrix);
+		frame.perFrame.matViewProjection = hlsl::float4x4::from_array((const f32*)&matViewProj);
+		frame.perFrame.matInverseProjection = hlsl::float4x4::from_array((const f32*)&matInverseProj);
+		frame.perFrame.matInverseView = hlsl::float4x4::from_array((const f32*)&matInverseView);
+		frame.perFrame.time = m_perFrameCBData.m_time;
+		frame.perFrame.screenW = m_perFrameCBData.m_screenW;
+		frame.perFrame.screenH = m_perFrameCBData.m_screenH;
+
+		static_assert(sizeof(SSAOCBData) == sizeof(SSAOFrame::SSAOConstants), "SSAOCBData and SSAOFrame::SSAOConstants mirror the same cbuffer");
+		memcpy(&frame.ssao, &m_SSAOCBData, sizeof(frame.ssao));
+
+		char path[64];
+		snprintf(path, sizeof(path), "capture_%03u.ssfc", m_captureCount);
+		if (FrameCapture::save(path, frame))
+		{
+			++m_captureCount;
+			m_captureStatus = std::string("Captured ") + path;
+		}
+		else
+		{
+			m_captureStatus = std::string("Couldn't write ") + path;
+		}
 	}
 
-	//-- Frame Time Profiling
-	void init_profile_queue()
+	//Everything in the trace buffers to trace_NNN.json, for chrome://tracing or ui.perfetto.dev
+	void save_trace()
 	{
-		m_profilingDataQueue.empty();
-		m_frameData.empty();
-		m_frameData.push(0.0f);
+		char path[64];
+		snprintf(path, sizeof(path), "trace_%03u.json", m_traceCount);
+		if (Trace::write_json(path))
+		{
+			++m_traceCount;
+			m_traceStatus = std::string("Saved ") + path;
+		}
+		else
+		{
+			m_traceStatus = std::string("Couldn't write ") + path;
+		}
 	}
 
-	void begin_profile_frame(FrameProfile& data, ID3D11Device* pD3DDevice, ID3D11DeviceContext* pD3DContext)
+	//-- Frame Time Profiling
+	void init_profile_queue(ID3D11Device* pD3DDevice)
 	{
-		HRESULT res;
-		//create and start profiling a frame
+		//The queries are made once and reused round the ring
 		D3D11_QUERY_DESC queryDesc;
 		ZeroMemory(&queryDesc, sizeof(queryDesc));
 
-		queryDesc.Query = D3D11_QUERY_TIMESTAMP;
-		res = pD3DDevice->CreateQuery(&queryDesc, &data.startTime);
-		res = pD3DDevice->CreateQuery(&queryDesc, &data.endTime);
-		queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
-		res = pD3DDevice->CreateQuery(&queryDesc, &data.disjoint);
+		for (FrameProfile& data : m_profileFrames)
+		{
+			queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+			pD3DDevice->CreateQuery(&queryDesc, &data.startTime);
+			pD3DDevice->CreateQuery(&queryDesc, &data.endTime);
+			queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+			pD3DDevice->CreateQuery(&queryDesc, &data.disjoint);
+		}
 
-		//Begin events
-		pD3DContext->Begin(data.disjoint);
-		pD3DContext->End(data.startTime);
+		m_profileHead = m_profileCount = 0;
+		m_frameTimesHead = m_frameTimesCount = 0;
 	}
 
-	void end_profile_frame(FrameProfile& data, ID3D11DeviceContext* pD3DContext)
+	void release_profile_queue()
 	{
-		//push frame to queue after ending the event
-		pD3DContext->End(data.endTime);
-		pD3DContext->End(data.disjoint);
-
-		//try immediate profiling		
-		if (S_OK != pD3DContext->GetData(data.disjoint, &data.dData, sizeof(data.dData), 0) ||
-			S_OK != pD3DContext->GetData(data.startTime, &data.sData, sizeof(data.sData), 0) ||
-			S_OK != pD3DContext->GetData(data.endTime, &data.eData, sizeof(data.eData), 0))
+		for (FrameProfile& data : m_profileFrames)
 		{
-			add_to_profile_queue(data);
-		}
-		else
-		{
-			//profile
-			get_profile_timings(data);
+			SAFE_RELEASE(data.startTime);
+			SAFE_RELEASE(data.endTime);
+			SAFE_RELEASE(data.disjoint);
 		}
 	}
 
-	void add_to_profile_queue(FrameProfile& data)
+	FrameProfile* begin_profile_frame(ID3D11DeviceContext* pD3DContext)
 	{
-		m_profilingDataQueue.push(data);
+		//All query sets still waiting on the GPU, skip this frame
+		if (m_profileCount == kProfileFramesInFlight)
+			return nullptr;
+
+		FrameProfile& data = m_profileFrames[(m_profileHead + m_profileCount) % kProfileFramesInFlight];
+
+		//Begin events
+		pD3DContext->Begin(data.disjoint);
+		pD3DContext->End(data.startTime);
+		data.cpuStart = Trace::now_ns();
+		return &data;
 	}
 
-	void profile_oldest_frame(ID3D11DeviceContext* pD3DContext)
+	void end_profile_frame(FrameProfile* pData, ID3D11DeviceContext* pD3DContext)
 	{
-		FrameProfile* pFrame = &m_profilingDataQueue.front();
+		if (!pData)
+			return;
+
+		//queue the frame after ending the event, profile_oldest_frames() reads it when it's in
+		pD3DContext->End(pData->endTime);
+		pD3DContext->End(pData->disjoint);
+		++m_profileCount;
+	}
 
-		if (S_OK != pD3DContext->GetData(pFrame->disjoint, &pFrame->dData, sizeof(pFrame->dData), 0) ||
-			S_OK != pD3DContext->GetData(pFrame->startTime, &pFrame->sData, sizeof(pFrame->sData), 0) ||
-			S_OK != pD3DContext->GetData(pFrame->endTime, &pFrame->eData, sizeof(pFrame->eData), 0))
+	void profile_oldest_frames(ID3D11DeviceContext* pD3DContext)
+	{
+		//In order, stop at the first frame the GPU hasn't finished
+		while (m_profileCount)
 		{
-			//skip and try again next time
-		}
-		else
-		{ 
+			FrameProfile* pFrame = &m_profileFrames[m_profileHead];
+
+			if (S_OK != pD3DContext->GetData(pFrame->disjoint, &pFrame->dData, sizeof(pFrame->dData), 0) ||
+				S_OK != pD3DContext->GetData(pFrame->startTime, &pFrame->sData, sizeof(pFrame->sData), 0) ||
+				S_OK != pD3DContext->GetData(pFrame->endTime, &pFrame->eData, sizeof(pFrame->eData), 0))
+			{
+				//skip and try again next time
+				break;
+			}
+
 			//profile
 			get_profile_timings(*pFrame);
-			m_profilingDataQueue.pop();
+			m_profileHead = (m_profileHead + 1) % kProfileFramesInFlight;
+			--m_profileCount;
 		}
 	}
 
 	void get_profile_timings(FrameProfile& data)
 	{
-		//do timings and push to the visual data queue
-		float d;
+		//A disjoint frame's timestamps mean nothing
+		if (data.dData.Disjoint)
+			return;
 
-		if (!data.dData.Disjoint)
+		u64 Delta = data.eData - data.sData;
+		float Frequency = static_cast<float>(data.dData.Frequency);
+		float d = (Delta / Frequency) * 1000.0f;
+
+		//D3D11 has no CPU / GPU clock calibration, so the trace shows the interval from when its start was submitted
+		TRACE_GPU("AO Technique", data.cpuStart, (u64)(Delta * (1e9 / data.dData.Frequency)));
+
+		//push newest, over the oldest once the ring is full...
+		if (m_frameTimesCount < (u32)MAX_FRAMES_FOR_PROFILE_QUEUE)
 		{
-			u64 Delta = data.eData - data.sData;
-			float Frequency = static_cast<float>(data.dData.Frequency);
-			d = (Delta / Frequency) * 1000.0f;
+			m_frameTimes[(m_frameTimesHead + m_frameTimesCount++) % MAX_FRAMES_FOR_PROFILE_QUEUE] = d;
 		}
-
-		//pop oldest timing...
-		if (m_frameData.size() > MAX_FRAMES_FOR_PROFILE_QUEUE)
+		else
 		{
-			m_frameData.pop();
+			m_frameTimes[m_frameTimesHead] = d;
+			m_frameTimesHead = (m_frameTimesHead + 1) % MAX_FRAMES_FOR_PROFILE_QUEUE;
 		}
-
-		//push newest...
-		m_frameData.push(d);
 	}
 	//--
 
@@ -1351,13 +2146,15 @@ private:
 	enum SSAOType {
 		kStandardSSAO = 0,
 		kSpiralSSAO,
-		//KGPUZENAlchemy,
+		kVogelAlchemySSAO,
+		kAdaptiveSSAO,
 		kMaxSSAOTypes
 	};
 	std::string m_ssaoNames[kMaxSSAOTypes] = {
 		"Default Technique",
-		"Spiral Kernel"
-		//"GPU ZEN: Alchemy Spiral"
+		"Spiral Kernel",
+		"GPU ZEN: Vogel Disk + Alchemy",
+		"GPU ZEN: Adaptive (importance map)"
 	};
 
 	enum BlurType {
@@ -1366,6 +2163,9 @@ private:
 		kKawase,
 		kKawaseSmall,
 		kKawaseMedium,
+		kDenoise4x4,
+		kFusedGauss,
+		kDualFilter,
 		kMaxBlurs
 	};
 	std::string m_blurNames[kMaxBlurs] = {
@@ -1373,24 +2173,24 @@ private:
 		"Fast Gaussian: 9 tap using 5 texel fetches XY",
 		"Kawase LRG: 0, 1, 2, 2, 3",
 		"Kawase SML: 0, 1, 1",
-		"Kawase MED: 0, 1, 1, 2"
+		"Kawase MED: 0, 1, 1, 2",
+		"Denoise 4x4: pairs with Vogel noise tile",
+		"Fused Gaussian: one compute pass, tile + apron in shared memory",
+		"Dual Filter: Kawase down / up pyramid"
 	};
 
 	//-- CBs
 	PerFrameCBData m_perFrameCBData;
-	ID3D11Buffer* m_pPerFrameCB = nullptr;
+	UploadAllocation m_perFrameConstants;
 
-	PerDrawCBData m_perDrawCBData;
-	ID3D11Buffer* m_pPerDrawCB = nullptr;
+	UploadRingD3D11 m_uploadRing;
 
 	std::vector<Light> m_lights;
-	ID3D11Buffer* m_pLightInfoCB = nullptr;
 
 	BlurCBData m_BlurCBData;
-	ID3D11Buffer* m_pBlurCBData = nullptr;
 
 	SSAOCBData m_SSAOCBData;
-	ID3D11Buffer* m_pSSAOCB = nullptr;
+	UploadAllocation m_ssaoConstants;
 
 	//-- Shaders
 	ShaderSet m_geometryPassShader;
@@ -1400,12 +2200,25 @@ private:
 	ShaderSet m_ssaoDebugShader;
 
 	ShaderSet m_SSAOShaders[kMaxSSAOTypes];
+	ShaderSet m_adaptiveBase;
+	ShaderSet m_importance;
 	ShaderSet m_GaussBlur;
 
 	//FastBlurs
 	ShaderSet m_GaussX;
 	ShaderSet m_GaussY;
 	ShaderSet m_kawase;
+	ShaderSet m_denoise4x4;
+	ShaderSet m_fusedBlur;
+	bool m_fusedBlurSupported = false;
+	int m_fusedIterations = 3;
+	int m_fusedBoxRadius = 0;
+	ShaderSet m_dualDown;
+	ShaderSet m_dualUp;
+	int m_dualFilterLevels = 3;
+
+	//CPU reference work (storage error measurement)
+	WorkerPool m_workerPool;
 
 	//Samplers
 	ID3D11SamplerState* m_pSamplerState[kMaxSamplers] = { nullptr };
@@ -1424,7 +2237,7 @@ private:
 	Mesh m_fullScreenQuad;
 	Mesh m_lightVolumeSphere;
 
-	// Random Normals
+	// Blue noise rotations (SSAOKernels::kNoiseTileRGBA)
 	Texture m_rndnrm;
 
 	//SSAO Shader Resources
@@ -1441,42 +2254,209 @@ private:
 	float m_bias = 0.01;
 	int m_samples_mult = 2;
 	float m_maxDistance = 2.0;
+	float m_maxScreenRadius = 0.1f;
+	int m_adaptiveBaseTaps = 4;
+	float m_importanceVarianceScale = 4.0f;
+	float m_importanceEdgeScale = 8.0f;
+
+	//Adaptive CPU reference, runs once after the next geometry pass
+	bool m_runAdaptiveReference = false;
+	AOReference::AdaptiveStats m_adaptiveStats;
+
+	//Software G-buffer comparison, runs once after the next geometry pass
+	struct SoftRasterCompare
+	{
+		bool valid = false;
+		f32 milliseconds = 0.f;
+		SoftRaster::Stats stats;
+		u32 coverageDiffs = 0;		//texels only one of the two drew
+		u32 depthMaxSteps = 0;
+		f32 depthMeanSteps = 0.f;
+		f32 normalMaxDegrees = 0.f;
+	};
+	bool m_runSoftRasterCompare = false;
+	SoftRasterCompare m_softRasterCompare;
+
+	//Ray traced ground truth and tap count calibration, runs once after the next geometry pass
+	struct GroundTruthResult
+	{
+		bool valid = false;
+		f32 bvhMilliseconds = 0.f;
+		f32 milliseconds = 0.f;
+		BVH::Stats bvh;
+		GroundTruthAO::Stats stats;
+		std::vector<GroundTruthAO::Calibration> spiralRows;
+		u32 spiralCheapest = 0;
+		GroundTruthAO::Calibration spiralConverged;
+		std::vector<GroundTruthAO::Calibration> rows;		//Vogel / Alchemy
+		u32 cheapest = 0;
+		GroundTruthAO::Calibration converged;
+	};
+	bool m_runGroundTruth = false;
+
+	bool m_runCapture = false;
+	u32 m_captureCount = 0;
+	std::string m_captureStatus;
+
+	int m_traceFrames = 10;
+	u32 m_traceFramesLeft = 2;		//startup and the first whole frame
+	bool m_traceSaveWhenDone = false;
+	u32 m_traceCount = 0;
+	std::string m_traceStatus;
+	int m_groundTruthRays = 64;
+	float m_groundTruthTolerance = 0.5f;
+	GroundTruthResult m_groundTruth;
+
+	struct VertexAOResult
+	{
+		u32 vertices = 0;
+		bool cached = false;
+		f32 milliseconds = 0.f;
+	};
+	bool m_bakedAO = true;
+	VertexAOResult m_vertexAO;
+
+	DistanceField m_distanceField;
+	DistanceField::Desc m_distanceFieldDesc;
+	DistanceFieldAO::Params m_distanceFieldParams;
+	Texture m_distanceFieldTexture;
+	ID3D11SamplerState* m_pDistanceFieldSampler = nullptr;
+	ID3D11SamplerState* m_pBlurClampSampler = nullptr;
+	UploadAllocation m_distanceFieldConstants;
+	bool m_distanceFieldAO = true;
+	int m_distanceFieldSteps = 4;
+	float m_distanceFieldWeight = 1.0f;
+	f32 m_distanceFieldMilliseconds = 0.f;
 
 	//Blur vars
 	int m_blurKernel = 5;
 	float m_blurSigma = 7.0f;
 	bool m_blurOn = true;
 
-	int m_blurTargetDownSize = 1;
-	int m_ssaoTargetDownSize = 1;
+	int m_blurTargetDownSize = 2;
+	int m_ssaoTargetDownSize = 2;
 
-	D3D11_VIEWPORT m_blurViewport;
-	D3D11_VIEWPORT m_ssaoViewport;
-	D3D11_VIEWPORT m_fsViewport;
+	//AO storage per stage, the adaptive base is always R16F (unnormalised) and its importance map R8
+	enum AOStage {
+		kAOStage_SSAO = 0,
+		kAOStage_Blur,			// between blur passes
+		kAOStage_BlurOutput,	// what lighting reads
+		kMaxAOStages
+	};
+	enum AOStorage {
+		kAOStorage_R8 = 0,
+		kAOStorage_R16F,
+		kMaxAOStorages
+	};
+	const char* m_aoStorageNames[kMaxAOStorages] = {
+		"R8_UNORM",
+		"R16_FLOAT"
+	};
+	int m_aoStorage[kMaxAOStages] = { kAOStorage_R8, kAOStorage_R8, kAOStorage_R8 };
 
-	ID3D11Texture2D*			m_pSSAOTexture = nullptr;
-	ID3D11RenderTargetView*		m_pSSAORTV = nullptr;
-	ID3D11ShaderResourceView*	m_pSSAOSRV = nullptr;
+	//Storage CPU reference, runs once after the next geometry pass
+	bool m_runStorageReference = false;
+	bool m_storageErrorValid = false;
+	AOReference::StorageError m_storageError;
 
-	//PostFx -- Blurred SSAO Buffer
-	ID3D11Texture2D*			m_pBlurSSAOTextures[2] = { nullptr, nullptr };
-	ID3D11RenderTargetView*		m_pBlurSSAORTV[2] = { nullptr, nullptr };
-	ID3D11ShaderResourceView*	m_pBlurSSAOSRV[2] = { nullptr, nullptr };
+	//Lighting vars
+	bool m_ssaoDebugEnabled = false;
+	int m_maxLights = 0;
+
+	//Scene -- DrawItem and draw key ids index these. Key order is draw order, so within the lighting
+	//pass directional lights go first, they switch on the additive blend.
+	enum SceneMesh
+	{
+		kSceneMesh_Plane,
+		kSceneMesh_Dragon,
+		kSceneMesh_Box,
+		kSceneMesh_FullScreenQuad,
+		kSceneMesh_LightVolume,
+		kMaxSceneMeshes
+	};
+	const Mesh* m_pSceneMeshes[kMaxSceneMeshes] = { nullptr };
+	SoftRaster::MeshView m_softMeshes[kMaxSceneMeshes];
 
-	// GBuffer objects
-	ID3D11Texture2D*		m_pGBufferTexture[kMaxGBufferTextures];
-	ID3D11RenderTargetView* m_pGBufferTargetViews[kMaxGBufferColourTargets];
-	ID3D11DepthStencilView* m_pGBufferDepthView;
-	ID3D11ShaderResourceView* m_pGBufferTextureViews[kMaxGBufferTextures];
+	enum SceneShader
+	{
+		kSceneShader_NoTex,
+		kSceneShader_DirectionalLight,
+		kSceneShader_PointLight,
+		kMaxSceneShaders
+	};
+	ShaderSet* m_pSceneShaders[kMaxSceneShaders] = { nullptr };
+
+	enum DrawPass
+	{
+		kDrawPass_Geometry,
+		kDrawPass_Lighting,
+		kMaxDrawPasses
+	};
+
+	//Draw list -- recorded by record_draws(), submitted by the geometry and lighting passes
+	class DrawBackend : public DrawListBackend
+	{
+	public:
+		void bind_shader(u32 shader) override { pApp->m_pSceneShaders[shader]->bind(pContext); }
+		void bind_mesh(u32 mesh) override { pApp->m_pSceneMeshes[mesh]->bind(pContext); }
+		void bind_material(u32 material) override {}	// nothing textured in the scene, always 0
+		void draw(const DrawCommand& cmd) override { pApp->issue_draw(pContext, cmd); }
+
+		SSAOApp* pApp = nullptr;
+		ID3D11DeviceContext* pContext = nullptr;
+	};
+	DrawList m_drawList;
+	DrawBackend m_drawBackend;
+	CommandRecorder m_commandRecorder;
+	RecordedPass m_recordedPasses[kMaxDrawPasses];
+
+	//Culling -- rebuilt every frame by cull_scene()
+	struct DrawItem
+	{
+		u32 shader;
+		u32 mesh;
+		m4x4 matModel;
+	};
+	std::vector<DrawItem> m_drawItems;
+	CullSet m_drawCullSet;
+	std::vector<u32> m_visibleDraws;
+
+	CullSet m_lightCullSet;
+	std::vector<u32> m_lightCullIndices;	//light index of each m_lightCullSet entry
+	std::vector<u32> m_visibleCulledLights;
+	std::vector<u32> m_visibleLights;		//light indices to draw, in order
+
+	//Instancing -- visible draws grouped by shader / mesh, per instance data in batch order
+	InstanceBatcher m_drawBatcher;
+	std::vector<GeometryInstance> m_geometryInstanceData;
+	InstanceBuffer<GeometryInstance> m_geometryInstances;
+	std::vector<PointLightInstance> m_pointLightInstanceData;
+	InstanceBuffer<PointLightInstance> m_pointLightInstances;
+
+	//Render graph -- rebuilt every frame, the SSAO / blur targets are its transients
+	RenderGraph m_renderGraph;
+	RenderGraphD3D11 m_renderGraphBackend;
+	RGTextureD3D11 m_backBuffer;
+
+	// GBuffer objects -- this frame's targets from the pool
+	RGTextureD3D11* m_pGBuffer[kMaxGBufferTextures] = { nullptr, nullptr, nullptr };
 
 	v3 m_position;
 	f32 m_size;
 
-	//Profiling
+	//Profiling -- rings, so a profiled frame creates no queries and allocates nothing
 	bool m_enableProfiling = true;
-	std::queue<FrameProfile> m_profilingDataQueue;
-	std::queue<float> m_frameData;
-	float test_data[MAX_FRAMES_FOR_PROFILE_QUEUE] = { 0 };
+	FrameProfile m_profileFrames[kProfileFramesInFlight] = {};
+	u32 m_profileHead = 0;		//oldest frame waiting on its queries
+	u32 m_profileCount = 0;
+	float m_frameTimes[MAX_FRAMES_FOR_PROFILE_QUEUE] = { 0 };
+	u32 m_frameTimesHead = 0;	//oldest time
+	u32 m_frameTimesCount = 0;
+
+	//Global heap allocations, for frames that should make none
+	u64 m_heapAllocations = 0;
+	u64 m_heapAllocationsLastFrame = 0;
+	u32 m_framesUpdated = 0;
 };
 
 SSAOApp g_app;
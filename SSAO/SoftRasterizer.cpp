@@ -0,0 +1,775 @@
+#include "SoftRasterizer.h"
+#include "GBufferEncoding.h"
+#include "AOReference.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RASTER_SSE2 1
+#endif
+
+using hlsl::float3;
+using hlsl::float4;
+
+struct SoftRaster::Rasterizer::Vertex
+{
+	float4 clip;	// SV_POSITION before the divide.
+	float3 normal;	// world space, as VS_Geometry outputs it.
+	f32 visibility;	// the colour's alpha.
+	u32 outcode;
+
+	// Snapped to sub texels (y down) with z / w and 1 / w, only when outcode needs no clipping.
+	s64 x, y;
+	f32 z, invW;
+};
+
+// Set up for rasterising, everything in sub texels with y down.
+struct SoftRaster::Rasterizer::Triangle
+{
+	// Texels whose centres the bounds can reach, clipped to the target.
+	s32 minX, minY, maxX, maxY;
+
+	// Edge i is the one opposite vertex i, E(px, py) = a * px + b * py + c >= 0 inside, with the
+	// top-left bias folded into c. eMin is E at the centre of texel (minX, minY).
+	s32 a[3];
+	s32 b[3];
+	s64 eMin[3];
+
+	// Weights of vertices 1 and 2 at the centre of (minX, minY) and their steps per texel.
+	f32 l1, l1dx, l1dy;
+	f32 l2, l2dx, l2dy;
+
+	// z / w is linear in screen space, the normals and visibilities go through 1 / w.
+	f32 z0, dz1, dz2;
+	float3 normalOverW[3];
+	f32 visibilityOverW[3];
+	f32 invW[3];
+
+	// Packed once when the three normals match (flat faces), encoding is most of a texel's cost.
+	bool flat;
+	u32 flatNormal;
+
+	// The albedo, with the visibility in the alpha when the three match (every unbaked mesh).
+	bool flatColour;
+	u32 colourSpec;
+};
+
+namespace
+{
+	using Vertex = SoftRaster::Rasterizer::Vertex;
+	using Triangle = SoftRaster::Rasterizer::Triangle;
+
+	constexpr s64 kSubTexel = 256;	// vertices snap to 1/256 of a texel, like the hardware and Coverage.h.
+	constexpr s32 kBlockSize = 8;
+	constexpr s64 kBlockSpan = (kBlockSize - 1) * kSubTexel;	// first to last texel centre of a block.
+
+	// Clip space x / y are clipped to +-kGuardBand * w, the rest of the band is rasterised as is.
+	constexpr f32 kGuardBand = 4.f;
+
+	constexpr u32 kClearColourSpec = 0;
+	constexpr u32 kClearNormal = 0;
+	constexpr u32 kClearDepth = 0xFFFFFF;
+
+	constexpr u32 kMaxClipVertices = 3 + 6;
+
+	// One tile's texels while it is rasterised, cleared and written back whole so the G-buffer
+	// is only touched once, in rows.
+	struct Tile
+	{
+		s32 x, y;			// first texel in the target.
+		s32 width, height;	// texels inside the target.
+
+		alignas(16) u32 depthStencil[SoftRaster::kTileWidth * SoftRaster::kTileHeight];
+		alignas(16) u32 normal[SoftRaster::kTileWidth * SoftRaster::kTileHeight];
+		alignas(16) u32 colourSpec[SoftRaster::kTileWidth * SoftRaster::kTileHeight];
+
+		size_t index(s32 targetX, s32 targetY) const { return (size_t)(targetY - y) * SoftRaster::kTileWidth + (targetX - x); }
+	};
+
+	inline Vertex lerp(const Vertex& a, const Vertex& b, f32 t)
+	{
+		Vertex v;
+		v.clip = float4(a.clip.x + (b.clip.x - a.clip.x) * t, a.clip.y + (b.clip.y - a.clip.y) * t
+			, a.clip.z + (b.clip.z - a.clip.z) * t, a.clip.w + (b.clip.w - a.clip.w) * t);
+		v.normal = a.normal + (b.normal - a.normal) * t;
+		v.visibility = a.visibility + (b.visibility - a.visibility) * t;
+		return v;
+	}
+
+	// Signed distance to clip plane [plane], >= 0 keeps: near, far, then the guard band.
+	inline f32 plane_distance(const float4& v, u32 plane)
+	{
+		switch (plane)
+		{
+		case 0: return v.z;
+		case 1: return v.w - v.z;
+		case 2: return kGuardBand * v.w - v.x;
+		case 3: return kGuardBand * v.w + v.x;
+		case 4: return kGuardBand * v.w - v.y;
+		default: return kGuardBand * v.w + v.y;
+		}
+	}
+
+	// Bit per plane the vertex is outside of: the frustum in the low 6 bits, then the clip planes.
+	constexpr u32 kFrustumBits = 0x3F;
+	constexpr u32 kClipBits = 0x10 | 0x20 | 0x40;	// near, far and the guard band.
+
+	inline u32 outcode(const float4& v)
+	{
+		u32 code = 0;
+		code |= v.x < -v.w ? 0x01 : 0;
+		code |= v.x > v.w ? 0x02 : 0;
+		code |= v.y < -v.w ? 0x04 : 0;
+		code |= v.y > v.w ? 0x08 : 0;
+		code |= v.z < 0.f ? 0x10 : 0;
+		code |= v.z > v.w ? 0x20 : 0;
+		for (u32 plane = 2; plane < 6; ++plane)
+		{
+			code |= plane_distance(v, plane) < 0.f ? 0x40 : 0;
+		}
+		return code;
+	}
+
+	// Sutherland-Hodgman against every clip plane. New vertices are always interpolated from the
+	// inside end of an edge, so triangles sharing an edge get identical ones and stay watertight.
+	u32 clip_polygon(Vertex* pPolygon, u32 count)
+	{
+		Vertex scratch[kMaxClipVertices];
+		for (u32 plane = 0; plane < 6 && count >= 3; ++plane)
+		{
+			u32 out = 0;
+			for (u32 i = 0; i < count; ++i)
+			{
+				const Vertex& cur = pPolygon[i];
+				const Vertex& next = pPolygon[(i + 1) % count];
+				const f32 dCur = plane_distance(cur.clip, plane);
+				const f32 dNext = plane_distance(next.clip, plane);
+				if (dCur >= 0.f)
+				{
+					scratch[out++] = cur;
+					if (dNext < 0.f)
+						scratch[out++] = lerp(cur, next, dCur / (dCur - dNext));
+				}
+				else if (dNext >= 0.f)
+				{
+					scratch[out++] = lerp(next, cur, dNext / (dNext - dCur));
+				}
+			}
+			ASSERT(out <= kMaxClipVertices);
+			std::copy(scratch, scratch + out, pPolygon);
+			count = out;
+		}
+		return count;
+	}
+
+	inline s64 floor_div(s64 v, s64 d) { return v >= 0 ? v / d : -((-v + d - 1) / d); }
+
+	// First / last texel whose centre is at or after lo / at or before hi.
+	inline s64 first_centre(s64 lo) { return floor_div(lo - kSubTexel / 2 + kSubTexel - 1, kSubTexel); }
+	inline s64 last_centre(s64 hi) { return floor_div(hi - kSubTexel / 2, kSubTexel); }
+
+	inline s64 texel_centre(s64 texel) { return texel * kSubTexel + kSubTexel / 2; }
+
+	// Clip space to snapped sub texels, the viewport transform.
+	inline void project(Vertex& v, u32 width, u32 height)
+	{
+		v.invW = 1.f / v.clip.w;
+		v.x = (s64)std::llround((v.clip.x * v.invW * 0.5f + 0.5f) * width * kSubTexel);
+		v.y = (s64)std::llround((0.5f - v.clip.y * v.invW * 0.5f) * height * kSubTexel);
+		v.z = v.clip.z * v.invW;
+	}
+
+	// Draw::albedo with a 0 alpha, the vertices fill it in.
+	inline u32 pack_albedo(const float3& albedo)
+	{
+		return GBufferEncoding::pack_albedo_spec(float4(albedo.x, albedo.y, albedo.z, 0.f));
+	}
+
+	// Orients and sets up one projected triangle. false when it covers no texel centre.
+	bool setup_triangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, u32 width, u32 height, u32 albedo, Triangle& tri)
+	{
+		// One winding for every triangle (no culling), degenerate ones cover nothing.
+		const Vertex* pV[3] = { &v0, &v1, &v2 };
+		s64 area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+		if (area == 0)
+			return false;
+		if (area < 0)
+		{
+			std::swap(pV[1], pV[2]);
+			area = -area;
+		}
+
+		tri.minX = (s32)std::max<s64>(0, first_centre(std::min({ v0.x, v1.x, v2.x })));
+		tri.maxX = (s32)std::min<s64>((s64)width - 1, last_centre(std::max({ v0.x, v1.x, v2.x })));
+		tri.minY = (s32)std::max<s64>(0, first_centre(std::min({ v0.y, v1.y, v2.y })));
+		tri.maxY = (s32)std::min<s64>((s64)height - 1, last_centre(std::max({ v0.y, v1.y, v2.y })));
+		if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+			return false;
+
+		const s64 px = texel_centre(tri.minX);
+		const s64 py = texel_centre(tri.minY);
+		s64 unbiased[3];
+		for (u32 i = 0; i < 3; ++i)
+		{
+			// Edge opposite vertex i, from vertex i + 1 to i + 2.
+			const Vertex& from = *pV[(i + 1) % 3];
+			const Vertex& to = *pV[(i + 2) % 3];
+			const s64 dx = to.x - from.x;
+			const s64 dy = to.y - from.y;
+			tri.a[i] = (s32)-dy;
+			tri.b[i] = (s32)dx;
+			unbiased[i] = dx * (py - from.y) - dy * (px - from.x);
+
+			// With y down and this winding a top edge runs right and a left edge runs up.
+			const bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+			tri.eMin[i] = unbiased[i] - (topLeft ? 0 : 1);
+		}
+
+		const f64 invArea = 1.0 / (f64)area;
+		tri.l1 = (f32)(unbiased[1] * invArea);
+		tri.l1dx = (f32)(tri.a[1] * kSubTexel * invArea);
+		tri.l1dy = (f32)(tri.b[1] * kSubTexel * invArea);
+		tri.l2 = (f32)(unbiased[2] * invArea);
+		tri.l2dx = (f32)(tri.a[2] * kSubTexel * invArea);
+		tri.l2dy = (f32)(tri.b[2] * kSubTexel * invArea);
+
+		tri.z0 = pV[0]->z;
+		tri.dz1 = pV[1]->z - pV[0]->z;
+		tri.dz2 = pV[2]->z - pV[0]->z;
+		for (u32 i = 0; i < 3; ++i)
+		{
+			tri.normalOverW[i] = pV[i]->normal * pV[i]->invW;
+			tri.visibilityOverW[i] = pV[i]->visibility * pV[i]->invW;
+			tri.invW[i] = pV[i]->invW;
+		}
+
+		tri.flat = v0.normal.x == v1.normal.x && v0.normal.y == v1.normal.y && v0.normal.z == v1.normal.z
+			&& v0.normal.x == v2.normal.x && v0.normal.y == v2.normal.y && v0.normal.z == v2.normal.z;
+		tri.flatNormal = tri.flat ? GBufferEncoding::pack_normal(hlsl::normalize(v0.normal)) : 0;
+
+		tri.flatColour = v0.visibility == v1.visibility && v0.visibility == v2.visibility;
+		tri.colourSpec = tri.flatColour ? albedo | ((u32)GBufferEncoding::to_unorm8(v0.visibility) << 24) : albedo;
+		return true;
+	}
+
+	// PS_Geometry_NoTex's normal at weights l1 / l2 of vertices 1 / 2, packed.
+	inline u32 shade_normal(const Triangle& tri, f32 l1, f32 l2)
+	{
+		if (tri.flat)
+			return tri.flatNormal;
+
+		const f32 l0 = 1.f - l1 - l2;
+		const f32 invW = l0 * tri.invW[0] + l1 * tri.invW[1] + l2 * tri.invW[2];
+		const float3 normal = (tri.normalOverW[0] * l0 + tri.normalOverW[1] * l1 + tri.normalOverW[2] * l2) / invW;
+		return GBufferEncoding::pack_normal(hlsl::normalize(normal));
+	}
+
+	// PS_Geometry_NoTex's albedo and vertex alpha at weights l1 / l2 of vertices 1 / 2, packed.
+	inline u32 shade_colour(const Triangle& tri, f32 l1, f32 l2)
+	{
+		if (tri.flatColour)
+			return tri.colourSpec;
+
+		const f32 l0 = 1.f - l1 - l2;
+		const f32 invW = l0 * tri.invW[0] + l1 * tri.invW[1] + l2 * tri.invW[2];
+		const f32 visibility = (tri.visibilityOverW[0] * l0 + tri.visibilityOverW[1] * l1 + tri.visibilityOverW[2] * l2) / invW;
+		return tri.colourSpec | ((u32)GBufferEncoding::to_unorm8(visibility) << 24);
+	}
+
+#if RASTER_SSE2
+	// Lanes of a where mask is set, of b elsewhere.
+	inline __m128i select(__m128i mask, __m128i a, __m128i b)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+#endif
+
+	// Float depth to D24_UNORM, round to nearest even like cvtps2dq. Clamped to the viewport's [0, 1].
+	inline u32 to_depth24(f32 z)
+	{
+		return (u32)std::nearbyint(hlsl::saturate(z) * 16777215.f);
+	}
+
+	// Rasterises tri over the 8x8 block at (blockX, blockY), clipped to the tile's texels in the target.
+	void rasterise_block(const Triangle& tri, s32 blockX, s32 blockY, Tile& tile, u32& texelsWritten)
+	{
+		// Trivial reject / accept per edge from the block's extreme texel centres. Partial edges
+		// keep E / 256 (floored) at the first texel, its sign is E's and it steps by a and b
+		// exactly, small enough for 32 bit lanes whatever the triangle's size.
+		const s32 dx = blockX - tri.minX;
+		const s32 dy = blockY - tri.minY;
+		s32 partialE[3];
+		s32 partialA[3];
+		s32 partialB[3];
+		u32 partials = 0;
+		for (u32 i = 0; i < 3; ++i)
+		{
+			const s64 e = tri.eMin[i] + (s64)tri.a[i] * kSubTexel * dx + (s64)tri.b[i] * kSubTexel * dy;
+			const s64 stepX = (s64)tri.a[i] * kBlockSpan;
+			const s64 stepY = (s64)tri.b[i] * kBlockSpan;
+			const s64 eMax = e + std::max<s64>(stepX, 0) + std::max<s64>(stepY, 0);
+			const s64 eMin = e + std::min<s64>(stepX, 0) + std::min<s64>(stepY, 0);
+			if (eMax < 0)
+				return;
+			if (eMin >= 0)
+				continue;
+			partialE[partials] = (s32)floor_div(e, kSubTexel);
+			partialA[partials] = tri.a[i];
+			partialB[partials] = tri.b[i];
+			++partials;
+		}
+
+		// Weights of vertices 1 and 2 at the block's first texel.
+		const f32 l1Origin = tri.l1 + tri.l1dx * dx + tri.l1dy * dy;
+		const f32 l2Origin = tri.l2 + tri.l2dx * dx + tri.l2dy * dy;
+		const f32 l1dx = tri.l1dx;
+		const f32 l1dy = tri.l1dy;
+		const f32 l2dx = tri.l2dx;
+		const f32 l2dy = tri.l2dy;
+
+		const s32 rows = std::min<s32>(kBlockSize, tile.y + tile.height - blockY);
+		const s32 columns = std::min<s32>(kBlockSize, tile.x + tile.width - blockX);
+
+#if RASTER_SSE2
+		const __m128i laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+		const __m128 laneIndexF = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+		const __m128i minusOne = _mm_set1_epi32(-1);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 depthScale = _mm_set1_ps(16777215.f);
+		const __m128i depthMask = _mm_set1_epi32(0xFFFFFF);
+
+		// Edge values of the first row, for each half of the block.
+		__m128i edge[3][2];
+		__m128i edgeStepY[3];
+		for (u32 e = 0; e < partials; ++e)
+		{
+			edge[e][0] = _mm_add_epi32(_mm_set1_epi32(partialE[e]), _mm_setr_epi32(0, partialA[e], partialA[e] * 2, partialA[e] * 3));
+			edge[e][1] = _mm_add_epi32(edge[e][0], _mm_set1_epi32(partialA[e] * 4));
+			edgeStepY[e] = _mm_set1_epi32(partialB[e]);
+		}
+
+		for (s32 row = 0; row < rows; ++row)
+		{
+			const s32 y = blockY + row;
+			for (s32 half = 0; half < 2; ++half)
+			{
+				const s32 x = blockX + half * 4;
+				if (x - blockX >= columns)
+					break;
+
+				// Coverage, all lanes in when no edge is partial. Lanes past the target are dropped.
+				__m128i write = _mm_cmpgt_epi32(_mm_set1_epi32(columns - half * 4), laneIndex);
+				for (u32 e = 0; e < partials; ++e)
+				{
+					write = _mm_and_si128(write, _mm_cmpgt_epi32(edge[e][half], minusOne));
+				}
+				if (!_mm_movemask_ps(_mm_castsi128_ps(write)))
+					continue;
+
+				// Depth at the covered centres, LESS_EQUAL against the tile.
+				const __m128 i = _mm_add_ps(_mm_set1_ps((f32)(half * 4)), laneIndexF);
+				const __m128 j = _mm_set1_ps((f32)row);
+				const __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_set1_ps(l1Origin), _mm_mul_ps(_mm_set1_ps(l1dx), i)), _mm_mul_ps(_mm_set1_ps(l1dy), j));
+				const __m128 l2 = _mm_add_ps(_mm_add_ps(_mm_set1_ps(l2Origin), _mm_mul_ps(_mm_set1_ps(l2dx), i)), _mm_mul_ps(_mm_set1_ps(l2dy), j));
+				const __m128 z = _mm_add_ps(_mm_add_ps(_mm_set1_ps(tri.z0), _mm_mul_ps(l1, _mm_set1_ps(tri.dz1))), _mm_mul_ps(l2, _mm_set1_ps(tri.dz2)));
+				const __m128i depth = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(z, zero), one), depthScale));
+
+				// Blocks start on 8 texel boundaries of the tile, so the 4 lanes are aligned and in the row.
+				const size_t index = tile.index(x, y);
+				__m128i* pDepth = (__m128i*)&tile.depthStencil[index];
+				const __m128i storedDepth = _mm_load_si128(pDepth);
+				write = _mm_andnot_si128(_mm_cmpgt_epi32(depth, _mm_and_si128(storedDepth, depthMask)), write);
+				const u32 mask = (u32)_mm_movemask_ps(_mm_castsi128_ps(write));
+				if (!mask)
+					continue;
+
+				_mm_store_si128(pDepth, select(write, depth, storedDepth));
+				if (tri.flat && tri.flatColour)
+				{
+					__m128i* pColourSpec = (__m128i*)&tile.colourSpec[index];
+					__m128i* pNormal = (__m128i*)&tile.normal[index];
+					_mm_store_si128(pColourSpec, select(write, _mm_set1_epi32((s32)tri.colourSpec), _mm_load_si128(pColourSpec)));
+					_mm_store_si128(pNormal, select(write, _mm_set1_epi32((s32)tri.flatNormal), _mm_load_si128(pNormal)));
+				}
+				else
+				{
+					alignas(16) f32 l1Lanes[4];
+					alignas(16) f32 l2Lanes[4];
+					_mm_store_ps(l1Lanes, l1);
+					_mm_store_ps(l2Lanes, l2);
+					for (u32 lane = 0; lane < 4; ++lane)
+					{
+						if (mask & (1u << lane))
+						{
+							tile.colourSpec[index + lane] = shade_colour(tri, l1Lanes[lane], l2Lanes[lane]);
+							tile.normal[index + lane] = shade_normal(tri, l1Lanes[lane], l2Lanes[lane]);
+						}
+					}
+				}
+				texelsWritten += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + (mask >> 3);
+			}
+
+			for (u32 e = 0; e < partials; ++e)
+			{
+				edge[e][0] = _mm_add_epi32(edge[e][0], edgeStepY[e]);
+				edge[e][1] = _mm_add_epi32(edge[e][1], edgeStepY[e]);
+			}
+		}
+#else
+		for (s32 row = 0; row < rows; ++row)
+		{
+			const s32 y = blockY + row;
+			for (s32 column = 0; column < columns; ++column)
+			{
+				bool inside = true;
+				for (u32 e = 0; e < partials && inside; ++e)
+				{
+					inside = partialE[e] + partialA[e] * column + partialB[e] * row >= 0;
+				}
+				if (!inside)
+					continue;
+
+				// Same float ops in the same order as the SSE2 lanes.
+				const f32 i = (f32)column;
+				const f32 j = (f32)row;
+				const f32 l1 = (l1Origin + l1dx * i) + l1dy * j;
+				const f32 l2 = (l2Origin + l2dx * i) + l2dy * j;
+				const u32 depth = to_depth24((tri.z0 + l1 * tri.dz1) + l2 * tri.dz2);
+
+				const size_t index = tile.index(blockX + column, y);
+				if (depth > (tile.depthStencil[index] & 0xFFFFFF))
+					continue;
+
+				tile.depthStencil[index] = depth;
+				tile.colourSpec[index] = shade_colour(tri, l1, l2);
+				tile.normal[index] = shade_normal(tri, l1, l2);
+				++texelsWritten;
+			}
+		}
+#endif
+	}
+}
+
+//================================================================================
+// GBuffer
+//================================================================================
+void SoftRaster::GBuffer::resize(u32 w, u32 h)
+{
+	ASSERT(w <= kMaxTargetSize && h <= kMaxTargetSize);
+	width = w;
+	height = h;
+	clear();
+}
+
+void SoftRaster::GBuffer::clear()
+{
+	const size_t texels = (size_t)width * height;
+	colourSpec.assign(texels, kClearColourSpec);
+	normal.assign(texels, kClearNormal);
+	depthStencil.assign(texels, kClearDepth);
+}
+
+//================================================================================
+// Rasterizer
+//================================================================================
+SoftRaster::Rasterizer::Rasterizer(WorkerPool* pPool)
+	: m_pPool(pPool)
+{
+}
+
+SoftRaster::Rasterizer::~Rasterizer()
+{
+}
+
+template <typename Fn>
+void SoftRaster::Rasterizer::run(u32 count, u32 minPerRange, const Fn& fn)
+{
+	if (m_pPool)
+	{
+		m_pPool->parallel_for(count, minPerRange, fn);
+	}
+	else
+	{
+		fn(0, count);
+	}
+}
+
+const SoftRaster::Stats& SoftRaster::Rasterizer::render(const Draw* pDraws, u32 drawCount, GBuffer& gbuffer)
+{
+	return render(pDraws, drawCount, gbuffer.targets(), false);
+}
+
+const SoftRaster::Stats& SoftRaster::Rasterizer::render(const Draw* pDraws, u32 drawCount, const Targets& targets, bool load)
+{
+	ASSERT(targets.width && targets.height);
+	ASSERT(targets.width <= kMaxTargetSize && targets.height <= kMaxTargetSize);
+
+	m_stats = Stats();
+	m_stats.draws = drawCount;
+
+	transform(pDraws, drawCount, targets.width, targets.height);
+	setup(pDraws, drawCount, targets.width, targets.height);
+
+	// Tiles vary a lot in cost, threads pull them one at a time rather than taking fixed ranges.
+	const u32 tiles = m_tilesX * m_tilesY;
+	std::atomic<u32> nextTile(0);
+	std::atomic<u32> texelsWritten(0);
+	run(m_pPool ? m_pPool->threads() : 1, 1, [&](u32, u32)
+	{
+		u32 written = 0;
+		for (u32 tile = nextTile++; tile < tiles; tile = nextTile++)
+		{
+			rasterise_tile(tile, targets, load, written);
+		}
+		texelsWritten += written;
+	});
+
+	m_stats.tiles = tiles;
+	m_stats.texelsWritten = texelsWritten;
+	for (u32 range = 0; range < m_ranges; ++range)
+	{
+		m_stats.culledTriangles += m_bins[range].culled;
+		m_stats.clippedTriangles += m_bins[range].clipped;
+		for (const std::vector<u32>& bin : m_bins[range].tiles)
+		{
+			m_stats.binnedTriangles += (u32)bin.size();
+		}
+	}
+	return m_stats;
+}
+
+// VS_Geometry for every vertex of every draw, projected once here rather than per triangle.
+void SoftRaster::Rasterizer::transform(const Draw* pDraws, u32 drawCount, u32 width, u32 height)
+{
+	m_vertexStart.resize(drawCount + 1);
+	m_vertexStart[0] = 0;
+	for (u32 d = 0; d < drawCount; ++d)
+	{
+		m_vertexStart[d + 1] = m_vertexStart[d] + pDraws[d].pMesh->vertexCount;
+	}
+	m_vertices.resize(m_vertexStart[drawCount]);
+
+	run(m_vertexStart[drawCount], 1024, [&](u32 begin, u32 end)
+	{
+		u32 d = (u32)(std::upper_bound(m_vertexStart.begin(), m_vertexStart.end(), begin) - m_vertexStart.begin()) - 1;
+		for (u32 v = begin; v < end; ++v)
+		{
+			while (v >= m_vertexStart[d + 1])
+				++d;
+
+			const Draw& draw = pDraws[d];
+			const u8* pVertex = draw.pMesh->pVertices + (size_t)(v - m_vertexStart[d]) * draw.pMesh->stride;
+			const float3& position = *(const float3*)(pVertex + draw.pMesh->positionOffset);
+			const float3& normal = *(const float3*)(pVertex + draw.pMesh->normalOffset);
+			const u32 colourOffset = draw.pMesh->colourOffset;
+
+			Vertex& vertex = m_vertices[v];
+			vertex.clip = hlsl::mul(float4(position.x, position.y, position.z, 1.f), draw.matMVP);
+			vertex.normal = hlsl::mul3x3(normal, draw.matModel);
+			vertex.visibility = colourOffset == kNoColour ? 1.f : GBufferEncoding::from_unorm8(pVertex[colourOffset + 3]);
+			vertex.outcode = outcode(vertex.clip);
+			if (!(vertex.outcode & kClipBits))
+			{
+				project(vertex, width, height);
+			}
+		}
+	});
+}
+
+// Clips, sets up and bins every triangle. Triangles are split into contiguous ranges, each with its
+// own bins, so no locks and the tiles see them in submission order.
+void SoftRaster::Rasterizer::setup(const Draw* pDraws, u32 drawCount, u32 width, u32 height)
+{
+	m_triangleStart.resize(drawCount + 1);
+	m_triangleStart[0] = 0;
+	for (u32 d = 0; d < drawCount; ++d)
+	{
+		const MeshView& mesh = *pDraws[d].pMesh;
+		m_triangleStart[d + 1] = m_triangleStart[d] + (mesh.pIndices ? mesh.indexCount : mesh.vertexCount) / 3;
+	}
+	const u32 triangles = m_triangleStart[drawCount];
+	m_stats.triangles = triangles;
+
+	m_tilesX = (width + kTileWidth - 1) / kTileWidth;
+	m_tilesY = (height + kTileHeight - 1) / kTileHeight;
+
+	constexpr u32 kMinTrianglesPerRange = 256;
+	const u32 threads = m_pPool ? m_pPool->threads() : 1;
+	m_ranges = std::max(1u, std::min(threads, triangles / kMinTrianglesPerRange));
+	if (m_bins.size() < m_ranges)
+	{
+		m_bins.resize(m_ranges);
+	}
+	for (u32 range = 0; range < m_ranges; ++range)
+	{
+		Bins& bins = m_bins[range];
+		bins.triangles.clear();
+		bins.tiles.resize(m_tilesX * m_tilesY);
+		for (std::vector<u32>& bin : bins.tiles)
+		{
+			bin.clear();
+		}
+		bins.culled = 0;
+		bins.clipped = 0;
+	}
+
+	run(m_ranges, 1, [&](u32 rangeBegin, u32 rangeEnd)
+	{
+		for (u32 range = rangeBegin; range < rangeEnd; ++range)
+		{
+			Bins& bins = m_bins[range];
+			const u32 begin = (u32)((u64)triangles * range / m_ranges);
+			const u32 end = (u32)((u64)triangles * (range + 1) / m_ranges);
+
+			auto bin = [&](const Vertex& v0, const Vertex& v1, const Vertex& v2, u32 albedo)
+			{
+				bins.triangles.emplace_back();
+				Triangle& tri = bins.triangles.back();
+				if (!setup_triangle(v0, v1, v2, width, height, albedo, tri))
+				{
+					bins.triangles.pop_back();
+					return;
+				}
+
+				const u32 index = (u32)bins.triangles.size() - 1;
+				for (u32 ty = tri.minY / kTileHeight; ty <= tri.maxY / kTileHeight; ++ty)
+				{
+					for (u32 tx = tri.minX / kTileWidth; tx <= tri.maxX / kTileWidth; ++tx)
+					{
+						bins.tiles[ty * m_tilesX + tx].push_back(index);
+					}
+				}
+			};
+
+			u32 d = (u32)(std::upper_bound(m_triangleStart.begin(), m_triangleStart.end(), begin) - m_triangleStart.begin()) - 1;
+			u32 albedo = pack_albedo(pDraws[d].albedo);
+			for (u32 t = begin; t < end; ++t)
+			{
+				while (t >= m_triangleStart[d + 1])
+				{
+					++d;
+					albedo = pack_albedo(pDraws[d].albedo);
+				}
+
+				const MeshView& mesh = *pDraws[d].pMesh;
+				const u32 first = (t - m_triangleStart[d]) * 3;
+				const Vertex* pDrawVertices = m_vertices.data() + m_vertexStart[d];
+
+				const Vertex* pTriangle[3];
+				for (u32 i = 0; i < 3; ++i)
+				{
+					const u32 index = mesh.pIndices ? mesh.pIndices[first + i] : first + i;
+					ASSERT(index < mesh.vertexCount);
+					pTriangle[i] = &pDrawVertices[index];
+				}
+
+				// Outside one of the frustum planes entirely.
+				if (pTriangle[0]->outcode & pTriangle[1]->outcode & pTriangle[2]->outcode & kFrustumBits)
+				{
+					++bins.culled;
+					continue;
+				}
+
+				if (!((pTriangle[0]->outcode | pTriangle[1]->outcode | pTriangle[2]->outcode) & kClipBits))
+				{
+					bin(*pTriangle[0], *pTriangle[1], *pTriangle[2], albedo);
+					continue;
+				}
+
+				// Crosses the near / far planes or leaves the guard band, clip and fan.
+				++bins.clipped;
+				Vertex polygon[kMaxClipVertices] = { *pTriangle[0], *pTriangle[1], *pTriangle[2] };
+				const u32 count = clip_polygon(polygon, 3);
+				for (u32 i = 0; i < count; ++i)
+				{
+					project(polygon[i], width, height);
+				}
+				for (u32 i = 2; i < count; ++i)
+				{
+					bin(polygon[0], polygon[i - 1], polygon[i], albedo);
+				}
+			}
+		}
+	});
+}
+
+void SoftRaster::Rasterizer::rasterise_tile(u32 tileIndex, const Targets& targets, bool load, u32& texelsWritten) const
+{
+	Tile tile;
+	tile.x = (s32)((tileIndex % m_tilesX) * kTileWidth);
+	tile.y = (s32)((tileIndex / m_tilesX) * kTileHeight);
+	tile.width = std::min<s32>(kTileWidth, targets.width - tile.x);
+	tile.height = std::min<s32>(kTileHeight, targets.height - tile.y);
+	std::fill(std::begin(tile.depthStencil), std::end(tile.depthStencil), kClearDepth);
+	std::fill(std::begin(tile.normal), std::end(tile.normal), kClearNormal);
+	std::fill(std::begin(tile.colourSpec), std::end(tile.colourSpec), kClearColourSpec);
+
+	if (load)
+	{
+		for (s32 row = 0; row < tile.height; ++row)
+		{
+			const size_t from = (size_t)(tile.y + row) * targets.width + tile.x;
+			const size_t to = (size_t)row * kTileWidth;
+			std::copy(targets.pDepthStencil + from, targets.pDepthStencil + from + tile.width, tile.depthStencil + to);
+			std::copy(targets.pNormal + from, targets.pNormal + from + tile.width, tile.normal + to);
+			std::copy(targets.pColourSpec + from, targets.pColourSpec + from + tile.width, tile.colourSpec + to);
+		}
+	}
+
+	const s32 tileMaxX = tile.x + tile.width - 1;
+	const s32 tileMaxY = tile.y + tile.height - 1;
+	for (u32 range = 0; range < m_ranges; ++range)
+	{
+		const Bins& bins = m_bins[range];
+		for (u32 index : bins.tiles[tileIndex])
+		{
+			const Triangle& tri = bins.triangles[index];
+
+			// Blocks of the tile the triangle's bounds touch.
+			const s32 minX = std::max(tri.minX, tile.x);
+			const s32 maxX = std::min(tri.maxX, tileMaxX);
+			const s32 minY = std::max(tri.minY, tile.y);
+			const s32 maxY = std::min(tri.maxY, tileMaxY);
+			for (s32 blockY = tile.y + (minY - tile.y) / kBlockSize * kBlockSize; blockY <= maxY; blockY += kBlockSize)
+			{
+				for (s32 blockX = tile.x + (minX - tile.x) / kBlockSize * kBlockSize; blockX <= maxX; blockX += kBlockSize)
+				{
+					rasterise_block(tri, blockX, blockY, tile, texelsWritten);
+				}
+			}
+		}
+	}
+
+	for (s32 row = 0; row < tile.height; ++row)
+	{
+		const size_t from = (size_t)row * kTileWidth;
+		const size_t to = (size_t)(tile.y + row) * targets.width + tile.x;
+		std::copy(tile.depthStencil + from, tile.depthStencil + from + tile.width, targets.pDepthStencil + to);
+		std::copy(tile.normal + from, tile.normal + from + tile.width, targets.pNormal + to);
+		std::copy(tile.colourSpec + from, tile.colourSpec + from + tile.width, targets.pColourSpec + to);
+	}
+}
+
+void SoftRaster::to_reference(const GBuffer& gbuffer, AOReference::GBuffer& out)
+{
+	out.resize(gbuffer.width, gbuffer.height);
+	for (size_t i = 0; i < out.depth.size(); ++i)
+	{
+		out.depth[i] = (gbuffer.depthStencil[i] & 0xFFFFFF) / 16777215.f;
+		out.normal[i] = GBufferEncoding::unpack_normal(gbuffer.normal[i]);
+	}
+}
+
+const char* SoftRaster::rasterizer_isa()
+{
+#if RASTER_SSE2
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ShaderMath.h"
+
+#include <vector>
+
+class WorkerPool;
+
+namespace AOReference { struct GBuffer; }
+
+//================================================================================
+// Software Rasterizer
+// CPU twin of the geometry pass (VS_Geometry + PS_Geometry_NoTex into the
+// G-buffer) for machines without a GPU. The targets have the D3D11 ones' texel
+// layout, so everything downstream (the AO references, the blurs) reads them
+// exactly as it reads a read back.
+//
+// Triangles are clipped to the near / far planes and a guard band, snapped to
+// 1/256 of a texel like the hardware (see Coverage.h) and binned into 64x32
+// tiles. Tiles are rasterised in parallel, each walks its bins in submission
+// order 8x8 texels at a time: blocks are trivially rejected / accepted per edge
+// with exact integer edge functions and the partial ones step the edges 4
+// texels an SSE2 op. Same states as the app: no culling, top-left rule, depth
+// LESS_EQUAL on 24 bit unorm depth.
+//
+// Only standard headers (and SSE2 intrinsics when the target has them) so it
+// builds on Linux.
+//================================================================================
+namespace SoftRaster
+{
+	using hlsl::float4;
+	using hlsl::float4x4;
+
+	constexpr u32 kTileWidth = 64;
+	constexpr u32 kTileHeight = 32;
+	constexpr u32 kMaxTargetSize = 4096;	// keeps the guard band's fixed point in range.
+
+	constexpr u32 kNoColour = ~0u;
+
+	// Strided view of a mesh's CPU copy, MeshVertex gives the offsets in the app (see Mesh::cpu_vertices()).
+	struct MeshView
+	{
+		const u8* pVertices = nullptr;
+		u32 vertexCount = 0;
+		u32 stride = 0;
+		u32 positionOffset = 0;		// float3, model space.
+		u32 normalOffset = 0;		// float3, model space.
+		u32 colourOffset = kNoColour;	// u32 R8G8B8A8_UNORM, only the alpha (baked AO, see VertexAO.h) is read. kNoColour = 1.
+		const u16* pIndices = nullptr;	// triangle list.
+		u32 indexCount = 0;
+	};
+
+	// One instance of the geometry pass, the PerDrawCB / GeometryInstance matrices un-transposed
+	// (row vectors, like m4x4).
+	struct Draw
+	{
+		const MeshView* pMesh = nullptr;
+		float4x4 matModel = float4x4::identity();
+		float4x4 matMVP = float4x4::identity();
+		hlsl::float3 albedo = hlsl::float3(0.9f, 0.9f, 0.9f);	// PS_Geometry_NoTex's output, the alpha is the vertices'.
+	};
+
+	// Where render() writes, width * height texels each, row major. Memory owned by the caller.
+	struct Targets
+	{
+		u32 width = 0;
+		u32 height = 0;
+		u32* pColourSpec = nullptr;
+		u32* pNormal = nullptr;
+		u32* pDepthStencil = nullptr;
+	};
+
+	// kGBufferColourSpec (RGBA8_UNORM), kGBufferNormal (RG16_SNORM octahedral) and kGBufferDepth
+	// (D24_UNORM_S8_UINT) texels, row major, packed like GBufferEncoding.h.
+	struct GBuffer
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<u32> colourSpec;
+		std::vector<u32> normal;
+		std::vector<u32> depthStencil;	// depth in the low 24 bits, stencil 0.
+
+		// Sized and cleared like the app's targets: colour 0, normal (0, 0) (+z), depth 1.
+		void resize(u32 w, u32 h);
+		void clear();
+
+		f32 depth(u32 x, u32 y) const { return (depthStencil[(size_t)y * width + x] & 0xFFFFFF) / 16777215.f; }
+
+		Targets targets() { return Targets{ width, height, colourSpec.data(), normal.data(), depthStencil.data() }; }
+	};
+
+	struct Stats
+	{
+		u32 draws = 0;
+		u32 triangles = 0;			// submitted.
+		u32 culledTriangles = 0;	// degenerate or outside the frustum.
+		u32 clippedTriangles = 0;	// that needed clipping.
+		u32 binnedTriangles = 0;	// triangle / tile pairs.
+		u32 tiles = 0;
+		u32 texelsWritten = 0;		// passed the depth test.
+	};
+
+	class Rasterizer
+	{
+	public:
+		// Vertices, triangle setup and tiles go over pPool when there is one.
+		explicit Rasterizer(WorkerPool* pPool = nullptr);
+		~Rasterizer();
+
+		// Draws pDraws into gbuffer in order, over cleared targets (every texel is written).
+		const Stats& render(const Draw* pDraws, u32 drawCount, GBuffer& gbuffer);
+
+		// Same into targets, on top of what they hold when load is set (the later draws of a pass).
+		const Stats& render(const Draw* pDraws, u32 drawCount, const Targets& targets, bool load);
+
+		const Stats& stats() const { return m_stats; }
+
+		struct Vertex;
+		struct Triangle;
+
+	private:
+		void transform(const Draw* pDraws, u32 drawCount, u32 width, u32 height);
+		void setup(const Draw* pDraws, u32 drawCount, u32 width, u32 height);
+		void rasterise_tile(u32 tileIndex, const Targets& targets, bool load, u32& texelsWritten) const;
+
+		template <typename Fn>
+		void run(u32 count, u32 minPerRange, const Fn& fn);
+
+		WorkerPool* m_pPool;
+		Stats m_stats;
+
+		// Per draw first vertex / triangle in the flattened arrays.
+		std::vector<u32> m_vertexStart;
+		std::vector<u32> m_triangleStart;
+		std::vector<Vertex> m_vertices;
+
+		// One set per setup range, tiles walk the ranges in order so draw order holds.
+		struct Bins
+		{
+			std::vector<Triangle> triangles;
+			std::vector<std::vector<u32>> tiles;	// indices into triangles.
+			u32 culled = 0;
+			u32 clipped = 0;
+		};
+		std::vector<Bins> m_bins;
+		u32 m_ranges = 0;
+		u32 m_tilesX = 0;
+		u32 m_tilesY = 0;
+	};
+
+	// Decodes depth and normals into an AOReference::GBuffer, the matrices are left to the caller.
+	void to_reference(const GBuffer& gbuffer, AOReference::GBuffer& out);
+
+	// "SSE2" or "Scalar", what the partial blocks were compiled with.
+	const char* rasterizer_isa();
+}
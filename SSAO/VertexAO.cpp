@@ -0,0 +1,163 @@
+#include "VertexAO.h"
+#include "BVH.h"
+#include "Culling.h"
+#include "GBufferEncoding.h"
+#include "GroundTruthAO.h"
+#include "WorkerPool.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+using namespace hlsl;
+
+namespace VertexAO
+{
+	static const char kMagic[4] = { 'V', 'A', 'O', '1' };
+
+	static float3 load_float3(const f32* pFirst, u32 strideBytes, u32 i)
+	{
+		const f32* p = (const f32*)((const u8*)pFirst + (size_t)i * strideBytes);
+		return float3(p[0], p[1], p[2]);
+	}
+
+	static u32 float_bits(f32 f)
+	{
+		u32 u;
+		memcpy(&u, &f, sizeof(u));
+		return u;
+	}
+
+	// Split vertices (the same corner once per face) get the same rays, so the seam doesn't show.
+	static u32 vertex_seed(const float3& p, const float3& n)
+	{
+		u32 h = 0;
+		const f32 values[6] = { p.x, p.y, p.z, n.x, n.y, n.z };
+		for (f32 v : values)
+		{
+			h = GroundTruthAO::hash(h ^ float_bits(v));
+		}
+		return h;
+	}
+
+	void bake(const f32* pPositions, const f32* pNormals, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount
+		, const Params& params, std::vector<f32>& visibilityOut, WorkerPool* pPool)
+	{
+		visibilityOut.assign(vertexCount, 1.f);
+		if (!vertexCount)
+			return;
+
+		BVH bvh;
+		bvh.add(pPositions, vertexCount, strideBytes, pIndices, indexCount, float4x4::identity());
+		bvh.build();
+
+		const f32 maxDistance = params.maxDistance > 0.f ? params.maxDistance
+			: Bounds::FromPoints(pPositions, vertexCount, strideBytes).radius * 0.25f;
+		const f32 bias = params.rayBias * maxDistance;
+		const u32 rays = std::max(4u, (params.raysPerVertex + 3) & ~3u);
+
+		auto vertices = [&](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; ++i)
+			{
+				const float3 p = load_float3(pPositions, strideBytes, i);
+				const float3 n = load_float3(pNormals, strideBytes, i);
+
+				const f32 length = std::sqrt(dot(n, n));
+				if (length < 1e-6f)
+					continue;
+
+				const float3 unitN = n * (1.f / length);
+				const f32 occlusion = GroundTruthAO::obscurance(bvh, p + unitN * bias, unitN, rays, maxDistance, vertex_seed(p, n));
+				visibilityOut[i] = 1.f - occlusion;
+			}
+		};
+
+		if (pPool)
+		{
+			pPool->parallel_for(vertexCount, 64, vertices);
+		}
+		else
+		{
+			vertices(0, vertexCount);
+		}
+	}
+
+	u8 to_alpha(f32 visibility)
+	{
+		return GBufferEncoding::to_unorm8(visibility);
+	}
+
+	u32 pack(u32 colour, u8 alpha)
+	{
+		return (colour & 0x00FFFFFFu) | ((u32)alpha << 24);
+	}
+
+	f32 unpack(u32 colour)
+	{
+		return GBufferEncoding::from_unorm8((u8)(colour >> 24));
+	}
+
+	static void fnv1a(u64& h, const void* pData, size_t bytes)
+	{
+		const u8* p = (const u8*)pData;
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			h = (h ^ p[i]) * 0x100000001B3ull;
+		}
+	}
+
+	u64 cache_key(const f32* pPositions, const f32* pNormals, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount
+		, const Params& params)
+	{
+		u64 h = 0xCBF29CE484222325ull;
+		fnv1a(h, &vertexCount, sizeof(vertexCount));
+		for (u32 i = 0; i < vertexCount; ++i)
+		{
+			fnv1a(h, (const u8*)pPositions + (size_t)i * strideBytes, sizeof(f32) * 3);
+			fnv1a(h, (const u8*)pNormals + (size_t)i * strideBytes, sizeof(f32) * 3);
+		}
+		if (pIndices)
+		{
+			fnv1a(h, pIndices, sizeof(u16) * indexCount);
+		}
+		fnv1a(h, &params.raysPerVertex, sizeof(params.raysPerVertex));
+		fnv1a(h, &params.maxDistance, sizeof(params.maxDistance));
+		fnv1a(h, &params.rayBias, sizeof(params.rayBias));
+		return h;
+	}
+
+	bool load_cache(const char* pPath, u64 key, u32 vertexCount, std::vector<u8>& alphaOut)
+	{
+		std::ifstream in(pPath, std::ios::binary);
+		if (!in)
+			return false;
+
+		char magic[4];
+		u64 fileKey = 0;
+		u32 fileCount = 0;
+		in.read(magic, sizeof(magic));
+		in.read((char*)&fileKey, sizeof(fileKey));
+		in.read((char*)&fileCount, sizeof(fileCount));
+		if (!in || memcmp(magic, kMagic, sizeof(kMagic)) || fileKey != key || fileCount != vertexCount)
+			return false;
+
+		alphaOut.resize(vertexCount);
+		in.read((char*)alphaOut.data(), vertexCount);
+		return (bool)in;
+	}
+
+	bool save_cache(const char* pPath, u64 key, const std::vector<u8>& alpha)
+	{
+		std::ofstream out(pPath, std::ios::binary);
+		if (!out)
+			return false;
+
+		const u32 count = (u32)alpha.size();
+		out.write(kMagic, sizeof(kMagic));
+		out.write((const char*)&key, sizeof(key));
+		out.write((const char*)&count, sizeof(count));
+		out.write((const char*)alpha.data(), count);
+		return (bool)out;
+	}
+}
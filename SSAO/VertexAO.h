@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <vector>
+
+class WorkerPool;
+
+//================================================================================
+// Baked Vertex AO
+// Offline ambient occlusion per vertex of a static mesh, packed into the alpha
+// of MeshVertex::colour (R8G8B8A8_UNORM, which every loader fills with 0xFF).
+// The geometry pass writes the interpolated alpha to the G-buffer and the
+// directional light scales its ambient by it as well as by the SSAO, so the
+// wide, low frequency occlusion comes for free at runtime and the SSAO radius
+// and tap count only need to cover contact detail.
+//
+// The bake is mesh local: the mesh's own triangles go in a BVH and every vertex
+// casts cosine weighted rays with GroundTruthAO::obscurance(), vertices over the
+// WorkerPool. Instances share one vertex buffer, so occlusion between objects
+// is still the SSAO's job.
+//
+// Results are cached in a file next to the model keyed by a hash of the mesh
+// and the params, only the first load of a changed mesh pays for the bake.
+//================================================================================
+namespace VertexAO
+{
+	struct Params
+	{
+		u32 raysPerVertex = 256;	// rounded up to a multiple of 4.
+		f32 maxDistance = 0.f;		// mesh units, 0 = a quarter of the bounding sphere's radius.
+		f32 rayBias = 1e-3f;		// origin offset along the normal, times maxDistance.
+	};
+
+	// pPositions / pNormals point at the first vertex's x, both strideBytes apart. pIndices is a u16
+	// triangle list, or null when the vertices are. visibilityOut[i] in [0, 1], 1 = unoccluded.
+	void bake(const f32* pPositions, const f32* pNormals, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount
+		, const Params& params, std::vector<f32>& visibilityOut, WorkerPool* pPool = nullptr);
+
+	// The alpha byte of an R8G8B8A8_UNORM colour.
+	u8 to_alpha(f32 visibility);
+	u32 pack(u32 colour, u8 alpha);
+	f32 unpack(u32 colour);
+
+	// FNV-1a over the positions, normals, indices and params: changes whenever the bake would.
+	u64 cache_key(const f32* pPositions, const f32* pNormals, u32 vertexCount, u32 strideBytes, const u16* pIndices, u32 indexCount
+		, const Params& params);
+
+	// Cache file: "VAO1", the key, the vertex count, then one alpha byte per vertex. load_cache()
+	// fails on a missing file or any mismatch.
+	bool load_cache(const char* pPath, u64 key, u32 vertexCount, std::vector<u8>& alphaOut);
+	bool save_cache(const char* pPath, u64 key, const std::vector<u8>& alpha);
+}
@@ -0,0 +1,326 @@
+//================================================================================
+// BlurBench
+// CPU checks and timings for the fused separable blur (Framework/SeparableBlur.h)
+// and the Kawase / dual filter blurs (Framework/KawaseBlur.h).
+//
+// Checks the 5 linear fetches of PS_BLUR_GAUSS_X / _Y add up to the 9 tap kernel,
+// that Gauss9(n) is n X + Y passes of it, that the tiled fused blur matches the
+// plain two pass one and that the Kawase blurs keep a flat image flat (single
+// threaded and over a WorkerPool). Then times the two pass blur against the fused
+// one, and lists every blur the app has with its effective radius (the sigma of
+// its impulse response), the GPU texture fetches it spends per texel and the
+// fetches per texel of sigma, the cost per effective radius.
+//
+// usage : BlurBench [width] [height] [iterations]
+//================================================================================
+#include "SeparableBlur.h"
+#include "KawaseBlur.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace
+{
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		f32 next01() { return (next() >> 8) * (1.0f / 16777216.0f); }
+	};
+
+	// AO like: smooth occlusion plus per pixel noise.
+	std::vector<f32> make_image(u32 width, u32 height)
+	{
+		Rng rng(0x5EED);
+		std::vector<f32> image(width * height);
+		for (u32 y = 0; y < height; ++y)
+		{
+			for (u32 x = 0; x < width; ++x)
+			{
+				const f32 smooth = 0.5f + 0.25f * std::sin(x * 0.031f) * std::cos(y * 0.047f);
+				image[y * width + x] = std::min(std::max(smooth + (rng.next01() - 0.5f) * 0.4f, 0.f), 1.f);
+			}
+		}
+		return image;
+	}
+
+	f32 max_difference(const std::vector<f32>& a, const std::vector<f32>& b)
+	{
+		f32 maxDiff = 0.f;
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			maxDiff = std::max(maxDiff, std::fabs(a[i] - b[i]));
+		}
+		return maxDiff;
+	}
+
+	// Bilinear weights of the linear fetches, split back onto the texels they straddle.
+	bool check_linear_taps()
+	{
+		f32 discrete[5] = {};
+		discrete[0] = LinearGaussTaps::kWeights[0];
+		for (u32 i = 1; i < LinearGaussTaps::kFetches; ++i)
+		{
+			const f32 offset = LinearGaussTaps::kOffsets[i];
+			const u32 texel = (u32)offset;
+			const f32 t = offset - texel;
+			discrete[texel] += LinearGaussTaps::kWeights[i] * (1.f - t);
+			discrete[texel + 1] += LinearGaussTaps::kWeights[i] * t;
+		}
+
+		const BlurKernel gauss = BlurKernel::Gauss9();
+		bool ok = true;
+		for (s32 i = 0; i < 5; ++i)
+		{
+			if (std::fabs(discrete[i] - gauss.weight(i)) > 1e-6f || gauss.weight(i) != gauss.weight(-i))
+			{
+				fprintf(stderr, "MISMATCH: linear fetches give %.8f for tap %d, kernel has %.8f\n", discrete[i], i, gauss.weight(i));
+				ok = false;
+			}
+		}
+		return ok;
+	}
+
+	// Gauss9(n) in one X and one Y pass against n X + Y passes of Gauss9(1), away from the clamped edges.
+	bool check_iterated_gauss(const std::vector<f32>& image, u32 width, u32 height, u32 iterations)
+	{
+		std::vector<f32> once(image), scratch(image.size());
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			blur_separable(once.data(), scratch.data(), width, height, BlurKernel::Gauss9());
+			std::swap(once, scratch);
+		}
+
+		std::vector<f32> combined(image.size());
+		const BlurKernel kernel = BlurKernel::Gauss9(iterations);
+		blur_separable(image.data(), combined.data(), width, height, kernel);
+
+		f32 maxDiff = 0.f;
+		for (u32 y = kernel.radius; y + kernel.radius < height; ++y)
+		{
+			for (u32 x = kernel.radius; x + kernel.radius < width; ++x)
+			{
+				maxDiff = std::max(maxDiff, std::fabs(once[y * width + x] - combined[y * width + x]));
+			}
+		}
+
+		if (maxDiff > 1e-5f)
+		{
+			fprintf(stderr, "MISMATCH: Gauss9(%u) is %g from %u passes\n", iterations, maxDiff, iterations);
+			return false;
+		}
+		return true;
+	}
+
+	bool check_fused(const char* pName, const std::vector<f32>& image, u32 width, u32 height, const BlurKernel& kernel, WorkerPool& pool)
+	{
+		std::vector<f32> reference(image.size()), fused(image.size()), threaded(image.size());
+		blur_separable(image.data(), reference.data(), width, height, kernel);
+		blur_fused(image.data(), fused.data(), width, height, kernel);
+		blur_fused(image.data(), threaded.data(), width, height, kernel, &pool);
+
+		const f32 fusedDiff = max_difference(reference, fused);
+		const f32 threadedDiff = max_difference(fused, threaded);
+		if (fusedDiff > 1e-5f || threadedDiff != 0.f)
+		{
+			fprintf(stderr, "MISMATCH: %s fused is %g from two pass, threaded is %g from single\n", pName, fusedDiff, threadedDiff);
+			return false;
+		}
+		return true;
+	}
+
+	using BlurFn = std::function<void(const f32* pIn, f32* pOut, u32 width, u32 height, WorkerPool* pPool)>;
+
+	// Iterations of PS_BLUR_KAWASE with the distances the app's Kawase blurs use.
+	BlurFn kawase_chain(const std::vector<u32>& distances)
+	{
+		return [distances](const f32* pIn, f32* pOut, u32 width, u32 height, WorkerPool* pPool)
+		{
+			std::vector<f32> a(pIn, pIn + (size_t)width * height), b(a.size());
+			for (u32 distance : distances)
+			{
+				kawase_pass(a.data(), b.data(), width, height, distance, pPool);
+				std::swap(a, b);
+			}
+			std::copy(a.begin(), a.end(), pOut);
+		};
+	}
+
+	BlurFn dual_filter(u32 levels)
+	{
+		return [levels](const f32* pIn, f32* pOut, u32 width, u32 height, WorkerPool* pPool)
+		{
+			blur_dual_filter(pIn, pOut, width, height, levels, pPool);
+		};
+	}
+
+	BlurFn fused(const BlurKernel& kernel)
+	{
+		return [kernel](const f32* pIn, f32* pOut, u32 width, u32 height, WorkerPool* pPool)
+		{
+			blur_fused(pIn, pOut, width, height, kernel, pPool);
+		};
+	}
+
+	// Flat in, flat out: the taps' weights add up to one and the clamped edges don't leak.
+	bool check_flat(const char* pName, const BlurFn& blur, WorkerPool& pool)
+	{
+		const u32 width = 200, height = 120;
+		const std::vector<f32> flat(width * height, 0.75f);
+		std::vector<f32> out(flat.size()), threaded(flat.size());
+		blur(flat.data(), out.data(), width, height, nullptr);
+		blur(flat.data(), threaded.data(), width, height, &pool);
+
+		const f32 flatDiff = max_difference(flat, out);
+		const f32 threadedDiff = max_difference(out, threaded);
+		if (flatDiff > 1e-5f || threadedDiff != 0.f)
+		{
+			fprintf(stderr, "MISMATCH: %s moves a flat image by %g, threaded is %g from single\n", pName, flatDiff, threadedDiff);
+			return false;
+		}
+		return true;
+	}
+
+	// Standard deviation of the impulse response along x, in texels. The pyramid's response depends
+	// on where the impulse falls against the levels so it is averaged over a run of positions.
+	f32 effective_sigma(const BlurFn& blur, u32 phases)
+	{
+		const u32 size = 512;
+		std::vector<f32> impulse(size * size), response(size * size);
+
+		f64 variance = 0.0;
+		for (u32 phase = 0; phase < phases; ++phase)
+		{
+			const u32 centre = size / 2 + phase;
+			std::fill(impulse.begin(), impulse.end(), 0.f);
+			impulse[centre * size + centre] = 1.f;
+			blur(impulse.data(), response.data(), size, size, nullptr);
+
+			// About the response's own centre, a pyramid can shift it by part of a texel.
+			f64 sum = 0.0, mean = 0.0, moment = 0.0;
+			for (u32 y = 0; y < size; ++y)
+			{
+				for (u32 x = 0; x < size; ++x)
+				{
+					const f64 w = response[y * size + x];
+					const f64 dx = (f64)x - centre;
+					sum += w;
+					mean += w * dx;
+					moment += w * dx * dx;
+				}
+			}
+			mean /= sum;
+			variance += moment / sum - mean * mean;
+		}
+		return (f32)std::sqrt(variance / phases);
+	}
+
+	template <typename Fn>
+	f64 time_ms(u32 iterations, Fn fn)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			fn();
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<f64, std::milli>(end - start).count();
+	}
+
+	void bench(const char* pName, const std::vector<f32>& image, u32 width, u32 height, const BlurKernel& kernel, WorkerPool& pool, u32 iterations)
+	{
+		std::vector<f32> out(image.size());
+		const f64 texels = (f64)width * height * iterations;
+
+		const f64 separableMs = time_ms(iterations, [&] { blur_separable(image.data(), out.data(), width, height, kernel); });
+		const f64 fusedMs = time_ms(iterations, [&] { blur_fused(image.data(), out.data(), width, height, kernel); });
+		const f64 threadedMs = time_ms(iterations, [&] { blur_fused(image.data(), out.data(), width, height, kernel, &pool); });
+
+		printf("%s : radius %u, sigma %.2f\n", pName, kernel.radius, kernel.sigma());
+		printf("  Two pass       : %8.3f ms/blur  %6.2f ns/texel\n", separableMs / iterations, separableMs * 1e6 / texels);
+		printf("  Fused          : %8.3f ms/blur  %6.2f ns/texel  (x%.2f)\n", fusedMs / iterations, fusedMs * 1e6 / texels, separableMs / fusedMs);
+		printf("  Fused %2u thrd  : %8.3f ms/blur  %6.2f ns/texel  (x%.2f)\n", pool.threads(), threadedMs / iterations, threadedMs * 1e6 / texels, separableMs / threadedMs);
+	}
+
+	struct BlurEntry
+	{
+		const char* pName;
+		BlurFn blur;
+		u32 passes;
+		f32 fetches;	// GPU texture fetches (shared memory loads for the fused blur) per blur target texel.
+		u32 phases;
+	};
+
+	void bench_radius(const std::vector<BlurEntry>& entries, const std::vector<f32>& image, u32 width, u32 height, WorkerPool& pool, u32 iterations)
+	{
+		std::vector<f32> out(image.size());
+		const f64 texels = (f64)width * height * iterations;
+
+		printf("Cost per effective radius (sigma of the impulse response, blur target texels):\n");
+		printf("  %-28s %6s %7s %8s %13s %10s %9s\n", "", "sigma", "passes", "fetches", "fetches/sigma", "cpu ms", "ns/texel");
+		for (const BlurEntry& e : entries)
+		{
+			const f32 sigma = effective_sigma(e.blur, e.phases);
+			const f64 ms = time_ms(iterations, [&] { e.blur(image.data(), out.data(), width, height, &pool); });
+			printf("  %-28s %6.2f %7u %8.2f %13.2f %10.3f %9.2f\n", e.pName, sigma, e.passes, e.fetches, e.fetches / sigma, ms / iterations, ms * 1e6 / texels);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const u32 width = argc > 1 ? (u32)atoi(argv[1]) : 1920;
+	const u32 height = argc > 2 ? (u32)atoi(argv[2]) : 1080;
+	const u32 iterations = argc > 3 ? (u32)atoi(argv[3]) : 10;
+
+	WorkerPool pool;
+	const std::vector<f32> image = make_image(width, height);
+
+	const BlurKernel gauss = BlurKernel::Gauss9(3);
+	const BlurKernel box = BlurKernel::Box(8, 3);
+
+	bool ok = check_linear_taps();
+	ok &= check_iterated_gauss(image, width, height, 3);
+	ok &= check_fused("Gauss9(1)", image, width, height, BlurKernel::Gauss9(), pool);
+	ok &= check_fused("Gauss9(3)", image, width, height, gauss, pool);
+	ok &= check_fused("Box(8, 3)", image, width, height, box, pool);
+	ok &= check_flat("Kawase LRG", kawase_chain({ 0, 1, 2, 2, 3 }), pool);
+	for (u32 levels = 1; levels <= kDualFilterMaxLevels; ++levels)
+	{
+		ok &= check_flat("Dual filter", dual_filter(levels), pool);
+	}
+	if (!ok)
+	{
+		return 1;
+	}
+
+	printf("%ux%u, %u iterations\n", width, height, iterations);
+	bench("Gauss9(3)", image, width, height, gauss, pool, iterations);
+	bench("Box(8, 3)", image, width, height, box, pool, iterations);
+
+	// The app's blurs, the Kawase ones as PS_BLUR_KAWASE runs them (kernel {0, 1, 2, 2, 3} for 3 to 5 passes).
+	// Passes and fetches are the GPU's, the times are the CPU versions' (both gaussians through blur_fused).
+	std::vector<BlurEntry> entries = {
+		{ "Fast Gauss (Gauss9 x3)", fused(gauss), 6, 30.f, 1 },
+		{ "Fused Gauss Box(8, 3)", fused(box), 1, (f32)((16 + 2 * box.radius) * (16 + 2 * box.radius)) / 256.f, 1 },
+		{ "Kawase SML 0,1,2", kawase_chain({ 0, 1, 2 }), 3, 12.f, 1 },
+		{ "Kawase MED 0,1,2,2", kawase_chain({ 0, 1, 2, 2 }), 4, 16.f, 1 },
+		{ "Kawase LRG 0,1,2,2,3", kawase_chain({ 0, 1, 2, 2, 3 }), 5, 20.f, 1 },
+	};
+	static const char* kDualNames[kDualFilterMaxLevels] = { "Dual Filter 1 level", "Dual Filter 2 levels", "Dual Filter 3 levels"
+		, "Dual Filter 4 levels", "Dual Filter 5 levels", "Dual Filter 6 levels" };
+	for (u32 levels = 1; levels <= kDualFilterMaxLevels; ++levels)
+	{
+		entries.push_back({ kDualNames[levels - 1], dual_filter(levels), 2 * levels, dual_filter_fetches(levels), 1u << levels });
+	}
+	bench_radius(entries, image, width, height, pool, iterations);
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+//================================================================================
+// CaptureReplay
+// Replays frames the app captured (SSAO/FrameCapture.h) through the CPU ports
+// of its passes: the G-buffer decode, the Vogel / Alchemy SSAO
+// (AOReference::ssao_vogel_alchemy) with the captured SSAOCB, and the fused
+// gaussian (blur_fused). No window or GPU, so a corpus of captures from the
+// field runs as a benchmark anywhere.
+//
+// Prints each pass's average time per capture. Writes the blurred visibility
+// as an 8 bit PGM per capture when given a directory, ready for ImageCompare.
+//
+// usage : CaptureReplay <iterations> <ao output dir or -> <capture.ssfc> [capture.ssfc ...]
+//================================================================================
+#include "FrameCapture.h"
+#include "SeparableBlur.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	template <typename Fn>
+	f64 time_ms(u32 iterations, const Fn& fn)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			fn();
+		}
+		return std::chrono::duration<f64, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / iterations;
+	}
+
+	bool write_pgm(const std::string& path, const std::vector<f32>& texels, u32 width, u32 height)
+	{
+		FILE* pFile = fopen(path.c_str(), "wb");
+		if (!pFile)
+			return false;
+
+		fprintf(pFile, "P5\n%u %u\n255\n", width, height);
+		std::vector<u8> bytes(texels.size());
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			bytes[i] = (u8)(std::min(std::max(texels[i], 0.f), 1.f) * 255.f + 0.5f);
+		}
+		const bool ok = fwrite(bytes.data(), 1, bytes.size(), pFile) == bytes.size();
+		fclose(pFile);
+		return ok;
+	}
+
+	// File name without the directories or the extension.
+	std::string capture_name(const char* pPath)
+	{
+		std::string name = pPath;
+		const size_t slash = name.find_last_of("/\\");
+		if (slash != std::string::npos)
+			name = name.substr(slash + 1);
+		const size_t dot = name.find_last_of('.');
+		return dot == std::string::npos ? name : name.substr(0, dot);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		printf("usage : CaptureReplay <iterations> <ao output dir or -> <capture.ssfc> [capture.ssfc ...]\n");
+		return 1;
+	}
+
+	const u32 iterations = std::max(1, atoi(argv[1]));
+	const char* pOutputDir = strcmp(argv[2], "-") ? argv[2] : nullptr;
+
+	WorkerPool pool;
+	const BlurKernel blur = BlurKernel::Gauss9(3);
+	printf("%u captures, %u iterations, %u threads\n", (u32)(argc - 3), iterations, pool.threads());
+
+	u32 failures = 0;
+	for (int arg = 3; arg < argc; ++arg)
+	{
+		const char* pPath = argv[arg];
+		FrameCapture::Replay replay;
+		const f64 openMs = time_ms(1, [&] { replay.open(pPath); });
+		if (!replay.is_open())
+		{
+			printf("FAILED %s is not a version %u capture\n", pPath, FrameCapture::kVersion);
+			++failures;
+			continue;
+		}
+
+		const u32 width = replay.width();
+		const u32 height = replay.height();
+		const AOReference::Params params = replay.params();
+
+		AOReference::GBuffer gbuffer;
+		AOReference::Image ao;
+		std::vector<f32> blurred(width * height);
+		const f64 decodeMs = time_ms(iterations, [&] { replay.decode(gbuffer, &pool); });
+		const f64 ssaoMs = time_ms(iterations, [&] { AOReference::ssao_vogel_alchemy(gbuffer, params, ao, &pool); });
+		const f64 blurMs = time_ms(iterations, [&] { blur_fused(ao.texels.data(), blurred.data(), width, height, blur, &pool); });
+
+		printf("%s : %ux%u, %u taps\n", pPath, width, height, params.samples * 4);
+		printf("  Map            : %8.3f ms\n", openMs);
+		printf("  G-buffer decode: %8.3f ms\n", decodeMs);
+		printf("  SSAO           : %8.3f ms\n", ssaoMs);
+		printf("  Blur           : %8.3f ms\n", blurMs);
+
+		if (pOutputDir)
+		{
+			for (f32& texel : blurred)
+			{
+				texel = 1.f - texel;
+			}
+			const std::string path = std::string(pOutputDir) + "/" + capture_name(pPath) + ".pgm";
+			if (!write_pgm(path, blurred, width, height))
+			{
+				printf("FAILED to write %s\n", path.c_str());
+				++failures;
+				continue;
+			}
+			printf("  Wrote %s\n", path.c_str());
+		}
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+//================================================================================
+// CullBench
+// CPU micro-benchmark for the batched frustum culler (Framework/Culling.h).
+//
+// Scatters N bounds (boxes and light sized spheres) over a scene several times
+// larger than the view, culls them with the scalar and SIMD paths, checks the
+// two agree and reports ns per bound and bounds per microsecond.
+//
+// usage : CullBench [bounds] [iterations]
+//================================================================================
+#include "Culling.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		f32 next01() { return (next() >> 8) * (1.0f / 16777216.0f); }
+		f32 range(f32 lo, f32 hi) { return lo + (hi - lo) * next01(); }
+	};
+
+	// Perspective camera at the origin looking down +z, row vector D3D conventions like the app's Camera.
+	hlsl::float4x4 view_projection(f32 fovY, f32 aspect, f32 zNear, f32 zFar)
+	{
+		const f32 yScale = 1.f / std::tan(fovY * 0.5f);
+		const f32 xScale = yScale / aspect;
+
+		hlsl::float4x4 m = {};
+		m.m[0][0] = xScale;
+		m.m[1][1] = yScale;
+		m.m[2][2] = zFar / (zFar - zNear);
+		m.m[2][3] = 1.f;
+		m.m[3][2] = -zNear * zFar / (zFar - zNear);
+		return m;
+	}
+
+	template <typename Fn>
+	f64 time_ms(u32 iterations, Fn fn)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			fn();
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<f64, std::milli>(end - start).count();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const u32 count = argc > 1 ? (u32)atoi(argv[1]) : 100000;
+	const u32 iterations = argc > 2 ? (u32)atoi(argv[2]) : 200;
+
+	Rng rng(0x5EED);
+
+	CullSet set;
+	set.reserve(count);
+	for (u32 i = 0; i < count; ++i)
+	{
+		const hlsl::float3 center(rng.range(-200.f, 200.f), rng.range(-20.f, 40.f), rng.range(-200.f, 200.f));
+		if (i & 1)
+		{
+			set.add(Bounds::FromSphere(center, rng.range(0.5f, 5.f)));
+		}
+		else
+		{
+			Bounds b;
+			b.center = center;
+			b.extents = hlsl::float3(rng.range(0.25f, 4.f), rng.range(0.25f, 4.f), rng.range(0.25f, 4.f));
+			b.radius = hlsl::length(b.extents);
+			set.add(b);
+		}
+	}
+
+	const Frustum frustum = Frustum::FromViewProjection(view_projection(degToRad(60.f), 16.f / 9.f, 0.1f, 150.f));
+
+	std::vector<u32> scalarVisible, simdVisible;
+	cull_frustum_scalar(frustum, set, scalarVisible);
+	cull_frustum(frustum, set, simdVisible);
+
+	if (scalarVisible != simdVisible)
+	{
+		fprintf(stderr, "MISMATCH: scalar %zu visible, %s %zu visible\n", scalarVisible.size(), cull_frustum_isa(), simdVisible.size());
+		return 1;
+	}
+
+	const f64 scalarMs = time_ms(iterations, [&] { cull_frustum_scalar(frustum, set, scalarVisible); });
+	const f64 simdMs = time_ms(iterations, [&] { cull_frustum(frustum, set, simdVisible); });
+
+	const f64 scalarNs = scalarMs * 1e6 / ((f64)iterations * count);
+	const f64 simdNs = simdMs * 1e6 / ((f64)iterations * count);
+
+	printf("%u bounds, %zu visible (%.1f%%), %u iterations\n", count, simdVisible.size(), 100.0 * simdVisible.size() / count, iterations);
+	printf("  Scalar : %8.3f ms/cull  %6.2f ns/bound  %8.1f bounds/us\n", scalarMs / iterations, scalarNs, 1e3 / scalarNs);
+	printf("  %-6s : %8.3f ms/cull  %6.2f ns/bound  %8.1f bounds/us  (x%.2f)\n", cull_frustum_isa(), simdMs / iterations, simdNs, 1e3 / simdNs, scalarNs / simdNs);
+
+	return 0;
+}
@@ -0,0 +1,1015 @@
+//================================================================================
+// FrameworkChecks
+// CPU checks of the framework pieces whose logic runs without a device, so
+// they can be run headless (CI, Linux) and fail the build.
+//
+// Render graph (Framework/RenderGraph.h): execution order, culling of passes
+// nothing reads, transient aliasing (only disjoint lifetimes, only compatible
+// descriptions), the barriers' before / after states and compile() failing on
+// a read before write and on a cycle.
+//
+// Render target pool (Framework/RenderTargetPool.h) on a counting allocator:
+// reuse of a bucket across frames and after an early release, eviction after
+// exactly maxIdleFrames unused, and the live / peak byte accounting.
+//
+// Draw list (Framework/DrawList.h): the radix sort of random draws against
+// std::stable_sort on the same 64 bit keys, and the shader / mesh / material
+// binds sent and skipped per pass, counted by a backend that also fails any
+// bind of what it already has bound.
+//
+// Command buffers (Framework/CommandBuffer.h): disjoint ranges of a sorted pass
+// recorded on WorkerPool threads, and by CommandRecorder on its workers,
+// replay exactly the draws of a serial recording in the same order, with the
+// same shader / mesh / material bound at each, also after a word round trip.
+//
+// Upload ring (Framework/UploadRing.h) written into a mirror of the GPU buffer:
+// aligned offsets, frames placed after each other until one doesn't fit and
+// wraps to 0 with a discard, no frame written over one the GPU may still read,
+// and a frame bigger than the ring growing it.
+//
+// G-buffer encoding (SSAO/GBufferEncoding.h): octahedral RG16 normals and RGBA8
+// albedo packed and unpacked the way the shaders and the hardware do it, with
+// the normal error in degrees and the albedo error in 8 bit steps.
+//
+// Coverage (Framework/Coverage.h) and the render graph's clear skipping: the
+// full screen quad covers every texel exactly once from 1x1 up to 1919x1081,
+// regular and jittered triangle grids do too, a half screen quad is reported
+// uncovered from the right texel (and its other half fills exactly the rest),
+// only the fully covered clear is skipped, and validation reports both the
+// partial coverage and a kDontCare target nothing declares coverage for. The
+// coverage cache follows the vertices, not the pointer to them: triangles
+// rebuilt in the same storage every frame get the clear their coverage needs.
+//
+// Prints FAILED and what differed for each failure, returns 1 if any failed.
+//
+// usage : FrameworkChecks
+//================================================================================
+#include "CommandBuffer.h"
+#include "Coverage.h"
+#include "GBufferEncoding.h"
+#include "DrawList.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+#include "UploadRing.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	u32 g_failures = 0;
+
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+	};
+
+	void fail(const char* pCheck, const char* pWhat)
+	{
+		printf("FAILED %s : %s\n", pCheck, pWhat);
+		++g_failures;
+	}
+
+	//================================================================================
+	// Render graph
+	//================================================================================
+
+	const RGTextureDesc kColour = RGTextureDesc::Create(64, 64, RGFormat::kRGBA8_UNORM);
+
+	const auto kNoExecute = [](const RGPassContext&) {};
+
+	std::vector<u32> pass_names_to_indices(const RenderGraph& graph, std::initializer_list<const char*> names)
+	{
+		std::vector<u32> indices;
+		for (const char* pName : names)
+		{
+			indices.push_back(graph.pass_index(pName));
+		}
+		return indices;
+	}
+
+	bool has_barrier(const RenderGraph& graph, const char* pPass, RGResource resource, RGState before, RGState after, bool aliasing)
+	{
+		for (const RGBarrier& b : graph.barriers(graph.pass_index(pPass)))
+		{
+			if (b.resource == resource.index && b.before == before && b.after == after && b.aliasing == aliasing)
+				return true;
+		}
+		return false;
+	}
+
+	// Write after read on a transient: the second writer waits for the first's reader, the result
+	// keeps declaration order and an unread output culls its pass and the pass feeding only it.
+	void check_graph_order_and_culling()
+	{
+		const char* pCheck = "render graph order / culling";
+
+		RenderGraph graph;
+		graph.reset();
+		const RGResource t = graph.create_texture("T", kColour);
+		const RGResource unused = graph.create_texture("Unused", kColour);
+		const RGResource feed = graph.create_texture("Feed", kColour);
+		const RGResource outA = graph.import_texture("Out A", kColour, nullptr);
+		const RGResource outB = graph.import_texture("Out B", kColour, nullptr);
+
+		graph.add_pass("Write T", [&](RGPassBuilder& b) { b.write(t); }, kNoExecute);
+		graph.add_pass("Read T", [&](RGPassBuilder& b) { b.read(t, 0); b.write(outA); }, kNoExecute);
+		graph.add_pass("Feed Unused", [&](RGPassBuilder& b) { b.write(feed); }, kNoExecute);
+		graph.add_pass("Write Unused", [&](RGPassBuilder& b) { b.read(feed, 0); b.write(unused); }, kNoExecute);
+		graph.add_pass("Rewrite T", [&](RGPassBuilder& b) { b.write(t); }, kNoExecute);
+		graph.add_pass("Read T Again", [&](RGPassBuilder& b) { b.read(t, 0); b.write(outB); }, kNoExecute);
+		graph.add_pass("Side Effect", [&](RGPassBuilder& b) { b.side_effect(); }, kNoExecute);
+
+		if (!graph.compile())
+		{
+			fail(pCheck, "compile() failed");
+			return;
+		}
+
+		if (graph.order() != pass_names_to_indices(graph, { "Write T", "Read T", "Rewrite T", "Read T Again", "Side Effect" }))
+			fail(pCheck, "order isn't Write T, Read T, Rewrite T, Read T Again, Side Effect");
+		if (!graph.is_culled(graph.pass_index("Write Unused")) || !graph.is_culled(graph.pass_index("Feed Unused")))
+			fail(pCheck, "a pass nothing reads, or the pass only it reads, wasn't culled");
+		if (graph.is_culled(graph.pass_index("Side Effect")))
+			fail(pCheck, "the side effect pass was culled");
+		if (graph.stats().passes != 5 || graph.stats().culledPasses != 2)
+			fail(pCheck, "stats don't count 5 passes and 2 culled");
+	}
+
+	// A -> B -> C -> D chain of same sized targets plus one of another format: lifetimes that
+	// touch get their own textures, the first and third share one, the other format never does.
+	void check_graph_aliasing_and_barriers()
+	{
+		const char* pCheck = "render graph aliasing / barriers";
+
+		RGTextureDesc half = kColour;
+		half.format = RGFormat::kR16_FLOAT;
+
+		RenderGraph graph;
+		graph.reset();
+		const RGResource t1 = graph.create_texture("T1", kColour);
+		const RGResource t2 = graph.create_texture("T2", kColour);
+		const RGResource t3 = graph.create_texture("T3", kColour);
+		const RGResource other = graph.create_texture("Other Format", half);
+		const RGResource out = graph.import_texture("Out", kColour, nullptr, RGState::kShaderResource);
+
+		graph.add_pass("A", [&](RGPassBuilder& b) { b.write(t1); }, kNoExecute);
+		graph.add_pass("B", [&](RGPassBuilder& b) { b.read(t1, 0); b.write(t2); }, kNoExecute);
+		graph.add_pass("C", [&](RGPassBuilder& b) { b.read(t2, 0); b.write(t3); b.write(other, 1); }, kNoExecute);
+		graph.add_pass("D", [&](RGPassBuilder& b) { b.read(t3, 0); b.read(other, 1); b.write(out); }, kNoExecute);
+
+		if (!graph.compile())
+		{
+			fail(pCheck, "compile() failed");
+			return;
+		}
+
+		if (graph.physical_index(t1) != graph.physical_index(t3))
+			fail(pCheck, "T1 and T3 don't overlap but weren't aliased");
+		if (graph.physical_index(t2) == graph.physical_index(t1) || graph.physical_index(t2) == graph.physical_index(t3))
+			fail(pCheck, "T2 shares a texture with a transient it's alive with");
+		if (graph.physical_index(other) == graph.physical_index(t1) || graph.physical_index(other) == graph.physical_index(t2))
+			fail(pCheck, "a texture of another format was aliased");
+		if (graph.stats().transients != 4 || graph.stats().physicalTransients != 3)
+			fail(pCheck, "stats don't count 4 transients on 3 textures");
+
+		if (!has_barrier(graph, "A", t1, RGState::kUndefined, RGState::kRenderTarget, false))
+			fail(pCheck, "A has no T1 Undefined -> RenderTarget barrier");
+		if (!has_barrier(graph, "B", t1, RGState::kRenderTarget, RGState::kShaderResource, false))
+			fail(pCheck, "B has no T1 RenderTarget -> ShaderResource barrier");
+		if (!has_barrier(graph, "C", t3, RGState::kUndefined, RGState::kRenderTarget, true))
+			fail(pCheck, "C has no aliasing T3 Undefined -> RenderTarget barrier");
+		if (!has_barrier(graph, "D", out, RGState::kShaderResource, RGState::kRenderTarget, false))
+			fail(pCheck, "D has no Out ShaderResource -> RenderTarget barrier from its initial state");
+		if (graph.barriers(graph.pass_index("D")).size() != 3)
+			fail(pCheck, "D doesn't have exactly its 3 barriers");
+	}
+
+	void check_graph_failures()
+	{
+		const char* pCheck = "render graph compile failures";
+
+		RenderGraph graph;
+		graph.reset();
+		RGResource t = graph.create_texture("T", kColour);
+		RGResource out = graph.import_texture("Out", kColour, nullptr);
+		graph.add_pass("Read", [&](RGPassBuilder& b) { b.read(t, 0); b.write(out); }, kNoExecute);
+		graph.add_pass("Write", [&](RGPassBuilder& b) { b.write(t); }, kNoExecute);
+		if (graph.compile())
+			fail(pCheck, "a transient read before it was written compiled");
+
+		graph.reset();
+		t = graph.create_texture("T", kColour);
+		out = graph.import_texture("Out", kColour, nullptr);
+		graph.add_pass("Write", [&](RGPassBuilder& b) { b.write(t); }, kNoExecute);
+		graph.add_pass("Feedback", [&](RGPassBuilder& b) { b.read(t, 0); b.write(t); b.write(out, 1); }, kNoExecute);
+		if (graph.compile())
+			fail(pCheck, "a pass reading the texture it writes (a cycle) compiled");
+
+		// And the same graph without the mistakes still compiles.
+		graph.reset();
+		t = graph.create_texture("T", kColour);
+		out = graph.import_texture("Out", kColour, nullptr);
+		graph.add_pass("Write", [&](RGPassBuilder& b) { b.write(t); }, kNoExecute);
+		graph.add_pass("Read", [&](RGPassBuilder& b) { b.read(t, 0); b.write(out); }, kNoExecute);
+		if (!graph.compile())
+			fail(pCheck, "a valid graph failed after the graph was reset");
+	}
+
+	//================================================================================
+	// Render target pool
+	//================================================================================
+
+	// Targets are just numbers, every one created must be destroyed exactly once.
+	class CountingAllocator : public RTPoolAllocator
+	{
+	public:
+		void* create_target(const RTPoolKey&) override
+		{
+			void* pTarget = (void*)(uintptr_t)++m_next;
+			m_live.push_back(pTarget);
+			return pTarget;
+		}
+
+		void destroy_target(void* pTarget) override
+		{
+			auto it = std::find(m_live.begin(), m_live.end(), pTarget);
+			if (it == m_live.end())
+			{
+				fail("render target pool", "a target was destroyed twice, or wasn't the pool's");
+				return;
+			}
+			m_live.erase(it);
+			m_destroyed.push_back(pTarget);
+		}
+
+		std::vector<void*> m_live;
+		std::vector<void*> m_destroyed;
+		uintptr_t m_next = 0;
+	};
+
+	void check_pool_reuse()
+	{
+		const char* pCheck = "render target pool reuse";
+
+		const RTPoolKey colour = RTPoolKey::From(kColour);
+		RTPoolKey bigger = colour;
+		bigger.width *= 2;
+
+		CountingAllocator allocator;
+		RenderTargetPool pool(allocator);
+
+		pool.begin_frame();
+		void* pFirst = pool.acquire(colour);
+		void* pSecond = pool.acquire(colour);
+		void* pBigger = pool.acquire(bigger);
+		if (pFirst == pSecond || pool.stats().created != 3)
+			fail(pCheck, "two targets of one key in use at once weren't two targets");
+
+		// Next frame everything is free again, the same key gets the same targets back.
+		pool.begin_frame();
+		void* pAgain = pool.acquire(colour);
+		void* pAgain2 = pool.acquire(colour);
+		if (pool.stats().created != 0 || pool.stats().reused != 2 || (pAgain != pFirst && pAgain != pSecond) || pAgain2 == pAgain
+			|| (pAgain2 != pFirst && pAgain2 != pSecond))
+			fail(pCheck, "a key used last frame didn't reuse its targets");
+
+		// Handed back early, the next acquire of the key takes it, another key doesn't.
+		pool.release(pAgain);
+		if (pool.acquire(bigger) != pBigger || pool.acquire(colour) != pAgain || pool.stats().created != 0)
+			fail(pCheck, "a released target wasn't reused, or went to another key");
+
+		if (pool.stats().liveTargets != 3 || pool.stats().inUseTargets != 3)
+			fail(pCheck, "stats don't count 3 live targets in use");
+	}
+
+	void check_pool_eviction()
+	{
+		const char* pCheck = "render target pool eviction / bytes";
+
+		const RTPoolKey colour = RTPoolKey::From(kColour);
+		RTPoolKey bigger = colour;
+		bigger.width *= 2;
+
+		CountingAllocator allocator;
+		RenderTargetPool pool(allocator);
+		if (pool.max_idle_frames() != 30)
+			fail(pCheck, "the default idle limit isn't 30 frames");
+
+		pool.begin_frame();
+		pool.acquire(colour);
+		void* pBigger = pool.acquire(bigger);
+		const u64 bothBytes = colour.size_bytes() + bigger.size_bytes();
+		if (pool.stats().liveBytes != bothBytes || pool.stats().peakBytes != bothBytes)
+			fail(pCheck, "live / peak bytes aren't the two targets' sizes");
+
+		// Only the small key keeps being used. The big one survives 30 idle frames, not 31.
+		for (u32 frame = 1; frame <= 30; ++frame)
+		{
+			pool.begin_frame();
+			pool.acquire(colour);
+		}
+		if (pool.stats().liveTargets != 2 || !allocator.m_destroyed.empty())
+			fail(pCheck, "a target was evicted before it sat idle 30 frames");
+
+		pool.begin_frame();
+		pool.acquire(colour);
+		if (pool.stats().evicted != 1 || allocator.m_destroyed.size() != 1 || allocator.m_destroyed[0] != pBigger)
+			fail(pCheck, "the target idle 31 frames wasn't the one evicted");
+		if (pool.stats().liveBytes != colour.size_bytes() || pool.stats().peakBytes != bothBytes)
+			fail(pCheck, "eviction didn't take its bytes off live, or lowered the peak");
+
+		// The evicted key costs one creation again, and the peak only moves once it's exceeded.
+		pool.begin_frame();
+		pool.acquire(colour);
+		pool.acquire(bigger);
+		pool.acquire(bigger);
+		if (pool.stats().created != 2 || pool.stats().peakBytes != colour.size_bytes() + 2 * bigger.size_bytes())
+			fail(pCheck, "peak bytes didn't follow the new high");
+
+		pool.clear();
+		if (!allocator.m_live.empty() || pool.stats().liveBytes != 0 || pool.stats().liveTargets != 0)
+			fail(pCheck, "clear() left targets alive");
+	}
+
+	//================================================================================
+	// Draw list
+	//================================================================================
+
+	class CountingDrawBackend : public DrawListBackend
+	{
+	public:
+		void bind_shader(u32 shader) override { m_redundant += m_bound && shader == m_shader; m_shader = shader; ++m_shaderBinds; }
+		void bind_mesh(u32 mesh) override { m_redundant += m_bound && mesh == m_mesh; m_mesh = mesh; ++m_meshBinds; }
+		void bind_material(u32 material) override { m_redundant += m_bound && material == m_material; m_material = material; ++m_materialBinds; }
+		void draw(const DrawCommand& cmd) override { m_bound = true; m_drawn.push_back(cmd.userData); }
+
+		// submit() assumes nothing is bound at its start.
+		void new_submit() { m_bound = false; }
+
+		u32 m_shader = 0, m_mesh = 0, m_material = 0;
+		bool m_bound = false;
+		u32 m_shaderBinds = 0, m_meshBinds = 0, m_materialBinds = 0;
+		u32 m_redundant = 0;
+		std::vector<u32> m_drawn;	// userData, in draw order
+	};
+
+	// Binds a filtered submit of sorted commands should send: the first draw binds everything, after
+	// that only what changes.
+	DrawListStats expected_binds(const std::vector<DrawCommand>& commands)
+	{
+		DrawListStats expected;
+		for (size_t i = 0; i < commands.size(); ++i)
+		{
+			const u64 key = commands[i].key;
+			const u64 prev = i ? commands[i - 1].key : 0;
+			const bool first = i == 0;
+
+			const bool shader = first || draw_key_shader(key) != draw_key_shader(prev);
+			const bool mesh = first || draw_key_mesh(key) != draw_key_mesh(prev);
+			const bool material = first || draw_key_material(key) != draw_key_material(prev);
+			expected.shaderBinds += shader;
+			expected.shaderBindsSkipped += !shader;
+			expected.meshBinds += mesh;
+			expected.meshBindsSkipped += !mesh;
+			expected.materialBinds += material;
+			expected.materialBindsSkipped += !material;
+			++expected.draws;
+		}
+		return expected;
+	}
+
+	bool same_binds(const DrawListStats& a, const DrawListStats& b)
+	{
+		return a.draws == b.draws
+			&& a.shaderBinds == b.shaderBinds && a.meshBinds == b.meshBinds && a.materialBinds == b.materialBinds
+			&& a.shaderBindsSkipped == b.shaderBindsSkipped && a.meshBindsSkipped == b.meshBindsSkipped && a.materialBindsSkipped == b.materialBindsSkipped;
+	}
+
+	void check_draw_list()
+	{
+		const char* pCheck = "draw list";
+		const u32 kPasses = 3;
+		const u32 kDraws = 20000;
+
+		// Few shaders / meshes / materials so keys repeat (the sort has to be stable and binds
+		// have something to skip), plus keys over every bit so all 8 radix passes run. The last
+		// pass is like the full screen ones, one quad and material under several shaders, so a
+		// shader changes while the mesh and material stay.
+		Rng rng(0xD4A3);
+		DrawList list;
+		std::vector<DrawCommand> reference;
+		for (u32 i = 0; i < kDraws; ++i)
+		{
+			const u32 pass = rng.next() % kPasses;
+			const bool fullScreen = pass == kPasses - 1;
+			const bool wide = !fullScreen && (rng.next() & 7) == 0;
+			const u32 shader = wide ? rng.next() % (1u << kDrawKeyShaderBits) : rng.next() % 4;
+			const u32 mesh = fullScreen ? 0 : wide ? rng.next() % (1u << kDrawKeyMeshBits) : rng.next() % 12;
+			const u32 material = fullScreen ? 0 : wide ? rng.next() % (1u << kDrawKeyMaterialBits) : rng.next() % 6;
+			const u64 key = make_draw_key(pass, shader, mesh, material);
+			list.add(key, i, 1, i);
+			reference.push_back({ key, i, 1, i });
+		}
+
+		list.sort();
+		std::stable_sort(reference.begin(), reference.end(), [](const DrawCommand& a, const DrawCommand& b) { return a.key < b.key; });
+		for (u32 i = 0; i < kDraws; ++i)
+		{
+			if (list.commands()[i].key != reference[i].key || list.commands()[i].userData != reference[i].userData)
+			{
+				fail(pCheck, "the radix sort's order isn't std::stable_sort's");
+				break;
+			}
+		}
+
+		// Pass by pass, each through its own range of the reference.
+		CountingDrawBackend backend;
+		DrawListStats expected;
+		for (u32 pass = 0; pass < kPasses; ++pass)
+		{
+			u32 first, count;
+			list.pass_range(pass, first, count);
+			const std::vector<DrawCommand> passCommands(reference.begin() + first, reference.begin() + first + count);
+			if (std::any_of(passCommands.begin(), passCommands.end(), [&](const DrawCommand& cmd) { return draw_key_pass(cmd.key) != pass; }))
+				fail(pCheck, "a pass range holds another pass's draws");
+
+			expected.add(expected_binds(passCommands));
+			backend.new_submit();
+			list.submit(backend, pass);
+		}
+
+		const DrawListStats stats = list.stats();
+		if (!same_binds(stats, expected))
+			fail(pCheck, "sent / skipped shader, mesh or material binds aren't what the sorted draws need");
+		if (backend.m_shaderBinds != stats.shaderBinds || backend.m_meshBinds != stats.meshBinds || backend.m_materialBinds != stats.materialBinds)
+			fail(pCheck, "the backend didn't get the binds the stats count as sent");
+		if (backend.m_redundant)
+			fail(pCheck, "a bind of what was already bound reached the backend");
+		if (backend.m_drawn.size() != kDraws || stats.binds() + stats.binds_skipped() != 3 * kDraws)
+			fail(pCheck, "not every draw was submitted once with its three binds");
+		for (u32 i = 0; i < kDraws && backend.m_drawn.size() == kDraws; ++i)
+		{
+			if (backend.m_drawn[i] != reference[i].userData)
+			{
+				fail(pCheck, "draws weren't submitted in key order");
+				break;
+			}
+		}
+		if (!stats.binds_skipped())
+			fail(pCheck, "nothing was skipped, the filter isn't doing anything");
+
+		// Filter off sends everything, the same draws.
+		list.clear();
+		list.set_filter_redundant(false);
+		for (const DrawCommand& cmd : reference)
+		{
+			list.add(cmd.key, cmd.firstInstance, cmd.instanceCount, cmd.userData);
+		}
+		list.sort();
+		CountingDrawBackend unfiltered;
+		list.submit(unfiltered);
+		if (list.stats().binds() != 3 * kDraws || list.stats().binds_skipped() != 0 || unfiltered.m_drawn != backend.m_drawn)
+			fail(pCheck, "with the filter off every bind isn't sent, or the draws changed");
+
+		printf("Draw list : %u draws, %u binds sent, %u redundant binds skipped (%.1f%%)\n", kDraws, stats.binds(), stats.binds_skipped()
+			, 100.0 * stats.binds_skipped() / (3.0 * kDraws));
+	}
+
+	//================================================================================
+	// Command buffers
+	//================================================================================
+
+	// Each draw with what was bound when it was made. A range starts with nothing bound so it
+	// sends binds a serial submit skipped, what each draw sees is the same.
+	struct ResolvedDraw
+	{
+		DrawCommand cmd;
+		u32 shader, mesh, material;
+
+		bool operator==(const ResolvedDraw& o) const
+		{
+			return cmd.key == o.cmd.key && cmd.firstInstance == o.cmd.firstInstance && cmd.instanceCount == o.cmd.instanceCount
+				&& cmd.userData == o.cmd.userData && shader == o.shader && mesh == o.mesh && material == o.material;
+		}
+	};
+
+	class ResolvingBackend : public DrawListBackend
+	{
+	public:
+		void bind_shader(u32 shader) override { m_shader = shader; }
+		void bind_mesh(u32 mesh) override { m_mesh = mesh; }
+		void bind_material(u32 material) override { m_material = material; }
+		void draw(const DrawCommand& cmd) override { m_draws.push_back({ cmd, m_shader, m_mesh, m_material }); }
+
+		u32 m_shader = ~0u, m_mesh = ~0u, m_material = ~0u;
+		std::vector<ResolvedDraw> m_draws;
+	};
+
+	void check_command_buffers(WorkerPool& pool)
+	{
+		const char* pCheck = "command buffers";
+		const u32 kPasses = 2;
+		const u32 kRanges = 16;
+
+		Rng rng(0xC0B1);
+		DrawList list;
+		for (u32 i = 0; i < 20000; ++i)
+		{
+			list.add(make_draw_key(rng.next() % kPasses, rng.next() % 8, rng.next() % 50, rng.next() % 4), i * 3, 1 + rng.next() % 5, i);
+		}
+		list.sort();
+
+		CommandRecorder recorder(3);
+		for (u32 pass = 0; pass < kPasses; ++pass)
+		{
+			CommandBuffer serialBuffer;
+			list.submit(serialBuffer, pass);
+			ResolvingBackend serial;
+			serialBuffer.replay(serial);
+
+			// Disjoint ranges on the pool's threads, each into its own buffer, replayed in range order.
+			u32 first, count;
+			list.pass_range(pass, first, count);
+			std::vector<CommandBuffer> buffers(kRanges);
+			std::vector<DrawListStats> rangeStats(kRanges);
+			pool.parallel_for(kRanges, 1, [&](u32 begin, u32 end)
+			{
+				for (u32 range = begin; range < end; ++range)
+				{
+					const u32 rangeBegin = count * range / kRanges;
+					const u32 rangeEnd = count * (range + 1) / kRanges;
+					list.submit_range(buffers[range], first + rangeBegin, rangeEnd - rangeBegin, rangeStats[range]);
+				}
+			});
+
+			ResolvingBackend threaded;
+			DrawListStats threadedStats;
+			for (u32 range = 0; range < kRanges; ++range)
+			{
+				buffers[range].replay(threaded);
+				threadedStats.add(rangeStats[range]);
+			}
+			if (threaded.m_draws != serial.m_draws)
+				fail(pCheck, "ranges recorded on the worker pool don't replay the serial recording's draws in order");
+			if (threadedStats.draws != count)
+				fail(pCheck, "the ranges' stats don't count every draw of the pass once");
+
+			// CommandRecorder picks its own ranges and threads.
+			RecordedPass recorded;
+			recorder.record(list, pass, recorded);
+			ResolvingBackend fromRecorder;
+			recorded.replay(fromRecorder);
+			if (fromRecorder.m_draws != serial.m_draws)
+				fail(pCheck, "CommandRecorder's buffers don't replay the serial recording's draws in order");
+			if (recorded.buffersUsed < 2)
+				fail(pCheck, "CommandRecorder recorded a big pass on one thread");
+
+			// The words are the whole recording.
+			ResolvingBackend reloaded;
+			for (u32 i = 0; i < recorded.buffersUsed; ++i)
+			{
+				CommandBuffer copy;
+				copy.assign(recorded.buffers[i].words().data(), (u32)recorded.buffers[i].words().size());
+				copy.replay(reloaded);
+			}
+			if (reloaded.m_draws != serial.m_draws)
+				fail(pCheck, "buffers loaded back from their words replay different draws");
+		}
+	}
+
+	//================================================================================
+	// Upload ring
+	//================================================================================
+
+	// A frame's blocks: where they went and the value each starts with.
+	struct UploadedFrame
+	{
+		u32 generation;
+		std::vector<UploadAllocation> allocations;
+		std::vector<u32> offsets;
+		std::vector<u32> values;
+	};
+
+	void check_upload_ring()
+	{
+		const char* pCheck = "upload ring";
+		const u32 kCapacity = 4096;
+		const u32 kAlignment = 256;
+
+		// A discard gets a fresh buffer (D3D11 renames it), frames before it keep theirs until the
+		// GPU is done. So every generation is kept and every frame is checked at the end: nothing
+		// written later may have landed on it.
+		std::vector<std::vector<u8>> generations;
+		std::vector<UploadedFrame> frames;
+
+		UploadRing ring(kCapacity, kAlignment);
+		Rng rng(0x0F1D);
+		u32 wraps = 0;
+		u32 grows = 0;
+		u32 head = 0;
+		for (u32 frame = 0; frame < 200; ++frame)
+		{
+			ring.begin_frame();
+
+			// Now and then a frame bigger than the ring.
+			const bool huge = frame == 120;
+			const u32 blocks = huge ? 40 : 1 + rng.next() % 6;
+
+			UploadedFrame uploaded;
+			for (u32 i = 0; i < blocks; ++i)
+			{
+				const u32 size = huge ? 200 : 4 + rng.next() % 600;
+				const u32 value = frame << 16 | i;
+				UploadAllocation a;
+				void* p = ring.allocate(size, a);
+				memset(p, 0xAB, size);
+				memcpy(p, &value, sizeof(value));
+				if (a.offset % kAlignment || a.size != size)
+					fail(pCheck, "an allocation isn't aligned, or lost its size");
+				uploaded.allocations.push_back(a);
+				uploaded.values.push_back(value);
+			}
+
+			const u32 capacityBefore = ring.capacity();
+			const UploadPlacement placement = ring.commit();
+			if (placement.base % kAlignment || placement.base + placement.size > ring.capacity())
+			{
+				fail(pCheck, "a frame was placed unaligned or past the end of the ring");
+				return;
+			}
+
+			const char* pWrong = nullptr;
+			if (placement.grew)
+			{
+				++grows;
+				if (!huge || ring.capacity() < placement.size || !placement.discard || placement.base != 0)
+					pWrong = "the ring grew without a frame bigger than it, or not to a fresh buffer at 0";
+			}
+			else if (huge)
+			{
+				pWrong = "a frame bigger than the ring didn't grow it";
+			}
+			else if (frame && (head + placement.size > capacityBefore) != placement.discard)
+			{
+				pWrong = "a frame wrapped though it fitted after the last one, or didn't though it didn't fit";
+			}
+			else if (frame && !placement.discard && placement.base != head)
+			{
+				pWrong = "a frame that fitted wasn't placed straight after the last one";
+			}
+			if (pWrong)
+			{
+				fail(pCheck, pWrong);
+				return;
+			}
+			wraps += frame && placement.discard;	// a grow goes back to 0 too
+			head = placement.base + placement.size;
+
+			if (placement.discard)
+			{
+				generations.emplace_back(ring.capacity(), (u8)0xCD);
+			}
+			std::vector<u8>& buffer = generations.back();
+			memcpy(buffer.data() + placement.base, ring.staging(), placement.size);
+
+			uploaded.generation = (u32)generations.size() - 1;
+			for (const UploadAllocation& a : uploaded.allocations)
+			{
+				uploaded.offsets.push_back(ring.ring_offset(a));
+			}
+			frames.push_back(uploaded);
+		}
+
+		for (const UploadedFrame& frame : frames)
+		{
+			for (size_t i = 0; i < frame.values.size(); ++i)
+			{
+				u32 value;
+				memcpy(&value, generations[frame.generation].data() + frame.offsets[i], sizeof(value));
+				if (value != frame.values[i])
+				{
+					fail(pCheck, "a frame the GPU could still be reading was written over");
+					return;
+				}
+			}
+		}
+
+		if (ring.stats().wraps != wraps || ring.stats().grows != grows || wraps <= grows || grows != 1)
+			fail(pCheck, "the frames didn't wrap and grow once, or the stats don't count it");
+	}
+
+	//================================================================================
+	// G-buffer encoding
+	//================================================================================
+
+	void check_gbuffer_encoding()
+	{
+		const char* pCheck = "G-buffer encoding";
+
+		// 16 bit octahedral is good to ~0.004 degrees, 8 bit UNORM to half a step with round to nearest.
+		const f32 kMaxNormalDegrees = 0.01f;
+		const f32 kMaxAlbedoSteps = 0.5f;
+
+		const GBufferEncoding::RoundTripError error = GBufferEncoding::round_trip_error();
+		const f32 albedoSteps = error.albedoMax * 255.f;
+		printf("G-buffer encoding : normal error max %.5f / mean %.5f degrees, albedo max %.3f steps\n"
+			, error.normalMaxDegrees, error.normalMeanDegrees, albedoSteps);
+
+		if (!(error.normalMaxDegrees < kMaxNormalDegrees) || !(error.normalMeanDegrees <= error.normalMaxDegrees))
+			fail(pCheck, "octahedral normals lose more than 0.01 degrees");
+		if (!(albedoSteps <= kMaxAlbedoSteps + 1e-4f))
+			fail(pCheck, "albedo loses more than half an 8 bit step");
+
+		// Every 8 bit value comes back exactly.
+		for (u32 v = 0; v < 256; ++v)
+		{
+			const u32 texel = v | (v << 8) | (v << 16) | (v << 24);
+			if (GBufferEncoding::pack_albedo_spec(GBufferEncoding::unpack_albedo_spec(texel)) != texel)
+			{
+				fail(pCheck, "an 8 bit albedo value doesn't survive unpack / pack");
+				break;
+			}
+		}
+	}
+
+	//================================================================================
+	// Coverage
+	//================================================================================
+
+	bool every_texel_once(const f32* pNdcXY, u32 triangles, u32 width, u32 height)
+	{
+		std::vector<u8> counts;
+		const CoverageResult result = rasterise_coverage(pNdcXY, triangles, width, height, &counts);
+		return result.full() && !result.overdrawn && result.covered == width * height
+			&& std::all_of(counts.begin(), counts.end(), [](u8 c) { return c == 1; });
+	}
+
+	void check_coverage()
+	{
+		const char* pCheck = "coverage";
+
+		// Small and odd sizes where rounding goes wrong, up to past 1080p on both axes.
+		const RGCoverage quad = RGCoverage::FullScreenQuad();
+		const u32 kSizes[] = { 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 33, 63, 64, 127, 255, 333, 540, 541, 959, 960, 1079, 1080, 1081, 1279, 1919 };
+		for (u32 width : kSizes)
+		{
+			for (u32 height : kSizes)
+			{
+				if (height > 1081)
+					continue;
+				if (!every_texel_once(quad.pNdcXY, quad.triangles, width, height))
+				{
+					printf("  full screen quad at %ux%u\n", width, height);
+					fail(pCheck, "the full screen quad doesn't cover every texel exactly once");
+				}
+			}
+		}
+
+		// Triangle grids, each cell split on a random diagonal so both windings and every edge
+		// direction share edges. Odd grids jitter the inner vertices, even ones are regular with an
+		// even cell count and a size of cells * (2m + 1) / 2 texels, which puts every other grid line
+		// and diagonal on texel centres for the top-left rule to settle.
+		Rng rng(0xC0DE);
+		for (u32 grid = 0; grid < 60; ++grid)
+		{
+			const bool jittered = grid & 1;
+			const u32 cells = jittered ? 2 + grid % 7 : 2 + 2 * (grid / 2 % 4);
+			std::vector<f32> xy((cells + 1) * (cells + 1) * 2);
+			for (u32 y = 0; y <= cells; ++y)
+			{
+				for (u32 x = 0; x <= cells; ++x)
+				{
+					const f32 jitter = jittered ? 0.3f / cells : 0.f;
+					f32* p = &xy[(y * (cells + 1) + x) * 2];
+					p[0] = -1.f + 2.f * x / cells + (x && x < cells ? ((rng.next() % 1000) / 1000.f - 0.5f) * jitter : 0.f);
+					p[1] = -1.f + 2.f * y / cells + (y && y < cells ? ((rng.next() % 1000) / 1000.f - 0.5f) * jitter : 0.f);
+				}
+			}
+
+			std::vector<f32> triangles;
+			// Starting each triangle at a random corner keeps its winding but moves every edge
+			// through all three edge slots.
+			auto triangle = [&](u32 ax, u32 ay, u32 bx, u32 by, u32 cx, u32 cy)
+			{
+				const u32 corners[3] = { ay * (cells + 1) + ax, by * (cells + 1) + bx, cy * (cells + 1) + cx };
+				const u32 first = rng.next() % 3;
+				for (u32 i = 0; i < 3; ++i)
+				{
+					triangles.push_back(xy[corners[(first + i) % 3] * 2]);
+					triangles.push_back(xy[corners[(first + i) % 3] * 2 + 1]);
+				}
+			};
+			for (u32 y = 0; y < cells; ++y)
+			{
+				for (u32 x = 0; x < cells; ++x)
+				{
+					if (rng.next() & 1)
+					{
+						triangle(x, y, x + 1, y, x + 1, y + 1);
+						triangle(x, y, x + 1, y + 1, x, y + 1);
+					}
+					else
+					{
+						triangle(x, y, x, y + 1, x + 1, y);
+						triangle(x + 1, y, x, y + 1, x + 1, y + 1);
+					}
+				}
+			}
+
+			const u32 width = jittered ? 37 + rng.next() % 100 : cells / 2 * (2 * (1 + rng.next() % 40) + 1);
+			const u32 height = jittered ? 23 + rng.next() % 100 : cells / 2 * (2 * (1 + rng.next() % 40) + 1);
+			if (!every_texel_once(triangles.data(), (u32)triangles.size() / 6, width, height))
+			{
+				printf("  %s grid %u, %u cells at %ux%u\n", jittered ? "jittered" : "regular", grid, cells, width, height);
+				fail(pCheck, "a triangle grid doesn't cover every texel exactly once");
+			}
+		}
+
+		// Left half of the screen. At an odd width the middle column's centre is on the quad's right
+		// edge, which the top-left rule leaves out, so that column goes to the right half. The top
+		// and bottom halves at an odd height do the same across a horizontal edge.
+		static const f32 kLeftHalf[] = { -1.f, -1.f, 0.f, -1.f, 0.f, 1.f, -1.f, -1.f, 0.f, 1.f, -1.f, 1.f };
+		static const f32 kBothHalves[] = {
+			-1.f, -1.f, 0.f, -1.f, 0.f, 1.f, -1.f, -1.f, 0.f, 1.f, -1.f, 1.f,
+			0.f, -1.f, 1.f, -1.f, 1.f, 1.f, 0.f, -1.f, 1.f, 1.f, 0.f, 1.f,
+		};
+		static const f32 kTopAndBottom[] = {
+			-1.f, -1.f, 1.f, -1.f, 1.f, 0.f, -1.f, -1.f, 1.f, 0.f, -1.f, 0.f,
+			-1.f, 0.f, 1.f, 0.f, 1.f, 1.f, -1.f, 0.f, 1.f, 1.f, -1.f, 1.f,
+		};
+		for (u32 width : { 64u, 63u })
+		{
+			const CoverageResult half = rasterise_coverage(kLeftHalf, 2, width, 32);
+			if (half.full() || half.covered != width / 2 * 32 || half.uncovered != (width - width / 2) * 32
+				|| half.firstUncoveredX != width / 2 || half.firstUncoveredY != 0)
+				fail(pCheck, "a half screen quad isn't reported uncovered from the middle column");
+			if (!every_texel_once(kBothHalves, 4, width, 32) || !every_texel_once(kTopAndBottom, 4, 32, width))
+				fail(pCheck, "the two halves of the screen don't cover every texel exactly once");
+		}
+	}
+
+	// Load op of each colour target, per pass name.
+	class LoadOpBackend : public RenderGraphBackend
+	{
+	public:
+		void* acquire_transient(u32 index, const RGTextureDesc&) override { return (void*)(uintptr_t)(index + 1); }
+		void begin_pass(const RGPassInfo& pass) override
+		{
+			for (const RGBinding& target : pass.colourTargets)
+			{
+				m_loads.push_back({ pass.pName, target.load });
+			}
+		}
+		void end_pass(const RGPassInfo&) override {}
+
+		RGLoadOp load(const char* pPass) const
+		{
+			for (const auto& l : m_loads)
+			{
+				if (!strcmp(l.first, pPass))
+					return l.second;
+			}
+			return RGLoadOp::kLoad;
+		}
+
+		std::vector<std::pair<const char*, RGLoadOp>> m_loads;
+	};
+
+	void check_graph_clear_skipping()
+	{
+		const char* pCheck = "render graph clear skipping";
+		static const f32 kLeftHalf[] = { -1.f, -1.f, 0.f, -1.f, 0.f, 1.f, -1.f, -1.f, 0.f, 1.f, -1.f, 1.f };
+		const RGTextureDesc desc = RGTextureDesc::Create(960, 540, RGFormat::kR8_UNORM);
+
+		RenderGraph graph;
+		for (u32 frame = 0; frame < 2; ++frame)
+		{
+			// The second frame validates, the cached coverage has to give the same load ops.
+			const bool validate = frame == 1;
+			graph.reset();
+			graph.set_coverage_validation(validate);
+
+			const RGResource ao = graph.create_texture("AO", desc);
+			const RGResource blurred = graph.create_texture("Blurred", desc);
+			const RGResource half = graph.create_texture("Half", desc);
+			const RGResource out = graph.import_texture("Out", desc, nullptr);
+
+			graph.add_pass("Uncovered", [&](RGPassBuilder& b) { b.write(ao); }, kNoExecute);
+			graph.add_pass("Full Screen", [&](RGPassBuilder& b) { b.read(ao, 0); b.write(blurred); b.cover(RGCoverage::FullScreenQuad()); }, kNoExecute);
+			graph.add_pass("Half Screen", [&](RGPassBuilder& b) { b.read(blurred, 0); b.write(half); b.cover(RGCoverage{ kLeftHalf, 2 }); }, kNoExecute);
+			graph.add_pass("Dont Care", [&](RGPassBuilder& b) { b.read(half, 0); b.write(out, 0, RGLoadOp::kDontCare); }, kNoExecute);
+
+			if (!graph.compile())
+			{
+				fail(pCheck, "compile() failed");
+				return;
+			}
+
+			LoadOpBackend backend;
+			graph.execute(backend);
+			if (backend.load("Uncovered") != RGLoadOp::kClear || backend.load("Half Screen") != RGLoadOp::kClear)
+				fail(pCheck, "a clear was skipped on a target nothing declares full coverage of");
+			if (backend.load("Full Screen") != RGLoadOp::kDontCare || graph.stats().skippedClears != 1)
+				fail(pCheck, "the fully covered clear wasn't the one skipped");
+
+			if (!validate)
+			{
+				if (!graph.coverage_reports().empty())
+					fail(pCheck, "coverage reports without validation on");
+				continue;
+			}
+
+			// Validation reports the full and half coverages and the kDontCare target with nothing behind it.
+			const std::vector<RGCoverageReport>& reports = graph.coverage_reports();
+			auto report = [&](RGResource resource) -> const RGCoverageReport*
+			{
+				auto it = std::find_if(reports.begin(), reports.end(), [&](const RGCoverageReport& r) { return r.resource == resource.index; });
+				return it != reports.end() ? &*it : nullptr;
+			};
+			const RGCoverageReport* pFull = report(blurred);
+			const RGCoverageReport* pHalf = report(half);
+			const RGCoverageReport* pDontCare = report(out);
+			if (reports.size() != 3 || !pFull || !pHalf || !pDontCare || report(ao))
+				fail(pCheck, "validation didn't report exactly the covered, half covered and kDontCare targets");
+			else
+			{
+				if (!pFull->declared || !pFull->coverage.full())
+					fail(pCheck, "validation didn't report the full screen quad as covering its target");
+				if (!pHalf->declared || pHalf->coverage.full() || pHalf->coverage.firstUncoveredX != 480 || pHalf->coverage.firstUncoveredY != 0)
+					fail(pCheck, "validation didn't report the half screen quad uncovered from x 480");
+				if (pDontCare->declared || pDontCare->coverage.uncovered != desc.width * desc.height || pDontCare->pass != graph.pass_index("Dont Care"))
+					fail(pCheck, "validation didn't report the kDontCare target without a declared coverage");
+			}
+		}
+	}
+
+	void check_graph_coverage_cache()
+	{
+		const char* pCheck = "render graph coverage cache";
+		static const f32 kFull[] = { -1.f, -1.f, 1.f, -1.f, 1.f, 1.f, -1.f, -1.f, 1.f, 1.f, -1.f, 1.f };
+		static const f32 kLeftHalf[] = { -1.f, -1.f, 0.f, -1.f, 0.f, 1.f, -1.f, -1.f, 0.f, 1.f, -1.f, 1.f };
+		const RGTextureDesc desc = RGTextureDesc::Create(320, 180, RGFormat::kR8_UNORM);
+
+		// One buffer rewritten every frame, like triangles a pass builds per frame in reused storage.
+		f32 vertices[12];
+		RenderGraph graph;
+		for (u32 frame = 0; frame < 6; ++frame)
+		{
+			const bool full = !(frame & 1);
+			memcpy(vertices, full ? kFull : kLeftHalf, sizeof(vertices));
+
+			graph.reset();
+			const RGResource target = graph.import_texture("Target", desc, nullptr);
+			graph.add_pass("Draw", [&](RGPassBuilder& b) { b.write(target); b.cover(RGCoverage{ vertices, 2 }); b.side_effect(); }, kNoExecute);
+			if (!graph.compile())
+			{
+				fail(pCheck, "compile() failed");
+				return;
+			}
+
+			LoadOpBackend backend;
+			graph.execute(backend);
+			const RGLoadOp expected = full ? RGLoadOp::kDontCare : RGLoadOp::kClear;
+			if (backend.load("Draw") != expected || graph.stats().skippedClears != (full ? 1u : 0u))
+			{
+				printf("  frame %u, %s screen\n", frame, full ? "full" : "half");
+				fail(pCheck, "the clear followed a cached coverage of vertices that have since changed");
+			}
+		}
+	}
+}
+
+int main()
+{
+	WorkerPool pool(4);
+
+	check_graph_order_and_culling();
+	check_graph_aliasing_and_barriers();
+	check_graph_failures();
+	check_pool_reuse();
+	check_pool_eviction();
+	check_draw_list();
+	check_command_buffers(pool);
+	check_upload_ring();
+	check_gbuffer_encoding();
+	check_coverage();
+	check_graph_clear_skipping();
+	check_graph_coverage_cache();
+
+	if (g_failures)
+	{
+		printf("%u checks FAILED\n", g_failures);
+		return 1;
+	}
+	printf("All checks passed\n");
+	return 0;
+}
@@ -0,0 +1,378 @@
+//================================================================================
+// HeadlessSSAO
+// Runs the SSAO frame (SSAO/SSAOFrame.h) on RenderBackendCPU: no window, no
+// GPU, only standard headers, so it builds and benchmarks on Linux render farm
+// nodes and in CI. The scene is procedural (a ground plane through the near
+// plane, a grid of boxes and spheres), lit by one directional light.
+//
+// Prints the average time of each pass over the frames, the render graph's
+// stats and the backend's per frame traffic. Writes the lit frame as a binary
+// PPM when given a path, and a trace of the timed frames (Trace.h) for
+// chrome://tracing or Perfetto when given a second one. A size or frame count
+// that isn't a positive whole number prints the usage and returns 1, --help
+// prints it and returns 0.
+//
+// usage : HeadlessSSAO [width] [height] [frames] [objects per side] [output.ppm or -] [trace.json]
+//================================================================================
+#include "SSAOFrame.h"
+#include "MemoryTracker.h"
+#include "RenderBackendCPU.h"
+#include "Trace.h"
+#include "WorkerPool.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	using hlsl::float3;
+	using hlsl::float4x4;
+	using SSAOFrame::Vertex;
+
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		f32 next01() { return (next() >> 8) * (1.0f / 16777216.0f); }
+	};
+
+	struct MeshData
+	{
+		std::vector<Vertex> vertices;
+		std::vector<u16> indices;
+	};
+
+	// Gauss-Jordan, the matrices here are all well conditioned.
+	float4x4 inverse(const float4x4& m)
+	{
+		f64 a[4][8];
+		for (u32 i = 0; i < 4; ++i)
+		{
+			for (u32 j = 0; j < 4; ++j)
+			{
+				a[i][j] = m.m[i][j];
+				a[i][j + 4] = i == j ? 1.0 : 0.0;
+			}
+		}
+		for (u32 col = 0; col < 4; ++col)
+		{
+			u32 pivot = col;
+			for (u32 row = col + 1; row < 4; ++row)
+			{
+				if (std::fabs(a[row][col]) > std::fabs(a[pivot][col]))
+					pivot = row;
+			}
+			std::swap(a[col], a[pivot]);
+			const f64 scale = 1.0 / a[col][col];
+			for (u32 j = 0; j < 8; ++j)
+				a[col][j] *= scale;
+			for (u32 row = 0; row < 4; ++row)
+			{
+				if (row == col)
+					continue;
+				const f64 factor = a[row][col];
+				for (u32 j = 0; j < 8; ++j)
+					a[row][j] -= factor * a[col][j];
+			}
+		}
+		float4x4 r;
+		for (u32 i = 0; i < 4; ++i)
+			for (u32 j = 0; j < 4; ++j)
+				r.m[i][j] = (f32)a[i][j + 4];
+		return r;
+	}
+
+	float4x4 translation_scale(const float3& t, f32 s)
+	{
+		float4x4 r = float4x4::identity();
+		r.m[0][0] = r.m[1][1] = r.m[2][2] = s;
+		r.m[3][0] = t.x;
+		r.m[3][1] = t.y;
+		r.m[3][2] = t.z;
+		return r;
+	}
+
+	// Left handed like DirectX::SimpleMath's camera, row vectors.
+	float4x4 look_at(const float3& eye, const float3& target)
+	{
+		const float3 z = hlsl::normalize(target - eye);
+		const float3 x = hlsl::normalize(hlsl::cross(float3(0.f, 1.f, 0.f), z));
+		const float3 y = hlsl::cross(z, x);
+		float4x4 r = float4x4::identity();
+		r.m[0][0] = x.x; r.m[1][0] = x.y; r.m[2][0] = x.z;
+		r.m[0][1] = y.x; r.m[1][1] = y.y; r.m[2][1] = y.z;
+		r.m[0][2] = z.x; r.m[1][2] = z.y; r.m[2][2] = z.z;
+		r.m[3][0] = -hlsl::dot(x, eye);
+		r.m[3][1] = -hlsl::dot(y, eye);
+		r.m[3][2] = -hlsl::dot(z, eye);
+		return r;
+	}
+
+	float4x4 perspective(f32 fovY, f32 aspect, f32 nearZ, f32 farZ)
+	{
+		const f32 yScale = 1.f / std::tan(fovY * 0.5f);
+		float4x4 r = {};
+		r.m[0][0] = yScale / aspect;
+		r.m[1][1] = yScale;
+		r.m[2][2] = farZ / (farZ - nearZ);
+		r.m[2][3] = 1.f;
+		r.m[3][2] = -nearZ * farZ / (farZ - nearZ);
+		return r;
+	}
+
+	MeshData make_plane(f32 halfSize)
+	{
+		MeshData mesh;
+		const float3 up(0.f, 1.f, 0.f);
+		mesh.vertices = { { float3(-halfSize, 0.f, -halfSize), up }, { float3(halfSize, 0.f, -halfSize), up }
+			, { float3(halfSize, 0.f, halfSize), up }, { float3(-halfSize, 0.f, halfSize), up } };
+		mesh.indices = { 0, 1, 2, 0, 2, 3 };
+		return mesh;
+	}
+
+	// Unit cube, flat faces.
+	MeshData make_box()
+	{
+		MeshData mesh;
+		const float3 normals[] = { float3(1.f, 0.f, 0.f), float3(-1.f, 0.f, 0.f), float3(0.f, 1.f, 0.f)
+			, float3(0.f, -1.f, 0.f), float3(0.f, 0.f, 1.f), float3(0.f, 0.f, -1.f) };
+		for (const float3& n : normals)
+		{
+			const float3 u = std::fabs(n.y) > 0.5f ? float3(1.f, 0.f, 0.f) : float3(0.f, 1.f, 0.f);
+			const float3 v = hlsl::cross(n, u);
+			const u16 first = (u16)mesh.vertices.size();
+			mesh.vertices.push_back({ (n - u - v) * 0.5f, n });
+			mesh.vertices.push_back({ (n + u - v) * 0.5f, n });
+			mesh.vertices.push_back({ (n + u + v) * 0.5f, n });
+			mesh.vertices.push_back({ (n - u + v) * 0.5f, n });
+			const u16 quad[] = { first, (u16)(first + 1), (u16)(first + 2), first, (u16)(first + 2), (u16)(first + 3) };
+			mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+		}
+		return mesh;
+	}
+
+	// Unit radius UV sphere, smooth normals.
+	MeshData make_sphere(u32 slices, u32 stacks)
+	{
+		MeshData mesh;
+		for (u32 stack = 0; stack <= stacks; ++stack)
+		{
+			const f32 phi = 3.14159265f * stack / stacks;
+			for (u32 slice = 0; slice <= slices; ++slice)
+			{
+				const f32 theta = 2.f * 3.14159265f * slice / slices;
+				const float3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+				mesh.vertices.push_back({ n, n });
+			}
+		}
+		for (u32 stack = 0; stack < stacks; ++stack)
+		{
+			for (u32 slice = 0; slice < slices; ++slice)
+			{
+				const u16 a = (u16)(stack * (slices + 1) + slice);
+				const u16 b = (u16)(a + slices + 1);
+				const u16 quad[] = { a, b, (u16)(a + 1), (u16)(a + 1), b, (u16)(b + 1) };
+				mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+			}
+		}
+		return mesh;
+	}
+
+	u32 add_mesh(SSAOFrame::Renderer& renderer, const MeshData& mesh)
+	{
+		return renderer.add_mesh(mesh.vertices.data(), (u32)mesh.vertices.size(), mesh.indices.data(), (u32)mesh.indices.size());
+	}
+
+	// RGBA8 texels to a binary PPM, alpha dropped.
+	bool write_ppm(const char* pPath, const std::vector<u8>& texels, u32 width, u32 height)
+	{
+		FILE* pFile = fopen(pPath, "wb");
+		if (!pFile)
+			return false;
+
+		fprintf(pFile, "P6\n%u %u\n255\n", width, height);
+		std::vector<u8> row(width * 3);
+		for (u32 y = 0; y < height; ++y)
+		{
+			for (u32 x = 0; x < width; ++x)
+			{
+				for (u32 c = 0; c < 3; ++c)
+				{
+					row[x * 3 + c] = texels[((size_t)y * width + x) * 4 + c];
+				}
+			}
+			fwrite(row.data(), 1, row.size(), pFile);
+		}
+		fclose(pFile);
+		return true;
+	}
+
+	// Whole decimal number in [minimum, maximum] and nothing after it, the default when absent.
+	bool parse_u32(int argc, char** argv, int arg, u32 minimum, u32 maximum, u32 fallback, u32* pOut)
+	{
+		if (arg >= argc)
+		{
+			*pOut = fallback;
+			return true;
+		}
+
+		const char* pText = argv[arg];
+		char* pEnd = nullptr;
+		errno = 0;
+		const long long value = strtoll(pText, &pEnd, 10);
+		if (pEnd == pText || *pEnd || errno || value < minimum || value > maximum)
+		{
+			printf("Bad argument %d '%s', expected a whole number from %u to %u\n", arg, pText, minimum, maximum);
+			return false;
+		}
+		*pOut = (u32)value;
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	static const char* kUsage = "usage : HeadlessSSAO [width] [height] [frames] [objects per side] [output.ppm or -] [trace.json]\n";
+	if (argc > 1 && (!strcmp(argv[1], "--help") || !strcmp(argv[1], "-h") || !strcmp(argv[1], "/?")))
+	{
+		printf("%s", kUsage);
+		return 0;
+	}
+
+	u32 width, height, frames, objectsPerSide;
+	if (!parse_u32(argc, argv, 1, 1, 16384, 1280, &width)
+		|| !parse_u32(argc, argv, 2, 1, 16384, 720, &height)
+		|| !parse_u32(argc, argv, 3, 1, 100000, 10, &frames)
+		|| !parse_u32(argc, argv, 4, 0, 1000, 24, &objectsPerSide))
+	{
+		printf("%s", kUsage);
+		return 1;
+	}
+	const char* pOutputPath = argc > 5 && strcmp(argv[5], "-") ? argv[5] : nullptr;
+	const char* pTracePath = argc > 6 ? argv[6] : nullptr;
+
+	WorkerPool pool;
+	RenderBackendCPU backend(&pool);
+	SSAOFrame::add_cpu_pipelines(backend);
+
+	SSAOFrame::Renderer renderer(backend);
+	const u32 plane = add_mesh(renderer, make_plane(200.f));
+	const u32 box = add_mesh(renderer, make_box());
+	const u32 sphere = add_mesh(renderer, make_sphere(32, 16));
+
+	renderer.add_instance(plane, float4x4::identity());
+	Rng rng(0xB0C5);
+	for (u32 z = 0; z < objectsPerSide; ++z)
+	{
+		for (u32 x = 0; x < objectsPerSide; ++x)
+		{
+			const f32 size = 0.4f + rng.next01() * 0.6f;
+			const float3 position((x - objectsPerSide * 0.5f) * 1.5f, size * 0.5f, z * 1.5f);
+			const bool isSphere = ((x + z) & 1) != 0;
+			renderer.add_instance(isSphere ? sphere : box, translation_scale(position, isSphere ? size * 0.5f : size));
+		}
+	}
+
+	SSAOFrame::Camera camera;
+	camera.matView = look_at(float3(0.f, 3.f, -6.f), float3(0.f, 0.f, 10.f));
+	camera.matProjection = perspective(0.9f, (f32)width / height, 0.1f, 500.f);
+	camera.matInverseView = inverse(camera.matView);
+	camera.matInverseProjection = inverse(camera.matProjection);
+
+	SSAOFrame::Settings settings;
+	settings.width = width;
+	settings.height = height;
+	settings.lightDirection = float3(0.4f, 1.f, -0.3f);
+
+	// One frame to create the targets and grow the scratch, the rest are steady state.
+	renderer.render(camera, settings);
+
+	std::vector<f64> passMs(renderer.timings().size(), 0.0);
+	backend.reset_stats();
+	if (pTracePath)
+	{
+		TRACE_THREAD_NAME("Main");
+		Trace::start();
+	}
+
+	f64 frameMs = 0.0;
+	u64 heapAllocations = 0;
+	for (u32 frame = 0; frame < frames; ++frame)
+	{
+		TRACE_SCOPE("Frame");
+		const u64 heapStart = MemoryTracker::heap_allocations();
+		const auto start = std::chrono::high_resolution_clock::now();
+		renderer.render(camera, settings);
+		frameMs += std::chrono::duration<f64, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		heapAllocations += MemoryTracker::heap_allocations() - heapStart;
+
+		const std::vector<SSAOFrame::PassTiming>& timings = renderer.timings();
+		for (u32 i = 0; i < timings.size() && i < passMs.size(); ++i)
+		{
+			passMs[i] += timings[i].milliseconds;
+		}
+	}
+
+	Trace::stop();
+
+	printf("%ux%u, %u frames, %s backend, %u threads\n", width, height, frames, backend.name(), pool.threads());
+	for (u32 i = 0; i < passMs.size(); ++i)
+	{
+		printf("  %-12s : %8.3f ms\n", renderer.timings()[i].pName, passMs[i] / frames);
+	}
+	printf("  %-12s : %8.3f ms\n", "Frame", frameMs / frames);
+	printf("Heap allocations per frame : %.1f\n", heapAllocations / (f64)frames);
+
+	const RGStats& graphStats = renderer.graph().stats();
+	printf("Graph : %u passes, %u transients on %u textures (%.1f of %.1f MB), %u clears skipped\n"
+		, graphStats.passes, graphStats.transients, graphStats.physicalTransients
+		, graphStats.physicalBytes / (f64)MB, graphStats.transientBytes / (f64)MB, graphStats.skippedClears);
+
+	const RBStats& stats = backend.stats();
+	printf("Backend per frame : %u draws, %u dispatches, %u pipeline binds, %u resource binds, %u clears, %.1f KB uploaded\n"
+		, stats.draws / frames, stats.dispatches / frames, stats.pipelineBinds / frames, stats.resourceBinds / frames
+		, stats.clears / frames, stats.uploadedBytes / (f64)frames / KB);
+
+	// Something was lit: the frame can't be a single colour.
+	std::vector<u8> texels((size_t)backend.texture_key(renderer.output()).size_bytes());
+	backend.read_texture(renderer.output(), texels.data());
+	u32 distinct = 0;
+	for (size_t i = 4; i < texels.size() && distinct < 2; i += 4)
+	{
+		distinct += memcmp(&texels[i], &texels[0], 3) != 0 ? 1 : 0;
+	}
+	if (!distinct)
+	{
+		printf("FAILED the lit frame is a single colour\n");
+		return 1;
+	}
+
+	if (pOutputPath)
+	{
+		if (!write_ppm(pOutputPath, texels, width, height))
+		{
+			printf("FAILED to write %s\n", pOutputPath);
+			return 1;
+		}
+		printf("Wrote %s\n", pOutputPath);
+	}
+
+	if (pTracePath)
+	{
+		const Trace::Stats traceStats = Trace::stats();
+		if (!Trace::write_json(pTracePath))
+		{
+			printf("FAILED to write %s\n", pTracePath);
+			return 1;
+		}
+		printf("Wrote %s : %llu events on %u threads, %llu dropped\n", pTracePath, (unsigned long long)traceStats.events, traceStats.threads
+			, (unsigned long long)traceStats.dropped);
+	}
+	return 0;
+}
@@ -0,0 +1,363 @@
+//================================================================================
+// ImageCompare
+// Scores AO outputs against references with ImageMetrics (PSNR, SSIM, FLIP),
+// so every configuration of a benchmark run gets a quality number to go with
+// its frame time in Analysis/datalog.csv.
+//
+// The reference is a file, for one ray traced image every output is compared
+// with, or a directory holding a reference of the same name per output. Reads
+// binary PGM (8 or 16 bit), PPM (Rec. 709 luminance) and PFM, as linear
+// intensity. Writes one CSV row per output, and each FLIP error map as a PGM
+// when given a directory for them.
+//
+// usage : ImageCompare <reference file or dir> <output dir> [pixels per degree] [scores.csv] [map dir]
+//================================================================================
+#include "ImageMetrics.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <dirent.h>
+	#include <sys/stat.h>
+#endif
+
+namespace
+{
+	struct Image
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<f32> texels;
+	};
+
+	bool is_directory(const std::string& path)
+	{
+#ifdef _WIN32
+		const DWORD attributes = GetFileAttributesA(path.c_str());
+		return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+		struct stat info;
+		return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+	}
+
+	bool has_image_extension(const std::string& name)
+	{
+		const size_t dot = name.find_last_of('.');
+		if (dot == std::string::npos)
+			return false;
+
+		std::string extension = name.substr(dot + 1);
+		for (char& c : extension)
+		{
+			c = (char)tolower(c);
+		}
+		return extension == "pgm" || extension == "ppm" || extension == "pfm";
+	}
+
+	// Image file names in dir, sorted.
+	std::vector<std::string> list_images(const std::string& dir)
+	{
+		std::vector<std::string> names;
+#ifdef _WIN32
+		WIN32_FIND_DATAA data;
+		const HANDLE hFind = FindFirstFileA((dir + "\\*").c_str(), &data);
+		if (hFind != INVALID_HANDLE_VALUE)
+		{
+			do
+			{
+				if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && has_image_extension(data.cFileName))
+					names.push_back(data.cFileName);
+			} while (FindNextFileA(hFind, &data));
+			FindClose(hFind);
+		}
+#else
+		if (DIR* pDir = opendir(dir.c_str()))
+		{
+			while (const dirent* pEntry = readdir(pDir))
+			{
+				if (has_image_extension(pEntry->d_name) && !is_directory(dir + "/" + pEntry->d_name))
+					names.push_back(pEntry->d_name);
+			}
+			closedir(pDir);
+		}
+#endif
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	// Header token, skipping whitespace and # comments.
+	bool read_token(FILE* pFile, char* pToken, u32 size)
+	{
+		int c = fgetc(pFile);
+		while (c == '#' || isspace(c))
+		{
+			if (c == '#')
+			{
+				while (c != '\n' && c != EOF)
+					c = fgetc(pFile);
+			}
+			c = fgetc(pFile);
+		}
+
+		u32 length = 0;
+		while (c != EOF && !isspace(c) && length + 1 < size)
+		{
+			pToken[length++] = (char)c;
+			c = fgetc(pFile);
+		}
+		pToken[length] = '\0';
+		return length > 0;
+	}
+
+	bool read_pnm(FILE* pFile, bool colour, Image& image)
+	{
+		char token[32];
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		image.width = (u32)atoi(token);
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		image.height = (u32)atoi(token);
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		const u32 maxValue = (u32)atoi(token);
+		if (!image.width || !image.height || !maxValue || maxValue > 65535)
+			return false;
+
+		const u32 channels = colour ? 3 : 1;
+		const u32 bytesPerValue = maxValue > 255 ? 2 : 1;
+		std::vector<u8> raw((size_t)image.width * image.height * channels * bytesPerValue);
+		if (fread(raw.data(), 1, raw.size(), pFile) != raw.size())
+			return false;
+
+		const f32 scale = 1.f / maxValue;
+		const f32 weights[3] = { 0.2126f, 0.7152f, 0.0722f };
+		image.texels.resize((size_t)image.width * image.height);
+		for (size_t i = 0; i < image.texels.size(); ++i)
+		{
+			f32 value = 0.f;
+			for (u32 c = 0; c < channels; ++c)
+			{
+				const u8* p = &raw[(i * channels + c) * bytesPerValue];
+				const u32 v = bytesPerValue == 2 ? (u32)(p[0] << 8 | p[1]) : p[0];
+				value += (colour ? weights[c] : 1.f) * v * scale;
+			}
+			image.texels[i] = value;
+		}
+		return true;
+	}
+
+	// Rows are stored bottom up, a negative scale means little endian.
+	bool read_pfm(FILE* pFile, bool colour, Image& image)
+	{
+		char token[32];
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		image.width = (u32)atoi(token);
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		image.height = (u32)atoi(token);
+		if (!read_token(pFile, token, sizeof(token)))
+			return false;
+		const bool littleEndian = atof(token) < 0.0;
+		if (!image.width || !image.height)
+			return false;
+
+		const u32 channels = colour ? 3 : 1;
+		std::vector<u8> raw((size_t)image.width * image.height * channels * sizeof(f32));
+		if (fread(raw.data(), 1, raw.size(), pFile) != raw.size())
+			return false;
+
+		const u16 probe = 1;
+		const bool swap = littleEndian != (*(const u8*)&probe == 1);
+		const f32 weights[3] = { 0.2126f, 0.7152f, 0.0722f };
+		image.texels.resize((size_t)image.width * image.height);
+		for (u32 y = 0; y < image.height; ++y)
+		{
+			for (u32 x = 0; x < image.width; ++x)
+			{
+				f32 value = 0.f;
+				for (u32 c = 0; c < channels; ++c)
+				{
+					u8* p = &raw[(((size_t)y * image.width + x) * channels + c) * sizeof(f32)];
+					if (swap)
+					{
+						std::swap(p[0], p[3]);
+						std::swap(p[1], p[2]);
+					}
+					f32 v;
+					memcpy(&v, p, sizeof(v));
+					value += (colour ? weights[c] : 1.f) * v;
+				}
+				image.texels[(size_t)(image.height - 1 - y) * image.width + x] = value;
+			}
+		}
+		return true;
+	}
+
+	bool read_image(const std::string& path, Image& image)
+	{
+		FILE* pFile = fopen(path.c_str(), "rb");
+		if (!pFile)
+			return false;
+
+		char magic[3] = {};
+		bool ok = fread(magic, 1, 2, pFile) == 2;
+		if (ok && magic[0] == 'P' && (magic[1] == '5' || magic[1] == '6'))
+		{
+			ok = read_pnm(pFile, magic[1] == '6', image);
+		}
+		else if (ok && magic[0] == 'P' && (magic[1] == 'f' || magic[1] == 'F'))
+		{
+			// Exactly one whitespace byte follows the header, read_token() ate it.
+			ok = read_pfm(pFile, magic[1] == 'F', image);
+		}
+		else
+		{
+			ok = false;
+		}
+		fclose(pFile);
+		return ok;
+	}
+
+	bool write_pgm(const std::string& path, const std::vector<f32>& texels, u32 width, u32 height)
+	{
+		FILE* pFile = fopen(path.c_str(), "wb");
+		if (!pFile)
+			return false;
+
+		fprintf(pFile, "P5\n%u %u\n255\n", width, height);
+		std::vector<u8> bytes(texels.size());
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			bytes[i] = (u8)(std::min(std::max(texels[i], 0.f), 1.f) * 255.f + 0.5f);
+		}
+		const bool ok = fwrite(bytes.data(), 1, bytes.size(), pFile) == bytes.size();
+		fclose(pFile);
+		return ok;
+	}
+
+	std::string stem(const std::string& name)
+	{
+		const size_t dot = name.find_last_of('.');
+		return dot == std::string::npos ? name : name.substr(0, dot);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("usage : ImageCompare <reference file or dir> <output dir> [pixels per degree] [scores.csv] [map dir]\n");
+		return 1;
+	}
+
+	const std::string referencePath = argv[1];
+	const std::string outputDir = argv[2];
+	ImageMetrics::Params params;
+	if (argc > 3)
+	{
+		params.pixelsPerDegree = (f32)atof(argv[3]);
+	}
+	const char* pCsvPath = argc > 4 ? argv[4] : nullptr;
+	const char* pMapDir = argc > 5 ? argv[5] : nullptr;
+
+	const bool referencePerOutput = is_directory(referencePath);
+	Image sharedReference;
+	if (!referencePerOutput && !read_image(referencePath, sharedReference))
+	{
+		printf("FAILED to read the reference %s\n", referencePath.c_str());
+		return 1;
+	}
+
+	const std::vector<std::string> names = list_images(outputDir);
+	if (names.empty())
+	{
+		printf("FAILED no .pgm / .ppm / .pfm images in %s\n", outputDir.c_str());
+		return 1;
+	}
+
+	FILE* pCsv = nullptr;
+	if (pCsvPath)
+	{
+		pCsv = fopen(pCsvPath, "w");
+		if (!pCsv)
+		{
+			printf("FAILED to write %s\n", pCsvPath);
+			return 1;
+		}
+		fprintf(pCsv, "Image, Width, Height, MSE, PSNR (dB), SSIM, FLIP mean, FLIP max\n");
+	}
+
+	WorkerPool pool;
+	printf("%u images, %.1f pixels per degree, %s, %u threads\n", (u32)names.size(), params.pixelsPerDegree, ImageMetrics::isa(), pool.threads());
+
+	u32 failures = 0;
+	for (const std::string& name : names)
+	{
+		Image output;
+		Image ownReference;
+		const Image* pReference = &sharedReference;
+		if (!read_image(outputDir + "/" + name, output))
+		{
+			printf("  %-32s : FAILED to read\n", name.c_str());
+			++failures;
+			continue;
+		}
+		if (referencePerOutput)
+		{
+			if (!read_image(referencePath + "/" + name, ownReference))
+			{
+				printf("  %-32s : FAILED no reference of the same name\n", name.c_str());
+				++failures;
+				continue;
+			}
+			pReference = &ownReference;
+		}
+		if (pReference->width != output.width || pReference->height != output.height)
+		{
+			printf("  %-32s : FAILED %ux%u against a %ux%u reference\n", name.c_str(), output.width, output.height, pReference->width, pReference->height);
+			++failures;
+			continue;
+		}
+
+		ImageMetrics::Maps maps;
+		const auto start = std::chrono::high_resolution_clock::now();
+		const ImageMetrics::Scores scores = ImageMetrics::compare(pReference->texels.data(), output.texels.data(), output.width, output.height
+			, params, pMapDir ? &maps : nullptr, &pool);
+		const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		printf("  %-32s : PSNR %6.2f dB, SSIM %.4f, FLIP %.4f (max %.3f)  %8.3f ms\n", name.c_str(), scores.psnr, scores.ssim, scores.flip, scores.flipMax, ms);
+		if (pCsv)
+		{
+			fprintf(pCsv, "%s, %u, %u, %.9f, %.3f, %.5f, %.5f, %.5f\n", name.c_str(), output.width, output.height
+				, scores.mse, scores.psnr, scores.ssim, scores.flip, scores.flipMax);
+		}
+		if (pMapDir && !write_pgm(std::string(pMapDir) + "/" + stem(name) + "_flip.pgm", maps.flip, output.width, output.height))
+		{
+			printf("FAILED to write the FLIP map of %s into %s\n", name.c_str(), pMapDir);
+			++failures;
+		}
+	}
+
+	if (pCsv)
+	{
+		fclose(pCsv);
+		printf("Wrote %s\n", pCsvPath);
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,415 @@
+//================================================================================
+// KernelGen
+// Offline generator for the SSAO sample kernels and noise tables.
+//
+// Writes the same tables twice, once as constexpr C++ and once as HLSL so the
+// shaders and the CPU references consume identical data:
+//   SSAO/SSAOKernels.h
+//   Assets/Shaders/SSAOKernels.hlsli
+//
+// Runs as a pre-build step of the SSAO project. Files are only rewritten when
+// their contents change so it doesn't trigger needless rebuilds.
+//
+// usage : KernelGen <repository root>
+//================================================================================
+#include "CoreTypes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	constexpr u32 kMaxTaps = 32;		// g_samples (max 8) * 4
+	constexpr u32 kNoiseTileSize = 64;
+	constexpr f32 kGoldenAngle = 2.4f;	// the shadertoy spiral's, rounded
+	constexpr f32 kBlueNoiseSigma = 1.5f;
+
+	// Small deterministic generator, std distributions aren't portable between STLs.
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		f32 next01() { return (next() >> 8) * (1.0f / 16777216.0f); }
+	};
+
+	//--------------------------------------------------------------------------------
+	// Blue noise, void-and-cluster (Ulichney 1993) on a toroidal tile.
+	// Produces a rank per texel, each rank appears once.
+	//--------------------------------------------------------------------------------
+	class VoidAndCluster
+	{
+	public:
+		explicit VoidAndCluster(u32 size)
+			: m_size(size)
+			, m_count(size * size)
+			, m_bits(size * size, 0)
+			, m_energy(size * size, 0.0f)
+			, m_kernel(size * size)
+		{
+			// Gaussian weights by wrapped offset.
+			for (u32 y = 0; y < size; ++y)
+			{
+				for (u32 x = 0; x < size; ++x)
+				{
+					const f32 dx = (f32)std::min(x, size - x);
+					const f32 dy = (f32)std::min(y, size - y);
+					m_kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0f * kBlueNoiseSigma * kBlueNoiseSigma));
+				}
+			}
+		}
+
+		std::vector<u32> generate(u32 seed)
+		{
+			std::vector<u32> ranks(m_count, 0);
+
+			// Initial binary pattern, ~10% random ones.
+			Rng rng(seed);
+			const u32 kInitialOnes = m_count / 10;
+			u32 ones = 0;
+			while (ones < kInitialOnes)
+			{
+				const u32 i = rng.next() % m_count;
+				if (!m_bits[i])
+				{
+					set(i, true);
+					++ones;
+				}
+			}
+
+			// Relax: move the tightest cluster into the largest void until it's stable.
+			for (u32 iteration = 0; iteration < m_count; ++iteration)
+			{
+				const u32 cluster = tightest_cluster();
+				set(cluster, false);
+				const u32 hole = largest_void();
+				set(hole, true);
+				if (hole == cluster)
+				{
+					break;
+				}
+			}
+
+			const std::vector<u8> prototype = m_bits;
+			const std::vector<f32> prototypeEnergy = m_energy;
+
+			// Phase 1 : rank the initial ones by removing clusters.
+			for (u32 rank = ones; rank-- > 0;)
+			{
+				const u32 cluster = tightest_cluster();
+				set(cluster, false);
+				ranks[cluster] = rank;
+			}
+
+			// Phase 2 + 3 : fill voids until the tile is full.
+			// (Phase 3's tightest cluster of zeros is the same texel as the largest void of ones.)
+			m_bits = prototype;
+			m_energy = prototypeEnergy;
+			for (u32 rank = ones; rank < m_count; ++rank)
+			{
+				const u32 hole = largest_void();
+				set(hole, true);
+				ranks[hole] = rank;
+			}
+
+			return ranks;
+		}
+
+	private:
+		void set(u32 index, bool value)
+		{
+			m_bits[index] = value ? 1 : 0;
+
+			const f32 sign = value ? 1.0f : -1.0f;
+			const u32 ix = index % m_size;
+			const u32 iy = index / m_size;
+			for (u32 y = 0; y < m_size; ++y)
+			{
+				const u32 ky = ((y + m_size - iy) % m_size) * m_size;
+				for (u32 x = 0; x < m_size; ++x)
+				{
+					m_energy[y * m_size + x] += sign * m_kernel[ky + (x + m_size - ix) % m_size];
+				}
+			}
+		}
+
+		u32 tightest_cluster() const
+		{
+			u32 best = 0;
+			f32 bestEnergy = -1.0f;
+			for (u32 i = 0; i < m_count; ++i)
+			{
+				if (m_bits[i] && m_energy[i] > bestEnergy)
+				{
+					bestEnergy = m_energy[i];
+					best = i;
+				}
+			}
+			return best;
+		}
+
+		u32 largest_void() const
+		{
+			u32 best = 0;
+			f32 bestEnergy = 1e30f;
+			for (u32 i = 0; i < m_count; ++i)
+			{
+				if (!m_bits[i] && m_energy[i] < bestEnergy)
+				{
+					bestEnergy = m_energy[i];
+					best = i;
+				}
+			}
+			return best;
+		}
+
+		u32 m_size;
+		u32 m_count;
+		std::vector<u8> m_bits;
+		std::vector<f32> m_energy;
+		std::vector<f32> m_kernel;
+	};
+
+	//--------------------------------------------------------------------------------
+	// Progressive poisson disk via Mitchell's best candidate.
+	// Kept in generation order so any prefix is itself well distributed, which
+	// is what adaptive sampling wants when it adds taps on top of a base pass.
+	//--------------------------------------------------------------------------------
+	std::vector<std::pair<f32, f32>> poisson_disk(u32 count, u32 seed)
+	{
+		constexpr u32 kCandidatesPerPoint = 32;
+
+		Rng rng(seed);
+		std::vector<std::pair<f32, f32>> points;
+
+		auto randomInDisk = [&rng]() {
+			for (;;)
+			{
+				const f32 x = rng.next01() * 2.0f - 1.0f;
+				const f32 y = rng.next01() * 2.0f - 1.0f;
+				if (x * x + y * y <= 1.0f)
+					return std::make_pair(x, y);
+			}
+		};
+
+		while (points.size() < count)
+		{
+			std::pair<f32, f32> best = randomInDisk();
+			f32 bestDistance = -1.0f;
+
+			for (u32 c = 0; c < kCandidatesPerPoint && !points.empty(); ++c)
+			{
+				const std::pair<f32, f32> candidate = randomInDisk();
+				f32 nearest = 1e30f;
+				for (const auto& p : points)
+				{
+					const f32 dx = p.first - candidate.first;
+					const f32 dy = p.second - candidate.second;
+					nearest = std::min(nearest, dx * dx + dy * dy);
+				}
+				if (nearest > bestDistance)
+				{
+					bestDistance = nearest;
+					best = candidate;
+				}
+			}
+
+			points.push_back(best);
+		}
+
+		return points;
+	}
+
+	f32 interleaved_gradient_noise(f32 x, f32 y)
+	{
+		auto frac = [](f32 v) { return v - std::floor(v); };
+		return frac(52.9829189f * frac(x * 0.06711056f + y * 4.0f * 0.00583715f));
+	}
+
+	u8 unorm8(f32 v)
+	{
+		return (u8)std::min(255.0f, std::max(0.0f, std::floor(v * 255.0f + 0.5f)));
+	}
+
+	//--------------------------------------------------------------------------------
+	// Output helpers
+	//--------------------------------------------------------------------------------
+	std::string fmt(f32 v)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%.9gf", v);
+		std::string s(buffer);
+		// HLSL and C++ both want a decimal point before the f suffix.
+		if (s.find_first_of(".e") == std::string::npos)
+		{
+			s.insert(s.size() - 1, ".0");
+		}
+		return s;
+	}
+
+	bool write_if_changed(const std::string& path, const std::string& contents)
+	{
+		{
+			std::ifstream existing(path, std::ios::binary);
+			if (existing.good())
+			{
+				std::stringstream ss;
+				ss << existing.rdbuf();
+				if (ss.str() == contents)
+				{
+					printf("KernelGen: %s is up to date\n", path.c_str());
+					return true;
+				}
+			}
+		}
+
+		std::ofstream out(path, std::ios::binary);
+		if (!out.good())
+		{
+			fprintf(stderr, "KernelGen: couldn't write %s\n", path.c_str());
+			return false;
+		}
+		out << contents;
+		printf("KernelGen: wrote %s\n", path.c_str());
+		return true;
+	}
+
+	struct Tables
+	{
+		std::vector<std::pair<f32, f32>> spiralDir;
+		std::vector<f32> vogelRadius;
+		std::vector<std::pair<f32, f32>> poisson;
+		std::vector<std::pair<f32, f32>> tileRotation4x4;
+		std::vector<u32> noiseTile;
+	};
+
+	Tables build_tables()
+	{
+		Tables t;
+
+		for (u32 i = 0; i < kMaxTaps; ++i)
+		{
+			const f32 theta = i * kGoldenAngle;
+			t.spiralDir.push_back(std::make_pair(std::cos(theta), std::sin(theta)));
+			t.vogelRadius.push_back(std::sqrt(i + 0.5f));
+		}
+
+		t.poisson = poisson_disk(kMaxTaps, 0x5eed1234u);
+
+		for (u32 y = 0; y < 4; ++y)
+		{
+			for (u32 x = 0; x < 4; ++x)
+			{
+				const f32 phase = kfTwoPI * interleaved_gradient_noise((f32)x, (f32)y);
+				t.tileRotation4x4.push_back(std::make_pair(std::cos(phase), std::sin(phase)));
+			}
+		}
+
+		// RGBA8 : r = blue noise, gb = unit rotation (cos, sin) of 2pi * r in [0,1], a = 1.
+		VoidAndCluster vac(kNoiseTileSize);
+		const std::vector<u32> ranks = vac.generate(0xb1e0a15eu);
+		const f32 kRankScale = 1.0f / (kNoiseTileSize * kNoiseTileSize);
+		for (u32 rank : ranks)
+		{
+			const f32 noise = (rank + 0.5f) * kRankScale;
+			const u8 r = unorm8(noise);
+			const u8 g = unorm8(std::cos(kfTwoPI * noise) * 0.5f + 0.5f);
+			const u8 b = unorm8(std::sin(kfTwoPI * noise) * 0.5f + 0.5f);
+			t.noiseTile.push_back((u32)r | ((u32)g << 8) | ((u32)b << 16) | (0xFFu << 24));
+		}
+
+		return t;
+	}
+
+	const char* kBanner =
+		"// GENERATED by Tools/KernelGen - do not edit.\n"
+		"// Regenerated as a pre-build step of the SSAO project.\n";
+
+	std::string emit_cpp(const Tables& t)
+	{
+		std::ostringstream o;
+		o << kBanner
+			<< "#pragma once\n\n"
+			<< "#include \"CoreTypes.h\"\n\n"
+			<< "namespace SSAOKernels\n{\n"
+			<< "\tconstexpr u32 kMaxTaps = " << kMaxTaps << ";\n"
+			<< "\tconstexpr u32 kNoiseTileSize = " << kNoiseTileSize << ";\n\n";
+
+		o << "\t// cos, sin of (i * golden angle).\n\tconstexpr f32 kGoldenSpiralDir[kMaxTaps][2] = {\n";
+		for (const auto& d : t.spiralDir) o << "\t\t{ " << fmt(d.first) << ", " << fmt(d.second) << " },\n";
+		o << "\t};\n\n";
+
+		o << "\t// sqrt(i + 0.5), scale by 1/sqrt(taps) for a vogel disk.\n\tconstexpr f32 kVogelRadius[kMaxTaps] = {\n";
+		for (f32 r : t.vogelRadius) o << "\t\t" << fmt(r) << ",\n";
+		o << "\t};\n\n";
+
+		o << "\t// Progressive poisson disk in the unit disk, any prefix is well distributed.\n\tconstexpr f32 kPoissonDisk[kMaxTaps][2] = {\n";
+		for (const auto& d : t.poisson) o << "\t\t{ " << fmt(d.first) << ", " << fmt(d.second) << " },\n";
+		o << "\t};\n\n";
+
+		o << "\t// cos, sin of 2pi * interleaved gradient noise over a 4x4 tile, index y * 4 + x.\n\tconstexpr f32 kTileRotation4x4[16][2] = {\n";
+		for (const auto& d : t.tileRotation4x4) o << "\t\t{ " << fmt(d.first) << ", " << fmt(d.second) << " },\n";
+		o << "\t};\n\n";
+
+		o << "\t// RGBA8 blue noise tile : r = noise, gb = (cos, sin) of 2pi * noise as unorm, a = 1.\n"
+			<< "\tconstexpr u32 kNoiseTileRGBA[kNoiseTileSize * kNoiseTileSize] = {\n";
+		for (u32 i = 0; i < t.noiseTile.size(); ++i)
+		{
+			if (i % 8 == 0) o << "\t\t";
+			char buffer[16];
+			snprintf(buffer, sizeof(buffer), "0x%08Xu,", t.noiseTile[i]);
+			o << buffer << (i % 8 == 7 ? "\n" : " ");
+		}
+		o << "\t};\n}\n";
+
+		return o.str();
+	}
+
+	std::string emit_hlsl(const Tables& t)
+	{
+		std::ostringstream o;
+		o << kBanner
+			<< "// C++ twin : SSAO/SSAOKernels.h\n\n"
+			<< "#define KERNEL_MAX_TAPS " << kMaxTaps << "\n"
+			<< "#define NOISE_TILE_SIZE " << kNoiseTileSize << "\n\n";
+
+		o << "// cos, sin of (i * golden angle).\nstatic const float2 kGoldenSpiralDir[KERNEL_MAX_TAPS] = {\n";
+		for (const auto& d : t.spiralDir) o << "\tfloat2(" << fmt(d.first) << ", " << fmt(d.second) << "),\n";
+		o << "};\n\n";
+
+		o << "// sqrt(i + 0.5), scale by 1/sqrt(taps) for a vogel disk.\nstatic const float kVogelRadius[KERNEL_MAX_TAPS] = {\n";
+		for (f32 r : t.vogelRadius) o << "\t" << fmt(r) << ",\n";
+		o << "};\n\n";
+
+		o << "// Progressive poisson disk in the unit disk, any prefix is well distributed.\nstatic const float2 kPoissonDisk[KERNEL_MAX_TAPS] = {\n";
+		for (const auto& d : t.poisson) o << "\tfloat2(" << fmt(d.first) << ", " << fmt(d.second) << "),\n";
+		o << "};\n\n";
+
+		o << "// cos, sin of 2pi * interleaved gradient noise over a 4x4 tile, index y * 4 + x.\nstatic const float2 kTileRotation4x4[16] = {\n";
+		for (const auto& d : t.tileRotation4x4) o << "\tfloat2(" << fmt(d.first) << ", " << fmt(d.second) << "),\n";
+		o << "};\n";
+
+		return o.str();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage : KernelGen <repository root>\n");
+		return 1;
+	}
+
+	const std::string root(argv[1]);
+	const Tables tables = build_tables();
+
+	bool ok = write_if_changed(root + "/SSAO/SSAOKernels.h", emit_cpp(tables));
+	ok &= write_if_changed(root + "/Assets/Shaders/SSAOKernels.hlsli", emit_hlsl(tables));
+
+	return ok ? 0 : 1;
+}
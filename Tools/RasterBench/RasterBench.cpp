@@ -0,0 +1,673 @@
+//================================================================================
+// RasterBench
+// CPU checks and timings for the software G-buffer rasterizer
+// (SSAO/SoftRasterizer.h), so the geometry -> AO -> blur chain can be profiled
+// on machines without a GPU.
+//
+// Checks that a jittered grid of triangles (mixed windings, edges through texel
+// centres) writes every texel exactly once and that the threaded rasterizer
+// gives the same bytes as the single threaded one. Then renders a procedural
+// scene (a ground plane through the near plane, a grid of boxes and smooth
+// spheres) and times the rasterizer single threaded and over a WorkerPool,
+// followed by the Vogel / Alchemy AO reference and the fused gaussian on the
+// result.
+//
+// Last the ray traced ground truth (SSAO/GroundTruthAO.h): checks the BVH's
+// hits against brute force and its 4 ray packets against single rays, times
+// the build and the rays, then reports how far the spiral and Vogel / Alchemy
+// references are from the ground truth at every tap count and at their
+// converged tap count, the estimator's bias (fails if the most taps aren't
+// closer than the fewest, or if Alchemy is further than the spiral).
+//
+// Then the distance field (Framework/DistanceField.h): jump flooding against
+// the exact bake on a small volume, threaded against single threaded, and the
+// distance field AO of the objects timed and compared with the ground truth,
+// also as PSNR / SSIM / FLIP (Framework/ImageMetrics.h) of the visibility.
+//
+// usage : RasterBench [width] [height] [iterations] [objects per side]
+//================================================================================
+#include "SoftRasterizer.h"
+#include "AOReference.h"
+#include "GroundTruthAO.h"
+#include "BVH.h"
+#include "DistanceField.h"
+#include "DistanceFieldAO.h"
+#include "ImageMetrics.h"
+#include "SSAOKernels.h"
+#include "SeparableBlur.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	using hlsl::float3;
+	using hlsl::float4x4;
+
+	struct Rng
+	{
+		u32 state;
+		explicit Rng(u32 seed) : state(seed) {}
+		u32 next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		f32 next01() { return (next() >> 8) * (1.0f / 16777216.0f); }
+	};
+
+	struct Vertex
+	{
+		float3 pos;
+		float3 normal;
+	};
+
+	struct MeshData
+	{
+		std::vector<Vertex> vertices;
+		std::vector<u16> indices;
+		SoftRaster::MeshView view;
+
+		// Points view at the arrays, once they are in their final place.
+		void finish()
+		{
+			view.pVertices = (const u8*)vertices.data();
+			view.vertexCount = (u32)vertices.size();
+			view.stride = sizeof(Vertex);
+			view.positionOffset = 0;
+			view.normalOffset = sizeof(float3);
+			view.pIndices = indices.data();
+			view.indexCount = (u32)indices.size();
+		}
+	};
+
+	float4x4 multiply(const float4x4& a, const float4x4& b)
+	{
+		float4x4 r = {};
+		for (u32 i = 0; i < 4; ++i)
+			for (u32 j = 0; j < 4; ++j)
+				for (u32 k = 0; k < 4; ++k)
+					r.m[i][j] += a.m[i][k] * b.m[k][j];
+		return r;
+	}
+
+	// Gauss-Jordan, the matrices here are all well conditioned.
+	float4x4 inverse(const float4x4& m)
+	{
+		f64 a[4][8];
+		for (u32 i = 0; i < 4; ++i)
+		{
+			for (u32 j = 0; j < 4; ++j)
+			{
+				a[i][j] = m.m[i][j];
+				a[i][j + 4] = i == j ? 1.0 : 0.0;
+			}
+		}
+		for (u32 col = 0; col < 4; ++col)
+		{
+			u32 pivot = col;
+			for (u32 row = col + 1; row < 4; ++row)
+			{
+				if (std::fabs(a[row][col]) > std::fabs(a[pivot][col]))
+					pivot = row;
+			}
+			std::swap(a[col], a[pivot]);
+			const f64 scale = 1.0 / a[col][col];
+			for (u32 j = 0; j < 8; ++j)
+				a[col][j] *= scale;
+			for (u32 row = 0; row < 4; ++row)
+			{
+				if (row == col)
+					continue;
+				const f64 factor = a[row][col];
+				for (u32 j = 0; j < 8; ++j)
+					a[row][j] -= factor * a[col][j];
+			}
+		}
+		float4x4 r;
+		for (u32 i = 0; i < 4; ++i)
+			for (u32 j = 0; j < 4; ++j)
+				r.m[i][j] = (f32)a[i][j + 4];
+		return r;
+	}
+
+	float4x4 translation_scale(const float3& t, f32 s)
+	{
+		float4x4 r = float4x4::identity();
+		r.m[0][0] = r.m[1][1] = r.m[2][2] = s;
+		r.m[3][0] = t.x;
+		r.m[3][1] = t.y;
+		r.m[3][2] = t.z;
+		return r;
+	}
+
+	// Left handed like DirectX::SimpleMath's camera, row vectors.
+	float4x4 look_at(const float3& eye, const float3& target)
+	{
+		const float3 z = hlsl::normalize(target - eye);
+		const float3 x = hlsl::normalize(hlsl::cross(float3(0.f, 1.f, 0.f), z));
+		const float3 y = hlsl::cross(z, x);
+		float4x4 r = float4x4::identity();
+		r.m[0][0] = x.x; r.m[1][0] = x.y; r.m[2][0] = x.z;
+		r.m[0][1] = y.x; r.m[1][1] = y.y; r.m[2][1] = y.z;
+		r.m[0][2] = z.x; r.m[1][2] = z.y; r.m[2][2] = z.z;
+		r.m[3][0] = -hlsl::dot(x, eye);
+		r.m[3][1] = -hlsl::dot(y, eye);
+		r.m[3][2] = -hlsl::dot(z, eye);
+		return r;
+	}
+
+	float4x4 perspective(f32 fovY, f32 aspect, f32 nearZ, f32 farZ)
+	{
+		const f32 yScale = 1.f / std::tan(fovY * 0.5f);
+		float4x4 r = {};
+		r.m[0][0] = yScale / aspect;
+		r.m[1][1] = yScale;
+		r.m[2][2] = farZ / (farZ - nearZ);
+		r.m[2][3] = 1.f;
+		r.m[3][2] = -nearZ * farZ / (farZ - nearZ);
+		return r;
+	}
+
+	MeshData make_plane(f32 halfSize)
+	{
+		MeshData mesh;
+		const float3 up(0.f, 1.f, 0.f);
+		mesh.vertices = { { float3(-halfSize, 0.f, -halfSize), up }, { float3(halfSize, 0.f, -halfSize), up }
+			, { float3(halfSize, 0.f, halfSize), up }, { float3(-halfSize, 0.f, halfSize), up } };
+		mesh.indices = { 0, 1, 2, 0, 2, 3 };
+		return mesh;
+	}
+
+	// Unit cube, flat faces.
+	MeshData make_box()
+	{
+		MeshData mesh;
+		const float3 normals[] = { float3(1.f, 0.f, 0.f), float3(-1.f, 0.f, 0.f), float3(0.f, 1.f, 0.f)
+			, float3(0.f, -1.f, 0.f), float3(0.f, 0.f, 1.f), float3(0.f, 0.f, -1.f) };
+		for (const float3& n : normals)
+		{
+			const float3 u = std::fabs(n.y) > 0.5f ? float3(1.f, 0.f, 0.f) : float3(0.f, 1.f, 0.f);
+			const float3 v = hlsl::cross(n, u);
+			const u16 first = (u16)mesh.vertices.size();
+			mesh.vertices.push_back({ (n - u - v) * 0.5f, n });
+			mesh.vertices.push_back({ (n + u - v) * 0.5f, n });
+			mesh.vertices.push_back({ (n + u + v) * 0.5f, n });
+			mesh.vertices.push_back({ (n - u + v) * 0.5f, n });
+			const u16 quad[] = { first, (u16)(first + 1), (u16)(first + 2), first, (u16)(first + 2), (u16)(first + 3) };
+			mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+		}
+		return mesh;
+	}
+
+	// Unit radius UV sphere, smooth normals so the normals go through the perspective correct path.
+	MeshData make_sphere(u32 slices, u32 stacks)
+	{
+		MeshData mesh;
+		for (u32 stack = 0; stack <= stacks; ++stack)
+		{
+			const f32 phi = 3.14159265f * stack / stacks;
+			for (u32 slice = 0; slice <= slices; ++slice)
+			{
+				const f32 theta = 2.f * 3.14159265f * slice / slices;
+				const float3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+				mesh.vertices.push_back({ n, n });
+			}
+		}
+		for (u32 stack = 0; stack < stacks; ++stack)
+		{
+			for (u32 slice = 0; slice < slices; ++slice)
+			{
+				const u16 a = (u16)(stack * (slices + 1) + slice);
+				const u16 b = (u16)(a + slices + 1);
+				const u16 quad[] = { a, b, (u16)(a + 1), (u16)(a + 1), b, (u16)(b + 1) };
+				mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+			}
+		}
+		return mesh;
+	}
+
+	struct Scene
+	{
+		MeshData plane;
+		MeshData box;
+		MeshData sphere;
+		std::vector<SoftRaster::Draw> draws;
+		float4x4 matView;
+		float4x4 matProjection;
+	};
+
+	// objectsPerSide^2 boxes and spheres on a plane that runs behind the camera.
+	void build_scene(Scene& scene, u32 width, u32 height, u32 objectsPerSide)
+	{
+		scene.plane = make_plane(200.f);
+		scene.box = make_box();
+		scene.sphere = make_sphere(32, 16);
+		scene.plane.finish();
+		scene.box.finish();
+		scene.sphere.finish();
+
+		scene.matView = look_at(float3(0.f, 3.f, -6.f), float3(0.f, 0.f, 10.f));
+		scene.matProjection = perspective(0.9f, (f32)width / height, 0.1f, 500.f);
+		const float4x4 matViewProjection = multiply(scene.matView, scene.matProjection);
+
+		auto add = [&](const MeshData& mesh, const float4x4& matModel)
+		{
+			SoftRaster::Draw draw;
+			draw.pMesh = &mesh.view;
+			draw.matModel = matModel;
+			draw.matMVP = multiply(matModel, matViewProjection);
+			scene.draws.push_back(draw);
+		};
+
+		add(scene.plane, float4x4::identity());
+		Rng rng(0xB0C5);
+		for (u32 z = 0; z < objectsPerSide; ++z)
+		{
+			for (u32 x = 0; x < objectsPerSide; ++x)
+			{
+				const f32 size = 0.4f + rng.next01() * 0.6f;
+				const float3 position((x - objectsPerSide * 0.5f) * 1.5f, size * 0.5f, z * 1.5f);
+				const bool sphere = ((x + z) & 1) != 0;
+				add(sphere ? scene.sphere : scene.box, translation_scale(position, sphere ? size * 0.5f : size));
+			}
+		}
+	}
+
+	template <typename Fn>
+	f64 time_ms(u32 iterations, const Fn& fn)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			fn();
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<f64, std::milli>(end - start).count();
+	}
+
+	// Shared edges, edges through texel centres and mixed windings must still write every texel once.
+	bool check_watertight(u32 width, u32 height, WorkerPool& pool)
+	{
+		bool ok = true;
+		for (u32 seed = 1; seed <= 4; ++seed)
+		{
+			Rng rng(seed * 7919);
+			const u32 cells = 17;
+			MeshData grid;
+			for (u32 y = 0; y <= cells; ++y)
+			{
+				for (u32 x = 0; x <= cells; ++x)
+				{
+					// Inner vertices jitter (little enough that every quad stays convex), odd seeds snap them
+					// to texel centres. The border overhangs the target.
+					f32 ndcX = -1.f + 2.f * x / cells;
+					f32 ndcY = -1.f + 2.f * y / cells;
+					if (x > 0 && x < cells)
+						ndcX += (rng.next01() - 0.5f) * 0.03f;
+					if (y > 0 && y < cells)
+						ndcY += (rng.next01() - 0.5f) * 0.03f;
+					if (seed & 1)
+					{
+						ndcX = ((std::floor((ndcX * 0.5f + 0.5f) * width) + 0.5f) / width) * 2.f - 1.f;
+						ndcY = ((std::floor((ndcY * 0.5f + 0.5f) * height) + 0.5f) / height) * 2.f - 1.f;
+					}
+					ndcX = x == 0 ? -1.3f : (x == cells ? 1.2f : ndcX);
+					ndcY = y == 0 ? -1.1f : (y == cells ? 1.4f : ndcY);
+					grid.vertices.push_back({ float3(ndcX, ndcY, 0.5f), float3(0.f, 0.f, -1.f) });
+				}
+			}
+			for (u32 y = 0; y < cells; ++y)
+			{
+				for (u32 x = 0; x < cells; ++x)
+				{
+					const u16 a = (u16)(y * (cells + 1) + x);
+					const u16 b = (u16)(a + 1);
+					const u16 c = (u16)(a + cells + 1);
+					const u16 d = (u16)(c + 1);
+					const u16 split0[] = { a, b, d, a, d, c };
+					const u16 split1[] = { a, c, b, b, c, d };
+					const u16* pQuad = (rng.next() & 1) ? split0 : split1;
+					grid.indices.insert(grid.indices.end(), pQuad, pQuad + 6);
+				}
+			}
+			grid.finish();
+
+			SoftRaster::Draw draw;
+			draw.pMesh = &grid.view;
+			SoftRaster::GBuffer gbuffer;
+			gbuffer.resize(width, height);
+			SoftRaster::Rasterizer rasterizer(&pool);
+			const SoftRaster::Stats& stats = rasterizer.render(&draw, 1, gbuffer);
+			if (stats.texelsWritten != width * height)
+			{
+				printf("FAILED watertight grid %u : %u texels written, expected %u\n", seed, stats.texelsWritten, width * height);
+				ok = false;
+			}
+		}
+		return ok;
+	}
+
+	// Every scene draw's triangles in world space.
+	void build_bvh(const Scene& scene, BVH& bvh)
+	{
+		bvh.clear();
+		for (const SoftRaster::Draw& draw : scene.draws)
+		{
+			const SoftRaster::MeshView& view = *draw.pMesh;
+			bvh.add((const f32*)(view.pVertices + view.positionOffset), view.vertexCount, view.stride, view.pIndices, view.indexCount, draw.matModel);
+		}
+		bvh.build();
+	}
+
+	// Closest hits against every triangle, and closest_hit_4() against closest_hit(). The packet
+	// does the single ray's ops so they match exactly, brute force can differ by the rounding of a
+	// slab test that skipped a neighbour triangle a few ulps nearer.
+	bool check_bvh(const BVH& bvh)
+	{
+		const std::vector<BVH::Triangle>& triangles = bvh.triangles();
+		auto brute_force = [&](const float3& o, const float3& d, f32 t)
+		{
+			for (const BVH::Triangle& tri : triangles)
+			{
+				const float3 p = hlsl::cross(d, tri.e2);
+				const f32 det = hlsl::dot(tri.e1, p);
+				if (std::fabs(det) <= 1e-12f)
+					continue;
+				const f32 invDet = 1.f / det;
+				const float3 s = o - tri.v0;
+				const f32 u = hlsl::dot(s, p) * invDet;
+				const float3 q = hlsl::cross(s, tri.e1);
+				const f32 v = hlsl::dot(d, q) * invDet;
+				const f32 hitT = hlsl::dot(tri.e2, q) * invDet;
+				if (u >= 0.f && u <= 1.f && v >= 0.f && u + v <= 1.f && hitT > 0.f && hitT < t)
+					t = hitT;
+			}
+			return t;
+		};
+
+		Rng rng(0xA0);
+		u32 hits = 0;
+		for (u32 packet = 0; packet < 128; ++packet)
+		{
+			// Four rays from one point above the objects, like one pixel's AO rays.
+			const float3 origin((rng.next01() - 0.5f) * 40.f, rng.next01() * 1.5f, rng.next01() * 36.f);
+			BVH::Ray4 rays;
+			for (u32 lane = 0; lane < 4; ++lane)
+			{
+				const float3 d = hlsl::normalize(float3(rng.next01() - 0.5f, rng.next01() - 0.5f, rng.next01() - 0.5f));
+				rays.ox[lane] = origin.x;
+				rays.oy[lane] = origin.y;
+				rays.oz[lane] = origin.z;
+				rays.dx[lane] = d.x;
+				rays.dy[lane] = d.y;
+				rays.dz[lane] = d.z;
+				rays.tMax[lane] = lane == 3 ? 0.f : 2.f + rng.next01() * 20.f;	// one idle lane.
+			}
+
+			f32 packetT[4];
+			bvh.closest_hit_4(rays, packetT);
+			for (u32 lane = 0; lane < 4; ++lane)
+			{
+				const float3 d(rays.dx[lane], rays.dy[lane], rays.dz[lane]);
+				const f32 expected = brute_force(origin, d, rays.tMax[lane]);
+				const f32 single = bvh.closest_hit(origin, d, rays.tMax[lane]);
+				if (std::fabs(single - expected) > 1e-5f * std::max(1.f, expected) || packetT[lane] != single)
+				{
+					printf("FAILED BVH ray %u : brute force %.9g, closest_hit %.9g, closest_hit_4 %.9g\n", packet * 4 + lane, expected, single, packetT[lane]);
+					return false;
+				}
+				hits += expected < rays.tMax[lane] ? 1 : 0;
+			}
+		}
+		if (!hits)
+		{
+			printf("FAILED BVH check rays hit nothing\n");
+			return false;
+		}
+		return true;
+	}
+
+	// Every scene draw's triangles in world space, the volume around the objects (the plane runs far
+	// past them).
+	void bake_distance_field(const Scene& scene, const DistanceField::Desc& desc, DistanceField& field, WorkerPool* pPool)
+	{
+		field.clear();
+		for (const SoftRaster::Draw& draw : scene.draws)
+		{
+			const SoftRaster::MeshView& view = *draw.pMesh;
+			field.add((const f32*)(view.pVertices + view.positionOffset), view.vertexCount, view.stride, view.pIndices, view.indexCount, draw.matModel);
+		}
+		field.bake(desc, pPool);
+	}
+
+	DistanceField::Desc objects_volume(u32 objectsPerSide, f32 padding)
+	{
+		DistanceField::Desc desc;
+		desc.padding = padding;
+		desc.voxelSize = 0.1f;
+		desc.maxResolution = 128;
+		desc.clipMin = float3(-(objectsPerSide * 0.75f + 1.f), -1.f, -1.f);
+		desc.clipMax = float3(objectsPerSide * 0.75f + 1.f, 2.f, objectsPerSide * 1.5f + 1.f);
+		return desc;
+	}
+
+	// Jump flooding on a 2x2 objects scene against the exact distances, and threaded against single
+	// threaded. A voxel can flood from a triangle that is a little further than the nearest, never by
+	// much (it is exact to the one it took).
+	bool check_distance_field(u32 width, u32 height, WorkerPool& pool)
+	{
+		Scene scene;
+		build_scene(scene, width, height, 2);
+		DistanceField::Desc desc = objects_volume(2, 0.5f);
+		desc.voxelSize = 0.2f;
+
+		DistanceField exact, flood, floodSingle;
+		desc.method = DistanceField::Method::kExact;
+		bake_distance_field(scene, desc, exact, &pool);
+		desc.method = DistanceField::Method::kJumpFlood;
+		bake_distance_field(scene, desc, flood, &pool);
+		bake_distance_field(scene, desc, floodSingle, nullptr);
+
+		if (flood.distances() != floodSingle.distances())
+		{
+			printf("FAILED threaded distance field differs from the single threaded one\n");
+			return false;
+		}
+
+		f32 maxError = 0.f;
+		u32 wrong = 0;
+		for (size_t i = 0; i < exact.distances().size(); ++i)
+		{
+			const f32 error = flood.distances()[i] - exact.distances()[i];
+			if (error < -1e-6f)
+			{
+				printf("FAILED jump flooded voxel %u nearer (%.6f) than the exact distance (%.6f)\n", (u32)i, flood.distances()[i], exact.distances()[i]);
+				return false;
+			}
+			maxError = std::max(maxError, error);
+			wrong += error > 1e-6f ? 1 : 0;
+		}
+		if (maxError > 0.5f * flood.voxel_size())
+		{
+			printf("FAILED jump flooding is %.3f voxels off the exact distance\n", maxError / flood.voxel_size());
+			return false;
+		}
+		printf("Distance field check : %ux%ux%u, jump flooding %u of %u voxels off, by %.3f voxels at most\n"
+			, flood.size(0), flood.size(1), flood.size(2), wrong, flood.stats().voxels, maxError / flood.voxel_size());
+		return true;
+	}
+
+	bool check_threads(const Scene& scene, u32 width, u32 height, WorkerPool& pool)
+	{
+		SoftRaster::GBuffer single;
+		SoftRaster::GBuffer threaded;
+		single.resize(width, height);
+		threaded.resize(width, height);
+		SoftRaster::Rasterizer(nullptr).render(scene.draws.data(), (u32)scene.draws.size(), single);
+		SoftRaster::Rasterizer(&pool).render(scene.draws.data(), (u32)scene.draws.size(), threaded);
+		if (single.depthStencil != threaded.depthStencil || single.normal != threaded.normal || single.colourSpec != threaded.colourSpec)
+		{
+			printf("FAILED threaded G-buffer differs from the single threaded one\n");
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const u32 width = argc > 1 ? (u32)atoi(argv[1]) : 1920;
+	const u32 height = argc > 2 ? (u32)atoi(argv[2]) : 1080;
+	const u32 iterations = argc > 3 ? (u32)atoi(argv[3]) : 10;
+	const u32 objectsPerSide = argc > 4 ? (u32)atoi(argv[4]) : 24;
+
+	WorkerPool pool;
+	Scene scene;
+	build_scene(scene, width, height, objectsPerSide);
+
+	bool ok = check_watertight(333, 217, pool);
+	ok &= check_watertight(width, height, pool);
+	ok &= check_threads(scene, width, height, pool);
+	if (!ok)
+	{
+		return 1;
+	}
+
+	SoftRaster::GBuffer gbuffer;
+	gbuffer.resize(width, height);
+	SoftRaster::Rasterizer single(nullptr);
+	SoftRaster::Rasterizer threaded(&pool);
+
+	const u32 draws = (u32)scene.draws.size();
+	const f64 singleMs = time_ms(iterations, [&] { single.render(scene.draws.data(), draws, gbuffer); });
+	const f64 threadedMs = time_ms(iterations, [&] { threaded.render(scene.draws.data(), draws, gbuffer); });
+	const SoftRaster::Stats& stats = threaded.stats();
+
+	printf("%ux%u, %u iterations, %s\n", width, height, iterations, SoftRaster::rasterizer_isa());
+	printf("Scene : %u draws, %u triangles, %u culled, %u clipped, %u tile bins, %u texels written\n"
+		, stats.draws, stats.triangles, stats.culledTriangles, stats.clippedTriangles, stats.binnedTriangles, stats.texelsWritten);
+	printf("  Geometry 1 thrd  : %8.3f ms/frame  %6.2f Mtris/s\n", singleMs / iterations, stats.triangles * (f64)iterations / (singleMs * 1e3));
+	printf("  Geometry %2u thrd : %8.3f ms/frame  %6.2f Mtris/s  (x%.2f)\n", pool.threads(), threadedMs / iterations
+		, stats.triangles * (f64)iterations / (threadedMs * 1e3), singleMs / threadedMs);
+
+	// The rest of the chain on what was rasterised, like the app's CPU references.
+	AOReference::GBuffer reference;
+	SoftRaster::to_reference(gbuffer, reference);
+	reference.matView = scene.matView;
+	reference.matProjection = scene.matProjection;
+	reference.matInverseView = inverse(scene.matView);
+	reference.matInverseProjection = inverse(scene.matProjection);
+
+	AOReference::Image ao;
+	std::vector<f32> blurred((size_t)width * height);
+	const BlurKernel gauss = BlurKernel::Gauss9(3);
+	const f64 aoMs = time_ms(1, [&] { AOReference::ssao_vogel_alchemy(reference, AOReference::Params(), ao, &pool); });
+	const f64 blurMs = time_ms(iterations, [&] { blur_fused(ao.texels.data(), blurred.data(), width, height, gauss, &pool); });
+
+	printf("  AO (Vogel / Alchemy reference, %2u thrd): %8.3f ms\n", pool.threads(), aoMs);
+	printf("  Blur (fused Gauss9(3), %2u thrd)        : %8.3f ms\n", pool.threads(), blurMs / iterations);
+	printf("  Geometry -> AO -> blur                 : %8.3f ms\n", threadedMs / iterations + aoMs + blurMs / iterations);
+
+	// Ground truth, and what each tap count of the reference misses of it.
+	BVH bvh;
+	const f64 bvhMs = time_ms(1, [&] { build_bvh(scene, bvh); });
+	if (!check_bvh(bvh))
+	{
+		return 1;
+	}
+	const BVH::Stats& bvhStats = bvh.stats();
+	printf("BVH (%s) : %u triangles, %u nodes, %u leaves, depth %u, SAH cost %.1f, built in %.3f ms\n", bvh_isa()
+		, bvhStats.triangles, bvhStats.nodes, bvhStats.leaves, bvhStats.maxDepth, bvhStats.sahCost, bvhMs);
+
+	AOReference::Image groundTruth;
+	GroundTruthAO::Params truthParams;
+	GroundTruthAO::Stats truthStats;
+	const f64 truthMs = time_ms(1, [&] { truthStats = GroundTruthAO::render(reference, bvh, truthParams, groundTruth, &pool); });
+	printf("  Ground truth (%u rays/pixel, %2u thrd)  : %8.3f ms  %6.2f Mrays/s, %.1f%% hit\n", truthParams.raysPerPixel, pool.threads(), truthMs
+		, truthStats.rays / (truthMs * 1e3), truthStats.rays ? 100.0 * truthStats.hits / truthStats.rays : 0.0);
+
+	// Each tap count against the ground truth, then the converged estimate's error: the estimator's
+	// bias, what no tap count gets under.
+	const f32 kToleranceSteps = 0.5f;
+	auto print_calibration = [&](const char* pName, const std::vector<GroundTruthAO::Calibration>& rows, const GroundTruthAO::Calibration& converged)
+	{
+		const u32 cheapest = GroundTruthAO::cheapest_acceptable(rows, kToleranceSteps);
+		for (u32 i = 0; i < rows.size(); ++i)
+		{
+			const GroundTruthAO::Calibration& row = rows[i];
+			printf("  %s %2u taps : %8.3f ms, rms %6.2f / max %6.2f R8 steps, x%.2f fitted rms %6.2f%s\n", pName, row.taps, row.milliseconds
+				, row.error.rms_steps(), row.error.max_steps(), row.gain, row.fittedError.rms_steps(), i == cheapest ? "  <- cheapest within 0.5" : "");
+		}
+		printf("  %s bias (%u taps) : %8.3f ms, rms %6.2f / max %6.2f R8 steps, x%.2f fitted rms %6.2f\n", pName, converged.taps, converged.milliseconds
+			, converged.error.rms_steps(), converged.error.max_steps(), converged.gain, converged.fittedError.rms_steps());
+
+		// More taps have to buy something measurable against the ground truth, or there is nothing to pick between.
+		if (!(rows.back().fittedError.rms < rows.front().fittedError.rms))
+		{
+			printf("FAILED %s at %u taps isn't closer to the ground truth than at %u\n", pName, rows.back().taps, rows.front().taps);
+			return false;
+		}
+		return true;
+	};
+
+	GroundTruthAO::Calibration spiralConverged, vogelConverged;
+	const std::vector<GroundTruthAO::Calibration> spiralRows = GroundTruthAO::calibrate_spiral(reference, groundTruth, AOReference::Params()
+		, SSAOKernels::kMaxTaps / 4, &pool, &spiralConverged);
+	const std::vector<GroundTruthAO::Calibration> vogelRows = GroundTruthAO::calibrate_vogel_alchemy(reference, groundTruth, AOReference::Params()
+		, SSAOKernels::kMaxTaps / 4, &pool, &vogelConverged);
+	if (!print_calibration("Spiral         ", spiralRows, spiralConverged) || !print_calibration("Vogel / Alchemy", vogelRows, vogelConverged))
+	{
+		return 1;
+	}
+
+	// Alchemy's estimator is the better fit to the ground truth, it has to stay that way at every tap count.
+	for (u32 i = 0; i < vogelRows.size(); ++i)
+	{
+		if (!(vogelRows[i].error.rms <= spiralRows[i].error.rms))
+		{
+			printf("FAILED Vogel / Alchemy at %u taps is further from the ground truth than the spiral (%.2f vs %.2f R8 steps)\n"
+				, vogelRows[i].taps, vogelRows[i].error.rms_steps(), spiralRows[i].error.rms_steps());
+			return 1;
+		}
+	}
+
+	// Distance field AO of the same scene, a few volume fetches per pixel.
+	if (!check_distance_field(width, height, pool))
+	{
+		return 1;
+	}
+
+	DistanceFieldAO::Params fieldParams;
+	fieldParams.maxDistance = truthParams.maxDistance;
+
+	DistanceField field;
+	const DistanceField::Desc fieldDesc = objects_volume(objectsPerSide, fieldParams.maxDistance);
+	const f64 bakeMs = time_ms(1, [&] { bake_distance_field(scene, fieldDesc, field, &pool); });
+	printf("Distance field : %ux%ux%u voxels of %.3f, %u triangles, %u seeds, %u passes, jump flooded in %.3f ms (%2u thrd)\n"
+		, field.size(0), field.size(1), field.size(2), field.voxel_size(), field.stats().triangles, field.stats().seeds, field.stats().passes, bakeMs, pool.threads());
+
+	AOReference::Image fieldAO;
+	const f64 fieldMs = time_ms(1, [&] { DistanceFieldAO::render(reference, field, fieldParams, fieldAO, &pool); });
+	const f32 fieldGain = GroundTruthAO::fit_gain(reference, groundTruth, fieldAO);
+	const AOReference::ImageError fieldError = GroundTruthAO::compare_drawn(reference, groundTruth, fieldAO);
+	const AOReference::ImageError fieldFitted = GroundTruthAO::compare_drawn(reference, groundTruth, fieldAO, fieldGain);
+	printf("  Distance field AO (%u cones x %u steps) : %8.3f ms, rms %6.2f / max %6.2f R8 steps, x%.2f fitted rms %6.2f\n"
+		, DistanceFieldAO::kCones, fieldParams.steps, fieldMs, fieldError.rms_steps(), fieldError.max_steps(), fieldGain, fieldFitted.rms_steps());
+
+	// What the lighting shows is the visibility, the metrics compare that.
+	std::vector<f32> truthVisibility(groundTruth.texels.size());
+	std::vector<f32> fieldVisibility(fieldAO.texels.size());
+	for (size_t i = 0; i < truthVisibility.size(); ++i)
+	{
+		truthVisibility[i] = 1.f - groundTruth.texels[i];
+		fieldVisibility[i] = 1.f - fieldAO.texels[i];
+	}
+	ImageMetrics::Scores scores;
+	const f64 metricsMs = time_ms(1, [&] { scores = ImageMetrics::compare(truthVisibility.data(), fieldVisibility.data(), width, height, ImageMetrics::Params(), nullptr, &pool); });
+	printf("    PSNR %.2f dB, SSIM %.4f, FLIP %.4f (max %.3f), scored in %.3f ms (%s, %2u thrd)\n"
+		, scores.psnr, scores.ssim, scores.flip, scores.flipMax, metricsMs, ImageMetrics::isa(), pool.threads());
+
+	return 0;
+}